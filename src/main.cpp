@@ -16,6 +16,8 @@
 
 // solver
 #include "shared/SolverFactory.h"
+#include "shared/Ensemble.h"
+#include "shared/Autotuner.h"
 
 #ifdef USE_MPI
 #include "utils/mpiUtils/GlobalMpiSession.h"
@@ -131,6 +133,27 @@ int main(int argc, char *argv[])
   std::string input_file = std::string(argv[1]);
   ConfigMap configMap = broadcast_parameters(input_file);
 
+  // implementation variants and tile sizes timed (or read from cache)
+  // for this machine
+  if (configMap.getBool("autotune", "enabled", false)) {
+    Autotuner autotuner(configMap);
+    autotuner.apply();
+  }
+
+  // many independent simulations in the same process
+  const std::string ensemble_file = configMap.getString("run", "ensemble_file", "");
+  if (!ensemble_file.empty()) {
+
+    {
+      Ensemble ensemble(configMap, ensemble_file);
+      ensemble.run();
+    }
+
+    Kokkos::finalize();
+
+    return EXIT_SUCCESS;
+  }
+
   // test: create a HydroParams object
   HydroParams params = HydroParams();
   params.setup(configMap);
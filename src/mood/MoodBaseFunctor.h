@@ -34,7 +34,7 @@ public:
   virtual ~MoodBaseFunctor() {};
 
   HydroParams params;
-  const int nbvar = params.nbvar;
+  enum { nbvar = NbVar<dim>::value };
 
   /**
    * a dummy swap device routine.
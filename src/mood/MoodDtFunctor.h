@@ -195,41 +195,31 @@ public:
 
   /* this is a reduce (max) functor  for 2d data */
   KOKKOS_INLINE_FUNCTION
-  void operator()(const int& index,
-		  real_t &invDt) const
+  void operator()(const int& i,
+                  const int& j,
+                  real_t &invDt) const
   {
-    const int isize = this->params.isize;
-    const int jsize = this->params.jsize;
-    const int ghostWidth = this->params.ghostWidth;
     //const int nbvar = this->params.nbvar;
     const real_t dx = this->params.dx;
     const real_t dy = this->params.dy;
     
-    int i,j;
-    index2coord(index,i,j,isize,jsize);
-
-    if(j >= ghostWidth && j < jsize - ghostWidth &&
-       i >= ghostWidth && i < isize - ghostWidth) {
-      
-      HydroState uLoc; // conservative    variables in current cell
-      HydroState qLoc; // primitive    variables in current cell
-      real_t c=0.0;
-      real_t vx, vy;
-      
-      // get local conservative variable
-      uLoc[ID] = Udata(i,j,ID);
-      uLoc[IP] = Udata(i,j,IP);
-      uLoc[IU] = Udata(i,j,IU);
-      uLoc[IV] = Udata(i,j,IV);
-
-      // get primitive variables in current cell
-      this->computePrimitives(uLoc, &c, qLoc);
-      vx = c+FABS(qLoc[IU]);
-      vy = c+FABS(qLoc[IV]);
-
-      invDt = FMAX(invDt, vx/dx + vy/dy);
+    HydroState uLoc; // conservative    variables in current cell
+    HydroState qLoc; // primitive    variables in current cell
+    real_t c=0.0;
+    real_t vx, vy;
       
-    }
+    // get local conservative variable
+    uLoc[ID] = Udata(i,j,ID);
+    uLoc[IP] = Udata(i,j,IP);
+    uLoc[IU] = Udata(i,j,IU);
+    uLoc[IV] = Udata(i,j,IV);
+
+    // get primitive variables in current cell
+    this->computePrimitives(uLoc, &c, qLoc);
+    vx = c+FABS(qLoc[IU]);
+    vy = c+FABS(qLoc[IV]);
+
+    invDt = FMAX(invDt, vx/dx + vy/dy);
 	    
   } // operator () for 2d
 
@@ -288,46 +278,34 @@ public:
 
   /* this is a reduce (max) functor for 3d data */
   KOKKOS_INLINE_FUNCTION
-  void operator()(const int& index,
-		  real_t &invDt) const
+  void operator()(const int& i,
+                  const int& j,
+                  const int& k,
+                  real_t &invDt) const
   {
-    const int isize = this->params.isize;
-    const int jsize = this->params.jsize;
-    const int ksize = this->params.ksize;
-    const int ghostWidth = this->params.ghostWidth;
-    
     const real_t dx = this->params.dx;
     const real_t dy = this->params.dy;
     const real_t dz = this->params.dz;
     
-    int i,j,k;
-    index2coord(index,i,j,k,isize,jsize,ksize);
-    
-    if(k >= ghostWidth && k < ksize - ghostWidth &&
-       j >= ghostWidth && j < jsize - ghostWidth &&
-       i >= ghostWidth && i < isize - ghostWidth) {
-      
-      HydroState uLoc; // conservative    variables in current cell
-      HydroState qLoc; // primitive    variables in current cell
-      real_t c=0.0;
-      real_t vx, vy, vz;
+    HydroState uLoc; // conservative    variables in current cell
+    HydroState qLoc; // primitive    variables in current cell
+    real_t c=0.0;
+    real_t vx, vy, vz;
       
-      // get local conservative variable
-      uLoc[ID] = Udata(i,j,k,ID);
-      uLoc[IP] = Udata(i,j,k,IP);
-      uLoc[IU] = Udata(i,j,k,IU);
-      uLoc[IV] = Udata(i,j,k,IV);
-      uLoc[IW] = Udata(i,j,k,IW);
-
-      // get primitive variables in current cell
-      this->computePrimitives(uLoc, &c, qLoc);
-      vx = c+FABS(qLoc[IU]);
-      vy = c+FABS(qLoc[IV]);
-      vz = c+FABS(qLoc[IW]);
-
-      invDt = FMAX(invDt, vx/dx + vy/dy + vz/dz);
-      
-    }
+    // get local conservative variable
+    uLoc[ID] = Udata(i,j,k,ID);
+    uLoc[IP] = Udata(i,j,k,IP);
+    uLoc[IU] = Udata(i,j,k,IU);
+    uLoc[IV] = Udata(i,j,k,IV);
+    uLoc[IW] = Udata(i,j,k,IW);
+
+    // get primitive variables in current cell
+    this->computePrimitives(uLoc, &c, qLoc);
+    vx = c+FABS(qLoc[IU]);
+    vy = c+FABS(qLoc[IV]);
+    vz = c+FABS(qLoc[IW]);
+
+    invDt = FMAX(invDt, vx/dx + vy/dy + vz/dz);
 	    
   } // operator () for 3d
 
@@ -76,7 +76,8 @@ public:
   //! functor for 2d 
   template<int dim_ = dim>
   KOKKOS_INLINE_FUNCTION
-  void operator()(const typename std::enable_if<dim_==2, int>::type& index)  const
+  void operator()(const typename std::enable_if<dim_==2, int>::type& i,
+                  const int& j) const
   {
 
     const int isize = this->params.isize;
@@ -86,7 +87,7 @@ public:
     const real_t dx = this->params.dx;
     const real_t dy = this->params.dy;
 
-    const real_t nbvar = this->params.nbvar;
+    const int nbvar = NbVar<dim>::value;
 
     // Quadrature weights when using 1 point (Gauss-Legendre).
     //const real_t QUADRATURE_WEIGHTS_N1[1] = {1.0};
@@ -108,9 +109,6 @@ public:
     // accumulate flux over all quadrature points
     HydroState flux, flux_tmp;
     
-    int i,j;
-    index2coord(index,i,j,isize,jsize);
-
     /*********************
      * flux along DIR_X
      *********************/
@@ -343,7 +341,9 @@ public:
   /************* UNFINISHED - TODO ***************/
   template<int dim_ = dim>
   KOKKOS_INLINE_FUNCTION
-  void operator()(const typename std::enable_if<dim_==3, int>::type& index) const
+  void operator()(const typename std::enable_if<dim_==3, int>::type& i,
+                  const int& j,
+                  const int& k) const
   {
     const int isize = this->params.isize;
     const int jsize = this->params.jsize;
@@ -354,7 +354,7 @@ public:
     const real_t dy = this->params.dy;
     const real_t dz = this->params.dz;
 
-    const real_t nbvar = this->params.nbvar;
+    const int nbvar = NbVar<dim>::value;
 
     // Quadrature weights when using 1 point (Gauss-Legendre).
     //const real_t QUADRATURE_WEIGHTS_N1[1] = {1.0};
@@ -376,9 +376,6 @@ public:
     // accumulate flux over all quadrature points
     HydroState flux, flux_tmp;
 
-    int i,j,k;
-    index2coord(index,i,j,k,isize,jsize,ksize);
-
     /*********************
      * flux along DIR_X
      *********************/
@@ -789,17 +786,14 @@ public:
   //! functor for 2d 
   template<int dim_ = dim>
   KOKKOS_INLINE_FUNCTION
-  void operator()(const typename std::enable_if<dim_==2, int>::type& index)  const
+  void operator()(const typename std::enable_if<dim_==2, int>::type& i,
+                  const int& j) const
   {
 
-    const int isize = this->params.isize;
-    const int jsize = this->params.jsize;
-    const int ghostWidth = this->params.ghostWidth;
-
     const real_t dx = this->params.dx;
     const real_t dy = this->params.dy;
 
-    const real_t nbvar = this->params.nbvar;
+    const int nbvar = NbVar<dim>::value;
 
     // riemann solver states left/right 
     HydroState UL, UR;
@@ -811,10 +805,6 @@ public:
     // accumulate flux over all quadrature points
     HydroState flux;
 
-    // current cell coordinates
-    int i,j;
-    index2coord(index,i,j,isize,jsize);
-
     // current flag (indicating if fluxes need to be recomputed)
     real_t flag  = Flags(i,j,0);
     real_t flagx = 0.0;
@@ -914,19 +904,16 @@ public:
   //! functor for 3d
   template<int dim_ = dim>
   KOKKOS_INLINE_FUNCTION
-  void operator()(const typename std::enable_if<dim_==3, int>::type& index)  const
+  void operator()(const typename std::enable_if<dim_==3, int>::type& i,
+                  const int& j,
+                  const int& k) const
   {
     
-    const int isize = this->params.isize;
-    const int jsize = this->params.jsize;
-    const int ksize = this->params.ksize;
-    const int ghostWidth = this->params.ghostWidth;
-
     const real_t dx = this->params.dx;
     const real_t dy = this->params.dy;
     const real_t dz = this->params.dz;
 
-    const real_t nbvar = this->params.nbvar;
+    const int nbvar = NbVar<dim>::value;
 
     // riemann solver states left/right 
     HydroState UL, UR;
@@ -938,10 +925,6 @@ public:
     // accumulate flux over all quadrature points
     HydroState flux;
 
-    // current cell coordinates
-    int i,j,k;
-    index2coord(index,i,j,k,isize,jsize,ksize);
-
     // current flag (indicating if fluxes need to be recomputed)
     real_t flag  = Flags(i,j,k,0);
     real_t flagx = 0.0;
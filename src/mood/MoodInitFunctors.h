@@ -50,12 +50,19 @@ public:
   //! functor for 2d 
   template<int dim_ = dim>
   KOKKOS_INLINE_FUNCTION
-  void operator()(const typename std::enable_if<dim_==2, int>::type& index) const
+  void operator()(const typename std::enable_if<dim_==2, int>::type& i,
+                  const int& j) const
   {
 
-    const int isize = this->params.isize;
-    const int jsize = this->params.jsize;
     const int ghostWidth = this->params.ghostWidth;
+
+#ifdef USE_MPI
+    const int i_offset = this->params.myOffset[IX];
+    const int j_offset = this->params.myOffset[IY];
+#else
+    const int i_offset = 0;
+    const int j_offset = 0;
+#endif
     
     const real_t xmin = this->params.xmin;
     const real_t ymin = this->params.ymin;
@@ -64,11 +71,8 @@ public:
     
     const real_t gamma0 = this->params.settings.gamma0;
     
-    int i,j;
-    index2coord(index,i,j,isize,jsize);
-    
-    real_t x = xmin + dx/2 + (i-ghostWidth)*dx;
-    real_t y = ymin + dy/2 + (j-ghostWidth)*dy;
+    real_t x = xmin + dx/2 + (i+i_offset-ghostWidth)*dx;
+    real_t y = ymin + dy/2 + (j+j_offset-ghostWidth)*dy;
     
     //real_t tmp = x+y*y;
     real_t tmp = x+y;
@@ -92,13 +96,22 @@ public:
   //! functor for 3d 
   template<int dim_ = dim>
   KOKKOS_INLINE_FUNCTION
-  void operator()(const typename std::enable_if<dim_==3, int>::type& index) const
+  void operator()(const typename std::enable_if<dim_==3, int>::type& i,
+                  const int& j,
+                  const int& k) const
   {
 
-    const int isize = this->params.isize;
-    const int jsize = this->params.jsize;
-    const int ksize = this->params.ksize;
     const int ghostWidth = this->params.ghostWidth;
+
+#ifdef USE_MPI
+    const int i_offset = this->params.myOffset[IX];
+    const int j_offset = this->params.myOffset[IY];
+    const int k_offset = this->params.myOffset[IZ];
+#else
+    const int i_offset = 0;
+    const int j_offset = 0;
+    const int k_offset = 0;
+#endif
     
     const real_t xmin = this->params.xmin;
     const real_t ymin = this->params.ymin;
@@ -109,12 +122,9 @@ public:
     
     const real_t gamma0 = this->params.settings.gamma0;
     
-    int i,j,k;
-    index2coord(index,i,j,k,isize,jsize,ksize);
-    
-    real_t x = xmin + dx/2 + (i-ghostWidth)*dx;
-    real_t y = ymin + dy/2 + (j-ghostWidth)*dy;
-    real_t z = zmin + dz/2 + (k-ghostWidth)*dz;
+    real_t x = xmin + dx/2 + (i+i_offset-ghostWidth)*dx;
+    real_t y = ymin + dy/2 + (j+j_offset-ghostWidth)*dy;
+    real_t z = zmin + dz/2 + (k+k_offset-ghostWidth)*dz;
     
     real_t tmp = x + y + z;
     if (tmp > 0.5 && tmp < 2.5) {
@@ -167,12 +177,19 @@ public:
   //! functor for 2d 
   template<int dim_ = dim>
   KOKKOS_INLINE_FUNCTION
-  void operator()(const typename std::enable_if<dim_==2, int>::type& index) const
+  void operator()(const typename std::enable_if<dim_==2, int>::type& i,
+                  const int& j) const
   {
 
-    const int isize = this->params.isize;
-    const int jsize = this->params.jsize;
     const int ghostWidth = this->params.ghostWidth;
+
+#ifdef USE_MPI
+    const int i_offset = this->params.myOffset[IX];
+    const int j_offset = this->params.myOffset[IY];
+#else
+    const int i_offset = 0;
+    const int j_offset = 0;
+#endif
     
     const real_t xmin = this->params.xmin;
     const real_t ymin = this->params.ymin;
@@ -191,11 +208,8 @@ public:
     const real_t blast_pressure_in = bParams.blast_pressure_in;
     const real_t blast_pressure_out= bParams.blast_pressure_out;
 
-    int i,j;
-    index2coord(index,i,j,isize,jsize);
-    
-    real_t x = xmin + dx/2 + (i-ghostWidth)*dx;
-    real_t y = ymin + dy/2 + (j-ghostWidth)*dy;
+    real_t x = xmin + dx/2 + (i+i_offset-ghostWidth)*dx;
+    real_t y = ymin + dy/2 + (j+j_offset-ghostWidth)*dy;
     
     real_t d2 = 
       (x-blast_center_x)*(x-blast_center_x)+
@@ -221,13 +235,22 @@ public:
   //! functor for 3d 
   template<int dim_ = dim>
   KOKKOS_INLINE_FUNCTION
-  void operator()(const typename std::enable_if<dim_==3, int>::type& index) const
+  void operator()(const typename std::enable_if<dim_==3, int>::type& i,
+                  const int& j,
+                  const int& k) const
   {
 
-    const int isize = this->params.isize;
-    const int jsize = this->params.jsize;
-    const int ksize = this->params.ksize;
     const int ghostWidth = this->params.ghostWidth;
+
+#ifdef USE_MPI
+    const int i_offset = this->params.myOffset[IX];
+    const int j_offset = this->params.myOffset[IY];
+    const int k_offset = this->params.myOffset[IZ];
+#else
+    const int i_offset = 0;
+    const int j_offset = 0;
+    const int k_offset = 0;
+#endif
     
     const real_t xmin = this->params.xmin;
     const real_t ymin = this->params.ymin;
@@ -249,12 +272,9 @@ public:
     const real_t blast_pressure_in = bParams.blast_pressure_in;
     const real_t blast_pressure_out= bParams.blast_pressure_out;
 
-    int i,j,k;
-    index2coord(index,i,j,k,isize,jsize,ksize);
-    
-    real_t x = xmin + dx/2 + (i-ghostWidth)*dx;
-    real_t y = ymin + dy/2 + (j-ghostWidth)*dy;
-    real_t z = zmin + dz/2 + (k-ghostWidth)*dz;
+    real_t x = xmin + dx/2 + (i+i_offset-ghostWidth)*dx;
+    real_t y = ymin + dy/2 + (j+j_offset-ghostWidth)*dy;
+    real_t z = zmin + dz/2 + (k+k_offset-ghostWidth)*dz;
     
     real_t d2 = 
       (x-blast_center_x)*(x-blast_center_x)+
@@ -320,23 +340,27 @@ public:
   //! functor for 2d 
   template<int dim_ = dim>
   KOKKOS_INLINE_FUNCTION
-  void operator()(const typename std::enable_if<dim_==2, int>::type& index) const
+  void operator()(const typename std::enable_if<dim_==2, int>::type& i,
+                  const int& j) const
   {
 
-    const int isize = this->params.isize;
-    const int jsize = this->params.jsize;
     const int ghostWidth = this->params.ghostWidth;
+
+#ifdef USE_MPI
+    const int i_offset = this->params.myOffset[IX];
+    const int j_offset = this->params.myOffset[IY];
+#else
+    const int i_offset = 0;
+    const int j_offset = 0;
+#endif
     
     const real_t xmin = this->params.xmin;
     const real_t ymin = this->params.ymin;
     const real_t dx = this->params.dx;
     const real_t dy = this->params.dy;
     
-    int i,j;
-    index2coord(index,i,j,isize,jsize);
-    
-    real_t x = xmin + dx/2 + (i-ghostWidth)*dx;
-    real_t y = ymin + dy/2 + (j-ghostWidth)*dy;
+    real_t x = xmin + dx/2 + (i+i_offset-ghostWidth)*dx;
+    real_t y = ymin + dy/2 + (j+j_offset-ghostWidth)*dy;
     
     if (x<xt) {
       if (y<yt) {
@@ -376,13 +400,20 @@ public:
   //! functor for 3d 
   template<int dim_ = dim>
   KOKKOS_INLINE_FUNCTION
-  void operator()(const typename std::enable_if<dim_==3, int>::type& index) const
+  void operator()(const typename std::enable_if<dim_==3, int>::type& i,
+                  const int& j,
+                  const int& k) const
   {
 
-    const int isize = this->params.isize;
-    const int jsize = this->params.jsize;
-    const int ksize = this->params.ksize;
     const int ghostWidth = this->params.ghostWidth;
+
+#ifdef USE_MPI
+    const int i_offset = this->params.myOffset[IX];
+    const int j_offset = this->params.myOffset[IY];
+#else
+    const int i_offset = 0;
+    const int j_offset = 0;
+#endif
     
     const real_t xmin = this->params.xmin;
     const real_t ymin = this->params.ymin;
@@ -391,11 +422,8 @@ public:
     const real_t dy = this->params.dy;
     const real_t dz = this->params.dz;
     
-    int i,j,k;
-    index2coord(index,i,j,k,isize,jsize,ksize);
-    
-    real_t x = xmin + dx/2 + (i-ghostWidth)*dx;
-    real_t y = ymin + dy/2 + (j-ghostWidth)*dy;
+    real_t x = xmin + dx/2 + (i+i_offset-ghostWidth)*dx;
+    real_t y = ymin + dy/2 + (j+j_offset-ghostWidth)*dy;
     //real_t z = zmin + dz/2 + (k-ghostWidth)*dz;
 
     if (x<xt) {
@@ -476,15 +504,22 @@ public:
   //! functor for 2d 
   template<int dim_ = dim>
   KOKKOS_INLINE_FUNCTION
-  void operator()(const typename std::enable_if<dim_==2, int>::type& index) const
+  void operator()(const typename std::enable_if<dim_==2, int>::type& i,
+                  const int& j) const
   {
 
     // get random number state
     rand_type rand_gen = rand_pool.get_state();
     
-    const int isize = this->params.isize;
-    const int jsize = this->params.jsize;
     const int ghostWidth = this->params.ghostWidth;
+
+#ifdef USE_MPI
+    const int i_offset = this->params.myOffset[IX];
+    const int j_offset = this->params.myOffset[IY];
+#else
+    const int i_offset = 0;
+    const int j_offset = 0;
+#endif
     
     const real_t xmin = this->params.xmin;
     const real_t ymin = this->params.ymin;
@@ -504,11 +539,8 @@ public:
     const real_t ampl      = khParams.amplitude;
     const real_t pressure  = khParams.pressure;
     
-    int i,j;
-    index2coord(index,i,j,isize,jsize);
-    
-    real_t x = xmin + dx/2 + (i-ghostWidth)*dx;
-    real_t y = ymin + dy/2 + (j-ghostWidth)*dy;
+    real_t x = xmin + dx/2 + (i+i_offset-ghostWidth)*dx;
+    real_t y = ymin + dy/2 + (j+j_offset-ghostWidth)*dy;
 
     // normalized coordinates in [0,1]
     real_t xn = (x-xmin)/(xmax-xmin);
@@ -572,16 +604,25 @@ public:
   //! functor for 3d 
   template<int dim_ = dim>
   KOKKOS_INLINE_FUNCTION
-  void operator()(const typename std::enable_if<dim_==3, int>::type& index) const
+  void operator()(const typename std::enable_if<dim_==3, int>::type& i,
+                  const int& j,
+                  const int& k) const
   {
 
     // get random number generator state
     rand_type rand_gen = rand_pool.get_state();
 
-    const int isize = this->params.isize;
-    const int jsize = this->params.jsize;
-    const int ksize = this->params.ksize;
     const int ghostWidth = this->params.ghostWidth;
+
+#ifdef USE_MPI
+    const int i_offset = this->params.myOffset[IX];
+    const int j_offset = this->params.myOffset[IY];
+    const int k_offset = this->params.myOffset[IZ];
+#else
+    const int i_offset = 0;
+    const int j_offset = 0;
+    const int k_offset = 0;
+#endif
     
     const real_t xmin = this->params.xmin;
     const real_t ymin = this->params.ymin;
@@ -602,12 +643,9 @@ public:
     const real_t ampl      = khParams.amplitude;
     const real_t pressure  = khParams.pressure;
 
-    int i,j,k;
-    index2coord(index,i,j,k,isize,jsize,ksize);
-    
-    real_t x = xmin + dx/2 + (i-ghostWidth)*dx;
-    real_t y = ymin + dy/2 + (j-ghostWidth)*dy;
-    real_t z = zmin + dz/2 + (k-ghostWidth)*dz;
+    real_t x = xmin + dx/2 + (i+i_offset-ghostWidth)*dx;
+    real_t y = ymin + dy/2 + (j+j_offset-ghostWidth)*dy;
+    real_t z = zmin + dz/2 + (k+k_offset-ghostWidth)*dz;
     
     // normalized coordinates in [0,1]
     real_t xn = (x-xmin)/(xmax-xmin);
@@ -720,12 +758,19 @@ public:
   //! functor for 2d 
   template<int dim_ = dim>
   KOKKOS_INLINE_FUNCTION
-  void operator()(const typename std::enable_if<dim_==2, int>::type& index) const
+  void operator()(const typename std::enable_if<dim_==2, int>::type& i,
+                  const int& j) const
   {
 
-    const int isize = this->params.isize;
-    const int jsize = this->params.jsize;
     const int ghostWidth = this->params.ghostWidth;
+
+#ifdef USE_MPI
+    const int i_offset = this->params.myOffset[IX];
+    const int j_offset = this->params.myOffset[IY];
+#else
+    const int i_offset = 0;
+    const int j_offset = 0;
+#endif
     
     const real_t xmin = this->params.xmin;
     const real_t ymin = this->params.ymin;
@@ -737,11 +782,8 @@ public:
     const real_t slope_f = this->wparams.slope_f;
     const real_t x_f     = this->wparams.x_f;
     
-    int i,j;
-    index2coord(index,i,j,isize,jsize);
-    
-    real_t x = xmin + dx/2 + (i-ghostWidth)*dx;
-    real_t y = ymin + dy/2 + (j-ghostWidth)*dy;
+    real_t x = xmin + dx/2 + (i+i_offset-ghostWidth)*dx;
+    real_t y = ymin + dy/2 + (j+j_offset-ghostWidth)*dy;
     
     if ( y > slope_f*(x-x_f) ) {
     
@@ -767,13 +809,22 @@ public:
   //! functor for 3d 
   template<int dim_ = dim>
   KOKKOS_INLINE_FUNCTION
-  void operator()(const typename std::enable_if<dim_==3, int>::type& index) const
+  void operator()(const typename std::enable_if<dim_==3, int>::type& i,
+                  const int& j,
+                  const int& k) const
   {
 
-    const int isize = this->params.isize;
-    const int jsize = this->params.jsize;
-    const int ksize = this->params.ksize;
     const int ghostWidth = this->params.ghostWidth;
+
+#ifdef USE_MPI
+    const int i_offset = this->params.myOffset[IX];
+    const int j_offset = this->params.myOffset[IY];
+    const int k_offset = this->params.myOffset[IZ];
+#else
+    const int i_offset = 0;
+    const int j_offset = 0;
+    const int k_offset = 0;
+#endif
     
     const real_t xmin = this->params.xmin;
     const real_t ymin = this->params.ymin;
@@ -787,12 +838,9 @@ public:
     const real_t slope_f = this->wparams.slope_f;
     const real_t x_f     = this->wparams.x_f;
 
-    int i,j,k;
-    index2coord(index,i,j,k,isize,jsize,ksize);
-    
-    real_t x = xmin + dx/2 + (i-ghostWidth)*dx;
-    real_t y = ymin + dy/2 + (j-ghostWidth)*dy;
-    real_t z = zmin + dz/2 + (k-ghostWidth)*dz;
+    real_t x = xmin + dx/2 + (i+i_offset-ghostWidth)*dx;
+    real_t y = ymin + dy/2 + (j+j_offset-ghostWidth)*dy;
+    real_t z = zmin + dz/2 + (k+k_offset-ghostWidth)*dz;
     
     if ( y > slope_f*(x-x_f) ) {
     
@@ -1057,26 +1105,30 @@ public:
   //! functor for 2d 
   template<int dim_ = dim>
   KOKKOS_INLINE_FUNCTION
-  void operator()(const typename std::enable_if<dim_==2, int>::type& index) const
+  void operator()(const typename std::enable_if<dim_==2, int>::type& i,
+                  const int& j) const
   {
 
-    const int isize = this->params.isize;
-    const int jsize = this->params.jsize;
     const int ghostWidth = this->params.ghostWidth;
+
+#ifdef USE_MPI
+    const int i_offset = this->params.myOffset[IX];
+    const int j_offset = this->params.myOffset[IY];
+#else
+    const int i_offset = 0;
+    const int j_offset = 0;
+#endif
     
     const real_t xmin = this->params.xmin;
     const real_t ymin = this->params.ymin;
     const real_t dx = this->params.dx;
     const real_t dy = this->params.dy;
         
-    int i,j;
-    index2coord(index,i,j,isize,jsize);
-
     const int nQuadPts = this->iparams.nQuadPts;
     
     // center of current cell
-    real_t x = xmin + dx/2 + (i-ghostWidth)*dx;
-    real_t y = ymin + dy/2 + (j-ghostWidth)*dy;
+    real_t x = xmin + dx/2 + (i+i_offset-ghostWidth)*dx;
+    real_t y = ymin + dy/2 + (j+j_offset-ghostWidth)*dy;
 
     HydroState2d q;
     compute_HydroState_with_quadrature(x,y,nQuadPts,q);
@@ -1094,13 +1146,22 @@ public:
   //! functor for 3d 
   template<int dim_ = dim>
   KOKKOS_INLINE_FUNCTION
-  void operator()(const typename std::enable_if<dim_==3, int>::type& index) const
+  void operator()(const typename std::enable_if<dim_==3, int>::type& i,
+                  const int& j,
+                  const int& k) const
   {
 
-    const int isize = this->params.isize;
-    const int jsize = this->params.jsize;
-    const int ksize = this->params.ksize;
     const int ghostWidth = this->params.ghostWidth;
+
+#ifdef USE_MPI
+    const int i_offset = this->params.myOffset[IX];
+    const int j_offset = this->params.myOffset[IY];
+    const int k_offset = this->params.myOffset[IZ];
+#else
+    const int i_offset = 0;
+    const int j_offset = 0;
+    const int k_offset = 0;
+#endif
     
     const real_t xmin = this->params.xmin;
     const real_t ymin = this->params.ymin;
@@ -1109,14 +1170,11 @@ public:
     const real_t dy = this->params.dy;
     const real_t dz = this->params.dz;
     
-    int i,j,k;
-    index2coord(index,i,j,k,isize,jsize,ksize);
-    
     const int nQuadPts = this->iparams.nQuadPts;
 
-    real_t x = xmin + dx/2 + (i-ghostWidth)*dx;
-    real_t y = ymin + dy/2 + (j-ghostWidth)*dy;
-    real_t z = zmin + dz/2 + (k-ghostWidth)*dz;
+    real_t x = xmin + dx/2 + (i+i_offset-ghostWidth)*dx;
+    real_t y = ymin + dy/2 + (j+j_offset-ghostWidth)*dy;
+    real_t z = zmin + dz/2 + (k+k_offset-ghostWidth)*dz;
     
     HydroState2d q;
     compute_HydroState_with_quadrature(x,y,nQuadPts,q);
@@ -1125,7 +1183,7 @@ public:
     Udata(i  ,j  ,k  , IU) = q[IU];
     Udata(i  ,j  ,k  , IV) = q[IV];
     Udata(i  ,j  ,k  , IW) = q[ID]*w_a;
-    Udata(i  ,j  ,k  , IP) = q[IW];
+    Udata(i  ,j  ,k  , IP) = q[IP];
 
   } // end operator () - 3d
   
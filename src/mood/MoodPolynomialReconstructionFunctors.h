@@ -81,119 +81,96 @@ public:
   //! functor for 2d 
   template<int dim_ = dim>
   KOKKOS_INLINE_FUNCTION
-  void operator()(const typename std::enable_if<dim_==2, int>::type& index)  const
+  void operator()(const typename std::enable_if<dim_==2, int>::type& i,
+                  const int& j) const
   {
 
-    const int isize = this->params.isize;
-    const int jsize = this->params.jsize;
-    const int ghostWidth = this->params.ghostWidth;
-
     //const real_t dx = this->params.dx;
     //const real_t dy = this->params.dy;
 
-    const real_t nbvar = this->params.nbvar;
-    
-    int i,j;
-    index2coord(index,i,j,isize,jsize);
+    const int nbvar = NbVar<dim>::value;
     
     // rhs is sized upon stencil, just remove central point
     Kokkos::Array<real_t,stencil_size-1> rhs;
 
-    if(j >= ghostWidth-1 && j < jsize-ghostWidth+1  &&
-       i >= ghostWidth-1 && i < isize-ghostWidth+1 ) {
-
-      for (int ivar=0; ivar<nbvar; ++ivar) {
+    for (int ivar=0; ivar<nbvar; ++ivar) {
 	
-	// retrieve neighbors data for variable ivar, and build rhs
-	int irhs = 0;
-	for (int is=0; is<stencil_size; ++is) {
-	  int x = stencil.offsets(is,0);
-	  int y = stencil.offsets(is,1);
-	  if (x != 0 or y != 0) {
-	    rhs[irhs] = Udata(i+x,j+y,ivar) - Udata(i,j,ivar);
-	    irhs++;
-	  }	
-	} // end for is
+      // retrieve neighbors data for variable ivar, and build rhs
+      int irhs = 0;
+      for (int is=0; is<stencil_size; ++is) {
+	int x = stencil.offsets(is,0);
+	int y = stencil.offsets(is,1);
+	if (x != 0 or y != 0) {
+	  rhs[irhs] = Udata(i+x,j+y,ivar) - Udata(i,j,ivar);
+	  irhs++;
+	}	
+      } // end for is
 	
-	// retrieve reconstruction polynomial coefficients in current cell
-	coefs_t coefs_c;
-	coefs_c[0] = Udata(i,j,ivar);
-	for (int icoef=0; icoef<mat_pi.extent(0); ++icoef) {
-	  real_t tmp = 0;
-	  for (int ik=0; ik<mat_pi.extent(1); ++ik) {
-	    tmp += mat_pi(icoef,ik) * rhs[ik];
-	  }
-	  coefs_c[icoef+1] = tmp;
+      // retrieve reconstruction polynomial coefficients in current cell
+      coefs_t coefs_c;
+      coefs_c[0] = Udata(i,j,ivar);
+      for (int icoef=0; icoef<mat_pi.extent(0); ++icoef) {
+	real_t tmp = 0;
+	for (int ik=0; ik<mat_pi.extent(1); ++ik) {
+	  tmp += mat_pi(icoef,ik) * rhs[ik];
 	}
+	coefs_c[icoef+1] = tmp;
+      }
 
-	// copy back results on device memory
-	for (int icoef=0; icoef<ncoefs; ++icoef)
-	  polyCoefs[icoef](i,j,ivar) = coefs_c[icoef];
+      // copy back results on device memory
+      for (int icoef=0; icoef<ncoefs; ++icoef)
+	polyCoefs[icoef](i,j,ivar) = coefs_c[icoef];
 
-      } // end for ivar
-      
-    } // end if
+    } // end for ivar
     
   } // end functor 2d
 
   //! functor for 3d 
   template<int dim_ = dim>
   KOKKOS_INLINE_FUNCTION
-  void operator()(const typename std::enable_if<dim_==3, int>::type& index) const
+  void operator()(const typename std::enable_if<dim_==3, int>::type& i,
+                  const int& j,
+                  const int& k) const
   {
-    const int isize = this->params.isize;
-    const int jsize = this->params.jsize;
-    const int ksize = this->params.ksize;
-    const int ghostWidth = this->params.ghostWidth;
-
     //const real_t dx = this->params.dx;
     //const real_t dy = this->params.dy;
     //const real_t dz = this->params.dz;
 
-    const real_t nbvar = this->params.nbvar;
-
-    int i,j,k;
-    index2coord(index,i,j,k,isize,jsize,ksize);
+    const int nbvar = NbVar<dim>::value;
 
     // rhs is sized upon stencil, just remove central point
     Kokkos::Array<real_t,stencil_size-1> rhs;
     
-    if(k >= ghostWidth && k < ksize - ghostWidth+1 &&
-       j >= ghostWidth && j < jsize - ghostWidth+1 &&
-       i >= ghostWidth && i < isize - ghostWidth+1) {
-
-      for (int ivar=0; ivar<nbvar; ++ivar) {
-
-	// retrieve neighbors data for ivar, and build rhs
-	int irhs = 0;
-	for (int is=0; is<stencil_size; ++is) {
-	  int x = stencil.offsets(is,0);
-	  int y = stencil.offsets(is,1);
-	  int z = stencil.offsets(is,2);
-	  if (x != 0 or y != 0 or z != 0) {
-	    rhs[irhs] = Udata(i+x,j+y,k+z,ivar) - Udata(i,j,k,ivar);
-	    irhs++;
-	  }	
-	} // end for is
-
-	// retrieve reconstruction polynomial coefficients in current cell
-	coefs_t coefs_c;
-	coefs_c[0] = Udata(i,j,k,ivar);
-	for (int icoef=0; icoef<mat_pi.extent(0); ++icoef) {
-	  real_t tmp = 0;
-	  for (int ik=0; ik<mat_pi.extent(1); ++ik) {
-	    tmp += mat_pi(icoef,ik) * rhs[ik];
-	  }
-	  coefs_c[icoef+1] = tmp;
+    for (int ivar=0; ivar<nbvar; ++ivar) {
+
+      // retrieve neighbors data for ivar, and build rhs
+      int irhs = 0;
+      for (int is=0; is<stencil_size; ++is) {
+	int x = stencil.offsets(is,0);
+	int y = stencil.offsets(is,1);
+	int z = stencil.offsets(is,2);
+	if (x != 0 or y != 0 or z != 0) {
+	  rhs[irhs] = Udata(i+x,j+y,k+z,ivar) - Udata(i,j,k,ivar);
+	  irhs++;
+	}	
+      } // end for is
+
+      // retrieve reconstruction polynomial coefficients in current cell
+      coefs_t coefs_c;
+      coefs_c[0] = Udata(i,j,k,ivar);
+      for (int icoef=0; icoef<mat_pi.extent(0); ++icoef) {
+	real_t tmp = 0;
+	for (int ik=0; ik<mat_pi.extent(1); ++ik) {
+	  tmp += mat_pi(icoef,ik) * rhs[ik];
 	}
+	coefs_c[icoef+1] = tmp;
+      }
 	
-	// copy back results on device memory
-	for (int icoef=0; icoef<ncoefs; ++icoef)
-	  polyCoefs[icoef](i,j,k,ivar) = coefs_c[icoef];
+      // copy back results on device memory
+      for (int icoef=0; icoef<ncoefs; ++icoef)
+	polyCoefs[icoef](i,j,k,ivar) = coefs_c[icoef];
 	
-      } // end for ivar
-      
-    } // end if i,j,k
+    } // end for ivar
     
   }  // end functor 3d
   
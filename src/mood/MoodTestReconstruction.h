@@ -66,7 +66,8 @@ public:
   //! functor for 2d 
   template<int dim_ = dim>
   KOKKOS_INLINE_FUNCTION
-  void operator()(const typename std::enable_if<dim_==2, int>::type& index)  const
+  void operator()(const typename std::enable_if<dim_==2, int>::type& i,
+                  const int& j) const
   {
 
     const int isize = this->params.isize;
@@ -76,7 +77,7 @@ public:
     const real_t dx = this->params.dx;
     const real_t dy = this->params.dy;
 
-    const real_t nbvar = this->params.nbvar;
+    const int nbvar = NbVar<dim>::value;
 
     // riemann solver states left/right (conservative variables),
     // one for each quadrature point
@@ -89,9 +90,6 @@ public:
     // accumulate flux over all quadrature points
     HydroState rec1, rec2;
     
-    int i,j;
-    index2coord(index,i,j,isize,jsize);
-
     /*********************
      * along DIR_X
      *********************/
@@ -209,7 +207,9 @@ public:
   /************* UNFINISHED - TODO ***************/
   template<int dim_ = dim>
   KOKKOS_INLINE_FUNCTION
-  void operator()(const typename std::enable_if<dim_==3, int>::type& index) const
+  void operator()(const typename std::enable_if<dim_==3, int>::type& i,
+                  const int& j,
+                  const int& k) const
   {
     
   }  // end functor 3d
@@ -45,122 +45,99 @@ public:
   //! functor for 2d 
   template<int dim_ = dim>
   KOKKOS_INLINE_FUNCTION
-  void operator()(const typename std::enable_if<dim_==2, int>::type& index)  const
+  void operator()(const typename std::enable_if<dim_==2, int>::type& i,
+                  const int& j) const
   {
-    const int isize = params.isize;
-    const int jsize = params.jsize;
-    const int ghostWidth = params.ghostWidth;
-    
-    int i,j;
-    index2coord(index,i,j,isize,jsize);
-
     HydroState tmp;
     
-    if(j >= ghostWidth && j < jsize-ghostWidth  &&
-       i >= ghostWidth && i < isize-ghostWidth ) {
-
-      tmp[ID] = UOld(i,j,ID);
-      tmp[IP] = UOld(i,j,IP);
-      tmp[IU] = UOld(i,j,IU);
-      tmp[IV] = UOld(i,j,IV);
-
-      tmp[ID] += FluxData_x(i  ,j  , ID);
-      tmp[IP] += FluxData_x(i  ,j  , IP);
-      tmp[IU] += FluxData_x(i  ,j  , IU);
-      tmp[IV] += FluxData_x(i  ,j  , IV);
-
-      tmp[ID] -= FluxData_x(i+1,j  , ID);
-      tmp[IP] -= FluxData_x(i+1,j  , IP);
-      tmp[IU] -= FluxData_x(i+1,j  , IU);
-      tmp[IV] -= FluxData_x(i+1,j  , IV);
+    tmp[ID] = UOld(i,j,ID);
+    tmp[IP] = UOld(i,j,IP);
+    tmp[IU] = UOld(i,j,IU);
+    tmp[IV] = UOld(i,j,IV);
+
+    tmp[ID] += FluxData_x(i  ,j  , ID);
+    tmp[IP] += FluxData_x(i  ,j  , IP);
+    tmp[IU] += FluxData_x(i  ,j  , IU);
+    tmp[IV] += FluxData_x(i  ,j  , IV);
+
+    tmp[ID] -= FluxData_x(i+1,j  , ID);
+    tmp[IP] -= FluxData_x(i+1,j  , IP);
+    tmp[IU] -= FluxData_x(i+1,j  , IU);
+    tmp[IV] -= FluxData_x(i+1,j  , IV);
       
-      tmp[ID] += FluxData_y(i  ,j  , ID);
-      tmp[IP] += FluxData_y(i  ,j  , IP);
-      tmp[IU] += FluxData_y(i  ,j  , IU);
-      tmp[IV] += FluxData_y(i  ,j  , IV);
+    tmp[ID] += FluxData_y(i  ,j  , ID);
+    tmp[IP] += FluxData_y(i  ,j  , IP);
+    tmp[IU] += FluxData_y(i  ,j  , IU);
+    tmp[IV] += FluxData_y(i  ,j  , IV);
       
-      tmp[ID] -= FluxData_y(i  ,j+1, ID);
-      tmp[IP] -= FluxData_y(i  ,j+1, IP);
-      tmp[IU] -= FluxData_y(i  ,j+1, IU);
-      tmp[IV] -= FluxData_y(i  ,j+1, IV);
-
-      UNew(i,j,ID) = tmp[ID];
-      UNew(i,j,IP) = tmp[IP];
-      UNew(i,j,IU) = tmp[IU];
-      UNew(i,j,IV) = tmp[IV];
-      
-    } // end if
+    tmp[ID] -= FluxData_y(i  ,j+1, ID);
+    tmp[IP] -= FluxData_y(i  ,j+1, IP);
+    tmp[IU] -= FluxData_y(i  ,j+1, IU);
+    tmp[IV] -= FluxData_y(i  ,j+1, IV);
+
+    UNew(i,j,ID) = tmp[ID];
+    UNew(i,j,IP) = tmp[IP];
+    UNew(i,j,IU) = tmp[IU];
+    UNew(i,j,IV) = tmp[IV];
     
   } // end operator ()
   
   //! functor for 3d 
   template<int dim_ = dim>
   KOKKOS_INLINE_FUNCTION
-  void operator()(const typename std::enable_if<dim_==3, int>::type& index)  const
+  void operator()(const typename std::enable_if<dim_==3, int>::type& i,
+                  const int& j,
+                  const int& k) const
   {
-    const int isize = params.isize;
-    const int jsize = params.jsize;
-    const int ksize = params.ksize;
-    const int ghostWidth = params.ghostWidth;
-    
-    int i,j,k;
-    index2coord(index,i,j,k,isize,jsize,ksize);
-
     HydroState tmp;
 
-    if(k >= ghostWidth && k < ksize-ghostWidth  &&
-       j >= ghostWidth && j < jsize-ghostWidth  &&
-       i >= ghostWidth && i < isize-ghostWidth ) {
-
-      tmp[ID] = UOld(i,j,k,ID);
-      tmp[IP] = UOld(i,j,k,IP);
-      tmp[IU] = UOld(i,j,k,IU);
-      tmp[IV] = UOld(i,j,k,IV);
-      tmp[IW] = UOld(i,j,k,IW);
-
-      tmp[ID] += FluxData_x(i  ,j  ,k  , ID);
-      tmp[IP] += FluxData_x(i  ,j  ,k  , IP);
-      tmp[IU] += FluxData_x(i  ,j  ,k  , IU);
-      tmp[IV] += FluxData_x(i  ,j  ,k  , IV);
-      tmp[IW] += FluxData_x(i  ,j  ,k  , IW);
-
-      tmp[ID] -= FluxData_x(i+1,j  ,k  , ID);
-      tmp[IP] -= FluxData_x(i+1,j  ,k  , IP);
-      tmp[IU] -= FluxData_x(i+1,j  ,k  , IU);
-      tmp[IV] -= FluxData_x(i+1,j  ,k  , IV);
-      tmp[IW] -= FluxData_x(i+1,j  ,k  , IW);
+    tmp[ID] = UOld(i,j,k,ID);
+    tmp[IP] = UOld(i,j,k,IP);
+    tmp[IU] = UOld(i,j,k,IU);
+    tmp[IV] = UOld(i,j,k,IV);
+    tmp[IW] = UOld(i,j,k,IW);
+
+    tmp[ID] += FluxData_x(i  ,j  ,k  , ID);
+    tmp[IP] += FluxData_x(i  ,j  ,k  , IP);
+    tmp[IU] += FluxData_x(i  ,j  ,k  , IU);
+    tmp[IV] += FluxData_x(i  ,j  ,k  , IV);
+    tmp[IW] += FluxData_x(i  ,j  ,k  , IW);
+
+    tmp[ID] -= FluxData_x(i+1,j  ,k  , ID);
+    tmp[IP] -= FluxData_x(i+1,j  ,k  , IP);
+    tmp[IU] -= FluxData_x(i+1,j  ,k  , IU);
+    tmp[IV] -= FluxData_x(i+1,j  ,k  , IV);
+    tmp[IW] -= FluxData_x(i+1,j  ,k  , IW);
       
-      tmp[ID] += FluxData_y(i  ,j  ,k  , ID);
-      tmp[IP] += FluxData_y(i  ,j  ,k  , IP);
-      tmp[IU] += FluxData_y(i  ,j  ,k  , IU);
-      tmp[IV] += FluxData_y(i  ,j  ,k  , IV);
-      tmp[IW] += FluxData_y(i  ,j  ,k  , IW);
+    tmp[ID] += FluxData_y(i  ,j  ,k  , ID);
+    tmp[IP] += FluxData_y(i  ,j  ,k  , IP);
+    tmp[IU] += FluxData_y(i  ,j  ,k  , IU);
+    tmp[IV] += FluxData_y(i  ,j  ,k  , IV);
+    tmp[IW] += FluxData_y(i  ,j  ,k  , IW);
       
-      tmp[ID] -= FluxData_y(i  ,j+1,k  , ID);
-      tmp[IP] -= FluxData_y(i  ,j+1,k  , IP);
-      tmp[IU] -= FluxData_y(i  ,j+1,k  , IU);
-      tmp[IV] -= FluxData_y(i  ,j+1,k  , IV);
-      tmp[IW] -= FluxData_y(i  ,j+1,k  , IW);
-
-      tmp[ID] += FluxData_z(i  ,j  ,k  , ID);
-      tmp[IP] += FluxData_z(i  ,j  ,k  , IP);
-      tmp[IU] += FluxData_z(i  ,j  ,k  , IU);
-      tmp[IV] += FluxData_z(i  ,j  ,k  , IV);
-      tmp[IW] += FluxData_z(i  ,j  ,k  , IW);
-
-      tmp[ID] -= FluxData_z(i  ,j  ,k+1, ID);
-      tmp[IP] -= FluxData_z(i  ,j  ,k+1, IP);
-      tmp[IU] -= FluxData_z(i  ,j  ,k+1, IU);
-      tmp[IV] -= FluxData_z(i  ,j  ,k+1, IV);
-      tmp[IW] -= FluxData_z(i  ,j  ,k+1, IW);
-
-      UNew(i,j,k,ID) = tmp[ID];
-      UNew(i,j,k,IP) = tmp[IP];
-      UNew(i,j,k,IU) = tmp[IU];
-      UNew(i,j,k,IV) = tmp[IV];
-      UNew(i,j,k,IW) = tmp[IW];
-
-    } // end if
+    tmp[ID] -= FluxData_y(i  ,j+1,k  , ID);
+    tmp[IP] -= FluxData_y(i  ,j+1,k  , IP);
+    tmp[IU] -= FluxData_y(i  ,j+1,k  , IU);
+    tmp[IV] -= FluxData_y(i  ,j+1,k  , IV);
+    tmp[IW] -= FluxData_y(i  ,j+1,k  , IW);
+
+    tmp[ID] += FluxData_z(i  ,j  ,k  , ID);
+    tmp[IP] += FluxData_z(i  ,j  ,k  , IP);
+    tmp[IU] += FluxData_z(i  ,j  ,k  , IU);
+    tmp[IV] += FluxData_z(i  ,j  ,k  , IV);
+    tmp[IW] += FluxData_z(i  ,j  ,k  , IW);
+
+    tmp[ID] -= FluxData_z(i  ,j  ,k+1, ID);
+    tmp[IP] -= FluxData_z(i  ,j  ,k+1, IP);
+    tmp[IU] -= FluxData_z(i  ,j  ,k+1, IU);
+    tmp[IV] -= FluxData_z(i  ,j  ,k+1, IV);
+    tmp[IW] -= FluxData_z(i  ,j  ,k+1, IW);
+
+    UNew(i,j,k,ID) = tmp[ID];
+    UNew(i,j,k,IP) = tmp[IP];
+    UNew(i,j,k,IU) = tmp[IU];
+    UNew(i,j,k,IV) = tmp[IV];
+    UNew(i,j,k,IW) = tmp[IW];
     
   } // end operator ()
   
@@ -211,122 +188,99 @@ public:
   //! functor for 2d 
   template<int dim_ = dim>
   KOKKOS_INLINE_FUNCTION
-  void operator()(const typename std::enable_if<dim_==2, int>::type& index)  const
+  void operator()(const typename std::enable_if<dim_==2, int>::type& i,
+                  const int& j) const
   {
-    const int isize = params.isize;
-    const int jsize = params.jsize;
-    const int ghostWidth = params.ghostWidth;
-    
-    int i,j;
-    index2coord(index,i,j,isize,jsize);
-
     HydroState tmp;
     
-    if(j >= ghostWidth && j < jsize-ghostWidth  &&
-       i >= ghostWidth && i < isize-ghostWidth ) {
-
-      tmp[ID] = UOld(i,j,ID) + URK(i,j,ID);
-      tmp[IP] = UOld(i,j,IP) + URK(i,j,IP);
-      tmp[IU] = UOld(i,j,IU) + URK(i,j,IU);
-      tmp[IV] = UOld(i,j,IV) + URK(i,j,IV);
-
-      tmp[ID] += FluxData_x(i  ,j  , ID);
-      tmp[IP] += FluxData_x(i  ,j  , IP);
-      tmp[IU] += FluxData_x(i  ,j  , IU);
-      tmp[IV] += FluxData_x(i  ,j  , IV);
-
-      tmp[ID] -= FluxData_x(i+1,j  , ID);
-      tmp[IP] -= FluxData_x(i+1,j  , IP);
-      tmp[IU] -= FluxData_x(i+1,j  , IU);
-      tmp[IV] -= FluxData_x(i+1,j  , IV);
+    tmp[ID] = UOld(i,j,ID) + URK(i,j,ID);
+    tmp[IP] = UOld(i,j,IP) + URK(i,j,IP);
+    tmp[IU] = UOld(i,j,IU) + URK(i,j,IU);
+    tmp[IV] = UOld(i,j,IV) + URK(i,j,IV);
+
+    tmp[ID] += FluxData_x(i  ,j  , ID);
+    tmp[IP] += FluxData_x(i  ,j  , IP);
+    tmp[IU] += FluxData_x(i  ,j  , IU);
+    tmp[IV] += FluxData_x(i  ,j  , IV);
+
+    tmp[ID] -= FluxData_x(i+1,j  , ID);
+    tmp[IP] -= FluxData_x(i+1,j  , IP);
+    tmp[IU] -= FluxData_x(i+1,j  , IU);
+    tmp[IV] -= FluxData_x(i+1,j  , IV);
       
-      tmp[ID] += FluxData_y(i  ,j  , ID);
-      tmp[IP] += FluxData_y(i  ,j  , IP);
-      tmp[IU] += FluxData_y(i  ,j  , IU);
-      tmp[IV] += FluxData_y(i  ,j  , IV);
+    tmp[ID] += FluxData_y(i  ,j  , ID);
+    tmp[IP] += FluxData_y(i  ,j  , IP);
+    tmp[IU] += FluxData_y(i  ,j  , IU);
+    tmp[IV] += FluxData_y(i  ,j  , IV);
       
-      tmp[ID] -= FluxData_y(i  ,j+1, ID);
-      tmp[IP] -= FluxData_y(i  ,j+1, IP);
-      tmp[IU] -= FluxData_y(i  ,j+1, IU);
-      tmp[IV] -= FluxData_y(i  ,j+1, IV);
-
-      UNew(i,j,ID) = 0.5*tmp[ID];
-      UNew(i,j,IP) = 0.5*tmp[IP];
-      UNew(i,j,IU) = 0.5*tmp[IU];
-      UNew(i,j,IV) = 0.5*tmp[IV];
-      
-    } // end if
+    tmp[ID] -= FluxData_y(i  ,j+1, ID);
+    tmp[IP] -= FluxData_y(i  ,j+1, IP);
+    tmp[IU] -= FluxData_y(i  ,j+1, IU);
+    tmp[IV] -= FluxData_y(i  ,j+1, IV);
+
+    UNew(i,j,ID) = 0.5*tmp[ID];
+    UNew(i,j,IP) = 0.5*tmp[IP];
+    UNew(i,j,IU) = 0.5*tmp[IU];
+    UNew(i,j,IV) = 0.5*tmp[IV];
     
   } // end operator ()
   
   //! functor for 3d 
   template<int dim_ = dim>
   KOKKOS_INLINE_FUNCTION
-  void operator()(const typename std::enable_if<dim_==3, int>::type& index)  const
+  void operator()(const typename std::enable_if<dim_==3, int>::type& i,
+                  const int& j,
+                  const int& k) const
   {
-    const int isize = params.isize;
-    const int jsize = params.jsize;
-    const int ksize = params.ksize;
-    const int ghostWidth = params.ghostWidth;
-    
-    int i,j,k;
-    index2coord(index,i,j,k,isize,jsize,ksize);
-
     HydroState tmp;
 
-    if(k >= ghostWidth && k < ksize-ghostWidth  &&
-       j >= ghostWidth && j < jsize-ghostWidth  &&
-       i >= ghostWidth && i < isize-ghostWidth ) {
-
-      tmp[ID] = UOld(i,j,k,ID) + URK(i,j,k,ID);
-      tmp[IP] = UOld(i,j,k,IP) + URK(i,j,k,IP);
-      tmp[IU] = UOld(i,j,k,IU) + URK(i,j,k,IU);
-      tmp[IV] = UOld(i,j,k,IV) + URK(i,j,k,IV);
-      tmp[IW] = UOld(i,j,k,IW) + URK(i,j,k,IW);
-
-      tmp[ID] += FluxData_x(i  ,j  ,k  , ID);
-      tmp[IP] += FluxData_x(i  ,j  ,k  , IP);
-      tmp[IU] += FluxData_x(i  ,j  ,k  , IU);
-      tmp[IV] += FluxData_x(i  ,j  ,k  , IV);
-      tmp[IW] += FluxData_x(i  ,j  ,k  , IW);
-
-      tmp[ID] -= FluxData_x(i+1,j  ,k  , ID);
-      tmp[IP] -= FluxData_x(i+1,j  ,k  , IP);
-      tmp[IU] -= FluxData_x(i+1,j  ,k  , IU);
-      tmp[IV] -= FluxData_x(i+1,j  ,k  , IV);
-      tmp[IW] -= FluxData_x(i+1,j  ,k  , IW);
+    tmp[ID] = UOld(i,j,k,ID) + URK(i,j,k,ID);
+    tmp[IP] = UOld(i,j,k,IP) + URK(i,j,k,IP);
+    tmp[IU] = UOld(i,j,k,IU) + URK(i,j,k,IU);
+    tmp[IV] = UOld(i,j,k,IV) + URK(i,j,k,IV);
+    tmp[IW] = UOld(i,j,k,IW) + URK(i,j,k,IW);
+
+    tmp[ID] += FluxData_x(i  ,j  ,k  , ID);
+    tmp[IP] += FluxData_x(i  ,j  ,k  , IP);
+    tmp[IU] += FluxData_x(i  ,j  ,k  , IU);
+    tmp[IV] += FluxData_x(i  ,j  ,k  , IV);
+    tmp[IW] += FluxData_x(i  ,j  ,k  , IW);
+
+    tmp[ID] -= FluxData_x(i+1,j  ,k  , ID);
+    tmp[IP] -= FluxData_x(i+1,j  ,k  , IP);
+    tmp[IU] -= FluxData_x(i+1,j  ,k  , IU);
+    tmp[IV] -= FluxData_x(i+1,j  ,k  , IV);
+    tmp[IW] -= FluxData_x(i+1,j  ,k  , IW);
       
-      tmp[ID] += FluxData_y(i  ,j  ,k  , ID);
-      tmp[IP] += FluxData_y(i  ,j  ,k  , IP);
-      tmp[IU] += FluxData_y(i  ,j  ,k  , IU);
-      tmp[IV] += FluxData_y(i  ,j  ,k  , IV);
-      tmp[IW] += FluxData_y(i  ,j  ,k  , IW);
+    tmp[ID] += FluxData_y(i  ,j  ,k  , ID);
+    tmp[IP] += FluxData_y(i  ,j  ,k  , IP);
+    tmp[IU] += FluxData_y(i  ,j  ,k  , IU);
+    tmp[IV] += FluxData_y(i  ,j  ,k  , IV);
+    tmp[IW] += FluxData_y(i  ,j  ,k  , IW);
       
-      tmp[ID] -= FluxData_y(i  ,j+1,k  , ID);
-      tmp[IP] -= FluxData_y(i  ,j+1,k  , IP);
-      tmp[IU] -= FluxData_y(i  ,j+1,k  , IU);
-      tmp[IV] -= FluxData_y(i  ,j+1,k  , IV);
-      tmp[IW] -= FluxData_y(i  ,j+1,k  , IW);
-
-      tmp[ID] += FluxData_z(i  ,j  ,k  , ID);
-      tmp[IP] += FluxData_z(i  ,j  ,k  , IP);
-      tmp[IU] += FluxData_z(i  ,j  ,k  , IU);
-      tmp[IV] += FluxData_z(i  ,j  ,k  , IV);
-      tmp[IW] += FluxData_z(i  ,j  ,k  , IW);
-
-      tmp[ID] -= FluxData_z(i  ,j  ,k+1, ID);
-      tmp[IP] -= FluxData_z(i  ,j  ,k+1, IP);
-      tmp[IU] -= FluxData_z(i  ,j  ,k+1, IU);
-      tmp[IV] -= FluxData_z(i  ,j  ,k+1, IV);
-      tmp[IW] -= FluxData_z(i  ,j  ,k+1, IW);
-
-      UNew(i,j,k,ID) = 0.5*tmp[ID];
-      UNew(i,j,k,IP) = 0.5*tmp[IP];
-      UNew(i,j,k,IU) = 0.5*tmp[IU];
-      UNew(i,j,k,IV) = 0.5*tmp[IV];
-      UNew(i,j,k,IW) = 0.5*tmp[IW];
-
-    } // end if
+    tmp[ID] -= FluxData_y(i  ,j+1,k  , ID);
+    tmp[IP] -= FluxData_y(i  ,j+1,k  , IP);
+    tmp[IU] -= FluxData_y(i  ,j+1,k  , IU);
+    tmp[IV] -= FluxData_y(i  ,j+1,k  , IV);
+    tmp[IW] -= FluxData_y(i  ,j+1,k  , IW);
+
+    tmp[ID] += FluxData_z(i  ,j  ,k  , ID);
+    tmp[IP] += FluxData_z(i  ,j  ,k  , IP);
+    tmp[IU] += FluxData_z(i  ,j  ,k  , IU);
+    tmp[IV] += FluxData_z(i  ,j  ,k  , IV);
+    tmp[IW] += FluxData_z(i  ,j  ,k  , IW);
+
+    tmp[ID] -= FluxData_z(i  ,j  ,k+1, ID);
+    tmp[IP] -= FluxData_z(i  ,j  ,k+1, IP);
+    tmp[IU] -= FluxData_z(i  ,j  ,k+1, IU);
+    tmp[IV] -= FluxData_z(i  ,j  ,k+1, IV);
+    tmp[IW] -= FluxData_z(i  ,j  ,k+1, IW);
+
+    UNew(i,j,k,ID) = 0.5*tmp[ID];
+    UNew(i,j,k,IP) = 0.5*tmp[IP];
+    UNew(i,j,k,IU) = 0.5*tmp[IU];
+    UNew(i,j,k,IV) = 0.5*tmp[IV];
+    UNew(i,j,k,IW) = 0.5*tmp[IW];
     
   } // end operator ()
   
@@ -384,124 +338,101 @@ public:
   //! functor for 2d 
   template<int dim_ = dim>
   KOKKOS_INLINE_FUNCTION
-  void operator()(const typename std::enable_if<dim_==2, int>::type& index)  const
+  void operator()(const typename std::enable_if<dim_==2, int>::type& i,
+                  const int& j) const
   {
-    const int isize = params.isize;
-    const int jsize = params.jsize;
-    const int ghostWidth = params.ghostWidth;
-    
-    int i,j;
-    index2coord(index,i,j,isize,jsize);
-
     HydroState tmp;
     HydroState tmp2;
     
-    if(j >= ghostWidth && j < jsize-ghostWidth  &&
-       i >= ghostWidth && i < isize-ghostWidth ) {
-
-      tmp[ID] = weight_uold * UOld(i,j,ID) + weight_urk * URK(i,j,ID);
-      tmp[IP] = weight_uold * UOld(i,j,IP) + weight_urk * URK(i,j,IP);
-      tmp[IU] = weight_uold * UOld(i,j,IU) + weight_urk * URK(i,j,IU);
-      tmp[IV] = weight_uold * UOld(i,j,IV) + weight_urk * URK(i,j,IV);
-
-      tmp2[ID] = FluxData_x(i  ,j  , ID);
-      tmp2[IP] = FluxData_x(i  ,j  , IP);
-      tmp2[IU] = FluxData_x(i  ,j  , IU);
-      tmp2[IV] = FluxData_x(i  ,j  , IV);
-
-      tmp2[ID] -= FluxData_x(i+1,j  , ID);
-      tmp2[IP] -= FluxData_x(i+1,j  , IP);
-      tmp2[IU] -= FluxData_x(i+1,j  , IU);
-      tmp2[IV] -= FluxData_x(i+1,j  , IV);
-      
-      tmp2[ID] += FluxData_y(i  ,j  , ID);
-      tmp2[IP] += FluxData_y(i  ,j  , IP);
-      tmp2[IU] += FluxData_y(i  ,j  , IU);
-      tmp2[IV] += FluxData_y(i  ,j  , IV);
+    tmp[ID] = weight_uold * UOld(i,j,ID) + weight_urk * URK(i,j,ID);
+    tmp[IP] = weight_uold * UOld(i,j,IP) + weight_urk * URK(i,j,IP);
+    tmp[IU] = weight_uold * UOld(i,j,IU) + weight_urk * URK(i,j,IU);
+    tmp[IV] = weight_uold * UOld(i,j,IV) + weight_urk * URK(i,j,IV);
+
+    tmp2[ID] = FluxData_x(i  ,j  , ID);
+    tmp2[IP] = FluxData_x(i  ,j  , IP);
+    tmp2[IU] = FluxData_x(i  ,j  , IU);
+    tmp2[IV] = FluxData_x(i  ,j  , IV);
+
+    tmp2[ID] -= FluxData_x(i+1,j  , ID);
+    tmp2[IP] -= FluxData_x(i+1,j  , IP);
+    tmp2[IU] -= FluxData_x(i+1,j  , IU);
+    tmp2[IV] -= FluxData_x(i+1,j  , IV);
       
-      tmp2[ID] -= FluxData_y(i  ,j+1, ID);
-      tmp2[IP] -= FluxData_y(i  ,j+1, IP);
-      tmp2[IU] -= FluxData_y(i  ,j+1, IU);
-      tmp2[IV] -= FluxData_y(i  ,j+1, IV);
-
-      UNew(i,j,ID) = tmp[ID] + weight_flux * tmp2[ID];
-      UNew(i,j,IP) = tmp[IP] + weight_flux * tmp2[IP];
-      UNew(i,j,IU) = tmp[IU] + weight_flux * tmp2[IU];
-      UNew(i,j,IV) = tmp[IV] + weight_flux * tmp2[IV];
+    tmp2[ID] += FluxData_y(i  ,j  , ID);
+    tmp2[IP] += FluxData_y(i  ,j  , IP);
+    tmp2[IU] += FluxData_y(i  ,j  , IU);
+    tmp2[IV] += FluxData_y(i  ,j  , IV);
       
-    } // end if
+    tmp2[ID] -= FluxData_y(i  ,j+1, ID);
+    tmp2[IP] -= FluxData_y(i  ,j+1, IP);
+    tmp2[IU] -= FluxData_y(i  ,j+1, IU);
+    tmp2[IV] -= FluxData_y(i  ,j+1, IV);
+
+    UNew(i,j,ID) = tmp[ID] + weight_flux * tmp2[ID];
+    UNew(i,j,IP) = tmp[IP] + weight_flux * tmp2[IP];
+    UNew(i,j,IU) = tmp[IU] + weight_flux * tmp2[IU];
+    UNew(i,j,IV) = tmp[IV] + weight_flux * tmp2[IV];
     
   } // end operator ()
   
   //! functor for 3d 
   template<int dim_ = dim>
   KOKKOS_INLINE_FUNCTION
-  void operator()(const typename std::enable_if<dim_==3, int>::type& index)  const
+  void operator()(const typename std::enable_if<dim_==3, int>::type& i,
+                  const int& j,
+                  const int& k) const
   {
-    const int isize = params.isize;
-    const int jsize = params.jsize;
-    const int ksize = params.ksize;
-    const int ghostWidth = params.ghostWidth;
-    
-    int i,j,k;
-    index2coord(index,i,j,k,isize,jsize,ksize);
-
     HydroState tmp;
     HydroState tmp2;
 
-    if(k >= ghostWidth && k < ksize-ghostWidth  &&
-       j >= ghostWidth && j < jsize-ghostWidth  &&
-       i >= ghostWidth && i < isize-ghostWidth ) {
-
-      tmp[ID] = weight_uold * UOld(i,j,k,ID) + weight_urk * URK(i,j,k,ID);
-      tmp[IP] = weight_uold * UOld(i,j,k,IP) + weight_urk * URK(i,j,k,IP);
-      tmp[IU] = weight_uold * UOld(i,j,k,IU) + weight_urk * URK(i,j,k,IU);
-      tmp[IV] = weight_uold * UOld(i,j,k,IV) + weight_urk * URK(i,j,k,IV);
-      tmp[IW] = weight_uold * UOld(i,j,k,IW) + weight_urk * URK(i,j,k,IW);
-
-      tmp2[ID]  = FluxData_x(i  ,j  ,k  , ID);
-      tmp2[IP]  = FluxData_x(i  ,j  ,k  , IP);
-      tmp2[IU]  = FluxData_x(i  ,j  ,k  , IU);
-      tmp2[IV]  = FluxData_x(i  ,j  ,k  , IV);
-      tmp2[IW]  = FluxData_x(i  ,j  ,k  , IW);
-
-      tmp2[ID] -= FluxData_x(i+1,j  ,k  , ID);
-      tmp2[IP] -= FluxData_x(i+1,j  ,k  , IP);
-      tmp2[IU] -= FluxData_x(i+1,j  ,k  , IU);
-      tmp2[IV] -= FluxData_x(i+1,j  ,k  , IV);
-      tmp2[IW] -= FluxData_x(i+1,j  ,k  , IW);
+    tmp[ID] = weight_uold * UOld(i,j,k,ID) + weight_urk * URK(i,j,k,ID);
+    tmp[IP] = weight_uold * UOld(i,j,k,IP) + weight_urk * URK(i,j,k,IP);
+    tmp[IU] = weight_uold * UOld(i,j,k,IU) + weight_urk * URK(i,j,k,IU);
+    tmp[IV] = weight_uold * UOld(i,j,k,IV) + weight_urk * URK(i,j,k,IV);
+    tmp[IW] = weight_uold * UOld(i,j,k,IW) + weight_urk * URK(i,j,k,IW);
+
+    tmp2[ID]  = FluxData_x(i  ,j  ,k  , ID);
+    tmp2[IP]  = FluxData_x(i  ,j  ,k  , IP);
+    tmp2[IU]  = FluxData_x(i  ,j  ,k  , IU);
+    tmp2[IV]  = FluxData_x(i  ,j  ,k  , IV);
+    tmp2[IW]  = FluxData_x(i  ,j  ,k  , IW);
+
+    tmp2[ID] -= FluxData_x(i+1,j  ,k  , ID);
+    tmp2[IP] -= FluxData_x(i+1,j  ,k  , IP);
+    tmp2[IU] -= FluxData_x(i+1,j  ,k  , IU);
+    tmp2[IV] -= FluxData_x(i+1,j  ,k  , IV);
+    tmp2[IW] -= FluxData_x(i+1,j  ,k  , IW);
       
-      tmp2[ID] += FluxData_y(i  ,j  ,k  , ID);
-      tmp2[IP] += FluxData_y(i  ,j  ,k  , IP);
-      tmp2[IU] += FluxData_y(i  ,j  ,k  , IU);
-      tmp2[IV] += FluxData_y(i  ,j  ,k  , IV);
-      tmp2[IW] += FluxData_y(i  ,j  ,k  , IW);
+    tmp2[ID] += FluxData_y(i  ,j  ,k  , ID);
+    tmp2[IP] += FluxData_y(i  ,j  ,k  , IP);
+    tmp2[IU] += FluxData_y(i  ,j  ,k  , IU);
+    tmp2[IV] += FluxData_y(i  ,j  ,k  , IV);
+    tmp2[IW] += FluxData_y(i  ,j  ,k  , IW);
       
-      tmp2[ID] -= FluxData_y(i  ,j+1,k  , ID);
-      tmp2[IP] -= FluxData_y(i  ,j+1,k  , IP);
-      tmp2[IU] -= FluxData_y(i  ,j+1,k  , IU);
-      tmp2[IV] -= FluxData_y(i  ,j+1,k  , IV);
-      tmp2[IW] -= FluxData_y(i  ,j+1,k  , IW);
-
-      tmp2[ID] += FluxData_z(i  ,j  ,k  , ID);
-      tmp2[IP] += FluxData_z(i  ,j  ,k  , IP);
-      tmp2[IU] += FluxData_z(i  ,j  ,k  , IU);
-      tmp2[IV] += FluxData_z(i  ,j  ,k  , IV);
-      tmp2[IW] += FluxData_z(i  ,j  ,k  , IW);
-
-      tmp2[ID] -= FluxData_z(i  ,j  ,k+1, ID);
-      tmp2[IP] -= FluxData_z(i  ,j  ,k+1, IP);
-      tmp2[IU] -= FluxData_z(i  ,j  ,k+1, IU);
-      tmp2[IV] -= FluxData_z(i  ,j  ,k+1, IV);
-      tmp2[IW] -= FluxData_z(i  ,j  ,k+1, IW);
-
-      UNew(i,j,k,ID) = tmp[ID] + weight_flux * tmp2[ID];
-      UNew(i,j,k,IP) = tmp[IP] + weight_flux * tmp2[IP];
-      UNew(i,j,k,IU) = tmp[IU] + weight_flux * tmp2[IU];
-      UNew(i,j,k,IV) = tmp[IV] + weight_flux * tmp2[IV];
-      UNew(i,j,k,IW) = tmp[IW] + weight_flux * tmp2[IW];
-
-    } // end if
+    tmp2[ID] -= FluxData_y(i  ,j+1,k  , ID);
+    tmp2[IP] -= FluxData_y(i  ,j+1,k  , IP);
+    tmp2[IU] -= FluxData_y(i  ,j+1,k  , IU);
+    tmp2[IV] -= FluxData_y(i  ,j+1,k  , IV);
+    tmp2[IW] -= FluxData_y(i  ,j+1,k  , IW);
+
+    tmp2[ID] += FluxData_z(i  ,j  ,k  , ID);
+    tmp2[IP] += FluxData_z(i  ,j  ,k  , IP);
+    tmp2[IU] += FluxData_z(i  ,j  ,k  , IU);
+    tmp2[IV] += FluxData_z(i  ,j  ,k  , IV);
+    tmp2[IW] += FluxData_z(i  ,j  ,k  , IW);
+
+    tmp2[ID] -= FluxData_z(i  ,j  ,k+1, ID);
+    tmp2[IP] -= FluxData_z(i  ,j  ,k+1, IP);
+    tmp2[IU] -= FluxData_z(i  ,j  ,k+1, IU);
+    tmp2[IV] -= FluxData_z(i  ,j  ,k+1, IV);
+    tmp2[IW] -= FluxData_z(i  ,j  ,k+1, IW);
+
+    UNew(i,j,k,ID) = tmp[ID] + weight_flux * tmp2[ID];
+    UNew(i,j,k,IP) = tmp[IP] + weight_flux * tmp2[IP];
+    UNew(i,j,k,IU) = tmp[IU] + weight_flux * tmp2[IU];
+    UNew(i,j,k,IV) = tmp[IV] + weight_flux * tmp2[IV];
+    UNew(i,j,k,IW) = tmp[IW] + weight_flux * tmp2[IW];
     
   } // end operator ()
   
@@ -555,15 +486,13 @@ public:
   //! functor for 2d 
   template<int dim_ = dim>
   KOKKOS_INLINE_FUNCTION
-  void operator()(const typename std::enable_if<dim_==2, int>::type& index) const
+  void operator()(const typename std::enable_if<dim_==2, int>::type& i,
+                  const int& j) const
   {
     const int isize = this->params.isize;
     const int jsize = this->params.jsize;
     const int ghostWidth = this->params.ghostWidth;
     
-    int i,j;
-    index2coord(index,i,j,isize,jsize);
-
     // set flags to zero
     Flags(i,j,0) = 0.0;
 
@@ -626,7 +555,9 @@ public:
   //! functor for 3d 
   template<int dim_ = dim>
   KOKKOS_INLINE_FUNCTION
-  void operator()(const typename std::enable_if<dim_==3, int>::type& index) const
+  void operator()(const typename std::enable_if<dim_==3, int>::type& i,
+                  const int& j,
+                  const int& k) const
   {
 
     const int isize = this->params.isize;
@@ -634,9 +565,6 @@ public:
     const int ksize = this->params.ksize;
     const int ghostWidth = this->params.ghostWidth;
     
-    int i,j,k;
-    index2coord(index,i,j,k,isize,jsize,ksize);
-
     // set flags to zero
     Flags(i,j,k,0) = 0.0;
 
@@ -69,6 +69,9 @@ public:
   //! Data array typedef for host memory space
   using DataArrayHost = typename std::conditional<dim==2,DataArray2dHost,DataArray3dHost>::type;
 
+  //! Range policy over (i,j) in 2d, (i,j,k) in 3d
+  using MDPolicy = typename std::conditional<dim==2,MDPolicy2d,MDPolicy3d>::type;
+
   //! total number of coefficients in the polynomial
   static const int ncoefs =  mood::binomial<dim+degree,dim>();
 
@@ -186,6 +189,19 @@ public:
   template<int dim_=dim>
   void make_boundaries(typename std::enable_if<dim_==3,DataArray3d>::type Udata);
 
+  //! boundaries before a Runge-Kutta stage : with deep halos, MPI ghost
+  //! cells are exchanged only once every few stages, physical boundaries
+  //! are filled at every stage (see SolverBase::deep_halo_stage)
+  void make_boundaries_stage(DataArray Udata);
+
+  //! range policy over all cells, ghost cells included
+  MDPolicy all_cells_policy() const;
+
+  //! range policy over the interior of the current stage grid (see
+  //! m_stage_params), extended by lo ghost layers on the left side and
+  //! by hi ghost layers on the right side along each direction
+  MDPolicy stage_policy(int lo, int hi) const;
+
   // host routines (initialization)
   void init_implode(DataArray Udata);
   void init_blast(DataArray Udata);
@@ -196,6 +212,18 @@ public:
   
   void save_solution_impl();
 
+  void run_analysis_impl();
+
+  void save_streams_impl();
+
+#ifdef USE_MPI
+  //! dynamic load balancing : migrate current state (U or U2)
+  void load_balancing_migrate(int dir, int shiftMin, int shiftMax);
+
+  //! dynamic load balancing : reallocate work arrays
+  void load_balancing_resize();
+#endif // USE_MPI
+
   // time integration
   bool forward_euler_enabled;
   bool ssprk2_enabled;
@@ -238,6 +266,8 @@ SolverHydroMood<dim,degree>::SolverHydroMood(HydroParams& params,
 
   solver_type = SOLVER_MOOD;
 
+  m_load_balancing_supported = true;
+
   if (dim==3)
     nbCells = params.isize*params.jsize*params.ksize;
   
@@ -374,6 +404,10 @@ SolverHydroMood<dim,degree>::SolverHydroMood(HydroParams& params,
   } else if ( !m_problem_name.compare("wedge") ) {
 
     init_wedge(U);
+
+    // wedge boundaries are not split into physical / MPI faces
+    m_deep_halo_stages = 1;
+    deep_halo_reset();
     
   } else if ( !m_problem_name.compare("isentropic_vortex") ) {
 
@@ -400,6 +434,7 @@ SolverHydroMood<dim,degree>::SolverHydroMood(HydroParams& params,
   std::cout << "SSPRK2        : " << ssprk2_enabled << "\n";
   std::cout << "SSPRK3        : " << ssprk3_enabled << "\n";
   std::cout << "SSPRK54       : " << ssprk54_enabled << "\n";
+  std::cout << "Deep halo stages : " << m_deep_halo_stages << "\n";
   std::cout << "##########################" << "\n";
 
   // print parameters on screen
@@ -741,7 +776,13 @@ double SolverHydroMood<dim,degree>::compute_dt_local()
 
   // call device functor
   ComputeDtFunctor computeDtFunctor(params, monomialMap.data, Udata);
-  Kokkos::parallel_reduce(nbCells, computeDtFunctor, invDt);
+  const int ghostWidth = params.ghostWidth;
+  Kokkos::parallel_reduce("ComputeDtFunctor",
+			  md_policy<dim>(ghostWidth, ghostWidth, ghostWidth,
+					 isize-ghostWidth, jsize-ghostWidth,
+					 ksize-ghostWidth,
+					 params.mdrange_tile),
+			  computeDtFunctor, invDt);
     
   dt = params.settings.cfl/invDt;
 
@@ -787,6 +828,60 @@ void SolverHydroMood<dim,degree>::next_iteration_impl()
   
 } // SolverHydroMood::next_iteration_impl
 
+#ifdef USE_MPI
+// =======================================================
+// =======================================================
+template<int dim, int degree>
+void SolverHydroMood<dim,degree>::load_balancing_migrate(int dir,
+							 int shiftMin,
+							 int shiftMax)
+{
+
+  // U and U2 are swapped every time step, only migrate the one
+  // holding the current state (see time_integration)
+  if ( m_iteration % 2 == 0 )
+    U  = migrate_data(U,  dir, shiftMin, shiftMax);
+  else
+    U2 = migrate_data(U2, dir, shiftMin, shiftMax);
+
+} // SolverHydroMood::load_balancing_migrate
+
+// =======================================================
+// =======================================================
+template<int dim, int degree>
+void SolverHydroMood<dim,degree>::load_balancing_resize()
+{
+
+  isize = params.isize;
+  jsize = params.jsize;
+  ksize = params.ksize;
+  nbCells = dim==2 ? isize*jsize : isize*jsize*ksize;
+  m_nCells = nbCells;
+
+  DataArray& Ucurrent = m_iteration % 2 == 0 ? U  : U2;
+  DataArray& Unext    = m_iteration % 2 == 0 ? U2 : U;
+
+  realloc_domain(Unext);
+  realloc_domain(Fluxes_x);
+  realloc_domain(Fluxes_y);
+  realloc_domain(Fluxes_z);
+  realloc_domain(MoodFlags);
+  for (int ip=0; ip<ncoefs; ++ip)
+    realloc_domain(PolyCoefs[ip]);
+  realloc_domain(U_RK1);
+  realloc_domain(U_RK2);
+  realloc_domain(U_RK3);
+  realloc_domain(U_RK4);
+
+  Uhost = Kokkos::create_mirror(U);
+
+  // fill ghost cells of the migrated state
+  make_boundaries(Ucurrent);
+  Kokkos::deep_copy(Unext, Ucurrent);
+
+} // SolverHydroMood::load_balancing_resize
+#endif // USE_MPI
+
 // =======================================================
 // =======================================================
 // ///////////////////////////////////////////
@@ -817,7 +912,7 @@ void SolverHydroMood<dim,degree>::time_integration_impl(DataArray data_in,
   
   // fill ghost cell in data_in
   timers[TIMER_BOUNDARIES]->start();
-  make_boundaries(data_in);
+  make_boundaries_stage(data_in);
   timers[TIMER_BOUNDARIES]->stop();
     
   // copy data_in into data_out (not necessary)
@@ -872,8 +967,8 @@ void SolverHydroMood<dim,degree>::time_int_forward_euler(DataArray data_in,
   {
     
     ComputeReconstructionPolynomialFunctor<dim,degree,stencilId>
-      functor(params, monomialMap.data, data_in, PolyCoefs, stencil, geomMatrixPI_view);
-    Kokkos::parallel_for(nbCells,functor);
+      functor(m_stage_params, monomialMap.data, data_in, PolyCoefs, stencil, geomMatrixPI_view);
+    Kokkos::parallel_for("ComputeReconstructionPolynomialFunctor", stage_policy(dim==2 ? 1 : 0, 1), functor);
 
     // for (int icoef=0; icoef<ncoefs; ++icoef)
     //   save_data_debug(PolyCoefs[icoef], Uhost, m_times_saved-1, m_t, "poly"+std::to_string(icoef));
@@ -907,7 +1002,7 @@ void SolverHydroMood<dim,degree>::time_int_forward_euler(DataArray data_in,
  
   // compute fluxes
   {
-    ComputeFluxesFunctor<dim,degree, stencilId> functor(params, monomialMap.data,
+    ComputeFluxesFunctor<dim,degree, stencilId> functor(m_stage_params, monomialMap.data,
 							data_in, PolyCoefs,
 							Fluxes_x,
 							Fluxes_y,
@@ -917,7 +1012,7 @@ void SolverHydroMood<dim,degree>::time_int_forward_euler(DataArray data_in,
 							QUAD_LOC_2D,
 							QUAD_LOC_3D,
 							dtdx, dtdy, dtdz);
-    Kokkos::parallel_for(nbCells, functor);
+    Kokkos::parallel_for("ComputeFluxesFunctor", all_cells_policy(), functor);
 
     //save_data_debug(Fluxes_x, Uhost, m_times_saved, m_t, "flux_x");
     //save_data_debug(Fluxes_y, Uhost, m_times_saved, m_t, "flux_y");
@@ -929,23 +1024,23 @@ void SolverHydroMood<dim,degree>::time_int_forward_euler(DataArray data_in,
   // because attemp to update leads to physically invalid values
   // (negative density or pressure)
   {  
-    ComputeMoodFlagsUpdateFunctor<dim,degree> functor(params, monomialMap.data,
+    ComputeMoodFlagsUpdateFunctor<dim,degree> functor(m_stage_params, monomialMap.data,
 						      data_in,
 						      MoodFlags,
 						      Fluxes_x,
 						      Fluxes_y,
 						      Fluxes_z);
-    Kokkos::parallel_for(nbCells, functor);
+    Kokkos::parallel_for("ComputeMoodFlagsUpdateFunctor", all_cells_policy(), functor);
     //save_data_debug(MoodFlags, Uhost, m_times_saved, m_t, "mood_flags");
   }
   
   // recompute fluxes arround flagged cells
   {
-    RecomputeFluxesFunctor<dim,degree> functor(params, monomialMap.data,
+    RecomputeFluxesFunctor<dim,degree> functor(m_stage_params, monomialMap.data,
 					       data_in, MoodFlags,
 					       Fluxes_x, Fluxes_y, Fluxes_z,
 					       dtdx, dtdy, dtdz);
-    Kokkos::parallel_for(nbCells, functor);
+    Kokkos::parallel_for("RecomputeFluxesFunctor", all_cells_policy(), functor);
     //save_data_debug(Fluxes_x, Uhost, m_times_saved, m_t, "flux_x_after");
     //save_data_debug(Fluxes_y, Uhost, m_times_saved, m_t, "flux_y_after");
   }
@@ -954,9 +1049,9 @@ void SolverHydroMood<dim,degree>::time_int_forward_euler(DataArray data_in,
 
   // actual update
   {
-    UpdateFunctor<dim> functor(params, data_in, data_out,
+    UpdateFunctor<dim> functor(m_stage_params, data_in, data_out,
 			       Fluxes_x, Fluxes_y, Fluxes_z);
-    Kokkos::parallel_for(nbCells, functor);
+    Kokkos::parallel_for("UpdateFunctor", stage_policy(0, 0), functor);
   }
     
 } // SolverHydroMood::time_int_forward_euler
@@ -1005,8 +1100,8 @@ void SolverHydroMood<dim,degree>::time_int_ssprk2(DataArray data_in,
   {
     
     ComputeReconstructionPolynomialFunctor<dim,degree,stencilId>
-      functor(params, monomialMap.data, data_in, PolyCoefs, stencil, geomMatrixPI_view);
-    Kokkos::parallel_for(nbCells,functor);
+      functor(m_stage_params, monomialMap.data, data_in, PolyCoefs, stencil, geomMatrixPI_view);
+    Kokkos::parallel_for("ComputeReconstructionPolynomialFunctor", stage_policy(dim==2 ? 1 : 0, 1), functor);
 
     // for (int icoef=0; icoef<ncoefs; ++icoef)
     //   save_data_debug(PolyCoefs[icoef], Uhost, m_times_saved-1, m_t, "poly"+std::to_string(icoef));
@@ -1015,7 +1110,7 @@ void SolverHydroMood<dim,degree>::time_int_ssprk2(DataArray data_in,
 
   // compute fluxes to update data_in
   {
-    ComputeFluxesFunctor<dim,degree, stencilId> functor(params, monomialMap.data,
+    ComputeFluxesFunctor<dim,degree, stencilId> functor(m_stage_params, monomialMap.data,
 							data_in, PolyCoefs,
 							Fluxes_x,
 							Fluxes_y,
@@ -1025,7 +1120,7 @@ void SolverHydroMood<dim,degree>::time_int_ssprk2(DataArray data_in,
 							QUAD_LOC_2D,
 							QUAD_LOC_3D,
 							dtdx, dtdy, dtdz);
-    Kokkos::parallel_for(nbCells, functor);
+    Kokkos::parallel_for("ComputeFluxesFunctor", all_cells_policy(), functor);
 
     //save_data_debug(Fluxes_x, Uhost, m_times_saved, m_t, "flux_x");
     //save_data_debug(Fluxes_y, Uhost, m_times_saved, m_t, "flux_y");
@@ -1035,35 +1130,35 @@ void SolverHydroMood<dim,degree>::time_int_ssprk2(DataArray data_in,
   // because attemp to update leads to physically invalid values
   // (negative density or pressure)
   {  
-    ComputeMoodFlagsUpdateFunctor<dim,degree> functor(params, monomialMap.data,
+    ComputeMoodFlagsUpdateFunctor<dim,degree> functor(m_stage_params, monomialMap.data,
 						      data_in,
 						      MoodFlags,
 						      Fluxes_x,
 						      Fluxes_y,
 						      Fluxes_z);
-    Kokkos::parallel_for(nbCells, functor);
+    Kokkos::parallel_for("ComputeMoodFlagsUpdateFunctor", all_cells_policy(), functor);
     //save_data_debug(MoodFlags, Uhost, m_times_saved, m_t, "mood_flags");    
   }
   
   // recompute fluxes arround flagged cells
   {
-    RecomputeFluxesFunctor<dim,degree> functor(params, monomialMap.data,
+    RecomputeFluxesFunctor<dim,degree> functor(m_stage_params, monomialMap.data,
 					       data_in, MoodFlags,
 					       Fluxes_x, Fluxes_y, Fluxes_z,
 					       dtdx, dtdy, dtdz);
-    Kokkos::parallel_for(nbCells, functor);
+    Kokkos::parallel_for("RecomputeFluxesFunctor", all_cells_policy(), functor);
     //save_data_debug(Fluxes_x, Uhost, m_times_saved, m_t, "flux_x_after");
     //save_data_debug(Fluxes_y, Uhost, m_times_saved, m_t, "flux_y_after");
   }
 
   // update: U_RK1 = data_in + dt*fluxes
   {
-    UpdateFunctor<dim> functor(params, data_in, U_RK1,
+    UpdateFunctor<dim> functor(m_stage_params, data_in, U_RK1,
 			       Fluxes_x, Fluxes_y, Fluxes_z);
-    Kokkos::parallel_for(nbCells, functor);
+    Kokkos::parallel_for("UpdateFunctor", stage_policy(0, 0), functor);
   }
 
-  make_boundaries(U_RK1);
+  make_boundaries_stage(U_RK1);
 
   // ==================================================================
   // second step : U_{n+1} = 0.5 * (U_n + U_RK1 + dt * fluxes(U_RK1) )
@@ -1072,15 +1167,15 @@ void SolverHydroMood<dim,degree>::time_int_ssprk2(DataArray data_in,
   {
     
     ComputeReconstructionPolynomialFunctor<dim,degree,stencilId>
-      functor(params, monomialMap.data, U_RK1, PolyCoefs, stencil, geomMatrixPI_view);
-    Kokkos::parallel_for(nbCells,functor);
+      functor(m_stage_params, monomialMap.data, U_RK1, PolyCoefs, stencil, geomMatrixPI_view);
+    Kokkos::parallel_for("ComputeReconstructionPolynomialFunctor", stage_policy(dim==2 ? 1 : 0, 1), functor);
 
   }
 
   // compute fluxes to update U_RK1
   {
 
-    ComputeFluxesFunctor<dim,degree, stencilId> functor(params, monomialMap.data,
+    ComputeFluxesFunctor<dim,degree, stencilId> functor(m_stage_params, monomialMap.data,
 							U_RK1, PolyCoefs,
 							Fluxes_x,
 							Fluxes_y,
@@ -1090,7 +1185,7 @@ void SolverHydroMood<dim,degree>::time_int_ssprk2(DataArray data_in,
 							QUAD_LOC_2D,
 							QUAD_LOC_3D,
 							dtdx, dtdy, dtdz);
-    Kokkos::parallel_for(nbCells, functor);
+    Kokkos::parallel_for("ComputeFluxesFunctor", all_cells_policy(), functor);
 
   }
 
@@ -1098,29 +1193,29 @@ void SolverHydroMood<dim,degree>::time_int_ssprk2(DataArray data_in,
   // because attemp to update leads to physically invalid values
   // (negative density or pressure)
   {  
-    ComputeMoodFlagsUpdateFunctor<dim,degree> functor(params, monomialMap.data,
+    ComputeMoodFlagsUpdateFunctor<dim,degree> functor(m_stage_params, monomialMap.data,
 						      U_RK1,
 						      MoodFlags,
 						      Fluxes_x,
 						      Fluxes_y,
 						      Fluxes_z);
-    Kokkos::parallel_for(nbCells, functor);
+    Kokkos::parallel_for("ComputeMoodFlagsUpdateFunctor", all_cells_policy(), functor);
   }
   
   // recompute fluxes arround flagged cells
   {
-    RecomputeFluxesFunctor<dim,degree> functor(params, monomialMap.data,
+    RecomputeFluxesFunctor<dim,degree> functor(m_stage_params, monomialMap.data,
 					       U_RK1, MoodFlags,
 					       Fluxes_x, Fluxes_y, Fluxes_z,
 					       dtdx, dtdy, dtdz);
-    Kokkos::parallel_for(nbCells, functor);
+    Kokkos::parallel_for("RecomputeFluxesFunctor", all_cells_policy(), functor);
   }
 
   // actual update
   {
-    UpdateFunctor_ssprk2<dim> functor(params, data_in, U_RK1, data_out,
+    UpdateFunctor_ssprk2<dim> functor(m_stage_params, data_in, U_RK1, data_out,
 				      Fluxes_x, Fluxes_y, Fluxes_z);
-    Kokkos::parallel_for(nbCells, functor);
+    Kokkos::parallel_for("UpdateFunctor_ssprk2", stage_policy(0, 0), functor);
   }  
   
 } // SolverHydroMood::time_int_ssprk2
@@ -1171,8 +1266,8 @@ void SolverHydroMood<dim,degree>::time_int_ssprk3(DataArray data_in,
   {
     
     ComputeReconstructionPolynomialFunctor<dim,degree,stencilId>
-      functor(params, monomialMap.data, data_in, PolyCoefs, stencil, geomMatrixPI_view);
-    Kokkos::parallel_for(nbCells,functor);
+      functor(m_stage_params, monomialMap.data, data_in, PolyCoefs, stencil, geomMatrixPI_view);
+    Kokkos::parallel_for("ComputeReconstructionPolynomialFunctor", stage_policy(dim==2 ? 1 : 0, 1), functor);
 
     // for (int icoef=0; icoef<ncoefs; ++icoef)
     //   save_data_debug(PolyCoefs[icoef], Uhost, m_times_saved-1, m_t, "poly"+std::to_string(icoef));
@@ -1181,7 +1276,7 @@ void SolverHydroMood<dim,degree>::time_int_ssprk3(DataArray data_in,
 
   // compute fluxes to update data_in
   {
-    ComputeFluxesFunctor<dim,degree, stencilId> functor(params, monomialMap.data,
+    ComputeFluxesFunctor<dim,degree, stencilId> functor(m_stage_params, monomialMap.data,
 							data_in, PolyCoefs,
 							Fluxes_x,
 							Fluxes_y,
@@ -1191,7 +1286,7 @@ void SolverHydroMood<dim,degree>::time_int_ssprk3(DataArray data_in,
 							QUAD_LOC_2D,
 							QUAD_LOC_3D,
 							dtdx, dtdy, dtdz);
-    Kokkos::parallel_for(nbCells, functor);
+    Kokkos::parallel_for("ComputeFluxesFunctor", all_cells_policy(), functor);
 
     //save_data_debug(Fluxes_x, Uhost, m_times_saved, m_t, "flux_x");
     //save_data_debug(Fluxes_y, Uhost, m_times_saved, m_t, "flux_y");
@@ -1201,35 +1296,35 @@ void SolverHydroMood<dim,degree>::time_int_ssprk3(DataArray data_in,
   // because attemp to update leads to physically invalid values
   // (negative density or pressure)
   {  
-    ComputeMoodFlagsUpdateFunctor<dim,degree> functor(params, monomialMap.data,
+    ComputeMoodFlagsUpdateFunctor<dim,degree> functor(m_stage_params, monomialMap.data,
 						      data_in,
 						      MoodFlags,
 						      Fluxes_x,
 						      Fluxes_y,
 						      Fluxes_z);
-    Kokkos::parallel_for(nbCells, functor);
+    Kokkos::parallel_for("ComputeMoodFlagsUpdateFunctor", all_cells_policy(), functor);
     //save_data_debug(MoodFlags, Uhost, m_times_saved, m_t, "mood_flags");
   }
   
   // recompute fluxes arround flagged cells
   {
-    RecomputeFluxesFunctor<dim,degree> functor(params, monomialMap.data,
+    RecomputeFluxesFunctor<dim,degree> functor(m_stage_params, monomialMap.data,
 					       data_in, MoodFlags,
 					       Fluxes_x, Fluxes_y, Fluxes_z,
 					       dtdx, dtdy, dtdz);
-    Kokkos::parallel_for(nbCells, functor);
+    Kokkos::parallel_for("RecomputeFluxesFunctor", all_cells_policy(), functor);
     //save_data_debug(Fluxes_x, Uhost, m_times_saved, m_t, "flux_x_after");
     //save_data_debug(Fluxes_y, Uhost, m_times_saved, m_t, "flux_y_after");
   }
 
   // update: U_RK1 = data_in + dt*fluxes
   {
-    UpdateFunctor<dim> functor(params, data_in, U_RK1,
+    UpdateFunctor<dim> functor(m_stage_params, data_in, U_RK1,
 			       Fluxes_x, Fluxes_y, Fluxes_z);
-    Kokkos::parallel_for(nbCells, functor);
+    Kokkos::parallel_for("UpdateFunctor", stage_policy(0, 0), functor);
   }
 
-  make_boundaries(U_RK1);
+  make_boundaries_stage(U_RK1);
   
   // ========================================================================
   // second step : U_RK2 = 3/4 * U_n + 1/4 * U_RK1 + 1/4 * dt * fluxes(U_RK1)
@@ -1238,15 +1333,15 @@ void SolverHydroMood<dim,degree>::time_int_ssprk3(DataArray data_in,
   {
     
     ComputeReconstructionPolynomialFunctor<dim,degree,stencilId>
-      functor(params, monomialMap.data, U_RK1, PolyCoefs, stencil, geomMatrixPI_view);
-    Kokkos::parallel_for(nbCells,functor);
+      functor(m_stage_params, monomialMap.data, U_RK1, PolyCoefs, stencil, geomMatrixPI_view);
+    Kokkos::parallel_for("ComputeReconstructionPolynomialFunctor", stage_policy(dim==2 ? 1 : 0, 1), functor);
 
   }
 
   // compute fluxes (U_RK1)
   {
     
-    ComputeFluxesFunctor<dim,degree, stencilId> functor(params, monomialMap.data,
+    ComputeFluxesFunctor<dim,degree, stencilId> functor(m_stage_params, monomialMap.data,
 							U_RK1, PolyCoefs,
 							Fluxes_x,
 							Fluxes_y,
@@ -1256,7 +1351,7 @@ void SolverHydroMood<dim,degree>::time_int_ssprk3(DataArray data_in,
 							QUAD_LOC_2D,
 							QUAD_LOC_3D,
 							dtdx, dtdy, dtdz);
-    Kokkos::parallel_for(nbCells, functor);
+    Kokkos::parallel_for("ComputeFluxesFunctor", all_cells_policy(), functor);
 
   }
 
@@ -1264,34 +1359,34 @@ void SolverHydroMood<dim,degree>::time_int_ssprk3(DataArray data_in,
   // because attemp to update leads to physically invalid values
   // (negative density or pressure)
   {  
-    ComputeMoodFlagsUpdateFunctor<dim,degree> functor(params, monomialMap.data,
+    ComputeMoodFlagsUpdateFunctor<dim,degree> functor(m_stage_params, monomialMap.data,
 						      U_RK1,
 						      MoodFlags,
 						      Fluxes_x,
 						      Fluxes_y,
 						      Fluxes_z);
-    Kokkos::parallel_for(nbCells, functor);
+    Kokkos::parallel_for("ComputeMoodFlagsUpdateFunctor", all_cells_policy(), functor);
   }
   
   // recompute fluxes arround flagged cells
   {
-    RecomputeFluxesFunctor<dim,degree> functor(params, monomialMap.data,
+    RecomputeFluxesFunctor<dim,degree> functor(m_stage_params, monomialMap.data,
 					       U_RK1, MoodFlags,
 					       Fluxes_x, Fluxes_y, Fluxes_z,
 					       dtdx, dtdy, dtdz);
-    Kokkos::parallel_for(nbCells, functor);
+    Kokkos::parallel_for("RecomputeFluxesFunctor", all_cells_policy(), functor);
   }
 
   // actual update
   // U_RK2 =  3/4 U_n + 1/4 U_RK1 + 1/4 * dt * Flux(U_RK1) 
   {
-    UpdateFunctor_weight<dim> functor(params, data_in, U_RK1, U_RK2,
+    UpdateFunctor_weight<dim> functor(m_stage_params, data_in, U_RK1, U_RK2,
 				      Fluxes_x, Fluxes_y, Fluxes_z,
 				      0.75, 0.25, 0.25);
-    Kokkos::parallel_for(nbCells, functor);
+    Kokkos::parallel_for("UpdateFunctor_weight", stage_policy(0, 0), functor);
   }  
 
-  make_boundaries(U_RK2);
+  make_boundaries_stage(U_RK2);
 
   // ============================================================================
   // thrird step : U_{n+1} = 1/3 * U_n + 2/3 * U_RK2 + 2/3 * dt * fluxes(U_RK2)
@@ -1300,15 +1395,15 @@ void SolverHydroMood<dim,degree>::time_int_ssprk3(DataArray data_in,
   {
     
     ComputeReconstructionPolynomialFunctor<dim,degree,stencilId>
-      functor(params, monomialMap.data, U_RK2, PolyCoefs, stencil, geomMatrixPI_view);
-    Kokkos::parallel_for(nbCells,functor);
+      functor(m_stage_params, monomialMap.data, U_RK2, PolyCoefs, stencil, geomMatrixPI_view);
+    Kokkos::parallel_for("ComputeReconstructionPolynomialFunctor", stage_policy(dim==2 ? 1 : 0, 1), functor);
 
   }
 
   // compute fluxes (U_RK2)
   {
     
-    ComputeFluxesFunctor<dim,degree, stencilId> functor(params, monomialMap.data,
+    ComputeFluxesFunctor<dim,degree, stencilId> functor(m_stage_params, monomialMap.data,
 							U_RK2, PolyCoefs,
 							Fluxes_x,
 							Fluxes_y,
@@ -1318,7 +1413,7 @@ void SolverHydroMood<dim,degree>::time_int_ssprk3(DataArray data_in,
 							QUAD_LOC_2D,
 							QUAD_LOC_3D,
 							dtdx, dtdy, dtdz);
-    Kokkos::parallel_for(nbCells, functor);
+    Kokkos::parallel_for("ComputeFluxesFunctor", all_cells_policy(), functor);
 
   }
 
@@ -1326,31 +1421,31 @@ void SolverHydroMood<dim,degree>::time_int_ssprk3(DataArray data_in,
   // because attemp to update leads to physically invalid values
   // (negative density or pressure)
   {  
-    ComputeMoodFlagsUpdateFunctor<dim,degree> functor(params, monomialMap.data,
+    ComputeMoodFlagsUpdateFunctor<dim,degree> functor(m_stage_params, monomialMap.data,
 						      U_RK2,
 						      MoodFlags,
 						      Fluxes_x,
 						      Fluxes_y,
 						      Fluxes_z);
-    Kokkos::parallel_for(nbCells, functor);
+    Kokkos::parallel_for("ComputeMoodFlagsUpdateFunctor", all_cells_policy(), functor);
   }
   
   // recompute fluxes arround flagged cells
   {
-    RecomputeFluxesFunctor<dim,degree> functor(params, monomialMap.data,
+    RecomputeFluxesFunctor<dim,degree> functor(m_stage_params, monomialMap.data,
 					       U_RK2, MoodFlags,
 					       Fluxes_x, Fluxes_y, Fluxes_z,
 					       dtdx, dtdy, dtdz);
-    Kokkos::parallel_for(nbCells, functor);
+    Kokkos::parallel_for("RecomputeFluxesFunctor", all_cells_policy(), functor);
   }
 
   // actual update
   // U_{n+1} =  1/3 U_n + 2/3 U_RK2 + 2/3 * dt * Flux(U_RK2) 
   {
-    UpdateFunctor_weight<dim> functor(params, data_in, U_RK2, data_out,
+    UpdateFunctor_weight<dim> functor(m_stage_params, data_in, U_RK2, data_out,
 				      Fluxes_x, Fluxes_y, Fluxes_z,
 				      1.0/3, 2.0/3, 2.0/3);
-    Kokkos::parallel_for(nbCells, functor);
+    Kokkos::parallel_for("UpdateFunctor_weight", stage_policy(0, 0), functor);
   }  
 
 } // SolverHydroMood::time_int_ssprk3
@@ -1407,9 +1502,6 @@ template<int dim, int degree>
 template<int dim_>
 void SolverHydroMood<dim,degree>::make_boundaries(typename std::enable_if<dim_==2,DataArray2d>::type Udata)
 {
-  
-  const int ghostWidth=params.ghostWidth;
-  int nbIter = ghostWidth*std::max(isize,jsize);
 
   // wedge has a different border condition
   if (!m_problem_name.compare("wedge")) {
@@ -1419,42 +1511,37 @@ void SolverHydroMood<dim,degree>::make_boundaries(typename std::enable_if<dim_==
     // call device functor
     {
       MakeBoundariesFunctor2D_wedge<FACE_XMIN> functor(params, wparams, Udata);
-      Kokkos::parallel_for(nbIter, functor);
+      Kokkos::parallel_for("MakeBoundariesFunctor2D_wedge",
+			   boundary_policy<2>(params, FACE_XMIN),
+			   functor);
     }
     {
       MakeBoundariesFunctor2D_wedge<FACE_XMAX> functor(params, wparams, Udata);
-      Kokkos::parallel_for(nbIter, functor);
+      Kokkos::parallel_for("MakeBoundariesFunctor2D_wedge",
+			   boundary_policy<2>(params, FACE_XMAX),
+			   functor);
     }
     
     {
       MakeBoundariesFunctor2D_wedge<FACE_YMIN> functor(params, wparams, Udata);
-      Kokkos::parallel_for(nbIter, functor);
+      Kokkos::parallel_for("MakeBoundariesFunctor2D_wedge",
+			   boundary_policy<2>(params, FACE_YMIN),
+			   functor);
     }
     {
       MakeBoundariesFunctor2D_wedge<FACE_YMAX> functor(params, wparams, Udata);
-      Kokkos::parallel_for(nbIter, functor);
+      Kokkos::parallel_for("MakeBoundariesFunctor2D_wedge",
+			   boundary_policy<2>(params, FACE_YMAX),
+			   functor);
     }
 
   } else {
 
-    // call device functor
-    {
-      MakeBoundariesFunctor2D<FACE_XMIN> functor(params, Udata);
-      Kokkos::parallel_for(nbIter, functor);
-    }
-    {
-      MakeBoundariesFunctor2D<FACE_XMAX> functor(params, Udata);
-      Kokkos::parallel_for(nbIter, functor);
-    }
-    
-    {
-      MakeBoundariesFunctor2D<FACE_YMIN> functor(params, Udata);
-      Kokkos::parallel_for(nbIter, functor);
-    }
-    {
-      MakeBoundariesFunctor2D<FACE_YMAX> functor(params, Udata);
-      Kokkos::parallel_for(nbIter, functor);
-    }
+#ifdef USE_MPI
+    make_boundaries_mpi(Udata, false);
+#else
+    make_boundaries_serial(Udata, false);
+#endif // USE_MPI
 
   }
   
@@ -1465,42 +1552,62 @@ template<int dim_>
 void SolverHydroMood<dim,degree>::make_boundaries(typename std::enable_if<dim_==3,DataArray3d>::type Udata)
 {
 
-  const int ghostWidth=params.ghostWidth;
-  
-  int max_size = std::max(isize,jsize);
-  max_size = std::max(max_size,ksize);
-  int nbIter = ghostWidth * max_size * max_size;
-  
-  // call device functor
-  {
-    MakeBoundariesFunctor3D<FACE_XMIN> functor(params, Udata);
-    Kokkos::parallel_for(nbIter, functor);
-  }  
-  {
-    MakeBoundariesFunctor3D<FACE_XMAX> functor(params, Udata);
-    Kokkos::parallel_for(nbIter, functor);
-  }
-  
-  {
-    MakeBoundariesFunctor3D<FACE_YMIN> functor(params, Udata);
-    Kokkos::parallel_for(nbIter, functor);
-  }
-  {
-    MakeBoundariesFunctor3D<FACE_YMAX> functor(params, Udata);
-    Kokkos::parallel_for(nbIter, functor);
-  }
-  
-  {
-    MakeBoundariesFunctor3D<FACE_ZMIN> functor(params, Udata);
-    Kokkos::parallel_for(nbIter, functor);
-  }
-  {
-    MakeBoundariesFunctor3D<FACE_ZMAX> functor(params, Udata);
-    Kokkos::parallel_for(nbIter, functor);
-  }
+#ifdef USE_MPI
+  make_boundaries_mpi(Udata, false);
+#else
+  make_boundaries_serial(Udata, false);
+#endif // USE_MPI
 
 } // SolverHydroMood::make_boundaries
 
+// =======================================================
+// =======================================================
+template<int dim, int degree>
+void SolverHydroMood<dim,degree>::make_boundaries_stage(DataArray Udata)
+{
+
+  if (deep_halo_stage()) {
+
+    make_boundaries(Udata);
+
+  } else {
+
+#ifdef USE_MPI
+    make_boundaries_physical(Udata, false, true);
+#endif // USE_MPI
+
+  }
+
+} // SolverHydroMood::make_boundaries_stage
+
+// =======================================================
+// =======================================================
+template<int dim, int degree>
+typename SolverHydroMood<dim,degree>::MDPolicy
+SolverHydroMood<dim,degree>::all_cells_policy() const
+{
+
+  return md_policy<dim>(0, 0, 0,
+			isize, jsize, ksize,
+			params.mdrange_tile);
+
+} // SolverHydroMood::all_cells_policy
+
+// =======================================================
+// =======================================================
+template<int dim, int degree>
+typename SolverHydroMood<dim,degree>::MDPolicy
+SolverHydroMood<dim,degree>::stage_policy(int lo, int hi) const
+{
+
+  const int gw = m_stage_params.ghostWidth;
+
+  return md_policy<dim>(gw-lo, gw-lo, gw-lo,
+			isize-gw+hi, jsize-gw+hi, ksize-gw+hi,
+			params.mdrange_tile);
+
+} // SolverHydroMood::stage_policy
+
 // =======================================================
 // =======================================================
 /**
@@ -1512,7 +1619,7 @@ void SolverHydroMood<dim,degree>::init_implode(DataArray Udata)
 {
 
   InitImplodeFunctor<dim,degree> functor(params, monomialMap.data, Udata);
-  Kokkos::parallel_for(nbCells, functor);
+  Kokkos::parallel_for("InitImplodeFunctor", all_cells_policy(), functor);
   
 } // init_implode
 
@@ -1529,7 +1636,7 @@ void SolverHydroMood<dim,degree>::init_blast(DataArray Udata)
   BlastParams blastParams = BlastParams(configMap);
   
   InitBlastFunctor<dim,degree> functor(params, monomialMap.data, blastParams, Udata);
-  Kokkos::parallel_for(nbCells, functor);
+  Kokkos::parallel_for("InitBlastFunctor", all_cells_policy(), functor);
 
 } // SolverHydroMood::init_blast
 
@@ -1562,7 +1669,7 @@ void SolverHydroMood<dim,degree>::init_four_quadrant(DataArray Udata)
 					      Udata,
 					      U0, U1, U2, U3,
 					      xt, yt);
-  Kokkos::parallel_for(nbCells, functor);
+  Kokkos::parallel_for("InitFourQuadrantFunctor", all_cells_policy(), functor);
     
 } // init_four_quadrant
 
@@ -1582,7 +1689,7 @@ void SolverHydroMood<dim,degree>::init_kelvin_helmholtz(DataArray Udata)
 						 monomialMap.data,
 						 khParams,
 						 Udata);
-  Kokkos::parallel_for(nbCells, functor);
+  Kokkos::parallel_for("InitKelvinHelmholtzFunctor", all_cells_policy(), functor);
 
 } // SolverHydroMood::init_kelvin_helmholtz
 
@@ -1599,7 +1706,7 @@ void SolverHydroMood<dim,degree>::init_wedge(DataArray Udata)
   WedgeParams wparams(configMap, 0.0);
   
   InitWedgeFunctor<dim,degree> functor(params, monomialMap.data, wparams, Udata);
-  Kokkos::parallel_for(nbCells, functor);
+  Kokkos::parallel_for("InitWedgeFunctor", all_cells_policy(), functor);
   
 } // init_wedge
 
@@ -1617,7 +1724,7 @@ void SolverHydroMood<dim,degree>::init_isentropic_vortex(DataArray Udata)
   IsentropicVortexParams iparams(configMap);
 
   InitIsentropicVortexFunctor<dim,degree> functor(params, monomialMap.data, iparams, Udata);
-  Kokkos::parallel_for(nbCells, functor);
+  Kokkos::parallel_for("InitIsentropicVortexFunctor", all_cells_policy(), functor);
   
 } // init_isentropic_vortex
 
@@ -1637,6 +1744,29 @@ void SolverHydroMood<dim,degree>::save_solution_impl()
     
 } // SolverHydroMood::save_solution_impl()
 
+// =======================================================
+// =======================================================
+template<int dim, int degree>
+void SolverHydroMood<dim,degree>::run_analysis_impl()
+{
+
+  DataArray Ucur = m_iteration % 2 == 0 ? U : U2;
+
+  make_boundaries(Ucur);
+  run_analysis(Ucur, false);
+
+} // SolverHydroMood::run_analysis_impl()
+
+// =======================================================
+// =======================================================
+template<int dim, int degree>
+void SolverHydroMood<dim,degree>::save_streams_impl()
+{
+
+  save_streams(m_iteration % 2 == 0 ? U : U2);
+
+} // SolverHydroMood::save_streams_impl()
+
 } // namespace mood
 
 #endif // SOLVER_HYDRO_MOOD_H_
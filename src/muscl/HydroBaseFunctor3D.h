@@ -24,7 +24,7 @@ HydroBaseFunctor3D(HydroParams params) : params(params) {};
   virtual ~HydroBaseFunctor3D() {};
 
   HydroParams params;
-  const int nbvar = params.nbvar;
+  enum { nbvar = NbVar<3>::value };
   
   // utility routines used in various computational kernels
 
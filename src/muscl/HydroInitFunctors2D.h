@@ -40,31 +40,26 @@ public:
   // static method which does it all: create and execute functor
   static void apply(HydroParams params,
                     ImplodeParams iparams,
-                    DataArray2d Udata,
-		    int         nbCells)
+                    DataArray2d Udata)
   {
     InitImplodeFunctor2D functor(params, iparams, Udata);
-    Kokkos::parallel_for(nbCells, functor);
+    Kokkos::parallel_for("InitImplodeFunctor2D",
+                         md_policy_2d(0, 0,
+                                      params.isize, params.jsize,
+                                      params.mdrange_tile),
+                         functor);
   }
 
   KOKKOS_INLINE_FUNCTION
-  void operator()(const int& index) const
+  void operator()(const int& i,
+                  const int& j) const
   {
 
-    const int isize = params.isize;
-    const int jsize = params.jsize;
     const int ghostWidth = params.ghostWidth;
     
-#ifdef USE_MPI
-    const int i_mpi = params.myMpiPos[IX];
-    const int j_mpi = params.myMpiPos[IY];
-#else
-    const int i_mpi = 0;
-    const int j_mpi = 0;
-#endif
+    const int i_offset = params.myOffset[IX];
+    const int j_offset = params.myOffset[IY];
 
-    const int nx = params.nx;
-    const int ny = params.ny;
 
     const real_t xmin = params.xmin;
     const real_t xmax = params.xmax;
@@ -74,11 +69,8 @@ public:
     
     const real_t gamma0 = params.settings.gamma0;
     
-    int i,j;
-    index2coord(index,i,j,isize,jsize);
-    
-    real_t x = xmin + dx/2 + (i+nx*i_mpi-ghostWidth)*dx;
-    real_t y = ymin + dy/2 + (j+ny*j_mpi-ghostWidth)*dy;
+    real_t x = xmin + dx/2 + (i+i_offset-ghostWidth)*dx;
+    real_t y = ymin + dy/2 + (j+j_offset-ghostWidth)*dy;
 
     // outer parameters
     const real_t rho_out = this->iparams.rho_out;
@@ -133,31 +125,26 @@ public:
   // static method which does it all: create and execute functor
   static void apply(HydroParams params,
 		    BlastParams bParams,
-                    DataArray2d Udata,
-		    int         nbCells)
+                    DataArray2d Udata)
   {
     InitBlastFunctor2D functor(params, bParams, Udata);
-    Kokkos::parallel_for(nbCells, functor);
+    Kokkos::parallel_for("InitBlastFunctor2D",
+                         md_policy_2d(0, 0,
+                                      params.isize, params.jsize,
+                                      params.mdrange_tile),
+                         functor);
   }
 
   KOKKOS_INLINE_FUNCTION
-  void operator()(const int& index) const
+  void operator()(const int& i,
+                  const int& j) const
   {
 
-    const int isize = params.isize;
-    const int jsize = params.jsize;
     const int ghostWidth = params.ghostWidth;
     
-#ifdef USE_MPI
-    const int i_mpi = params.myMpiPos[IX];
-    const int j_mpi = params.myMpiPos[IY];
-#else
-    const int i_mpi = 0;
-    const int j_mpi = 0;
-#endif
+    const int i_offset = params.myOffset[IX];
+    const int j_offset = params.myOffset[IY];
 
-    const int nx = params.nx;
-    const int ny = params.ny;
 
     const real_t xmin = params.xmin;
     const real_t ymin = params.ymin;
@@ -176,11 +163,8 @@ public:
     const real_t blast_pressure_in = bParams.blast_pressure_in;
     const real_t blast_pressure_out= bParams.blast_pressure_out;
   
-    int i,j;
-    index2coord(index,i,j,isize,jsize);
-    
-    real_t x = xmin + dx/2 + (i+nx*i_mpi-ghostWidth)*dx;
-    real_t y = ymin + dy/2 + (j+ny*j_mpi-ghostWidth)*dy;
+    real_t x = xmin + dx/2 + (i+i_offset-ghostWidth)*dx;
+    real_t y = ymin + dy/2 + (j+j_offset-ghostWidth)*dy;
 
     real_t d2 = 
       (x-blast_center_x)*(x-blast_center_x)+
@@ -222,31 +206,26 @@ public:
   // static method which does it all: create and execute functor
   static void apply(HydroParams params,
 		    KHParams    khParams,
-                    DataArray2d Udata,
-		    int         nbCells)
+                    DataArray2d Udata)
   {
     InitKelvinHelmholtzFunctor2D functor(params, khParams, Udata);
-    Kokkos::parallel_for(nbCells, functor);
+    Kokkos::parallel_for("InitKelvinHelmholtzFunctor2D",
+                         md_policy_2d(0, 0,
+                                      params.isize, params.jsize,
+                                      params.mdrange_tile),
+                         functor);
   }
 
   KOKKOS_INLINE_FUNCTION
-  void operator()(const int& index) const
+  void operator()(const int& i,
+                  const int& j) const
   {
 
-    const int isize = params.isize;
-    const int jsize = params.jsize;
     const int ghostWidth = params.ghostWidth;
     
-#ifdef USE_MPI
-    const int i_mpi = params.myMpiPos[IX];
-    const int j_mpi = params.myMpiPos[IY];
-#else
-    const int i_mpi = 0;
-    const int j_mpi = 0;
-#endif
+    const int i_offset = params.myOffset[IX];
+    const int j_offset = params.myOffset[IY];
 
-    const int nx = params.nx;
-    const int ny = params.ny;
 
     const real_t xmin = params.xmin;
     const real_t ymin = params.ymin;
@@ -264,11 +243,8 @@ public:
     const real_t ampl      = khParams.amplitude;
     const real_t pressure  = khParams.pressure;
     
-    int i,j;
-    index2coord(index,i,j,isize,jsize);
-    
-    real_t x = xmin + dx/2 + (i+nx*i_mpi-ghostWidth)*dx;
-    real_t y = ymin + dy/2 + (j+ny*j_mpi-ghostWidth)*dy;
+    real_t x = xmin + dx/2 + (i+i_offset-ghostWidth)*dx;
+    real_t y = ymin + dy/2 + (j+j_offset-ghostWidth)*dy;
 
     // normalized coordinates in [0,1]
     //real_t xn = (x-xmin)/(xmax-xmin);
@@ -360,31 +336,26 @@ public:
   // static method which does it all: create and execute functor
   static void apply(HydroParams  params,
 		    GreshoParams gvParams,
-                    DataArray2d  Udata,
-		    int          nbCells)
+                    DataArray2d  Udata)
   {
     InitGreshoVortexFunctor2D functor(params, gvParams, Udata);
-    Kokkos::parallel_for(nbCells, functor);
+    Kokkos::parallel_for("InitGreshoVortexFunctor2D",
+                         md_policy_2d(0, 0,
+                                      params.isize, params.jsize,
+                                      params.mdrange_tile),
+                         functor);
   }
 
   KOKKOS_INLINE_FUNCTION
-  void operator()(const int& index) const
+  void operator()(const int& i,
+                  const int& j) const
   {
 
-    const int isize = params.isize;
-    const int jsize = params.jsize;
     const int ghostWidth = params.ghostWidth;
     
-#ifdef USE_MPI
-    const int i_mpi = params.myMpiPos[IX];
-    const int j_mpi = params.myMpiPos[IY];
-#else
-    const int i_mpi = 0;
-    const int j_mpi = 0;
-#endif
+    const int i_offset = params.myOffset[IX];
+    const int j_offset = params.myOffset[IY];
 
-    const int nx = params.nx;
-    const int ny = params.ny;
 
     const real_t xmin = params.xmin;
     const real_t ymin = params.ymin;
@@ -400,11 +371,8 @@ public:
 
     const real_t p0 = rho0 / (gamma0 * Ma * Ma);
     
-    int i,j;
-    index2coord(index,i,j,isize,jsize);
-    
-    real_t x = xmin + dx/2 + (i+nx*i_mpi-ghostWidth)*dx;
-    real_t y = ymin + dy/2 + (j+ny*j_mpi-ghostWidth)*dy;
+    real_t x = xmin + dx/2 + (i+i_offset-ghostWidth)*dx;
+    real_t y = ymin + dy/2 + (j+j_offset-ghostWidth)*dy;
 
     real_t r = sqrt(x*x+y*y);
     real_t theta = atan2(y,x);
@@ -475,43 +443,35 @@ public:
 		    HydroState U2,
 		    HydroState U3,
 		    real_t xt,
-		    real_t yt,
-		    int    nbCells)
+		    real_t yt)
   {
     InitFourQuadrantFunctor2D functor(params, Udata, configNumber,
 				      U0, U1, U2, U3, xt, yt);
-    Kokkos::parallel_for(nbCells, functor);
+    Kokkos::parallel_for("InitFourQuadrantFunctor2D",
+                         md_policy_2d(0, 0,
+                                      params.isize, params.jsize,
+                                      params.mdrange_tile),
+                         functor);
   }
 
   KOKKOS_INLINE_FUNCTION
-  void operator()(const int& index) const
+  void operator()(const int& i,
+                  const int& j) const
   {
 
-    const int isize = params.isize;
-    const int jsize = params.jsize;
     const int ghostWidth = params.ghostWidth;
     
-#ifdef USE_MPI
-    const int i_mpi = params.myMpiPos[IX];
-    const int j_mpi = params.myMpiPos[IY];
-#else
-    const int i_mpi = 0;
-    const int j_mpi = 0;
-#endif
+    const int i_offset = params.myOffset[IX];
+    const int j_offset = params.myOffset[IY];
 
-    const int nx = params.nx;
-    const int ny = params.ny;
 
     const real_t xmin = params.xmin;
     const real_t ymin = params.ymin;
     const real_t dx = params.dx;
     const real_t dy = params.dy;
     
-    int i,j;
-    index2coord(index,i,j,isize,jsize);
-    
-    real_t x = xmin + dx/2 + (i+nx*i_mpi-ghostWidth)*dx;
-    real_t y = ymin + dy/2 + (j+ny*j_mpi-ghostWidth)*dy;
+    real_t x = xmin + dx/2 + (i+i_offset-ghostWidth)*dx;
+    real_t y = ymin + dy/2 + (j+j_offset-ghostWidth)*dy;
     
     if (x<xt) {
       if (y<yt) {
@@ -565,31 +525,26 @@ public:
   // static method which does it all: create and execute functor
   static void apply(HydroParams params,
 		    IsentropicVortexParams iparams,
-                    DataArray2d Udata,
-		    int         nbCells)
+                    DataArray2d Udata)
   {
     InitIsentropicVortexFunctor2D functor(params, iparams, Udata);
-    Kokkos::parallel_for(nbCells, functor);
+    Kokkos::parallel_for("InitIsentropicVortexFunctor2D",
+                         md_policy_2d(0, 0,
+                                      params.isize, params.jsize,
+                                      params.mdrange_tile),
+                         functor);
   }
   
   KOKKOS_INLINE_FUNCTION
-  void operator()(const int& index) const
+  void operator()(const int& i,
+                  const int& j) const
   {
 
-    const int isize = params.isize;
-    const int jsize = params.jsize;
     const int ghostWidth = params.ghostWidth;
     
-#ifdef USE_MPI
-    const int i_mpi = params.myMpiPos[IX];
-    const int j_mpi = params.myMpiPos[IY];
-#else
-    const int i_mpi = 0;
-    const int j_mpi = 0;
-#endif
+    const int i_offset = params.myOffset[IX];
+    const int j_offset = params.myOffset[IY];
 
-    const int nx = params.nx;
-    const int ny = params.ny;
 
     const real_t xmin = params.xmin;
     const real_t ymin = params.ymin;
@@ -598,11 +553,8 @@ public:
     
     const real_t gamma0 = params.settings.gamma0;
   
-    int i,j;
-    index2coord(index,i,j,isize,jsize);
-    
-    real_t x = xmin + dx/2 + (i+nx*i_mpi-ghostWidth)*dx;
-    real_t y = ymin + dy/2 + (j+ny*j_mpi-ghostWidth)*dy;
+    real_t x = xmin + dx/2 + (i+i_offset-ghostWidth)*dx;
+    real_t y = ymin + dy/2 + (j+j_offset-ghostWidth)*dy;
 
     // ambient flow
     const real_t rho_a = this->iparams.rho_a;
@@ -672,29 +624,24 @@ public:
                     DataArray2d Udata,
 		    VectorField2d gravity)
   {
-    uint64_t nbCells = params.isize * params.jsize;
     RayleighTaylorInstabilityFunctor2D functor(params, rtiparams, Udata, gravity);
-    Kokkos::parallel_for(nbCells, functor);
+    Kokkos::parallel_for("RayleighTaylorInstabilityFunctor2D",
+                         md_policy_2d(0, 0,
+                                      params.isize, params.jsize,
+                                      params.mdrange_tile),
+                         functor);
   }
 
   KOKKOS_INLINE_FUNCTION
-  void operator()(const int& index) const
+  void operator()(const int& i,
+                  const int& j) const
   {
 
-    const int isize = params.isize;
-    const int jsize = params.jsize;
     const int ghostWidth = params.ghostWidth;
     
-#ifdef USE_MPI
-    const int i_mpi = params.myMpiPos[IX];
-    const int j_mpi = params.myMpiPos[IY];
-#else
-    const int i_mpi = 0;
-    const int j_mpi = 0;
-#endif
+    const int i_offset = params.myOffset[IX];
+    const int j_offset = params.myOffset[IY];
 
-    const int nx = params.nx;
-    const int ny = params.ny;
 
     const real_t xmin = params.xmin;
     const real_t ymin = params.ymin;
@@ -710,11 +657,8 @@ public:
     
     const real_t gamma0 = params.settings.gamma0;
   
-    int i,j;
-    index2coord(index,i,j,isize,jsize);
-    
-    real_t x = xmin + dx/2 + (i+nx*i_mpi-ghostWidth)*dx;
-    real_t y = ymin + dy/2 + (j+ny*j_mpi-ghostWidth)*dy;
+    real_t x = xmin + dx/2 + (i+i_offset-ghostWidth)*dx;
+    real_t y = ymin + dy/2 + (j+j_offset-ghostWidth)*dy;
 
     /* initialize perturbation amplitude */
     real_t amplitude = rtiparams.amplitude;
@@ -799,29 +743,24 @@ public:
                     DataArray2d Udata,
 		    VectorField2d gravity)
   {
-    uint64_t nbCells = params.isize * params.jsize;
     RisingBubbleFunctor2D functor(params, rbparams, Udata, gravity);
-    Kokkos::parallel_for(nbCells, functor);
+    Kokkos::parallel_for("RisingBubbleFunctor2D",
+                         md_policy_2d(0, 0,
+                                      params.isize, params.jsize,
+                                      params.mdrange_tile),
+                         functor);
   }
 
   KOKKOS_INLINE_FUNCTION
-  void operator()(const int& index) const
+  void operator()(const int& i,
+                  const int& j) const
   {
 
-    const int isize = params.isize;
-    const int jsize = params.jsize;
     const int ghostWidth = params.ghostWidth;
     
-#ifdef USE_MPI
-    const int i_mpi = params.myMpiPos[IX];
-    const int j_mpi = params.myMpiPos[IY];
-#else
-    const int i_mpi = 0;
-    const int j_mpi = 0;
-#endif
+    const int i_offset = params.myOffset[IX];
+    const int j_offset = params.myOffset[IY];
 
-    const int nx = params.nx;
-    const int ny = params.ny;
 
     const real_t xmin = params.xmin;
     const real_t ymin = params.ymin;
@@ -834,11 +773,8 @@ public:
     
     const real_t gamma0 = params.settings.gamma0;
   
-    int i,j;
-    index2coord(index,i,j,isize,jsize);
-    
-    real_t x = xmin + dx/2 + (i+nx*i_mpi-ghostWidth)*dx;
-    real_t y = ymin + dy/2 + (j+ny*j_mpi-ghostWidth)*dy;
+    real_t x = xmin + dx/2 + (i+i_offset-ghostWidth)*dx;
+    real_t y = ymin + dy/2 + (j+j_offset-ghostWidth)*dy;
 
     /* retrieve bubble parameter */
 
@@ -915,29 +851,24 @@ public:
                     DataArray2d        Udata,
 		    VectorField2d      gravity)
   {
-    uint64_t nbCells = params.isize * params.jsize;
     InitDiskFunctor2D functor(params, dparams, grav, Udata, gravity);
-    Kokkos::parallel_for(nbCells, functor);
+    Kokkos::parallel_for("InitDiskFunctor2D",
+                         md_policy_2d(0, 0,
+                                      params.isize, params.jsize,
+                                      params.mdrange_tile),
+                         functor);
   }
 
   KOKKOS_INLINE_FUNCTION
-  void operator()(const int& index) const
+  void operator()(const int& i,
+                  const int& j) const
   {
 
-    const int isize = params.isize;
-    const int jsize = params.jsize;
     const int ghostWidth = params.ghostWidth;
     
-#ifdef USE_MPI
-    const int i_mpi = params.myMpiPos[IX];
-    const int j_mpi = params.myMpiPos[IY];
-#else
-    const int i_mpi = 0;
-    const int j_mpi = 0;
-#endif
+    const int i_offset = params.myOffset[IX];
+    const int j_offset = params.myOffset[IY];
 
-    const int nx = params.nx;
-    const int ny = params.ny;
 
     const real_t xmin = params.xmin;
     //const real_t xmax = params.xmax;
@@ -957,11 +888,8 @@ public:
     const real_t rho_contrast   = dparams.contrast_density;
     const real_t contrast_width = dparams.contrast_width;
     
-    int i,j;
-    index2coord(index,i,j,isize,jsize);
-    
-    real_t x = xmin + dx/2 + (i+nx*i_mpi-ghostWidth)*dx - xc;
-    real_t y = ymin + dy/2 + (j+ny*j_mpi-ghostWidth)*dy - yc;
+    real_t x = xmin + dx/2 + (i+i_offset-ghostWidth)*dx - xc;
+    real_t y = ymin + dy/2 + (j+j_offset-ghostWidth)*dy - yc;
     real_t z = 0;
     
     const real_t GM = grav.GM;
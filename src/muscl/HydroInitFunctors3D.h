@@ -33,25 +33,22 @@ public:
   
   // static method which does it all: create and execute functor
   static void apply(HydroParams params,
-                    DataArray3d Udata,
-		    int         nbCells)
+                    DataArray3d Udata)
   {
     InitFakeFunctor3D functor(params, Udata);
-    Kokkos::parallel_for(nbCells, functor);
+    Kokkos::parallel_for("InitFakeFunctor3D",
+                         md_policy_3d(0, 0, 0,
+                                      params.isize, params.jsize, params.ksize,
+                                      params.mdrange_tile),
+                         functor);
   }
 
   KOKKOS_INLINE_FUNCTION
-  void operator()(const int& index) const
+  void operator()(const int& i,
+                  const int& j,
+                  const int& k) const
   {
 
-    const int isize = params.isize;
-    const int jsize = params.jsize;
-    const int ksize = params.ksize;
-    
-    int i,j,k;
-
-    index2coord(index,i,j,k,isize,jsize,ksize);
-        
     Udata(i  ,j  ,k  , ID) = 0.0;
     Udata(i  ,j  ,k  , IP) = 0.0;
     Udata(i  ,j  ,k  , IU) = 0.0;
@@ -78,35 +75,28 @@ public:
   // static method which does it all: create and execute functor
   static void apply(HydroParams params,
                     ImplodeParams iparams,
-                    DataArray3d Udata,
-		    int         nbCells)
+                    DataArray3d Udata)
   {
     InitImplodeFunctor3D functor(params, iparams, Udata);
-    Kokkos::parallel_for(nbCells, functor);
+    Kokkos::parallel_for("InitImplodeFunctor3D",
+                         md_policy_3d(0, 0, 0,
+                                      params.isize, params.jsize, params.ksize,
+                                      params.mdrange_tile),
+                         functor);
   }
 
   KOKKOS_INLINE_FUNCTION
-  void operator()(const int& index) const
+  void operator()(const int& i,
+                  const int& j,
+                  const int& k) const
   {
 
-    const int isize = params.isize;
-    const int jsize = params.jsize;
-    const int ksize = params.ksize;
     const int ghostWidth = params.ghostWidth;
     
-#ifdef USE_MPI
-    const int i_mpi = params.myMpiPos[IX];
-    const int j_mpi = params.myMpiPos[IY];
-    const int k_mpi = params.myMpiPos[IZ];
-#else
-    const int i_mpi = 0;
-    const int j_mpi = 0;
-    const int k_mpi = 0;
-#endif
+    const int i_offset = params.myOffset[IX];
+    const int j_offset = params.myOffset[IY];
+    const int k_offset = params.myOffset[IZ];
 
-    const int nx = params.nx;
-    const int ny = params.ny;
-    const int nz = params.nz;
 
     const real_t xmin = params.xmin;
     const real_t xmax = params.xmax;
@@ -119,12 +109,9 @@ public:
     
     const real_t gamma0 = params.settings.gamma0;
     
-    int i,j,k;
-    index2coord(index,i,j,k,isize,jsize,ksize);
-    
-    real_t x = xmin + dx/2 + (i+nx*i_mpi-ghostWidth)*dx;
-    real_t y = ymin + dy/2 + (j+ny*j_mpi-ghostWidth)*dy;
-    real_t z = zmin + dz/2 + (k+nz*k_mpi-ghostWidth)*dz;
+    real_t x = xmin + dx/2 + (i+i_offset-ghostWidth)*dx;
+    real_t y = ymin + dy/2 + (j+j_offset-ghostWidth)*dy;
+    real_t z = zmin + dz/2 + (k+k_offset-ghostWidth)*dz;
     
     // outer parameters
     const real_t rho_out = this->iparams.rho_out;
@@ -183,35 +170,28 @@ public:
   // static method which does it all: create and execute functor
   static void apply(HydroParams params,
 		    BlastParams bParams,
-                    DataArray3d Udata,
-		    int         nbCells)
+                    DataArray3d Udata)
   {
     InitBlastFunctor3D functor(params, bParams, Udata);
-    Kokkos::parallel_for(nbCells, functor);
+    Kokkos::parallel_for("InitBlastFunctor3D",
+                         md_policy_3d(0, 0, 0,
+                                      params.isize, params.jsize, params.ksize,
+                                      params.mdrange_tile),
+                         functor);
   }
 
   KOKKOS_INLINE_FUNCTION
-  void operator()(const int& index) const
+  void operator()(const int& i,
+                  const int& j,
+                  const int& k) const
   {
 
-    const int isize = params.isize;
-    const int jsize = params.jsize;
-    const int ksize = params.ksize;
     const int ghostWidth = params.ghostWidth;
     
-#ifdef USE_MPI
-    const int i_mpi = params.myMpiPos[IX];
-    const int j_mpi = params.myMpiPos[IY];
-    const int k_mpi = params.myMpiPos[IZ];
-#else
-    const int i_mpi = 0;
-    const int j_mpi = 0;
-    const int k_mpi = 0;
-#endif
+    const int i_offset = params.myOffset[IX];
+    const int j_offset = params.myOffset[IY];
+    const int k_offset = params.myOffset[IZ];
 
-    const int nx = params.nx;
-    const int ny = params.ny;
-    const int nz = params.nz;
 
     const real_t xmin = params.xmin;
     const real_t ymin = params.ymin;
@@ -235,12 +215,9 @@ public:
     const real_t blast_pressure_out= bParams.blast_pressure_out;
   
 
-    int i,j,k;
-    index2coord(index,i,j,k,isize,jsize,ksize);
-    
-    real_t x = xmin + dx/2 + (i+nx*i_mpi-ghostWidth)*dx;
-    real_t y = ymin + dy/2 + (j+ny*j_mpi-ghostWidth)*dy;
-    real_t z = zmin + dz/2 + (k+nz*k_mpi-ghostWidth)*dz;
+    real_t x = xmin + dx/2 + (i+i_offset-ghostWidth)*dx;
+    real_t y = ymin + dy/2 + (j+j_offset-ghostWidth)*dy;
+    real_t z = zmin + dz/2 + (k+k_offset-ghostWidth)*dz;
 
     real_t d2 = 
       (x-blast_center_x)*(x-blast_center_x)+
@@ -286,35 +263,28 @@ public:
   // static method which does it all: create and execute functor
   static void apply(HydroParams params,
 		    KHParams    khParams,
-                    DataArray3d Udata,
-		    int         nbCells)
+                    DataArray3d Udata)
   {
     InitKelvinHelmholtzFunctor3D functor(params, khParams, Udata);
-    Kokkos::parallel_for(nbCells, functor);
+    Kokkos::parallel_for("InitKelvinHelmholtzFunctor3D",
+                         md_policy_3d(0, 0, 0,
+                                      params.isize, params.jsize, params.ksize,
+                                      params.mdrange_tile),
+                         functor);
   }
 
   KOKKOS_INLINE_FUNCTION
-  void operator()(const int& index) const
+  void operator()(const int& i,
+                  const int& j,
+                  const int& k) const
   {
 
-    const int isize = params.isize;
-    const int jsize = params.jsize;
-    const int ksize = params.ksize;
     const int ghostWidth = params.ghostWidth;
     
-#ifdef USE_MPI
-    const int i_mpi = params.myMpiPos[IX];
-    const int j_mpi = params.myMpiPos[IY];
-    const int k_mpi = params.myMpiPos[IZ];
-#else
-    const int i_mpi = 0;
-    const int j_mpi = 0;
-    const int k_mpi = 0;
-#endif
+    const int i_offset = params.myOffset[IX];
+    const int j_offset = params.myOffset[IY];
+    const int k_offset = params.myOffset[IZ];
 
-    const int nx = params.nx;
-    const int ny = params.ny;
-    const int nz = params.nz;
 
     const real_t xmin = params.xmin;
     const real_t ymin = params.ymin;
@@ -337,12 +307,9 @@ public:
     const real_t ampl      = khParams.amplitude;
     const real_t pressure  = khParams.pressure;
     
-    int i,j,k;
-    index2coord(index,i,j,k,isize,jsize,ksize);
-    
-    real_t x = xmin + dx/2 + (i+nx*i_mpi-ghostWidth)*dx;
-    real_t y = ymin + dy/2 + (j+ny*j_mpi-ghostWidth)*dy;
-    real_t z = zmin + dz/2 + (k+nz*k_mpi-ghostWidth)*dz;
+    real_t x = xmin + dx/2 + (i+i_offset-ghostWidth)*dx;
+    real_t y = ymin + dy/2 + (j+j_offset-ghostWidth)*dy;
+    real_t z = zmin + dz/2 + (k+k_offset-ghostWidth)*dz;
 
     // normalized coordinates in [0,1]
     //real_t xn = (x-xmin)/(xmax-xmin);
@@ -449,34 +416,28 @@ public:
   // static method which does it all: create and execute functor
   static void apply(HydroParams  params,
 		    GreshoParams gvParams,
-                    DataArray3d  Udata,
-		    int          nbCells)
+                    DataArray3d  Udata)
   {
     InitGreshoVortexFunctor3D functor(params, gvParams, Udata);
-    Kokkos::parallel_for(nbCells, functor);
+    Kokkos::parallel_for("InitGreshoVortexFunctor3D",
+                         md_policy_3d(0, 0, 0,
+                                      params.isize, params.jsize, params.ksize,
+                                      params.mdrange_tile),
+                         functor);
   }
 
   KOKKOS_INLINE_FUNCTION
-  void operator()(const int& index) const
+  void operator()(const int& i,
+                  const int& j,
+                  const int& k) const
   {
 
-    const int isize = params.isize;
-    const int jsize = params.jsize;
-    const int ksize = params.ksize;
     const int ghostWidth = params.ghostWidth;
     
-#ifdef USE_MPI
-    const int i_mpi = params.myMpiPos[IX];
-    const int j_mpi = params.myMpiPos[IY];
-    const int k_mpi = params.myMpiPos[IZ];
-#else
-    const int i_mpi = 0;
-    const int j_mpi = 0;
-    //const int k_mpi = 0;
-#endif
-
-    const int nx = params.nx;
-    const int ny = params.ny;
+    const int i_offset = params.myOffset[IX];
+    const int j_offset = params.myOffset[IY];
+    //const int k_offset = params.myOffset[IZ];
+
     //const int nz = params.nz;
 
     const real_t xmin = params.xmin;
@@ -498,12 +459,9 @@ public:
 
     const real_t p0 = rho0 / (gamma0 * Ma * Ma);
     
-    int i,j,k;
-    index2coord(index,i,j,k,isize,jsize,ksize);
-    
-    real_t x = xmin + dx/2 + (i+nx*i_mpi-ghostWidth)*dx;
-    real_t y = ymin + dy/2 + (j+ny*j_mpi-ghostWidth)*dy;
-    //real_t z = zmin + dz/2 + (k+nz*k_mpi-ghostWidth)*dz;
+    real_t x = xmin + dx/2 + (i+i_offset-ghostWidth)*dx;
+    real_t y = ymin + dy/2 + (j+j_offset-ghostWidth)*dy;
+    //real_t z = zmin + dz/2 + (k+k_offset-ghostWidth)*dz;
 
     real_t r = sqrt(x*x+y*y);
     real_t theta = atan2(y,x);
@@ -577,33 +535,26 @@ public:
                     DataArray3d Udata,
 		    VectorField3d gravity)
   {
-    uint64_t nbCells = params.isize * params.jsize * params.ksize;
     RayleighTaylorInstabilityFunctor3D functor(params, rtiparams, Udata, gravity);
-    Kokkos::parallel_for(nbCells, functor);
+    Kokkos::parallel_for("RayleighTaylorInstabilityFunctor3D",
+                         md_policy_3d(0, 0, 0,
+                                      params.isize, params.jsize, params.ksize,
+                                      params.mdrange_tile),
+                         functor);
   }
 
   KOKKOS_INLINE_FUNCTION
-  void operator()(const int& index) const
+  void operator()(const int& i,
+                  const int& j,
+                  const int& k) const
   {
 
-    const int isize = params.isize;
-    const int jsize = params.jsize;
-    const int ksize = params.ksize;
     const int ghostWidth = params.ghostWidth;
     
-#ifdef USE_MPI
-    const int i_mpi = params.myMpiPos[IX];
-    const int j_mpi = params.myMpiPos[IY];
-    const int k_mpi = params.myMpiPos[IZ];
-#else
-    const int i_mpi = 0;
-    const int j_mpi = 0;
-    const int k_mpi = 0;
-#endif
+    const int i_offset = params.myOffset[IX];
+    const int j_offset = params.myOffset[IY];
+    const int k_offset = params.myOffset[IZ];
 
-    const int nx = params.nx;
-    const int ny = params.ny;
-    const int nz = params.nz;
 
     const real_t xmin = params.xmin;
     const real_t ymin = params.ymin;
@@ -623,12 +574,9 @@ public:
     
     const real_t gamma0 = params.settings.gamma0;
   
-    int i,j,k;
-    index2coord(index,i,j,k,isize,jsize,ksize);
-    
-    real_t x = xmin + dx/2 + (i+nx*i_mpi-ghostWidth)*dx;
-    real_t y = ymin + dy/2 + (j+ny*j_mpi-ghostWidth)*dy;
-    real_t z = zmin + dz/2 + (k+nz*k_mpi-ghostWidth)*dz;
+    real_t x = xmin + dx/2 + (i+i_offset-ghostWidth)*dx;
+    real_t y = ymin + dy/2 + (j+j_offset-ghostWidth)*dy;
+    real_t z = zmin + dz/2 + (k+k_offset-ghostWidth)*dz;
 
     /* initialize perturbation amplitude */
     real_t amplitude = rtiparams.amplitude;
@@ -715,33 +663,26 @@ public:
                     DataArray3d Udata,
 		    VectorField3d gravity)
   {
-    uint64_t nbCells = params.isize * params.jsize * params.ksize;
     RisingBubbleFunctor3D functor(params, rbparams, Udata, gravity);
-    Kokkos::parallel_for(nbCells, functor);
+    Kokkos::parallel_for("RisingBubbleFunctor3D",
+                         md_policy_3d(0, 0, 0,
+                                      params.isize, params.jsize, params.ksize,
+                                      params.mdrange_tile),
+                         functor);
   }
 
   KOKKOS_INLINE_FUNCTION
-  void operator()(const int& index) const
+  void operator()(const int& i,
+                  const int& j,
+                  const int& k) const
   {
 
-    const int isize = params.isize;
-    const int jsize = params.jsize;
-    const int ksize = params.ksize;
     const int ghostWidth = params.ghostWidth;
     
-#ifdef USE_MPI
-    const int i_mpi = params.myMpiPos[IX];
-    const int j_mpi = params.myMpiPos[IY];
-    const int k_mpi = params.myMpiPos[IZ];
-#else
-    const int i_mpi = 0;
-    const int j_mpi = 0;
-    const int k_mpi = 0;
-#endif
+    const int i_offset = params.myOffset[IX];
+    const int j_offset = params.myOffset[IY];
+    const int k_offset = params.myOffset[IZ];
 
-    const int nx = params.nx;
-    const int ny = params.ny;
-    const int nz = params.nz;
 
     const real_t xmin = params.xmin;
     const real_t ymin = params.ymin;
@@ -757,12 +698,9 @@ public:
     
     const real_t gamma0 = params.settings.gamma0;
   
-    int i,j,k;
-    index2coord(index,i,j,k,isize,jsize,ksize);
-    
-    real_t x = xmin + dx/2 + (i+nx*i_mpi-ghostWidth)*dx;
-    real_t y = ymin + dy/2 + (j+ny*j_mpi-ghostWidth)*dy;
-    real_t z = zmin + dz/2 + (k+nz*k_mpi-ghostWidth)*dz;
+    real_t x = xmin + dx/2 + (i+i_offset-ghostWidth)*dx;
+    real_t y = ymin + dy/2 + (j+j_offset-ghostWidth)*dy;
+    real_t z = zmin + dz/2 + (k+k_offset-ghostWidth)*dz;
 
     /* retrieve bubble parameter */
 
@@ -841,33 +779,26 @@ public:
                     DataArray3d        Udata,
 		    VectorField3d      gravity)
   {
-    uint64_t nbCells = params.isize * params.jsize * params.ksize;
     InitDiskFunctor3D functor(params, dparams, grav, Udata, gravity);
-    Kokkos::parallel_for(nbCells, functor);
+    Kokkos::parallel_for("InitDiskFunctor3D",
+                         md_policy_3d(0, 0, 0,
+                                      params.isize, params.jsize, params.ksize,
+                                      params.mdrange_tile),
+                         functor);
   }
 
   KOKKOS_INLINE_FUNCTION
-  void operator()(const int& index) const
+  void operator()(const int& i,
+                  const int& j,
+                  const int& k) const
   {
 
-    const int isize = params.isize;
-    const int jsize = params.jsize;
-    const int ksize = params.ksize;
     const int ghostWidth = params.ghostWidth;
     
-#ifdef USE_MPI
-    const int i_mpi = params.myMpiPos[IX];
-    const int j_mpi = params.myMpiPos[IY];
-    const int k_mpi = params.myMpiPos[IZ];
-#else
-    const int i_mpi = 0;
-    const int j_mpi = 0;
-    const int k_mpi = 0;
-#endif
+    const int i_offset = params.myOffset[IX];
+    const int j_offset = params.myOffset[IY];
+    const int k_offset = params.myOffset[IZ];
 
-    const int nx = params.nx;
-    const int ny = params.ny;
-    const int nz = params.nz;
 
     const real_t xmin = params.xmin;
     //const real_t xmax = params.xmax;
@@ -890,12 +821,9 @@ public:
     const real_t rho_contrast   = dparams.contrast_density;
     const real_t contrast_width = dparams.contrast_width;
     
-    int i,j,k;
-    index2coord(index,i,j,k,isize,jsize,ksize);
-    
-    real_t x = xmin + dx/2 + (i+nx*i_mpi-ghostWidth)*dx - xc;
-    real_t y = ymin + dy/2 + (j+ny*j_mpi-ghostWidth)*dy - yc;
-    real_t z = zmin + dz/2 + (k+nz*k_mpi-ghostWidth)*dz - zc;
+    real_t x = xmin + dx/2 + (i+i_offset-ghostWidth)*dx - xc;
+    real_t y = ymin + dy/2 + (j+j_offset-ghostWidth)*dy - yc;
+    real_t z = zmin + dz/2 + (k+k_offset-ghostWidth)*dz - zc;
     
     
     const real_t GM = grav.GM;
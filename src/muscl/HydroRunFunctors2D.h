@@ -33,11 +33,18 @@ public:
   // static method which does it all: create and execute functor
   static void apply(HydroParams params,
                     DataArray2d Udata,
-		    int nbCells,
                     real_t& invDt)
   {
+    const int isize = params.isize;
+    const int jsize = params.jsize;
+    const int ghostWidth = params.ghostWidth;
+
     ComputeDtFunctor2D functor(params, Udata);
-    Kokkos::parallel_reduce(nbCells, functor, invDt);
+    Kokkos::parallel_reduce("ComputeDtFunctor2D",
+                            md_policy_2d(ghostWidth, ghostWidth,
+                                         isize-ghostWidth, jsize-ghostWidth,
+                                         params.mdrange_tile),
+                            functor, invDt);
   }
 
   // Tell each thread how to initialize its reduction result.
@@ -56,41 +63,30 @@ public:
 
   /* this is a reduce (max) functor */
   KOKKOS_INLINE_FUNCTION
-  void operator()(const int &index, real_t &invDt) const
+  void operator()(const int& i, const int& j, real_t &invDt) const
   {
-    const int isize = params.isize;
-    const int jsize = params.jsize;
-    const int ghostWidth = params.ghostWidth;
     //const int nbvar = params.nbvar;
     const real_t dx = params.dx;
     const real_t dy = params.dy;
     
-    int i,j;
-    index2coord(index,i,j,isize,jsize);
-
-    if(j >= ghostWidth && j < jsize - ghostWidth &&
-       i >= ghostWidth && i < isize - ghostWidth) {
-      
-      HydroState uLoc; // conservative    variables in current cell
-      HydroState qLoc; // primitive    variables in current cell
-      real_t c=0.0;
-      real_t vx, vy;
+    HydroState uLoc; // conservative    variables in current cell
+    HydroState qLoc; // primitive    variables in current cell
+    real_t c=0.0;
+    real_t vx, vy;
       
-      // get local conservative variable
-      uLoc[ID] = Udata(i,j,ID);
-      uLoc[IP] = Udata(i,j,IP);
-      uLoc[IU] = Udata(i,j,IU);
-      uLoc[IV] = Udata(i,j,IV);
-
-      // get primitive variables in current cell
-      computePrimitives(uLoc, &c, qLoc);
-      vx = c+FABS(qLoc[IU]);
-      vy = c+FABS(qLoc[IV]);
-
-      invDt = FMAX(invDt, vx/dx + vy/dy);
+    // get local conservative variable
+    uLoc[ID] = Udata(i,j,ID);
+    uLoc[IP] = Udata(i,j,IP);
+    uLoc[IU] = Udata(i,j,IU);
+    uLoc[IV] = Udata(i,j,IV);
+
+    // get primitive variables in current cell
+    computePrimitives(uLoc, &c, qLoc);
+    vx = c+FABS(qLoc[IU]);
+    vy = c+FABS(qLoc[IV]);
+
+    invDt = FMAX(invDt, vx/dx + vy/dy);
       
-    }
-	    
   } // operator ()
 
 
@@ -145,11 +141,18 @@ public:
 		    real_t        cfl,
 		    VectorField2d gravity,
                     DataArray2d   Udata,
-		    int           nbCells,
                     real_t&       invDt)
   {
+    const int isize = params.isize;
+    const int jsize = params.jsize;
+    const int ghostWidth = params.ghostWidth;
+
     ComputeDtGravityFunctor2D functor(params, cfl, gravity, Udata);
-    Kokkos::parallel_reduce(nbCells, functor, invDt);
+    Kokkos::parallel_reduce("ComputeDtGravityFunctor2D",
+                            md_policy_2d(ghostWidth, ghostWidth,
+                                         isize-ghostWidth, jsize-ghostWidth,
+                                         params.mdrange_tile),
+                            functor, invDt);
   }
 
   // Tell each thread how to initialize its reduction result.
@@ -168,57 +171,46 @@ public:
 
   /* this is a reduce (max) functor */
   KOKKOS_INLINE_FUNCTION
-  void operator()(const int &index, real_t &invDt) const
+  void operator()(const int& i, const int& j, real_t &invDt) const
   {
-    const int isize = params.isize;
-    const int jsize = params.jsize;
-    const int ghostWidth = params.ghostWidth;
     //const int nbvar = params.nbvar;
     const real_t dx = fmin(params.dx, params.dy);
     
-    int i,j;
-    index2coord(index,i,j,isize,jsize);
-
-    if(j >= ghostWidth && j < jsize - ghostWidth &&
-       i >= ghostWidth && i < isize - ghostWidth) {
+    HydroState uLoc; // conservative    variables in current cell
+    HydroState qLoc; // primitive    variables in current cell
+    real_t c=0.0;
       
-      HydroState uLoc; // conservative    variables in current cell
-      HydroState qLoc; // primitive    variables in current cell
-      real_t c=0.0;
-      
-      // get local conservative variable
-      uLoc[ID] = Udata(i,j,ID);
-      uLoc[IP] = Udata(i,j,IP);
-      uLoc[IU] = Udata(i,j,IU);
-      uLoc[IV] = Udata(i,j,IV);
-
-      // get primitive variables in current cell
-      computePrimitives(uLoc, &c, qLoc);
-      real_t velocity = 0.0;
-      velocity += c+FABS(qLoc[IU]);
-      velocity += c+FABS(qLoc[IV]);
-
-      /* Due to the gravitational acceleration, the CFL condition 
-       * can be written as
-       * g dt^2 / (2 dx) + u dt / dx <= cfl 
-       * where u = sum(|v_i| + c_s) and g = sum(|g_i|)
-       *
-       * u / dx has to be corrected by a factor k / (sqrt(1 + 2k) - 1) 
-       * in order to satisfy the new CFL, where k = g dx cfl / u^2
-       */
-      double k = fabs(gravity(i,j,IX)) + fabs(gravity(i,j,IY));
+    // get local conservative variable
+    uLoc[ID] = Udata(i,j,ID);
+    uLoc[IP] = Udata(i,j,IP);
+    uLoc[IU] = Udata(i,j,IU);
+    uLoc[IV] = Udata(i,j,IV);
+
+    // get primitive variables in current cell
+    computePrimitives(uLoc, &c, qLoc);
+    real_t velocity = 0.0;
+    velocity += c+FABS(qLoc[IU]);
+    velocity += c+FABS(qLoc[IV]);
+
+    /* Due to the gravitational acceleration, the CFL condition 
+     * can be written as
+     * g dt^2 / (2 dx) + u dt / dx <= cfl 
+     * where u = sum(|v_i| + c_s) and g = sum(|g_i|)
+     *
+     * u / dx has to be corrected by a factor k / (sqrt(1 + 2k) - 1) 
+     * in order to satisfy the new CFL, where k = g dx cfl / u^2
+     */
+    double k = fabs(gravity(i,j,IX)) + fabs(gravity(i,j,IY));
 					     
-      k *= cfl * dx / (velocity * velocity);
+    k *= cfl * dx / (velocity * velocity);
 
-       /* prevent numerical errors due to very low gravity */
-      k = fmax(k, 1e-4);
+     /* prevent numerical errors due to very low gravity */
+    k = fmax(k, 1e-4);
 
-      velocity *= k / (sqrt(1.0 + 2.0 * k) - 1.0);
+    velocity *= k / (sqrt(1.0 + 2.0 * k) - 1.0);
 
-      invDt = fmax(invDt, velocity/dx);
+    invDt = fmax(invDt, velocity/dx);
       
-    }
-	    
   } // operator ()
 
 
@@ -242,6 +234,102 @@ public:
   
 }; // ComputeDtGravityFunctor2D
 
+/*************************************************/
+/*************************************************/
+/*************************************************/
+class ComputeRefinementIndicatorFunctor2D : public HydroBaseFunctor2D {
+
+public:
+
+  /**
+   * AMR refinement indicator : largest relative jump of density and
+   * pressure between the two neighbors of a cell (ghost cells must be
+   * up to date), in [0,1].
+   *
+   * \param[in] params
+   * \param[in] Udata
+   */
+  ComputeRefinementIndicatorFunctor2D(HydroParams params,
+				      DataArray2d Udata) :
+    HydroBaseFunctor2D(params),
+    Udata(Udata)  {};
+
+  // static method which does it all: create and execute functor
+  static void apply(HydroParams params,
+                    DataArray2d Udata,
+                    real_t& indicator)
+  {
+    const int isize = params.isize;
+    const int jsize = params.jsize;
+    const int ghostWidth = params.ghostWidth;
+
+    ComputeRefinementIndicatorFunctor2D functor(params, Udata);
+    Kokkos::parallel_reduce("ComputeRefinementIndicatorFunctor2D",
+                            md_policy_2d(ghostWidth, ghostWidth,
+                                         isize-ghostWidth, jsize-ghostWidth,
+                                         params.mdrange_tile),
+                            functor, indicator);
+  }
+
+  // Tell each thread how to initialize its reduction result.
+  KOKKOS_INLINE_FUNCTION
+  void init (real_t& dst) const
+  {
+    // indicator is non negative
+    dst = ZERO_F;
+  } // init
+
+  KOKKOS_INLINE_FUNCTION
+  void primitives(int i, int j, HydroState& q) const
+  {
+    HydroState u;
+    real_t c;
+    u[ID] = Udata(i,j,ID);
+    u[IP] = Udata(i,j,IP);
+    u[IU] = Udata(i,j,IU);
+    u[IV] = Udata(i,j,IV);
+    computePrimitives(u, &c, q);
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  static real_t jump(real_t a, real_t b)
+  {
+    return FABS(a-b) / (FABS(a)+FABS(b));
+  }
+
+  /* this is a reduce (max) functor */
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const int& i, const int& j, real_t &indicator) const
+  {
+    HydroState qm, qp;
+
+    primitives(i-1, j, qm);
+    primitives(i+1, j, qp);
+    indicator = FMAX(indicator, jump(qm[ID], qp[ID]));
+    indicator = FMAX(indicator, jump(qm[IP], qp[IP]));
+
+    primitives(i, j-1, qm);
+    primitives(i, j+1, qp);
+    indicator = FMAX(indicator, jump(qm[ID], qp[ID]));
+    indicator = FMAX(indicator, jump(qm[IP], qp[IP]));
+
+  } // operator ()
+
+  // "Join" intermediate results from different threads.
+  KOKKOS_INLINE_FUNCTION
+  void join (volatile real_t& dst,
+	     const volatile real_t& src) const
+  {
+    // max reduce
+    if (dst < src) {
+      dst = src;
+    }
+  } // join
+
+  DataArray2d Udata;
+
+}; // ComputeRefinementIndicatorFunctor2D
+
 /*************************************************/
 /*************************************************/
 /*************************************************/
@@ -266,45 +354,41 @@ public:
                     DataArray2d Udata,
                     DataArray2d Qdata)
   {
-    int nbCells = params.isize * params.jsize;
+    const int isize = params.isize;
+    const int jsize = params.jsize;
+
     ConvertToPrimitivesFunctor2D functor(params, Udata, Qdata);
-    Kokkos::parallel_for(nbCells, functor);
+    Kokkos::parallel_for("ConvertToPrimitivesFunctor2D",
+                         md_policy_2d(0, 0,
+                                      isize, jsize,
+                                      params.mdrange_tile),
+                         functor);
   }
 
   KOKKOS_INLINE_FUNCTION
-  void operator()(const int& index) const
+  void operator()(const int& i, const int& j) const
   {
-    const int isize = params.isize;
-    const int jsize = params.jsize;
     //const int ghostWidth = params.ghostWidth;
     
-    int i,j;
-    index2coord(index,i,j,isize,jsize);
-    
-    if(j >= 0 && j < jsize  &&
-       i >= 0 && i < isize ) {
-      
-      HydroState uLoc; // conservative    variables in current cell
-      HydroState qLoc; // primitive    variables in current cell
-      real_t c;
+    HydroState uLoc; // conservative    variables in current cell
+    HydroState qLoc; // primitive    variables in current cell
+    real_t c;
       
-      // get local conservative variable
-      uLoc[ID] = Udata(i,j,ID);
-      uLoc[IP] = Udata(i,j,IP);
-      uLoc[IU] = Udata(i,j,IU);
-      uLoc[IV] = Udata(i,j,IV);
+    // get local conservative variable
+    uLoc[ID] = Udata(i,j,ID);
+    uLoc[IP] = Udata(i,j,IP);
+    uLoc[IU] = Udata(i,j,IU);
+    uLoc[IV] = Udata(i,j,IV);
       
-      // get primitive variables in current cell
-      computePrimitives(uLoc, &c, qLoc);
-
-      // copy q state in q global
-      Qdata(i,j,ID) = qLoc[ID];
-      Qdata(i,j,IP) = qLoc[IP];
-      Qdata(i,j,IU) = qLoc[IU];
-      Qdata(i,j,IV) = qLoc[IV];
+    // get primitive variables in current cell
+    computePrimitives(uLoc, &c, qLoc);
+
+    // copy q state in q global
+    Qdata(i,j,ID) = qLoc[ID];
+    Qdata(i,j,IP) = qLoc[IP];
+    Qdata(i,j,IU) = qLoc[IU];
+    Qdata(i,j,IV) = qLoc[IV];
       
-    }
-    
   }
   
   DataArray2d Udata;
@@ -342,82 +426,70 @@ public:
     dtdx(dtdx), dtdy(dtdy) {};
   
   KOKKOS_INLINE_FUNCTION
-  void operator()(const int& index) const
+  void operator()(const int& i, const int& j) const
   {
-    const int isize = params.isize;
-    const int jsize = params.jsize;
-    const int ghostWidth = params.ghostWidth;
-    
-    int i,j;
-    index2coord(index,i,j,isize,jsize);
-    
-    if(j >= ghostWidth && j <= jsize - ghostWidth &&
-       i >= ghostWidth && i <= isize - ghostWidth) {
+    HydroState qleft, qright;
+    HydroState flux_x, flux_y;
+    HydroState qgdnv;
+
+    //
+    // Solve Riemann problem at X-interfaces and compute
+    // X-fluxes
+    //
+    qleft[ID]   = Qm_x(i-1,j , ID);
+    qleft[IP]   = Qm_x(i-1,j , IP);
+    qleft[IU]   = Qm_x(i-1,j , IU);
+    qleft[IV]   = Qm_x(i-1,j , IV);
       
-      HydroState qleft, qright;
-      HydroState flux_x, flux_y;
-      HydroState qgdnv;
-
-      //
-      // Solve Riemann problem at X-interfaces and compute
-      // X-fluxes
-      //
-      qleft[ID]   = Qm_x(i-1,j , ID);
-      qleft[IP]   = Qm_x(i-1,j , IP);
-      qleft[IU]   = Qm_x(i-1,j , IU);
-      qleft[IV]   = Qm_x(i-1,j , IV);
+    qright[ID]  = Qp_x(i  ,j , ID);
+    qright[IP]  = Qp_x(i  ,j , IP);
+    qright[IU]  = Qp_x(i  ,j , IU);
+    qright[IV]  = Qp_x(i  ,j , IV);
       
-      qright[ID]  = Qp_x(i  ,j , ID);
-      qright[IP]  = Qp_x(i  ,j , IP);
-      qright[IU]  = Qp_x(i  ,j , IU);
-      qright[IV]  = Qp_x(i  ,j , IV);
+    // compute hydro flux_x
+    //riemann_hllc(qleft,qright,qgdnv,flux_x);
+    riemann_hydro(qleft,qright,qgdnv,flux_x,params);
+
+    //
+    // Solve Riemann problem at Y-interfaces and compute Y-fluxes
+    //
+    qleft[ID]   = Qm_y(i  ,j-1, ID);
+    qleft[IP]   = Qm_y(i  ,j-1, IP);
+    qleft[IU]   = Qm_y(i  ,j-1, IV); // watchout IU, IV permutation
+    qleft[IV]   = Qm_y(i  ,j-1, IU); // watchout IU, IV permutation
+
+    qright[ID]  = Qp_y(i  ,j , ID);
+    qright[IP]  = Qp_y(i  ,j , IP);
+    qright[IU]  = Qp_y(i  ,j , IV); // watchout IU, IV permutation
+    qright[IV]  = Qp_y(i  ,j , IU); // watchout IU, IV permutation
       
-      // compute hydro flux_x
-      //riemann_hllc(qleft,qright,qgdnv,flux_x);
-      riemann_hydro(qleft,qright,qgdnv,flux_x,params);
-
-      //
-      // Solve Riemann problem at Y-interfaces and compute Y-fluxes
-      //
-      qleft[ID]   = Qm_y(i  ,j-1, ID);
-      qleft[IP]   = Qm_y(i  ,j-1, IP);
-      qleft[IU]   = Qm_y(i  ,j-1, IV); // watchout IU, IV permutation
-      qleft[IV]   = Qm_y(i  ,j-1, IU); // watchout IU, IV permutation
-
-      qright[ID]  = Qp_y(i  ,j , ID);
-      qright[IP]  = Qp_y(i  ,j , IP);
-      qright[IU]  = Qp_y(i  ,j , IV); // watchout IU, IV permutation
-      qright[IV]  = Qp_y(i  ,j , IU); // watchout IU, IV permutation
-      
-      // compute hydro flux_y
-      //riemann_hllc(qleft,qright,qgdnv,flux_y);
-      riemann_hydro(qleft,qright,qgdnv,flux_y,params);
+    // compute hydro flux_y
+    //riemann_hllc(qleft,qright,qgdnv,flux_y);
+    riemann_hydro(qleft,qright,qgdnv,flux_y,params);
             
-      //
-      // update hydro array
-      //
-      Udata(i-1,j  , ID) += - flux_x[ID]*dtdx;
-      Udata(i-1,j  , IP) += - flux_x[IP]*dtdx;
-      Udata(i-1,j  , IU) += - flux_x[IU]*dtdx;
-      Udata(i-1,j  , IV) += - flux_x[IV]*dtdx;
-
-      Udata(i  ,j  , ID) +=   flux_x[ID]*dtdx;
-      Udata(i  ,j  , IP) +=   flux_x[IP]*dtdx;
-      Udata(i  ,j  , IU) +=   flux_x[IU]*dtdx;
-      Udata(i  ,j  , IV) +=   flux_x[IV]*dtdx;
-
-      Udata(i  ,j-1, ID) += - flux_y[ID]*dtdy;
-      Udata(i  ,j-1, IP) += - flux_y[IP]*dtdy;
-      Udata(i  ,j-1, IU) += - flux_y[IV]*dtdy; // watchout IU and IV swapped
-      Udata(i  ,j-1, IV) += - flux_y[IU]*dtdy; // watchout IU and IV swapped
-
-      Udata(i  ,j  , ID) +=   flux_y[ID]*dtdy;
-      Udata(i  ,j  , IP) +=   flux_y[IP]*dtdy;
-      Udata(i  ,j  , IU) +=   flux_y[IV]*dtdy; // watchout IU and IV swapped
-      Udata(i  ,j  , IV) +=   flux_y[IU]*dtdy; // watchout IU and IV swapped
+    //
+    // update hydro array
+    //
+    Udata(i-1,j  , ID) += - flux_x[ID]*dtdx;
+    Udata(i-1,j  , IP) += - flux_x[IP]*dtdx;
+    Udata(i-1,j  , IU) += - flux_x[IU]*dtdx;
+    Udata(i-1,j  , IV) += - flux_x[IV]*dtdx;
+
+    Udata(i  ,j  , ID) +=   flux_x[ID]*dtdx;
+    Udata(i  ,j  , IP) +=   flux_x[IP]*dtdx;
+    Udata(i  ,j  , IU) +=   flux_x[IU]*dtdx;
+    Udata(i  ,j  , IV) +=   flux_x[IV]*dtdx;
+
+    Udata(i  ,j-1, ID) += - flux_y[ID]*dtdy;
+    Udata(i  ,j-1, IP) += - flux_y[IP]*dtdy;
+    Udata(i  ,j-1, IU) += - flux_y[IV]*dtdy; // watchout IU and IV swapped
+    Udata(i  ,j-1, IV) += - flux_y[IU]*dtdy; // watchout IU and IV swapped
+
+    Udata(i  ,j  , ID) +=   flux_y[ID]*dtdy;
+    Udata(i  ,j  , IP) +=   flux_y[IP]*dtdy;
+    Udata(i  ,j  , IU) +=   flux_y[IV]*dtdy; // watchout IU and IV swapped
+    Udata(i  ,j  , IV) +=   flux_y[IU]*dtdy; // watchout IU and IV swapped
       
-    }
-    
   }
   
   DataArray2d Udata;
@@ -457,95 +529,84 @@ public:
     dtdx(dtdx), dtdy(dtdy) {};
   
   KOKKOS_INLINE_FUNCTION
-  void operator()(const int& index) const
+  void operator()(const int& i, const int& j) const
   {
-    const int isize = params.isize;
-    const int jsize = params.jsize;
-    const int ghostWidth = params.ghostWidth;
-    
-    int i,j;
-    index2coord(index,i,j,isize,jsize);
-    
-    if(j >= 1 && j <= jsize - ghostWidth &&
-       i >= 1 && i <= isize - ghostWidth) {
-
-      HydroState qLoc   ; // local primitive variables
-      HydroState qPlusX ;
-      HydroState qMinusX;
-      HydroState qPlusY ;
-      HydroState qMinusY;
-
-      HydroState dqX;
-      HydroState dqY;
-
-      HydroState qmX;
-      HydroState qmY;
-      HydroState qpX;
-      HydroState qpY;
+    HydroState qLoc   ; // local primitive variables
+    HydroState qPlusX ;
+    HydroState qMinusX;
+    HydroState qPlusY ;
+    HydroState qMinusY;
+
+    HydroState dqX;
+    HydroState dqY;
+
+    HydroState qmX;
+    HydroState qmY;
+    HydroState qpX;
+    HydroState qpY;
       
-      // get primitive variables state vector
-      {
-	qLoc   [ID] = Qdata(i  ,j  , ID);
-	qPlusX [ID] = Qdata(i+1,j  , ID);
-	qMinusX[ID] = Qdata(i-1,j  , ID);
-	qPlusY [ID] = Qdata(i  ,j+1, ID);
-	qMinusY[ID] = Qdata(i  ,j-1, ID);
-
-	qLoc   [IP] = Qdata(i  ,j  , IP);
-	qPlusX [IP] = Qdata(i+1,j  , IP);
-	qMinusX[IP] = Qdata(i-1,j  , IP);
-	qPlusY [IP] = Qdata(i  ,j+1, IP);
-	qMinusY[IP] = Qdata(i  ,j-1, IP);
-
-	qLoc   [IU] = Qdata(i  ,j  , IU);
-	qPlusX [IU] = Qdata(i+1,j  , IU);
-	qMinusX[IU] = Qdata(i-1,j  , IU);
-	qPlusY [IU] = Qdata(i  ,j+1, IU);
-	qMinusY[IU] = Qdata(i  ,j-1, IU);
-
-	qLoc   [IV] = Qdata(i  ,j  , IV);
-	qPlusX [IV] = Qdata(i+1,j  , IV);
-	qMinusX[IV] = Qdata(i-1,j  , IV);
-	qPlusY [IV] = Qdata(i  ,j+1, IV);
-	qMinusY[IV] = Qdata(i  ,j-1, IV);
-
-      } // 
+    // get primitive variables state vector
+    {
+      qLoc   [ID] = Qdata(i  ,j  , ID);
+      qPlusX [ID] = Qdata(i+1,j  , ID);
+      qMinusX[ID] = Qdata(i-1,j  , ID);
+      qPlusY [ID] = Qdata(i  ,j+1, ID);
+      qMinusY[ID] = Qdata(i  ,j-1, ID);
+
+      qLoc   [IP] = Qdata(i  ,j  , IP);
+      qPlusX [IP] = Qdata(i+1,j  , IP);
+      qMinusX[IP] = Qdata(i-1,j  , IP);
+      qPlusY [IP] = Qdata(i  ,j+1, IP);
+      qMinusY[IP] = Qdata(i  ,j-1, IP);
+
+      qLoc   [IU] = Qdata(i  ,j  , IU);
+      qPlusX [IU] = Qdata(i+1,j  , IU);
+      qMinusX[IU] = Qdata(i-1,j  , IU);
+      qPlusY [IU] = Qdata(i  ,j+1, IU);
+      qMinusY[IU] = Qdata(i  ,j-1, IU);
+
+      qLoc   [IV] = Qdata(i  ,j  , IV);
+      qPlusX [IV] = Qdata(i+1,j  , IV);
+      qMinusX[IV] = Qdata(i-1,j  , IV);
+      qPlusY [IV] = Qdata(i  ,j+1, IV);
+      qMinusY[IV] = Qdata(i  ,j-1, IV);
+
+    } // 
       
-      // get hydro slopes dq
-      slope_unsplit_hydro_2d(qLoc, 
-			     qPlusX, qMinusX, 
-			     qPlusY, qMinusY, 
-			     dqX, dqY);
+    // get hydro slopes dq
+    slope_unsplit_hydro_2d(qLoc, 
+			   qPlusX, qMinusX, 
+			   qPlusY, qMinusY, 
+			   dqX, dqY);
       
-      // compute qm, qp
-      trace_unsplit_hydro_2d(qLoc, 
-			     dqX, dqY,
-			     dtdx, dtdy, 
-			     qmX, qmY,
-			     qpX, qpY);
-
-      // store qm, qp : only what is really needed
-      Qm_x(i  ,j  , ID) = qmX[ID];
-      Qp_x(i  ,j  , ID) = qpX[ID];
-      Qm_y(i  ,j  , ID) = qmY[ID];
-      Qp_y(i  ,j  , ID) = qpY[ID];
+    // compute qm, qp
+    trace_unsplit_hydro_2d(qLoc, 
+			   dqX, dqY,
+			   dtdx, dtdy, 
+			   qmX, qmY,
+			   qpX, qpY);
+
+    // store qm, qp : only what is really needed
+    Qm_x(i  ,j  , ID) = qmX[ID];
+    Qp_x(i  ,j  , ID) = qpX[ID];
+    Qm_y(i  ,j  , ID) = qmY[ID];
+    Qp_y(i  ,j  , ID) = qpY[ID];
       
-      Qm_x(i  ,j  , IP) = qmX[IP];
-      Qp_x(i  ,j  , IP) = qpX[IP];
-      Qm_y(i  ,j  , IP) = qmY[IP];
-      Qp_y(i  ,j  , IP) = qpY[IP];
+    Qm_x(i  ,j  , IP) = qmX[IP];
+    Qp_x(i  ,j  , IP) = qpX[IP];
+    Qm_y(i  ,j  , IP) = qmY[IP];
+    Qp_y(i  ,j  , IP) = qpY[IP];
       
-      Qm_x(i  ,j  , IU) = qmX[IU];
-      Qp_x(i  ,j  , IU) = qpX[IU];
-      Qm_y(i  ,j  , IU) = qmY[IU];
-      Qp_y(i  ,j  , IU) = qpY[IU];
+    Qm_x(i  ,j  , IU) = qmX[IU];
+    Qp_x(i  ,j  , IU) = qpX[IU];
+    Qm_y(i  ,j  , IU) = qmY[IU];
+    Qp_y(i  ,j  , IU) = qpY[IU];
       
-      Qm_x(i  ,j  , IV) = qmX[IV];
-      Qp_x(i  ,j  , IV) = qpX[IV];
-      Qm_y(i  ,j  , IV) = qmY[IV];
-      Qp_y(i  ,j  , IV) = qpY[IV];
+    Qm_x(i  ,j  , IV) = qmX[IV];
+    Qp_x(i  ,j  , IV) = qpX[IV];
+    Qm_y(i  ,j  , IV) = qmY[IV];
+    Qp_y(i  ,j  , IV) = qpY[IV];
       
-    }
   }
 
   DataArray2d Qdata;
@@ -601,231 +662,226 @@ public:
 		    bool gravity_enabled,
 		    VectorField2d gravity)
   {
-    int nbCells = params.isize * params.jsize;
+    const int isize = params.isize;
+    const int jsize = params.jsize;
+    const int ghostWidth = params.ghostWidth;
+
     ComputeAndStoreFluxesFunctor2D functor(params, Qdata,
 					   FluxData_x, FluxData_y,
 					   dt,
 					   gravity_enabled,
 					   gravity);
-    Kokkos::parallel_for(nbCells, functor);
+    Kokkos::parallel_for("ComputeAndStoreFluxesFunctor2D",
+                         md_policy_2d(ghostWidth, ghostWidth,
+                                      isize-ghostWidth+1, jsize-ghostWidth+1,
+                                      params.mdrange_tile),
+                         functor);
   }
 
   KOKKOS_INLINE_FUNCTION
-  void operator()(const int& index) const
+  void operator()(const int& i, const int& j) const
   {
-    const int isize = params.isize;
-    const int jsize = params.jsize;
-    const int ghostWidth = params.ghostWidth;
-    
-    int i,j;
-    index2coord(index,i,j,isize,jsize);
-    
-    if(j >= ghostWidth && j <= jsize-ghostWidth  &&
-       i >= ghostWidth && i <= isize-ghostWidth ) {
-      
-      // local primitive variables
-      HydroState qLoc; // local primitive variables
+    // local primitive variables
+    HydroState qLoc; // local primitive variables
       
-      // local primitive variables in neighbor cell
-      HydroState qLocNeighbor;
+    // local primitive variables in neighbor cell
+    HydroState qLocNeighbor;
       
-      // local primitive variables in neighborbood
-      HydroState qNeighbors_0;
-      HydroState qNeighbors_1;
-      HydroState qNeighbors_2;
-      HydroState qNeighbors_3;
+    // local primitive variables in neighborbood
+    HydroState qNeighbors_0;
+    HydroState qNeighbors_1;
+    HydroState qNeighbors_2;
+    HydroState qNeighbors_3;
       
-      // Local slopes and neighbor slopes
-      HydroState dqX;
-      HydroState dqY;
-      HydroState dqX_neighbor;
-      HydroState dqY_neighbor;
-
-      // Local variables for Riemann problems solving
-      HydroState qleft;
-      HydroState qright;
-      HydroState qgdnv;
-      HydroState flux_x;
-      HydroState flux_y;
-
-      //!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
-      // deal with left interface along X !
-      //!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
-
-      // get primitive variables state vector
-      qLoc[ID]         = Qdata(i  ,j  , ID);
-      qNeighbors_0[ID] = Qdata(i+1,j  , ID);
-      qNeighbors_1[ID] = Qdata(i-1,j  , ID);
-      qNeighbors_2[ID] = Qdata(i  ,j+1, ID);
-      qNeighbors_3[ID] = Qdata(i  ,j-1, ID);
+    // Local slopes and neighbor slopes
+    HydroState dqX;
+    HydroState dqY;
+    HydroState dqX_neighbor;
+    HydroState dqY_neighbor;
+
+    // Local variables for Riemann problems solving
+    HydroState qleft;
+    HydroState qright;
+    HydroState qgdnv;
+    HydroState flux_x;
+    HydroState flux_y;
+
+    //!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+    // deal with left interface along X !
+    //!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+
+    // get primitive variables state vector
+    qLoc[ID]         = Qdata(i  ,j  , ID);
+    qNeighbors_0[ID] = Qdata(i+1,j  , ID);
+    qNeighbors_1[ID] = Qdata(i-1,j  , ID);
+    qNeighbors_2[ID] = Qdata(i  ,j+1, ID);
+    qNeighbors_3[ID] = Qdata(i  ,j-1, ID);
       
-      qLoc[IP]         = Qdata(i  ,j  , IP);
-      qNeighbors_0[IP] = Qdata(i+1,j  , IP);
-      qNeighbors_1[IP] = Qdata(i-1,j  , IP);
-      qNeighbors_2[IP] = Qdata(i  ,j+1, IP);
-      qNeighbors_3[IP] = Qdata(i  ,j-1, IP);
+    qLoc[IP]         = Qdata(i  ,j  , IP);
+    qNeighbors_0[IP] = Qdata(i+1,j  , IP);
+    qNeighbors_1[IP] = Qdata(i-1,j  , IP);
+    qNeighbors_2[IP] = Qdata(i  ,j+1, IP);
+    qNeighbors_3[IP] = Qdata(i  ,j-1, IP);
       
-      qLoc[IU]         = Qdata(i  ,j  , IU);
-      qNeighbors_0[IU] = Qdata(i+1,j  , IU);
-      qNeighbors_1[IU] = Qdata(i-1,j  , IU);
-      qNeighbors_2[IU] = Qdata(i  ,j+1, IU);
-      qNeighbors_3[IU] = Qdata(i  ,j-1, IU);
+    qLoc[IU]         = Qdata(i  ,j  , IU);
+    qNeighbors_0[IU] = Qdata(i+1,j  , IU);
+    qNeighbors_1[IU] = Qdata(i-1,j  , IU);
+    qNeighbors_2[IU] = Qdata(i  ,j+1, IU);
+    qNeighbors_3[IU] = Qdata(i  ,j-1, IU);
       
-      qLoc[IV]         = Qdata(i  ,j  , IV);
-      qNeighbors_0[IV] = Qdata(i+1,j  , IV);
-      qNeighbors_1[IV] = Qdata(i-1,j  , IV);
-      qNeighbors_2[IV] = Qdata(i  ,j+1, IV);
-      qNeighbors_3[IV] = Qdata(i  ,j-1, IV);
+    qLoc[IV]         = Qdata(i  ,j  , IV);
+    qNeighbors_0[IV] = Qdata(i+1,j  , IV);
+    qNeighbors_1[IV] = Qdata(i-1,j  , IV);
+    qNeighbors_2[IV] = Qdata(i  ,j+1, IV);
+    qNeighbors_3[IV] = Qdata(i  ,j-1, IV);
       
-      slope_unsplit_hydro_2d(qLoc, 
-			     qNeighbors_0, qNeighbors_1, 
-			     qNeighbors_2, qNeighbors_3,
-			     dqX, dqY);
+    slope_unsplit_hydro_2d(qLoc, 
+			   qNeighbors_0, qNeighbors_1, 
+			   qNeighbors_2, qNeighbors_3,
+			   dqX, dqY);
       
-      // slopes at left neighbor along X      
-      qLocNeighbor[ID] = Qdata(i-1,j  , ID);
-      qNeighbors_0[ID] = Qdata(i  ,j  , ID);
-      qNeighbors_1[ID] = Qdata(i-2,j  , ID);
-      qNeighbors_2[ID] = Qdata(i-1,j+1, ID);
-      qNeighbors_3[ID] = Qdata(i-1,j-1, ID);
+    // slopes at left neighbor along X      
+    qLocNeighbor[ID] = Qdata(i-1,j  , ID);
+    qNeighbors_0[ID] = Qdata(i  ,j  , ID);
+    qNeighbors_1[ID] = Qdata(i-2,j  , ID);
+    qNeighbors_2[ID] = Qdata(i-1,j+1, ID);
+    qNeighbors_3[ID] = Qdata(i-1,j-1, ID);
       
-      qLocNeighbor[IP] = Qdata(i-1,j  , IP);
-      qNeighbors_0[IP] = Qdata(i  ,j  , IP);
-      qNeighbors_1[IP] = Qdata(i-2,j  , IP);
-      qNeighbors_2[IP] = Qdata(i-1,j+1, IP);
-      qNeighbors_3[IP] = Qdata(i-1,j-1, IP);
+    qLocNeighbor[IP] = Qdata(i-1,j  , IP);
+    qNeighbors_0[IP] = Qdata(i  ,j  , IP);
+    qNeighbors_1[IP] = Qdata(i-2,j  , IP);
+    qNeighbors_2[IP] = Qdata(i-1,j+1, IP);
+    qNeighbors_3[IP] = Qdata(i-1,j-1, IP);
       
-      qLocNeighbor[IU] = Qdata(i-1,j  , IU);
-      qNeighbors_0[IU] = Qdata(i  ,j  , IU);
-      qNeighbors_1[IU] = Qdata(i-2,j  , IU);
-      qNeighbors_2[IU] = Qdata(i-1,j+1, IU);
-      qNeighbors_3[IU] = Qdata(i-1,j-1, IU);
+    qLocNeighbor[IU] = Qdata(i-1,j  , IU);
+    qNeighbors_0[IU] = Qdata(i  ,j  , IU);
+    qNeighbors_1[IU] = Qdata(i-2,j  , IU);
+    qNeighbors_2[IU] = Qdata(i-1,j+1, IU);
+    qNeighbors_3[IU] = Qdata(i-1,j-1, IU);
       
-      qLocNeighbor[IV] = Qdata(i-1,j  , IV);
-      qNeighbors_0[IV] = Qdata(i  ,j  , IV);
-      qNeighbors_1[IV] = Qdata(i-2,j  , IV);
-      qNeighbors_2[IV] = Qdata(i-1,j+1, IV);
-      qNeighbors_3[IV] = Qdata(i-1,j-1, IV);
+    qLocNeighbor[IV] = Qdata(i-1,j  , IV);
+    qNeighbors_0[IV] = Qdata(i  ,j  , IV);
+    qNeighbors_1[IV] = Qdata(i-2,j  , IV);
+    qNeighbors_2[IV] = Qdata(i-1,j+1, IV);
+    qNeighbors_3[IV] = Qdata(i-1,j-1, IV);
       
-      slope_unsplit_hydro_2d(qLocNeighbor, 
-			     qNeighbors_0, qNeighbors_1, 
-			     qNeighbors_2, qNeighbors_3,
-			     dqX_neighbor, dqY_neighbor);
+    slope_unsplit_hydro_2d(qLocNeighbor, 
+			   qNeighbors_0, qNeighbors_1, 
+			   qNeighbors_2, qNeighbors_3,
+			   dqX_neighbor, dqY_neighbor);
       
-      //
-      // compute reconstructed states at left interface along X
-      //
+    //
+    // compute reconstructed states at left interface along X
+    //
       
-      // left interface : right state
-      trace_unsplit_2d_along_dir(qLoc,
-				 dqX, dqY,
-				 dtdx, dtdy, FACE_XMIN, qright);
+    // left interface : right state
+    trace_unsplit_2d_along_dir(qLoc,
+			       dqX, dqY,
+			       dtdx, dtdy, FACE_XMIN, qright);
       
-      // left interface : left state
-      trace_unsplit_2d_along_dir(qLocNeighbor,
-				 dqX_neighbor,dqY_neighbor,
-				 dtdx, dtdy, FACE_XMAX, qleft);
+    // left interface : left state
+    trace_unsplit_2d_along_dir(qLocNeighbor,
+			       dqX_neighbor,dqY_neighbor,
+			       dtdx, dtdy, FACE_XMAX, qleft);
       
-      if (gravity_enabled) {
-	// we need to modify input to flux computation with
-	// gravity predictor (half time step)
+    if (gravity_enabled) {
+      // we need to modify input to flux computation with
+      // gravity predictor (half time step)
 	
-	qleft[IU]  += 0.5 * dt * gravity(i-1,j,IX);
-	qleft[IV]  += 0.5 * dt * gravity(i-1,j,IY);
+      qleft[IU]  += 0.5 * dt * gravity(i-1,j,IX);
+      qleft[IV]  += 0.5 * dt * gravity(i-1,j,IY);
 
-	qright[IU] += 0.5 * dt * gravity(i,j,IX);
-	qright[IV] += 0.5 * dt * gravity(i,j,IY);
+      qright[IU] += 0.5 * dt * gravity(i,j,IX);
+      qright[IV] += 0.5 * dt * gravity(i,j,IY);
 
-      }
+    }
       
-      // Solve Riemann problem at X-interfaces and compute X-fluxes
-      //riemann_2d(qleft,qright,qgdnv,flux_x);
-      riemann_hydro(qleft,qright,qgdnv,flux_x,params);
+    // Solve Riemann problem at X-interfaces and compute X-fluxes
+    //riemann_2d(qleft,qright,qgdnv,flux_x);
+    riemann_hydro(qleft,qright,qgdnv,flux_x,params);
 	
-      //
-      // store fluxes X
-      //
-      FluxData_x(i  ,j  , ID) = flux_x[ID] * dtdx;
-      FluxData_x(i  ,j  , IP) = flux_x[IP] * dtdx;
-      FluxData_x(i  ,j  , IU) = flux_x[IU] * dtdx;
-      FluxData_x(i  ,j  , IV) = flux_x[IV] * dtdx;
+    //
+    // store fluxes X
+    //
+    FluxData_x(i  ,j  , ID) = flux_x[ID] * dtdx;
+    FluxData_x(i  ,j  , IP) = flux_x[IP] * dtdx;
+    FluxData_x(i  ,j  , IU) = flux_x[IU] * dtdx;
+    FluxData_x(i  ,j  , IV) = flux_x[IV] * dtdx;
       
-      //!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
-      // deal with left interface along Y !
-      //!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
-
-      // slopes at left neighbor along Y
-      qLocNeighbor[ID] = Qdata(i  ,j-1, ID);
-      qNeighbors_0[ID] = Qdata(i+1,j-1, ID);
-      qNeighbors_1[ID] = Qdata(i-1,j-1, ID);
-      qNeighbors_2[ID] = Qdata(i  ,j  , ID);
-      qNeighbors_3[ID] = Qdata(i  ,j-2, ID);
+    //!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+    // deal with left interface along Y !
+    //!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+
+    // slopes at left neighbor along Y
+    qLocNeighbor[ID] = Qdata(i  ,j-1, ID);
+    qNeighbors_0[ID] = Qdata(i+1,j-1, ID);
+    qNeighbors_1[ID] = Qdata(i-1,j-1, ID);
+    qNeighbors_2[ID] = Qdata(i  ,j  , ID);
+    qNeighbors_3[ID] = Qdata(i  ,j-2, ID);
       
-      qLocNeighbor[IP] = Qdata(i  ,j-1, IP);
-      qNeighbors_0[IP] = Qdata(i+1,j-1, IP);
-      qNeighbors_1[IP] = Qdata(i-1,j-1, IP);
-      qNeighbors_2[IP] = Qdata(i  ,j  , IP);
-      qNeighbors_3[IP] = Qdata(i  ,j-2, IP);
+    qLocNeighbor[IP] = Qdata(i  ,j-1, IP);
+    qNeighbors_0[IP] = Qdata(i+1,j-1, IP);
+    qNeighbors_1[IP] = Qdata(i-1,j-1, IP);
+    qNeighbors_2[IP] = Qdata(i  ,j  , IP);
+    qNeighbors_3[IP] = Qdata(i  ,j-2, IP);
       
-      qLocNeighbor[IU] = Qdata(i  ,j-1, IU);
-      qNeighbors_0[IU] = Qdata(i+1,j-1, IU);
-      qNeighbors_1[IU] = Qdata(i-1,j-1, IU);
-      qNeighbors_2[IU] = Qdata(i  ,j  , IU);
-      qNeighbors_3[IU] = Qdata(i  ,j-2, IU);
+    qLocNeighbor[IU] = Qdata(i  ,j-1, IU);
+    qNeighbors_0[IU] = Qdata(i+1,j-1, IU);
+    qNeighbors_1[IU] = Qdata(i-1,j-1, IU);
+    qNeighbors_2[IU] = Qdata(i  ,j  , IU);
+    qNeighbors_3[IU] = Qdata(i  ,j-2, IU);
       
-      qLocNeighbor[IV] = Qdata(i  ,j-1, IV);
-      qNeighbors_0[IV] = Qdata(i+1,j-1, IV);
-      qNeighbors_1[IV] = Qdata(i-1,j-1, IV);
-      qNeighbors_2[IV] = Qdata(i  ,j  , IV);
-      qNeighbors_3[IV] = Qdata(i  ,j-2, IV);
+    qLocNeighbor[IV] = Qdata(i  ,j-1, IV);
+    qNeighbors_0[IV] = Qdata(i+1,j-1, IV);
+    qNeighbors_1[IV] = Qdata(i-1,j-1, IV);
+    qNeighbors_2[IV] = Qdata(i  ,j  , IV);
+    qNeighbors_3[IV] = Qdata(i  ,j-2, IV);
 	
-      slope_unsplit_hydro_2d(qLocNeighbor, 
-			     qNeighbors_0, qNeighbors_1, 
-			     qNeighbors_2, qNeighbors_3,
-			     dqX_neighbor, dqY_neighbor);
-
-      //
-      // compute reconstructed states at left interface along Y
-      //
+    slope_unsplit_hydro_2d(qLocNeighbor, 
+			   qNeighbors_0, qNeighbors_1, 
+			   qNeighbors_2, qNeighbors_3,
+			   dqX_neighbor, dqY_neighbor);
+
+    //
+    // compute reconstructed states at left interface along Y
+    //
 	
-      // left interface : right state
-      trace_unsplit_2d_along_dir(qLoc,
-				 dqX, dqY,
-				 dtdx, dtdy, FACE_YMIN, qright);
-
-      // left interface : left state
-      trace_unsplit_2d_along_dir(qLocNeighbor,
-				 dqX_neighbor,dqY_neighbor,
-				 dtdx, dtdy, FACE_YMAX, qleft);
-
-      if (gravity_enabled) {
-	// we need to modify input to flux computation with
-	// gravity predictor (half time step)
+    // left interface : right state
+    trace_unsplit_2d_along_dir(qLoc,
+			       dqX, dqY,
+			       dtdx, dtdy, FACE_YMIN, qright);
+
+    // left interface : left state
+    trace_unsplit_2d_along_dir(qLocNeighbor,
+			       dqX_neighbor,dqY_neighbor,
+			       dtdx, dtdy, FACE_YMAX, qleft);
+
+    if (gravity_enabled) {
+      // we need to modify input to flux computation with
+      // gravity predictor (half time step)
 	
-	qleft[IU]  += 0.5 * dt * gravity(i,j-1,IX);
-	qleft[IV]  += 0.5 * dt * gravity(i,j-1,IY);
-
-	qright[IU] += 0.5 * dt * gravity(i,j,IX);
-	qright[IV] += 0.5 * dt * gravity(i,j,IY);
+      qleft[IU]  += 0.5 * dt * gravity(i,j-1,IX);
+      qleft[IV]  += 0.5 * dt * gravity(i,j-1,IY);
 
-      }
+      qright[IU] += 0.5 * dt * gravity(i,j,IX);
+      qright[IV] += 0.5 * dt * gravity(i,j,IY);
 
-      // Solve Riemann problem at Y-interfaces and compute Y-fluxes
-      swapValues(&(qleft[IU]) ,&(qleft[IV]) );
-      swapValues(&(qright[IU]),&(qright[IV]));
-      //riemann_2d(qleft,qright,qgdnv,flux_y);
-      riemann_hydro(qleft,qright,qgdnv,flux_y,params);
+    }
 
-      //
-      // store fluxes Y
-      //
-      FluxData_y(i  ,j  , ID) = flux_y[ID] * dtdy;
-      FluxData_y(i  ,j  , IP) = flux_y[IP] * dtdy;
-      FluxData_y(i  ,j  , IU) = flux_y[IV] * dtdy; //
-      FluxData_y(i  ,j  , IV) = flux_y[IU] * dtdy; //
+    // Solve Riemann problem at Y-interfaces and compute Y-fluxes
+    swapValues(&(qleft[IU]) ,&(qleft[IV]) );
+    swapValues(&(qright[IU]),&(qright[IV]));
+    //riemann_2d(qleft,qright,qgdnv,flux_y);
+    riemann_hydro(qleft,qright,qgdnv,flux_y,params);
+
+    //
+    // store fluxes Y
+    //
+    FluxData_y(i  ,j  , ID) = flux_y[ID] * dtdy;
+    FluxData_y(i  ,j  , IP) = flux_y[IP] * dtdy;
+    FluxData_y(i  ,j  , IU) = flux_y[IV] * dtdy; //
+    FluxData_y(i  ,j  , IV) = flux_y[IU] * dtdy; //
           
-    } // end if
-    
   } // end operator ()
   
   DataArray2d Qdata;
@@ -868,47 +924,42 @@ public:
                     DataArray2d Udata,
 		    DataArray2d FluxData_x,
 		    DataArray2d FluxData_y)
-  {
-    int nbCells = params.isize * params.jsize;
-    UpdateFunctor2D functor(params, Udata, FluxData_x, FluxData_y);
-    Kokkos::parallel_for(nbCells, functor);
-  }
-
-  KOKKOS_INLINE_FUNCTION
-  void operator()(const int& index) const
   {
     const int isize = params.isize;
     const int jsize = params.jsize;
     const int ghostWidth = params.ghostWidth;
-    
-    int i,j;
-    index2coord(index,i,j,isize,jsize);
-
-    if(j >= ghostWidth && j < jsize-ghostWidth  &&
-       i >= ghostWidth && i < isize-ghostWidth ) {
 
-      Udata(i  ,j  , ID) +=  FluxData_x(i  ,j  , ID);
-      Udata(i  ,j  , IP) +=  FluxData_x(i  ,j  , IP);
-      Udata(i  ,j  , IU) +=  FluxData_x(i  ,j  , IU);
-      Udata(i  ,j  , IV) +=  FluxData_x(i  ,j  , IV);
+    UpdateFunctor2D functor(params, Udata, FluxData_x, FluxData_y);
+    Kokkos::parallel_for("UpdateFunctor2D",
+                         md_policy_2d(ghostWidth, ghostWidth,
+                                      isize-ghostWidth, jsize-ghostWidth,
+                                      params.mdrange_tile),
+                         functor);
+  }
 
-      Udata(i  ,j  , ID) -=  FluxData_x(i+1,j  , ID);
-      Udata(i  ,j  , IP) -=  FluxData_x(i+1,j  , IP);
-      Udata(i  ,j  , IU) -=  FluxData_x(i+1,j  , IU);
-      Udata(i  ,j  , IV) -=  FluxData_x(i+1,j  , IV);
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const int& i, const int& j) const
+  {
+    Udata(i  ,j  , ID) +=  FluxData_x(i  ,j  , ID);
+    Udata(i  ,j  , IP) +=  FluxData_x(i  ,j  , IP);
+    Udata(i  ,j  , IU) +=  FluxData_x(i  ,j  , IU);
+    Udata(i  ,j  , IV) +=  FluxData_x(i  ,j  , IV);
+
+    Udata(i  ,j  , ID) -=  FluxData_x(i+1,j  , ID);
+    Udata(i  ,j  , IP) -=  FluxData_x(i+1,j  , IP);
+    Udata(i  ,j  , IU) -=  FluxData_x(i+1,j  , IU);
+    Udata(i  ,j  , IV) -=  FluxData_x(i+1,j  , IV);
       
-      Udata(i  ,j  , ID) +=  FluxData_y(i  ,j  , ID);
-      Udata(i  ,j  , IP) +=  FluxData_y(i  ,j  , IP);
-      Udata(i  ,j  , IU) +=  FluxData_y(i  ,j  , IU);
-      Udata(i  ,j  , IV) +=  FluxData_y(i  ,j  , IV);
+    Udata(i  ,j  , ID) +=  FluxData_y(i  ,j  , ID);
+    Udata(i  ,j  , IP) +=  FluxData_y(i  ,j  , IP);
+    Udata(i  ,j  , IU) +=  FluxData_y(i  ,j  , IU);
+    Udata(i  ,j  , IV) +=  FluxData_y(i  ,j  , IV);
       
-      Udata(i  ,j  , ID) -=  FluxData_y(i  ,j+1, ID);
-      Udata(i  ,j  , IP) -=  FluxData_y(i  ,j+1, IP);
-      Udata(i  ,j  , IU) -=  FluxData_y(i  ,j+1, IU);
-      Udata(i  ,j  , IV) -=  FluxData_y(i  ,j+1, IV);
+    Udata(i  ,j  , ID) -=  FluxData_y(i  ,j+1, ID);
+    Udata(i  ,j  , IP) -=  FluxData_y(i  ,j+1, IP);
+    Udata(i  ,j  , IU) -=  FluxData_y(i  ,j+1, IU);
+    Udata(i  ,j  , IV) -=  FluxData_y(i  ,j+1, IV);
 
-    } // end if
-    
   } // end operator ()
   
   DataArray2d Udata;
@@ -945,52 +996,47 @@ public:
                     DataArray2d Udata,
 		    DataArray2d FluxData)
   {
-    int nbCells = params.isize * params.jsize;
+    const int isize = params.isize;
+    const int jsize = params.jsize;
+    const int ghostWidth = params.ghostWidth;
+
     UpdateDirFunctor2D<dir> functor(params, Udata, FluxData);
-    Kokkos::parallel_for(nbCells, functor);
+    Kokkos::parallel_for("UpdateDirFunctor2D",
+                         md_policy_2d(ghostWidth, ghostWidth,
+                                      isize-ghostWidth, jsize-ghostWidth,
+                                      params.mdrange_tile),
+                         functor);
   }
 
   KOKKOS_INLINE_FUNCTION
-  void operator()(const int& index) const
+  void operator()(const int& i, const int& j) const
   {
-    const int isize = params.isize;
-    const int jsize = params.jsize;
-    const int ghostWidth = params.ghostWidth;
-    
-    int i,j;
-    index2coord(index,i,j,isize,jsize);
-    
-    if(j >= ghostWidth && j < jsize-ghostWidth  &&
-       i >= ghostWidth && i < isize-ghostWidth ) {
+    if (dir == XDIR) {
 
-      if (dir == XDIR) {
+      Udata(i  ,j  , ID) +=  FluxData(i  ,j  , ID);
+      Udata(i  ,j  , IP) +=  FluxData(i  ,j  , IP);
+      Udata(i  ,j  , IU) +=  FluxData(i  ,j  , IU);
+      Udata(i  ,j  , IV) +=  FluxData(i  ,j  , IV);
 
-	Udata(i  ,j  , ID) +=  FluxData(i  ,j  , ID);
-	Udata(i  ,j  , IP) +=  FluxData(i  ,j  , IP);
-	Udata(i  ,j  , IU) +=  FluxData(i  ,j  , IU);
-	Udata(i  ,j  , IV) +=  FluxData(i  ,j  , IV);
+      Udata(i  ,j  , ID) -=  FluxData(i+1,j  , ID);
+      Udata(i  ,j  , IP) -=  FluxData(i+1,j  , IP);
+      Udata(i  ,j  , IU) -=  FluxData(i+1,j  , IU);
+      Udata(i  ,j  , IV) -=  FluxData(i+1,j  , IV);
 
-	Udata(i  ,j  , ID) -=  FluxData(i+1,j  , ID);
-	Udata(i  ,j  , IP) -=  FluxData(i+1,j  , IP);
-	Udata(i  ,j  , IU) -=  FluxData(i+1,j  , IU);
-	Udata(i  ,j  , IV) -=  FluxData(i+1,j  , IV);
+    } else if (dir == YDIR) {
 
-      } else if (dir == YDIR) {
-
-	Udata(i  ,j  , ID) +=  FluxData(i  ,j  , ID);
-	Udata(i  ,j  , IP) +=  FluxData(i  ,j  , IP);
-	Udata(i  ,j  , IU) +=  FluxData(i  ,j  , IU);
-	Udata(i  ,j  , IV) +=  FluxData(i  ,j  , IV);
+      Udata(i  ,j  , ID) +=  FluxData(i  ,j  , ID);
+      Udata(i  ,j  , IP) +=  FluxData(i  ,j  , IP);
+      Udata(i  ,j  , IU) +=  FluxData(i  ,j  , IU);
+      Udata(i  ,j  , IV) +=  FluxData(i  ,j  , IV);
 	
-	Udata(i  ,j  , ID) -=  FluxData(i  ,j+1, ID);
-	Udata(i  ,j  , IP) -=  FluxData(i  ,j+1, IP);
-	Udata(i  ,j  , IU) -=  FluxData(i  ,j+1, IU);
-	Udata(i  ,j  , IV) -=  FluxData(i  ,j+1, IV);
+      Udata(i  ,j  , ID) -=  FluxData(i  ,j+1, ID);
+      Udata(i  ,j  , IP) -=  FluxData(i  ,j+1, IP);
+      Udata(i  ,j  , IU) -=  FluxData(i  ,j+1, IU);
+      Udata(i  ,j  , IV) -=  FluxData(i  ,j+1, IV);
 
-      }
+    }
       
-    } // end if
-    
   } // end operator ()
   
   DataArray2d Udata;
@@ -1026,82 +1072,77 @@ public:
 		    DataArray2d Slopes_x,
 		    DataArray2d Slopes_y)
   {
-    int nbCells = params.isize * params.jsize;
+    const int isize = params.isize;
+    const int jsize = params.jsize;
+    const int ghostWidth = params.ghostWidth;
+
     ComputeSlopesFunctor2D functor(params, Qdata, Slopes_x, Slopes_y);
-    Kokkos::parallel_for(nbCells, functor);
+    Kokkos::parallel_for("ComputeSlopesFunctor2D",
+                         md_policy_2d(ghostWidth-1, ghostWidth-1,
+                                      isize-ghostWidth+1, jsize-ghostWidth+1,
+                                      params.mdrange_tile),
+                         functor);
   }
 
   KOKKOS_INLINE_FUNCTION
-  void operator()(const int& index) const
+  void operator()(const int& i, const int& j) const
   {
-    const int isize = params.isize;
-    const int jsize = params.jsize;
-    const int ghostWidth = params.ghostWidth;
+      // local primitive variables
+      HydroState qLoc; // local primitive variables
+
+      // local primitive variables in neighborbood
+      HydroState qNeighbors_0;
+      HydroState qNeighbors_1;
+      HydroState qNeighbors_2;
+      HydroState qNeighbors_3;
+
+      // Local slopes and neighbor slopes
+      HydroState dqX{};
+      HydroState dqY{};
+
+      // get primitive variables state vector
+      qLoc[ID]         = Qdata(i  ,j  , ID);
+      qNeighbors_0[ID] = Qdata(i+1,j  , ID);
+      qNeighbors_1[ID] = Qdata(i-1,j  , ID);
+      qNeighbors_2[ID] = Qdata(i  ,j+1, ID);
+      qNeighbors_3[ID] = Qdata(i  ,j-1, ID);
 
-    int i,j;
-    index2coord(index,i,j,isize,jsize);
-
-    if(j >= ghostWidth-1 && j <= jsize-ghostWidth  &&
-       i >= ghostWidth-1 && i <= isize-ghostWidth ) {
-
-      	// local primitive variables
-	HydroState qLoc; // local primitive variables
-
-	// local primitive variables in neighborbood
-	HydroState qNeighbors_0;
-	HydroState qNeighbors_1;
-	HydroState qNeighbors_2;
-	HydroState qNeighbors_3;
-
-	// Local slopes and neighbor slopes
-	HydroState dqX{};
-	HydroState dqY{};
-
-	// get primitive variables state vector
-	qLoc[ID]         = Qdata(i  ,j  , ID);
-	qNeighbors_0[ID] = Qdata(i+1,j  , ID);
-	qNeighbors_1[ID] = Qdata(i-1,j  , ID);
-	qNeighbors_2[ID] = Qdata(i  ,j+1, ID);
-	qNeighbors_3[ID] = Qdata(i  ,j-1, ID);
-
-	qLoc[IP]         = Qdata(i  ,j  , IP);
-	qNeighbors_0[IP] = Qdata(i+1,j  , IP);
-	qNeighbors_1[IP] = Qdata(i-1,j  , IP);
-	qNeighbors_2[IP] = Qdata(i  ,j+1, IP);
-	qNeighbors_3[IP] = Qdata(i  ,j-1, IP);
+      qLoc[IP]         = Qdata(i  ,j  , IP);
+      qNeighbors_0[IP] = Qdata(i+1,j  , IP);
+      qNeighbors_1[IP] = Qdata(i-1,j  , IP);
+      qNeighbors_2[IP] = Qdata(i  ,j+1, IP);
+      qNeighbors_3[IP] = Qdata(i  ,j-1, IP);
 	
-	qLoc[IU]         = Qdata(i  ,j  , IU);
-	qNeighbors_0[IU] = Qdata(i+1,j  , IU);
-	qNeighbors_1[IU] = Qdata(i-1,j  , IU);
-	qNeighbors_2[IU] = Qdata(i  ,j+1, IU);
-	qNeighbors_3[IU] = Qdata(i  ,j-1, IU);
+      qLoc[IU]         = Qdata(i  ,j  , IU);
+      qNeighbors_0[IU] = Qdata(i+1,j  , IU);
+      qNeighbors_1[IU] = Qdata(i-1,j  , IU);
+      qNeighbors_2[IU] = Qdata(i  ,j+1, IU);
+      qNeighbors_3[IU] = Qdata(i  ,j-1, IU);
 	
-	qLoc[IV]         = Qdata(i  ,j  , IV);
-	qNeighbors_0[IV] = Qdata(i+1,j  , IV);
-	qNeighbors_1[IV] = Qdata(i-1,j  , IV);
-	qNeighbors_2[IV] = Qdata(i  ,j+1, IV);
-	qNeighbors_3[IV] = Qdata(i  ,j-1, IV);
+      qLoc[IV]         = Qdata(i  ,j  , IV);
+      qNeighbors_0[IV] = Qdata(i+1,j  , IV);
+      qNeighbors_1[IV] = Qdata(i-1,j  , IV);
+      qNeighbors_2[IV] = Qdata(i  ,j+1, IV);
+      qNeighbors_3[IV] = Qdata(i  ,j-1, IV);
 	
-	slope_unsplit_hydro_2d(qLoc, 
-			       qNeighbors_0, qNeighbors_1, 
-			       qNeighbors_2, qNeighbors_3,
-			       dqX, dqY);
+      slope_unsplit_hydro_2d(qLoc, 
+			     qNeighbors_0, qNeighbors_1, 
+			     qNeighbors_2, qNeighbors_3,
+			     dqX, dqY);
 	
-	// copy back slopes in global arrays
-	Slopes_x(i  ,j, ID) = dqX[ID];
-	Slopes_y(i  ,j, ID) = dqY[ID];
+      // copy back slopes in global arrays
+      Slopes_x(i  ,j, ID) = dqX[ID];
+      Slopes_y(i  ,j, ID) = dqY[ID];
 	
-	Slopes_x(i  ,j, IP) = dqX[IP];
-	Slopes_y(i  ,j, IP) = dqY[IP];
+      Slopes_x(i  ,j, IP) = dqX[IP];
+      Slopes_y(i  ,j, IP) = dqY[IP];
 	
-	Slopes_x(i  ,j, IU) = dqX[IU];
-	Slopes_y(i  ,j, IU) = dqY[IU];
+      Slopes_x(i  ,j, IU) = dqX[IU];
+      Slopes_y(i  ,j, IU) = dqY[IU];
 	
-	Slopes_x(i  ,j, IV) = dqX[IV];
-	Slopes_y(i  ,j, IV) = dqY[IV];
+      Slopes_x(i  ,j, IV) = dqX[IV];
+      Slopes_y(i  ,j, IV) = dqY[IV];
       
-    } // end if
-    
   } // end operator ()
   
   DataArray2d Qdata;
@@ -1154,186 +1195,181 @@ public:
 		    bool          gravity_enabled,
 		    VectorField2d gravity)
   {
-    int nbCells = params.isize * params.jsize;
+    const int isize = params.isize;
+    const int jsize = params.jsize;
+    const int ghostWidth = params.ghostWidth;
+
     ComputeTraceAndFluxes_Functor2D<dir> functor(params, Qdata,
 						 Slopes_x, Slopes_y,
 						 Fluxes,
 						 dt,
 						 gravity_enabled,
 						 gravity);
-    Kokkos::parallel_for(nbCells, functor);
+    Kokkos::parallel_for("ComputeTraceAndFluxes_Functor2D",
+                         md_policy_2d(ghostWidth, ghostWidth,
+                                      isize-ghostWidth+1, jsize-ghostWidth+1,
+                                      params.mdrange_tile),
+                         functor);
   }
 
   KOKKOS_INLINE_FUNCTION
-  void operator()(const int& index) const
+  void operator()(const int& i, const int& j) const
   {
-    const int isize = params.isize;
-    const int jsize = params.jsize;
-    const int ghostWidth = params.ghostWidth;
-    
-    int i,j;
-    index2coord(index,i,j,isize,jsize);
-    
-    if(j >= ghostWidth && j <= jsize-ghostWidth  &&
-       i >= ghostWidth && i <= isize-ghostWidth ) {
-
-	// local primitive variables
-	HydroState qLoc; // local primitive variables
+      // local primitive variables
+      HydroState qLoc; // local primitive variables
 
-	// local primitive variables in neighbor cell
-	HydroState qLocNeighbor;
+      // local primitive variables in neighbor cell
+      HydroState qLocNeighbor;
 
-	// Local slopes and neighbor slopes
-	HydroState dqX;
-	HydroState dqY;
-	HydroState dqX_neighbor;
-	HydroState dqY_neighbor;
+      // Local slopes and neighbor slopes
+      HydroState dqX;
+      HydroState dqY;
+      HydroState dqX_neighbor;
+      HydroState dqY_neighbor;
 
-	// Local variables for Riemann problems solving
-	HydroState qleft;
-	HydroState qright;
-	HydroState qgdnv;
-	HydroState flux;
+      // Local variables for Riemann problems solving
+      HydroState qleft;
+      HydroState qright;
+      HydroState qgdnv;
+      HydroState flux;
 
-	//
-	// compute reconstructed states at left interface along X
-	//
-	qLoc[ID] = Qdata   (i  ,j, ID);
-	dqX[ID]  = Slopes_x(i  ,j, ID);
-	dqY[ID]  = Slopes_y(i  ,j, ID);
+      //
+      // compute reconstructed states at left interface along X
+      //
+      qLoc[ID] = Qdata   (i  ,j, ID);
+      dqX[ID]  = Slopes_x(i  ,j, ID);
+      dqY[ID]  = Slopes_y(i  ,j, ID);
 	
-	qLoc[IP] = Qdata   (i  ,j, IP);
-	dqX[IP]  = Slopes_x(i  ,j, IP);
-	dqY[IP]  = Slopes_y(i  ,j, IP);
+      qLoc[IP] = Qdata   (i  ,j, IP);
+      dqX[IP]  = Slopes_x(i  ,j, IP);
+      dqY[IP]  = Slopes_y(i  ,j, IP);
 	
-	qLoc[IU] = Qdata   (i  ,j, IU);
-	dqX[IU]  = Slopes_x(i  ,j, IU);
-	dqY[IU]  = Slopes_y(i  ,j, IU);
+      qLoc[IU] = Qdata   (i  ,j, IU);
+      dqX[IU]  = Slopes_x(i  ,j, IU);
+      dqY[IU]  = Slopes_y(i  ,j, IU);
 	
-	qLoc[IV] = Qdata   (i  ,j, IV);
-	dqX[IV]  = Slopes_x(i  ,j, IV);
-	dqY[IV]  = Slopes_y(i  ,j, IV);
+      qLoc[IV] = Qdata   (i  ,j, IV);
+      dqX[IV]  = Slopes_x(i  ,j, IV);
+      dqY[IV]  = Slopes_y(i  ,j, IV);
 
-	if (dir == XDIR) {
+      if (dir == XDIR) {
 
-	  // left interface : right state
-	  trace_unsplit_2d_along_dir(qLoc,
-				     dqX, dqY,
-				     dtdx, dtdy, FACE_XMIN, qright);
+	// left interface : right state
+	trace_unsplit_2d_along_dir(qLoc,
+				   dqX, dqY,
+				   dtdx, dtdy, FACE_XMIN, qright);
 
-	  if (gravity_enabled) {
-	    // we need to modify input to flux computation with
-	    // gravity predictor (half time step)
+	if (gravity_enabled) {
+	  // we need to modify input to flux computation with
+	  // gravity predictor (half time step)
 	    
-	    qright[IU] += 0.5 * dt * gravity(i,j,IX);
-	    qright[IV] += 0.5 * dt * gravity(i,j,IY);
+	  qright[IU] += 0.5 * dt * gravity(i,j,IX);
+	  qright[IV] += 0.5 * dt * gravity(i,j,IY);
 	    
-	  }
+	}
 
-	  qLocNeighbor[ID] = Qdata   (i-1,j  , ID);
-	  dqX_neighbor[ID] = Slopes_x(i-1,j  , ID);
-	  dqY_neighbor[ID] = Slopes_y(i-1,j  , ID);
+	qLocNeighbor[ID] = Qdata   (i-1,j  , ID);
+	dqX_neighbor[ID] = Slopes_x(i-1,j  , ID);
+	dqY_neighbor[ID] = Slopes_y(i-1,j  , ID);
 	  
-	  qLocNeighbor[IP] = Qdata   (i-1,j  , IP);
-	  dqX_neighbor[IP] = Slopes_x(i-1,j  , IP);
-	  dqY_neighbor[IP] = Slopes_y(i-1,j  , IP);
+	qLocNeighbor[IP] = Qdata   (i-1,j  , IP);
+	dqX_neighbor[IP] = Slopes_x(i-1,j  , IP);
+	dqY_neighbor[IP] = Slopes_y(i-1,j  , IP);
 	  
-	  qLocNeighbor[IU] = Qdata   (i-1,j  , IU);
-	  dqX_neighbor[IU] = Slopes_x(i-1,j  , IU);
-	  dqY_neighbor[IU] = Slopes_y(i-1,j  , IU);
+	qLocNeighbor[IU] = Qdata   (i-1,j  , IU);
+	dqX_neighbor[IU] = Slopes_x(i-1,j  , IU);
+	dqY_neighbor[IU] = Slopes_y(i-1,j  , IU);
 	  
-	  qLocNeighbor[IV] = Qdata   (i-1,j  , IV);
-	  dqX_neighbor[IV] = Slopes_x(i-1,j  , IV);
-	  dqY_neighbor[IV] = Slopes_y(i-1,j  , IV);
+	qLocNeighbor[IV] = Qdata   (i-1,j  , IV);
+	dqX_neighbor[IV] = Slopes_x(i-1,j  , IV);
+	dqY_neighbor[IV] = Slopes_y(i-1,j  , IV);
 	  
-	  // left interface : left state
-	  trace_unsplit_2d_along_dir(qLocNeighbor,
-				     dqX_neighbor,dqY_neighbor,
-				     dtdx, dtdy, FACE_XMAX, qleft);
+	// left interface : left state
+	trace_unsplit_2d_along_dir(qLocNeighbor,
+				   dqX_neighbor,dqY_neighbor,
+				   dtdx, dtdy, FACE_XMAX, qleft);
 	  
-	  if (gravity_enabled) {
-	    // we need to modify input to flux computation with
-	    // gravity predictor (half time step)
+	if (gravity_enabled) {
+	  // we need to modify input to flux computation with
+	  // gravity predictor (half time step)
 	    
-	    qleft[IU]  += 0.5 * dt * gravity(i-1,j,IX);
-	    qleft[IV]  += 0.5 * dt * gravity(i-1,j,IY);
+	  qleft[IU]  += 0.5 * dt * gravity(i-1,j,IX);
+	  qleft[IV]  += 0.5 * dt * gravity(i-1,j,IY);
 	    
-	  }
+	}
 	  
-	  // Solve Riemann problem at X-interfaces and compute X-fluxes
-	  riemann_hydro(qleft,qright,qgdnv,flux,params);
-
-	  //
-	  // store fluxes
-	  //	
-	  Fluxes(i  ,j , ID) =  flux[ID]*dtdx;
-	  Fluxes(i  ,j , IP) =  flux[IP]*dtdx;
-	  Fluxes(i  ,j , IU) =  flux[IU]*dtdx;
-	  Fluxes(i  ,j , IV) =  flux[IV]*dtdx;
-
-	} else if (dir == YDIR) {
-
-	  // left interface : right state
-	  trace_unsplit_2d_along_dir(qLoc,
-				     dqX, dqY,
-				     dtdx, dtdy, FACE_YMIN, qright);
-
-	  if (gravity_enabled) {
-	    // we need to modify input to flux computation with
-	    // gravity predictor (half time step)
+	// Solve Riemann problem at X-interfaces and compute X-fluxes
+	riemann_hydro(qleft,qright,qgdnv,flux,params);
+
+	//
+	// store fluxes
+	//	
+	Fluxes(i  ,j , ID) =  flux[ID]*dtdx;
+	Fluxes(i  ,j , IP) =  flux[IP]*dtdx;
+	Fluxes(i  ,j , IU) =  flux[IU]*dtdx;
+	Fluxes(i  ,j , IV) =  flux[IV]*dtdx;
+
+      } else if (dir == YDIR) {
+
+	// left interface : right state
+	trace_unsplit_2d_along_dir(qLoc,
+				   dqX, dqY,
+				   dtdx, dtdy, FACE_YMIN, qright);
+
+	if (gravity_enabled) {
+	  // we need to modify input to flux computation with
+	  // gravity predictor (half time step)
 	    
-	    qright[IU] += 0.5 * dt * gravity(i,j,IX);
-	    qright[IV] += 0.5 * dt * gravity(i,j,IY);
+	  qright[IU] += 0.5 * dt * gravity(i,j,IX);
+	  qright[IV] += 0.5 * dt * gravity(i,j,IY);
 	    
-	  }
+	}
 	  
-	  qLocNeighbor[ID] = Qdata   (i  ,j-1, ID);
-	  dqX_neighbor[ID] = Slopes_x(i  ,j-1, ID);
-	  dqY_neighbor[ID] = Slopes_y(i  ,j-1, ID);
+	qLocNeighbor[ID] = Qdata   (i  ,j-1, ID);
+	dqX_neighbor[ID] = Slopes_x(i  ,j-1, ID);
+	dqY_neighbor[ID] = Slopes_y(i  ,j-1, ID);
 	  
-	  qLocNeighbor[IP] = Qdata   (i  ,j-1, IP);
-	  dqX_neighbor[IP] = Slopes_x(i  ,j-1, IP);
-	  dqY_neighbor[IP] = Slopes_y(i  ,j-1, IP);
+	qLocNeighbor[IP] = Qdata   (i  ,j-1, IP);
+	dqX_neighbor[IP] = Slopes_x(i  ,j-1, IP);
+	dqY_neighbor[IP] = Slopes_y(i  ,j-1, IP);
 	  
-	  qLocNeighbor[IU] = Qdata   (i  ,j-1, IU);
-	  dqX_neighbor[IU] = Slopes_x(i  ,j-1, IU);
-	  dqY_neighbor[IU] = Slopes_y(i  ,j-1, IU);
+	qLocNeighbor[IU] = Qdata   (i  ,j-1, IU);
+	dqX_neighbor[IU] = Slopes_x(i  ,j-1, IU);
+	dqY_neighbor[IU] = Slopes_y(i  ,j-1, IU);
 	  
-	  qLocNeighbor[IV] = Qdata   (i  ,j-1, IV);
-	  dqX_neighbor[IV] = Slopes_x(i  ,j-1, IV);
-	  dqY_neighbor[IV] = Slopes_y(i  ,j-1, IV);
+	qLocNeighbor[IV] = Qdata   (i  ,j-1, IV);
+	dqX_neighbor[IV] = Slopes_x(i  ,j-1, IV);
+	dqY_neighbor[IV] = Slopes_y(i  ,j-1, IV);
 	  
-	  // left interface : left state
-	  trace_unsplit_2d_along_dir(qLocNeighbor,
-				     dqX_neighbor,dqY_neighbor,
-				     dtdx, dtdy, FACE_YMAX, qleft);
+	// left interface : left state
+	trace_unsplit_2d_along_dir(qLocNeighbor,
+				   dqX_neighbor,dqY_neighbor,
+				   dtdx, dtdy, FACE_YMAX, qleft);
 	  
-	  if (gravity_enabled) {
-	    // we need to modify input to flux computation with
-	    // gravity predictor (half time step)
+	if (gravity_enabled) {
+	  // we need to modify input to flux computation with
+	  // gravity predictor (half time step)
 	    
-	    qleft[IU]  += 0.5 * dt * gravity(i,j-1,IX);
-	    qleft[IV]  += 0.5 * dt * gravity(i,j-1,IY);
+	  qleft[IU]  += 0.5 * dt * gravity(i,j-1,IX);
+	  qleft[IV]  += 0.5 * dt * gravity(i,j-1,IY);
 	    
-	  }
+	}
 	  
-	  // Solve Riemann problem at Y-interfaces and compute Y-fluxes
-	  swapValues(&(qleft[IU]) ,&(qleft[IV]) );
-	  swapValues(&(qright[IU]),&(qright[IV]));
-	  riemann_hydro(qleft,qright,qgdnv,flux,params);
+	// Solve Riemann problem at Y-interfaces and compute Y-fluxes
+	swapValues(&(qleft[IU]) ,&(qleft[IV]) );
+	swapValues(&(qright[IU]),&(qright[IV]));
+	riemann_hydro(qleft,qright,qgdnv,flux,params);
 	  
-	  //
-	  // update hydro array
-	  //	  
-	  Fluxes(i  ,j  , ID) =  flux[ID]*dtdy;
-	  Fluxes(i  ,j  , IP) =  flux[IP]*dtdy;
-	  Fluxes(i  ,j  , IU) =  flux[IV]*dtdy; // IU/IV swapped
-	  Fluxes(i  ,j  , IV) =  flux[IU]*dtdy; // IU/IV swapped
+	//
+	// update hydro array
+	//	  
+	Fluxes(i  ,j  , ID) =  flux[ID]*dtdy;
+	Fluxes(i  ,j  , IP) =  flux[IP]*dtdy;
+	Fluxes(i  ,j  , IU) =  flux[IV]*dtdy; // IU/IV swapped
+	Fluxes(i  ,j  , IV) =  flux[IU]*dtdy; // IU/IV swapped
 
-	}
+      }
 	      
-    } // end if
-    
   } // end operator ()
   
   DataArray2d Qdata;
@@ -1379,47 +1415,42 @@ public:
 		    VectorField2d gravity,
 		    real_t dt)
   {
-    int nbCells = params.isize * params.jsize;
+    const int isize = params.isize;
+    const int jsize = params.jsize;
+    const int ghostWidth = params.ghostWidth;
+
     GravitySourceTermFunctor2D functor(params, Udata_in, Udata_out, gravity, dt);
-    Kokkos::parallel_for(nbCells, functor);
+    Kokkos::parallel_for("GravitySourceTermFunctor2D",
+                         md_policy_2d(ghostWidth, ghostWidth,
+                                      isize-ghostWidth, jsize-ghostWidth,
+                                      params.mdrange_tile),
+                         functor);
   }
   
   KOKKOS_INLINE_FUNCTION
-  void operator()(const int& index) const
+  void operator()(const int& i, const int& j) const
   {
-    const int isize = params.isize;
-    const int jsize = params.jsize;
-    const int ghostWidth = params.ghostWidth;
-    
-    int i,j;
-    index2coord(index,i,j,isize,jsize);
-    
-    if(j >= ghostWidth && j < jsize-ghostWidth  &&
-       i >= ghostWidth && i < isize-ghostWidth ) {
-
-      real_t rhoOld = Udata_in(i,j,ID);
-      real_t rhoNew = fmax(params.settings.smallr,Udata_out(i,j,ID));
+    real_t rhoOld = Udata_in(i,j,ID);
+    real_t rhoNew = fmax(params.settings.smallr,Udata_out(i,j,ID));
 
-      real_t rhou   = Udata_out(i,j,IU);
-      real_t rhov   = Udata_out(i,j,IV);
+    real_t rhou   = Udata_out(i,j,IU);
+    real_t rhov   = Udata_out(i,j,IV);
       
-      // compute kinetic energy before updating momentum
-      real_t ekin_old = 0.5 * (rhou*rhou + rhov*rhov) / rhoNew;
+    // compute kinetic energy before updating momentum
+    real_t ekin_old = 0.5 * (rhou*rhou + rhov*rhov) / rhoNew;
       
-      // update momentum
-      rhou += 0.5 * dt * gravity(i,j,IX) * (rhoOld + rhoNew); 
-      rhov += 0.5 * dt * gravity(i,j,IY) * (rhoOld + rhoNew);
-      Udata_out(i,j,IU) = rhou;
-      Udata_out(i,j,IV) = rhov;
+    // update momentum
+    rhou += 0.5 * dt * gravity(i,j,IX) * (rhoOld + rhoNew); 
+    rhov += 0.5 * dt * gravity(i,j,IY) * (rhoOld + rhoNew);
+    Udata_out(i,j,IU) = rhou;
+    Udata_out(i,j,IV) = rhov;
       
-      // compute kinetic energy after updating momentum
-      real_t ekin_new = 0.5 * (rhou*rhou + rhov*rhov) / rhoNew;
+    // compute kinetic energy after updating momentum
+    real_t ekin_new = 0.5 * (rhou*rhou + rhov*rhov) / rhoNew;
 
-      // update total energy
-      Udata_out(i,j,IE) += (ekin_new - ekin_old);
+    // update total energy
+    Udata_out(i,j,IE) += (ekin_new - ekin_old);
       
-    }
-    
   } // end operator ()
   
   DataArray2d Udata_in, Udata_out;
@@ -0,0 +1,327 @@
+/**
+ * \file HydroSweepFunctors.h
+ *
+ * Directionally split MUSCL-Hancock scheme (implementationVersion = 2),
+ * one sweep per direction.
+ *
+ * A sweep along direction dir works on pencils, i.e. lines of cells
+ * along dir, ghost cells included. Each team loads a group of adjacent
+ * pencils into scratch memory, and performs primitive conversion, slopes,
+ * trace, Riemann solver and update there before writing the new state
+ * back once; no intermediate global array (Q, Slopes_*, Fluxes_*) is
+ * needed.
+ *
+ * Pencils of a group are adjacent along the direction of unit stride
+ * of the state arrays (see StateLayout), and are loaded / stored with
+ * that direction as the fastest index, so that global memory accesses
+ * stay contiguous even when dir is a slow direction; in scratch memory,
+ * pencils are stored one after the other (i.e. transposed), so that the
+ * computation runs with unit stride along dir.
+ *
+ * Velocity components are rotated when loading a pencil, so that the
+ * velocity normal to the sweep is always stored as IU (the 1D scheme and
+ * the Riemann solvers are written along X).
+ */
+#ifndef HYDRO_SWEEP_FUNCTORS_H_
+#define HYDRO_SWEEP_FUNCTORS_H_
+
+#include "shared/kokkos_shared.h"
+#include "HydroBaseFunctor2D.h"
+#include "HydroBaseFunctor3D.h"
+#include "shared/RiemannSolvers.h"
+
+namespace ppkMHD { namespace muscl {
+
+/*************************************************/
+/*************************************************/
+/*************************************************/
+/**
+ * One sweep of the directionally split MUSCL-Hancock scheme.
+ *
+ * Cells updated are the interior cells along dir, on the pencils
+ * [tlo,thi[ along the transverse directions; ghost pencils along a
+ * transverse direction not swept yet during the current time step are
+ * updated as well, so that the next sweeps find their ghost cells up
+ * to date without any border exchange.
+ *
+ * \tparam dim 2 or 3
+ * \tparam dir direction of the sweep (IX, IY or IZ)
+ */
+template<int dim, int dir>
+class HydroSweepFunctor :
+    public std::conditional<dim==2,HydroBaseFunctor2D,HydroBaseFunctor3D>::type {
+
+public:
+
+  using Base = typename std::conditional<dim==2,HydroBaseFunctor2D,HydroBaseFunctor3D>::type;
+  using typename Base::HydroState;
+  using DataArray = typename Base::DataArray;
+
+  using TeamPolicy = Kokkos::TeamPolicy<Device>;
+  using TeamMember = typename TeamPolicy::member_type;
+
+  //! pencils of a team in scratch memory : variable, pencil * cell
+  using ScratchArray = Kokkos::View<real_t**, Kokkos::LayoutRight,
+				    typename Device::scratch_memory_space,
+				    Kokkos::MemoryTraits<Kokkos::Unmanaged> >;
+
+  //! direction of unit stride of the state arrays
+#ifdef PPKMHD_LAYOUT_LEFT
+  static constexpr int contigDir = IX;
+#else
+  static constexpr int contigDir = dim-1;
+#endif
+
+  //! direction along which pencils of a team are adjacent
+  static constexpr int groupDir = dir != contigDir ? contigDir : (dir == IX ? IY : IX);
+
+  //! other transverse direction (3D only)
+  static constexpr int otherDir = dim==2 ? IZ : 3 - dir - groupDir;
+
+  /**
+   * \param[in]  params
+   * \param[in]  Uin    state at the beginning of the sweep
+   * \param[out] Uout   state at the end of the sweep (may be Uin)
+   * \param[in]  tlo    first pencil along each transverse direction
+   * \param[in]  thi    last pencil (excluded) along each transverse direction
+   * \param[in]  width  number of pencils per team
+   * \param[in]  level  scratch memory level
+   * \param[in]  dt     time step
+   */
+  HydroSweepFunctor(HydroParams params,
+		    DataArray   Uin,
+		    DataArray   Uout,
+		    Kokkos::Array<int,3> tlo,
+		    Kokkos::Array<int,3> thi,
+		    int         width,
+		    int         level,
+		    real_t      dt) :
+    Base(params), Uin(Uin), Uout(Uout), tlo(tlo), thi(thi),
+    width(width), level(level),
+    length(dir==IX ? params.isize : (dir==IY ? params.jsize : params.ksize)),
+    nGroups((thi[groupDir]-tlo[groupDir]+width-1)/width),
+    dtdx(dt/(dir==IX ? params.dx : (dir==IY ? params.dy : params.dz)))
+  {};
+
+  //! scratch memory needed by a team (4 arrays : u, q, dq, flux)
+  static size_t scratch_size(int nbvar, int width, int length)
+  {
+    return 4 * ScratchArray::shmem_size(nbvar, width*length);
+  }
+
+  // static method which does it all: create and execute functor
+  static void apply(HydroParams params,
+		    DataArray   Uin,
+		    DataArray   Uout,
+		    Kokkos::Array<int,3> tlo,
+		    Kokkos::Array<int,3> thi,
+		    int         width,
+		    real_t      dt)
+  {
+    const int length = dir==IX ? params.isize : (dir==IY ? params.jsize : params.ksize);
+    const size_t bytes = scratch_size(params.nbvar, width, length);
+
+    // level 0 (fast) scratch memory is small on GPUs
+    const int level = bytes <= 32768 ? 0 : 1;
+
+    HydroSweepFunctor functor(params, Uin, Uout, tlo, thi, width, level, dt);
+
+    const int nOther = dim==2 ? 1 : thi[otherDir]-tlo[otherDir];
+
+    TeamPolicy policy(functor.nGroups*nOther, Kokkos::AUTO);
+    Kokkos::parallel_for("HydroSweepFunctor",
+			 policy.set_scratch_size(level, Kokkos::PerTeam(bytes)),
+			 functor);
+  }
+
+  //! global variable stored in slot iv of a pencil (velocity rotation)
+  KOKKOS_INLINE_FUNCTION
+  static int var(int iv)
+  {
+    return iv == IU ? IU+dir : (iv == IU+dir ? IU : iv);
+  }
+
+  template<int dim_ = dim>
+  KOKKOS_INLINE_FUNCTION
+  typename std::enable_if<dim_==2, storage_t&>::type
+  cell(const DataArray& U, const int (&c)[3], int iv) const
+  {
+    return U(c[IX], c[IY], var(iv));
+  }
+
+  template<int dim_ = dim>
+  KOKKOS_INLINE_FUNCTION
+  typename std::enable_if<dim_==3, storage_t&>::type
+  cell(const DataArray& U, const int (&c)[3], int iv) const
+  {
+    return U(c[IX], c[IY], c[IZ], var(iv));
+  }
+
+  /**
+   * Coordinates of cell l of pencil w, from the flat index m of a
+   * load / store loop (unit stride direction fastest).
+   */
+  KOKKOS_INLINE_FUNCTION
+  void coords(int m, int nw, int first, int other, int& w, int& l, int (&c)[3]) const
+  {
+    if (dir == contigDir) {
+      l = m % length;
+      w = m / length;
+    } else {
+      w = m % nw;
+      l = m / nw;
+    }
+    c[dir]      = l;
+    c[groupDir] = first + w;
+    c[otherDir] = other;
+  }
+
+  //! limited slope from a cell value and its neighbors along dir
+  KOKKOS_INLINE_FUNCTION
+  real_t slope(real_t qMinus, real_t q, real_t qPlus) const
+  {
+    const real_t slope_type = this->params.settings.slope_type;
+
+    const real_t dlft = slope_type*(q     - qMinus);
+    const real_t drgt = slope_type*(qPlus - q     );
+    const real_t dcen = HALF_F * (qPlus - qMinus);
+    const real_t dsgn = (dcen >= ZERO_F) ? ONE_F : -ONE_F;
+    const real_t dlim = (dlft*drgt) <= ZERO_F ? ZERO_F : fmin( FABS(dlft), FABS(drgt) );
+
+    return dsgn * fmin( dlim, FABS(dcen) );
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const TeamMember& team) const
+  {
+
+    const int nbvar = NbVar<dim>::value;
+    const int gw    = this->params.ghostWidth;
+    const real_t gamma0 = this->params.settings.gamma0;
+    const real_t smallr = this->params.settings.smallr;
+    const real_t smallp = this->params.settings.smallp;
+    const int n = length;
+
+    const int group = team.league_rank() % nGroups;
+    const int other = team.league_rank() / nGroups + (dim==2 ? 0 : tlo[otherDir]);
+
+    const int first = tlo[groupDir] + group*width;
+    const int nw = thi[groupDir]-first < width ? thi[groupDir]-first : width;
+
+    ScratchArray u   (team.team_scratch(level), nbvar, width*n);
+    ScratchArray q   (team.team_scratch(level), nbvar, width*n);
+    ScratchArray dq  (team.team_scratch(level), nbvar, width*n);
+    ScratchArray flux(team.team_scratch(level), nbvar, width*n);
+
+    // load pencils
+    Kokkos::parallel_for(Kokkos::TeamThreadRange(team, nw*n), [&](const int m) {
+	int w, l, c[3];
+	coords(m, nw, first, other, w, l, c);
+	for (int iv=0; iv<nbvar; ++iv)
+	  u(iv, w*n+l) = cell(Uin, c, iv);
+      });
+    team.team_barrier();
+
+    // primitive variables
+    Kokkos::parallel_for(Kokkos::TeamThreadRange(team, nw*n), [&](const int m) {
+	HydroState uLoc, qLoc;
+	real_t c;
+	for (int iv=0; iv<nbvar; ++iv)
+	  uLoc[iv] = u(iv, m);
+	this->computePrimitives(uLoc, &c, qLoc);
+	for (int iv=0; iv<nbvar; ++iv)
+	  q(iv, m) = qLoc[iv];
+      });
+    team.team_barrier();
+
+    // slopes (first and last cells of a pencil are not used)
+    Kokkos::parallel_for(Kokkos::TeamThreadRange(team, nw*n), [&](const int m) {
+	const int l = m % n;
+	for (int iv=0; iv<nbvar; ++iv)
+	  dq(iv, m) = l == 0 || l == n-1 ? ZERO_F :
+	    slope(q(iv, m-1), q(iv, m), q(iv, m+1));
+      });
+    team.team_barrier();
+
+    // trace (half time step predictor along dir) : q becomes the left
+    // state at the right interface, dq the right state at the left one
+    Kokkos::parallel_for(Kokkos::TeamThreadRange(team, nw*n), [&](const int m) {
+
+	const real_t r = q(ID, m);
+	const real_t p = q(IP, m);
+	const real_t un = q(IU, m);
+
+	const real_t dr = HALF_F * dq(ID, m);
+	const real_t dp = HALF_F * dq(IP, m);
+	const real_t du = HALF_F * dq(IU, m);
+
+	for (int iv=0; iv<nbvar; ++iv) {
+
+	  const real_t d = HALF_F * dq(iv, m);
+
+	  real_t s0;
+	  if (iv == ID)      s0 = -un*dr - du*r;
+	  else if (iv == IP) s0 = -un*dp - du*gamma0*p;
+	  else if (iv == IU) s0 = -un*du - dp/r;
+	  else               s0 = -un*d;
+
+	  const real_t qc = q(iv, m) + s0*dtdx;
+
+	  q (iv, m) = qc + d;
+	  dq(iv, m) = qc - d;
+
+	}
+
+	q (ID, m) = fmax(smallr, q (ID, m));
+	dq(ID, m) = fmax(smallr, dq(ID, m));
+	q (IP, m) = fmax(smallp * q (ID, m), q (IP, m));
+	dq(IP, m) = fmax(smallp * dq(ID, m), dq(IP, m));
+
+      });
+    team.team_barrier();
+
+    // Riemann problems at the interfaces of interior cells, flux at
+    // index l is the one of the left interface of cell l
+    Kokkos::parallel_for(Kokkos::TeamThreadRange(team, nw*n), [&](const int m) {
+	const int l = m % n;
+	if (l < gw || l > n-gw)
+	  return;
+
+	HydroState qleft, qright, qgdnv, fluxLoc;
+	for (int iv=0; iv<nbvar; ++iv) {
+	  qleft [iv] = q (iv, m-1);
+	  qright[iv] = dq(iv, m);
+	}
+
+	riemann_hydro(qleft, qright, qgdnv, fluxLoc, this->params);
+
+	for (int iv=0; iv<nbvar; ++iv)
+	  flux(iv, m) = fluxLoc[iv]*dtdx;
+      });
+    team.team_barrier();
+
+    // update and store interior cells
+    Kokkos::parallel_for(Kokkos::TeamThreadRange(team, nw*n), [&](const int m) {
+	int w, l, c[3];
+	coords(m, nw, first, other, w, l, c);
+	if (l < gw || l >= n-gw)
+	  return;
+	const int s = w*n+l;
+	for (int iv=0; iv<nbvar; ++iv)
+	  cell(Uout, c, iv) = u(iv, s) + flux(iv, s) - flux(iv, s+1);
+      });
+
+  } // operator ()
+
+  DataArray Uin, Uout;
+  Kokkos::Array<int,3> tlo, thi;
+  int width, level, length, nGroups;
+  real_t dtdx;
+
+}; // class HydroSweepFunctor
+
+} // namespace muscl
+
+} // namespace ppkMHD
+
+#endif // HYDRO_SWEEP_FUNCTORS_H_
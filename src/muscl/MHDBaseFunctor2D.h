@@ -24,7 +24,7 @@ public:
   virtual ~MHDBaseFunctor2D() {};
 
   HydroParams params;
-  const int nbvar = params.nbvar;
+  enum { nbvar = NbVar<2,true>::value };
 
   // utility routines used in various computational kernels
 
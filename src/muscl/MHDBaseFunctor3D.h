@@ -24,7 +24,7 @@ public:
   virtual ~MHDBaseFunctor3D() {};
 
   HydroParams params;
-  const int nbvar = params.nbvar;
+  enum { nbvar = NbVar<3,true>::value };
 
   // utility routines used in various computational kernels
 
@@ -41,31 +41,31 @@ public:
   // static method which does it all: create and execute functor
   static void apply(HydroParams params,
                     ImplodeParams iparams,
-                    DataArray2d Udata,
-		    int         nbCells)
+                    DataArray2d Udata)
   {
     InitImplodeFunctor2D_MHD functor(params, iparams, Udata);
-    Kokkos::parallel_for(nbCells, functor);
+    Kokkos::parallel_for("InitImplodeFunctor2D_MHD",
+                         md_policy_2d(0, 0,
+                                      params.isize, params.jsize,
+                                      params.mdrange_tile),
+                         functor);
   }
 
   KOKKOS_INLINE_FUNCTION
-  void operator()(const int& index) const
+  void operator()(const int& i,
+                  const int& j) const
   {
 
-    const int isize = params.isize;
-    const int jsize = params.jsize;
     const int ghostWidth = params.ghostWidth;
     
 #ifdef USE_MPI
-    const int i_mpi = params.myMpiPos[IX];
-    const int j_mpi = params.myMpiPos[IY];
+    const int i_offset = params.myOffset[IX];
+    const int j_offset = params.myOffset[IY];
 #else
-    const int i_mpi = 0;
-    const int j_mpi = 0;
+    const int i_offset = 0;
+    const int j_offset = 0;
 #endif
 
-    const int nx = params.nx;
-    const int ny = params.ny;
 
     const real_t xmin = params.xmin;
     const real_t xmax = params.xmax;
@@ -75,11 +75,8 @@ public:
     
     const real_t gamma0 = params.settings.gamma0;
     
-    int i,j;
-    index2coord(index,i,j,isize,jsize);
-    
-    real_t x = xmin + dx/2 + (i+nx*i_mpi-ghostWidth)*dx;
-    real_t y = ymin + dy/2 + (j+ny*j_mpi-ghostWidth)*dy;
+    real_t x = xmin + dx/2 + (i+i_offset-ghostWidth)*dx;
+    real_t y = ymin + dy/2 + (j+j_offset-ghostWidth)*dy;
     
     // outer parameters
     const real_t rho_out = this->iparams.rho_out;
@@ -150,31 +147,31 @@ public:
   // static method which does it all: create and execute functor
   static void apply(HydroParams params,
 		    BlastParams bParams,
-                    DataArray2d Udata,
-		    int         nbCells)
+                    DataArray2d Udata)
   {
     InitBlastFunctor2D_MHD functor(params, bParams, Udata);
-    Kokkos::parallel_for(nbCells, functor);
+    Kokkos::parallel_for("InitBlastFunctor2D_MHD",
+                         md_policy_2d(0, 0,
+                                      params.isize, params.jsize,
+                                      params.mdrange_tile),
+                         functor);
   }
 
   KOKKOS_INLINE_FUNCTION
-  void operator()(const int& index) const
+  void operator()(const int& i,
+                  const int& j) const
   {
 
-    const int isize = params.isize;
-    const int jsize = params.jsize;
     const int ghostWidth = params.ghostWidth;
     
 #ifdef USE_MPI
-    const int i_mpi = params.myMpiPos[IX];
-    const int j_mpi = params.myMpiPos[IY];
+    const int i_offset = params.myOffset[IX];
+    const int j_offset = params.myOffset[IY];
 #else
-    const int i_mpi = 0;
-    const int j_mpi = 0;
+    const int i_offset = 0;
+    const int j_offset = 0;
 #endif
 
-    const int nx = params.nx;
-    const int ny = params.ny;
 
     const real_t xmin = params.xmin;
     const real_t ymin = params.ymin;
@@ -195,11 +192,8 @@ public:
     const real_t blast_pressure_out= bParams.blast_pressure_out;
   
 
-    int i,j;
-    index2coord(index,i,j,isize,jsize);
-    
-    real_t x = xmin + dx/2 + (i+nx*i_mpi-ghostWidth)*dx;
-    real_t y = ymin + dy/2 + (j+ny*j_mpi-ghostWidth)*dy;
+    real_t x = xmin + dx/2 + (i+i_offset-ghostWidth)*dx;
+    real_t y = ymin + dy/2 + (j+j_offset-ghostWidth)*dy;
 
     real_t d2 = 
       (x-blast_center_x)*(x-blast_center_x)+
@@ -259,32 +253,41 @@ public:
   // static method which does it all: create and execute functor
   static void apply(HydroParams params,
                     OrszagTangParams otParams,
-                    DataArray2d Udata,
-		    int         nbCells)
+                    DataArray2d Udata)
   {
     InitOrszagTangFunctor2D functor(params, otParams, Udata);
 
     functor.phase = INIT_ALL_VAR_BUT_ENERGY;
-    Kokkos::parallel_for(nbCells, functor);
+    Kokkos::parallel_for("InitOrszagTangFunctor2D",
+                         md_policy_2d(0, 0,
+                                      params.isize, params.jsize,
+                                      params.mdrange_tile),
+                         functor);
 
     functor.phase = INIT_ENERGY;
-    Kokkos::parallel_for(nbCells, functor);
+    Kokkos::parallel_for("InitOrszagTangFunctor2D",
+                         md_policy_2d(0, 0,
+                                      params.isize, params.jsize,
+                                      params.mdrange_tile),
+                         functor);
     
   }
 
   KOKKOS_INLINE_FUNCTION
-  void operator()(const int& index) const
+  void operator()(const int& i,
+                  const int& j) const
   {
 
     if (phase == INIT_ALL_VAR_BUT_ENERGY)
-      init_all_var_but_energy(index);
+      init_all_var_but_energy(i,j);
     else if(phase == INIT_ENERGY)
-      init_energy(index);
+      init_energy(i,j);
 
   } // end operator ()
 
   KOKKOS_INLINE_FUNCTION
-  void init_all_var_but_energy(const int index) const
+  void init_all_var_but_energy(const int& i,
+                               const int& j) const
   {
     
     const int isize = params.isize;
@@ -292,15 +295,13 @@ public:
     const int ghostWidth = params.ghostWidth;
     
 #ifdef USE_MPI
-    const int i_mpi = params.myMpiPos[IX];
-    const int j_mpi = params.myMpiPos[IY];
+    const int i_offset = params.myOffset[IX];
+    const int j_offset = params.myOffset[IY];
 #else
-    const int i_mpi = 0;
-    const int j_mpi = 0;
+    const int i_offset = 0;
+    const int j_offset = 0;
 #endif
 
-    const int nx = params.nx;
-    const int ny = params.ny;
 
     const double xmin = params.xmin;
     const double ymin = params.ymin;
@@ -316,11 +317,8 @@ public:
     const double d0    = gamma0*p0;
     const double v0    = 1.0;
 
-    int i,j;
-    index2coord(index,i,j,isize,jsize);
-    
-    double xPos = xmin + dx/2 + (i+nx*i_mpi-ghostWidth)*dx;
-    double yPos = ymin + dy/2 + (j+ny*j_mpi-ghostWidth)*dy;
+    double xPos = xmin + dx/2 + (i+i_offset-ghostWidth)*dx;
+    double yPos = ymin + dy/2 + (j+j_offset-ghostWidth)*dy;
     
     if(j < jsize  &&
        i < isize ) {
@@ -347,7 +345,8 @@ public:
   } // init_all_var_but_energy
 
   KOKKOS_INLINE_FUNCTION
-  void init_energy(const int index) const
+  void init_energy(const int& i,
+                   const int& j) const
   {
 
     const int isize = params.isize;
@@ -368,11 +367,8 @@ public:
     //const double d0    = gamma0*p0;
     //const double v0    = 1.0;
 
-    int i,j;
-    index2coord(index,i,j,isize,jsize);
-    
-    //double xPos = xmin + dx/2 + (i+nx*i_mpi-ghostWidth)*dx;
-    //double yPos = ymin + dy/2 + (j+ny*j_mpi-ghostWidth)*dy;
+    //double xPos = xmin + dx/2 + (i+i_offset-ghostWidth)*dx;
+    //double yPos = ymin + dy/2 + (j+j_offset-ghostWidth)*dy;
         
     if (i<isize-1 and j<jsize-1) {
       Udata(i,j,IP)  = p0 / (gamma0-1.0) +
@@ -409,31 +405,31 @@ public:
   // static method which does it all: create and execute functor
   static void apply(HydroParams params,
 		    KHParams    khParams,
-                    DataArray2d Udata,
-		    int         nbCells)
+                    DataArray2d Udata)
   {
     InitKelvinHelmholtzFunctor2D_MHD functor(params, khParams, Udata);
-    Kokkos::parallel_for(nbCells, functor);    
+    Kokkos::parallel_for("InitKelvinHelmholtzFunctor2D_MHD",
+                         md_policy_2d(0, 0,
+                                      params.isize, params.jsize,
+                                      params.mdrange_tile),
+                         functor);    
   }
 
   KOKKOS_INLINE_FUNCTION
-  void operator()(const int& index) const
+  void operator()(const int& i,
+                  const int& j) const
   {
     
-    const int isize = params.isize;
-    const int jsize = params.jsize;
     const int ghostWidth = params.ghostWidth;
     
 #ifdef USE_MPI
-    const int i_mpi = params.myMpiPos[IX];
-    const int j_mpi = params.myMpiPos[IY];
+    const int i_offset = params.myOffset[IX];
+    const int j_offset = params.myOffset[IY];
 #else
-    const int i_mpi = 0;
-    const int j_mpi = 0;
+    const int i_offset = 0;
+    const int j_offset = 0;
 #endif
 
-    const int nx = params.nx;
-    const int ny = params.ny;
 
     const real_t xmin = params.xmin;
     const real_t ymin = params.ymin;
@@ -451,11 +447,8 @@ public:
     const real_t ampl      = khParams.amplitude;
     const real_t pressure  = khParams.pressure;
     
-    int i,j;
-    index2coord(index,i,j,isize,jsize);
-    
-    real_t x = xmin + dx/2 + (i+nx*i_mpi-ghostWidth)*dx;
-    real_t y = ymin + dy/2 + (j+ny*j_mpi-ghostWidth)*dy;
+    real_t x = xmin + dx/2 + (i+i_offset-ghostWidth)*dx;
+    real_t y = ymin + dy/2 + (j+j_offset-ghostWidth)*dy;
 
     // normalized coordinates in [0,1]
     //real_t xn = (x-xmin)/(xmax-xmin);
@@ -607,31 +600,31 @@ public:
   // static method which does it all: create and execute functor
   static void apply(HydroParams params,
 		    RotorParams rParams,
-                    DataArray2d Udata,
-		    int         nbCells)
+                    DataArray2d Udata)
   {
     InitRotorFunctor2D_MHD functor(params, rParams, Udata);
-    Kokkos::parallel_for(nbCells, functor);
+    Kokkos::parallel_for("InitRotorFunctor2D_MHD",
+                         md_policy_2d(0, 0,
+                                      params.isize, params.jsize,
+                                      params.mdrange_tile),
+                         functor);
   }
   
   KOKKOS_INLINE_FUNCTION
-  void operator()(const int& index) const
+  void operator()(const int& i,
+                  const int& j) const
   {
     
-    const int isize = params.isize;
-    const int jsize = params.jsize;
     const int ghostWidth = params.ghostWidth;
     
 #ifdef USE_MPI
-    const int i_mpi = params.myMpiPos[IX];
-    const int j_mpi = params.myMpiPos[IY];
+    const int i_offset = params.myOffset[IX];
+    const int j_offset = params.myOffset[IY];
 #else
-    const int i_mpi = 0;
-    const int j_mpi = 0;
+    const int i_offset = 0;
+    const int j_offset = 0;
 #endif
 
-    const int nx = params.nx;
-    const int ny = params.ny;
 
     const real_t xmin = params.xmin;
     const real_t ymin = params.ymin;
@@ -653,11 +646,8 @@ public:
     const real_t xCenter = (xmax + xmin)/2;
     const real_t yCenter = (ymax + ymin)/2;
 
-    int i,j;
-    index2coord(index,i,j,isize,jsize);
-    
-    real_t x = xmin + dx/2 + (i+nx*i_mpi-ghostWidth)*dx;
-    real_t y = ymin + dy/2 + (j+ny*j_mpi-ghostWidth)*dy;
+    real_t x = xmin + dx/2 + (i+i_offset-ghostWidth)*dx;
+    real_t y = ymin + dy/2 + (j+j_offset-ghostWidth)*dy;
     
     real_t r = SQRT( (x-xCenter)*(x-xCenter) +
 		     (y-yCenter)*(y-yCenter) );
@@ -737,8 +727,7 @@ public:
 
   InitFieldLoopFunctor2D_MHD(HydroParams     params,
 			     FieldLoopParams flParams,
-			     DataArray2d     Udata,
-			     int             nbCells) :
+			     DataArray2d     Udata) :
     MHDBaseFunctor2D(params),
     flParams(flParams),
     Udata(Udata)
@@ -749,51 +738,60 @@ public:
   // static method which does it all: create and execute functor
   static void apply(HydroParams params,
 		    FieldLoopParams flParams,
-                    DataArray2d Udata,
-		    int         nbCells)
+                    DataArray2d Udata)
   {
-    InitFieldLoopFunctor2D_MHD functor(params, flParams, Udata, nbCells);
+    InitFieldLoopFunctor2D_MHD functor(params, flParams, Udata);
 
     functor.phase = COMPUTE_VECTOR_POTENTIAL;
-    Kokkos::parallel_for(nbCells, functor);
+    Kokkos::parallel_for("InitFieldLoopFunctor2D_MHD",
+                         md_policy_2d(0, 0,
+                                      params.isize, params.jsize,
+                                      params.mdrange_tile),
+                         functor);
 
     functor.phase = DO_INIT_CONDITION;
-    Kokkos::parallel_for(nbCells, functor);
+    Kokkos::parallel_for("InitFieldLoopFunctor2D_MHD",
+                         md_policy_2d(0, 0,
+                                      params.isize, params.jsize,
+                                      params.mdrange_tile),
+                         functor);
 
     functor.phase = DO_INIT_ENERGY;
-    Kokkos::parallel_for(nbCells, functor);
+    Kokkos::parallel_for("InitFieldLoopFunctor2D_MHD",
+                         md_policy_2d(0, 0,
+                                      params.isize, params.jsize,
+                                      params.mdrange_tile),
+                         functor);
 
   } // apply
   
   KOKKOS_INLINE_FUNCTION
-  void operator()(const int& index) const
+  void operator()(const int& i,
+                  const int& j) const
   {
     if ( phase == COMPUTE_VECTOR_POTENTIAL ) {
-      compute_vector_potential(index);
+      compute_vector_potential(i,j);
     } else if (phase == DO_INIT_CONDITION) {
-      do_init_condition(index);
+      do_init_condition(i,j);
     } else if (phase == DO_INIT_ENERGY) {
-      do_init_energy(index);
+      do_init_energy(i,j);
     }
   }
   
   KOKKOS_INLINE_FUNCTION
-  void compute_vector_potential(const int& index) const
+  void compute_vector_potential(const int& i,
+                                const int& j) const
   {
     
-    const int isize = params.isize;
-    const int jsize = params.jsize;
     const int ghostWidth = params.ghostWidth;
     
-    const int nx = params.nx;
-    const int ny = params.ny;
 
 #ifdef USE_MPI
-    const int i_mpi = params.myMpiPos[IX];
-    const int j_mpi = params.myMpiPos[IY];
+    const int i_offset = params.myOffset[IX];
+    const int j_offset = params.myOffset[IY];
 #else
-    const int i_mpi = 0;
-    const int j_mpi = 0;
+    const int i_offset = 0;
+    const int j_offset = 0;
 #endif
 
     const real_t xmin = params.xmin;
@@ -806,11 +804,8 @@ public:
     const real_t radius    = flParams.radius;
     const real_t amplitude = flParams.amplitude;
 
-    int i,j;
-    index2coord(index,i,j,isize,jsize);
-    
-    real_t x = xmin + dx/2 + (i+nx*i_mpi-ghostWidth)*dx;
-    real_t y = ymin + dy/2 + (j+ny*j_mpi-ghostWidth)*dy;
+    real_t x = xmin + dx/2 + (i+i_offset-ghostWidth)*dx;
+    real_t y = ymin + dy/2 + (j+j_offset-ghostWidth)*dy;
     
     real_t r = sqrt(x*x+y*y);
     if ( r < radius ) {
@@ -822,7 +817,8 @@ public:
   } // compute_vector_potential
 
   KOKKOS_INLINE_FUNCTION
-  void do_init_condition(const int& index) const
+  void do_init_condition(const int& i,
+                         const int& j) const
   {
     
     const int isize = params.isize;
@@ -834,11 +830,11 @@ public:
     const int nz = params.nz;
    
 #ifdef USE_MPI
-    const int i_mpi = params.myMpiPos[IX];
-    const int j_mpi = params.myMpiPos[IY];
+    const int i_offset = params.myOffset[IX];
+    const int j_offset = params.myOffset[IY];
 #else
-    const int i_mpi = 0;
-    const int j_mpi = 0;
+    const int i_offset = 0;
+    const int j_offset = 0;
 #endif
     
     const real_t xmin = params.xmin;
@@ -859,14 +855,11 @@ public:
     const real_t sin_theta = sqrt(1-cos_theta*cos_theta);
 
 
-    int i,j;
-    index2coord(index,i,j,isize,jsize);
-    
     if (i>=ghostWidth and i<isize-ghostWidth and
 	j>=ghostWidth and j<jsize-ghostWidth) {
 
-      real_t x = xmin + dx/2 + (i+nx*i_mpi-ghostWidth)*dx;
-      real_t y = ymin + dy/2 + (j+ny*j_mpi-ghostWidth)*dy;
+      real_t x = xmin + dx/2 + (i+i_offset-ghostWidth)*dx;
+      real_t y = ymin + dy/2 + (j+j_offset-ghostWidth)*dy;
 
       real_t diag = sqrt(1.0*(nx*nx + ny*ny + nz*nz));
       real_t r    = sqrt(x*x+y*y);
@@ -902,7 +895,8 @@ public:
   } // do_init_condition
   
   KOKKOS_INLINE_FUNCTION
-  void do_init_energy(const int& index) const
+  void do_init_energy(const int& i,
+                      const int& j) const
   {
     
     const int isize = params.isize;
@@ -911,9 +905,6 @@ public:
     
     const real_t gamma0 = params.settings.gamma0;
     
-    int i,j;
-    index2coord(index,i,j,isize,jsize);
-    
     if (i>=ghostWidth and i<isize-ghostWidth and
 	j>=ghostWidth and j<jsize-ghostWidth )
       {
@@ -961,18 +952,22 @@ public:
   // static method which does it all: create and execute functor
   static void apply(HydroParams params,
 		    WaveParams wParams,
-		    DataArray2d Udata,
-		    int         nbCells)
+		    DataArray2d Udata)
   {
     
     InitWaveFunctor2D_MHD functor(params, wParams, Udata);
     
-    Kokkos::parallel_for(nbCells, functor);
+    Kokkos::parallel_for("InitWaveFunctor2D_MHD",
+                         md_policy_2d(0, 0,
+                                      params.isize, params.jsize,
+                                      params.mdrange_tile),
+                         functor);
     
   }
 
   KOKKOS_INLINE_FUNCTION
-  void operator()(const int& index) const
+  void operator()(const int& i,
+                  const int& j) const
   {
   } // end operator ()
 		
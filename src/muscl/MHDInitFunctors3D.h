@@ -39,35 +39,34 @@ public:
   // static method which does it all: create and execute functor
   static void apply(HydroParams params,
                     ImplodeParams iparams,
-                    DataArray3d Udata,
-		    int         nbCells)
+                    DataArray3d Udata)
   {
     InitImplodeFunctor3D_MHD functor(params, iparams, Udata);
-    Kokkos::parallel_for(nbCells, functor);
+    Kokkos::parallel_for("InitImplodeFunctor3D_MHD",
+                         md_policy_3d(0, 0, 0,
+                                      params.isize, params.jsize, params.ksize,
+                                      params.mdrange_tile),
+                         functor);
   }
 
   KOKKOS_INLINE_FUNCTION
-  void operator()(const int& index) const
+  void operator()(const int& i,
+                  const int& j,
+                  const int& k) const
   {
 
-    const int isize = params.isize;
-    const int jsize = params.jsize;
-    const int ksize = params.ksize;
     const int ghostWidth = params.ghostWidth;
     
 #ifdef USE_MPI
-    const int i_mpi = params.myMpiPos[IX];
-    const int j_mpi = params.myMpiPos[IY];
-    const int k_mpi = params.myMpiPos[IZ];
+    const int i_offset = params.myOffset[IX];
+    const int j_offset = params.myOffset[IY];
+    const int k_offset = params.myOffset[IZ];
 #else
-    const int i_mpi = 0;
-    const int j_mpi = 0;
-    const int k_mpi = 0;
+    const int i_offset = 0;
+    const int j_offset = 0;
+    const int k_offset = 0;
 #endif
 
-    const int nx = params.nx;
-    const int ny = params.ny;
-    const int nz = params.nz;
 
     const real_t xmin = params.xmin;
     const real_t xmax = params.xmax;
@@ -80,12 +79,9 @@ public:
     
     const real_t gamma0 = params.settings.gamma0;
     
-    int i,j,k;
-    index2coord(index,i,j,k,isize,jsize,ksize);
-    
-    real_t x = xmin + dx/2 + (i+nx*i_mpi-ghostWidth)*dx;
-    real_t y = ymin + dy/2 + (j+ny*j_mpi-ghostWidth)*dy;
-    real_t z = zmin + dz/2 + (k+nz*k_mpi-ghostWidth)*dz;
+    real_t x = xmin + dx/2 + (i+i_offset-ghostWidth)*dx;
+    real_t y = ymin + dy/2 + (j+j_offset-ghostWidth)*dy;
+    real_t z = zmin + dz/2 + (k+k_offset-ghostWidth)*dz;
     
     // outer parameters
     const real_t rho_out = this->iparams.rho_out;
@@ -160,35 +156,34 @@ public:
   // static method which does it all: create and execute functor
   static void apply(HydroParams params,
 		    BlastParams bParams,
-                    DataArray3d Udata,
-		    int         nbCells)
+                    DataArray3d Udata)
   {
     InitBlastFunctor3D_MHD functor(params, bParams, Udata);
-    Kokkos::parallel_for(nbCells, functor);
+    Kokkos::parallel_for("InitBlastFunctor3D_MHD",
+                         md_policy_3d(0, 0, 0,
+                                      params.isize, params.jsize, params.ksize,
+                                      params.mdrange_tile),
+                         functor);
   }
 
   KOKKOS_INLINE_FUNCTION
-  void operator()(const int& index) const
+  void operator()(const int& i,
+                  const int& j,
+                  const int& k) const
   {
 
-    const int isize = params.isize;
-    const int jsize = params.jsize;
-    const int ksize = params.ksize;
     const int ghostWidth = params.ghostWidth;
     
 #ifdef USE_MPI
-    const int i_mpi = params.myMpiPos[IX];
-    const int j_mpi = params.myMpiPos[IY];
-    const int k_mpi = params.myMpiPos[IZ];
+    const int i_offset = params.myOffset[IX];
+    const int j_offset = params.myOffset[IY];
+    const int k_offset = params.myOffset[IZ];
 #else
-    const int i_mpi = 0;
-    const int j_mpi = 0;
-    const int k_mpi = 0;
+    const int i_offset = 0;
+    const int j_offset = 0;
+    const int k_offset = 0;
 #endif
 
-    const int nx = params.nx;
-    const int ny = params.ny;
-    const int nz = params.nz;
 
     const real_t xmin = params.xmin;
     const real_t ymin = params.ymin;
@@ -213,12 +208,9 @@ public:
     const real_t blast_pressure_in = bParams.blast_pressure_in;
     const real_t blast_pressure_out= bParams.blast_pressure_out;
   
-    int i,j,k;
-    index2coord(index,i,j,k,isize,jsize,ksize);
-    
-    real_t x = xmin + dx/2 + (i+nx*i_mpi-ghostWidth)*dx;
-    real_t y = ymin + dy/2 + (j+ny*j_mpi-ghostWidth)*dy;
-    real_t z = zmin + dz/2 + (k+nz*k_mpi-ghostWidth)*dz;
+    real_t x = xmin + dx/2 + (i+i_offset-ghostWidth)*dx;
+    real_t y = ymin + dy/2 + (j+j_offset-ghostWidth)*dy;
+    real_t z = zmin + dz/2 + (k+k_offset-ghostWidth)*dz;
 
     real_t d2 = 
       (x-blast_center_x)*(x-blast_center_x)+
@@ -278,51 +270,57 @@ public:
   // static method which does it all: create and execute functor
   static void apply(HydroParams params,
                     OrszagTangParams otParams,
-                    DataArray3d Udata,
-		    int         nbCells)
+                    DataArray3d Udata)
   {
     InitOrszagTangFunctor3D functor(params, otParams, Udata);
 
     functor.phase = INIT_ALL_VAR_BUT_ENERGY;
-    Kokkos::parallel_for(nbCells, functor);
+    Kokkos::parallel_for("InitOrszagTangFunctor3D",
+                         md_policy_3d(0, 0, 0,
+                                      params.isize, params.jsize, params.ksize,
+                                      params.mdrange_tile),
+                         functor);
 
     functor.phase = INIT_ENERGY;
-    Kokkos::parallel_for(nbCells, functor);
+    Kokkos::parallel_for("InitOrszagTangFunctor3D",
+                         md_policy_3d(0, 0, 0,
+                                      params.isize, params.jsize, params.ksize,
+                                      params.mdrange_tile),
+                         functor);
   }
 
   KOKKOS_INLINE_FUNCTION
-  void operator()(const int& index) const
+  void operator()(const int& i,
+                  const int& j,
+                  const int& k) const
   {
 
     if (phase == INIT_ALL_VAR_BUT_ENERGY)
-      init_all_var_but_energy(index);
+      init_all_var_but_energy(i,j,k);
     else if(phase == INIT_ENERGY)
-      init_energy(index);
+      init_energy(i,j,k);
 
   } // end operator ()
 
   KOKKOS_INLINE_FUNCTION
-  void init_all_var_but_energy(const int index) const
+  void init_all_var_but_energy(const int& i,
+                               const int& j,
+                               const int& k) const
   {
     
-    const int isize = params.isize;
-    const int jsize = params.jsize;
-    const int ksize = params.ksize;
     const int ghostWidth = params.ghostWidth;
     
 #ifdef USE_MPI
-    const int i_mpi = params.myMpiPos[IX];
-    const int j_mpi = params.myMpiPos[IY];
-    const int k_mpi = params.myMpiPos[IZ];
+    const int i_offset = params.myOffset[IX];
+    const int j_offset = params.myOffset[IY];
+    const int k_offset = params.myOffset[IZ];
 #else
-    const int i_mpi = 0;
-    const int j_mpi = 0;
-    const int k_mpi = 0;
+    const int i_offset = 0;
+    const int j_offset = 0;
+    const int k_offset = 0;
 #endif
-    UNUSED(k_mpi);
+    UNUSED(k_offset);
 
-    const int nx = params.nx;
-    const int ny = params.ny;
     const int nz = params.nz;
     UNUSED(nz);
     
@@ -346,12 +344,9 @@ public:
     const double v0    = 1.0;
     const double kt    = otParams.kt;
 
-    int i,j,k;
-    index2coord(index,i,j,k,isize,jsize,ksize);
-    
-    double xPos = xmin + dx/2 + (i+nx*i_mpi-ghostWidth)*dx;
-    double yPos = ymin + dy/2 + (j+ny*j_mpi-ghostWidth)*dy;
-    double zPos = zmin + dz/2 + (k+nz*k_mpi-ghostWidth)*dz;
+    double xPos = xmin + dx/2 + (i+i_offset-ghostWidth)*dx;
+    double yPos = ymin + dy/2 + (j+j_offset-ghostWidth)*dy;
+    double zPos = zmin + dz/2 + (k+k_offset-ghostWidth)*dz;
         
     // density
     Udata(i,j,k,ID) = d0;
@@ -373,12 +368,13 @@ public:
   } // init_all_var_but_energy
 
   KOKKOS_INLINE_FUNCTION
-  void init_energy(const int index) const
+  void init_energy(const int& i,
+                   const int& j,
+                   const int& k) const
   {
 
     const int isize = params.isize;
     const int jsize = params.jsize;
-    const int ksize = params.ksize;
     //const int ghostWidth = params.ghostWidth;
     
     const real_t gamma0 = params.settings.gamma0;
@@ -389,9 +385,6 @@ public:
     //const double d0    = gamma0*p0;
     //const double v0    = 1.0;
 
-    int i,j,k;
-    index2coord(index,i,j,k,isize,jsize,ksize);
-    
     //double xPos = xmin + dx/2 + (i-ghostWidth)*dx;
     //double yPos = ymin + dy/2 + (j-ghostWidth)*dy;
     //double zPos = zmin + dz/2 + (k-ghostWidth)*dz;
@@ -432,35 +425,34 @@ public:
   // static method which does it all: create and execute functor
   static void apply(HydroParams params,
 		    KHParams    khParams,
-                    DataArray3d Udata,
-		    int         nbCells)
+                    DataArray3d Udata)
   {
     InitKelvinHelmholtzFunctor3D_MHD functor(params, khParams, Udata);
-    Kokkos::parallel_for(nbCells, functor);
+    Kokkos::parallel_for("InitKelvinHelmholtzFunctor3D_MHD",
+                         md_policy_3d(0, 0, 0,
+                                      params.isize, params.jsize, params.ksize,
+                                      params.mdrange_tile),
+                         functor);
   }
 
   KOKKOS_INLINE_FUNCTION
-  void operator()(const int& index) const
+  void operator()(const int& i,
+                  const int& j,
+                  const int& k) const
   {
 
-    const int isize = params.isize;
-    const int jsize = params.jsize;
-    const int ksize = params.ksize;
     const int ghostWidth = params.ghostWidth;
     
 #ifdef USE_MPI
-    const int i_mpi = params.myMpiPos[IX];
-    const int j_mpi = params.myMpiPos[IY];
-    const int k_mpi = params.myMpiPos[IZ];
+    const int i_offset = params.myOffset[IX];
+    const int j_offset = params.myOffset[IY];
+    const int k_offset = params.myOffset[IZ];
 #else
-    const int i_mpi = 0;
-    const int j_mpi = 0;
-    const int k_mpi = 0;
+    const int i_offset = 0;
+    const int j_offset = 0;
+    const int k_offset = 0;
 #endif
 
-    const int nx = params.nx;
-    const int ny = params.ny;
-    const int nz = params.nz;
 
     const real_t xmin = params.xmin;
     const real_t ymin = params.ymin;
@@ -483,12 +475,9 @@ public:
     const real_t ampl      = khParams.amplitude;
     const real_t pressure  = khParams.pressure;
     
-    int i,j,k;
-    index2coord(index,i,j,k,isize,jsize,ksize);
-    
-    real_t x = xmin + dx/2 + (i+nx*i_mpi-ghostWidth)*dx;
-    real_t y = ymin + dy/2 + (j+ny*j_mpi-ghostWidth)*dy;
-    real_t z = zmin + dz/2 + (k+nz*k_mpi-ghostWidth)*dz;
+    real_t x = xmin + dx/2 + (i+i_offset-ghostWidth)*dx;
+    real_t y = ymin + dy/2 + (j+j_offset-ghostWidth)*dy;
+    real_t z = zmin + dz/2 + (k+k_offset-ghostWidth)*dz;
 
     // normalized coordinates in [0,1]
     //real_t xn = (x-xmin)/(xmax-xmin);
@@ -643,35 +632,35 @@ public:
   // static method which does it all: create and execute functor
   static void apply(HydroParams params,
 		    RotorParams rParams,
-                    DataArray3d Udata,
-		    int         nbCells)
+                    DataArray3d Udata)
   {
     InitRotorFunctor3D_MHD functor(params, rParams, Udata);
-    Kokkos::parallel_for(nbCells, functor);
+    Kokkos::parallel_for("InitRotorFunctor3D_MHD",
+                         md_policy_3d(0, 0, 0,
+                                      params.isize, params.jsize, params.ksize,
+                                      params.mdrange_tile),
+                         functor);
   }
   
   KOKKOS_INLINE_FUNCTION
-  void operator()(const int& index) const
+  void operator()(const int& i,
+                  const int& j,
+                  const int& k) const
   {
     
-    const int isize = params.isize;
-    const int jsize = params.jsize;
-    const int ksize = params.ksize;
     const int ghostWidth = params.ghostWidth;
     
 #ifdef USE_MPI
-    const int i_mpi = params.myMpiPos[IX];
-    const int j_mpi = params.myMpiPos[IY];
-    const int k_mpi = params.myMpiPos[IZ];
+    const int i_offset = params.myOffset[IX];
+    const int j_offset = params.myOffset[IY];
+    const int k_offset = params.myOffset[IZ];
 #else
-    const int i_mpi = 0;
-    const int j_mpi = 0;
-    const int k_mpi = 0;
+    const int i_offset = 0;
+    const int j_offset = 0;
+    const int k_offset = 0;
 #endif
-    UNUSED(k_mpi);
+    UNUSED(k_offset);
     
-    const int nx = params.nx;
-    const int ny = params.ny;
     const int nz = params.nz;
     UNUSED(nz);
 
@@ -695,11 +684,8 @@ public:
     const real_t xCenter = (xmax + xmin)/2;
     const real_t yCenter = (ymax + ymin)/2;
 
-    int i,j,k;
-    index2coord(index,i,j,k,isize,jsize,ksize);
-    
-    real_t x = xmin + dx/2 + (i+nx*i_mpi-ghostWidth)*dx;
-    real_t y = ymin + dy/2 + (j+ny*j_mpi-ghostWidth)*dy;
+    real_t x = xmin + dx/2 + (i+i_offset-ghostWidth)*dx;
+    real_t y = ymin + dy/2 + (j+j_offset-ghostWidth)*dy;
     
     real_t r = SQRT( (x-xCenter)*(x-xCenter) +
 		     (y-yCenter)*(y-yCenter) );
@@ -779,8 +765,7 @@ public:
 
   InitFieldLoopFunctor3D_MHD(HydroParams     params,
 			     FieldLoopParams flParams,
-			     DataArray3d     Udata,
-			     int             nbCells) :
+			     DataArray3d     Udata) :
     MHDBaseFunctor3D(params),
     flParams(flParams),
     Udata(Udata)
@@ -791,55 +776,65 @@ public:
   // static method which does it all: create and execute functor
   static void apply(HydroParams params,
 		    FieldLoopParams flParams,
-                    DataArray3d Udata,
-		    int         nbCells)
+                    DataArray3d Udata)
   {
-    InitFieldLoopFunctor3D_MHD functor(params, flParams, Udata, nbCells);
+    InitFieldLoopFunctor3D_MHD functor(params, flParams, Udata);
 
     functor.phase = COMPUTE_VECTOR_POTENTIAL;
-    Kokkos::parallel_for(nbCells, functor);
+    Kokkos::parallel_for("InitFieldLoopFunctor3D_MHD",
+                         md_policy_3d(0, 0, 0,
+                                      params.isize, params.jsize, params.ksize,
+                                      params.mdrange_tile),
+                         functor);
 
     functor.phase = DO_INIT_CONDITION;
-    Kokkos::parallel_for(nbCells, functor);
+    Kokkos::parallel_for("InitFieldLoopFunctor3D_MHD",
+                         md_policy_3d(0, 0, 0,
+                                      params.isize, params.jsize, params.ksize,
+                                      params.mdrange_tile),
+                         functor);
 
     functor.phase = DO_INIT_ENERGY;
-    Kokkos::parallel_for(nbCells, functor);
+    Kokkos::parallel_for("InitFieldLoopFunctor3D_MHD",
+                         md_policy_3d(0, 0, 0,
+                                      params.isize, params.jsize, params.ksize,
+                                      params.mdrange_tile),
+                         functor);
 
   } // apply
   
   KOKKOS_INLINE_FUNCTION
-  void operator()(const int& index) const
+  void operator()(const int& i,
+                  const int& j,
+                  const int& k) const
   {
     if ( phase == COMPUTE_VECTOR_POTENTIAL ) {
-      compute_vector_potential(index);
+      compute_vector_potential(i,j,k);
     } else if (phase == DO_INIT_CONDITION) {
-      do_init_condition(index);
+      do_init_condition(i,j,k);
     } else if (phase == DO_INIT_ENERGY) {
-      do_init_energy(index);
+      do_init_energy(i,j,k);
     }
   }
 
   KOKKOS_INLINE_FUNCTION
-  void compute_vector_potential(const int& index) const
+  void compute_vector_potential(const int& i,
+                                const int& j,
+                                const int& k) const
   {
     
-    const int isize = params.isize;
-    const int jsize = params.jsize;
-    const int ksize = params.ksize;
     const int ghostWidth = params.ghostWidth;
     
-    const int nx = params.nx;
-    const int ny = params.ny;
     //const int nz = params.nz;
 
 #ifdef USE_MPI
-    const int i_mpi = params.myMpiPos[IX];
-    const int j_mpi = params.myMpiPos[IY];
-    //const int k_mpi = params.myMpiPos[IZ];
+    const int i_offset = params.myOffset[IX];
+    const int j_offset = params.myOffset[IY];
+    //const int k_offset = params.myOffset[IZ];
 #else
-    const int i_mpi = 0;
-    const int j_mpi = 0;
-    //const int k_mpi = 0;
+    const int i_offset = 0;
+    const int j_offset = 0;
+    //const int k_offset = 0;
 #endif
 
     const real_t xmin = params.xmin;
@@ -854,12 +849,9 @@ public:
     const real_t radius    = flParams.radius;
     const real_t amplitude = flParams.amplitude;
 
-    int i,j,k;
-    index2coord(index,i,j,k,isize,jsize,ksize);
-    
-    real_t x = xmin + dx/2 + (i+nx*i_mpi-ghostWidth)*dx;
-    real_t y = ymin + dy/2 + (j+ny*j_mpi-ghostWidth)*dy;
-    //real_t z = zmin + dz/2 + (k+nz*k_mpi-ghostWidth)*dz;
+    real_t x = xmin + dx/2 + (i+i_offset-ghostWidth)*dx;
+    real_t y = ymin + dy/2 + (j+j_offset-ghostWidth)*dy;
+    //real_t z = zmin + dz/2 + (k+k_offset-ghostWidth)*dz;
     
     A(i,j,k,0) = ZERO_F;
     A(i,j,k,1) = ZERO_F;
@@ -873,7 +865,9 @@ public:
   } // compute_vector_potential
 
   KOKKOS_INLINE_FUNCTION
-  void do_init_condition(const int& index) const
+  void do_init_condition(const int& i,
+                         const int& j,
+                         const int& k) const
   {
     
     const int isize = params.isize;
@@ -882,17 +876,15 @@ public:
     const int ghostWidth = params.ghostWidth;
     
 #ifdef USE_MPI
-    const int i_mpi = params.myMpiPos[IX];
-    const int j_mpi = params.myMpiPos[IY];
-    //const int k_mpi = params.myMpiPos[IZ];
+    const int i_offset = params.myOffset[IX];
+    const int j_offset = params.myOffset[IY];
+    //const int k_offset = params.myOffset[IZ];
 #else
-    const int i_mpi = 0;
-    const int j_mpi = 0;
-    //const int k_mpi = 0;
+    const int i_offset = 0;
+    const int j_offset = 0;
+    //const int k_offset = 0;
 #endif
 
-    const int nx = params.nx;
-    const int ny = params.ny;
     //const int nz = params.nz;
 
     const real_t xmin = params.xmin;
@@ -918,16 +910,13 @@ public:
     const real_t cos_theta = 2.0/sqrt(5.0);
     const real_t sin_theta = sqrt(1-cos_theta*cos_theta);
     
-    int i,j,k;
-    index2coord(index,i,j,k,isize,jsize,ksize);
-    
     if (i>=ghostWidth and i<isize-ghostWidth and
 	j>=ghostWidth and j<jsize-ghostWidth and
 	k>=ghostWidth and k<ksize-ghostWidth) {
       
-      real_t x = xmin + dx/2 + (i+nx*i_mpi-ghostWidth)*dx;
-      real_t y = ymin + dy/2 + (j+ny*j_mpi-ghostWidth)*dy;
-      //real_t z = zmin + dz/2 + (k+nz*k_mpi-ghostWidth)*dz;
+      real_t x = xmin + dx/2 + (i+i_offset-ghostWidth)*dx;
+      real_t y = ymin + dy/2 + (j+j_offset-ghostWidth)*dy;
+      //real_t z = zmin + dz/2 + (k+k_offset-ghostWidth)*dz;
 
       real_t r = sqrt(x*x+y*y);
 
@@ -972,7 +961,9 @@ public:
   } // end do_init_condition
   
   KOKKOS_INLINE_FUNCTION
-  void do_init_energy(const int& index) const
+  void do_init_energy(const int& i,
+                      const int& j,
+                      const int& k) const
   {
     
     const int isize = params.isize;
@@ -982,9 +973,6 @@ public:
     
     const real_t gamma0 = params.settings.gamma0;
     
-    int i,j,k;
-    index2coord(index,i,j,k,isize,jsize,ksize);
-    
     if (i>=ghostWidth and i<isize-ghostWidth and
 	j>=ghostWidth and j<jsize-ghostWidth and
 	k>=ghostWidth and k<ksize-ghostWidth)
@@ -1038,65 +1026,73 @@ private:
 public:
   InitWaveFunctor3D_MHD(HydroParams params,
 			WaveParams wParams,
-			 DataArray3d Udata,
-       int         nbCells) :
+			 DataArray3d Udata) :
     MHDBaseFunctor3D(params), wParams(wParams), Udata(Udata)  {
     
     A = DataArrayVector3("A", params.isize, params.jsize,params.ksize);
 
     phase = COMPUTE_VECTOR_POTENTIAL;
-    Kokkos::parallel_for(nbCells, *this);
+    Kokkos::parallel_for("InitWaveFunctor3D_MHD",
+                         md_policy_3d(0, 0, 0,
+                                      params.isize, params.jsize, params.ksize,
+                                      params.mdrange_tile),
+                         *this);
 
     phase = COMPUTE_FACE_CENTERED_B;
-    Kokkos::parallel_for(nbCells, *this);
+    Kokkos::parallel_for("InitWaveFunctor3D_MHD",
+                         md_policy_3d(0, 0, 0,
+                                      params.isize, params.jsize, params.ksize,
+                                      params.mdrange_tile),
+                         *this);
 
     phase = DO_INIT_CONDITION;
-    Kokkos::parallel_for(nbCells, *this);
+    Kokkos::parallel_for("InitWaveFunctor3D_MHD",
+                         md_policy_3d(0, 0, 0,
+                                      params.isize, params.jsize, params.ksize,
+                                      params.mdrange_tile),
+                         *this);
       
       };
   
   // static method which does it all: create and execute functor
   static void apply(HydroParams params,
 		    WaveParams wParams,
-                    DataArray3d Udata,
-		    int         nbCells)
+                    DataArray3d Udata)
   {
-    InitWaveFunctor3D_MHD functor(params, wParams, Udata,nbCells);
+    InitWaveFunctor3D_MHD functor(params, wParams, Udata);
   }
   
   KOKKOS_INLINE_FUNCTION
-  void operator()(const int& index) const
+  void operator()(const int& i,
+                  const int& j,
+                  const int& k) const
   {
     if ( phase == COMPUTE_VECTOR_POTENTIAL ) {
-      compute_vector_potential(index);
+      compute_vector_potential(i,j,k);
     } else if (phase == COMPUTE_FACE_CENTERED_B) {
-      compute_face_centered_B(index);
+      compute_face_centered_B(i,j,k);
     } else if (phase == DO_INIT_CONDITION) {
-      do_init_condition(index);
+      do_init_condition(i,j,k);
     }
   }
   
   KOKKOS_INLINE_FUNCTION
-  void compute_vector_potential(const int& index) const
+  void compute_vector_potential(const int& i,
+                                const int& j,
+                                const int& k) const
   {
     
-    const int isize = params.isize;
-    const int jsize = params.jsize;
-    const int ksize = params.ksize;
     const int ghostWidth = params.ghostWidth;
     
-    const int nx = params.nx;
-    const int ny = params.ny;
-    const int nz = params.nz;
 
 #ifdef USE_MPI
-    const int i_mpi = params.myMpiPos[IX];
-    const int j_mpi = params.myMpiPos[IY];
-    const int k_mpi = params.myMpiPos[IZ];
+    const int i_offset = params.myOffset[IX];
+    const int j_offset = params.myOffset[IY];
+    const int k_offset = params.myOffset[IZ];
 #else
-    const int i_mpi = 0;
-    const int j_mpi = 0;
-    const int k_mpi = 0;
+    const int i_offset = 0;
+    const int j_offset = 0;
+    const int k_offset = 0;
 #endif
 
     const real_t xmin = params.xmin;
@@ -1107,12 +1103,9 @@ public:
     const real_t dy = params.dy;
     const real_t dz = params.dz;
 
-    int i,j,k;
-    index2coord(index,i,j,k,isize,jsize,ksize);
-    
-    real_t x = xmin + dx/2 + (i+nx*i_mpi-ghostWidth)*dx;
-    real_t y = ymin + dy/2 + (j+ny*j_mpi-ghostWidth)*dy;
-    real_t z = zmin + dz/2 + (k+nz*k_mpi-ghostWidth)*dz;
+    real_t x = xmin + dx/2 + (i+i_offset-ghostWidth)*dx;
+    real_t y = ymin + dy/2 + (j+j_offset-ghostWidth)*dy;
+    real_t z = zmin + dz/2 + (k+k_offset-ghostWidth)*dz;
     
     const real_t bx0    = wParams.bx0;
     const real_t by0    = wParams.by0;
@@ -1163,7 +1156,9 @@ public:
   } // compute_vector_potential
 
   KOKKOS_INLINE_FUNCTION
-  void compute_face_centered_B(const int& index) const
+  void compute_face_centered_B(const int& i,
+                               const int& j,
+                               const int& k) const
   {
     const int isize = params.isize;
     const int jsize = params.jsize;
@@ -1174,9 +1169,6 @@ public:
     const real_t dy = params.dy;
     const real_t dz = params.dz;
     
-    int i,j,k;
-    index2coord(index,i,j,k,isize,jsize,ksize);
-    
     if (i>=ghostWidth-1 and i<isize-ghostWidth+1 and
 	j>=ghostWidth-1 and j<jsize-ghostWidth+1 and
 	k>=ghostWidth-1 and k<ksize-ghostWidth+1) {
@@ -1198,7 +1190,9 @@ public:
   }
 
   KOKKOS_INLINE_FUNCTION
-  void do_init_condition(const int& index) const
+  void do_init_condition(const int& i,
+                         const int& j,
+                         const int& k) const
   {
 
     const int isize = params.isize;
@@ -1207,18 +1201,15 @@ public:
     const int ghostWidth = params.ghostWidth;
     
 #ifdef USE_MPI
-    const int i_mpi = params.myMpiPos[IX];
-    const int j_mpi = params.myMpiPos[IY];
-    const int k_mpi = params.myMpiPos[IZ];
+    const int i_offset = params.myOffset[IX];
+    const int j_offset = params.myOffset[IY];
+    const int k_offset = params.myOffset[IZ];
 #else
-    const int i_mpi = 0;
-    const int j_mpi = 0;
-    const int k_mpi = 0;
+    const int i_offset = 0;
+    const int j_offset = 0;
+    const int k_offset = 0;
 #endif
 
-    const int nx = params.nx;
-    const int ny = params.ny;
-    const int nz = params.nz;
 
     const real_t xmin = params.xmin;
     const real_t ymin = params.ymin;
@@ -1250,16 +1241,13 @@ public:
     const real_t k_par  = wParams.k_par;
     
   
-    int i,j,k;
-    index2coord(index,i,j,k,isize,jsize,ksize);
-    
     if (i>=ghostWidth and i<isize-ghostWidth and
 	j>=ghostWidth and j<jsize-ghostWidth and
 	k>=ghostWidth and k<ksize-ghostWidth) {
     
-      real_t x = xmin + dx/2 + (i+nx*i_mpi-ghostWidth)*dx;
-      real_t y = ymin + dy/2 + (j+ny*j_mpi-ghostWidth)*dy;
-      real_t z = zmin + dz/2 + (k+nz*k_mpi-ghostWidth)*dz;
+      real_t x = xmin + dx/2 + (i+i_offset-ghostWidth)*dx;
+      real_t y = ymin + dy/2 + (j+j_offset-ghostWidth)*dy;
+      real_t z = zmin + dz/2 + (k+k_offset-ghostWidth)*dz;
     
       real_t X = cos_a2*(x*cos_a3 + y*sin_a3) + z*sin_a2;
       real_t sn = sin(k_par*X); 
@@ -82,7 +82,7 @@ void SolverHydroMuscl<2>::init_four_quadrant(DataArray Udata)
 
   InitFourQuadrantFunctor2D::apply(params, Udata, configNumber,
 				   U0, U1, U2, U3,
-				   xt, yt, nbCells);
+				   xt, yt);
   
 } // SolverHydroMuscl<2>::init_four_quadrant
 
@@ -94,7 +94,7 @@ void SolverHydroMuscl<2>::init_isentropic_vortex(DataArray Udata)
   
   IsentropicVortexParams iparams(configMap);
   
-  InitIsentropicVortexFunctor2D::apply(params, iparams, Udata, nbCells);
+  InitIsentropicVortexFunctor2D::apply(params, iparams, Udata);
   
 } // SolverHydroMuscl<2>::init_isentropic_vortex
 
@@ -229,175 +229,163 @@ void SolverHydroMuscl<3>::init(DataArray Udata)
 // =======================================================
 // =======================================================
 // ///////////////////////////////////////////
-// Actual computation of Godunov scheme - 2d
+// Numerical scheme kernels - 2d
 // ///////////////////////////////////////////
 template<>
-void SolverHydroMuscl<2>::godunov_unsplit_impl(DataArray data_in, 
-					       DataArray data_out, 
-					       real_t dt)
+void SolverHydroMuscl<2>::godunov_unsplit_kernels(const HydroParams& hparams,
+						  DataArray data_in,
+						  DataArray data_out,
+						  VectorField grav,
+						  real_t dt)
 {
-  
-  // fill ghost cell in data_in
-  timers[TIMER_BOUNDARIES]->start();
-  make_boundaries(data_in);
-  timers[TIMER_BOUNDARIES]->stop();
-    
-  // copy data_in into data_out (not necessary)
-  // data_out = data_in;
-  Kokkos::deep_copy(data_out, data_in);
-  
-  // start main computation
-  timers[TIMER_NUM_SCHEME]->start();
 
+  // directionally split version, no work array
+  if (hparams.implementationVersion == 2) {
+    godunov_split_kernels(hparams, data_in, data_out, dt);
+    return;
+  }
+  
   // convert conservative variable into primitives ones for the entire domain
-  convertToPrimitives(data_in);
+  ConvertToPrimitivesFunctor2D::apply(hparams, data_in, Q);
 
-  if (params.implementationVersion == 0) {
+  if (hparams.implementationVersion == 0) {
     
     // compute fluxes (if gravity_enabled is false, the last parameter is not used)
-    ComputeAndStoreFluxesFunctor2D::apply(params, Q,
+    ComputeAndStoreFluxesFunctor2D::apply(hparams, Q,
 					  Fluxes_x, Fluxes_y,
 					  dt,
 					  m_gravity_enabled,
-					  gravity);
+					  grav);
     
     // actual update
-    UpdateFunctor2D::apply(params, data_out,
+    UpdateFunctor2D::apply(hparams, data_out,
 			   Fluxes_x, Fluxes_y);
 
     // gravity source term
     if (m_gravity_enabled) {
-      GravitySourceTermFunctor2D::apply(params, data_in, data_out, gravity, dt);
+      GravitySourceTermFunctor2D::apply(hparams, data_in, data_out, grav, dt);
     }
 
     
-  } else if (params.implementationVersion == 1) {
+  } else if (hparams.implementationVersion == 1) {
 
     // call device functor to compute slopes
-    ComputeSlopesFunctor2D::apply(params, Q,
+    ComputeSlopesFunctor2D::apply(hparams, Q,
 				  Slopes_x, Slopes_y);
 
     // now trace along X axis
-    ComputeTraceAndFluxes_Functor2D<XDIR>::apply(params, Q,
+    ComputeTraceAndFluxes_Functor2D<XDIR>::apply(hparams, Q,
 						 Slopes_x, Slopes_y,
 						 Fluxes_x,
 						 dt,
 						 m_gravity_enabled,
-						 gravity);
+						 grav);
     
     // and update along X axis
-    UpdateDirFunctor2D<XDIR>::apply(params, data_out, Fluxes_x);
+    UpdateDirFunctor2D<XDIR>::apply(hparams, data_out, Fluxes_x);
     
     // now trace along Y axis
-    ComputeTraceAndFluxes_Functor2D<YDIR>::apply(params, Q,
+    ComputeTraceAndFluxes_Functor2D<YDIR>::apply(hparams, Q,
 						 Slopes_x, Slopes_y,
 						 Fluxes_y,
 						 dt,
 						 m_gravity_enabled,
-						 gravity);
+						 grav);
     
     // and update along Y axis
-    UpdateDirFunctor2D<YDIR>::apply(params, data_out, Fluxes_y);
+    UpdateDirFunctor2D<YDIR>::apply(hparams, data_out, Fluxes_y);
     
     // gravity source term
     if (m_gravity_enabled) {
-      GravitySourceTermFunctor2D::apply(params, data_in, data_out, gravity, dt);
+      GravitySourceTermFunctor2D::apply(hparams, data_in, data_out, grav, dt);
     }
 
-  } // end params.implementationVersion == 1
+  } // end hparams.implementationVersion == 1
   
-  timers[TIMER_NUM_SCHEME]->stop();
-  
-} // SolverHydroMuscl2D::godunov_unsplit_impl
+} // SolverHydroMuscl<2>::godunov_unsplit_kernels
 
 // =======================================================
 // =======================================================
 // ///////////////////////////////////////////
-// Actual computation of Godunov scheme - 3d
+// Numerical scheme kernels - 3d
 // ///////////////////////////////////////////
 template<>
-void SolverHydroMuscl<3>::godunov_unsplit_impl(DataArray data_in, 
-					       DataArray data_out, 
-					       real_t dt)
+void SolverHydroMuscl<3>::godunov_unsplit_kernels(const HydroParams& hparams,
+						  DataArray data_in,
+						  DataArray data_out,
+						  VectorField grav,
+						  real_t dt)
 {
 
-  // fill ghost cell in data_in
-  timers[TIMER_BOUNDARIES]->start();
-  make_boundaries(data_in);
-  timers[TIMER_BOUNDARIES]->stop();
-    
-  // copy data_in into data_out (not necessary)
-  // data_out = data_in;
-  Kokkos::deep_copy(data_out, data_in);
-  
-  // start main computation
-  timers[TIMER_NUM_SCHEME]->start();
+  // directionally split version, no work array
+  if (hparams.implementationVersion == 2) {
+    godunov_split_kernels(hparams, data_in, data_out, dt);
+    return;
+  }
 
   // convert conservative variable into primitives ones for the entire domain
-  convertToPrimitives(data_in);
+  ConvertToPrimitivesFunctor3D::apply(hparams, data_in, Q);
 
-  if (params.implementationVersion == 0) {
+  if (hparams.implementationVersion == 0) {
     
     // compute fluxes
-    ComputeAndStoreFluxesFunctor3D::apply(params, Q,
+    ComputeAndStoreFluxesFunctor3D::apply(hparams, Q,
 					  Fluxes_x, Fluxes_y, Fluxes_z,
 					  dt,
 					  m_gravity_enabled,
-					  gravity);
+					  grav);
 
     // actual update
-    UpdateFunctor3D::apply(params, data_out,
+    UpdateFunctor3D::apply(hparams, data_out,
 			   Fluxes_x, Fluxes_y, Fluxes_z);
 
     // gravity source term
     if (m_gravity_enabled) {
-      GravitySourceTermFunctor3D::apply(params, data_in, data_out, gravity, dt);
+      GravitySourceTermFunctor3D::apply(hparams, data_in, data_out, grav, dt);
     }
 
     
-  } else if (params.implementationVersion == 1) {
+  } else if (hparams.implementationVersion == 1) {
 
     // call device functor to compute slopes
-    ComputeSlopesFunctor3D::apply(params, Q,
+    ComputeSlopesFunctor3D::apply(hparams, Q,
 				  Slopes_x, Slopes_y, Slopes_z);
 
     // now trace along X axis
-    ComputeTraceAndFluxes_Functor3D<XDIR>::apply(params, Q,
+    ComputeTraceAndFluxes_Functor3D<XDIR>::apply(hparams, Q,
 						 Slopes_x, Slopes_y, Slopes_z,
 						 Fluxes_x,
-						 dt, m_gravity_enabled, gravity);
+						 dt, m_gravity_enabled, grav);
     
     // and update along X axis
-    UpdateDirFunctor3D<XDIR>::apply(params, data_out, Fluxes_x);
+    UpdateDirFunctor3D<XDIR>::apply(hparams, data_out, Fluxes_x);
 
     // now trace along Y axis
-    ComputeTraceAndFluxes_Functor3D<YDIR>::apply(params, Q,
+    ComputeTraceAndFluxes_Functor3D<YDIR>::apply(hparams, Q,
 						 Slopes_x, Slopes_y, Slopes_z,
 						 Fluxes_y,
-						 dt, m_gravity_enabled, gravity);
+						 dt, m_gravity_enabled, grav);
     
     // and update along Y axis
-    UpdateDirFunctor3D<YDIR>::apply(params, data_out, Fluxes_y);
+    UpdateDirFunctor3D<YDIR>::apply(hparams, data_out, Fluxes_y);
 
     // now trace along Z axis
-    ComputeTraceAndFluxes_Functor3D<ZDIR>::apply(params, Q,
+    ComputeTraceAndFluxes_Functor3D<ZDIR>::apply(hparams, Q,
 						 Slopes_x, Slopes_y, Slopes_z,
 						 Fluxes_z,
-						 dt, m_gravity_enabled, gravity);
+						 dt, m_gravity_enabled, grav);
     
     // and update along Z axis
-    UpdateDirFunctor3D<ZDIR>::apply(params, data_out, Fluxes_z);
+    UpdateDirFunctor3D<ZDIR>::apply(hparams, data_out, Fluxes_z);
 
     // gravity source term
     if (m_gravity_enabled) {
-      GravitySourceTermFunctor3D::apply(params, data_in, data_out, gravity, dt);
+      GravitySourceTermFunctor3D::apply(hparams, data_in, data_out, grav, dt);
     }
 
-  } // end params.implementationVersion == 1
-  
-  timers[TIMER_NUM_SCHEME]->stop();
+  } // end hparams.implementationVersion == 1
 
-} // SolverHydroMuscl<3>::godunov_unsplit_impl
+} // SolverHydroMuscl<3>::godunov_unsplit_kernels
 
 } // namespace muscl
 
@@ -12,16 +12,22 @@
 #include <sstream>
 #include <fstream>
 #include <algorithm>
+#include <limits>
+#include <cmath>
 
 // shared
 #include "shared/SolverBase.h"
 #include "shared/HydroParams.h"
 #include "shared/kokkos_shared.h"
 #include "shared/problems/initRiemannConfig2d.h"
+#include "shared/MultiBlock.h"
+#include "shared/TemporalBlocking.h"
+#include "shared/AMRForest.h"
 
 // the actual computational functors called in HydroRun
 #include "muscl/HydroRunFunctors2D.h"
 #include "muscl/HydroRunFunctors3D.h"
+#include "muscl/HydroSweepFunctors.h"
 
 // Init conditions functors
 #include "muscl/HydroInitFunctors2D.h"
@@ -91,6 +97,43 @@ public:
 
   /* Gravity field */
   VectorField gravity;
+
+  //! over-decomposition of the sub-domain (run/blocks_per_rank > 1),
+  //! null when the sub-domain is a single block (U / U2)
+  std::shared_ptr<MultiBlock<dim>> m_blocks;
+
+  //! gravity field of each block (over-decomposition only)
+  std::vector<VectorField> m_blocks_gravity;
+
+  //! temporal blocking (run/temporal_blocking_steps > 1, single
+  //! process), null otherwise
+  std::shared_ptr<TemporalBlocking<dim>> m_tiles;
+
+  //! gravity field of each tile (temporal blocking only)
+  std::vector<VectorField> m_tiles_gravity;
+
+  //! time step of a temporal block relative to the CFL time step of
+  //! its initial state
+  real_t m_tiles_dt_factor;
+
+  //! current number of steps per temporal block (at most depth)
+  int m_tiles_depth;
+
+  //! number of steps of the current temporal block, and steps left
+  int m_tiles_steps;
+  int m_tiles_left;
+
+  //! adaptive mesh (amr/enabled), null on a uniform grid; U is then
+  //! only used for output
+  std::shared_ptr<AMRForest<dim>> m_amr;
+
+  //! number of time steps between two regrids (0 : never)
+  int m_amr_regrid_interval;
+
+  //! directionally split sweeps (implementationVersion = 2) : number
+  //! of pencils per team, and time step being computed (sweep order)
+  int m_pencil_width;
+  int m_sweep_step;
   
   //riemann_solver_t riemann_solver_fn; /*!< riemann solver function pointer */
 
@@ -118,9 +161,23 @@ public:
   //! init wrapper (actual initialization)
   void init(DataArray Udata);
 
+  //! initial condition of AMR leaf l into Udata (and leaf gravity field)
+  void init_amr_leaf(int l, DataArray Udata);
+
+  //! initial AMR forest, refined up to level_max
+  void init_amr();
+
+  //! refine / coarsen AMR leaves according to U[index]
+  bool amr_regrid(int index);
+
   //! compute time step inside an MPI process, at shared memory level.
   double compute_dt_local();
 
+  //! inverse of the time step allowed by a (block) state array
+  real_t compute_inv_dt(const HydroParams& hparams,
+			DataArray Udata,
+			VectorField grav);
+
   //! perform 1 time step (time integration).
   void next_iteration_impl();
 
@@ -130,6 +187,42 @@ public:
   void godunov_unsplit_impl(DataArray data_in, 
 			    DataArray data_out, 
 			    real_t dt);
+
+  //! numerical scheme on one (block) state array, ghost cells of
+  //! data_in must be up to date
+  void godunov_unsplit_kernels(const HydroParams& hparams,
+			       DataArray data_in,
+			       DataArray data_out,
+			       VectorField grav,
+			       real_t dt);
+
+  //! directionally split numerical scheme (implementationVersion = 2),
+  //! one pencil sweep per direction
+  void godunov_split_kernels(const HydroParams& hparams,
+			     DataArray data_in,
+			     DataArray data_out,
+			     real_t dt);
+
+  //! one sweep along direction dir
+  template<int dir>
+  void sweep(const HydroParams& hparams,
+	     DataArray data_in,
+	     DataArray data_out,
+	     const Kokkos::Array<int,3>& tlo,
+	     const Kokkos::Array<int,3>& thi,
+	     real_t dt);
+
+  //! numerical scheme, over-decomposition version
+  void godunov_unsplit_blocks(real_t dt);
+
+  //! fixed time step and number of steps of the next temporal block
+  void compute_dt_tiles();
+
+  //! numerical scheme, temporal blocking version
+  void godunov_unsplit_tiles(real_t dt);
+
+  //! numerical scheme, AMR version
+  void godunov_unsplit_amr(real_t dt);
   
   void convertToPrimitives(DataArray Udata);
   
@@ -140,6 +233,13 @@ public:
 
   // output
   void save_solution_impl();
+
+  // in-situ analysis and output streams
+  void run_analysis_impl();
+  void save_streams_impl();
+
+  //! current state (U or U2), AMR / multi-block data gathered into U
+  DataArray current_state();
   
   int isize, jsize, ksize;
   int nbCells;
@@ -162,6 +262,11 @@ SolverHydroMuscl<dim>::SolverHydroMuscl(HydroParams& params,
   U(), U2(), Q(),
   Fluxes_x(), Fluxes_y(), Fluxes_z(),
   Slopes_x(), Slopes_y(), Slopes_z(),
+  m_blocks(), m_blocks_gravity(),
+  m_tiles(), m_tiles_gravity(), m_tiles_dt_factor(1.0),
+  m_tiles_depth(1), m_tiles_steps(0), m_tiles_left(0),
+  m_amr(), m_amr_regrid_interval(0),
+  m_pencil_width(1), m_sweep_step(0),
   isize(params.isize),
   jsize(params.jsize),
   ksize(params.ksize),
@@ -180,6 +285,97 @@ SolverHydroMuscl<dim>::SolverHydroMuscl(HydroParams& params,
  
   long long int total_mem_size = 0;
 
+  /*
+   * directionally split sweeps work in scratch memory : no work array
+   * (Q, fluxes, slopes) is allocated.
+   */
+  if (params.implementationVersion == 2) {
+
+    if (m_gravity_enabled) {
+      fprintf(stderr, "Directionally split sweeps (implementationVersion=2) do not support gravity\n");
+      exit(EXIT_FAILURE);
+    }
+
+    m_pencil_width = configMap.getInteger("OTHER", "pencil_width", 8);
+    if (m_pencil_width < 1)
+      m_pencil_width = 1;
+
+  }
+
+  /*
+   * over-decomposition : the sub-domain is split into several blocks
+   * with their own state arrays; U is then only used for
+   * initialization and output, and work arrays (Q, fluxes, slopes) are
+   * sized for the largest block.
+   */
+  int nbBlocks = configMap.getInteger("run", "blocks_per_rank", 1);
+
+  /*
+   * adaptive mesh : the domain is covered by leaves of fixed size, each
+   * with its own state arrays and parameters; work arrays are sized
+   * for a leaf. Flux correction needs the fluxes of all directions
+   * at once (implementation 0).
+   */
+  if (configMap.getBool("amr", "enabled", false)) {
+
+    if (params.implementationVersion != 0 || m_restart_run_enabled) {
+      fprintf(stderr, "AMR requires implementationVersion=0 and is not available for restart runs\n");
+      exit(EXIT_FAILURE);
+    }
+
+    m_amr = std::make_shared<AMRForest<dim>>(params, configMap);
+    m_amr_regrid_interval = configMap.getInteger("amr", "regrid_interval", 4);
+
+  } else if (nbBlocks > 1) {
+    m_blocks = std::make_shared<MultiBlock<dim>>(params, nbBlocks);
+    if (m_blocks->size() < 2)
+      m_blocks.reset();
+  }
+
+  /*
+   * temporal blocking : the domain is cut into tiles along the last
+   * direction, each advanced by several time steps in small work
+   * arrays (with a fixed time step); ghost cells of the whole domain
+   * are only needed once per block of steps, so that it is limited to
+   * a single process. Work arrays are sized for a tile.
+   */
+  int tilesDepth = configMap.getInteger("run", "temporal_blocking_steps", 1);
+#ifdef USE_MPI
+  if (tilesDepth > 1 && params.nProcs > 1) {
+    if (params.myRank == 0)
+      std::cout << "Temporal blocking disabled (single process only)\n";
+    tilesDepth = 1;
+  }
+#endif // USE_MPI
+
+  if (tilesDepth > 1 && !m_amr && !m_blocks) {
+    m_tiles = std::make_shared<TemporalBlocking<dim>>
+      (params, tilesDepth,
+       configMap.getInteger("run", "temporal_blocking_tile_layers", 16));
+    m_tiles_dt_factor = configMap.getFloat("run", "temporal_blocking_dt_factor", 0.8);
+    m_tiles_depth = m_tiles->depth();
+  }
+
+  // sizes of work arrays
+  const int isizeW = m_amr ? m_amr->ghosted_size() : isize;
+  const int jsizeW =
+    m_amr ? m_amr->ghosted_size() :
+    dim==2 && m_blocks ? m_blocks->max_ghosted_size() :
+    dim==2 && m_tiles  ? m_tiles->max_ghosted_size()  : jsize;
+  const int ksizeW =
+    m_amr ? m_amr->ghosted_size() :
+    dim==3 && m_blocks ? m_blocks->max_ghosted_size() :
+    dim==3 && m_tiles  ? m_tiles->max_ghosted_size()  : ksize;
+
+  /*
+   * work arrays (Q, fluxes, slopes) live in the scratch arena, phases
+   * of a time step are those of godunov_unsplit_impl; with
+   * implementation 1, traces and updates of successive directions
+   * interleave, so that all work arrays stay alive until the last
+   * update.
+   */
+  enum { PHASE_PRIMITIVES, PHASE_SLOPES, PHASE_TRACE, PHASE_UPDATE };
+
   /*
    * memory allocation (use sizes with ghosts included).
    *
@@ -191,32 +387,30 @@ SolverHydroMuscl<dim>::SolverHydroMuscl(HydroParams& params,
 
     U     = DataArray("U", isize, jsize, nbvar);
     Uhost = Kokkos::create_mirror(U);
-    U2    = DataArray("U2",isize, jsize, nbvar);
-    Q     = DataArray("Q", isize, jsize, nbvar);
+    if (!m_blocks && !m_amr)
+      U2  = DataArray("U2",isize, jsize, nbvar);
+    total_mem_size += 2*isize*jsize*nbvar * sizeof(real_t);// U+U2(or blocks)
 
-    total_mem_size += isize*jsize*nbvar * sizeof(real_t) * 3;// 1+1+1 for U+U2+Q
-    
     if (params.implementationVersion == 0) {
-      
-      Fluxes_x = DataArray("Fluxes_x", isize, jsize, nbvar);
-      Fluxes_y = DataArray("Fluxes_y", isize, jsize, nbvar);
-      
-      total_mem_size += isize*jsize*nbvar * sizeof(real_t) * 2;// 1+1 for Fluxes_x+Fluxes_y
+
+      m_scratch.declare(Q, PHASE_PRIMITIVES, PHASE_TRACE, isizeW, jsizeW, nbvar);
+
+      m_scratch.declare(Fluxes_x, PHASE_TRACE, PHASE_UPDATE, isizeW, jsizeW, nbvar);
+      m_scratch.declare(Fluxes_y, PHASE_TRACE, PHASE_UPDATE, isizeW, jsizeW, nbvar);
 
     } else if (params.implementationVersion == 1) {
-      
-      Slopes_x = DataArray("Slope_x", isize, jsize, nbvar);
-      Slopes_y = DataArray("Slope_y", isize, jsize, nbvar);
-      
+
+      m_scratch.declare(Q, PHASE_PRIMITIVES, PHASE_UPDATE, isizeW, jsizeW, nbvar);
+
+      m_scratch.declare(Slopes_x, PHASE_SLOPES, PHASE_UPDATE, isizeW, jsizeW, nbvar);
+      m_scratch.declare(Slopes_y, PHASE_SLOPES, PHASE_UPDATE, isizeW, jsizeW, nbvar);
+
       // direction splitting (only need one flux array)
-      Fluxes_x = DataArray("Fluxes_x", isize, jsize, nbvar);
-      Fluxes_y = Fluxes_x;
-      
-      total_mem_size += isize*jsize*nbvar * sizeof(real_t) * 3;// 1+1+1 for Slopes_x+Slopes_y+Fluxes_x
+      m_scratch.declare(Fluxes_x, PHASE_TRACE, PHASE_UPDATE, isizeW, jsizeW, nbvar);
 
-    } 
+    }
 
-    if (m_gravity_enabled) {
+    if (m_gravity_enabled && !m_amr) {
       gravity = VectorField("gravity field",isize,jsize);
       total_mem_size += isize*jsize*2;
     }
@@ -225,52 +419,86 @@ SolverHydroMuscl<dim>::SolverHydroMuscl(HydroParams& params,
 
     U     = DataArray("U", isize,jsize,ksize, nbvar);
     Uhost = Kokkos::create_mirror(U);
-    U2    = DataArray("U2",isize,jsize,ksize, nbvar);
-    Q     = DataArray("Q", isize,jsize,ksize, nbvar);
-    
-    total_mem_size += isize*jsize*ksize*nbvar*sizeof(real_t)*3;// 1+1+1=3 for U+U2+Q
+    if (!m_blocks && !m_amr)
+      U2  = DataArray("U2",isize,jsize,ksize, nbvar);
+    total_mem_size += 2*isize*jsize*ksize*nbvar*sizeof(real_t);// U+U2(or blocks)
 
     if (params.implementationVersion == 0) {
-      
-      Fluxes_x = DataArray("Fluxes_x", isize,jsize,ksize, nbvar);
-      Fluxes_y = DataArray("Fluxes_y", isize,jsize,ksize, nbvar);
-      Fluxes_z = DataArray("Fluxes_z", isize,jsize,ksize, nbvar);
-      
-      total_mem_size += isize*jsize*ksize*nbvar*sizeof(real_t)*3;// 1+1+1=3 Fluxes
+
+      m_scratch.declare(Q, PHASE_PRIMITIVES, PHASE_TRACE, isizeW,jsizeW,ksizeW, nbvar);
+
+      m_scratch.declare(Fluxes_x, PHASE_TRACE, PHASE_UPDATE, isizeW,jsizeW,ksizeW, nbvar);
+      m_scratch.declare(Fluxes_y, PHASE_TRACE, PHASE_UPDATE, isizeW,jsizeW,ksizeW, nbvar);
+      m_scratch.declare(Fluxes_z, PHASE_TRACE, PHASE_UPDATE, isizeW,jsizeW,ksizeW, nbvar);
 
     } else if (params.implementationVersion == 1) {
-      
-      Slopes_x = DataArray("Slope_x", isize,jsize,ksize, nbvar);
-      Slopes_y = DataArray("Slope_y", isize,jsize,ksize, nbvar);
-      Slopes_z = DataArray("Slope_z", isize,jsize,ksize, nbvar);
-      
+
+      m_scratch.declare(Q, PHASE_PRIMITIVES, PHASE_UPDATE, isizeW,jsizeW,ksizeW, nbvar);
+
+      m_scratch.declare(Slopes_x, PHASE_SLOPES, PHASE_UPDATE, isizeW,jsizeW,ksizeW, nbvar);
+      m_scratch.declare(Slopes_y, PHASE_SLOPES, PHASE_UPDATE, isizeW,jsizeW,ksizeW, nbvar);
+      m_scratch.declare(Slopes_z, PHASE_SLOPES, PHASE_UPDATE, isizeW,jsizeW,ksizeW, nbvar);
+
       // direction splitting (only need one flux array)
-      Fluxes_x = DataArray("Fluxes_x", isize,jsize,ksize, nbvar);
-      Fluxes_y = Fluxes_x;
-      Fluxes_z = Fluxes_x;
-      
-      total_mem_size += isize*jsize*ksize*nbvar*sizeof(real_t)*4;// 1+1+1+1=4 Slopes
+      m_scratch.declare(Fluxes_x, PHASE_TRACE, PHASE_UPDATE, isizeW,jsizeW,ksizeW, nbvar);
+
     }
     
-    if (m_gravity_enabled) {
+    if (m_gravity_enabled && !m_amr) {
       gravity = VectorField("gravity field",isize,jsize,ksize);
       total_mem_size += isize*jsize*ksize*3;
     }
 
   } // dim == 2 / 3
+
+  m_scratch.allocate();
+  total_mem_size += m_scratch.size();
+
+  if (params.implementationVersion == 1) {
+    Fluxes_y = Fluxes_x;
+    Fluxes_z = Fluxes_x;
+  }
   
-  // perform init condition
-  init(U);
-  
-  // initialize boundaries
-  make_boundaries(U);
+  if (m_amr) {
+
+    // perform init condition on each leaf
+    init_amr();
+
+  } else {
+
+    // perform init condition
+    init(U);
+
+    if (m_blocks) {
+
+      // ghost cells are filled before each block update
+      m_blocks->scatter(U, 0);
 
-  // copy U into U2
-  Kokkos::deep_copy(U2,U);
+      m_blocks_gravity.resize(m_blocks->size());
+      if (m_gravity_enabled)
+	m_blocks->scatter_field(gravity, m_blocks_gravity);
+
+    } else {
+
+      // initialize boundaries
+      make_boundaries(U);
+
+      // copy U into U2
+      Kokkos::deep_copy(U2,U);
+
+      if (m_tiles && m_gravity_enabled)
+	m_tiles->scatter_field(gravity, m_tiles_gravity);
+
+    }
+
+  }
   
   // compute initialize time step
   compute_dt();
 
+  // footprint of the most loaded process
+  const double mem_size = max_memory_footprint(total_mem_size);
+
   int myRank=0;
 #ifdef USE_MPI
   myRank = params.myRank;
@@ -285,7 +513,17 @@ SolverHydroMuscl<dim>::SolverHydroMuscl(HydroParams& params,
     // print parameters on screen
     params.print();
     std::cout << "##########################" << "\n";
-    std::cout << "Memory requested : " << (total_mem_size / 1e6) << " MBytes\n"; 
+    std::cout << "Memory requested : " << (mem_size / 1e6) << " MBytes per process (peak)\n";
+    std::cout << "Work arrays      : " << (m_scratch.size() / 1e6) << " MBytes ("
+	      << (m_scratch.requested_size() / 1e6) << " MBytes without aliasing)\n";
+    if (m_blocks)
+      std::cout << "Blocks per process : " << m_blocks->size() << "\n";
+    if (m_tiles)
+      std::cout << "Temporal blocking : " << m_tiles->size() << " tiles, "
+		<< m_tiles->depth() << " steps per block\n";
+    if (m_amr)
+      std::cout << "AMR leaves : " << m_amr->size()
+		<< " (" << m_amr->nb_cells() << " cells)\n";
     std::cout << "##########################" << "\n";
   }
 
@@ -339,7 +577,7 @@ void SolverHydroMuscl<dim>::init_implode(DataArray Udata)
 			      InitImplodeFunctor3D>::type;
 
   // perform init
-  InitImplodeFunctor::apply(params, iparams, Udata, nbCells);
+  InitImplodeFunctor::apply(params, iparams, Udata);
 
 } // SolverHydroMuscl::init_implode
 
@@ -362,7 +600,7 @@ void SolverHydroMuscl<dim>::init_blast(DataArray Udata)
 			      InitBlastFunctor3D>::type;
 
   // perform init
-  InitBlastFunctor::apply(params, blastParams, Udata, nbCells);
+  InitBlastFunctor::apply(params, blastParams, Udata);
 
 } // SolverHydroMuscl::init_blast
 
@@ -391,7 +629,7 @@ void SolverHydroMuscl<dim>::init_kelvin_helmholtz(DataArray Udata)
 			      InitKelvinHelmholtzFunctor3D>::type;
 
   // perform init
-  InitKelvinHelmholtzFunctor::apply(params, khParams, Udata, nbCells);
+  InitKelvinHelmholtzFunctor::apply(params, khParams, Udata);
 
 } // SolverHydroMuscl::init_kelvin_helmholtz
 
@@ -418,7 +656,7 @@ void SolverHydroMuscl<dim>::init_gresho_vortex(DataArray Udata)
 			      InitGreshoVortexFunctor3D>::type;
 
   // perform init
-  InitGreshoVortexFunctor::apply(params, gvParams, Udata, nbCells);
+  InitGreshoVortexFunctor::apply(params, gvParams, Udata);
 
 } // SolverHydroMuscl<dim>::init_gresho_vortex
 
@@ -613,6 +851,99 @@ void SolverHydroMuscl<dim>::init_restart(DataArray Udata)
   
 } // SolverHydroMuscl<dim>::init_restart
 
+// =======================================================
+// =======================================================
+/**
+ * Init routines work on the solver parameters, gravity field and
+ * number of cells : point them to the leaf during the call.
+ */
+template<int dim>
+void SolverHydroMuscl<dim>::init_amr_leaf(int l, DataArray Udata)
+{
+
+  auto& leaf = (*m_amr)[l];
+  const HydroParams& lp = leaf.params;
+
+  if (m_gravity_enabled && leaf.gravity.data() == nullptr)
+    leaf.gravity = dim==2 ?
+      VectorField("gravity field", lp.isize, lp.jsize) :
+      VectorField("gravity field", lp.isize, lp.jsize, lp.ksize);
+
+  HydroParams params_save = params;
+  VectorField gravity_save = gravity;
+
+  params = lp;
+  gravity = leaf.gravity;
+
+  init(Udata);
+
+  params = params_save;
+  gravity = gravity_save;
+
+} // SolverHydroMuscl<dim>::init_amr_leaf
+
+// =======================================================
+// =======================================================
+/**
+ * Leaves are initialized from the initial condition (not
+ * interpolated), then refined where needed, level after level.
+ */
+template<int dim>
+void SolverHydroMuscl<dim>::init_amr()
+{
+
+  for (int level=0; ; ++level) {
+
+    for (int l : m_amr->local())
+      init_amr_leaf(l, (*m_amr)[l].U[0]);
+
+    if (level == m_amr->level_max() || !amr_regrid(0))
+      break;
+
+  }
+
+} // SolverHydroMuscl<dim>::init_amr
+
+// =======================================================
+// =======================================================
+template<int dim>
+bool SolverHydroMuscl<dim>::amr_regrid(int index)
+{
+
+  AMRForest<dim>& amr = *m_amr;
+
+  // alias to actual device functor
+  using ComputeRefinementIndicatorFunctor =
+    typename std::conditional<dim==2,
+			      ComputeRefinementIndicatorFunctor2D,
+			      ComputeRefinementIndicatorFunctor3D>::type;
+
+  amr.fill_ghosts(index, false);
+
+  std::vector<real_t> indicator(amr.size(), ZERO_F);
+  for (int l : amr.local())
+    ComputeRefinementIndicatorFunctor::apply(amr[l].params, amr[l].U[index],
+					     indicator[l]);
+
+  const bool changed = amr.regrid(index, indicator);
+
+  // gravity field of new leaves (U[1-index] is not used yet)
+  if (changed && m_gravity_enabled)
+    for (int l : amr.local())
+      if (amr[l].fresh)
+	init_amr_leaf(l, amr[l].U[1-index]);
+
+  // average number of cells per process (performance report)
+  int nProcs = 1;
+#ifdef USE_MPI
+  nProcs = params.nProcs;
+#endif // USE_MPI
+  m_nCells = amr.nb_cells() / nProcs;
+
+  return changed;
+
+} // SolverHydroMuscl<dim>::amr_regrid
+
 // =======================================================
 // =======================================================
 /**
@@ -626,13 +957,74 @@ double SolverHydroMuscl<dim>::compute_dt_local()
 
   real_t dt;
   real_t invDt = ZERO_F;
-  DataArray Udata;
+
+  if (m_amr && m_amr->time_levels() > 1) {
+
+    const int index = m_iteration % 2;
+
+    // local time stepping : stable time step of each leaf, time levels
+    // are set from them (time step of level 0 is returned, identical
+    // on all processes)
+    std::vector<real_t> dtLeaf(m_amr->size(), std::numeric_limits<real_t>::max());
+
+    for (int l : m_amr->local()) {
+      auto& leaf = (*m_amr)[l];
+      const real_t invDtLeaf = compute_inv_dt(leaf.params, leaf.U[index],
+					      leaf.gravity);
+      if (invDtLeaf > ZERO_F)
+	dtLeaf[l] = params.settings.cfl/invDtLeaf;
+    }
+
+    return m_amr->set_time_levels(dtLeaf);
+
+  } else if (m_amr) {
+
+    const int index = m_iteration % 2;
+
+    for (int l : m_amr->local()) {
+      auto& leaf = (*m_amr)[l];
+      invDt = std::max(invDt, compute_inv_dt(leaf.params, leaf.U[index],
+					     leaf.gravity));
+    }
+
+  } else if (m_blocks) {
+
+    const int index = m_iteration % 2;
+
+    for (int b=0; b<m_blocks->size(); ++b) {
+      auto& blk = (*m_blocks)[b];
+      invDt = std::max(invDt, compute_inv_dt(blk.params, blk.U[index],
+					     m_blocks_gravity[b]));
+    }
+
+  } else {
+
+    // which array is the current one ?
+    DataArray Udata;
+    if (m_iteration % 2 == 0)
+      Udata = U;
+    else
+      Udata = U2;
+
+    invDt = compute_inv_dt(params, Udata, gravity);
+
+  }
   
-  // which array is the current one ?
-  if (m_iteration % 2 == 0)
-    Udata = U;
-  else
-    Udata = U2;
+  dt = params.settings.cfl/invDt;
+  
+  return dt;
+
+} // SolverHydroMuscl::compute_dt_local
+
+// =======================================================
+// =======================================================
+template<int dim>
+real_t SolverHydroMuscl<dim>::compute_inv_dt(const HydroParams& hparams,
+					     DataArray Udata,
+					     VectorField grav)
+{
+
+  real_t invDt = ZERO_F;
 
   if (m_gravity_enabled) {
 
@@ -643,11 +1035,10 @@ double SolverHydroMuscl<dim>::compute_dt_local()
       				ComputeDtGravityFunctor3D>::type;
     
     // call device functor
-    ComputeDtFunctor::apply(params,
-			    params.settings.cfl,
-			    gravity,
+    ComputeDtFunctor::apply(hparams,
+			    hparams.settings.cfl,
+			    grav,
 			    Udata,
-			    nbCells,
 			    invDt);
     
   } else {
@@ -661,15 +1052,13 @@ double SolverHydroMuscl<dim>::compute_dt_local()
 				ComputeDtFunctor3D>::type;
     
     // call device functor
-    ComputeDtFunctor::apply(params, Udata, nbCells, invDt);
+    ComputeDtFunctor::apply(hparams, Udata, invDt);
     
   }
-  
-  dt = params.settings.cfl/invDt;
-  
-  return dt;
 
-} // SolverHydroMuscl::compute_dt_local
+  return invDt;
+
+} // SolverHydroMuscl::compute_inv_dt
 
 // =======================================================
 // =======================================================
@@ -704,9 +1093,12 @@ void SolverHydroMuscl<dim>::next_iteration_impl()
     } // end output
   } // end enable output
   
-  // compute new dt
+  // compute new dt (fixed inside a temporal block)
   timers[TIMER_DT]->start();
-  compute_dt();
+  if (!m_tiles)
+    compute_dt();
+  else if (m_tiles_left == 0)
+    compute_dt_tiles();
   timers[TIMER_DT]->stop();
   
   // perform one step integration
@@ -722,8 +1114,16 @@ void SolverHydroMuscl<dim>::next_iteration_impl()
 template<int dim>
 void SolverHydroMuscl<dim>::godunov_unsplit(real_t dt)
 {
+
+  m_sweep_step = m_iteration;
   
-  if ( m_iteration % 2 == 0 ) {
+  if (m_amr) {
+    godunov_unsplit_amr(dt);
+  } else if (m_blocks) {
+    godunov_unsplit_blocks(dt);
+  } else if (m_tiles) {
+    godunov_unsplit_tiles(dt);
+  } else if ( m_iteration % 2 == 0 ) {
     godunov_unsplit_impl(U , U2, dt);
   } else {
     godunov_unsplit_impl(U2, U , dt);
@@ -742,21 +1142,334 @@ void SolverHydroMuscl<dim>::godunov_unsplit_impl(DataArray data_in,
 						 real_t dt)
 {
 
-  // 2d / 3d implementation are specialized in implementation file
+  // fill ghost cell in data_in
+  timers[TIMER_BOUNDARIES]->start();
+  make_boundaries(data_in);
+  timers[TIMER_BOUNDARIES]->stop();
+    
+  // copy data_in into data_out (not necessary)
+  // data_out = data_in;
+  Kokkos::deep_copy(data_out, data_in);
   
+  // start main computation
+  timers[TIMER_NUM_SCHEME]->start();
+
+  godunov_unsplit_kernels(params, data_in, data_out, gravity, dt);
+
+  timers[TIMER_NUM_SCHEME]->stop();
+
 } // SolverHydroMuscl<dim>::godunov_unsplit_impl
 
+// =======================================================
+// =======================================================
+template<int dim>
+void SolverHydroMuscl<dim>::godunov_unsplit_kernels(const HydroParams& hparams,
+						    DataArray data_in,
+						    DataArray data_out,
+						    VectorField grav,
+						    real_t dt)
+{
+
+  // 2d / 3d implementation are specialized in implementation file
+  
+} // SolverHydroMuscl<dim>::godunov_unsplit_kernels
+
+// =======================================================
+// =======================================================
+/**
+ * Sweeps are done in order X, Y(, Z) at even time steps and in reverse
+ * order at odd ones (Strang splitting over two steps). The first sweep
+ * reads data_in, the next ones update data_out in place.
+ *
+ * A sweep also updates the ghost pencils along the directions not swept
+ * yet, so that border conditions are only needed once per time step :
+ * ghost cells of data_in must be up to date.
+ */
+template<int dim>
+void SolverHydroMuscl<dim>::godunov_split_kernels(const HydroParams& hparams,
+						  DataArray data_in,
+						  DataArray data_out,
+						  real_t dt)
+{
+
+  const int gw = hparams.ghostWidth;
+  const int size[3] = {hparams.isize, hparams.jsize, dim==2 ? 1 : hparams.ksize};
+
+  int order[3] = {IX, IY, IZ};
+  if (m_sweep_step % 2 == 1)
+    std::reverse(order, order+dim);
+
+  Kokkos::Array<int,3> tlo = {0, 0, 0};
+  Kokkos::Array<int,3> thi = {size[IX], size[IY], size[IZ]};
+
+  DataArray Uin = data_in;
+
+  for (int s=0; s<dim; ++s) {
+
+    const int dir = order[s];
+
+    if (dir == IX)
+      sweep<IX>(hparams, Uin, data_out, tlo, thi, dt);
+    else if (dir == IY)
+      sweep<IY>(hparams, Uin, data_out, tlo, thi, dt);
+    else
+      sweep<dim==3 ? IZ : IX>(hparams, Uin, data_out, tlo, thi, dt);
+
+    // only interior cells along dir are up to date
+    tlo[dir] = gw;
+    thi[dir] = size[dir]-gw;
+
+    Uin = data_out;
+
+  }
+
+} // SolverHydroMuscl<dim>::godunov_split_kernels
+
+// =======================================================
+// =======================================================
+template<int dim>
+template<int dir>
+void SolverHydroMuscl<dim>::sweep(const HydroParams& hparams,
+				  DataArray data_in,
+				  DataArray data_out,
+				  const Kokkos::Array<int,3>& tlo,
+				  const Kokkos::Array<int,3>& thi,
+				  real_t dt)
+{
+
+  HydroSweepFunctor<dim,dir>::apply(hparams, data_in, data_out,
+				    tlo, thi, m_pencil_width, dt);
+
+} // SolverHydroMuscl<dim>::sweep
+
 // 2d version
 template<>
-void SolverHydroMuscl<2>::godunov_unsplit_impl(DataArray data_in, 
-					       DataArray data_out, 
-					       real_t dt);
+void SolverHydroMuscl<2>::godunov_unsplit_kernels(const HydroParams& hparams,
+						  DataArray data_in,
+						  DataArray data_out,
+						  VectorField grav,
+						  real_t dt);
 
 // 3d version
 template<>
-void SolverHydroMuscl<3>::godunov_unsplit_impl(DataArray data_in, 
-					       DataArray data_out, 
-					       real_t dt);
+void SolverHydroMuscl<3>::godunov_unsplit_kernels(const HydroParams& hparams,
+						  DataArray data_in,
+						  DataArray data_out,
+						  VectorField grav,
+						  real_t dt);
+
+// =======================================================
+// =======================================================
+/**
+ * Over-decomposition : each block is updated as soon as its ghost
+ * cells are ready (see MultiBlock::run); time spent waiting for
+ * neighbor processes is accounted as boundaries.
+ */
+template<int dim>
+void SolverHydroMuscl<dim>::godunov_unsplit_blocks(real_t dt)
+{
+
+  const int index = m_iteration % 2;
+
+  MultiBlock<dim>& blocks = *m_blocks;
+
+  timers[TIMER_BOUNDARIES]->start();
+
+  blocks.run(index, false, [&](int b) {
+
+      timers[TIMER_BOUNDARIES]->stop();
+      timers[TIMER_NUM_SCHEME]->start();
+
+      auto& blk = blocks[b];
+
+      Kokkos::deep_copy(blk.U[1-index], blk.U[index]);
+
+      godunov_unsplit_kernels(blk.params, blk.U[index], blk.U[1-index],
+			      m_blocks_gravity[b], dt);
+
+      timers[TIMER_NUM_SCHEME]->stop();
+      timers[TIMER_BOUNDARIES]->start();
+
+    });
+
+  timers[TIMER_BOUNDARIES]->stop();
+
+} // SolverHydroMuscl<dim>::godunov_unsplit_blocks
+
+// =======================================================
+// =======================================================
+/**
+ * Temporal blocking : the time step is computed from the state at the
+ * beginning of the block and reduced by temporal_blocking_dt_factor,
+ * since the CFL condition can not be checked inside the block. It is
+ * checked at the end of the block, before the block is accepted (see
+ * godunov_unsplit_tiles); blocks are then made twice shorter, and grow
+ * again one step at a time.
+ *
+ * Blocks end at tEnd, at nStepmax and before outputs, analysis or
+ * output streams.
+ */
+template<int dim>
+void SolverHydroMuscl<dim>::compute_dt_tiles()
+{
+
+  compute_dt();
+
+  if (m_tiles_steps > 0)
+    m_tiles_depth = std::min(m_tiles->depth(), m_tiles_depth+1);
+
+  m_dt *= m_tiles_dt_factor;
+
+  int nSteps = std::min(m_tiles_depth, params.nStepmax - m_iteration);
+
+  // last block : end exactly at tEnd
+  if (m_t + nSteps*m_dt > m_tEnd) {
+    nSteps = std::max(1, (int) std::ceil((m_tEnd - m_t)/m_dt));
+    m_dt = (m_tEnd - m_t)/nSteps;
+  }
+
+  nSteps = steps_before_next_event(std::max(1, nSteps));
+
+  m_tiles_steps = nSteps;
+  m_tiles_left  = nSteps;
+
+} // SolverHydroMuscl<dim>::compute_dt_tiles
+
+// =======================================================
+// =======================================================
+/**
+ * Temporal blocking : the whole block of steps is computed at its first
+ * step (see TemporalBlocking::run), the other steps only advance time.
+ * The result must be the current state (U or U2, according to the
+ * iteration parity) at the end of the block, U and U2 are swapped after
+ * an even number of steps.
+ *
+ * When the state at the end of the block does not allow the time step
+ * used (CFL condition), the block is computed again from its initial
+ * state (left untouched) with half the steps and, if necessary, a
+ * shorter time step; time only advances once a block is accepted. A
+ * block of a single step is always accepted (same as plain stepping).
+ */
+template<int dim>
+void SolverHydroMuscl<dim>::godunov_unsplit_tiles(real_t dt)
+{
+
+  if (m_tiles_left == m_tiles_steps) {
+
+    int myRank=0;
+#ifdef USE_MPI
+    myRank = params.myRank;
+#endif // USE_MPI
+
+    DataArray data_in  = m_iteration % 2 == 0 ? U  : U2;
+    DataArray data_out = m_iteration % 2 == 0 ? U2 : U;
+
+    timers[TIMER_BOUNDARIES]->start();
+    make_boundaries(data_in);
+    timers[TIMER_BOUNDARIES]->stop();
+
+    TemporalBlocking<dim>& tiles = *m_tiles;
+
+    for (;;) {
+
+      timers[TIMER_NUM_SCHEME]->start();
+
+      tiles.run(data_in, data_out, m_tiles_steps, false,
+		[&](int b, int s, DataArray tile_in, DataArray tile_out) {
+
+		  m_sweep_step = m_iteration + s;
+
+		  Kokkos::deep_copy(tile_out, tile_in);
+
+		  godunov_unsplit_kernels(tiles[b].params, tile_in, tile_out,
+					  m_gravity_enabled ? m_tiles_gravity[b] : gravity,
+					  dt);
+
+		});
+
+      timers[TIMER_NUM_SCHEME]->stop();
+
+      if (m_tiles_steps == 1)
+	break;
+
+      // CFL condition at the end of the block (temporal blocking is
+      // limited to a single process)
+      timers[TIMER_DT]->start();
+      const real_t dtOut = params.settings.cfl / compute_inv_dt(params, data_out, gravity);
+      timers[TIMER_DT]->stop();
+
+      if (dt <= dtOut)
+	break;
+
+      // reject the block (a NaN state is rejected too)
+      m_tiles_depth = std::max(1, m_tiles_steps/2);
+      m_tiles_steps = m_tiles_depth;
+      m_tiles_left  = m_tiles_steps;
+
+      if (dtOut*m_tiles_dt_factor < dt)
+	dt = dtOut*m_tiles_dt_factor;
+      m_dt = dt;
+
+      if (myRank==0)
+	printf("temporal blocking : CFL exceeded at step %d, block computed again with %d steps (dt=%g)\n",
+	       m_iteration, m_tiles_steps, dt);
+
+    }
+
+    if (m_tiles_steps % 2 == 0)
+      std::swap(U, U2);
+
+  }
+
+  m_tiles_left--;
+
+} // SolverHydroMuscl<dim>::godunov_unsplit_tiles
+
+// =======================================================
+// =======================================================
+/**
+ * AMR : leaves are advanced level after level (time levels, see
+ * AMRForest::run) as soon as their ghost cells are filled; cells next
+ * to a leaf finer in space or time are then corrected with the fluxes
+ * of that leaf (conservation), and the forest is adapted every
+ * regrid_interval steps.
+ */
+template<int dim>
+void SolverHydroMuscl<dim>::godunov_unsplit_amr(real_t dt)
+{
+
+  const int index = m_iteration % 2;
+
+  AMRForest<dim>& amr = *m_amr;
+
+  timers[TIMER_BOUNDARIES]->start();
+
+  amr.run(index, false, dt, [&](int l, int in, real_t dtLevel) {
+
+      timers[TIMER_BOUNDARIES]->stop();
+      timers[TIMER_NUM_SCHEME]->start();
+
+      auto& leaf = amr[l];
+
+      Kokkos::deep_copy(leaf.U[1-in], leaf.U[in]);
+
+      godunov_unsplit_kernels(leaf.params, leaf.U[in], leaf.U[1-in],
+			      leaf.gravity, dtLevel);
+
+      amr.save_face_fluxes(l, Fluxes_x, Fluxes_y, Fluxes_z);
+
+      timers[TIMER_NUM_SCHEME]->stop();
+      timers[TIMER_BOUNDARIES]->start();
+
+    });
+
+  if (m_amr_regrid_interval > 0 &&
+      (m_iteration+1) % m_amr_regrid_interval == 0)
+    amr_regrid(1-index);
+
+  timers[TIMER_BOUNDARIES]->stop();
+
+} // SolverHydroMuscl<dim>::godunov_unsplit_amr
 
 // =======================================================
 // =======================================================
@@ -785,7 +1498,13 @@ void SolverHydroMuscl<dim>::save_solution_impl()
 {
 
   timers[TIMER_IO]->start();
-  if (m_iteration % 2 == 0)
+  if (m_amr) {
+    m_amr->project(U, m_iteration % 2);
+    save_data(U,  Uhost, m_times_saved, m_t);
+  } else if (m_blocks) {
+    m_blocks->gather(U, m_iteration % 2);
+    save_data(U,  Uhost, m_times_saved, m_t);
+  } else if (m_iteration % 2 == 0)
     save_data(U,  Uhost, m_times_saved, m_t);
   else
     save_data(U2, Uhost, m_times_saved, m_t);
@@ -794,6 +1513,48 @@ void SolverHydroMuscl<dim>::save_solution_impl()
     
 } // SolverHydroMuscl::save_solution_impl()
 
+// =======================================================
+// =======================================================
+template<int dim>
+typename SolverHydroMuscl<dim>::DataArray
+SolverHydroMuscl<dim>::current_state()
+{
+
+  if (m_amr) {
+    m_amr->project(U, m_iteration % 2);
+    return U;
+  } else if (m_blocks) {
+    m_blocks->gather(U, m_iteration % 2);
+    return U;
+  }
+
+  return m_iteration % 2 == 0 ? U : U2;
+
+} // SolverHydroMuscl::current_state()
+
+// =======================================================
+// =======================================================
+template<int dim>
+void SolverHydroMuscl<dim>::run_analysis_impl()
+{
+
+  DataArray Ucur = current_state();
+
+  make_boundaries(Ucur);
+  run_analysis(Ucur, false);
+
+} // SolverHydroMuscl::run_analysis_impl()
+
+// =======================================================
+// =======================================================
+template<int dim>
+void SolverHydroMuscl<dim>::save_streams_impl()
+{
+
+  save_streams(current_state());
+
+} // SolverHydroMuscl::save_streams_impl()
+
 } // namespace muscl
 
 } // namespace ppkMHD
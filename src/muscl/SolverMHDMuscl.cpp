@@ -68,7 +68,7 @@ void SolverMHDMuscl<3>::computeElectricField(DataArray Udata)
 {
 
   // call device functor
-  ComputeElecFieldFunctor3D::apply(params, Udata, Q, ElecField, nbCells);
+  ComputeElecFieldFunctor3D::apply(params, Udata, Q, ElecField);
   
 } // SolverMHDMuscl<3>::computeElectricField
 
@@ -83,7 +83,7 @@ void SolverMHDMuscl<3>::computeMagSlopes(DataArray Udata)
 {
 
   // call device functor
-  ComputeMagSlopesFunctor3D::apply(params, Udata, DeltaA, DeltaB, DeltaC, nbCells);
+  ComputeMagSlopesFunctor3D::apply(params, Udata, DeltaA, DeltaB, DeltaC);
   
 } // SolverMHDMuscl3D::computeMagSlopes
 
@@ -110,7 +110,7 @@ void SolverMHDMuscl<2>::computeTrace(DataArray Udata, real_t dt)
 				   Qp_x, Qp_y,
 				   QEdge_RT, QEdge_RB,
 				   QEdge_LT, QEdge_LB,
-				   dtdx, dtdy, nbCells);
+				   dtdx, dtdy);
   
 } // SolverMHDMuscl<2>::computeTrace
 
@@ -141,8 +141,7 @@ void SolverMHDMuscl<3>::computeTrace(DataArray Udata, real_t dt)
 				   QEdge_RT,  QEdge_RB,  QEdge_LT,  QEdge_LB,
 				   QEdge_RT2, QEdge_RB2, QEdge_LT2, QEdge_LB2,
 				   QEdge_RT3, QEdge_RB3, QEdge_LT3, QEdge_LB3,
-				   dtdx, dtdy, dtdz,
-				   nbCells);
+				   dtdx, dtdy, dtdz);
   
 } // SolverMHDMuscl<3>::computeTrace
 
@@ -163,8 +162,7 @@ void SolverMHDMuscl<2>::computeFluxesAndStore(real_t dt)
 					    Qm_x, Qm_y,
 					    Qp_x, Qp_y,
 					    Fluxes_x, Fluxes_y,
-					    dtdx, dtdy,
-					    nbCells);
+					    dtdx, dtdy);
   
 } // SolverMHDMuscl<2>::computeFluxesAndStore
 
@@ -186,8 +184,7 @@ void SolverMHDMuscl<3>::computeFluxesAndStore(real_t dt)
 					    Qm_x, Qm_y, Qm_z,
 					    Qp_x, Qp_y, Qp_z,
 					    Fluxes_x, Fluxes_y, Fluxes_z,
-					    dtdx, dtdy, dtdz,
-					    nbCells);
+					    dtdx, dtdy, dtdz);
   
 } // SolverMHDMuscl<3>::computeFluxesAndStore
 
@@ -208,7 +205,7 @@ void SolverMHDMuscl<2>::computeEmfAndStore(real_t dt)
 				     QEdge_RT, QEdge_RB,
 				     QEdge_LT, QEdge_LB,
 				     Emf1,
-				     dtdx, dtdy, nbCells);
+				     dtdx, dtdy);
   
 } // SolverMHSMuscl<2>::computeEmfAndStore
 
@@ -231,7 +228,7 @@ void SolverMHDMuscl<3>::computeEmfAndStore(real_t dt)
 				     QEdge_RT2, QEdge_RB2, QEdge_LT2, QEdge_LB2,
 				     QEdge_RT3, QEdge_RB3, QEdge_LT3, QEdge_LB3,
 				     Emf,
-				     dtdx, dtdy, dtdz, nbCells);
+				     dtdx, dtdy, dtdz);
   
 } // SolverMHDMuscl<3>::computeEmfAndStore
 
@@ -281,13 +278,11 @@ void SolverMHDMuscl<2>::godunov_unsplit_impl(DataArray data_in,
     // actual update with fluxes
     UpdateFunctor2D_MHD::apply(params, data_out,
 			       Fluxes_x, Fluxes_y,
-			       dtdx, dtdy,
-			       nbCells);
+			       dtdx, dtdy);
     
     // actual update with emf
     UpdateEmfFunctor2D::apply(params, data_out,
-			      Emf1, dtdx, dtdy,
-			      nbCells);
+			      Emf1, dtdx, dtdy);
     
   }
   timers[TIMER_NUM_SCHEME]->stop();
@@ -348,13 +343,11 @@ void SolverMHDMuscl<3>::godunov_unsplit_impl(DataArray data_in,
     // actual update with fluxes
     UpdateFunctor3D_MHD::apply(params, data_out,
 			       Fluxes_x, Fluxes_y, Fluxes_z,
-			       dtdx, dtdy, dtdz,
-			       nbCells);
+			       dtdx, dtdy, dtdz);
 
     // actual update with emf
     UpdateEmfFunctor3D::apply(params, data_out,
-			      Emf, dtdx, dtdy, dtdz,
-			      nbCells);
+			      Emf, dtdx, dtdy, dtdz);
     
   }
   timers[TIMER_NUM_SCHEME]->stop();
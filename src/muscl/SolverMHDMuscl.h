@@ -158,6 +158,10 @@ public:
 
   // output
   void save_solution_impl();
+
+  // in-situ analysis and output streams
+  void run_analysis_impl();
+  void save_streams_impl();
   
   int isize, jsize, ksize;
   int nbCells;
@@ -200,11 +204,25 @@ SolverMHDMuscl<dim>::SolverMHDMuscl(HydroParams& params,
   
   m_nCells = nbCells;
   m_nDofsPerCell = 1;
+
+  if (params.implementationVersion == 2) {
+    fprintf(stderr, "implementationVersion=2 (directionally split sweeps) is only available for hydro\n");
+    exit(EXIT_FAILURE);
+  }
   
   int nbvar = params.nbvar;
  
   long long int total_mem_size = 0;
 
+  /*
+   * work arrays live in the scratch arena, phases of a time step are
+   * those of godunov_unsplit_impl : fluxes reuse the memory of the
+   * primitive variables (and electric field, magnetic slopes in 3d),
+   * which are no longer needed once the trace is computed.
+   */
+  enum { PHASE_PRIMITIVES, PHASE_ELEC_FIELD, PHASE_MAG_SLOPES, PHASE_TRACE,
+	 PHASE_FLUXES, PHASE_EMF, PHASE_UPDATE };
+
   /*
    * memory allocation (use sizes with ghosts included).
    *
@@ -217,30 +235,27 @@ SolverMHDMuscl<dim>::SolverMHDMuscl(HydroParams& params,
     U     = DataArray("U", isize, jsize, nbvar);
     Uhost = Kokkos::create_mirror(U);
     U2    = DataArray("U2",isize, jsize, nbvar);
-    Q     = DataArray("Q", isize, jsize, nbvar);
 
-    total_mem_size += isize*jsize*nbvar * sizeof(real_t) * 3;// 1+1+1 for U+U2+Q
+    total_mem_size += isize*jsize*nbvar * sizeof(real_t) * 2;// 1+1 for U+U2
+
+    m_scratch.declare(Q, PHASE_PRIMITIVES, PHASE_TRACE, isize, jsize, nbvar);
     
     if (params.implementationVersion == 0) {
       
-      Qm_x = DataArray("Qm_x", isize,jsize, nbvar);
-      Qm_y = DataArray("Qm_y", isize,jsize, nbvar);
-      Qp_x = DataArray("Qp_x", isize,jsize, nbvar);
-      Qp_y = DataArray("Qp_y", isize,jsize, nbvar);
+      m_scratch.declare(Qm_x, PHASE_TRACE, PHASE_FLUXES, isize,jsize, nbvar);
+      m_scratch.declare(Qm_y, PHASE_TRACE, PHASE_FLUXES, isize,jsize, nbvar);
+      m_scratch.declare(Qp_x, PHASE_TRACE, PHASE_FLUXES, isize,jsize, nbvar);
+      m_scratch.declare(Qp_y, PHASE_TRACE, PHASE_FLUXES, isize,jsize, nbvar);
       
-      QEdge_RT = DataArray("QEdge_RT", isize,jsize, nbvar);
-      QEdge_RB = DataArray("QEdge_RB", isize,jsize, nbvar);
-      QEdge_LT = DataArray("QEdge_LT", isize,jsize, nbvar);
-      QEdge_LB = DataArray("QEdge_LB", isize,jsize, nbvar);
+      m_scratch.declare(QEdge_RT, PHASE_TRACE, PHASE_EMF, isize,jsize, nbvar);
+      m_scratch.declare(QEdge_RB, PHASE_TRACE, PHASE_EMF, isize,jsize, nbvar);
+      m_scratch.declare(QEdge_LT, PHASE_TRACE, PHASE_EMF, isize,jsize, nbvar);
+      m_scratch.declare(QEdge_LB, PHASE_TRACE, PHASE_EMF, isize,jsize, nbvar);
       
-      Fluxes_x = DataArray("Fluxes_x", isize,jsize, nbvar);
-      Fluxes_y = DataArray("Fluxes_y", isize,jsize, nbvar);
+      m_scratch.declare(Fluxes_x, PHASE_FLUXES, PHASE_UPDATE, isize,jsize, nbvar);
+      m_scratch.declare(Fluxes_y, PHASE_FLUXES, PHASE_UPDATE, isize,jsize, nbvar);
       
-      Emf1 = DataArrayScalar("Emf", isize,jsize);
-      
-      total_mem_size +=
-	isize*jsize* nbvar * sizeof(real_t) * 10 +
-	isize*jsize*     1 * sizeof(real_t);
+      m_scratch.declare(Emf1, PHASE_EMF, PHASE_UPDATE, isize,jsize);
       
     }
 
@@ -249,54 +264,57 @@ SolverMHDMuscl<dim>::SolverMHDMuscl(HydroParams& params,
     U     = DataArray("U", isize,jsize,ksize, nbvar);
     Uhost = Kokkos::create_mirror(U);
     U2    = DataArray("U2",isize,jsize,ksize, nbvar);
-    Q     = DataArray("Q", isize,jsize,ksize, nbvar);
     
-    total_mem_size += isize*jsize*ksize*nbvar*sizeof(real_t)*3;// 1+1+1=3 for U+U2+Q
+    total_mem_size += isize*jsize*ksize*nbvar*sizeof(real_t)*2;// 1+1=2 for U+U2
+
+    m_scratch.declare(Q, PHASE_PRIMITIVES, PHASE_TRACE, isize,jsize,ksize, nbvar);
 
     if (params.implementationVersion == 0) {
       
-      Qm_x = DataArray("Qm_x", isize,jsize,ksize, nbvar);
-      Qm_y = DataArray("Qm_y", isize,jsize,ksize, nbvar);
-      Qm_z = DataArray("Qm_z", isize,jsize,ksize, nbvar);
+      m_scratch.declare(Qm_x, PHASE_TRACE, PHASE_FLUXES, isize,jsize,ksize, nbvar);
+      m_scratch.declare(Qm_y, PHASE_TRACE, PHASE_FLUXES, isize,jsize,ksize, nbvar);
+      m_scratch.declare(Qm_z, PHASE_TRACE, PHASE_FLUXES, isize,jsize,ksize, nbvar);
       
-      Qp_x = DataArray("Qp_x", isize,jsize,ksize, nbvar);
-      Qp_y = DataArray("Qp_y", isize,jsize,ksize, nbvar);
-      Qp_z = DataArray("Qp_z", isize,jsize,ksize, nbvar);
+      m_scratch.declare(Qp_x, PHASE_TRACE, PHASE_FLUXES, isize,jsize,ksize, nbvar);
+      m_scratch.declare(Qp_y, PHASE_TRACE, PHASE_FLUXES, isize,jsize,ksize, nbvar);
+      m_scratch.declare(Qp_z, PHASE_TRACE, PHASE_FLUXES, isize,jsize,ksize, nbvar);
       
-      QEdge_RT  = DataArray("QEdge_RT", isize,jsize,ksize, nbvar);
-      QEdge_RB  = DataArray("QEdge_RB", isize,jsize,ksize, nbvar);
-      QEdge_LT  = DataArray("QEdge_LT", isize,jsize,ksize, nbvar);
-      QEdge_LB  = DataArray("QEdge_LB", isize,jsize,ksize, nbvar);
+      m_scratch.declare(QEdge_RT,  PHASE_TRACE, PHASE_EMF, isize,jsize,ksize, nbvar);
+      m_scratch.declare(QEdge_RB,  PHASE_TRACE, PHASE_EMF, isize,jsize,ksize, nbvar);
+      m_scratch.declare(QEdge_LT,  PHASE_TRACE, PHASE_EMF, isize,jsize,ksize, nbvar);
+      m_scratch.declare(QEdge_LB,  PHASE_TRACE, PHASE_EMF, isize,jsize,ksize, nbvar);
       
-      QEdge_RT2 = DataArray("QEdge_RT2", isize,jsize,ksize, nbvar);
-      QEdge_RB2 = DataArray("QEdge_RB2", isize,jsize,ksize, nbvar);
-      QEdge_LT2 = DataArray("QEdge_LT2", isize,jsize,ksize, nbvar);
-      QEdge_LB2 = DataArray("QEdge_LB2", isize,jsize,ksize, nbvar);
+      m_scratch.declare(QEdge_RT2, PHASE_TRACE, PHASE_EMF, isize,jsize,ksize, nbvar);
+      m_scratch.declare(QEdge_RB2, PHASE_TRACE, PHASE_EMF, isize,jsize,ksize, nbvar);
+      m_scratch.declare(QEdge_LT2, PHASE_TRACE, PHASE_EMF, isize,jsize,ksize, nbvar);
+      m_scratch.declare(QEdge_LB2, PHASE_TRACE, PHASE_EMF, isize,jsize,ksize, nbvar);
       
-      QEdge_RT3 = DataArray("QEdge_RT3", isize,jsize,ksize, nbvar);
-      QEdge_RB3 = DataArray("QEdge_RB3", isize,jsize,ksize, nbvar);
-      QEdge_LT3 = DataArray("QEdge_LT3", isize,jsize,ksize, nbvar);
-      QEdge_LB3 = DataArray("QEdge_LB3", isize,jsize,ksize, nbvar);
+      m_scratch.declare(QEdge_RT3, PHASE_TRACE, PHASE_EMF, isize,jsize,ksize, nbvar);
+      m_scratch.declare(QEdge_RB3, PHASE_TRACE, PHASE_EMF, isize,jsize,ksize, nbvar);
+      m_scratch.declare(QEdge_LT3, PHASE_TRACE, PHASE_EMF, isize,jsize,ksize, nbvar);
+      m_scratch.declare(QEdge_LB3, PHASE_TRACE, PHASE_EMF, isize,jsize,ksize, nbvar);
       
-      Fluxes_x  = DataArray("Fluxes_x", isize,jsize,ksize, nbvar);
-      Fluxes_y  = DataArray("Fluxes_y", isize,jsize,ksize, nbvar);
-      Fluxes_z  = DataArray("Fluxes_z", isize,jsize,ksize, nbvar);
+      m_scratch.declare(Fluxes_x, PHASE_FLUXES, PHASE_UPDATE, isize,jsize,ksize, nbvar);
+      m_scratch.declare(Fluxes_y, PHASE_FLUXES, PHASE_UPDATE, isize,jsize,ksize, nbvar);
+      m_scratch.declare(Fluxes_z, PHASE_FLUXES, PHASE_UPDATE, isize,jsize,ksize, nbvar);
       
-      Emf       = DataArrayVector3("Emf", isize,jsize,ksize);
+      // the emf update reads one layer beyond the computed edges (into
+      // ghost cells) : keep it out of aliasing so that this layer
+      // stays zero
+      m_scratch.declare(Emf, PHASE_PRIMITIVES, PHASE_UPDATE, isize,jsize,ksize);
       
-      ElecField = DataArrayVector3("ElecField", isize,jsize,ksize); 
+      m_scratch.declare(ElecField, PHASE_ELEC_FIELD, PHASE_TRACE, isize,jsize,ksize);
       
-      DeltaA    = DataArrayVector3("DeltaA", isize,jsize,ksize);
-      DeltaB    = DataArrayVector3("DeltaB", isize,jsize,ksize);
-      DeltaC    = DataArrayVector3("DeltaC", isize,jsize,ksize);
-      
-      total_mem_size +=
-	isize*jsize*ksize*nbvar*sizeof(real_t)*21 +
-	isize*jsize*ksize*    3*sizeof(real_t)*5;
+      m_scratch.declare(DeltaA, PHASE_MAG_SLOPES, PHASE_TRACE, isize,jsize,ksize);
+      m_scratch.declare(DeltaB, PHASE_MAG_SLOPES, PHASE_TRACE, isize,jsize,ksize);
+      m_scratch.declare(DeltaC, PHASE_MAG_SLOPES, PHASE_TRACE, isize,jsize,ksize);
       
     }
 
   } // dim == 2 / 3
+
+  m_scratch.allocate();
+  total_mem_size += m_scratch.size();
   
   // perform init condition
   init(U);
@@ -310,6 +328,9 @@ SolverMHDMuscl<dim>::SolverMHDMuscl(HydroParams& params,
   // compute initialize time step
   compute_dt();
 
+  // footprint of the most loaded process
+  const double mem_size = max_memory_footprint(total_mem_size);
+
   int myRank=0;
 #ifdef USE_MPI
   myRank = params.myRank;
@@ -324,7 +345,9 @@ SolverMHDMuscl<dim>::SolverMHDMuscl(HydroParams& params,
     // print parameters on screen
     params.print();
     std::cout << "##########################" << "\n";
-    std::cout << "Memory requested : " << (total_mem_size / 1e6) << " MBytes\n"; 
+    std::cout << "Memory requested : " << (mem_size / 1e6) << " MBytes per process (peak)\n";
+    std::cout << "Work arrays      : " << (m_scratch.size() / 1e6) << " MBytes ("
+	      << (m_scratch.requested_size() / 1e6) << " MBytes without aliasing)\n";
     std::cout << "##########################" << "\n";
   }
   
@@ -376,7 +399,7 @@ void SolverMHDMuscl<dim>::init_blast(DataArray Udata)
 			      InitBlastFunctor3D_MHD>::type;
 
   // perform init
-  InitBlastFunctor::apply(params, blastParams, Udata, nbCells);
+  InitBlastFunctor::apply(params, blastParams, Udata);
 
 } // SolverMHDMuscl::init_blast
 
@@ -398,7 +421,7 @@ void SolverMHDMuscl<dim>::init_orszag_tang(DataArray Udata)
 			      InitOrszagTangFunctor2D,
 			      InitOrszagTangFunctor3D>::type;
   
-  InitOrszagTangFunctor::apply(params, otParams, Udata, nbCells);
+  InitOrszagTangFunctor::apply(params, otParams, Udata);
   
 } // init_orszag_tang
 
@@ -427,7 +450,7 @@ void SolverMHDMuscl<dim>::init_kelvin_helmholtz(DataArray Udata)
 			      InitKelvinHelmholtzFunctor3D_MHD>::type;
 
   // perform init
-  InitKelvinHelmholtzFunctor::apply(params, khParams, Udata, nbCells);
+  InitKelvinHelmholtzFunctor::apply(params, khParams, Udata);
   
 } // init_kelvin_helmholtz
 
@@ -450,7 +473,7 @@ void SolverMHDMuscl<dim>::init_implode(DataArray Udata)
 			      InitImplodeFunctor3D_MHD>::type;
 
   // perform init
-  InitImplodeFunctor::apply(params, implodeParams, Udata, nbCells);
+  InitImplodeFunctor::apply(params, implodeParams, Udata);
 
 } // SolverMHDMuscl::init_implode
 
@@ -473,7 +496,7 @@ void SolverMHDMuscl<dim>::init_rotor(DataArray Udata)
 			      InitRotorFunctor3D_MHD>::type;
 
   // perform init
-  InitRotorFunctor::apply(params, rotorParams, Udata, nbCells);
+  InitRotorFunctor::apply(params, rotorParams, Udata);
 
 } // SolverMHDMuscl::init_rotor
 
@@ -496,7 +519,7 @@ void SolverMHDMuscl<dim>::init_field_loop(DataArray Udata)
 			      InitFieldLoopFunctor3D_MHD>::type;
 
   // perform init
-  InitFieldLoopFunctor::apply(params, flParams, Udata, nbCells);
+  InitFieldLoopFunctor::apply(params, flParams, Udata);
 
 } // SolverMHDMuscl::init_field_loop
 
@@ -518,7 +541,7 @@ void SolverMHDMuscl<dim>::init_wave(DataArray Udata)
 			      InitWaveFunctor3D_MHD>::type;
 
   // perform init
-  InitWaveFunctor::apply(params, wParams, Udata, nbCells);
+  InitWaveFunctor::apply(params, wParams, Udata);
 
 } // SolverMHDMuscl::init_wave
 
@@ -644,7 +667,7 @@ double SolverMHDMuscl<dim>::compute_dt_local()
 			      ComputeDtFunctor3D_MHD>::type;
 
   // call device functor
-  ComputeDtFunctor::apply(params, Udata, nbCells, invDt);
+  ComputeDtFunctor::apply(params, Udata, invDt);
     
   dt = params.settings.cfl/invDt;
 
@@ -756,7 +779,7 @@ void SolverMHDMuscl<dim>::convertToPrimitives(DataArray Udata)
 			      ConvertToPrimitivesFunctor3D_MHD>::type;
 
   // call device functor
-  ConvertToPrimitivesFunctor::apply(params, Udata, Q, nbCells);
+  ConvertToPrimitivesFunctor::apply(params, Udata, Q);
   
 } // SolverMHDMuscl::convertToPrimitives
 
@@ -808,6 +831,29 @@ void SolverMHDMuscl<dim>::save_solution_impl()
     
 } // SolverMHDMuscl::save_solution_impl()
 
+// =======================================================
+// =======================================================
+template<int dim>
+void SolverMHDMuscl<dim>::run_analysis_impl()
+{
+
+  DataArray Ucur = m_iteration % 2 == 0 ? U : U2;
+
+  make_boundaries(Ucur);
+  run_analysis(Ucur, true);
+
+} // SolverMHDMuscl::run_analysis_impl()
+
+// =======================================================
+// =======================================================
+template<int dim>
+void SolverMHDMuscl<dim>::save_streams_impl()
+{
+
+  save_streams(m_iteration % 2 == 0 ? U : U2);
+
+} // SolverMHDMuscl::save_streams_impl()
+
 } // namespace muscl
 
 } // namespace ppkMHD
@@ -11,6 +11,14 @@
 
 namespace sdm {
 
+//! list of cell (flat) indexes, used to restrict a functor to a subset of
+//! cells (e.g. cells flagged by a troubled cells indicator).
+//! Also used to store per-cell integer flags.
+using CellList = Kokkos::View<int*, Device>;
+
+//! tag used to launch a functor over a CellList instead of all cells
+struct TagCellList {};
+
 /**
  * SDM base functor, this is not a functor, but a base class to derive an actual
  * Kokkos functor.
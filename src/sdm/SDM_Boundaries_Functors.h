@@ -3,6 +3,7 @@
 
 #include "shared/HydroParams.h"    // for HydroParams
 #include "shared/kokkos_shared.h"  // for Data arrays
+#include "shared/BoundariesFunctors.h" // for boundary_policy
 
 namespace sdm {
 
@@ -40,11 +41,12 @@ public:
   // static method which does it all: create and execute functor
   static void apply(HydroParams         params,
                     SDM_Geometry<dim,N> sdm_geom,
-                    DataArray           Udata,
-                    int                 nbIter)
+                    DataArray           Udata)
   {
     MakeBoundariesFunctor_SDM<dim,N,faceId> functor(params, sdm_geom, Udata);
-    Kokkos::parallel_for(nbIter, functor);
+    Kokkos::parallel_for("MakeBoundariesFunctor_SDM",
+                         boundary_policy<dim>(params, faceId),
+                         functor);
   }
 
   // ================================================
@@ -55,21 +57,14 @@ public:
   //! functor for 2d 
   template<int dim_ = dim>
   KOKKOS_INLINE_FUNCTION
-  void operator()(const typename std::enable_if<dim_==2, int>::type& index) const
+  void operator()(const typename std::enable_if<dim_==2, int>::type& i,
+                  const int& j) const
   {
     const int nx = this->params.nx;
     const int ny = this->params.ny;
     
     const int ghostWidth = this->params.ghostWidth;
-    const int nbvar = this->params.nbvar;
-    
-    const int imin = this->params.imin;
-    const int imax = this->params.imax;
-    
-    const int jmin = this->params.jmin;
-    const int jmax = this->params.jmax;
-    
-    int i,j;
+    const int nbvar = NbVar<dim>::value;
     
     int boundary_type;
     
@@ -81,48 +76,39 @@ public:
       // boundary xmin
       boundary_type = this->params.boundary_type_xmin;
 
-      j = index / ghostWidth;
-      i = index - j*ghostWidth;
-      
-      if(j >= jmin && j <= jmax    &&
-	 i >= 0    && i <ghostWidth) {
-	
-	for (int idy=0; idy<N; ++idy) {
-	  for (int idx=0; idx<N; ++idx) {
+      for (int idy=0; idy<N; ++idy) {
+	for (int idx=0; idx<N; ++idx) {
 	    
-	    for ( iVar=0; iVar<nbvar; iVar++ ) {
-	      real_t sign=1.0;
+	  for ( iVar=0; iVar<nbvar; iVar++ ) {
+	    real_t sign=1.0;
 	      
-	      if ( boundary_type == BC_DIRICHLET ) {
-		i0=2*ghostWidth-1-i;
-		if (iVar==IU) sign=-ONE_F;
+	    if ( boundary_type == BC_DIRICHLET ) {
+	      i0=2*ghostWidth-1-i;
+	      if (iVar==IU) sign=-ONE_F;
 
-		// mirror DoFs idx <-> N-1-idx
-		Udata(i  ,j  , dofMap(idx,idy,0,iVar)) =
-		  Udata(i0  ,j  , dofMap(N-1-idx,idy,0,iVar))*sign;
+	      // mirror DoFs idx <-> N-1-idx
+	      Udata(i  ,j  , dofMap(idx,idy,0,iVar)) =
+		Udata(i0  ,j  , dofMap(N-1-idx,idy,0,iVar))*sign;
 		
-	      } else if( boundary_type == BC_NEUMANN ) {
+	    } else if( boundary_type == BC_NEUMANN ) {
 
-		// TO BE MODIFIED: ghost cell DoFs must be extrapolated from
-		// the inside
-		i0=ghostWidth;
-		Udata(i  ,j  , dofMap(idx,idy,0,iVar)) =
-		  Udata(i0  ,j  , dofMap(idx,idy,0,iVar));
+	      // TO BE MODIFIED: ghost cell DoFs must be extrapolated from
+	      // the inside
+	      i0=ghostWidth;
+	      Udata(i  ,j  , dofMap(idx,idy,0,iVar)) =
+		Udata(i0  ,j  , dofMap(idx,idy,0,iVar));
 
-	      } else { // periodic
+	    } else { // periodic
 
-		i0=nx+i;
-		Udata(i  ,j  , dofMap(idx,idy,0,iVar)) =
-		  Udata(i0  ,j  , dofMap(idx,idy,0,iVar));
+	      i0=nx+i;
+	      Udata(i  ,j  , dofMap(idx,idy,0,iVar)) =
+		Udata(i0  ,j  , dofMap(idx,idy,0,iVar));
 		
-	      }
+	    }
 	      
-	  
-	    } // end for iVar
-	  } // end for idx
-	} // end for idy
-	
-      } // end guard
+	  } // end for iVar
+	} // end for idx
+      } // end for idy
       
     } // end FACE_XMIN
 
@@ -131,46 +117,37 @@ public:
       // boundary xmax
       boundary_type = this->params.boundary_type_xmax;
       
-      j = index / ghostWidth;
-      i = index - j*ghostWidth;
-      i += (nx+ghostWidth);
+      for (int idy=0; idy<N; ++idy) {
+	for (int idx=0; idx<N; ++idx) {
 
-      if(j >= jmin          && j <= jmax             &&
-	 i >= nx+ghostWidth && i <= nx+2*ghostWidth-1) {
-	
-	for (int idy=0; idy<N; ++idy) {
-	  for (int idx=0; idx<N; ++idx) {
-
-	    for ( iVar=0; iVar<nbvar; iVar++ ) {
-	      real_t sign=1.0;
+	  for ( iVar=0; iVar<nbvar; iVar++ ) {
+	    real_t sign=1.0;
 	      
-	      if ( boundary_type == BC_DIRICHLET ) {
+	    if ( boundary_type == BC_DIRICHLET ) {
 
-		i0=2*nx+2*ghostWidth-1-i;
-		if (iVar==IU) sign=-ONE_F;
+	      i0=2*nx+2*ghostWidth-1-i;
+	      if (iVar==IU) sign=-ONE_F;
 
-		// mirror DoFs idx <-> N-1-idx
-		Udata(i  ,j  , dofMap(idx,idy,0,iVar)) =
-		  Udata(i0 ,j  , dofMap(N-1-idx,idy,0,iVar))*sign;
+	      // mirror DoFs idx <-> N-1-idx
+	      Udata(i  ,j  , dofMap(idx,idy,0,iVar)) =
+		Udata(i0 ,j  , dofMap(N-1-idx,idy,0,iVar))*sign;
 		
-	      } else if ( boundary_type == BC_NEUMANN ) {
+	    } else if ( boundary_type == BC_NEUMANN ) {
 
-		i0=nx+ghostWidth-1;
-		Udata(i  ,j  , dofMap(idx,idy,0,iVar)) =
-		  Udata(i0 ,j  , dofMap(idx,idy,0,iVar));
+	      i0=nx+ghostWidth-1;
+	      Udata(i  ,j  , dofMap(idx,idy,0,iVar)) =
+		Udata(i0 ,j  , dofMap(idx,idy,0,iVar));
 
-	      } else { // periodic
+	    } else { // periodic
 
-		i0=i-nx;
-		Udata(i  ,j  , dofMap(idx,idy,0,iVar)) =
-		  Udata(i0 ,j  , dofMap(idx,idy,0,iVar));
-	      }
+	      i0=i-nx;
+	      Udata(i  ,j  , dofMap(idx,idy,0,iVar)) =
+		Udata(i0 ,j  , dofMap(idx,idy,0,iVar));
+	    }
 	  
-	    } // end for iVar
-	  } // end for idx
-	} // end for idy
-
-      } // end guard
+	  } // end for iVar
+	} // end for idx
+      } // end for idy
       
     } // end FACE_XMAX
     
@@ -179,45 +156,37 @@ public:
       // boundary ymin
       boundary_type = this->params.boundary_type_ymin;
       
-      i = index / ghostWidth;
-      j = index - i*ghostWidth;
+      for (int idy=0; idy<N; ++idy) {
+	for (int idx=0; idx<N; ++idx) {
 
-      if(i >= imin && i <= imax    &&
-	 j >= 0    && j <ghostWidth) {
-	
-	for (int idy=0; idy<N; ++idy) {
-	  for (int idx=0; idx<N; ++idx) {
+	  for ( iVar=0; iVar<nbvar; iVar++ ) {
+	    real_t sign=1.0;
 
-	    for ( iVar=0; iVar<nbvar; iVar++ ) {
-	      real_t sign=1.0;
-
-	      if ( boundary_type == BC_DIRICHLET ) {
+	    if ( boundary_type == BC_DIRICHLET ) {
 
-		j0=2*ghostWidth-1-j;
-		if (iVar==IV) sign=-ONE_F;
-		// mirror DoFs idy <-> N-1-idy
-		Udata(i  ,j  , dofMap(idx,idy,0,iVar)) =
-		  Udata(i  ,j0 , dofMap(idx,N-1-idy,0,iVar))*sign;
+	      j0=2*ghostWidth-1-j;
+	      if (iVar==IV) sign=-ONE_F;
+	      // mirror DoFs idy <-> N-1-idy
+	      Udata(i  ,j  , dofMap(idx,idy,0,iVar)) =
+		Udata(i  ,j0 , dofMap(idx,N-1-idy,0,iVar))*sign;
 		
-	      } else if ( boundary_type == BC_NEUMANN ) {
+	    } else if ( boundary_type == BC_NEUMANN ) {
 
-		j0=ghostWidth;
-		Udata(i  ,j  , dofMap(idx,idy,0,iVar)) =
-		  Udata(i  ,j0 , dofMap(idx,idy,0,iVar));
+	      j0=ghostWidth;
+	      Udata(i  ,j  , dofMap(idx,idy,0,iVar)) =
+		Udata(i  ,j0 , dofMap(idx,idy,0,iVar));
 		
-	      } else { // periodic
+	    } else { // periodic
 
-		j0=ny+j;
-		Udata(i  ,j  , dofMap(idx,idy,0,iVar)) =
-		  Udata(i  ,j0 , dofMap(idx,idy,0,iVar));
+	      j0=ny+j;
+	      Udata(i  ,j  , dofMap(idx,idy,0,iVar)) =
+		Udata(i  ,j0 , dofMap(idx,idy,0,iVar));
 		
-	      }
+	    }
 	  
-	    } // end for IVar
-	  } // end for idx
-	} // end for idy
-	
-      } // end guard
+	  } // end for IVar
+	} // end for idx
+      } // end for idy
       
     } // end FACE_YMIN
 
@@ -226,45 +195,37 @@ public:
       // boundary ymax
       boundary_type = this->params.boundary_type_ymax;
       
-      i = index / ghostWidth;
-      j = index - i*ghostWidth;
-      j += (ny+ghostWidth);
-      if(i >= imin          && i <= imax              &&
-	 j >= ny+ghostWidth && j <= ny+2*ghostWidth-1) {
-	
-	for (int idy=0; idy<N; ++idy) {
-	  for (int idx=0; idx<N; ++idx) {
+      for (int idy=0; idy<N; ++idy) {
+	for (int idx=0; idx<N; ++idx) {
 
-	    for ( iVar=0; iVar<nbvar; iVar++ ) {
-	      real_t sign=1.0;
+	  for ( iVar=0; iVar<nbvar; iVar++ ) {
+	    real_t sign=1.0;
 	      
-	      if ( boundary_type == BC_DIRICHLET ) {
+	    if ( boundary_type == BC_DIRICHLET ) {
 
-		j0=2*ny+2*ghostWidth-1-j;
-		if (iVar==IV) sign=-ONE_F;
-		// mirror DoFs idy <-> N-1-idy
-		Udata(i  ,j  , dofMap(idx,idy,0,iVar)) =
-		  Udata(i  ,j0  , dofMap(idx,N-1-idy,0,iVar))*sign;
+	      j0=2*ny+2*ghostWidth-1-j;
+	      if (iVar==IV) sign=-ONE_F;
+	      // mirror DoFs idy <-> N-1-idy
+	      Udata(i  ,j  , dofMap(idx,idy,0,iVar)) =
+		Udata(i  ,j0  , dofMap(idx,N-1-idy,0,iVar))*sign;
 		
-	      } else if ( boundary_type == BC_NEUMANN ) {
+	    } else if ( boundary_type == BC_NEUMANN ) {
 
-		j0=ny+ghostWidth-1;
-		Udata(i  ,j  , dofMap(idx,idy,0,iVar)) =
-		  Udata(i  ,j0  , dofMap(idx,idy,0,iVar));
+	      j0=ny+ghostWidth-1;
+	      Udata(i  ,j  , dofMap(idx,idy,0,iVar)) =
+		Udata(i  ,j0  , dofMap(idx,idy,0,iVar));
 		
-	      } else { // periodic
+	    } else { // periodic
 
-		j0=j-ny;
-		Udata(i  ,j  , dofMap(idx,idy,0,iVar)) =
-		  Udata(i  ,j0  , dofMap(idx,idy,0,iVar));
+	      j0=j-ny;
+	      Udata(i  ,j  , dofMap(idx,idy,0,iVar)) =
+		Udata(i  ,j0  , dofMap(idx,idy,0,iVar));
 		
-	      }
+	    }
 	      	      
-	    } // end for iVar
-	  } // end for idx
-	} // end for idy
-
-      } // end guard
+	  } // end for iVar
+	} // end for idx
+      } // end for idy
       
     } // end FACE_YMAX
     
@@ -278,29 +239,18 @@ public:
   //! functor for 3d 
   template<int dim_ = dim>
   KOKKOS_INLINE_FUNCTION
-  void operator()(const typename std::enable_if<dim_==3, int>::type& index) const
+  void operator()(const typename std::enable_if<dim_==3, int>::type& i,
+                  const int& j,
+                  const int& k) const
   {
 
     const int nx = this->params.nx;
     const int ny = this->params.ny;
     const int nz = this->params.nz;
     
-    const int isize = this->params.isize;
-    const int jsize = this->params.jsize;
     //const int ksize = this->params.ksize;
     const int ghostWidth = this->params.ghostWidth;
-    const int nbvar = this->params.nbvar;
-    
-    const int imin = this->params.imin;
-    const int imax = this->params.imax;
-    
-    const int jmin = this->params.jmin;
-    const int jmax = this->params.jmax;
-
-    const int kmin = this->params.kmin;
-    const int kmax = this->params.kmax;
-    
-    int i,j,k;
+    const int nbvar = NbVar<dim>::value;
     
     int boundary_type;
     
@@ -309,312 +259,257 @@ public:
     
     if (faceId == FACE_XMIN) {
       
-      // boundary xmin (index = i + j * ghostWidth + k * ghostWidth*jsize)
-      k = index / (ghostWidth*jsize);
-      j = (index - k*ghostWidth*jsize) / ghostWidth;
-      i = index - j*ghostWidth - k*ghostWidth*jsize;
+      // boundary xmin
       
       boundary_type = this->params.boundary_type_xmin;
       
-      if(k >= kmin && k <= kmax &&
-	 j >= jmin && j <= jmax &&
-	 i >= 0    && i <ghostWidth) {
-	
-	for (int idz=0; idz<N; ++idz) {
-	  for (int idy=0; idy<N; ++idy) {
-	    for (int idx=0; idx<N; ++idx) {
+      for (int idz=0; idz<N; ++idz) {
+	for (int idy=0; idy<N; ++idy) {
+	  for (int idx=0; idx<N; ++idx) {
 	      
-	      for ( iVar=0; iVar<nbvar; iVar++ ) {
-		real_t sign=1.0;
+	    for ( iVar=0; iVar<nbvar; iVar++ ) {
+	      real_t sign=1.0;
 		
-		if ( boundary_type == BC_DIRICHLET ) {
+	      if ( boundary_type == BC_DIRICHLET ) {
 
-		  i0=2*ghostWidth-1-i;
-		  if (iVar==IU) sign=-ONE_F;
-		  // mirror DoFs idx <-> N-1-idx
-		  Udata(i,j,k, dofMap(idx,idy,idz,iVar)) =
-		    Udata(i0,j,k, dofMap(N-1-idx,idy,idz,iVar))*sign;
+		i0=2*ghostWidth-1-i;
+		if (iVar==IU) sign=-ONE_F;
+		// mirror DoFs idx <-> N-1-idx
+		Udata(i,j,k, dofMap(idx,idy,idz,iVar)) =
+		  Udata(i0,j,k, dofMap(N-1-idx,idy,idz,iVar))*sign;
 
-		} else if( boundary_type == BC_NEUMANN ) {
+	      } else if( boundary_type == BC_NEUMANN ) {
 
-		  i0=ghostWidth;
-		  Udata(i,j,k, dofMap(idx,idy,idz,iVar)) =
-		    Udata(i0,j,k, dofMap(idx,idy,idz,iVar));
+		i0=ghostWidth;
+		Udata(i,j,k, dofMap(idx,idy,idz,iVar)) =
+		  Udata(i0,j,k, dofMap(idx,idy,idz,iVar));
 
-		} else { // periodic
+	      } else { // periodic
 
-		  i0=nx+i;
-		  Udata(i,j,k, dofMap(idx,idy,idz,iVar)) =
-		    Udata(i0,j,k, dofMap(idx,idy,idz,iVar));
+		i0=nx+i;
+		Udata(i,j,k, dofMap(idx,idy,idz,iVar)) =
+		  Udata(i0,j,k, dofMap(idx,idy,idz,iVar));
 		  
-		}
+	      }
 		
-	  
-	      } // end for iVar
-	    } // end for idx
-	  } // end for idy
-	} // end for idz
+	    } // end for iVar
+	  } // end for idx
+	} // end for idy
+      } // end for idz
 	
-      } // end guard
     } // end FACE_XMIN
 
     if (faceId == FACE_XMAX) {
       
-      // boundary xmax (index = i + j *ghostWidth + k * ghostWidth*jsize)
+      // boundary xmax
       // same i,j,k as xmin, except translation along x-axis
-      k = index / (ghostWidth*jsize);
-      j = (index - k*ghostWidth*jsize) / ghostWidth;
-      i = index - j*ghostWidth - k*ghostWidth*jsize;
 
-      i += (nx+ghostWidth);
-      
       boundary_type = this->params.boundary_type_xmax;
       
-      if(k >= kmin          && k <= kmax &&
-	 j >= jmin          && j <= jmax &&
-	 i >= nx+ghostWidth && i <= nx+2*ghostWidth-1) {
-	
-	for (int idz=0; idz<N; ++idz) {
-	  for (int idy=0; idy<N; ++idy) {
-	    for (int idx=0; idx<N; ++idx) {
+      for (int idz=0; idz<N; ++idz) {
+	for (int idy=0; idy<N; ++idy) {
+	  for (int idx=0; idx<N; ++idx) {
 
-	      for ( iVar=0; iVar<nbvar; iVar++ ) {
-		real_t sign=1.0;
+	    for ( iVar=0; iVar<nbvar; iVar++ ) {
+	      real_t sign=1.0;
 		
-		if ( boundary_type == BC_DIRICHLET ) {
+	      if ( boundary_type == BC_DIRICHLET ) {
 
-		  i0=2*nx+2*ghostWidth-1-i;
-		  if (iVar==IU) sign=-ONE_F;
-		  // mirror DoFs idx <-> N-1-idx
-		  Udata(i,j,k, dofMap(idx,idy,idz,iVar)) =
-		    Udata(i0,j,k, dofMap(N-1-idx,idy,idz,iVar))*sign;
+		i0=2*nx+2*ghostWidth-1-i;
+		if (iVar==IU) sign=-ONE_F;
+		// mirror DoFs idx <-> N-1-idx
+		Udata(i,j,k, dofMap(idx,idy,idz,iVar)) =
+		  Udata(i0,j,k, dofMap(N-1-idx,idy,idz,iVar))*sign;
 
-		} else if ( boundary_type == BC_NEUMANN ) {
+	      } else if ( boundary_type == BC_NEUMANN ) {
 
-		  i0=nx+ghostWidth-1;
-		  Udata(i,j,k, dofMap(idx,idy,idz,iVar)) =
-		    Udata(i0,j,k, dofMap(idx,idy,idz,iVar));
+		i0=nx+ghostWidth-1;
+		Udata(i,j,k, dofMap(idx,idy,idz,iVar)) =
+		  Udata(i0,j,k, dofMap(idx,idy,idz,iVar));
 
-		} else { // periodic
+	      } else { // periodic
 
-		  i0=i-nx;
-		  Udata(i,j,k, dofMap(idx,idy,idz,iVar)) =
-		    Udata(i0,j,k, dofMap(idx,idy,idz,iVar));
+		i0=i-nx;
+		Udata(i,j,k, dofMap(idx,idy,idz,iVar)) =
+		  Udata(i0,j,k, dofMap(idx,idy,idz,iVar));
 
-		}
+	      }
 				
-	      } // end for iVar
-	    } // end for idx
-	  } // end for idy
-	} // end for idz
+	    } // end for iVar
+	  } // end for idx
+	} // end for idy
+      } // end for idz
 
-      } // end guard
     } // end FACE_XMAX
 
     if (faceId == FACE_YMIN) {
 
-      // boundary ymin (index = i + j*isize + k*isize*ghostWidth)
-      k = index / (isize*ghostWidth);
-      j = (index - k*isize*ghostWidth) / isize;
-      i = index - j*isize - k*isize*ghostWidth;
+      // boundary ymin
 
       boundary_type = this->params.boundary_type_ymin;
       
-      if(k >= kmin && k <= kmax       && 
-	 j >= 0    && j <  ghostWidth &&
-	 i >= imin && i <= imax) {
-	
-	for (int idz=0; idz<N; ++idz) {
-	  for (int idy=0; idy<N; ++idy) {
-	    for (int idx=0; idx<N; ++idx) {
+      for (int idz=0; idz<N; ++idz) {
+	for (int idy=0; idy<N; ++idy) {
+	  for (int idx=0; idx<N; ++idx) {
 
-	      for ( iVar=0; iVar<nbvar; iVar++ ) {
-		real_t sign=1.0;
+	    for ( iVar=0; iVar<nbvar; iVar++ ) {
+	      real_t sign=1.0;
 	      
-		if ( boundary_type == BC_DIRICHLET ) {
+	      if ( boundary_type == BC_DIRICHLET ) {
 
-		  j0=2*ghostWidth-1-j;
-		  if (iVar==IV) sign=-ONE_F;
-		  // mirror DoFs idy <-> N-1-idy
-		  Udata(i,j,k, dofMap(idx,idy,idz,iVar)) =
-		    Udata(i,j0,k, dofMap(idx,N-1-idy,idz,iVar))*sign;
+		j0=2*ghostWidth-1-j;
+		if (iVar==IV) sign=-ONE_F;
+		// mirror DoFs idy <-> N-1-idy
+		Udata(i,j,k, dofMap(idx,idy,idz,iVar)) =
+		  Udata(i,j0,k, dofMap(idx,N-1-idy,idz,iVar))*sign;
 
-		} else if ( boundary_type == BC_NEUMANN ) {
+	      } else if ( boundary_type == BC_NEUMANN ) {
 
-		  j0=ghostWidth;
-		  Udata(i,j,k, dofMap(idx,idy,idz,iVar)) =
-		    Udata(i,j0,k, dofMap(idx,idy,idz,iVar));
+		j0=ghostWidth;
+		Udata(i,j,k, dofMap(idx,idy,idz,iVar)) =
+		  Udata(i,j0,k, dofMap(idx,idy,idz,iVar));
 
-		} else { // periodic
+	      } else { // periodic
 
-		  j0=ny+j;
-		  Udata(i,j,k, dofMap(idx,idy,idz,iVar)) =
-		    Udata(i,j0,k, dofMap(idx,idy,idz,iVar));
+		j0=ny+j;
+		Udata(i,j,k, dofMap(idx,idy,idz,iVar)) =
+		  Udata(i,j0,k, dofMap(idx,idy,idz,iVar));
 
-		}
+	      }
 				
-	      } // end for iVar
-	    } // end for idx
-	  } // end for idy
-	} // end for idz
+	    } // end for iVar
+	  } // end for idx
+	} // end for idy
+      } // end for idz
 
-      } // end guard
     } // end FACE_YMIN
 
     if (faceId == FACE_YMAX) {
       
-      // boundary ymax (index = i + j*isize + k*isize*ghostWidth)
+      // boundary ymax
       // same i,j,k as ymin, except translation along y-axis
-      k = index / (isize*ghostWidth);
-      j = (index - k*isize*ghostWidth) / isize;
-      i = index - j*isize - k*isize*ghostWidth;
-
-      j += (ny+ghostWidth);
 
       boundary_type = this->params.boundary_type_ymax;
       
-      if(k >= kmin           && k <= kmax              &&
-	 j >= ny+ghostWidth  && j <= ny+2*ghostWidth-1 &&
-	 i >= imin           && i <= imax) {
-	
-	for (int idz=0; idz<N; ++idz) {
-	  for (int idy=0; idy<N; ++idy) {
-	    for (int idx=0; idx<N; ++idx) {
+      for (int idz=0; idz<N; ++idz) {
+	for (int idy=0; idy<N; ++idy) {
+	  for (int idx=0; idx<N; ++idx) {
 
-	      for ( iVar=0; iVar<nbvar; iVar++ ) {
-		real_t sign=1.0;
+	    for ( iVar=0; iVar<nbvar; iVar++ ) {
+	      real_t sign=1.0;
 		
-		if ( boundary_type == BC_DIRICHLET ) {
+	      if ( boundary_type == BC_DIRICHLET ) {
 
-		  j0=2*ny+2*ghostWidth-1-j;
-		  if (iVar==IV) sign=-ONE_F;
-		  // mirror DoFs idy <-> N-1-idy
-		  Udata(i,j,k, dofMap(idx,idy,idz,iVar)) =
-		    Udata(i,j0,k, dofMap(idx,N-1-idy,idz,iVar))*sign;
+		j0=2*ny+2*ghostWidth-1-j;
+		if (iVar==IV) sign=-ONE_F;
+		// mirror DoFs idy <-> N-1-idy
+		Udata(i,j,k, dofMap(idx,idy,idz,iVar)) =
+		  Udata(i,j0,k, dofMap(idx,N-1-idy,idz,iVar))*sign;
 
-		} else if ( boundary_type == BC_NEUMANN ) {
+	      } else if ( boundary_type == BC_NEUMANN ) {
 
-		  j0=ny+ghostWidth-1;
-		  Udata(i,j,k, dofMap(idx,idy,idz,iVar)) =
-		    Udata(i,j0,k, dofMap(idx,idy,idz,iVar));
+		j0=ny+ghostWidth-1;
+		Udata(i,j,k, dofMap(idx,idy,idz,iVar)) =
+		  Udata(i,j0,k, dofMap(idx,idy,idz,iVar));
 
-		} else { // periodic
+	      } else { // periodic
 
-		  j0=j-ny;
-		  Udata(i,j,k, dofMap(idx,idy,idz,iVar)) =
-		    Udata(i,j0,k, dofMap(idx,idy,idz,iVar));
+		j0=j-ny;
+		Udata(i,j,k, dofMap(idx,idy,idz,iVar)) =
+		  Udata(i,j0,k, dofMap(idx,idy,idz,iVar));
 		  
-		}
+	      }
 				
-	      } // end for iVar
-	    } // end for idx
-	  } // end for idy
-	} // end for idz
+	    } // end for iVar
+	  } // end for idx
+	} // end for idy
+      } // end for idz
 		
-      } // end guard
     } // end FACE_YMAX
 
     if (faceId == FACE_ZMIN) {
       
-      // boundary zmin (index = i + j*isize + k*isize*jsize)
-      k = index / (isize*jsize);
-      j = (index - k*isize*jsize) / isize;
-      i = index - j*isize - k*isize*jsize;
+      // boundary zmin
 
       boundary_type = this->params.boundary_type_zmin;
       
-      if(k >= 0    && k <  ghostWidth &&
-	 j >= jmin && j <= jmax       &&
-	 i >= imin && i <= imax) {
-	
-	for (int idz=0; idz<N; ++idz) {
-	  for (int idy=0; idy<N; ++idy) {
-	    for (int idx=0; idx<N; ++idx) {
+      for (int idz=0; idz<N; ++idz) {
+	for (int idy=0; idy<N; ++idy) {
+	  for (int idx=0; idx<N; ++idx) {
 	      
-	      for ( iVar=0; iVar<nbvar; iVar++ ) {
-		real_t sign=1.0;
+	    for ( iVar=0; iVar<nbvar; iVar++ ) {
+	      real_t sign=1.0;
 	      
-		if ( boundary_type == BC_DIRICHLET ) {
+	      if ( boundary_type == BC_DIRICHLET ) {
 
-		  k0=2*ghostWidth-1-k;
-		  if (iVar==IW) sign=-ONE_F;
-		  // mirror DoFs idz <-> N-1-idz
-		  Udata(i,j,k, dofMap(idx,idy,idz,iVar)) =
-		    Udata(i,j,k0, dofMap(idx,idy,N-1-idz,iVar))*sign;
+		k0=2*ghostWidth-1-k;
+		if (iVar==IW) sign=-ONE_F;
+		// mirror DoFs idz <-> N-1-idz
+		Udata(i,j,k, dofMap(idx,idy,idz,iVar)) =
+		  Udata(i,j,k0, dofMap(idx,idy,N-1-idz,iVar))*sign;
 
-		} else if ( boundary_type == BC_NEUMANN ) {
+	      } else if ( boundary_type == BC_NEUMANN ) {
 
-		  k0=ghostWidth;
-		  Udata(i,j,k, dofMap(idx,idy,idz,iVar)) =
-		    Udata(i,j,k0, dofMap(idx,idy,idz,iVar));
+		k0=ghostWidth;
+		Udata(i,j,k, dofMap(idx,idy,idz,iVar)) =
+		  Udata(i,j,k0, dofMap(idx,idy,idz,iVar));
 
-		} else { // periodic
+	      } else { // periodic
 
-		  k0=nz+k;
-		  Udata(i,j,k, dofMap(idx,idy,idz,iVar)) =
-		    Udata(i,j,k0, dofMap(idx,idy,idz,iVar));
+		k0=nz+k;
+		Udata(i,j,k, dofMap(idx,idy,idz,iVar)) =
+		  Udata(i,j,k0, dofMap(idx,idy,idz,iVar));
 		  
-		}
+	      }
 				
-	      } // end for iVar
-	    } // end for idx
-	  } // end for idy
-	} // end for idz
+	    } // end for iVar
+	  } // end for idx
+	} // end for idy
+      } // end for idz
 
-      } // end guard
     } // end FACE_ZMIN
     
     if (faceId == FACE_ZMAX) {
       
-      // boundary zmax (index = i + j*isize + k*isize*jsize)
+      // boundary zmax
       // same i,j,k as ymin, except translation along y-axis
-      k = index / (isize*jsize);
-      j = (index - k*isize*jsize) / isize;
-      i = index - j*isize - k*isize*jsize;
-
-      k += (nz+ghostWidth);
 
       boundary_type = this->params.boundary_type_zmax;
       
-      if(k >= nz+ghostWidth && k <= nz+2*ghostWidth-1 &&
-	 j >= jmin          && j <= jmax              &&
-	 i >= imin          && i <= imax) {
-	
-	for (int idz=0; idz<N; ++idz) {
-	  for (int idy=0; idy<N; ++idy) {
-	    for (int idx=0; idx<N; ++idx) {
+      for (int idz=0; idz<N; ++idz) {
+	for (int idy=0; idy<N; ++idy) {
+	  for (int idx=0; idx<N; ++idx) {
 
-	      for ( iVar=0; iVar<nbvar; iVar++ ) {
-		real_t sign=1.0;
+	    for ( iVar=0; iVar<nbvar; iVar++ ) {
+	      real_t sign=1.0;
 	
-		if ( boundary_type == BC_DIRICHLET ) {
+	      if ( boundary_type == BC_DIRICHLET ) {
 
-		  k0=2*nz+2*ghostWidth-1-k;
-		  if (iVar==IW) sign=-ONE_F;
-		  // mirror DoFs idz <-> N-1-idz
-		  Udata(i,j,k, dofMap(idx,idy,idz,iVar)) =
-		    Udata(i,j,k0, dofMap(idx,idy,N-1-idz,iVar))*sign;
+		k0=2*nz+2*ghostWidth-1-k;
+		if (iVar==IW) sign=-ONE_F;
+		// mirror DoFs idz <-> N-1-idz
+		Udata(i,j,k, dofMap(idx,idy,idz,iVar)) =
+		  Udata(i,j,k0, dofMap(idx,idy,N-1-idz,iVar))*sign;
 
-		} else if ( boundary_type == BC_NEUMANN ) {
+	      } else if ( boundary_type == BC_NEUMANN ) {
 
-		  k0=nz+ghostWidth-1;
-		  Udata(i,j,k, dofMap(idx,idy,idz,iVar)) =
-		    Udata(i,j,k0, dofMap(idx,idy,idz,iVar));
+		k0=nz+ghostWidth-1;
+		Udata(i,j,k, dofMap(idx,idy,idz,iVar)) =
+		  Udata(i,j,k0, dofMap(idx,idy,idz,iVar));
 
-		} else { // periodic
+	      } else { // periodic
 
-		  k0=k-nz;
-		  Udata(i,j,k, dofMap(idx,idy,idz,iVar)) =
-		    Udata(i,j,k0, dofMap(idx,idy,idz,iVar));
+		k0=k-nz;
+		Udata(i,j,k, dofMap(idx,idy,idz,iVar)) =
+		  Udata(i,j,k0, dofMap(idx,idy,idz,iVar));
 
-		}
+	      }
 				
-	      } // end for iVar
-	    } // end for idx
-	  } // end for idy
-	} // end for idz
+	    } // end for iVar
+	  } // end for idx
+	} // end for idy
+      } // end for idz
 	
-      } // end guard
     } // end FACE_ZMAX
 
   } // end operator () - 3d
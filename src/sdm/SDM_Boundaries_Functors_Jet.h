@@ -3,6 +3,7 @@
 
 #include "shared/HydroParams.h"    // for HydroParams
 #include "shared/kokkos_shared.h"  // for Data arrays
+#include "shared/BoundariesFunctors.h" // for boundary_policy
 #include "shared/problems/JetParams.h"    // for Jet border condition
 
 namespace sdm {
@@ -42,11 +43,12 @@ public:
   static void apply(HydroParams         params,
                     SDM_Geometry<dim,N> sdm_geom,
                     JetParams           jparams,
-                    DataArray           Udata,
-                    int                 nbIter)
+                    DataArray           Udata)
   {
     MakeBoundariesFunctor_SDM_Jet<dim,N,faceId> functor(params, sdm_geom, jparams, Udata);
-    Kokkos::parallel_for(nbIter, functor);
+    Kokkos::parallel_for("MakeBoundariesFunctor_SDM_Jet",
+                         boundary_policy<dim>(params, faceId),
+                         functor);
   }
 
   // ================================================
@@ -57,27 +59,22 @@ public:
   //! functor for 2d 
   template<int dim_ = dim>
   KOKKOS_INLINE_FUNCTION
-  void operator()(const typename std::enable_if<dim_==2, int>::type& index) const
+  void operator()(const typename std::enable_if<dim_==2, int>::type& i,
+                  const int& j) const
   {
 
     const int nx = this->params.nx;
     const int ny = this->params.ny;
     
     const int ghostWidth = this->params.ghostWidth;
-    const int nbvar = this->params.nbvar;
-    
-    const int imin = this->params.imin;
-    const int imax = this->params.imax;
-    
-    const int jmin = this->params.jmin;
-    const int jmax = this->params.jmax;
+    const int nbvar = NbVar<dim>::value;
     
 #ifdef USE_MPI
-    //const int i_mpi = this->params.myMpiPos[IX];
-    const int j_mpi = this->params.myMpiPos[IY];
+    //const int i_offset = this->params.myOffset[IX];
+    const int j_offset = this->params.myOffset[IY];
 #else
-    //const int i_mpi = 0;
-    const int j_mpi = 0;
+    //const int i_offset = 0;
+    const int j_offset = 0;
 #endif
 
     //const real_t xmin = this->params.xmin;
@@ -101,8 +98,6 @@ public:
     const real_t pos_jet   = jparams.pos_jet;
     const real_t width_jet = jparams.width_jet;
     
-    int i,j;
-    
     //int boundary_type;
     
     int i0, j0;
@@ -111,65 +106,49 @@ public:
       
       // boundary xmin (inflow / outflow)
 
-      j = index / ghostWidth;
-      i = index - j*ghostWidth;
-      
-      if(j >= jmin and j <= jmax    and
-	 i >= 0    and i <ghostWidth) {
-	  
-	for (int idy=0; idy<N; ++idy) {
-	  for (int idx=0; idx<N; ++idx) {
+      for (int idy=0; idy<N; ++idy) {
+	for (int idx=0; idx<N; ++idx) {
 
-	    real_t y = ymin + (j+ny*j_mpi-ghostWidth)*dy;
-	    y += this->sdm_geom.solution_pts_1d(idy) * dy;
+	  real_t y = ymin + (j+j_offset-ghostWidth)*dy;
+	  y += this->sdm_geom.solution_pts_1d(idy) * dy;
 
-	    if (y > pos_jet - 0.5*width_jet and
-		y < pos_jet + 0.5*width_jet ) { // jet / inflow
+	  if (y > pos_jet - 0.5*width_jet and
+	      y < pos_jet + 0.5*width_jet ) { // jet / inflow
 	      
-	      Udata(i,j,dofMap(idx,idy,0,ID)) = rho1;
-	      Udata(i,j,dofMap(idx,idy,0,IE)) = e_tot1;
-	      Udata(i,j,dofMap(idx,idy,0,IU)) = rho_u1;
-	      Udata(i,j,dofMap(idx,idy,0,IV)) = rho_v1;
+	    Udata(i,j,dofMap(idx,idy,0,ID)) = rho1;
+	    Udata(i,j,dofMap(idx,idy,0,IE)) = e_tot1;
+	    Udata(i,j,dofMap(idx,idy,0,IU)) = rho_u1;
+	    Udata(i,j,dofMap(idx,idy,0,IV)) = rho_v1;
 
-	    } else  { // bulk
+	  } else  { // bulk
 
-	      Udata(i,j,dofMap(idx,idy,0,ID)) = rho2;
-	      Udata(i,j,dofMap(idx,idy,0,IE)) = e_tot2;
-	      Udata(i,j,dofMap(idx,idy,0,IU)) = rho_u2;
-	      Udata(i,j,dofMap(idx,idy,0,IV)) = rho_v2;
+	    Udata(i,j,dofMap(idx,idy,0,ID)) = rho2;
+	    Udata(i,j,dofMap(idx,idy,0,IE)) = e_tot2;
+	    Udata(i,j,dofMap(idx,idy,0,IU)) = rho_u2;
+	    Udata(i,j,dofMap(idx,idy,0,IV)) = rho_v2;
 
-	    }
+	  }
 	    
-	  } // end idx
-	} // end idy
-	
-      }
+	} // end idx
+      } // end idy
       
     } // end FACE_XMIN
 
     if (faceId == FACE_XMAX) {
       
       // boundary xmax (outflow)
-      j = index / ghostWidth;
-      i = index - j*ghostWidth;
-      i += (nx+ghostWidth);
 
-      if(j >= jmin          and j <= jmax             and
-	 i >= nx+ghostWidth and i <= nx+2*ghostWidth-1) {
-	
-	i0=nx+ghostWidth-1;  
-
-	for (int idy=0; idy<N; ++idy) {
-	  for (int idx=0; idx<N; ++idx) {
-	    for ( int iVar=0; iVar<nbvar; iVar++ ) {
-	      // copy Dof from cell i0,j into cell i,j with a mirror
-	      Udata(i,j,dofMap(idx,idy,0,iVar)) =
-		Udata(i0,j,dofMap(N-1-idx,idy,0,iVar));
-	    }
-	  } // end for idx
-	} // end for idy
-	  
-      }
+      i0=nx+ghostWidth-1;  
+
+      for (int idy=0; idy<N; ++idy) {
+	for (int idx=0; idx<N; ++idx) {
+	  for ( int iVar=0; iVar<nbvar; iVar++ ) {
+	    // copy Dof from cell i0,j into cell i,j with a mirror
+	    Udata(i,j,dofMap(idx,idy,0,iVar)) =
+	      Udata(i0,j,dofMap(N-1-idx,idy,0,iVar));
+	  }
+	} // end for idx
+      } // end for idy
 	
     } // end FACE_XMAX
     
@@ -177,26 +156,18 @@ public:
       
       // boundary ymin : outflow
 
-      i = index / ghostWidth;
-      j = index - i*ghostWidth;
-      
-      if(i >= imin and i <= imax    and
-	 j >= 0    and j <ghostWidth) {
-
-	j0=ghostWidth;
+      j0=ghostWidth;
 	
-	for (int idy=0; idy<N; ++idy) {
-	  for (int idx=0; idx<N; ++idx) {
+      for (int idy=0; idy<N; ++idy) {
+	for (int idx=0; idx<N; ++idx) {
 	    
-	    for ( int iVar=0; iVar<nbvar; iVar++ ) {
-	      Udata(i,j,dofMap(idx,idy,0,iVar)) =
-		Udata(i,j0,dofMap(idx,/*N-1-*/idy,0,iVar));
-	    }
+	  for ( int iVar=0; iVar<nbvar; iVar++ ) {
+	    Udata(i,j,dofMap(idx,idy,0,iVar)) =
+	      Udata(i,j0,dofMap(idx,/*N-1-*/idy,0,iVar));
+	  }
 	    
-	  } // end for idx
-	} // end for idy
-	
-      } // end if i,j
+	} // end for idx
+      } // end for idy
       
     } // end FACE_YMIN
 
@@ -204,27 +175,18 @@ public:
 
       // boundary ymax : outflow
 
-      i = index / ghostWidth;
-      j = index - i*ghostWidth;
-      j += (ny+ghostWidth);
-      
-      if(i >= imin          and i <= imax              and
-	 j >= ny+ghostWidth and j <= ny+2*ghostWidth-1) {
-	
-	j0=ny+ghostWidth-1;
+      j0=ny+ghostWidth-1;
 	
-	for (int idy=0; idy<N; ++idy) {
-	  for (int idx=0; idx<N; ++idx) {
+      for (int idy=0; idy<N; ++idy) {
+	for (int idx=0; idx<N; ++idx) {
 	    
-	    for ( int iVar=0; iVar<nbvar; iVar++ ) {
-	      Udata(i,j,dofMap(idx,idy,0,iVar)) =
-		Udata(i,j0,dofMap(idx,/*N-1-*/idy,0,iVar));
-	    }
+	  for ( int iVar=0; iVar<nbvar; iVar++ ) {
+	    Udata(i,j,dofMap(idx,idy,0,iVar)) =
+	      Udata(i,j0,dofMap(idx,/*N-1-*/idy,0,iVar));
+	  }
 
-	  } // end idx
-	} // end idy
-	
-      } // end if i,j
+	} // end idx
+      } // end idy
       
     } // end FACE_YMAX
 
@@ -238,7 +200,9 @@ public:
   //! functor for 3d 
   template<int dim_ = dim>
   KOKKOS_INLINE_FUNCTION
-  void operator()(const typename std::enable_if<dim_==3, int>::type& index) const
+  void operator()(const typename std::enable_if<dim_==3, int>::type& i,
+                  const int& j,
+                  const int& k) const
   {
 
     /* PARTIALLY UNIMPLEMENTED */
@@ -247,30 +211,19 @@ public:
     const int ny = this->params.ny;
     const int nz = this->params.nz;
     
-    const int isize = this->params.isize;
-    const int jsize = this->params.jsize;
     //const int ksize = this->params.ksize;
 
     const int ghostWidth = this->params.ghostWidth;
-    const int nbvar = this->params.nbvar;
-    
-    const int imin = this->params.imin;
-    const int imax = this->params.imax;
-    
-    const int jmin = this->params.jmin;
-    const int jmax = this->params.jmax;
+    const int nbvar = NbVar<dim>::value;
     
-    const int kmin = this->params.kmin;
-    const int kmax = this->params.kmax;
-
 #ifdef USE_MPI
-    //const int i_mpi = this->params.myMpiPos[IX];
-    const int j_mpi = this->params.myMpiPos[IY];
-    const int k_mpi = this->params.myMpiPos[IZ];
+    //const int i_offset = this->params.myOffset[IX];
+    const int j_offset = this->params.myOffset[IY];
+    const int k_offset = this->params.myOffset[IZ];
 #else
-    //const int i_mpi = 0;
-    const int j_mpi = 0;
-    const int k_mpi = 0;
+    //const int i_offset = 0;
+    const int j_offset = 0;
+    const int k_offset = 0;
 #endif
 
     //const real_t xmin = this->params.xmin;
@@ -298,8 +251,6 @@ public:
     const real_t pos_jet   = jparams.pos_jet;
     const real_t width_jet = jparams.width_jet;
     
-    int i,j,k;
-    
     //int boundary_type;
     
     int i0, j0, k0;
@@ -308,85 +259,65 @@ public:
       
       // boundary xmin (inflow / outflow)
       
-      // boundary xmin (index = i + j * ghostWidth + k * ghostWidth*jsize)
-      k = index / (ghostWidth*jsize);
-      j = (index - k*ghostWidth*jsize) / ghostWidth;
-      i = index - j*ghostWidth - k*ghostWidth*jsize;
+      // boundary xmin
       
-      if(k >= kmin and k <= kmax    and
-	 j >= jmin and j <= jmax    and
-	 i >= 0    and i <ghostWidth) {
-	
-	for (int idz=0; idz<N; ++idz) {
-	  for (int idy=0; idy<N; ++idy) {
-	    for (int idx=0; idx<N; ++idx) {
+      for (int idz=0; idz<N; ++idz) {
+	for (int idy=0; idy<N; ++idy) {
+	  for (int idx=0; idx<N; ++idx) {
 	      
-	      real_t y = ymin + (j+ny*j_mpi-ghostWidth)*dy;
-	      real_t z = zmin + (k+nz*k_mpi-ghostWidth)*dz;
+	    real_t y = ymin + (j+j_offset-ghostWidth)*dy;
+	    real_t z = zmin + (k+k_offset-ghostWidth)*dz;
 	      
-	      y += this->sdm_geom.solution_pts_1d(idy) * dy;
-	      z += this->sdm_geom.solution_pts_1d(idz) * dz;
+	    y += this->sdm_geom.solution_pts_1d(idy) * dy;
+	    z += this->sdm_geom.solution_pts_1d(idz) * dz;
 	      
-	      real_t radius2 =
-		(y-pos_jet)*(y-pos_jet) +
-		(z-pos_jet)*(z-pos_jet) ;
+	    real_t radius2 =
+	      (y-pos_jet)*(y-pos_jet) +
+	      (z-pos_jet)*(z-pos_jet) ;
 	      
-	      if (radius2 < 0.25*width_jet*width_jet ) { // jet / inflow
+	    if (radius2 < 0.25*width_jet*width_jet ) { // jet / inflow
 		
-		Udata(i,j,k,dofMap(idx,idy,idz,ID)) = rho1;
-		Udata(i,j,k,dofMap(idx,idy,idz,IE)) = e_tot1;
-		Udata(i,j,k,dofMap(idx,idy,idz,IU)) = rho_u1;
-		Udata(i,j,k,dofMap(idx,idy,idz,IV)) = rho_v1;
-		Udata(i,j,k,dofMap(idx,idy,idz,IW)) = rho_w1;
+	      Udata(i,j,k,dofMap(idx,idy,idz,ID)) = rho1;
+	      Udata(i,j,k,dofMap(idx,idy,idz,IE)) = e_tot1;
+	      Udata(i,j,k,dofMap(idx,idy,idz,IU)) = rho_u1;
+	      Udata(i,j,k,dofMap(idx,idy,idz,IV)) = rho_v1;
+	      Udata(i,j,k,dofMap(idx,idy,idz,IW)) = rho_w1;
 		
-	      } else  { // bulk
+	    } else  { // bulk
 		
-		Udata(i,j,k,dofMap(idx,idy,idz,ID)) = rho2;
-		Udata(i,j,k,dofMap(idx,idy,idz,IE)) = e_tot2;
-		Udata(i,j,k,dofMap(idx,idy,idz,IU)) = rho_u2;
-		Udata(i,j,k,dofMap(idx,idy,idz,IV)) = rho_v2;
-		Udata(i,j,k,dofMap(idx,idy,idz,IW)) = rho_w2;
+	      Udata(i,j,k,dofMap(idx,idy,idz,ID)) = rho2;
+	      Udata(i,j,k,dofMap(idx,idy,idz,IE)) = e_tot2;
+	      Udata(i,j,k,dofMap(idx,idy,idz,IU)) = rho_u2;
+	      Udata(i,j,k,dofMap(idx,idy,idz,IV)) = rho_v2;
+	      Udata(i,j,k,dofMap(idx,idy,idz,IW)) = rho_w2;
 		
-	      }
+	    }
 	      
-	    } // end idx
-	  } // end idy
-	} // end idz
-	
-      } // end if inside border
+	  } // end idx
+	} // end idy
+      } // end idz
       
     } // end FACE_XMIN
     
     if (faceId == FACE_XMAX) {
       
       // boundary xmax (outflow)
-      // boundary xmax (index = i + j *ghostWidth + k * ghostWidth*jsize)
+      // boundary xmax
       // same i,j,k as xmin, except translation along x-axis
-      k = index / (ghostWidth*jsize);
-      j = (index - k*ghostWidth*jsize) / ghostWidth;
-      i = index - j*ghostWidth - k*ghostWidth*jsize;
 
-      i += (nx+ghostWidth);
-      
-      if(k >= kmin          and k <= kmax and
-	 j >= jmin          and j <= jmax and
-	 i >= nx+ghostWidth and i <= nx+2*ghostWidth-1) {
-	
-	i0=nx+ghostWidth-1;
+      i0=nx+ghostWidth-1;
 	
-	for (int idz=0; idz<N; ++idz) {
-	  for (int idy=0; idy<N; ++idy) {
-	    for (int idx=0; idx<N; ++idx) {
-	      for ( int iVar=0; iVar<nbvar; iVar++ ) {
-		// copy Dof from cell i0,j,k into cell i,j,k with a mirror
-		Udata(i,j,k,dofMap(idx,idy,idz,iVar)) =
-		  Udata(i0,j,k,dofMap(idx,idy,idz,iVar));
-	      }
-	    } // end for idx
-	  } // end for idy
-	} // end for idz
-	
-      } // end if inside border
+      for (int idz=0; idz<N; ++idz) {
+	for (int idy=0; idy<N; ++idy) {
+	  for (int idx=0; idx<N; ++idx) {
+	    for ( int iVar=0; iVar<nbvar; iVar++ ) {
+	      // copy Dof from cell i0,j,k into cell i,j,k with a mirror
+	      Udata(i,j,k,dofMap(idx,idy,idz,iVar)) =
+		Udata(i0,j,k,dofMap(idx,idy,idz,iVar));
+	    }
+	  } // end for idx
+	} // end for idy
+      } // end for idz
       
     } // end FACE_XMAX
 
@@ -394,30 +325,20 @@ public:
       
       // boundary ymin : outflow
 
-      k = index / (isize*ghostWidth);
-      j = (index - k*isize*ghostWidth) / isize;
-      i = index - j*isize - k*isize*ghostWidth;
-      
-      if(k >= kmin and k <= kmax     and
-	 j >= 0    and j <ghostWidth and 
-	 i >= imin and i <= imax    ) {
-
-	j0=ghostWidth;
+      j0=ghostWidth;
 	
-	for (int idz=0; idz<N; ++idz) {
-	  for (int idy=0; idy<N; ++idy) {
-	    for (int idx=0; idx<N; ++idx) {
+      for (int idz=0; idz<N; ++idz) {
+	for (int idy=0; idy<N; ++idy) {
+	  for (int idx=0; idx<N; ++idx) {
 	      
-	      for ( int iVar=0; iVar<nbvar; iVar++ ) {
-		Udata(i,j,k,dofMap(idx,idy,idz,iVar)) =
-		  Udata(i,j0,k,dofMap(idx,idy,idz,iVar));
-	      }
+	    for ( int iVar=0; iVar<nbvar; iVar++ ) {
+	      Udata(i,j,k,dofMap(idx,idy,idz,iVar)) =
+		Udata(i,j0,k,dofMap(idx,idy,idz,iVar));
+	    }
 	      
-	    } // end for idx
-	  } // end for idy
-	} // end for idz
-	
-      } // end if inside border
+	  } // end for idx
+	} // end for idy
+      } // end for idz
       
     } // end FACE_YMIN
 
@@ -425,32 +346,20 @@ public:
 
       // boundary ymax : outflow
 
-      k = index / (isize*ghostWidth);
-      j = (index - k*isize*ghostWidth) / isize;
-      i = index - j*isize - k*isize*ghostWidth;
-
-      j += (ny+ghostWidth);
-      
-      if(k >= kmin          and k <= kmax              and
-	 j >= ny+ghostWidth and j <= ny+2*ghostWidth-1 and
-	 i >= imin          and i <= imax              ) {
+      j0=ny+ghostWidth-1;
 	
-	j0=ny+ghostWidth-1;
-	
-	for (int idz=0; idz<N; ++idz) {
-	  for (int idy=0; idy<N; ++idy) {
-	    for (int idx=0; idx<N; ++idx) {
+      for (int idz=0; idz<N; ++idz) {
+	for (int idy=0; idy<N; ++idy) {
+	  for (int idx=0; idx<N; ++idx) {
 	      
-	      for ( int iVar=0; iVar<nbvar; iVar++ ) {
-		Udata(i,j,k,dofMap(idx,idy,idz,iVar)) =
-		  Udata(i,j0,k,dofMap(idx,idy,idz,iVar));
-	      }
+	    for ( int iVar=0; iVar<nbvar; iVar++ ) {
+	      Udata(i,j,k,dofMap(idx,idy,idz,iVar)) =
+		Udata(i,j0,k,dofMap(idx,idy,idz,iVar));
+	    }
 	      
-	    } // end idx
-	  } // end idy
-	} // end idz
-	
-      } // end if inside border
+	  } // end idx
+	} // end idy
+      } // end idz
       
     } // end FACE_YMAX
 
@@ -458,30 +367,20 @@ public:
       
       // boundary zmin : outflow
 
-      k = index / (isize*jsize);
-      j = (index - k*isize*jsize) / isize;
-      i = index - j*isize - k*isize*jsize;
-      
-      if(k >= 0    and k <  ghostWidth and
-	 j >= jmin and j <= jmax       and
-	 i >= imin and i <= imax) {
-
-	k0=ghostWidth;
+      k0=ghostWidth;
 	
-	for (int idz=0; idz<N; ++idz) {
-	  for (int idy=0; idy<N; ++idy) {
-	    for (int idx=0; idx<N; ++idx) {
+      for (int idz=0; idz<N; ++idz) {
+	for (int idy=0; idy<N; ++idy) {
+	  for (int idx=0; idx<N; ++idx) {
 	      
-	      for ( int iVar=0; iVar<nbvar; iVar++ ) {
-		Udata(i,j,k,dofMap(idx,idy,idz,iVar)) =
-		  Udata(i,j,k0,dofMap(idx,idy,idz,iVar));
-	      }
+	    for ( int iVar=0; iVar<nbvar; iVar++ ) {
+	      Udata(i,j,k,dofMap(idx,idy,idz,iVar)) =
+		Udata(i,j,k0,dofMap(idx,idy,idz,iVar));
+	    }
 	      
-	    } // end for idx
-	  } // end for idy
-	} // end for idz
-	
-      } // end if inside border
+	  } // end for idx
+	} // end for idy
+      } // end for idz
       
     } // end FACE_ZMIN
 
@@ -489,32 +388,20 @@ public:
 
       // boundary zmax : outflow
       
-      k = index / (isize*jsize);
-      j = (index - k*isize*jsize) / isize;
-      i = index - j*isize - k*isize*jsize;
-
-      k += (nz+ghostWidth);
-      
-      if(k >= nz+ghostWidth and k <= nz+2*ghostWidth-1 and
-	 j >= jmin          and j <= jmax              and
-	 i >= imin          and i <= imax) {
-	
-	k0=nz+ghostWidth-1;
+      k0=nz+ghostWidth-1;
 	
-	for (int idz=0; idz<N; ++idz) {
-	  for (int idy=0; idy<N; ++idy) {
-	    for (int idx=0; idx<N; ++idx) {
+      for (int idz=0; idz<N; ++idz) {
+	for (int idy=0; idy<N; ++idy) {
+	  for (int idx=0; idx<N; ++idx) {
 	      
-	      for ( int iVar=0; iVar<nbvar; iVar++ ) {
-		Udata(i,j,k,dofMap(idx,idy,idz,iVar)) =
-		  Udata(i,j,k0,dofMap(idx,idy,idz,iVar));
-	      }
+	    for ( int iVar=0; iVar<nbvar; iVar++ ) {
+	      Udata(i,j,k,dofMap(idx,idy,idz,iVar)) =
+		Udata(i,j,k0,dofMap(idx,idy,idz,iVar));
+	    }
 	      
-	    } // end idx
-	  } // end idy
-	} // end idz
-	
-      } // end if inside border
+	  } // end idx
+	} // end idy
+      } // end idz
       
     } // end FACE_ZMAX
     
@@ -3,6 +3,7 @@
 
 #include "shared/HydroParams.h"    // for HydroParams
 #include "shared/kokkos_shared.h"  // for Data arrays
+#include "shared/BoundariesFunctors.h" // for boundary_policy
 #include "shared/problems/WedgeParams.h"    // for Wedge border condition
 
 namespace sdm {
@@ -39,11 +40,12 @@ public:
   static void apply(HydroParams         params,
                     SDM_Geometry<dim,N> sdm_geom,
                     WedgeParams         wparams,
-                    DataArray           Udata,
-                    int                 nbIter)
+                    DataArray           Udata)
   {
     MakeBoundariesFunctor_SDM_Wedge<dim,N,faceId> functor(params, sdm_geom, wparams, Udata);
-    Kokkos::parallel_for(nbIter, functor);
+    Kokkos::parallel_for("MakeBoundariesFunctor_SDM_Wedge",
+                         boundary_policy<dim>(params, faceId),
+                         functor);
   }
 
   // ================================================
@@ -54,27 +56,22 @@ public:
   //! functor for 2d 
   template<int dim_ = dim>
   KOKKOS_INLINE_FUNCTION
-  void operator()(const typename std::enable_if<dim_==2, int>::type& index) const
+  void operator()(const typename std::enable_if<dim_==2, int>::type& i,
+                  const int& j) const
   {
 
     const int nx = this->params.nx;
     const int ny = this->params.ny;
     
     const int ghostWidth = this->params.ghostWidth;
-    const int nbvar = this->params.nbvar;
-    
-    const int imin = this->params.imin;
-    const int imax = this->params.imax;
-    
-    const int jmin = this->params.jmin;
-    const int jmax = this->params.jmax;
+    const int nbvar = NbVar<dim>::value;
     
 #ifdef USE_MPI
-    const int i_mpi = this->params.myMpiPos[IX];
-    const int j_mpi = this->params.myMpiPos[IY];
+    const int i_offset = this->params.myOffset[IX];
+    const int j_offset = this->params.myOffset[IY];
 #else
-    const int i_mpi = 0;
-    const int j_mpi = 0;
+    const int i_offset = 0;
+    const int j_offset = 0;
 #endif
 
     const real_t xmin = this->params.xmin;
@@ -93,8 +90,6 @@ public:
     const real_t rho_v2 = wparams.rho_v2;
     const real_t e_tot2 = wparams.e_tot2;
 
-    int i,j;
-    
     //int boundary_type;
     
     int i0, j0;
@@ -103,48 +98,32 @@ public:
       
       // boundary xmin (inflow)
 
-      j = index / ghostWidth;
-      i = index - j*ghostWidth;
-      
-      if(j >= jmin && j <= jmax    &&
-	 i >= 0    && i <ghostWidth) {
-	  
-	for (int idy=0; idy<N; ++idy) {
-	  for (int idx=0; idx<N; ++idx) {
-	    Udata(i,j,dofMap(idx,idy,0,ID)) = rho1;
-	    Udata(i,j,dofMap(idx,idy,0,IE)) = e_tot1;
-	    Udata(i,j,dofMap(idx,idy,0,IU)) = rho_u1;
-	    Udata(i,j,dofMap(idx,idy,0,IV)) = rho_v1;
-	  } // end idx
-	} // end idy
-	
-      }
+      for (int idy=0; idy<N; ++idy) {
+	for (int idx=0; idx<N; ++idx) {
+	  Udata(i,j,dofMap(idx,idy,0,ID)) = rho1;
+	  Udata(i,j,dofMap(idx,idy,0,IE)) = e_tot1;
+	  Udata(i,j,dofMap(idx,idy,0,IU)) = rho_u1;
+	  Udata(i,j,dofMap(idx,idy,0,IV)) = rho_v1;
+	} // end idx
+      } // end idy
       
     } // end FACE_XMIN
 
     if (faceId == FACE_XMAX) {
       
       // boundary xmax (outflow)
-      j = index / ghostWidth;
-      i = index - j*ghostWidth;
-      i += (nx+ghostWidth);
 
-      if(j >= jmin          && j <= jmax             &&
-	 i >= nx+ghostWidth && i <= nx+2*ghostWidth-1) {
-	
-	i0=nx+ghostWidth-1;  
-
-	for (int idy=0; idy<N; ++idy) {
-	  for (int idx=0; idx<N; ++idx) {
-	    for ( int iVar=0; iVar<nbvar; iVar++ ) {
-	      // copy Dof from cell i0,j into cell i,j with a mirror
-	      Udata(i,j,dofMap(idx,idy,0,iVar)) =
-		Udata(i0,j,dofMap(N-1-idx,idy,0,iVar));
-	    }
-	  } // end for idx
-	} // end for idy
-	  
-      }
+      i0=nx+ghostWidth-1;  
+
+      for (int idy=0; idy<N; ++idy) {
+	for (int idx=0; idx<N; ++idx) {
+	  for ( int iVar=0; iVar<nbvar; iVar++ ) {
+	    // copy Dof from cell i0,j into cell i,j with a mirror
+	    Udata(i,j,dofMap(idx,idy,0,iVar)) =
+	      Udata(i0,j,dofMap(N-1-idx,idy,0,iVar));
+	  }
+	} // end for idx
+      } // end for idy
 	
     } // end FACE_XMAX
     
@@ -154,45 +133,37 @@ public:
       // if (x <  x_f) inflow
       // else          reflective
 
-      i = index / ghostWidth;
-      j = index - i*ghostWidth;
-      
-      if(i >= imin && i <= imax    &&
-	 j >= 0    && j <ghostWidth) {
-
-	  for (int idy=0; idy<N; ++idy) {
-	    for (int idx=0; idx<N; ++idx) {
+	for (int idy=0; idy<N; ++idy) {
+	  for (int idx=0; idx<N; ++idx) {
 
-	      // lower left corner
-	      real_t x = xmin + (i+nx*i_mpi-ghostWidth)*dx;
-	      x += this->sdm_geom.solution_pts_1d(idx) * dx;
+	    // lower left corner
+	    real_t x = xmin + (i+i_offset-ghostWidth)*dx;
+	    x += this->sdm_geom.solution_pts_1d(idx) * dx;
 
-	      if (x < wparams.x_f) { // inflow
+	    if (x < wparams.x_f) { // inflow
 		
-		Udata(i,j,dofMap(idx,idy,0,ID)) = rho1;
-		Udata(i,j,dofMap(idx,idy,0,IE)) = e_tot1;
-		Udata(i,j,dofMap(idx,idy,0,IU)) = rho_u1;
-		Udata(i,j,dofMap(idx,idy,0,IV)) = rho_v1;
+	      Udata(i,j,dofMap(idx,idy,0,ID)) = rho1;
+	      Udata(i,j,dofMap(idx,idy,0,IE)) = e_tot1;
+	      Udata(i,j,dofMap(idx,idy,0,IU)) = rho_u1;
+	      Udata(i,j,dofMap(idx,idy,0,IV)) = rho_v1;
 	  
-	      } else { // reflective
+	    } else { // reflective
 		
-		// mirror DoFs idy <-> N-1-idy
+	      // mirror DoFs idy <-> N-1-idy
 		
-		real_t sign=1.0;
-		j0=2*ghostWidth-1-j;
+	      real_t sign=1.0;
+	      j0=2*ghostWidth-1-j;
 		
-		for ( int iVar=0; iVar<nbvar; iVar++ ) {
-		  if (iVar==IV) sign=-ONE_F;
-		  Udata(i,j,dofMap(idx,idy,0,iVar)) =
-		    Udata(i,j0,dofMap(idx,N-1-idy,0,iVar))*sign;
-		}
+	      for ( int iVar=0; iVar<nbvar; iVar++ ) {
+		if (iVar==IV) sign=-ONE_F;
+		Udata(i,j,dofMap(idx,idy,0,iVar)) =
+		  Udata(i,j0,dofMap(idx,N-1-idy,0,iVar))*sign;
+	      }
 
-	      } // end inflow / reflective
+	    } // end inflow / reflective
 
-	    } // end for idx
-	  } // end for idy
-	
-      } // end if i,j
+	  } // end for idx
+	} // end for idy
       
     } // end FACE_YMIN
 
@@ -202,51 +173,42 @@ public:
       // if (x <  x_f + y/slope_f + delta_x) inflow
       // else                                outflow
 
-      i = index / ghostWidth;
-      j = index - i*ghostWidth;
-      j += (ny+ghostWidth);
-      
-      if(i >= imin          && i <= imax              &&
-	 j >= ny+ghostWidth && j <= ny+2*ghostWidth-1) {
-	
-	for (int idy=0; idy<N; ++idy) {
-	  for (int idx=0; idx<N; ++idx) {
+      for (int idy=0; idy<N; ++idy) {
+	for (int idx=0; idx<N; ++idx) {
 	    
-	    // lower left corner
-	    real_t x = xmin + (i+nx*i_mpi-ghostWidth)*dx;
-	    real_t y = ymin + (j+ny*j_mpi-ghostWidth)*dy;
+	  // lower left corner
+	  real_t x = xmin + (i+i_offset-ghostWidth)*dx;
+	  real_t y = ymin + (j+j_offset-ghostWidth)*dy;
 	    
-	    x += this->sdm_geom.solution_pts_1d(idx) * dx;
-	    y += this->sdm_geom.solution_pts_1d(idy) * dy;
+	  x += this->sdm_geom.solution_pts_1d(idx) * dx;
+	  y += this->sdm_geom.solution_pts_1d(idy) * dy;
 
-	    if (x < wparams.x_f + y/wparams.slope_f + wparams.delta_x) { // inflow
+	  if (x < wparams.x_f + y/wparams.slope_f + wparams.delta_x) { // inflow
 
-	      Udata(i,j,dofMap(idx,idy,0,ID)) = rho1;
-	      Udata(i,j,dofMap(idx,idy,0,IP)) = e_tot1;
-	      Udata(i,j,dofMap(idx,idy,0,IU)) = rho_u1;
-	      Udata(i,j,dofMap(idx,idy,0,IV)) = rho_v1;
+	    Udata(i,j,dofMap(idx,idy,0,ID)) = rho1;
+	    Udata(i,j,dofMap(idx,idy,0,IP)) = e_tot1;
+	    Udata(i,j,dofMap(idx,idy,0,IU)) = rho_u1;
+	    Udata(i,j,dofMap(idx,idy,0,IV)) = rho_v1;
 	      
-	    } else { // outflow
+	  } else { // outflow
 	  
-	      // j0=ny+ghostWidth-1;
+	    // j0=ny+ghostWidth-1;
 	      
-	      // // copy the last Dof from cell i,j0 into every Dof of cell i,j
-	      // for ( int iVar=0; iVar<nbvar; iVar++ ) {
-	      // 	Udata(i,j,dofMap(idx,idy,0,iVar)) =
-	      // 	  Udata(i,j0,dofMap(idx,N-1-idy,0,iVar));
-	      // }
+	    // // copy the last Dof from cell i,j0 into every Dof of cell i,j
+	    // for ( int iVar=0; iVar<nbvar; iVar++ ) {
+	    // 	Udata(i,j,dofMap(idx,idy,0,iVar)) =
+	    // 	  Udata(i,j0,dofMap(idx,N-1-idy,0,iVar));
+	    // }
 	      
-	      Udata(i,j,dofMap(idx,idy,0,ID)) = rho2;
-	      Udata(i,j,dofMap(idx,idy,0,IP)) = e_tot2;
-	      Udata(i,j,dofMap(idx,idy,0,IU)) = rho_u2;
-	      Udata(i,j,dofMap(idx,idy,0,IV)) = rho_v2;
+	    Udata(i,j,dofMap(idx,idy,0,ID)) = rho2;
+	    Udata(i,j,dofMap(idx,idy,0,IP)) = e_tot2;
+	    Udata(i,j,dofMap(idx,idy,0,IU)) = rho_u2;
+	    Udata(i,j,dofMap(idx,idy,0,IV)) = rho_v2;
 
-	    } // end inflow / outflow
+	  } // end inflow / outflow
 
-	  } // end idx
-	} // end idy
-	
-      } // end if i,j
+	} // end idx
+      } // end idy
       
     } // end FACE_YMAX
 
@@ -260,7 +222,9 @@ public:
   //! functor for 3d 
   template<int dim_ = dim>
   KOKKOS_INLINE_FUNCTION
-  void operator()(const typename std::enable_if<dim_==3, int>::type& index) const
+  void operator()(const typename std::enable_if<dim_==3, int>::type& i,
+                  const int& j,
+                  const int& k) const
   {
 
     /* UNIMPLEMENTED */
@@ -62,12 +62,16 @@ public:
                       DataArray         Udata2,
                       int               varId)
   {
-    int64_t nbCells = params.isize * params.jsize;
+    const int ghostWidth = params.ghostWidth;
 
     real_t error = 0;
     Compute_Error_Functor_2d<N,norm> functor(params, sdm_geom,
                                              Udata1, Udata2, varId);
-    Kokkos::parallel_reduce(nbCells, functor, error);
+    Kokkos::parallel_reduce("Compute_Error_Functor_2d",
+                            md_policy_2d(ghostWidth, ghostWidth,
+                                         params.isize-ghostWidth, params.jsize-ghostWidth,
+                                         params.mdrange_tile),
+                            functor, error);
     return error;
   }
 
@@ -98,38 +102,26 @@ public:
   // ================================================
   //! functor for 2d
   KOKKOS_INLINE_FUNCTION
-  void operator()(const int& index,
-		  real_t &sum) const
+  void operator()(const int& i,
+                  const int& j,
+                  real_t &sum) const
   {
-    const int isize = this->params.isize;
-    const int jsize = this->params.jsize;
-    const int ghostWidth = this->params.ghostWidth;
+    // loop over current cell DoF solution points
+    for (int idy=0; idy<N; ++idy) {
+      for (int idx=0; idx<N; ++idx) {
 
-    // local cell index
-    int i,j;
-    index2coord(index,i,j,isize,jsize);
-
-    if(j >= ghostWidth && j < jsize - ghostWidth &&
-       i >= ghostWidth && i < isize - ghostWidth) {
-
-      // loop over current cell DoF solution points
-      for (int idy=0; idy<N; ++idy) {
-	for (int idx=0; idx<N; ++idx) {
-
-	  // get local conservative variable
-	  real_t tmp1 = Udata1(i,j, dofMap(idx,idy,0,varId));
-	  real_t tmp2 = Udata2(i,j, dofMap(idx,idy,0,varId));
+	// get local conservative variable
+	real_t tmp1 = Udata1(i,j, dofMap(idx,idy,0,varId));
+	real_t tmp2 = Udata2(i,j, dofMap(idx,idy,0,varId));
           
-	  if (norm == NORM_L1) {
-	    sum += fabs(tmp1-tmp2);
-	  } else {
-	    sum += (tmp1-tmp2)*(tmp1-tmp2);
-	  }
+	if (norm == NORM_L1) {
+	  sum += fabs(tmp1-tmp2);
+	} else {
+	  sum += (tmp1-tmp2)*(tmp1-tmp2);
+	}
 	  
-	} // end for idx
-      } // end for idy
-      
-    } // end guard - ghostcells
+      } // end for idx
+    } // end for idy
 
   } // end operator () - 2d
   
@@ -193,12 +185,17 @@ public:
                       DataArray         Udata2,
                       int               varId)
   {
-    int64_t nbCells = params.isize * params.jsize * params.ksize;
+    const int ghostWidth = params.ghostWidth;
 
     real_t error = 0;
     Compute_Error_Functor_3d<N,norm> functor(params, sdm_geom,
                                              Udata1, Udata2, varId);
-    Kokkos::parallel_reduce(nbCells, functor, error);
+    Kokkos::parallel_reduce("Compute_Error_Functor_3d",
+                            md_policy_3d(ghostWidth, ghostWidth, ghostWidth,
+                                         params.isize-ghostWidth, params.jsize-ghostWidth,
+                                         params.ksize-ghostWidth,
+                                         params.mdrange_tile),
+                            functor, error);
     return error;
   }
 
@@ -229,42 +226,29 @@ public:
   // ================================================
   //! functor for 3d
   KOKKOS_INLINE_FUNCTION
-  void operator()(const int& index,
-		  real_t &sum) const
+  void operator()(const int& i,
+                  const int& j,
+                  const int& k,
+                  real_t &sum) const
   {
-    const int isize = this->params.isize;
-    const int jsize = this->params.jsize;
-    const int ksize = this->params.ksize;
-    const int ghostWidth = this->params.ghostWidth;
-
-    // local cell index
-    int i,j,k;
-    index2coord(index,i,j,k,isize,jsize,ksize);
-
-    if(k >= ghostWidth and k < ksize - ghostWidth and
-       j >= ghostWidth and j < jsize - ghostWidth and
-       i >= ghostWidth and i < isize - ghostWidth) {
-
-      // loop over current cell DoF solution points
-      for (int idz=0; idz<N; ++idz) {
-        for (int idy=0; idy<N; ++idy) {
-          for (int idx=0; idx<N; ++idx) {
+    // loop over current cell DoF solution points
+    for (int idz=0; idz<N; ++idz) {
+      for (int idy=0; idy<N; ++idy) {
+        for (int idx=0; idx<N; ++idx) {
             
-            // get local conservative variable
-            real_t tmp1 = Udata1(i,j,k, dofMap(idx,idy,idz,varId));
-            real_t tmp2 = Udata2(i,j,k, dofMap(idx,idy,idz,varId));
+          // get local conservative variable
+          real_t tmp1 = Udata1(i,j,k, dofMap(idx,idy,idz,varId));
+          real_t tmp2 = Udata2(i,j,k, dofMap(idx,idy,idz,varId));
             
-            if (norm == NORM_L1) {
-              sum += fabs(tmp1-tmp2);
-            } else {
-              sum += (tmp1-tmp2)*(tmp1-tmp2);
-            }
+          if (norm == NORM_L1) {
+            sum += fabs(tmp1-tmp2);
+          } else {
+            sum += (tmp1-tmp2)*(tmp1-tmp2);
+          }
 	  
-          } // end for idx
-        } // end for idy
-      } // end for idz
-      
-    } // end guard - ghostcells
+        } // end for idx
+      } // end for idy
+    } // end for idz
 
   } // end operator () - 3d
   
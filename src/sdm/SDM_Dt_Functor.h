@@ -231,11 +231,15 @@ public:
                       ppkMHD::EulerEquations<2> euler,
                       DataArray                 Udata)
   {
-    int64_t nbCells = params.isize * params.jsize;
+    const int ghostWidth = params.ghostWidth;
 
     real_t invDt = 0;
     ComputeDt_Functor_2d<N> functor(params, sdm_geom, euler, Udata);
-    Kokkos::parallel_reduce(nbCells, functor, invDt);
+    Kokkos::parallel_reduce("ComputeDt_Functor_2d",
+                            md_policy_2d(ghostWidth, ghostWidth,
+                                         params.isize-ghostWidth, params.jsize-ghostWidth,
+                                         params.mdrange_tile),
+                            functor, invDt);
     return invDt;
   }
 
@@ -260,13 +264,10 @@ public:
   // ================================================
   //! functor for 2d - CFL constraint
   KOKKOS_INLINE_FUNCTION
-  void operator()(const int& index,
-		  real_t &invDt) const
+  void operator()(const int& i,
+                  const int& j,
+                  real_t &invDt) const
   {
-    const int isize = this->params.isize;
-    const int jsize = this->params.jsize;
-    const int ghostWidth = this->params.ghostWidth;
-
     //const int nbvar = this->params.nbvar;
 
     // to take into account the N DoF per direction per cell
@@ -274,42 +275,33 @@ public:
     const real_t dx = this->params.dx/N;
     const real_t dy = this->params.dy/N;
 
-    // local cell index
-    int i,j;
-    index2coord(index,i,j,isize,jsize);
-
-    if(j >= ghostWidth && j < jsize - ghostWidth &&
-       i >= ghostWidth && i < isize - ghostWidth) {
+    HydroState uLoc; // conservative    variables in current cell
+    HydroState qLoc; // primitive       variables in current cell
+    real_t c=0.0;
+    real_t vx, vy;
 
-      HydroState uLoc; // conservative    variables in current cell
-      HydroState qLoc; // primitive       variables in current cell
-      real_t c=0.0;
-      real_t vx, vy;
+    // loop over current cell DoF solution points
+    for (int idy=0; idy<N; ++idy) {
+      for (int idx=0; idx<N; ++idx) {
 
-      // loop over current cell DoF solution points
-      for (int idy=0; idy<N; ++idy) {
-	for (int idx=0; idx<N; ++idx) {
+	// get local conservative variable
+	uLoc[ID] = Udata(i,j, dofMap(idx,idy,0,ID));
+	uLoc[IE] = Udata(i,j, dofMap(idx,idy,0,IE));
+	uLoc[IU] = Udata(i,j, dofMap(idx,idy,0,IU));
+	uLoc[IV] = Udata(i,j, dofMap(idx,idy,0,IV));
 
-	  // get local conservative variable
-	  uLoc[ID] = Udata(i,j, dofMap(idx,idy,0,ID));
-	  uLoc[IE] = Udata(i,j, dofMap(idx,idy,0,IE));
-	  uLoc[IU] = Udata(i,j, dofMap(idx,idy,0,IU));
-	  uLoc[IV] = Udata(i,j, dofMap(idx,idy,0,IV));
-
-	  // get primitive variables in current cell
-	  euler.convert_to_primitive(uLoc,qLoc,this->params.settings.gamma0);
+	// get primitive variables in current cell
+	euler.convert_to_primitive(uLoc,qLoc,this->params.settings.gamma0);
 
-	  c = euler.compute_speed_of_sound(qLoc,this->params.settings.gamma0);
+	c = euler.compute_speed_of_sound(qLoc,this->params.settings.gamma0);
 	  
-	  vx = c+FABS(qLoc[IU]);
-	  vy = c+FABS(qLoc[IV]);
+	vx = c+FABS(qLoc[IU]);
+	vy = c+FABS(qLoc[IV]);
 	  
-	  invDt = FMAX(invDt, vx/dx + vy/dy);
+	invDt = FMAX(invDt, vx/dx + vy/dy);
 	  
-	} // end for idx
-      } // end for idy
-      
-    } // end guard - ghostcells
+      } // end for idx
+    } // end for idy
 
   } // end operator () - 2d
   
@@ -364,11 +356,16 @@ public:
                       ppkMHD::EulerEquations<3> euler,
                       DataArray                 Udata)
   {
-    int64_t nbCells = params.isize * params.jsize * params.ksize;
+    const int ghostWidth = params.ghostWidth;
 
     real_t invDt = 0;
     ComputeDt_Functor_3d<N> functor(params, sdm_geom, euler, Udata);
-    Kokkos::parallel_reduce(nbCells, functor, invDt);
+    Kokkos::parallel_reduce("ComputeDt_Functor_3d",
+                            md_policy_3d(ghostWidth, ghostWidth, ghostWidth,
+                                         params.isize-ghostWidth, params.jsize-ghostWidth,
+                                         params.ksize-ghostWidth,
+                                         params.mdrange_tile),
+                            functor, invDt);
     return invDt;
   }
 
@@ -393,15 +390,12 @@ public:
   // ================================================
   //! functor for 3d 
   KOKKOS_INLINE_FUNCTION
-  void operator()(const int& index,
-		  real_t &invDt) const
+  void operator()(const int& i,
+                  const int& j,
+                  const int& k,
+                  real_t &invDt) const
   {
 
-    const int isize = this->params.isize;
-    const int jsize = this->params.jsize;
-    const int ksize = this->params.ksize;
-    const int ghostWidth = this->params.ghostWidth;
-
     //const int nbvar = this->params.nbvar;
 
     // to take into account the N DoF per direction per cell
@@ -410,47 +404,37 @@ public:
     const real_t dy = this->params.dy/N;
     const real_t dz = this->params.dz/N;
     
-    // local cell index
-    int i,j,k;
-    index2coord(index,i,j,k,isize,jsize,ksize);
-
-    if(k >= ghostWidth && k < ksize - ghostWidth &&
-       j >= ghostWidth && j < jsize - ghostWidth &&
-       i >= ghostWidth && i < isize - ghostWidth) {
+    HydroState uLoc; // conservative    variables in current cell
+    HydroState qLoc; // primitive       variables in current cell
+    real_t c=0.0;
+    real_t vx, vy, vz;
       
-      HydroState uLoc; // conservative    variables in current cell
-      HydroState qLoc; // primitive       variables in current cell
-      real_t c=0.0;
-      real_t vx, vy, vz;
-      
-      // loop over current cell DoF solution points
-      for (int idz=0; idz<N; ++idz) {
-	for (int idy=0; idy<N; ++idy) {
-	  for (int idx=0; idx<N; ++idx) {
+    // loop over current cell DoF solution points
+    for (int idz=0; idz<N; ++idz) {
+      for (int idy=0; idy<N; ++idy) {
+	for (int idx=0; idx<N; ++idx) {
 	  
-	    // get local conservative variable
-	    uLoc[ID] = Udata(i,j,k, dofMap(idx,idy,idz,ID));
-	    uLoc[IE] = Udata(i,j,k, dofMap(idx,idy,idz,IE));
-	    uLoc[IU] = Udata(i,j,k, dofMap(idx,idy,idz,IU));
-	    uLoc[IV] = Udata(i,j,k, dofMap(idx,idy,idz,IV));
-	    uLoc[IW] = Udata(i,j,k, dofMap(idx,idy,idz,IW));
+	  // get local conservative variable
+	  uLoc[ID] = Udata(i,j,k, dofMap(idx,idy,idz,ID));
+	  uLoc[IE] = Udata(i,j,k, dofMap(idx,idy,idz,IE));
+	  uLoc[IU] = Udata(i,j,k, dofMap(idx,idy,idz,IU));
+	  uLoc[IV] = Udata(i,j,k, dofMap(idx,idy,idz,IV));
+	  uLoc[IW] = Udata(i,j,k, dofMap(idx,idy,idz,IW));
 	    
-	    // get primitive variables in current cell
-	    euler.convert_to_primitive(uLoc,qLoc,this->params.settings.gamma0);
+	  // get primitive variables in current cell
+	  euler.convert_to_primitive(uLoc,qLoc,this->params.settings.gamma0);
 	    
-	    c = euler.compute_speed_of_sound(qLoc,this->params.settings.gamma0);
+	  c = euler.compute_speed_of_sound(qLoc,this->params.settings.gamma0);
 	    
-	    vx = c+FABS(qLoc[IU]);
-	    vy = c+FABS(qLoc[IV]);
-	    vz = c+FABS(qLoc[IW]);
+	  vx = c+FABS(qLoc[IU]);
+	  vy = c+FABS(qLoc[IV]);
+	  vz = c+FABS(qLoc[IW]);
 	    
-	    invDt = FMAX(invDt, vx/dx + vy/dy + vz/dz);
+	  invDt = FMAX(invDt, vx/dx + vy/dy + vz/dz);
 	    
-	  } // end for idx
-	} // end for idy
-      } // end for idz
-      
-    } // end guard - ghostcells
+	} // end for idx
+      } // end for idy
+    } // end for idz
     
   } // end operator () - 3d
 
@@ -0,0 +1,246 @@
+/**
+ * \file SDM_Face_Trace_Functors.h
+ *
+ * Face traces exchange, an alternative to full ghost cells exchange
+ * between MPI sub-domains.
+ *
+ * The only data a SDM cell needs from a neighbor cell across a face
+ * normal to direction dir are the values interpolated at the flux points
+ * lying on that face (N^(dim-1) points per variable), i.e. the left / right
+ * states of the face Riemann problems (or the values to be averaged at cell
+ * borders for viscous terms).
+ *
+ * Instead of sending gw layers of cells (N^dim dofs per variable and per
+ * cell), each MPI process interpolates its own outer-most interior cells
+ * at flux points, packs the face values into a buffer, and the receiving
+ * process unpacks them into the flux points of its ghost cells adjacent
+ * to the face; the face Riemann solver then consumes them as usual.
+ *
+ * Only the nbvar first variables of the flux data array are exchanged
+ * (conservative variables in Fluxes, velocity and velocity gradients in
+ * FUgrad, see VarIndexGrad2d / VarIndexGrad3d).
+ *
+ * Buffer layout is flat : value of variable iv (among nbvar) at face point
+ * ipt (among N^(dim-1)) of face cell iface is stored at
+ * iv + nbvar * (ipt + N^(dim-1) * iface); face cells are the interior
+ * cells of the sub-domain face (ghost cells in the transverse directions
+ * are not sent).
+ */
+#ifndef SDM_FACE_TRACE_FUNCTORS_H_
+#define SDM_FACE_TRACE_FUNCTORS_H_
+
+#include "shared/kokkos_shared.h"
+#include "sdm/SDMBaseFunctor.h"
+
+#include "sdm/SDM_Geometry.h"
+#include "sdm/sdm_shared.h" // for DofMapFlux
+
+namespace sdm {
+
+//! flat buffer used to send / receive face traces
+using TraceBuffer = Kokkos::View<storage_t*, Device>;
+
+//! face traces copy direction
+enum FaceTraceCopyMode {
+  FACE_TRACE_PACK,  /*!< interior flux points to buffer */
+  FACE_TRACE_UNPACK /*!< buffer to ghost cells flux points */
+};
+
+/*************************************************/
+/*************************************************/
+/*************************************************/
+/**
+ * Copy face traces between a flux data array (Fluxes or FUgrad) and a
+ * MPI buffer.
+ *
+ * Pack : values of the outer-most interior cells at the flux points lying
+ * on sub-domain face side (flux point 0 on FACE_MIN, N on FACE_MAX).
+ *
+ * Unpack : values received from the neighbor on face side are written in
+ * the ghost cells adjacent to that face, at the flux points shared with
+ * the interior cells (flux point N on FACE_MIN, 0 on FACE_MAX).
+ *
+ * \tparam dir is the direction normal to the face (IX, IY or IZ)
+ */
+template<int dim, int N, int dir>
+class Copy_Face_Trace_Functor : public SDMBaseFunctor<dim,N> {
+
+public:
+  using typename SDMBaseFunctor<dim,N>::DataArray;
+
+  static constexpr auto dofMapF = DofMapFlux<dim,N,dir>;
+
+  //! number of flux points on a cell face
+  static constexpr int nbFacePoints = dim==2 ? N : N*N;
+
+  /**
+   * \param[in]     params
+   * \param[in]     sdm_geom
+   * \param[in,out] UdataFlux data at flux points (direction dir)
+   * \param[in,out] buffer face traces
+   * \param[in]     side FACE_MIN or FACE_MAX
+   * \param[in]     mode FACE_TRACE_PACK or FACE_TRACE_UNPACK
+   * \param[in]     nbvar number of variables to copy (0 to nbvar-1)
+   */
+  Copy_Face_Trace_Functor(HydroParams         params,
+			  SDM_Geometry<dim,N> sdm_geom,
+			  DataArray           UdataFlux,
+			  TraceBuffer         buffer,
+			  int                 side,
+			  FaceTraceCopyMode   mode,
+			  int                 nbvar) :
+    SDMBaseFunctor<dim,N>(params,sdm_geom),
+    UdataFlux(UdataFlux),
+    buffer(buffer),
+    side(side),
+    mode(mode),
+    nbvar(nbvar)
+  {};
+
+  //! number of interior cells of a sub-domain face normal to dir
+  static int64_t nbFaceCells(const HydroParams& params)
+  {
+    const int gw = params.ghostWidth;
+    const int64_t nx = params.isize - 2*gw;
+    const int64_t ny = params.jsize - 2*gw;
+    const int64_t nz = dim==2 ? 1 : params.ksize - 2*gw;
+
+    return dir==IX ? ny*nz : (dir==IY ? nx*nz : nx*ny);
+  }
+
+  //! number of values exchanged through a sub-domain face
+  static int64_t buffer_size(const HydroParams& params, int nbvar)
+  {
+    return nbFaceCells(params) * nbFacePoints * nbvar;
+  }
+
+  // static method which does it all: create and execute functor
+  static void apply(HydroParams         params,
+                    SDM_Geometry<dim,N> sdm_geom,
+                    DataArray           UdataFlux,
+                    TraceBuffer         buffer,
+                    int                 side,
+                    FaceTraceCopyMode   mode,
+                    int                 nbvar)
+  {
+    int64_t nbIter = nbFaceCells(params) * nbFacePoints;
+
+    Copy_Face_Trace_Functor functor(params, sdm_geom,
+                                    UdataFlux, buffer,
+                                    side, mode, nbvar);
+    Kokkos::parallel_for("Copy_Face_Trace_Functor", nbIter, functor);
+  }
+
+  // ================================================
+  //
+  // 2D version.
+  //
+  // ================================================
+  //! functor for 2d
+  template<int dim_ = dim>
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const typename std::enable_if<dim_==2, int64_t>::type& index) const
+  {
+
+    const int isize = this->params.isize;
+    const int jsize = this->params.jsize;
+    const int gw    = this->params.ghostWidth;
+
+    const int ipt   = index % N;
+    const int iface = index / N;
+
+    // cell normal coordinate, flux point index along dir
+    const int nsize = dir==IX ? isize : jsize;
+    int inormal, iF;
+    if (mode == FACE_TRACE_PACK) {
+      inormal = side==FACE_MIN ? gw : nsize-gw-1;
+      iF      = side==FACE_MIN ? 0  : N;
+    } else {
+      inormal = side==FACE_MIN ? gw-1 : nsize-gw;
+      iF      = side==FACE_MIN ? N    : 0;
+    }
+
+    const int i = dir==IX ? inormal : gw + iface;
+    const int j = dir==IX ? gw + iface : inormal;
+
+    const int idx = dir==IX ? iF  : ipt;
+    const int idy = dir==IX ? ipt : iF;
+
+    for (int iv=0; iv<nbvar; ++iv) {
+      const int64_t ib = iv + nbvar*index;
+      const int dof = dofMapF(idx,idy,0,iv);
+      if (mode == FACE_TRACE_PACK)
+	buffer(ib) = UdataFlux(i,j,dof);
+      else
+	UdataFlux(i,j,dof) = buffer(ib);
+    }
+
+  } // operator () - 2d
+
+  // ================================================
+  //
+  // 3D version.
+  //
+  // ================================================
+  //! functor for 3d
+  template<int dim_ = dim>
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const typename std::enable_if<dim_==3, int64_t>::type& index) const
+  {
+
+    const int isize = this->params.isize;
+    const int jsize = this->params.jsize;
+    const int ksize = this->params.ksize;
+    const int gw    = this->params.ghostWidth;
+
+    // face point coordinates (a,b) in the face plane
+    const int ipt   = index % (N*N);
+    const int iface = index / (N*N);
+    const int a = ipt % N;
+    const int b = ipt / N;
+
+    // face cell coordinates (p,q) in the face plane
+    const int np = dir==IX ? jsize-2*gw : isize-2*gw;
+    const int p = gw + iface % np;
+    const int q = gw + iface / np;
+
+    const int nsize = dir==IX ? isize : (dir==IY ? jsize : ksize);
+    int inormal, iF;
+    if (mode == FACE_TRACE_PACK) {
+      inormal = side==FACE_MIN ? gw : nsize-gw-1;
+      iF      = side==FACE_MIN ? 0  : N;
+    } else {
+      inormal = side==FACE_MIN ? gw-1 : nsize-gw;
+      iF      = side==FACE_MIN ? N    : 0;
+    }
+
+    const int i = dir==IX ? inormal : p;
+    const int j = dir==IX ? p : (dir==IY ? inormal : q);
+    const int k = dir==IZ ? inormal : q;
+
+    const int idx = dir==IX ? iF : a;
+    const int idy = dir==IX ? a  : (dir==IY ? iF : b);
+    const int idz = dir==IZ ? iF : b;
+
+    for (int iv=0; iv<nbvar; ++iv) {
+      const int64_t ib = iv + nbvar*index;
+      const int dof = dofMapF(idx,idy,idz,iv);
+      if (mode == FACE_TRACE_PACK)
+	buffer(ib) = UdataFlux(i,j,k,dof);
+      else
+	UdataFlux(i,j,k,dof) = buffer(ib);
+    }
+
+  } // operator () - 3d
+
+  DataArray         UdataFlux;
+  TraceBuffer       buffer;
+  int               side;
+  FaceTraceCopyMode mode;
+  int               nbvar;
+
+}; // class Copy_Face_Trace_Functor
+
+} // namespace sdm
+
+#endif // SDM_FACE_TRACE_FUNCTORS_H_
@@ -51,13 +51,13 @@ public:
                     ppkMHD::EulerEquations<dim> euler,
                     DataArray           UdataFlux)
   {
-    int64_t nbCells = (dim==2) ? 
-      params.isize * params.jsize :
-      params.isize * params.jsize * params.ksize;
-    
     ComputeFluxAtFluxPoints_Functor functor(params, sdm_geom, 
                                             euler, UdataFlux);
-    Kokkos::parallel_for("ComputeFluxAtFluxPoints_Functor", nbCells, functor);
+    Kokkos::parallel_for("ComputeFluxAtFluxPoints_Functor",
+                         md_policy<dim>(0, 0, 0,
+                                        params.isize, params.jsize, params.ksize,
+                                        params.mdrange_tile),
+                         functor);
   }
 
   // ================================================
@@ -68,16 +68,13 @@ public:
   //! functor for 2d 
   template<int dim_ = dim>
   KOKKOS_INLINE_FUNCTION
-  void operator()(const typename std::enable_if<dim_==2, int>::type& index) const
+  void operator()(const typename std::enable_if<dim_==2, int>::type& i,
+                  const int& j) const
   {
     const int isize = this->params.isize;
     const int jsize = this->params.jsize;
 
-    const int nbvar = this->params.nbvar;
-
-    // local cell index
-    int i,j;
-    index2coord(index,i,j,isize,jsize);
+    const int nbvar = NbVar<dim>::value;
 
     // state variable for conservative variables, and flux
     HydroState q = {}, flux;
@@ -258,18 +255,16 @@ public:
   //! functor for 3d 
   template<int dim_ = dim>
   KOKKOS_INLINE_FUNCTION
-  void operator()(const typename std::enable_if<dim_==3, int>::type& index) const
+  void operator()(const typename std::enable_if<dim_==3, int>::type& i,
+                  const int& j,
+                  const int& k) const
   {
 
     const int isize = this->params.isize;
     const int jsize = this->params.jsize;
     const int ksize = this->params.ksize;
 
-    const int nbvar = this->params.nbvar;
-
-    // local cell index
-    int i,j,k;
-    index2coord(index,i,j,k,isize,jsize,ksize);
+    const int nbvar = NbVar<dim>::value;
 
     // state variable for conservative variables, and flux
     HydroState q = {}, flux;
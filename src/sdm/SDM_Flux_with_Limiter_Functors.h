@@ -86,15 +86,18 @@ public:
                     DataArray           Uaverage,
                     DataArray           Umin,
                     DataArray           Umax,
-                    DataArray           UdataFlux,
-                    int                 nbCells)
+                    DataArray           UdataFlux)
   {
     Compute_Reconstructed_state_with_Limiter_Functor functor(params, sdm_geom, 
                                                              euler, Udata,
                                                              Uaverage, 
                                                              Umin, Umax,
                                                              UdataFlux);
-    Kokkos::parallel_for(nbCells, functor);
+    Kokkos::parallel_for("Compute_Reconstructed_state_with_Limiter_Functor",
+                         md_policy<dim>(0, 0, 0,
+                                        params.isize, params.jsize, params.ksize,
+                                        params.mdrange_tile),
+                         functor);
   }
 
   // ================================================
@@ -105,16 +108,10 @@ public:
   //! functor for 2d 
   template<int dim_ = dim>
   KOKKOS_INLINE_FUNCTION
-  void operator()(const typename std::enable_if<dim_==2, int>::type& index) const
+  void operator()(const typename std::enable_if<dim_==2, int>::type& i,
+                  const int& j) const
   {
-    const int isize = this->params.isize;
-    const int jsize = this->params.jsize;
-
-    const int nbvar = this->params.nbvar;
-
-    // local cell index
-    int i,j;
-    index2coord(index,i,j,isize,jsize);
+    const int nbvar = NbVar<dim>::value;
 
     // state variable for conservative variables, and flux
     //HydroState q;
@@ -335,18 +332,12 @@ public:
   //! functor for 3d 
   template<int dim_ = dim>
   KOKKOS_INLINE_FUNCTION
-  void operator()(const typename std::enable_if<dim_==3, int>::type& index) const
+  void operator()(const typename std::enable_if<dim_==3, int>::type& i,
+                  const int& j,
+                  const int& k) const
   {
 
-    const int isize = this->params.isize;
-    const int jsize = this->params.jsize;
-    const int ksize = this->params.ksize;
-
-    const int nbvar = this->params.nbvar;
-
-    // local cell index
-    int i,j,k;
-    index2coord(index,i,j,k,isize,jsize,ksize);
+    const int nbvar = NbVar<dim>::value;
 
     // state variable for conservative variables, and flux
     //HydroState q;
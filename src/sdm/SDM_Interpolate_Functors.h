@@ -57,13 +57,13 @@ public:
                     DataArray           UdataSol,
                     DataArray           UdataFlux)
   {
-    int nbCells = dim==2 ? 
-      params.isize*params.jsize : 
-      params.isize*params.jsize*params.ksize;
-
     Interpolate_At_FluxPoints_Functor functor(params, sdm_geom, 
                                               UdataSol, UdataFlux);
-    Kokkos::parallel_for("Interpolate_At_FluxPoints_Functor", nbCells, functor);
+    Kokkos::parallel_for("Interpolate_At_FluxPoints_Functor",
+                         md_policy<dim>(0, 0, 0,
+                                        params.isize, params.jsize, params.ksize,
+                                        params.mdrange_tile),
+                         functor);
   }
   
   // =========================================================
@@ -74,17 +74,11 @@ public:
   //! functor for 2d 
   template<int dim_ = dim>
   KOKKOS_INLINE_FUNCTION
-  void operator()(const typename std::enable_if<dim_==2, int>::type& index) const
+  void operator()(const typename std::enable_if<dim_==2, int>::type& i,
+                  const int& j) const
   {
 
-    const int isize = this->params.isize;
-    const int jsize = this->params.jsize;
-
-    const int nbvar = this->params.nbvar;
-
-    // local cell index
-    int i,j;
-    index2coord(index,i,j,isize,jsize);
+    const int nbvar = NbVar<dim>::value;
 
     solution_values_t sol;
     flux_values_t     flux;
@@ -173,18 +167,12 @@ public:
   //! functor for 3d 
   template<int dim_ = dim>
   KOKKOS_INLINE_FUNCTION
-  void operator()(const typename std::enable_if<dim_==3, int>::type& index) const
+  void operator()(const typename std::enable_if<dim_==3, int>::type& i,
+                  const int& j,
+                  const int& k) const
   {
 
-    const int isize = this->params.isize;
-    const int jsize = this->params.jsize;
-    const int ksize = this->params.ksize;
-
-    const int nbvar = this->params.nbvar;
-
-    // local cell index
-    int i,j,k;
-    index2coord(index,i,j,k,isize,jsize,ksize);
+    const int nbvar = NbVar<dim>::value;
 
     solution_values_t sol;
     flux_values_t     flux;
@@ -361,13 +349,13 @@ public:
                     DataArray           UdataFlux,
                     DataArray           UdataSol)
   {
-    int nbCells = dim==2 ? 
-      params.isize*params.jsize : 
-      params.isize*params.jsize*params.ksize;
-    
     Interpolate_At_SolutionPoints_Functor functor(params, sdm_geom,
                                                   UdataFlux, UdataSol);
-    Kokkos::parallel_for("Interpolate_At_SolutionPoints_Functor",nbCells, functor);
+    Kokkos::parallel_for("Interpolate_At_SolutionPoints_Functor",
+                         md_policy<dim>(0, 0, 0,
+                                        params.isize, params.jsize, params.ksize,
+                                        params.mdrange_tile),
+                         functor);
   }
   
   // =========================================================
@@ -378,23 +366,17 @@ public:
   //! functor for 2d 
   template<int dim_ = dim>
   KOKKOS_INLINE_FUNCTION
-  void operator()(const typename std::enable_if<dim_==2, int>::type& index) const
+  void operator()(const typename std::enable_if<dim_==2, int>::type& i,
+                  const int& j) const
   {
 
-    const int isize = this->params.isize;
-    const int jsize = this->params.jsize;
-
-    const int nbvar = this->params.nbvar;
+    const int nbvar = NbVar<dim>::value;
 
     // rescale factor for derivative
     real_t rescale = 1.0/this->params.dx;
     if (dir == IY)
       rescale = 1.0/this->params.dy;
     
-    // local cell index
-    int i,j;
-    index2coord(index,i,j,isize,jsize);
-
     solution_values_t sol;
     flux_values_t     flux;
     
@@ -492,14 +474,12 @@ public:
   //! functor for 3d 
   template<int dim_ = dim>
   KOKKOS_INLINE_FUNCTION
-  void operator()(const typename std::enable_if<dim_==3, int>::type& index) const
+  void operator()(const typename std::enable_if<dim_==3, int>::type& i,
+                  const int& j,
+                  const int& k) const
   {
 
-    const int isize = this->params.isize;
-    const int jsize = this->params.jsize;
-    const int ksize = this->params.ksize;
-
-    const int nbvar = this->params.nbvar;
+    const int nbvar = NbVar<dim>::value;
 
     // rescale factor for derivative
     real_t rescale = 1.0/this->params.dx;
@@ -508,10 +488,6 @@ public:
     if (dir == IZ)
       rescale = 1.0/this->params.dz;
 
-    // local cell index
-    int i,j,k;
-    index2coord(index,i,j,k,isize,jsize,ksize);
-
     solution_values_t sol;
     flux_values_t     flux;
     
@@ -11,6 +11,7 @@
 
 #include "sdm/SDM_Geometry.h"
 #include "sdm/sdm_shared.h" // for DofMap
+#include "sdm/SDM_Interpolate_Functors.h" // for Interpolation_type_t
 
 #include "shared/EulerEquations.h"
 
@@ -27,6 +28,9 @@ namespace sdm {
  *
  * Perform exactly the inverse of Interpolate_At_SolutionPoints_Functor.
  *
+ * Same result as Interpolate_At_FluxPoints_Functor; in 2D, one thread
+ * per (cell, flux point) instead of one thread per cell.
+ *
  */
 template<int dim, int N, int dir>
 class Interpolate_At_FluxPoints_Functor_v2 : public SDMBaseFunctor<dim,N> {
@@ -39,10 +43,10 @@ public:
   static constexpr auto dofMapS = DofMap<dim,N>;
   static constexpr auto dofMapF = DofMapFlux<dim,N,dir>;
   
-  Interpolate_At_FluxPoints_Functor(HydroParams         params,
-				    SDM_Geometry<dim,N> sdm_geom,
-				    DataArray           UdataSol,
-				    DataArray           UdataFlux) :
+  Interpolate_At_FluxPoints_Functor_v2(HydroParams         params,
+				       SDM_Geometry<dim,N> sdm_geom,
+				       DataArray           UdataSol,
+				       DataArray           UdataFlux) :
     SDMBaseFunctor<dim,N>(params,sdm_geom),
     UdataSol(UdataSol),
     UdataFlux(UdataFlux)
@@ -52,12 +56,21 @@ public:
   static void apply(HydroParams         params,
                     SDM_Geometry<dim,N> sdm_geom,
                     DataArray           UdataSol,
-                    DataArray           UdataFlux,
-                    int                 nbCells)
+                    DataArray           UdataFlux)
   {
+    // in 2D, the last range dimension is the flux point index
+    const int last = dim==2 ? N+1 : params.ksize;
+    const Kokkos::Array<int,3> tile = {{params.mdrange_tile[0],
+                                        params.mdrange_tile[1],
+                                        dim==2 ? 0 : params.mdrange_tile[2]}};
+
     Interpolate_At_FluxPoints_Functor_v2 functor(params, sdm_geom, 
                                                  UdataSol, UdataFlux);
-    Kokkos::parallel_for(nbCells, functor);
+    Kokkos::parallel_for("Interpolate_At_FluxPoints_Functor_v2",
+                         md_policy_3d(0, 0, 0,
+                                      params.isize, params.jsize, last,
+                                      tile),
+                         functor);
   }
   
   // =========================================================
@@ -68,26 +81,15 @@ public:
   //! functor for 2d 
   template<int dim_ = dim>
   KOKKOS_INLINE_FUNCTION
-  void operator()(const typename std::enable_if<dim_==2, int>::type& index) const
+  void operator()(const typename std::enable_if<dim_==2, int>::type& i,
+                  const int& j,
+                  const int& fluxId) const
   {
 
-    const int isize = this->params.isize;
-    const int jsize = this->params.jsize;
-
-    const int nbvar = this->params.nbvar;
-
-    // get cell index
-    int ij = index / (N+1);
-
-    // get flux point index
-    int fluxId = index - (N+1)*ij;
-
-    // get local cell coordinate
-    int i,j;
-    index2coord(ij,i,j,isize,jsize);
+    const int nbvar = NbVar<dim>::value;
 
     solution_values_t sol;
-    double            flux;
+    real_t            flux;
     
     // loop over cell DoF's
     if (dir == IX) {
@@ -163,18 +165,12 @@ public:
   //! functor for 3d 
   template<int dim_ = dim>
   KOKKOS_INLINE_FUNCTION
-  void operator()(const typename std::enable_if<dim_==3, int>::type& index) const
+  void operator()(const typename std::enable_if<dim_==3, int>::type& i,
+                  const int& j,
+                  const int& k) const
   {
 
-    const int isize = this->params.isize;
-    const int jsize = this->params.jsize;
-    const int ksize = this->params.ksize;
-
-    const int nbvar = this->params.nbvar;
-
-    // local cell index
-    int i,j,k;
-    index2coord(index,i,j,k,isize,jsize,ksize);
+    const int nbvar = NbVar<dim>::value;
 
     solution_values_t sol;
     flux_values_t     flux;
@@ -300,14 +296,7 @@ public:
   
   DataArray UdataSol, UdataFlux;
 
-}; // class Interpolate_At_FluxPoints_Functor
-
-enum Interpolation_type_t {
-  INTERPOLATE_DERIVATIVE=0,
-  INTERPOLATE_SOLUTION=1,
-  INTERPOLATE_DERIVATIVE_NEGATIVE=2,
-  INTERPOLATE_SOLUTION_NEGATIVE=3
-};
+}; // class Interpolate_At_FluxPoints_Functor_v2
 
 /*************************************************/
 /*************************************************/
@@ -333,10 +322,10 @@ public:
   static constexpr auto dofMapS = DofMap<dim,N>;
   static constexpr auto dofMapF = DofMapFlux<dim,N,dir>;
   
-  Interpolate_At_SolutionPoints_Functor(HydroParams         params,
-					SDM_Geometry<dim,N> sdm_geom,
-					DataArray           UdataFlux,
-					DataArray           UdataSol) :
+  Interpolate_At_SolutionPoints_Functor_v2(HydroParams         params,
+					   SDM_Geometry<dim,N> sdm_geom,
+					   DataArray           UdataFlux,
+					   DataArray           UdataSol) :
     SDMBaseFunctor<dim,N>(params,sdm_geom),
     UdataFlux(UdataFlux),
     UdataSol(UdataSol)
@@ -346,12 +335,15 @@ public:
   static void apply(HydroParams         params,
                     SDM_Geometry<dim,N> sdm_geom,
                     DataArray           UdataFlux,
-                    DataArray           UdataSol,
-                    int                 nbCells)
+                    DataArray           UdataSol)
   {
     Interpolate_At_SolutionPoints_Functor_v2 functor(params, sdm_geom, 
                                                      UdataFlux, UdataSol);
-    Kokkos::parallel_for(nbCells, functor);
+    Kokkos::parallel_for("Interpolate_At_SolutionPoints_Functor_v2",
+                         md_policy<dim>(0, 0, 0,
+                                        params.isize, params.jsize, params.ksize,
+                                        params.mdrange_tile),
+                         functor);
   }
   
   // =========================================================
@@ -362,23 +354,17 @@ public:
   //! functor for 2d 
   template<int dim_ = dim>
   KOKKOS_INLINE_FUNCTION
-  void operator()(const typename std::enable_if<dim_==2, int>::type& index) const
+  void operator()(const typename std::enable_if<dim_==2, int>::type& i,
+                  const int& j) const
   {
 
-    const int isize = this->params.isize;
-    const int jsize = this->params.jsize;
-
-    const int nbvar = this->params.nbvar;
+    const int nbvar = NbVar<dim>::value;
 
     // rescale factor for derivative
     real_t rescale = 1.0/this->params.dx;
     if (dir == IY)
       rescale = 1.0/this->params.dy;
     
-    // local cell index
-    int i,j;
-    index2coord(index,i,j,isize,jsize);
-
     solution_values_t sol;
     flux_values_t     flux;
     
@@ -470,14 +456,12 @@ public:
   //! functor for 3d 
   template<int dim_ = dim>
   KOKKOS_INLINE_FUNCTION
-  void operator()(const typename std::enable_if<dim_==3, int>::type& index) const
+  void operator()(const typename std::enable_if<dim_==3, int>::type& i,
+                  const int& j,
+                  const int& k) const
   {
 
-    const int isize = this->params.isize;
-    const int jsize = this->params.jsize;
-    const int ksize = this->params.ksize;
-
-    const int nbvar = this->params.nbvar;
+    const int nbvar = NbVar<dim>::value;
 
     // rescale factor for derivative
     real_t rescale = 1.0/this->params.dx;
@@ -486,10 +470,6 @@ public:
     if (dir == IZ)
       rescale = 1.0/this->params.dz;
 
-    // local cell index
-    int i,j,k;
-    index2coord(index,i,j,k,isize,jsize,ksize);
-
     solution_values_t sol;
     flux_values_t     flux;
     
@@ -620,7 +600,7 @@ public:
   
   DataArray UdataFlux, UdataSol;
 
-}; // Interpolate_At_SolutionPoints_Functor
+}; // Interpolate_At_SolutionPoints_Functor_v2
 
 } // namespace sdm
 
@@ -73,13 +73,13 @@ public:
                     DataArray           UdataSol,
                     DataArray           UdataFlux)
   {
-    int64_t nbCells = dim == 2 ?
-      params.isize * params.jsize :
-      params.isize * params.jsize * params.ksize;
-
     Interpolate_velocities_Sol2Flux_Functor functor(params, sdm_geom, 
                                                     UdataSol, UdataFlux);
-    Kokkos::parallel_for("Interpolate_velocities_Sol2Flux_Functor",nbCells, functor);
+    Kokkos::parallel_for("Interpolate_velocities_Sol2Flux_Functor",
+                         md_policy<dim>(0, 0, 0,
+                                        params.isize, params.jsize, params.ksize,
+                                        params.mdrange_tile),
+                         functor);
   }
 
   // =========================================================
@@ -90,16 +90,10 @@ public:
   //! functor for 2d 
   template<int dim_ = dim>
   KOKKOS_INLINE_FUNCTION
-  void operator()(const typename std::enable_if<dim_==2, int>::type& index) const
+  void operator()(const typename std::enable_if<dim_==2, int>::type& i,
+                  const int& j) const
   {
 
-    const int isize = this->params.isize;
-    const int jsize = this->params.jsize;
-
-    // local cell index
-    int i,j;
-    index2coord(index,i,j,isize,jsize);
-
     solution_values_t sol;
     flux_values_t     flux;
 
@@ -189,17 +183,11 @@ public:
   //! functor for 3d 
   template<int dim_ = dim>
   KOKKOS_INLINE_FUNCTION
-  void operator()(const typename std::enable_if<dim_==3, int>::type& index) const
+  void operator()(const typename std::enable_if<dim_==3, int>::type& i,
+                  const int& j,
+                  const int& k) const
   {
 
-    const int isize = this->params.isize;
-    const int jsize = this->params.jsize;
-    const int ksize = this->params.ksize;
-
-    // local cell index
-    int i,j,k;
-    index2coord(index,i,j,k,isize,jsize,ksize);
-
     solution_values_t sol;
     flux_values_t     flux;
     
@@ -378,10 +366,6 @@ public:
                     SDM_Geometry<dim,N> sdm_geom,
                     DataArray           UdataFlux)
   {
-    int64_t nbCells = dim == 2 ?
-      params.isize * params.jsize :
-      params.isize * params.jsize * params.ksize;
-
     int nvar_to_average = dim;
     var_index_t var_index;
     if (dim==2) {
@@ -393,12 +377,33 @@ public:
       var_index[2] = (int) VarIndexGrad3d::IGW;
     }
     
+    apply(params, sdm_geom, UdataFlux, nvar_to_average, var_index);
+  }
+
+  // static method which does it all: create and execute functor
+  // (average the nbvar components listed in var_index)
+  static void apply(HydroParams         params,
+                    SDM_Geometry<dim,N> sdm_geom,
+                    DataArray           UdataFlux,
+                    int                 nbvar,
+                    var_index_t         var_index)
+  {
     Average_component_at_cell_borders_Functor functor(params,
                                                       sdm_geom,
                                                       UdataFlux, 
-                                                      nvar_to_average,
+                                                      nbvar,
                                                       var_index);
-    Kokkos::parallel_for("Average_component_at_cell_borders_Functor", nbCells, functor);
+
+    // each cell deals with its left border along dir, except the first one
+    Kokkos::parallel_for("Average_component_at_cell_borders_Functor",
+                         md_policy<dim>(dir==IX ? 1 : 0,
+                                        dir==IY ? 1 : 0,
+                                        dir==IZ ? 1 : 0,
+                                        params.isize,
+                                        params.jsize,
+                                        params.ksize,
+                                        params.mdrange_tile),
+                         functor);
   }
   
   // =========================================================
@@ -409,16 +414,10 @@ public:
   //! functor for 2d 
   template<int dim_ = dim>
   KOKKOS_INLINE_FUNCTION
-  void operator()(const typename std::enable_if<dim_==2, int>::type& index) const
+  void operator()(const typename std::enable_if<dim_==2, int>::type& i,
+                  const int& j) const
   {
 
-    const int isize = this->params.isize;
-    const int jsize = this->params.jsize;
-
-    // local cell index
-    int i,j;
-    index2coord(index,i,j,isize,jsize);
-
     real_t dataL, dataR, data_average;
     
     // =========================
@@ -426,25 +425,20 @@ public:
     // =========================
     if (dir == IX) {
 
-      // avoid ghost cells
-      if (i>0 and i<isize) {
-
-	// just deals with the left cell border
-	for (int idy=0; idy<N; ++idy) {
+      // just deals with the left cell border
+      for (int idy=0; idy<N; ++idy) {
 
-	  for (int iv = 0; iv<nbvar; iv++) {
-	    int ivar = var_index[iv];
+	for (int iv = 0; iv<nbvar; iv++) {
+	  int ivar = var_index[iv];
 	    
-	    dataL = UdataFlux(i-1,j, dofMapF(N,idy,0,ivar));
-	    dataR = UdataFlux(i  ,j, dofMapF(0,idy,0,ivar));
-	    data_average = 0.5*(dataL + dataR);
-	    UdataFlux(i-1,j, dofMapF(N,idy,0,ivar)) = data_average;
-	    UdataFlux(i  ,j, dofMapF(0,idy,0,ivar)) = data_average;
-	  }
+	  dataL = UdataFlux(i-1,j, dofMapF(N,idy,0,ivar));
+	  dataR = UdataFlux(i  ,j, dofMapF(0,idy,0,ivar));
+	  data_average = 0.5*(dataL + dataR);
+	  UdataFlux(i-1,j, dofMapF(N,idy,0,ivar)) = data_average;
+	  UdataFlux(i  ,j, dofMapF(0,idy,0,ivar)) = data_average;
+	}
 	  
-	} // end for idy
-
-      } // end ghost cells guard
+      } // end for idy
       
     } // end dir IX
     
@@ -453,25 +447,20 @@ public:
     // =========================
     if (dir == IY) {
 
-      // avoid ghost cells
-      if (j>0 and j<jsize) {
-
-	// just deals with the left cell border
-	for (int idx=0; idx<N; ++idx) {
+      // just deals with the left cell border
+      for (int idx=0; idx<N; ++idx) {
 
-	  for (int iv = 0; iv<nbvar; iv++) {
-	    int ivar = var_index[iv];
+	for (int iv = 0; iv<nbvar; iv++) {
+	  int ivar = var_index[iv];
 	    
-	    dataL = UdataFlux(i,j-1, dofMapF(idx,N,0,ivar));
-	    dataR = UdataFlux(i,j  , dofMapF(idx,0,0,ivar));
-	    data_average = 0.5*(dataL + dataR);
-	    UdataFlux(i,j-1, dofMapF(idx,N,0,ivar)) = data_average;
-	    UdataFlux(i,j  , dofMapF(idx,0,0,ivar)) = data_average;
-	  }
+	  dataL = UdataFlux(i,j-1, dofMapF(idx,N,0,ivar));
+	  dataR = UdataFlux(i,j  , dofMapF(idx,0,0,ivar));
+	  data_average = 0.5*(dataL + dataR);
+	  UdataFlux(i,j-1, dofMapF(idx,N,0,ivar)) = data_average;
+	  UdataFlux(i,j  , dofMapF(idx,0,0,ivar)) = data_average;
+	}
 	  
-	} // end for idy
-
-      } // end ghost cells guard
+      } // end for idy
       
     } // end dir IY
     
@@ -485,17 +474,11 @@ public:
   //! functor for 3d 
   template<int dim_ = dim>
   KOKKOS_INLINE_FUNCTION
-  void operator()(const typename std::enable_if<dim_==3, int>::type& index) const
+  void operator()(const typename std::enable_if<dim_==3, int>::type& i,
+                  const int& j,
+                  const int& k) const
   {
 
-    const int isize = this->params.isize;
-    const int jsize = this->params.jsize;
-    const int ksize = this->params.ksize;
-
-    // local cell index
-    int i,j,k;
-    index2coord(index,i,j,k,isize,jsize,ksize);
-
     real_t dataL, dataR, data_average;
     
     // =========================
@@ -503,27 +486,22 @@ public:
     // =========================
     if (dir == IX) {
 
-      // avoid ghost cells
-      if (i>0 and i<isize) {
-
-	// just deals with the left cell border
-	for (int idz=0; idz<N; ++idz) {
-	  for (int idy=0; idy<N; ++idy) {
+      // just deals with the left cell border
+      for (int idz=0; idz<N; ++idz) {
+	for (int idy=0; idy<N; ++idy) {
 
-	    for (int iv = 0; iv<nbvar; iv++) {
-	      int ivar = var_index[iv];
+	  for (int iv = 0; iv<nbvar; iv++) {
+	    int ivar = var_index[iv];
 
-	      dataL = UdataFlux(i-1,j, k, dofMapF(N,idy,idz,ivar));
-	      dataR = UdataFlux(i  ,j, k, dofMapF(0,idy,idz,ivar));
-	      data_average = 0.5*(dataL + dataR);
-	      UdataFlux(i-1,j, k, dofMapF(N,idy,idz,ivar)) = data_average;
-	      UdataFlux(i  ,j, k, dofMapF(0,idy,idz,ivar)) = data_average;
-	    } // end for ivar
+	    dataL = UdataFlux(i-1,j, k, dofMapF(N,idy,idz,ivar));
+	    dataR = UdataFlux(i  ,j, k, dofMapF(0,idy,idz,ivar));
+	    data_average = 0.5*(dataL + dataR);
+	    UdataFlux(i-1,j, k, dofMapF(N,idy,idz,ivar)) = data_average;
+	    UdataFlux(i  ,j, k, dofMapF(0,idy,idz,ivar)) = data_average;
+	  } // end for ivar
 	  
-	  } // end for idy
-	} // end for idz
-	
-      } // end ghost cells guard
+	} // end for idy
+      } // end for idz
       
     } // end dir IX
 
@@ -532,27 +510,22 @@ public:
     // =========================
     if (dir == IY) {
 
-      // avoid ghost cells
-      if (j>0 and j<jsize) {
-
-	// just deals with the left cell border
-	for (int idz=0; idz<N; ++idz) {
-	  for (int idx=0; idx<N; ++idx) {
+      // just deals with the left cell border
+      for (int idz=0; idz<N; ++idz) {
+	for (int idx=0; idx<N; ++idx) {
 
-	    for (int iv = 0; iv<nbvar; iv++) {
-	      int ivar = var_index[iv];
+	  for (int iv = 0; iv<nbvar; iv++) {
+	    int ivar = var_index[iv];
 
-	      dataL = UdataFlux(i,j-1, k, dofMapF(idx,N,idz,ivar));
-	      dataR = UdataFlux(i,j  , k, dofMapF(idx,0,idz,ivar));
-	      data_average = 0.5*(dataL + dataR);
-	      UdataFlux(i,j-1, k, dofMapF(idx,N,idz,ivar)) = data_average;
-	      UdataFlux(i,j  , k, dofMapF(idx,0,idz,ivar)) = data_average;
-	    } // end for ivar
+	    dataL = UdataFlux(i,j-1, k, dofMapF(idx,N,idz,ivar));
+	    dataR = UdataFlux(i,j  , k, dofMapF(idx,0,idz,ivar));
+	    data_average = 0.5*(dataL + dataR);
+	    UdataFlux(i,j-1, k, dofMapF(idx,N,idz,ivar)) = data_average;
+	    UdataFlux(i,j  , k, dofMapF(idx,0,idz,ivar)) = data_average;
+	  } // end for ivar
 	  
-	  } // end for idx
-	} // end for idz
-	
-      } // end ghost cells guard
+	} // end for idx
+      } // end for idz
       
     } // end dir IY
 
@@ -561,27 +534,22 @@ public:
     // =========================
     if (dir == IZ) {
 
-      // avoid ghost cells
-      if (k>0 and k<ksize) {
-
-	// just deals with the left cell border
-	for (int idy=0; idy<N; ++idy) {
-	  for (int idx=0; idx<N; ++idx) {
+      // just deals with the left cell border
+      for (int idy=0; idy<N; ++idy) {
+	for (int idx=0; idx<N; ++idx) {
 
-	    for (int iv = 0; iv<nbvar; iv++) {
-	      int ivar = var_index[iv];
+	  for (int iv = 0; iv<nbvar; iv++) {
+	    int ivar = var_index[iv];
 
-	      dataL = UdataFlux(i,j, k-1, dofMapF(idx,idy,N,ivar));
-	      dataR = UdataFlux(i,j, k  , dofMapF(idx,idy,0,ivar));
-	      data_average = 0.5*(dataL + dataR);
-	      UdataFlux(i,j, k-1, dofMapF(idx,idy,N,ivar)) = data_average;
-	      UdataFlux(i,j, k  , dofMapF(idx,idy,0,ivar)) = data_average;
-	    } // end for ivar
+	    dataL = UdataFlux(i,j, k-1, dofMapF(idx,idy,N,ivar));
+	    dataR = UdataFlux(i,j, k  , dofMapF(idx,idy,0,ivar));
+	    data_average = 0.5*(dataL + dataR);
+	    UdataFlux(i,j, k-1, dofMapF(idx,idy,N,ivar)) = data_average;
+	    UdataFlux(i,j, k  , dofMapF(idx,idy,0,ivar)) = data_average;
+	  } // end for ivar
 	  
-	  } // end for idx
-	} // end for idy
-	
-      } // end ghost cells guard
+	} // end for idx
+      } // end for idy
       
     } // end dir IZ
 
@@ -650,15 +618,15 @@ public:
                     DataArray           UdataFlux,
                     DataArray           UdataSol)
   {
-    int64_t nbCells = dim == 2 ?
-      params.isize * params.jsize :
-      params.isize * params.jsize * params.ksize;
-
     Interp_grad_velocity_at_SolutionPoints_Functor functor(params,
                                                            sdm_geom,
                                                            UdataFlux,
                                                            UdataSol);
-    Kokkos::parallel_for("Interp_grad_velocity_at_SolutionPoints_Functor", nbCells, functor);
+    Kokkos::parallel_for("Interp_grad_velocity_at_SolutionPoints_Functor",
+                         md_policy<dim>(0, 0, 0,
+                                        params.isize, params.jsize, params.ksize,
+                                        params.mdrange_tile),
+                         functor);
   }
 
   // =========================================================
@@ -669,21 +637,15 @@ public:
   //! functor for 2d 
   template<int dim_ = dim>
   KOKKOS_INLINE_FUNCTION
-  void operator()(const typename std::enable_if<dim_==2, int>::type& index) const
+  void operator()(const typename std::enable_if<dim_==2, int>::type& i,
+                  const int& j) const
   {
 
-    const int isize = this->params.isize;
-    const int jsize = this->params.jsize;
-
     // rescale factor for derivative
     real_t rescale = 1.0/this->params.dx;
     if (dir == IY)
       rescale = 1.0/this->params.dy;
     
-    // local cell index
-    int i,j;
-    index2coord(index,i,j,isize,jsize);
-
     solution_values_t sol;
     flux_values_t     flux;
     
@@ -759,13 +721,11 @@ public:
   //! functor for 3d 
   template<int dim_ = dim>
   KOKKOS_INLINE_FUNCTION
-  void operator()(const typename std::enable_if<dim_==3, int>::type& index) const
+  void operator()(const typename std::enable_if<dim_==3, int>::type& i,
+                  const int& j,
+                  const int& k) const
   {
 
-    const int isize = this->params.isize;
-    const int jsize = this->params.jsize;
-    const int ksize = this->params.ksize;
-
     // rescale factor for derivative
     real_t rescale = 1.0/this->params.dx;
     if (dir == IY)
@@ -773,10 +733,6 @@ public:
     if (dir == IZ)
       rescale = 1.0/this->params.dz;
 
-    // local cell index
-    int i,j,k;
-    index2coord(index,i,j,k,isize,jsize,ksize);
-
     solution_values_t sol;
     flux_values_t     flux;
     
@@ -957,15 +913,15 @@ public:
                     DataArray           UdataSol,
                     DataArray           UdataFlux)
   {
-    int64_t nbCells = dim == 2 ?
-      params.isize * params.jsize :
-      params.isize * params.jsize * params.ksize;
-
     Interpolate_velocity_gradients_Sol2Flux_Functor functor(params,
                                                             sdm_geom,
                                                             UdataSol,
                                                             UdataFlux);
-    Kokkos::parallel_for("Interpolate_velocity_gradients_Sol2Flux_Functor", nbCells, functor);
+    Kokkos::parallel_for("Interpolate_velocity_gradients_Sol2Flux_Functor",
+                         md_policy<dim>(0, 0, 0,
+                                        params.isize, params.jsize, params.ksize,
+                                        params.mdrange_tile),
+                         functor);
   }
 
   // =========================================================
@@ -976,16 +932,10 @@ public:
   //! functor for 2d 
   template<int dim_ = dim>
   KOKKOS_INLINE_FUNCTION
-  void operator()(const typename std::enable_if<dim_==2, int>::type& index) const
+  void operator()(const typename std::enable_if<dim_==2, int>::type& i,
+                  const int& j) const
   {
 
-    const int isize = this->params.isize;
-    const int jsize = this->params.jsize;
-
-    // local cell index
-    int i,j;
-    index2coord(index,i,j,isize,jsize);
-
     solution_values_t sol;
     flux_values_t     flux;
 
@@ -1082,17 +1032,11 @@ public:
   //! functor for 3d 
   template<int dim_ = dim>
   KOKKOS_INLINE_FUNCTION
-  void operator()(const typename std::enable_if<dim_==3, int>::type& index) const
+  void operator()(const typename std::enable_if<dim_==3, int>::type& i,
+                  const int& j,
+                  const int& k) const
   {
 
-    const int isize = this->params.isize;
-    const int jsize = this->params.jsize;
-    const int ksize = this->params.ksize;
-
-    // local cell index
-    int i,j,k;
-    index2coord(index,i,j,k,isize,jsize,ksize);
-
     solution_values_t sol;
     flux_values_t     flux;
     
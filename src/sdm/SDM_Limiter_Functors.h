@@ -49,13 +49,13 @@ public:
                     DataArray           Udata,
                     DataArray           Uaverage)
   {
-    int64_t nbCells = dim == 2 ?
-      params.isize * params.jsize :
-      params.isize * params.jsize * params.ksize;
-    
     Average_Conservative_Variables_Functor functor(params, sdm_geom,
                                                    Udata, Uaverage);
-    Kokkos::parallel_for("Average_Conservative_Variables_Functor", nbCells, functor);
+    Kokkos::parallel_for("Average_Conservative_Variables_Functor",
+                         md_policy<dim>(0, 0, 0,
+                                        params.isize, params.jsize, params.ksize,
+                                        params.mdrange_tile),
+                         functor);
   }
 
   // ================================================
@@ -66,16 +66,10 @@ public:
   //! functor for 2d 
   template<int dim_ = dim>
   KOKKOS_INLINE_FUNCTION
-  void operator()(const typename std::enable_if<dim_==2, int>::type& index) const
+  void operator()(const typename std::enable_if<dim_==2, int>::type& i,
+                  const int& j) const
   {
-    const int isize = this->params.isize;
-    const int jsize = this->params.jsize;
-
-    const int nbvar = this->params.nbvar;
-
-    // local cell index
-    int i,j;
-    index2coord(index,i,j,isize,jsize);
+    const int nbvar = NbVar<dim>::value;
 
     // for each variables
     for (int ivar = 0; ivar<nbvar; ++ivar) {
@@ -119,18 +113,12 @@ public:
   //! functor for 3d 
   template<int dim_ = dim>
   KOKKOS_INLINE_FUNCTION
-  void operator()(const typename std::enable_if<dim_==3, int>::type& index) const
+  void operator()(const typename std::enable_if<dim_==3, int>::type& i,
+                  const int& j,
+                  const int& k) const
   {
 
-    const int isize = this->params.isize;
-    const int jsize = this->params.jsize;
-    const int ksize = this->params.ksize;
-
-    const int nbvar = this->params.nbvar;
-
-    // local cell index
-    int i,j,k;
-    index2coord(index,i,j,k,isize,jsize,ksize);
+    const int nbvar = NbVar<dim>::value;
 
     // for each variables
     for (int ivar = 0; ivar<nbvar; ++ivar) {
@@ -230,14 +218,14 @@ public:
                     DataArray           Umax,
                     int                 corner_included)
   {
-    int64_t nbCells = dim == 2 ?
-      params.isize * params.jsize :
-      params.isize * params.jsize * params.ksize;
-
     MinMax_Conservative_Variables_Functor functor(params, sdm_geom, 
                                                   Uaverage, Umin, Umax,
                                                   corner_included);
-    Kokkos::parallel_for("MinMax_Conservative_Variables_Functor", nbCells, functor);
+    Kokkos::parallel_for("MinMax_Conservative_Variables_Functor",
+                         md_policy<dim>(0, 0, 0,
+                                        params.isize, params.jsize, params.ksize,
+                                        params.mdrange_tile),
+                         functor);
   }
 
   KOKKOS_INLINE_FUNCTION
@@ -264,16 +252,13 @@ public:
   //! functor for 2d 
   template<int dim_ = dim>
   KOKKOS_INLINE_FUNCTION
-  void operator()(const typename std::enable_if<dim_==2, int>::type& index) const
+  void operator()(const typename std::enable_if<dim_==2, int>::type& i,
+                  const int& j) const
   {
     const int isize = this->params.isize;
     const int jsize = this->params.jsize;
 
-    const int nbvar = this->params.nbvar;
-
-    // local cell index
-    int i,j;
-    index2coord(index,i,j,isize,jsize);
+    const int nbvar = NbVar<dim>::value;
 
     // for each variables
     for (int ivar = 0; ivar<nbvar; ++ivar) {
@@ -316,17 +301,15 @@ public:
   //! functor for 3d 
   template<int dim_ = dim>
   KOKKOS_INLINE_FUNCTION
-  void operator()(const typename std::enable_if<dim_==3, int>::type& index) const
+  void operator()(const typename std::enable_if<dim_==3, int>::type& i,
+                  const int& j,
+                  const int& k) const
   {
     const int isize = this->params.isize;
     const int jsize = this->params.jsize;
     const int ksize = this->params.ksize;
 
-    const int nbvar = this->params.nbvar;
-
-    // local cell index
-    int i,j,k;
-    index2coord(index,i,j,k,isize,jsize,ksize);
+    const int nbvar = NbVar<dim>::value;
 
     // for each variables
     for (int ivar = 0; ivar<nbvar; ++ivar) {
@@ -409,18 +392,54 @@ public:
   {};
 
   // static method which does it all: create and execute functor
+  //
+  // if nbListedCells is non-negative, the functor is only applied to
+  // the cells listed in cellList.
   static void apply(HydroParams         params,
                     SDM_Geometry<dim,N> sdm_geom,
                     DataArray           Udata,
-                    DataArray           Uaverage)
+                    DataArray           Uaverage,
+                    CellList            cellList = CellList(),
+                    int                 nbListedCells = -1)
   {
-    int64_t nbCells = dim == 2 ?
-      params.isize * params.jsize :
-      params.isize * params.jsize * params.ksize;
-
     Average_Gradient_Functor functor(params, sdm_geom, 
                                      Udata, Uaverage);
-    Kokkos::parallel_for("Average_Gradient_Functor", nbCells, functor);
+
+    if (nbListedCells < 0) {
+      Kokkos::parallel_for("Average_Gradient_Functor",
+                           md_policy<dim>(0, 0, 0,
+                                          params.isize, params.jsize, params.ksize,
+                                          params.mdrange_tile),
+                           functor);
+    } else {
+      functor.cellList = cellList;
+      Kokkos::parallel_for("Average_Gradient_Functor - cell list",
+                           Kokkos::RangePolicy<Device,TagCellList>(0,nbListedCells),
+                           functor);
+    }
+  }
+
+  //! functor restricted to a list of cells (2d)
+  template<int dim_ = dim>
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const TagCellList&,
+                  const typename std::enable_if<dim_==2, int>::type& ilist) const
+  {
+    int i,j;
+    index2coord(cellList(ilist),i,j,this->params.isize,this->params.jsize);
+    (*this)(i,j);
+  }
+
+  //! functor restricted to a list of cells (3d)
+  template<int dim_ = dim>
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const TagCellList&,
+                  const typename std::enable_if<dim_==3, int>::type& ilist) const
+  {
+    int i,j,k;
+    index2coord(cellList(ilist),i,j,k,
+                this->params.isize,this->params.jsize,this->params.ksize);
+    (*this)(i,j,k);
   }
 
   // ================================================
@@ -431,16 +450,10 @@ public:
   //! functor for 2d 
   template<int dim_ = dim>
   KOKKOS_INLINE_FUNCTION
-  void operator()(const typename std::enable_if<dim_==2, int>::type& index) const
+  void operator()(const typename std::enable_if<dim_==2, int>::type& i,
+                  const int& j) const
   {
-    const int isize = this->params.isize;
-    const int jsize = this->params.jsize;
-
-    const int nbvar = this->params.nbvar;
-
-    // local cell index
-    int i,j;
-    index2coord(index,i,j,isize,jsize);
+    const int nbvar = NbVar<dim>::value;
 
     if (dir == IX) {
       
@@ -564,18 +577,12 @@ public:
   //! functor for 3d 
   template<int dim_ = dim>
   KOKKOS_INLINE_FUNCTION
-  void operator()(const typename std::enable_if<dim_==3, int>::type& index) const
+  void operator()(const typename std::enable_if<dim_==3, int>::type& i,
+                  const int& j,
+                  const int& k) const
   {
 
-    const int isize = this->params.isize;
-    const int jsize = this->params.jsize;
-    const int ksize = this->params.ksize;
-
-    const int nbvar = this->params.nbvar;
-
-    // local cell index
-    int i,j,k;
-    index2coord(index,i,j,k,isize,jsize,ksize);
+    const int nbvar = NbVar<dim>::value;
 
     if (dir == IX) {
       
@@ -763,6 +770,7 @@ public:
   
   DataArray Udata;
   DataArray Uaverage;
+  CellList  cellList;
 
 }; // class Average_Gradient_Functor
 
@@ -770,7 +778,10 @@ public:
 /*************************************************/
 /*************************************************/
 /**
- * This functor applies the limiting procedure to all cells.
+ * This functor applies the limiting procedure to all cells (except the
+ * outer layer of cells, which have no neighbor), or to a list of cells
+ * built by Troubled_Cells_Indicator_Functor (which never flags the
+ * outer layer).
  * 
  * The limiting procedure is described in Cockburn and Shu,
  * "The Runge-Kutta Discontinuous Galerkin Method for Conservation Laws V: 
@@ -820,16 +831,51 @@ public:
                     DataArray           Ugradx,
                     DataArray           Ugrady,
                     DataArray           Ugradz,
-                    const real_t        Mdx2)
+                    const real_t        Mdx2,
+                    CellList            cellList = CellList(),
+                    int                 nbListedCells = -1)
   {
-    int64_t nbCells = dim == 2 ?
-      params.isize * params.jsize :
-      params.isize * params.jsize * params.ksize;
-
     Apply_limiter_Functor functor(params, sdm_geom, euler, 
                                   Udata, Uaverage,
                                   Ugradx, Ugrady, Ugradz, Mdx2);
-    Kokkos::parallel_for("Apply_limiter_Functor", nbCells, functor);
+
+    if (nbListedCells < 0) {
+      Kokkos::parallel_for("Apply_limiter_Functor",
+                           md_policy<dim>(1, 1, 1,
+                                          params.isize-1,
+                                          params.jsize-1,
+                                          params.ksize-1,
+                                          params.mdrange_tile),
+                           functor);
+    } else {
+      functor.cellList = cellList;
+      Kokkos::parallel_for("Apply_limiter_Functor - cell list",
+                           Kokkos::RangePolicy<Device,TagCellList>(0,nbListedCells),
+                           functor);
+    }
+  }
+
+  //! functor restricted to a list of cells (2d)
+  template<int dim_ = dim>
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const TagCellList&,
+                  const typename std::enable_if<dim_==2, int>::type& ilist) const
+  {
+    int i,j;
+    index2coord(cellList(ilist),i,j,this->params.isize,this->params.jsize);
+    (*this)(i,j);
+  }
+
+  //! functor restricted to a list of cells (3d)
+  template<int dim_ = dim>
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const TagCellList&,
+                  const typename std::enable_if<dim_==3, int>::type& ilist) const
+  {
+    int i,j,k;
+    index2coord(cellList(ilist),i,j,k,
+                this->params.isize,this->params.jsize,this->params.ksize);
+    (*this)(i,j,k);
   }
 
   /**
@@ -863,12 +909,10 @@ public:
   //! functor for 2d 
   template<int dim_ = dim>
   KOKKOS_INLINE_FUNCTION
-  void operator()(const typename std::enable_if<dim_==2, int>::type& index) const
+  void operator()(const typename std::enable_if<dim_==2, int>::type& i,
+                  const int& j) const
   {
-    const int isize = this->params.isize;
-    const int jsize = this->params.jsize;
-
-    const int nbvar = this->params.nbvar;
+    const int nbvar = NbVar<dim>::value;
 
     const real_t gamma0 = this->params.settings.gamma0;
 
@@ -885,14 +929,6 @@ public:
     // Needs explanation here !!!
     const real_t dx = 1.0; //this->params.dx;
     
-    // local cell index
-    int i,j;
-    index2coord(index,i,j,isize,jsize);
-
-    if (i==0 or i==isize-1 or
-	j==0 or j==jsize-1 )
-      return;
-
     // read cell-average conservative variables
     HydroState Uave = {}; //Uave[IE]=0;
     for (int ivar = 0; ivar<nbvar; ++ivar) {
@@ -988,14 +1024,12 @@ public:
   //! functor for 3d 
   template<int dim_ = dim>
   KOKKOS_INLINE_FUNCTION
-  void operator()(const typename std::enable_if<dim_==3, int>::type& index) const
+  void operator()(const typename std::enable_if<dim_==3, int>::type& i,
+                  const int& j,
+                  const int& k) const
   {
 
-    const int isize = this->params.isize;
-    const int jsize = this->params.jsize;
-    const int ksize = this->params.ksize;
-
-    const int nbvar = this->params.nbvar;
+    const int nbvar = NbVar<dim>::value;
 
     const real_t gamma0 = this->params.settings.gamma0;
 
@@ -1017,15 +1051,6 @@ public:
     // Needs explanation here !!!
     const real_t dx = 1.0; //this->params.dx;
 
-    // local cell index
-    int i,j,k;
-    index2coord(index,i,j,k,isize,jsize,ksize);
-
-    if (i==0 or i==isize-1 or
-	j==0 or j==jsize-1 or
-	k==0 or k==ksize-1 )
-      return;
-
     // read cell-average conservative variables
     HydroState Uave = {}; //Uave[IE]=0;
     for (int ivar = 0; ivar<nbvar; ++ivar) {
@@ -1141,6 +1166,7 @@ public:
   DataArray Ugrady;
   DataArray Ugradz;
   real_t    Mdx2;
+  CellList  cellList;
   
 }; // class Apply_limiter_Functor
 
@@ -0,0 +1,1672 @@
+/**
+ * \file SDM_PAdaptive_Functors.h
+ *
+ * Functors of the p-adaptive Spectral Difference Method (see
+ * SolverHydroSDM_PAdaptive.h) : each cell has its own order M (number of
+ * solution points per direction) in [1,N].
+ *
+ * Solution points of all cells are stored in a compact DoF store, a 1D
+ * array where the DoFs of a cell of order M (M^dim solution points,
+ * ordered as DofMap<dim,M>) start at DofOffsets(cell). Cells are grouped
+ * by order in a cell list (ghost cells, always of order N, last), so
+ * that each group is handled by functors specialized at compile time
+ * for its order M, using the SDM_Geometry of order M.
+ *
+ * Cells of different orders are coupled through their faces : face
+ * traces are interpolated at the N^(dim-1) points of order N of the face
+ * (tangential Lagrange interpolation), where the Riemann problems are
+ * solved; a cell of lower order then uses the L2 projection of the
+ * common flux on its own polynomial space (mortar), so that the face
+ * integral of the flux is the same on both sides and the scheme stays
+ * conservative. The solution of order N is reduced to a lower order the
+ * same way.
+ */
+#ifndef SDM_PADAPTIVE_FUNCTORS_H_
+#define SDM_PADAPTIVE_FUNCTORS_H_
+
+#include <vector>
+#include <limits> // for std::numeric_limits
+#ifdef __CUDA_ARCH__
+#include <math_constants.h> // for cuda math constants, e.g. CUDART_INF
+#endif // __CUDA_ARCH__
+
+#include "shared/kokkos_shared.h"
+#include "sdm/SDMBaseFunctor.h"
+
+#include "sdm/SDM_Geometry.h"
+#include "sdm/sdm_shared.h" // for DofMap
+
+#include "shared/RiemannSolvers.h"
+#include "shared/EulerEquations.h"
+
+namespace sdm {
+
+//! compact DoF store (all cells, variable number of DoFs per cell)
+using DofStore   = Kokkos::View<storage_t*, Device>;
+
+//! first DoF of each cell in a DofStore
+using DofOffsets = Kokkos::View<int64_t*, Device>;
+
+/**
+ * SDM_Geometry of all orders 1 to N : the geometry of order M is member
+ * geom of base class SDM_Geometry_List<dim,M>.
+ */
+template<int dim, int N>
+struct SDM_Geometry_List : public SDM_Geometry_List<dim,N-1>
+{
+
+  SDM_Geometry<dim,N> geom;
+
+  //! init solution / flux points and Lagrange matrices of all orders
+  void init()
+  {
+    SDM_Geometry_List<dim,N-1>::init();
+    geom.init(0);
+    geom.init_lagrange_1d();
+  }
+
+  //! geometry of order M (M <= N)
+  template<int M>
+  const SDM_Geometry<dim,M>& get() const
+  {
+    return static_cast<const SDM_Geometry_List<dim,M>&>(*this).geom;
+  }
+
+  //! 1D solution points of all orders, points[M] for order M
+  void solution_points(std::vector<std::vector<real_t> >& points) const
+  {
+    SDM_Geometry_List<dim,N-1>::solution_points(points);
+    points.resize(N+1);
+    points[N].resize(N);
+    for (int i=0; i<N; ++i)
+      points[N][i] = geom.solution_pts_1d_host(i);
+  }
+
+}; // struct SDM_Geometry_List
+
+template<int dim>
+struct SDM_Geometry_List<dim,0>
+{
+  void init() {}
+  void solution_points(std::vector<std::vector<real_t> >& points) const { UNUSED(points); }
+}; // struct SDM_Geometry_List<dim,0>
+
+/**
+ * Lagrange interpolation matrices between the 1D solution points of order
+ * M (M in [1,N], first index) and the 1D solution points of order N.
+ */
+template<int dim, int N>
+struct PAdaptive_Matrices
+{
+
+  using Matrix = Kokkos::View<real_t***, Device>;
+
+  //! sol2max(M,i,j) : i-th Lagrange polynomial of order M at j-th point of order N
+  Matrix sol2max;
+
+  //! max2sol(M,i,j) : i-th Lagrange polynomial of order N at j-th point of order M
+  Matrix max2sol;
+
+  //! projection(M,i,j) : interpolation at order M and back at order N,
+  //! i.e. sum over m of max2sol(M,i,m) * sol2max(M,m,j)
+  Matrix projection;
+
+  //! max2sol_l2(M,i,j) : L2 projection on polynomials of degree M-1 of
+  //! the i-th Lagrange polynomial of order N, at j-th point of order M
+  //! (preserves integrals over [0,1], identity for M = N)
+  Matrix max2sol_l2;
+
+  void init(const SDM_Geometry_List<dim,N>& geometries)
+  {
+
+    std::vector<std::vector<real_t> > points;
+    geometries.solution_points(points);
+
+    sol2max    = Matrix("sol2max",    N+1, N, N);
+    max2sol    = Matrix("max2sol",    N+1, N, N);
+    projection = Matrix("projection", N+1, N, N);
+    max2sol_l2 = Matrix("max2sol_l2", N+1, N, N);
+
+    typename Matrix::HostMirror sol2max_h    = Kokkos::create_mirror(sol2max);
+    typename Matrix::HostMirror max2sol_h    = Kokkos::create_mirror(max2sol);
+    typename Matrix::HostMirror projection_h = Kokkos::create_mirror(projection);
+    typename Matrix::HostMirror max2sol_l2_h = Kokkos::create_mirror(max2sol_l2);
+
+    // Gauss-Legendre quadrature with N points on [0,1] : exact for the
+    // products of Lagrange polynomials of order N (degree N-1) and
+    // Legendre polynomials of degree < N
+    std::vector<double> xq, wq;
+    gauss_legendre(N, xq, wq);
+
+    for (int M=1; M<=N; ++M) {
+
+      for (int i=0; i<M; ++i)
+	for (int j=0; j<N; ++j)
+	  sol2max_h(M,i,j) = lagrange(points[M], i, points[N][j]);
+
+      for (int i=0; i<N; ++i)
+	for (int j=0; j<M; ++j)
+	  max2sol_h(M,i,j) = lagrange(points[N], i, points[M][j]);
+
+      for (int i=0; i<N; ++i)
+	for (int j=0; j<N; ++j) {
+	  real_t val = 0;
+	  for (int m=0; m<M; ++m)
+	    val += max2sol_h(M,i,m) * sol2max_h(M,m,j);
+	  projection_h(M,i,j) = val;
+	}
+
+      // L2 projection : sum over n < M of (2n+1) <l_i, P_n> P_n, P_n
+      // being the Legendre polynomial of degree n on [0,1]
+      for (int i=0; i<N; ++i)
+	for (int j=0; j<M; ++j) {
+	  double val = 0;
+	  if (M == N) {
+	    val = i == j ? 1.0 : 0.0;
+	  } else {
+	    for (int n=0; n<M; ++n) {
+	      double dot = 0;
+	      for (size_t q=0; q<xq.size(); ++q)
+		dot += wq[q] * lagrange(points[N], i, xq[q]) * legendre(n, xq[q]);
+	      val += (2*n+1) * dot * legendre(n, points[M][j]);
+	    }
+	  }
+	  max2sol_l2_h(M,i,j) = val;
+	}
+
+    }
+
+    Kokkos::deep_copy(sol2max,    sol2max_h);
+    Kokkos::deep_copy(max2sol,    max2sol_h);
+    Kokkos::deep_copy(projection, projection_h);
+    Kokkos::deep_copy(max2sol_l2, max2sol_l2_h);
+
+  } // init
+
+  /**
+   * i-th Lagrange polynomial of the given nodes, evaluated at x
+   *
+   * l_i(x) = \Pi_{k \neq i} \frac{x-x_k}{x_i-x_k}
+   *
+   * (exactly 0 or 1 when x is one of the nodes)
+   */
+  static real_t lagrange(const std::vector<real_t>& nodes, int i, real_t x)
+  {
+    real_t l = 1.0;
+    for (size_t k=0; k<nodes.size(); ++k)
+      if ((int) k != i)
+	l *= (x-nodes[k])/(nodes[i]-nodes[k]);
+    return l;
+  }
+
+  //! Legendre polynomial of degree n on [0,1], evaluated at x
+  static double legendre(int n, double x)
+  {
+    // Bonnet recursion on [-1,1]
+    const double t = 2*x-1;
+    double p0 = 1.0, p1 = t;
+    if (n == 0)
+      return p0;
+    for (int k=1; k<n; ++k) {
+      const double p2 = ((2*k+1)*t*p1 - k*p0)/(k+1);
+      p0 = p1;
+      p1 = p2;
+    }
+    return p1;
+  }
+
+  //! n points Gauss-Legendre quadrature on [0,1] (weights sum to 1)
+  static void gauss_legendre(int n, std::vector<double>& x, std::vector<double>& w)
+  {
+    x.resize(n);
+    w.resize(n);
+    for (int q=0; q<n; ++q) {
+      // Newton iterations on [-1,1], from Chebyshev points
+      double t = cos(M_PI*(q+0.75)/(n+0.5));
+      double dp = 1.0;
+      for (int iter=0; iter<100; ++iter) {
+	double p0 = 1.0, p1 = t;
+	for (int k=1; k<n; ++k) {
+	  const double p2 = ((2*k+1)*t*p1 - k*p0)/(k+1);
+	  p0 = p1;
+	  p1 = p2;
+	}
+	dp = n*(t*p1 - p0)/(t*t-1);
+	const double dt = p1/dp;
+	t -= dt;
+	if (fabs(dt) < 1e-15)
+	  break;
+      }
+      x[q] = 0.5*(1-t);
+      w[q] = 1.0/((1-t*t)*dp*dp);
+    }
+  }
+
+}; // struct PAdaptive_Matrices
+
+/**
+ * Base class of the functors working on cells of order M of a DofStore
+ * (N is the maximum order).
+ *
+ * Along direction dir, the M^dim solution points of a cell are seen as
+ * M^(dim-1) lines of M points; line l has tangential coordinates
+ * (l%M, l/M) in increasing axis order, and the points of order N of a
+ * face are ordered the same way (A + N*B).
+ */
+template<int dim, int N, int M>
+class PAdaptiveBaseFunctor : public SDMBaseFunctor<dim,M> {
+
+public:
+  using typename SDMBaseFunctor<dim,M>::DataArray;
+  using typename SDMBaseFunctor<dim,M>::HydroState;
+  using Matrix = typename PAdaptive_Matrices<dim,N>::Matrix;
+
+  ////// static constexpr are not supported by nvcc /////
+  enum {
+    nbvar       = NbVar<dim>::value,
+    NB_LINES    = dim==2 ? M   : M*M,   //!< lines of solution points along a direction
+    NB_SOL_PTS  = dim==2 ? M*M : M*M*M, //!< solution points of a cell of order M
+    NB_FACE_PTS = dim==2 ? N   : N*N,   //!< face points of order N
+    NB_MAX_PTS  = dim==2 ? N*N : N*N*N  //!< solution points of a cell of order N
+  };
+
+  PAdaptiveBaseFunctor(HydroParams               params,
+		       SDM_Geometry<dim,M>       sdm_geom,
+		       PAdaptive_Matrices<dim,N> matrices,
+		       DofOffsets                offsets) :
+    SDMBaseFunctor<dim,M>(params,sdm_geom),
+    matrices(matrices),
+    offsets(offsets),
+    cellList()
+  {};
+
+  //! cell coordinates from flat index
+  KOKKOS_INLINE_FUNCTION
+  void cell_coords(int index, int& i, int& j, int& k) const
+  {
+    k = 0;
+    if (dim==2)
+      index2coord(index,i,j,this->params.isize,this->params.jsize);
+    else
+      index2coord(index,i,j,k,this->params.isize,this->params.jsize,this->params.ksize);
+  }
+
+  //! flat index from cell coordinates
+  KOKKOS_INLINE_FUNCTION
+  int cell_index(int i, int j, int k) const
+  {
+    return dim==2 ?
+      coord2index(i,j,this->params.isize,this->params.jsize) :
+      coord2index(i,j,k,this->params.isize,this->params.jsize,this->params.ksize);
+  }
+
+  //! true for cells of the sub-domain interior
+  KOKKOS_INLINE_FUNCTION
+  bool is_interior(int i, int j, int k) const
+  {
+    const int gw = this->params.ghostWidth;
+    return
+      i >= gw and i < this->params.isize-gw and
+      j >= gw and j < this->params.jsize-gw and
+      (dim==2 or (k >= gw and k < this->params.ksize-gw));
+  }
+
+  //! element of a 2D / 3D data array
+  KOKKOS_INLINE_FUNCTION
+  static storage_t& data_at(const DataArray2d& a, int i, int j, int k, int iv)
+  {
+    UNUSED(k);
+    return a(i,j,iv);
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  static storage_t& data_at(const DataArray3d& a, int i, int j, int k, int iv)
+  {
+    return a(i,j,k,iv);
+  }
+
+  //! DoF index (inside a cell) of point p of line l along direction dir
+  KOKKOS_INLINE_FUNCTION
+  static int line_dof(int dir, int l, int p, int ivar)
+  {
+    const int a = l % M;
+    const int b = l / M;
+    return
+      dir == IX ? DofMap<dim,M>(p,a,b,ivar) :
+      dir == IY ? DofMap<dim,M>(a,p,b,ivar) :
+                  DofMap<dim,M>(a,b,p,ivar);
+  }
+
+  //! Euler flux along direction dir
+  KOKKOS_INLINE_FUNCTION
+  static void flux_along(int dir, const HydroState2d& q, real_t p, HydroState2d& flux)
+  {
+    if (dir == IX)
+      ppkMHD::EulerEquations<2>::flux_x(q, p, flux);
+    else
+      ppkMHD::EulerEquations<2>::flux_y(q, p, flux);
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  static void flux_along(int dir, const HydroState3d& q, real_t p, HydroState3d& flux)
+  {
+    if (dir == IX)
+      ppkMHD::EulerEquations<3>::flux_x(q, p, flux);
+    else if (dir == IY)
+      ppkMHD::EulerEquations<3>::flux_y(q, p, flux);
+    else
+      ppkMHD::EulerEquations<3>::flux_z(q, p, flux);
+  }
+
+  /**
+   * Interpolate values at the Nin^dim solution points of order Nin at
+   * the Nout^dim solution points of order Nout, one direction after the
+   * other; mat(m,a,b) is the value of the a-th Lagrange polynomial (order
+   * Nin) at the b-th point (order Nout).
+   */
+  template<int Nin, int Nout>
+  KOKKOS_INLINE_FUNCTION
+  void tensor_interpolate(const Matrix& mat, int m,
+			  const Kokkos::Array<real_t, dim==2 ? Nin*Nin : Nin*Nin*Nin>& in,
+			  Kokkos::Array<real_t, dim==2 ? Nout*Nout : Nout*Nout*Nout>& out) const
+  {
+
+    const int Nc = dim==2 ? 1 : Nin;
+
+    // along X
+    Kokkos::Array<real_t, dim==2 ? Nout*Nin : Nout*Nin*Nin> t1;
+    for (int c=0; c<Nc; ++c)
+      for (int b=0; b<Nin; ++b)
+	for (int X=0; X<Nout; ++X) {
+	  real_t val = 0;
+	  for (int a=0; a<Nin; ++a)
+	    val += in[a+Nin*(b+Nin*c)] * mat(m,a,X);
+	  t1[X+Nout*(b+Nin*c)] = val;
+	}
+
+    // along Y
+    Kokkos::Array<real_t, dim==2 ? Nout*Nout : Nout*Nout*Nin> t2;
+    for (int c=0; c<Nc; ++c)
+      for (int Y=0; Y<Nout; ++Y)
+	for (int X=0; X<Nout; ++X) {
+	  real_t val = 0;
+	  for (int b=0; b<Nin; ++b)
+	    val += t1[X+Nout*(b+Nin*c)] * mat(m,b,Y);
+	  t2[X+Nout*(Y+Nout*c)] = val;
+	}
+
+    if (dim==2) {
+      for (int p=0; p<Nout*Nout; ++p)
+	out[p] = t2[p];
+      return;
+    }
+
+    // along Z
+    for (int Z=0; Z<Nout; ++Z)
+      for (int Y=0; Y<Nout; ++Y)
+	for (int X=0; X<Nout; ++X) {
+	  real_t val = 0;
+	  for (int c=0; c<Nc; ++c)
+	    val += t2[X+Nout*(Y+Nout*c)] * mat(m,c,Z);
+	  out[X+Nout*(Y+Nout*Z)] = val;
+	}
+
+  } // tensor_interpolate
+
+  PAdaptive_Matrices<dim,N> matrices;
+  DofOffsets                offsets;
+
+  //! cells visited (the functors are launched over a range of this list)
+  CellList                  cellList;
+
+}; // class PAdaptiveBaseFunctor
+
+/*************************************************/
+/*************************************************/
+/*************************************************/
+/**
+ * Select the order of each cell from the solution of order N (Udata) :
+ * the order is lowered from N down to min_order as long as interpolating
+ * density and energy at the lower order and back changes them by less
+ * than tolerance times their maximum in the cell (smoothness indicator
+ * measuring the content of the highest modes).
+ *
+ * Ghost cells are of order N.
+ */
+template<int dim, int N>
+class PAdaptive_Order_Functor : public PAdaptiveBaseFunctor<dim,N,N> {
+
+public:
+  using Base = PAdaptiveBaseFunctor<dim,N,N>;
+  using typename Base::DataArray;
+
+  PAdaptive_Order_Functor(HydroParams               params,
+			  SDM_Geometry<dim,N>       sdm_geom,
+			  PAdaptive_Matrices<dim,N> matrices,
+			  DataArray                 Udata,
+			  CellList                  CellOrder,
+			  int                       min_order,
+			  real_t                    tolerance) :
+    Base(params, sdm_geom, matrices, DofOffsets()),
+    Udata(Udata),
+    CellOrder(CellOrder),
+    min_order(min_order),
+    tolerance(tolerance)
+  {};
+
+  // static method which does it all: create and execute functor
+  static void apply(HydroParams               params,
+		    SDM_Geometry<dim,N>       sdm_geom,
+		    PAdaptive_Matrices<dim,N> matrices,
+		    DataArray                 Udata,
+		    CellList                  CellOrder,
+		    int                       min_order,
+		    real_t                    tolerance)
+  {
+    PAdaptive_Order_Functor functor(params, sdm_geom, matrices, Udata, CellOrder,
+				    min_order, tolerance);
+    Kokkos::parallel_for("PAdaptive_Order_Functor",
+                         md_policy<dim>(0, 0, 0,
+                                        params.isize, params.jsize, params.ksize,
+                                        params.mdrange_tile),
+                         functor);
+  }
+
+  //! functor for 2d
+  template<int dim_ = dim>
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const typename std::enable_if<dim_==2, int>::type& i,
+                  const int& j) const
+  {
+    cell(i,j,0);
+  }
+
+  //! functor for 3d
+  template<int dim_ = dim>
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const typename std::enable_if<dim_==3, int>::type& i,
+                  const int& j,
+                  const int& k) const
+  {
+    cell(i,j,k);
+  }
+
+  //! work for one cell (2d and 3d)
+  KOKKOS_INLINE_FUNCTION
+  void cell(int i, int j, int k) const
+  {
+
+    const int index = this->cell_index(i,j,k);
+
+    if (!this->is_interior(i,j,k)) {
+      CellOrder(index) = N;
+      return;
+    }
+
+    // density and energy
+    Kokkos::Array<real_t, Base::NB_MAX_PTS> u[2], pu;
+    real_t umax[2] = {0, 0};
+
+    for (int v=0; v<2; ++v) {
+      const int ivar = v==0 ? ID : IE;
+      for (int p=0; p<Base::NB_MAX_PTS; ++p) {
+	u[v][p] = this->data_at(Udata,i,j,k, p + Base::NB_MAX_PTS*ivar);
+	umax[v] = fmax(umax[v], fabs(u[v][p]));
+      }
+    }
+
+    // lower the order while the relative change of the worst variable
+    // remains below tolerance
+    int order = N;
+
+    for (int m = N-1; m >= min_order; --m) {
+
+      real_t err = 0;
+      for (int v=0; v<2; ++v) {
+	this->template tensor_interpolate<N,N>(this->matrices.projection, m, u[v], pu);
+	for (int p=0; p<Base::NB_MAX_PTS; ++p)
+	  err = fmax(err, fabs(u[v][p]-pu[p]) / fmax(umax[v], 1e-30));
+      }
+
+      if (err > tolerance)
+	break;
+
+      order = m;
+
+    } // end for m
+
+    CellOrder(index) = order;
+
+  } // operator ()
+
+  DataArray Udata;
+  CellList  CellOrder;
+  int       min_order;
+  real_t    tolerance;
+
+}; // class PAdaptive_Order_Functor
+
+/*************************************************/
+/*************************************************/
+/*************************************************/
+/**
+ * Buffer layer : the order of an interior cell is raised to the highest
+ * order of its interior face neighbors, so that features moving out of
+ * a cell enter a cell of the same order.
+ */
+template<int dim, int N>
+class PAdaptive_Order_Buffer_Functor : public PAdaptiveBaseFunctor<dim,N,N> {
+
+public:
+  using Base = PAdaptiveBaseFunctor<dim,N,N>;
+
+  PAdaptive_Order_Buffer_Functor(HydroParams               params,
+				 SDM_Geometry<dim,N>       sdm_geom,
+				 PAdaptive_Matrices<dim,N> matrices,
+				 CellList                  CellOrderIn,
+				 CellList                  CellOrderOut) :
+    Base(params, sdm_geom, matrices, DofOffsets()),
+    CellOrderIn(CellOrderIn),
+    CellOrderOut(CellOrderOut)
+  {};
+
+  // static method which does it all: create and execute functor
+  static void apply(HydroParams               params,
+		    SDM_Geometry<dim,N>       sdm_geom,
+		    PAdaptive_Matrices<dim,N> matrices,
+		    CellList                  CellOrderIn,
+		    CellList                  CellOrderOut)
+  {
+    PAdaptive_Order_Buffer_Functor functor(params, sdm_geom, matrices,
+					   CellOrderIn, CellOrderOut);
+    Kokkos::parallel_for("PAdaptive_Order_Buffer_Functor",
+                         md_policy<dim>(0, 0, 0,
+                                        params.isize, params.jsize, params.ksize,
+                                        params.mdrange_tile),
+                         functor);
+  }
+
+  //! functor for 2d
+  template<int dim_ = dim>
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const typename std::enable_if<dim_==2, int>::type& i,
+                  const int& j) const
+  {
+    cell(i,j,0);
+  }
+
+  //! functor for 3d
+  template<int dim_ = dim>
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const typename std::enable_if<dim_==3, int>::type& i,
+                  const int& j,
+                  const int& k) const
+  {
+    cell(i,j,k);
+  }
+
+  //! work for one cell (2d and 3d)
+  KOKKOS_INLINE_FUNCTION
+  void cell(int i, int j, int k) const
+  {
+
+    const int index = this->cell_index(i,j,k);
+
+    int order = CellOrderIn(index);
+
+    if (this->is_interior(i,j,k)) {
+
+      for (int d=0; d<dim; ++d) {
+	for (int s=-1; s<=1; s+=2) {
+	  const int ii = i + (d==IX ? s : 0);
+	  const int jj = j + (d==IY ? s : 0);
+	  const int kk = k + (d==IZ ? s : 0);
+	  if (this->is_interior(ii,jj,kk)) {
+	    const int neighbor = CellOrderIn(this->cell_index(ii,jj,kk));
+	    order = order > neighbor ? order : neighbor;
+	  }
+	}
+      }
+
+    }
+
+    CellOrderOut(index) = order;
+
+  } // operator ()
+
+  CellList CellOrderIn;
+  CellList CellOrderOut;
+
+}; // class PAdaptive_Order_Buffer_Functor
+
+/*************************************************/
+/*************************************************/
+/*************************************************/
+/**
+ * Flag the interior cells of a given order (used to build the list of
+ * cells grouped by order with Compact_Cell_List_Functor); order 0 flags
+ * the ghost cells.
+ */
+template<int dim>
+class PAdaptive_Order_Flags_Functor {
+
+public:
+
+  PAdaptive_Order_Flags_Functor(HydroParams params,
+				CellList    CellOrder,
+				CellList    CellFlags,
+				int         order) :
+    params(params),
+    CellOrder(CellOrder),
+    CellFlags(CellFlags),
+    order(order)
+  {};
+
+  // static method which does it all: create and execute functor
+  static void apply(HydroParams params,
+		    CellList    CellOrder,
+		    CellList    CellFlags,
+		    int         order)
+  {
+    PAdaptive_Order_Flags_Functor functor(params, CellOrder, CellFlags, order);
+    Kokkos::parallel_for("PAdaptive_Order_Flags_Functor",
+                         md_policy<dim>(0, 0, 0,
+                                        params.isize, params.jsize, params.ksize,
+                                        params.mdrange_tile),
+                         functor);
+  }
+
+  //! functor for 2d
+  template<int dim_ = dim>
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const typename std::enable_if<dim_==2, int>::type& i,
+                  const int& j) const
+  {
+    cell(i,j,0);
+  }
+
+  //! functor for 3d
+  template<int dim_ = dim>
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const typename std::enable_if<dim_==3, int>::type& i,
+                  const int& j,
+                  const int& k) const
+  {
+    cell(i,j,k);
+  }
+
+  //! work for one cell (2d and 3d)
+  KOKKOS_INLINE_FUNCTION
+  void cell(int i, int j, int k) const
+  {
+
+    const int isize = params.isize;
+    const int jsize = params.jsize;
+    const int ksize = params.ksize;
+    const int gw    = params.ghostWidth;
+
+    // flat cell index, as used by the cell list
+    const int index = dim==2 ?
+      coord2index(i,j,isize,jsize) :
+      coord2index(i,j,k,isize,jsize,ksize);
+
+    const bool interior =
+      i >= gw and i < isize-gw and
+      j >= gw and j < jsize-gw and
+      (dim==2 or (k >= gw and k < ksize-gw));
+
+    if (order == 0)
+      CellFlags(index) = interior ? 0 : 1;
+    else
+      CellFlags(index) = (interior and CellOrder(index) == order) ? 1 : 0;
+
+  } // operator ()
+
+  HydroParams params;
+  CellList    CellOrder;
+  CellList    CellFlags;
+  int         order;
+
+}; // class PAdaptive_Order_Flags_Functor
+
+/*************************************************/
+/*************************************************/
+/*************************************************/
+/**
+ * DoF offsets : exclusive prefix sum of the number of DoFs of the cells,
+ * taken in the order of the cell list (cells of a given order are then
+ * contiguous in the DoF store, ghost cells last).
+ *
+ * The total number of DoFs is returned by apply.
+ */
+template<int dim>
+class PAdaptive_Offsets_Functor {
+
+public:
+  using CountView = Kokkos::View<int64_t, Device>;
+
+  enum { nbvar = NbVar<dim>::value };
+
+  PAdaptive_Offsets_Functor(CellList   cellList,
+			    CellList   CellOrder,
+			    DofOffsets offsets,
+			    CountView  total,
+			    int        nbCells) :
+    cellList(cellList),
+    CellOrder(CellOrder),
+    offsets(offsets),
+    total(total),
+    nbCells(nbCells)
+  {};
+
+  // static method which does it all: create and execute functor
+  static int64_t apply(CellList   cellList,
+		       CellList   CellOrder,
+		       DofOffsets offsets,
+		       int        nbCells)
+  {
+    CountView total("nbDofs");
+
+    PAdaptive_Offsets_Functor functor(cellList, CellOrder, offsets, total, nbCells);
+    Kokkos::parallel_scan("PAdaptive_Offsets_Functor", nbCells, functor);
+
+    CountView::HostMirror total_h = Kokkos::create_mirror_view(total);
+    Kokkos::deep_copy(total_h, total);
+
+    return total_h();
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const int& ilist, int64_t& update, const bool final) const
+  {
+    const int index = cellList(ilist);
+    const int order = CellOrder(index);
+    const int64_t size = (dim==2 ? order*order : order*order*order) * nbvar;
+
+    if (final) {
+      offsets(index) = update;
+      if (ilist == nbCells-1)
+	total() = update + size;
+    }
+
+    update += size;
+  }
+
+  CellList   cellList;
+  CellList   CellOrder;
+  DofOffsets offsets;
+  CountView  total;
+  int        nbCells;
+
+}; // class PAdaptive_Offsets_Functor
+
+/*************************************************/
+/*************************************************/
+/*************************************************/
+/**
+ * Copy cells of order M from a data array of order N (Udata) into the
+ * DoF store, with the L2 projection at order M (cell integrals are
+ * preserved).
+ */
+template<int dim, int N, int M>
+class PAdaptive_Pack_Functor : public PAdaptiveBaseFunctor<dim,N,M> {
+
+public:
+  using Base = PAdaptiveBaseFunctor<dim,N,M>;
+  using typename Base::DataArray;
+
+  PAdaptive_Pack_Functor(HydroParams               params,
+			 SDM_Geometry<dim,M>       sdm_geom,
+			 PAdaptive_Matrices<dim,N> matrices,
+			 DofOffsets                offsets,
+			 DataArray                 Udata,
+			 DofStore                  Ustore) :
+    Base(params, sdm_geom, matrices, offsets),
+    Udata(Udata),
+    Ustore(Ustore)
+  {};
+
+  // static method which does it all: create and execute functor
+  // on cells [begin, begin+count[ of cellList
+  static void apply(HydroParams               params,
+		    SDM_Geometry<dim,M>       sdm_geom,
+		    PAdaptive_Matrices<dim,N> matrices,
+		    DofOffsets                offsets,
+		    DataArray                 Udata,
+		    DofStore                  Ustore,
+		    CellList                  cellList,
+		    int                       begin,
+		    int                       count)
+  {
+    PAdaptive_Pack_Functor functor(params, sdm_geom, matrices, offsets, Udata, Ustore);
+    functor.cellList = cellList;
+    Kokkos::parallel_for("PAdaptive_Pack_Functor",
+			 Kokkos::RangePolicy<Device,TagCellList>(begin,begin+count),
+			 functor);
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const TagCellList&, const int& ilist) const
+  {
+
+    const int index = this->cellList(ilist);
+    int i,j,k;
+    this->cell_coords(index,i,j,k);
+
+    const int64_t off = this->offsets(index);
+
+    Kokkos::Array<real_t, Base::NB_MAX_PTS> in;
+    Kokkos::Array<real_t, Base::NB_SOL_PTS> out;
+
+    for (int ivar=0; ivar<Base::nbvar; ++ivar) {
+
+      for (int p=0; p<Base::NB_MAX_PTS; ++p)
+	in[p] = this->data_at(Udata,i,j,k, p + Base::NB_MAX_PTS*ivar);
+
+      if (M == N) {
+	for (int p=0; p<Base::NB_SOL_PTS; ++p)
+	  out[p] = in[p];
+      } else {
+	this->template tensor_interpolate<N,M>(this->matrices.max2sol_l2, M, in, out);
+      }
+
+      for (int p=0; p<Base::NB_SOL_PTS; ++p)
+	Ustore(off + p + Base::NB_SOL_PTS*ivar) = out[p];
+
+    }
+
+  } // operator ()
+
+  DataArray Udata;
+  DofStore  Ustore;
+
+}; // class PAdaptive_Pack_Functor
+
+/*************************************************/
+/*************************************************/
+/*************************************************/
+/**
+ * Copy cells of order M from the DoF store into a data array of order
+ * N (Udata), interpolating at the solution points of order N (exact).
+ *
+ * If border_only is true, only cells closer than 2 ghostWidth to the
+ * sub-domain border are copied (cells used to fill ghost cells).
+ */
+template<int dim, int N, int M>
+class PAdaptive_Unpack_Functor : public PAdaptiveBaseFunctor<dim,N,M> {
+
+public:
+  using Base = PAdaptiveBaseFunctor<dim,N,M>;
+  using typename Base::DataArray;
+
+  PAdaptive_Unpack_Functor(HydroParams               params,
+			   SDM_Geometry<dim,M>       sdm_geom,
+			   PAdaptive_Matrices<dim,N> matrices,
+			   DofOffsets                offsets,
+			   DofStore                  Ustore,
+			   DataArray                 Udata,
+			   bool                      border_only) :
+    Base(params, sdm_geom, matrices, offsets),
+    Ustore(Ustore),
+    Udata(Udata),
+    border_only(border_only)
+  {};
+
+  // static method which does it all: create and execute functor
+  // on cells [begin, begin+count[ of cellList
+  static void apply(HydroParams               params,
+		    SDM_Geometry<dim,M>       sdm_geom,
+		    PAdaptive_Matrices<dim,N> matrices,
+		    DofOffsets                offsets,
+		    DofStore                  Ustore,
+		    DataArray                 Udata,
+		    bool                      border_only,
+		    CellList                  cellList,
+		    int                       begin,
+		    int                       count)
+  {
+    PAdaptive_Unpack_Functor functor(params, sdm_geom, matrices, offsets,
+				     Ustore, Udata, border_only);
+    functor.cellList = cellList;
+    Kokkos::parallel_for("PAdaptive_Unpack_Functor",
+			 Kokkos::RangePolicy<Device,TagCellList>(begin,begin+count),
+			 functor);
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const TagCellList&, const int& ilist) const
+  {
+
+    const int index = this->cellList(ilist);
+    int i,j,k;
+    this->cell_coords(index,i,j,k);
+
+    if (border_only) {
+      const int gw2 = 2*this->params.ghostWidth;
+      const bool border =
+	i < gw2 or i >= this->params.isize-gw2 or
+	j < gw2 or j >= this->params.jsize-gw2 or
+	(dim==3 and (k < gw2 or k >= this->params.ksize-gw2));
+      if (!border)
+	return;
+    }
+
+    const int64_t off = this->offsets(index);
+
+    Kokkos::Array<real_t, Base::NB_SOL_PTS> in;
+    Kokkos::Array<real_t, Base::NB_MAX_PTS> out;
+
+    for (int ivar=0; ivar<Base::nbvar; ++ivar) {
+
+      for (int p=0; p<Base::NB_SOL_PTS; ++p)
+	in[p] = Ustore(off + p + Base::NB_SOL_PTS*ivar);
+
+      if (M == N) {
+	for (int p=0; p<Base::NB_MAX_PTS; ++p)
+	  out[p] = in[p];
+      } else {
+	this->template tensor_interpolate<M,N>(this->matrices.sol2max, M, in, out);
+      }
+
+      for (int p=0; p<Base::NB_MAX_PTS; ++p)
+	this->data_at(Udata,i,j,k, p + Base::NB_MAX_PTS*ivar) = out[p];
+
+    }
+
+  } // operator ()
+
+  DofStore  Ustore;
+  DataArray Udata;
+  bool      border_only;
+
+}; // class PAdaptive_Unpack_Functor
+
+/*************************************************/
+/*************************************************/
+/*************************************************/
+/**
+ * Face traces along direction dir of cells of order M : conservative
+ * variables interpolated at the flux points 0 (side 0) and M (side 1)
+ * of each line, then at the N^(dim-1) face points of order N.
+ *
+ * Traces(cell, pt + NB_FACE_PTS*(ivar + nbvar*side))
+ */
+template<int dim, int N, int M, int dir>
+class PAdaptive_Trace_Functor : public PAdaptiveBaseFunctor<dim,N,M> {
+
+public:
+  using Base = PAdaptiveBaseFunctor<dim,N,M>;
+  using typename Base::DataArray;
+  using typename Base::solution_values_t;
+
+  PAdaptive_Trace_Functor(HydroParams               params,
+			  SDM_Geometry<dim,M>       sdm_geom,
+			  PAdaptive_Matrices<dim,N> matrices,
+			  DofOffsets                offsets,
+			  DofStore                  Ustore,
+			  DataArray                 Traces) :
+    Base(params, sdm_geom, matrices, offsets),
+    Ustore(Ustore),
+    Traces(Traces)
+  {};
+
+  // static method which does it all: create and execute functor
+  // on cells [begin, begin+count[ of cellList
+  static void apply(HydroParams               params,
+		    SDM_Geometry<dim,M>       sdm_geom,
+		    PAdaptive_Matrices<dim,N> matrices,
+		    DofOffsets                offsets,
+		    DofStore                  Ustore,
+		    DataArray                 Traces,
+		    CellList                  cellList,
+		    int                       begin,
+		    int                       count)
+  {
+    PAdaptive_Trace_Functor functor(params, sdm_geom, matrices, offsets, Ustore, Traces);
+    functor.cellList = cellList;
+    Kokkos::parallel_for("PAdaptive_Trace_Functor",
+			 Kokkos::RangePolicy<Device,TagCellList>(begin,begin+count),
+			 functor);
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const TagCellList&, const int& ilist) const
+  {
+
+    const int index = this->cellList(ilist);
+    int i,j,k;
+    this->cell_coords(index,i,j,k);
+
+    const int64_t off = this->offsets(index);
+    const real_t smallr = this->params.settings.smallr;
+
+    solution_values_t sol;
+
+    for (int ivar=0; ivar<Base::nbvar; ++ivar) {
+
+      // values at both ends of each line
+      Kokkos::Array<real_t, Base::NB_LINES> trace[2];
+
+      for (int l=0; l<Base::NB_LINES; ++l) {
+
+	for (int p=0; p<M; ++p)
+	  sol[p] = Ustore(off + this->line_dof(dir,l,p,ivar));
+
+	trace[0][l] = this->sol2flux(sol, 0);
+	trace[1][l] = this->sol2flux(sol, M);
+
+      }
+
+      // interpolate at the face points of order N
+      for (int side=0; side<2; ++side) {
+
+	for (int pt=0; pt<Base::NB_FACE_PTS; ++pt) {
+
+	  real_t val = 0;
+
+	  if (M == N) {
+	    val = trace[side][pt];
+	  } else {
+	    const int A = pt % N;
+	    const int B = pt / N;
+	    for (int l=0; l<Base::NB_LINES; ++l) {
+	      const real_t wb = dim==2 ? 1.0 : this->matrices.sol2max(M, l/M, B);
+	      val += trace[side][l] * this->matrices.sol2max(M, l%M, A) * wb;
+	    }
+	  }
+
+	  // positivity preserving for density
+	  if (ivar==ID)
+	    val = fmax(val, smallr);
+
+	  this->data_at(Traces,i,j,k, pt + Base::NB_FACE_PTS*(ivar + Base::nbvar*side)) = val;
+
+	}
+
+      } // end for side
+
+    } // end for ivar
+
+  } // operator ()
+
+  DofStore  Ustore;
+  DataArray Traces;
+
+}; // class PAdaptive_Trace_Functor
+
+/*************************************************/
+/*************************************************/
+/*************************************************/
+/**
+ * Riemann problems at the faces of order N normal to direction dir,
+ * between the face traces (side 1) of the left neighbor and the face
+ * traces (side 0) of the current cell; the flux is stored in the
+ * current cell, FaceFlux(cell, pt + NB_FACE_PTS*ivar).
+ *
+ * Only faces of interior cells are computed.
+ */
+template<int dim, int N, int dir>
+class PAdaptive_Riemann_Functor : public PAdaptiveBaseFunctor<dim,N,N> {
+
+public:
+  using Base = PAdaptiveBaseFunctor<dim,N,N>;
+  using typename Base::DataArray;
+  using typename Base::HydroState;
+
+  PAdaptive_Riemann_Functor(HydroParams                 params,
+			    SDM_Geometry<dim,N>         sdm_geom,
+			    PAdaptive_Matrices<dim,N>   matrices,
+			    ppkMHD::EulerEquations<dim> euler,
+			    DataArray                   Traces,
+			    DataArray                   FaceFlux) :
+    Base(params, sdm_geom, matrices, DofOffsets()),
+    euler(euler),
+    Traces(Traces),
+    FaceFlux(FaceFlux)
+  {};
+
+  // static method which does it all: create and execute functor
+  static void apply(HydroParams                 params,
+		    SDM_Geometry<dim,N>         sdm_geom,
+		    PAdaptive_Matrices<dim,N>   matrices,
+		    ppkMHD::EulerEquations<dim> euler,
+		    DataArray                   Traces,
+		    DataArray                   FaceFlux)
+  {
+    PAdaptive_Riemann_Functor functor(params, sdm_geom, matrices, euler,
+				      Traces, FaceFlux);
+
+    // faces of interior cells : one more face along dir
+    const int gw = params.ghostWidth;
+    Kokkos::parallel_for("PAdaptive_Riemann_Functor",
+                         md_policy<dim>(gw, gw, gw,
+                                        params.isize-gw + (dir==IX ? 1 : 0),
+                                        params.jsize-gw + (dir==IY ? 1 : 0),
+                                        params.ksize-gw + (dir==IZ ? 1 : 0),
+                                        params.mdrange_tile),
+                         functor);
+  }
+
+  //! functor for 2d
+  template<int dim_ = dim>
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const typename std::enable_if<dim_==2, int>::type& i,
+                  const int& j) const
+  {
+    cell(i,j,0);
+  }
+
+  //! functor for 3d
+  template<int dim_ = dim>
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const typename std::enable_if<dim_==3, int>::type& i,
+                  const int& j,
+                  const int& k) const
+  {
+    cell(i,j,k);
+  }
+
+  //! work for one cell (2d and 3d)
+  KOKKOS_INLINE_FUNCTION
+  void cell(int i, int j, int k) const
+  {
+    // left neighbor
+    const int il = i - (dir==IX ? 1 : 0);
+    const int jl = j - (dir==IY ? 1 : 0);
+    const int kl = k - (dir==IZ ? 1 : 0);
+
+    // velocity component normal to the face
+    const int IN = dir==IX ? IU : (dir==IY ? IV : IW);
+
+    for (int pt=0; pt<Base::NB_FACE_PTS; ++pt) {
+
+      // conservative state
+      HydroState qL = {}, qR = {};
+
+      // primitive state
+      HydroState wL, wR;
+
+      HydroState qgdnv, flux;
+
+      for (int ivar = 0; ivar<Base::nbvar; ++ivar) {
+	qL[ivar] = this->data_at(Traces,il,jl,kl, pt + Base::NB_FACE_PTS*(ivar + Base::nbvar));
+	qR[ivar] = this->data_at(Traces,i ,j ,k , pt + Base::NB_FACE_PTS*ivar);
+      }
+
+      // convert to primitive
+      euler.convert_to_primitive(qR,wR,this->params.settings.gamma0);
+      euler.convert_to_primitive(qL,wL,this->params.settings.gamma0);
+
+      // riemann solver
+      if (dir != IX) {
+	this->swap( wL[IU], wL[IN] );
+	this->swap( wR[IU], wR[IN] );
+      }
+      ppkMHD::riemann_hydro(wL,wR,qgdnv,flux,this->params);
+      if (dir != IX)
+	this->swap( flux[IU], flux[IN] ); // swap again
+
+      for (int ivar = 0; ivar<Base::nbvar; ++ivar)
+	this->data_at(FaceFlux,i,j,k, pt + Base::NB_FACE_PTS*ivar) = flux[ivar];
+
+    } // end for pt
+
+  } // operator ()
+
+  ppkMHD::EulerEquations<dim> euler;
+  DataArray Traces;
+  DataArray FaceFlux;
+
+}; // class PAdaptive_Riemann_Functor
+
+/*************************************************/
+/*************************************************/
+/*************************************************/
+/**
+ * Flux divergence along direction dir of cells of order M, accumulated
+ * in Ustore_fdiv : Euler flux at interior flux points, common flux
+ * (FaceFlux of the cell and of its right neighbor) interpolated at the
+ * end points, then derivative at solution points.
+ */
+template<int dim, int N, int M, int dir>
+class PAdaptive_Divergence_Functor : public PAdaptiveBaseFunctor<dim,N,M> {
+
+public:
+  using Base = PAdaptiveBaseFunctor<dim,N,M>;
+  using typename Base::DataArray;
+  using typename Base::HydroState;
+  using typename Base::solution_values_t;
+  using typename Base::flux_values_t;
+
+  PAdaptive_Divergence_Functor(HydroParams                 params,
+			       SDM_Geometry<dim,M>         sdm_geom,
+			       PAdaptive_Matrices<dim,N>   matrices,
+			       DofOffsets                  offsets,
+			       ppkMHD::EulerEquations<dim> euler,
+			       DofStore                    Ustore,
+			       DataArray                   FaceFlux,
+			       DofStore                    Ustore_fdiv) :
+    Base(params, sdm_geom, matrices, offsets),
+    euler(euler),
+    Ustore(Ustore),
+    FaceFlux(FaceFlux),
+    Ustore_fdiv(Ustore_fdiv)
+  {};
+
+  // static method which does it all: create and execute functor
+  // on cells [begin, begin+count[ of cellList
+  static void apply(HydroParams                 params,
+		    SDM_Geometry<dim,M>         sdm_geom,
+		    PAdaptive_Matrices<dim,N>   matrices,
+		    DofOffsets                  offsets,
+		    ppkMHD::EulerEquations<dim> euler,
+		    DofStore                    Ustore,
+		    DataArray                   FaceFlux,
+		    DofStore                    Ustore_fdiv,
+		    CellList                    cellList,
+		    int                         begin,
+		    int                         count)
+  {
+    PAdaptive_Divergence_Functor functor(params, sdm_geom, matrices, offsets, euler,
+					 Ustore, FaceFlux, Ustore_fdiv);
+    functor.cellList = cellList;
+    Kokkos::parallel_for("PAdaptive_Divergence_Functor",
+			 Kokkos::RangePolicy<Device,TagCellList>(begin,begin+count),
+			 functor);
+  }
+
+  //! common flux at the face of cell (i,j,k) at line l : L2 projection
+  //! of the flux at the points of order N (same face integral)
+  KOKKOS_INLINE_FUNCTION
+  real_t face_flux(int i, int j, int k, int l, int ivar) const
+  {
+    if (M == N)
+      return this->data_at(FaceFlux,i,j,k, l + Base::NB_FACE_PTS*ivar);
+
+    const int a = l % M;
+    const int b = l / M;
+
+    real_t val = 0;
+    for (int pt=0; pt<Base::NB_FACE_PTS; ++pt) {
+      const real_t wb = dim==2 ? 1.0 : this->matrices.max2sol_l2(M, pt/N, b);
+      val += this->data_at(FaceFlux,i,j,k, pt + Base::NB_FACE_PTS*ivar) *
+	this->matrices.max2sol_l2(M, pt%N, a) * wb;
+    }
+
+    return val;
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const TagCellList&, const int& ilist) const
+  {
+
+    const int index = this->cellList(ilist);
+    int i,j,k;
+    this->cell_coords(index,i,j,k);
+
+    const int64_t off = this->offsets(index);
+
+    // right neighbor
+    const int ir = i + (dir==IX ? 1 : 0);
+    const int jr = j + (dir==IY ? 1 : 0);
+    const int kr = k + (dir==IZ ? 1 : 0);
+
+    // rescale factor for derivative
+    real_t rescale = 1.0/this->params.dx;
+    if (dir == IY)
+      rescale = 1.0/this->params.dy;
+    if (dir == IZ)
+      rescale = 1.0/this->params.dz;
+
+    solution_values_t sol;
+    flux_values_t     flux;
+
+    for (int l=0; l<Base::NB_LINES; ++l) {
+
+      // conservative variables, then fluxes, at flux points of line l
+      Kokkos::Array<HydroState, M+1> q;
+
+      for (int ivar=0; ivar<Base::nbvar; ++ivar) {
+
+	for (int p=0; p<M; ++p)
+	  sol[p] = Ustore(off + this->line_dof(dir,l,p,ivar));
+
+	this->sol2flux_vector(sol, flux);
+
+	// positivity preserving for density
+	if (ivar==ID) {
+	  for (int idf=0; idf<M+1; ++idf)
+	    flux[idf] = fmax(flux[idf], this->params.settings.smallr);
+	}
+
+	for (int idf=0; idf<M+1; ++idf)
+	  q[idf][ivar] = flux[idf];
+
+      }
+
+      // interior flux points
+      for (int idf=1; idf<M; ++idf) {
+	HydroState f;
+	real_t p = euler.compute_pressure(q[idf], this->params.settings.gamma0);
+	this->flux_along(dir, q[idf], p, f);
+	q[idf] = f;
+      }
+
+      // end points : common flux
+      for (int ivar=0; ivar<Base::nbvar; ++ivar) {
+	q[0][ivar] = face_flux(i ,j ,k , l, ivar);
+	q[M][ivar] = face_flux(ir,jr,kr, l, ivar);
+      }
+
+      // derivative at solution points
+      for (int ivar=0; ivar<Base::nbvar; ++ivar) {
+
+	for (int idf=0; idf<M+1; ++idf)
+	  flux[idf] = q[idf][ivar];
+
+	this->flux2sol_derivative_vector(flux, sol, rescale);
+
+	for (int p=0; p<M; ++p)
+	  Ustore_fdiv(off + this->line_dof(dir,l,p,ivar)) += sol[p];
+
+      }
+
+    } // end for l
+
+  } // operator ()
+
+  ppkMHD::EulerEquations<dim> euler;
+  DofStore  Ustore;
+  DataArray FaceFlux;
+  DofStore  Ustore_fdiv;
+
+}; // class PAdaptive_Divergence_Functor
+
+/*************************************************/
+/*************************************************/
+/*************************************************/
+/**
+ * Zhang-Shu positivity preserving of cells of order M (same as
+ * Apply_positivity_Functor_v2, the cell average being computed with the
+ * Gauss-Chebyshev quadrature of order M).
+ */
+template<int dim, int N, int M>
+class PAdaptive_Positivity_Functor : public PAdaptiveBaseFunctor<dim,N,M> {
+
+public:
+  using Base = PAdaptiveBaseFunctor<dim,N,M>;
+  using typename Base::HydroState;
+  using typename Base::solution_values_t;
+  using typename Base::flux_values_t;
+
+  PAdaptive_Positivity_Functor(HydroParams               params,
+			       SDM_Geometry<dim,M>       sdm_geom,
+			       PAdaptive_Matrices<dim,N> matrices,
+			       DofOffsets                offsets,
+			       DofStore                  Ustore) :
+    Base(params, sdm_geom, matrices, offsets),
+    Ustore(Ustore)
+  {};
+
+  // static method which does it all: create and execute functor
+  // on cells [begin, begin+count[ of cellList
+  static void apply(HydroParams               params,
+		    SDM_Geometry<dim,M>       sdm_geom,
+		    PAdaptive_Matrices<dim,N> matrices,
+		    DofOffsets                offsets,
+		    DofStore                  Ustore,
+		    CellList                  cellList,
+		    int                       begin,
+		    int                       count)
+  {
+    PAdaptive_Positivity_Functor functor(params, sdm_geom, matrices, offsets, Ustore);
+    functor.cellList = cellList;
+    Kokkos::parallel_for("PAdaptive_Positivity_Functor",
+			 Kokkos::RangePolicy<Device,TagCellList>(begin,begin+count),
+			 functor);
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const TagCellList&, const int& ilist) const
+  {
+
+    const int index = this->cellList(ilist);
+    const int64_t off = this->offsets(index);
+
+    const real_t gamma0 = this->params.settings.gamma0;
+    const real_t smallr = this->params.settings.smallr;
+
+    /*
+     * cell average (Gauss-Chebyshev quadrature)
+     */
+    HydroState uave;
+
+    for (int ivar=0; ivar<Base::nbvar; ++ivar) {
+
+      real_t tmp = 0.0;
+
+      for (int p=0; p<Base::NB_SOL_PTS; ++p) {
+	real_t val = Ustore(off + p + Base::NB_SOL_PTS*ivar);
+	for (int d=0, q=p; d<dim; ++d, q/=M) {
+	  const real_t x = this->sdm_geom.solution_pts_1d(q%M);
+	  val *= sqrt(x-x*x);
+	}
+	tmp += val;
+      }
+
+      // final scaling
+      tmp *= dim==2 ? (M_PI/M)*(M_PI/M) : (M_PI/M)*(M_PI/M)*(M_PI/M);
+
+      if (ivar == ID)
+	uave[ID] = tmp > smallr ? tmp : smallr;
+      else
+	uave[ivar] = tmp;
+
+    }
+
+    /*
+     * enforce density positivity
+     */
+
+    // minimun density at flux points
+    real_t rho_min;
+#ifdef __CUDA_ARCH__
+    rho_min = CUDART_INF; // something big
+#else
+    rho_min = std::numeric_limits<real_t>::max();
+#endif
+
+    solution_values_t sol;
+    flux_values_t     flux;
+
+    for (int d=0; d<dim; ++d) {
+      for (int l=0; l<Base::NB_LINES; ++l) {
+
+	for (int p=0; p<M; ++p)
+	  sol[p] = Ustore(off + this->line_dof(d,l,p,ID));
+
+	this->sol2flux_vector(sol, flux);
+
+	for (int idf=0; idf<M+1; ++idf)
+	  rho_min = rho_min < flux[idf] ? rho_min : flux[idf];
+
+      }
+    }
+
+    const real_t eps1 = smallr; // a small density
+    const real_t ratio = (uave[ID] - eps1)/(uave[ID] - rho_min) + 1e-13;
+    const real_t theta1 = ratio < 1.0 ? ratio : 1.0;
+
+    if (theta1 < 1.0) {
+      for (int p=0; p<Base::NB_SOL_PTS; ++p) {
+	const real_t rho = Ustore(off + p + Base::NB_SOL_PTS*ID);
+	Ustore(off + p + Base::NB_SOL_PTS*ID) = theta1 * (rho - uave[ID]) + uave[ID];
+      }
+    }
+
+    /*
+     * enforce pressure positivity : theta2 is the min value of t over
+     * all flux points, where t solves a 2nd order equation
+     */
+    real_t theta2 = 1.0;
+
+    const real_t eps2 = 1e-13;
+
+    real_t m2_ave = 0;
+    for (int d=0; d<dim; ++d)
+      m2_ave += uave[IU+d]*uave[IU+d];
+
+    for (int d=0; d<dim; ++d) {
+      for (int l=0; l<Base::NB_LINES; ++l) {
+
+	// conservative variables at flux points
+	Kokkos::Array<HydroState, M+1> q;
+
+	for (int ivar=0; ivar<Base::nbvar; ++ivar) {
+	  for (int p=0; p<M; ++p)
+	    sol[p] = Ustore(off + this->line_dof(d,l,p,ivar));
+	  this->sol2flux_vector(sol, flux);
+	  for (int idf=0; idf<M+1; ++idf)
+	    q[idf][ivar] = flux[idf];
+	}
+
+	for (int idf=0; idf<M+1; ++idf) {
+
+	  const real_t rho = q[idf][ID];
+	  const real_t E   = q[idf][IE];
+
+	  real_t m2 = 0;
+	  for (int c=0; c<dim; ++c)
+	    m2 += q[idf][IU+c]*q[idf][IU+c];
+
+	  const real_t pressure = (gamma0-1)*(E-0.5*m2/rho);
+
+	  if (pressure < 1e-12) {
+
+	    const real_t drho = rho - uave[ID];
+	    const real_t dE   = E   - uave[IE];
+
+	    real_t dm2 = 0, mdm = 0;
+	    for (int c=0; c<dim; ++c) {
+	      const real_t dm = q[idf][IU+c] - uave[IU+c];
+	      dm2 += dm*dm;
+	      mdm += uave[IU+c]*dm;
+	    }
+
+	    // solve 2nd order equation in t:
+	    // a_1 t^2 + b_1 t + c_1 = 0
+	    real_t a1 = 2.0*drho*dE - dm2;
+	    real_t b1 = 2.0*drho*(uave[IE] - eps2/(gamma0-1.0))
+	      + 2.0*uave[ID]*dE
+	      - 2.0*mdm;
+	    real_t c1 = 2.0*uave[ID]*uave[IE]
+	      - m2_ave
+	      - 2.0*eps2*uave[ID]/(gamma0-1.0);
+	    // Divide by a1 to avoid round-off error
+	    b1 /= a1;
+	    c1 /= a1;
+	    // discrimant
+	    real_t D = sqrt( fabs(b1*b1 - 4.0*c1) );
+
+	    // possible solutions
+	    real_t t1 = 0.5*(-b1 - D);
+	    real_t t2 = 0.5*(-b1 + D);
+	    real_t t=0.0;
+	    if(     t1 > -1.0e-12 and t1 < 1.0 + 1.0e-12)
+	      t = t1;
+	    else if(t2 > -1.0e-12 and t2 < 1.0 + 1.0e-12)
+	      t = t2;
+
+	    // t should strictly lie in [0,1]
+	    t = t<1.0 ? t : 1.0;
+	    t = t>0.0 ? t : 0.0;
+	    // round off error : take the cell average value
+	    if (fabs(1.0-t) < 1.0e-14)
+	      t = 0.0;
+
+	    theta2 = theta2 < t ? theta2 : t;
+
+	  } // end small pressure
+
+	} // end for idf
+
+      } // end for l
+    } // end for d
+
+    if (theta2 < 1.0) {
+      for (int ivar=0; ivar<Base::nbvar; ++ivar) {
+	for (int p=0; p<Base::NB_SOL_PTS; ++p) {
+	  const real_t val = Ustore(off + p + Base::NB_SOL_PTS*ivar);
+	  Ustore(off + p + Base::NB_SOL_PTS*ivar) = theta2 * (val - uave[ivar]) + uave[ivar];
+	}
+      }
+    }
+
+  } // operator ()
+
+  DofStore Ustore;
+
+}; // class PAdaptive_Positivity_Functor
+
+/*************************************************/
+/*************************************************/
+/*************************************************/
+/**
+ * Runge-Kutta update of the first nbDofs DoFs of a DoF store :
+ * Uout = c0 * U_0 + c1 * U_1 + c2 * dt * U_2
+ */
+class PAdaptive_Update_RK_Functor {
+
+public:
+  using coefs_t = Kokkos::Array<real_t,3>;
+
+  PAdaptive_Update_RK_Functor(DofStore Uout,
+			      DofStore U_0,
+			      DofStore U_1,
+			      DofStore U_2,
+			      coefs_t  coefs,
+			      real_t   dt) :
+    Uout(Uout),
+    U_0(U_0),
+    U_1(U_1),
+    U_2(U_2),
+    c0(coefs[0]),
+    c1(coefs[1]),
+    c2dt(coefs[2]*dt)
+  {};
+
+  // static method which does it all: create and execute functor
+  static void apply(DofStore Uout,
+		    DofStore U_0,
+		    DofStore U_1,
+		    DofStore U_2,
+		    coefs_t  coefs,
+		    real_t   dt,
+		    int64_t  nbDofs)
+  {
+    PAdaptive_Update_RK_Functor functor(Uout, U_0, U_1, U_2, coefs, dt);
+    Kokkos::parallel_for("PAdaptive_Update_RK_Functor", nbDofs, functor);
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const int64_t& i) const
+  {
+    Uout(i) =
+      c0   * U_0(i) +
+      c1   * U_1(i) +
+      c2dt * U_2(i);
+  }
+
+  DofStore Uout;
+  DofStore U_0;
+  DofStore U_1;
+  DofStore U_2;
+  real_t   c0;
+  real_t   c1;
+  real_t   c2dt;
+
+}; // class PAdaptive_Update_RK_Functor
+
+} // namespace sdm
+
+#endif // SDM_PADAPTIVE_FUNCTORS_H_
@@ -82,13 +82,13 @@ public:
                     DataArray           UdataFlux,
                     DataArray           Uaverage)
   {
-    int64_t nbCells = dim == 2 ?
-      params.isize * params.jsize :
-      params.isize * params.jsize * params.ksize;
-    
     Apply_positivity_Functor functor(params, sdm_geom, 
                                      UdataSol, UdataFlux, Uaverage);
-    Kokkos::parallel_for("Apply_positivity_Functor", nbCells, functor);
+    Kokkos::parallel_for("Apply_positivity_Functor",
+                         md_policy<dim>(0, 0, 0,
+                                        params.isize, params.jsize, params.ksize,
+                                        params.mdrange_tile),
+                         functor);
   }
 
   // =========================================================
@@ -99,20 +99,14 @@ public:
   //! functor for 2d 
   template<int dim_ = dim>
   KOKKOS_INLINE_FUNCTION
-  void operator()(const typename std::enable_if<dim_==2, int>::type& index) const
+  void operator()(const typename std::enable_if<dim_==2, int>::type& i,
+                  const int& j) const
   {
     
-    const int isize = this->params.isize;
-    const int jsize = this->params.jsize;
-    
-    const int nbvar = this->params.nbvar;
+    const int nbvar = NbVar<dim>::value;
 
     const real_t gamma0 = this->params.settings.gamma0;
     
-    // local cell index
-    int i,j;
-    index2coord(index,i,j,isize,jsize);
-
     int idx_flux_end = N+1;
     int idy_flux_end = N;
 
@@ -425,21 +419,15 @@ public:
   //! functor for 3d 
   template<int dim_ = dim>
   KOKKOS_INLINE_FUNCTION
-  void operator()(const typename std::enable_if<dim_==3, int>::type& index) const
+  void operator()(const typename std::enable_if<dim_==3, int>::type& i,
+                  const int& j,
+                  const int& k) const
   {
 
-    const int isize = this->params.isize;
-    const int jsize = this->params.jsize;
-    const int ksize = this->params.ksize;
-
-    const int nbvar = this->params.nbvar;
+    const int nbvar = NbVar<dim>::value;
 
     const real_t gamma0 = this->params.settings.gamma0;
 
-    // local cell index
-    int i,j,k;
-    index2coord(index,i,j,k,isize,jsize,ksize);
-
     int idx_flux_end = N+1;
     int idy_flux_end = N;
     int idz_flux_end = N;
@@ -889,18 +877,54 @@ public:
   {};
 
   // static method which does it all: create and execute functor
+  //
+  // if nbListedCells is non-negative, the functor is only applied to
+  // the cells listed in cellList.
   static void apply(HydroParams         params,
                     SDM_Geometry<dim,N> sdm_geom,
                     DataArray           UdataSol,
-                    DataArray           Uaverage)
+                    DataArray           Uaverage,
+                    CellList            cellList = CellList(),
+                    int                 nbListedCells = -1)
   {
-    int64_t nbCells = dim == 2 ?
-      params.isize * params.jsize :
-      params.isize * params.jsize * params.ksize;
-    
     Apply_positivity_Functor_v2 functor(params, sdm_geom, 
                                         UdataSol, Uaverage);
-    Kokkos::parallel_for("Apply_positivity_Functor_v2", nbCells, functor);
+
+    if (nbListedCells < 0) {
+      Kokkos::parallel_for("Apply_positivity_Functor_v2",
+                           md_policy<dim>(0, 0, 0,
+                                          params.isize, params.jsize, params.ksize,
+                                          params.mdrange_tile),
+                           functor);
+    } else {
+      functor.cellList = cellList;
+      Kokkos::parallel_for("Apply_positivity_Functor_v2 - cell list",
+                           Kokkos::RangePolicy<Device,TagCellList>(0,nbListedCells),
+                           functor);
+    }
+  }
+
+  //! functor restricted to a list of cells (2d)
+  template<int dim_ = dim>
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const TagCellList&,
+                  const typename std::enable_if<dim_==2, int>::type& ilist) const
+  {
+    int i,j;
+    index2coord(cellList(ilist),i,j,this->params.isize,this->params.jsize);
+    (*this)(i,j);
+  }
+
+  //! functor restricted to a list of cells (3d)
+  template<int dim_ = dim>
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const TagCellList&,
+                  const typename std::enable_if<dim_==3, int>::type& ilist) const
+  {
+    int i,j,k;
+    index2coord(cellList(ilist),i,j,k,
+                this->params.isize,this->params.jsize,this->params.ksize);
+    (*this)(i,j,k);
   }
 
   // =========================================================
@@ -911,20 +935,14 @@ public:
   //! functor for 2d 
   template<int dim_ = dim>
   KOKKOS_INLINE_FUNCTION
-  void operator()(const typename std::enable_if<dim_==2, int>::type& index) const
+  void operator()(const typename std::enable_if<dim_==2, int>::type& i,
+                  const int& j) const
   {
     
-    const int isize = this->params.isize;
-    const int jsize = this->params.jsize;
-    
     //const int nbvar = this->params.nbvar;
 
     const real_t gamma0 = this->params.settings.gamma0;
     
-    // local cell index
-    int i,j;
-    index2coord(index,i,j,isize,jsize);
-
     // average density at cell level
     const real_t rho_ave  = Uaverage(i,j,ID);
     const real_t rhou_ave = Uaverage(i,j,IU);
@@ -1231,21 +1249,15 @@ public:
   //! functor for 3d 
   template<int dim_ = dim>
   KOKKOS_INLINE_FUNCTION
-  void operator()(const typename std::enable_if<dim_==3, int>::type& index) const
+  void operator()(const typename std::enable_if<dim_==3, int>::type& i,
+                  const int& j,
+                  const int& k) const
   {
 
-    const int isize = this->params.isize;
-    const int jsize = this->params.jsize;
-    const int ksize = this->params.ksize;
-
     //const int nbvar = this->params.nbvar;
 
     const real_t gamma0 = this->params.settings.gamma0;
 
-    // local cell index
-    int i,j,k;
-    index2coord(index,i,j,k,isize,jsize,ksize);
-
     // average density at cell level
     const real_t rho_ave  = Uaverage(i,j,k,ID);
     const real_t rhou_ave = Uaverage(i,j,k,IU);
@@ -1706,6 +1718,7 @@ public:
   DataArray UdataSol;
   DataArray UdataFlux;
   DataArray Uaverage;
+  CellList  cellList;
   
 }; // class Apply_positivity_Functor_v2
 
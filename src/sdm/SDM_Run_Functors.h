@@ -45,12 +45,12 @@ public:
 		    DataArray           Udata,
 		    bool                isFlux)
   {
-    int64_t nbCells = dim == 2 ?
-	params.isize * params.jsize :
-	params.isize * params.jsize * params.ksize;
-
     SDM_Erase_Functor functor(params, sdm_geom, Udata, isFlux);
-    Kokkos::parallel_for("SDM_Erase_Functor", nbCells, functor);
+    Kokkos::parallel_for("SDM_Erase_Functor",
+                         md_policy<dim>(0, 0, 0,
+                                        params.isize, params.jsize, params.ksize,
+                                        params.mdrange_tile),
+                         functor);
   }
 
   /*
@@ -59,16 +59,10 @@ public:
   //! functor for 2d 
   template<int dim_ = dim>
   KOKKOS_INLINE_FUNCTION
-  void operator()(const typename std::enable_if<dim_==2, int>::type& index) const
+  void operator()(const typename std::enable_if<dim_==2, int>::type& i,
+                  const int& j) const
   {
 
-    const int isize = this->params.isize;
-    const int jsize = this->params.jsize;
-
-    // local cell index
-    int i,j;
-    index2coord(index,i,j,isize,jsize);
-    
     // loop over cell DoF's
 
     if (isFlux) {
@@ -108,17 +102,11 @@ public:
   //! functor for 3d 
   template<int dim_ = dim>
   KOKKOS_INLINE_FUNCTION
-  void operator()(const typename std::enable_if<dim_==3, int>::type& index) const
+  void operator()(const typename std::enable_if<dim_==3, int>::type& i,
+                  const int& j,
+                  const int& k) const
   {
 
-    const int isize = this->params.isize;
-    const int jsize = this->params.jsize;
-    const int ksize = this->params.ksize;
-    
-    // local cell index
-    int i,j,k;
-    index2coord(index,i,j,k,isize,jsize,ksize);
-
     // loop over cell DoF's
 
     if (isFlux) {
@@ -198,80 +186,64 @@ public:
                     SDM_Geometry<dim,N> sdm_geom,
                     DataArray           Udata,
                     DataArray           mdUdt,
-                    real_t              dt,
-                    int                 nbCells)
+                    real_t              dt)
   {
+    const int ghostWidth = params.ghostWidth;
+
     SDM_Update_Functor functor(params, sdm_geom, 
                                Udata, mdUdt, dt);
-    Kokkos::parallel_for("SDM_Update_Functor", nbCells, functor);
+    Kokkos::parallel_for("SDM_Update_Functor",
+                         md_policy<dim>(ghostWidth, ghostWidth, ghostWidth,
+                                        params.isize-ghostWidth,
+                                        params.jsize-ghostWidth,
+                                        params.ksize-ghostWidth,
+                                        params.mdrange_tile),
+                         functor);
   }
 
   //! functor for 2d 
   template<int dim_ = dim>
   KOKKOS_INLINE_FUNCTION
-  void operator()(const typename std::enable_if<dim_==2, int>::type& index)  const
+  void operator()(const typename std::enable_if<dim_==2, int>::type& i,
+                  const int& j) const
   {
-    const int isize = this->params.isize;
-    const int jsize = this->params.jsize;
-    const int ghostWidth = this->params.ghostWidth;
-    
-    int i,j;
-    index2coord(index,i,j,isize,jsize);
-
     HydroState tmp;
     
-    if(j >= ghostWidth && j < jsize-ghostWidth  &&
-       i >= ghostWidth && i < isize-ghostWidth ) {
-
-      for (int idy=0; idy<N; ++idy) {
-	for (int idx=0; idx<N; ++idx) {
+    for (int idy=0; idy<N; ++idy) {
+      for (int idx=0; idx<N; ++idx) {
 	
-	  Udata(i,j,dofMap(idx,idy,0,ID)) -= dt*mdUdt(i,j,dofMap(idx,idy,0,ID));
-	  Udata(i,j,dofMap(idx,idy,0,IE)) -= dt*mdUdt(i,j,dofMap(idx,idy,0,IE));
-	  Udata(i,j,dofMap(idx,idy,0,IU)) -= dt*mdUdt(i,j,dofMap(idx,idy,0,IU));
-	  Udata(i,j,dofMap(idx,idy,0,IV)) -= dt*mdUdt(i,j,dofMap(idx,idy,0,IV));
+	Udata(i,j,dofMap(idx,idy,0,ID)) -= dt*mdUdt(i,j,dofMap(idx,idy,0,ID));
+	Udata(i,j,dofMap(idx,idy,0,IE)) -= dt*mdUdt(i,j,dofMap(idx,idy,0,IE));
+	Udata(i,j,dofMap(idx,idy,0,IU)) -= dt*mdUdt(i,j,dofMap(idx,idy,0,IU));
+	Udata(i,j,dofMap(idx,idy,0,IV)) -= dt*mdUdt(i,j,dofMap(idx,idy,0,IV));
 
-	} // for idx
-      } // for idy
-	  
-    } // end if guard
+      } // for idx
+    } // for idy
     
   } // end operator ()
   
   //! functor for 3d 
   template<int dim_ = dim>
   KOKKOS_INLINE_FUNCTION
-  void operator()(const typename std::enable_if<dim_==3, int>::type& index)  const
+  void operator()(const typename std::enable_if<dim_==3, int>::type& i,
+                  const int& j,
+                  const int& k) const
   {
-    const int isize = this->params.isize;
-    const int jsize = this->params.jsize;
-    const int ksize = this->params.ksize;
-    const int ghostWidth = this->params.ghostWidth;
-    
-    int i,j,k;
-    index2coord(index,i,j,k,isize,jsize,ksize);
-
     HydroState tmp;
 
-    if(k >= ghostWidth && k < ksize-ghostWidth  &&
-       j >= ghostWidth && j < jsize-ghostWidth  &&
-       i >= ghostWidth && i < isize-ghostWidth ) {
-
-      for (int idz=0; idz<N; ++idz) {
-	for (int idy=0; idy<N; ++idy) {
-	  for (int idx=0; idx<N; ++idx) {
+    for (int idz=0; idz<N; ++idz) {
+      for (int idy=0; idy<N; ++idy) {
+	for (int idx=0; idx<N; ++idx) {
 	
-	    Udata(i,j,k,dofMap(idx,idy,idz,ID)) -= dt*mdUdt(i,j,k,dofMap(idx,idy,idz,ID));
-	    Udata(i,j,k,dofMap(idx,idy,idz,IE)) -= dt*mdUdt(i,j,k,dofMap(idx,idy,idz,IE));
-	    Udata(i,j,k,dofMap(idx,idy,idz,IU)) -= dt*mdUdt(i,j,k,dofMap(idx,idy,idz,IU));
-	    Udata(i,j,k,dofMap(idx,idy,idz,IV)) -= dt*mdUdt(i,j,k,dofMap(idx,idy,idz,IV));
-	    Udata(i,j,k,dofMap(idx,idy,idz,IW)) -= dt*mdUdt(i,j,k,dofMap(idx,idy,idz,IW));
-
-	  } // for idx
-	} // for idy
-      } // for idz
-      
-    } // end if guard
+	  Udata(i,j,k,dofMap(idx,idy,idz,ID)) -= dt*mdUdt(i,j,k,dofMap(idx,idy,idz,ID));
+	  Udata(i,j,k,dofMap(idx,idy,idz,IE)) -= dt*mdUdt(i,j,k,dofMap(idx,idy,idz,IE));
+	  Udata(i,j,k,dofMap(idx,idy,idz,IU)) -= dt*mdUdt(i,j,k,dofMap(idx,idy,idz,IU));
+	  Udata(i,j,k,dofMap(idx,idy,idz,IV)) -= dt*mdUdt(i,j,k,dofMap(idx,idy,idz,IV));
+	  Udata(i,j,k,dofMap(idx,idy,idz,IW)) -= dt*mdUdt(i,j,k,dofMap(idx,idy,idz,IW));
+
+	} // for idx
+      } // for idy
+    } // for idz
     
   } // end operator ()
   
@@ -316,109 +288,93 @@ public:
                     DataArray           Udata,
                     DataArray           URK,
                     DataArray           mdUdt,
-                    real_t              dt,
-                    int                 nbCells)
+                    real_t              dt)
   {
+    const int ghostWidth = params.ghostWidth;
+
     SDM_Update_sspRK2_Functor functor(params, sdm_geom, 
                                       Udata, URK, mdUdt, dt);
-    Kokkos::parallel_for("SDM_Update_sspRK2_Functor", nbCells, functor);
+    Kokkos::parallel_for("SDM_Update_sspRK2_Functor",
+                         md_policy<dim>(ghostWidth, ghostWidth, ghostWidth,
+                                        params.isize-ghostWidth,
+                                        params.jsize-ghostWidth,
+                                        params.ksize-ghostWidth,
+                                        params.mdrange_tile),
+                         functor);
   }
 
   //! functor for 2d
   template<int dim_ = dim>
   KOKKOS_INLINE_FUNCTION
-  void operator()(const typename std::enable_if<dim_==2, int>::type& index)  const
+  void operator()(const typename std::enable_if<dim_==2, int>::type& i,
+                  const int& j) const
   {
-    const int isize = this->params.isize;
-    const int jsize = this->params.jsize;
-    const int ghostWidth = this->params.ghostWidth;
-    
-    int i,j;
-    index2coord(index,i,j,isize,jsize);
-
     HydroState tmp;
     
-    if(j >= ghostWidth && j < jsize-ghostWidth  &&
-       i >= ghostWidth && i < isize-ghostWidth ) {
-
-      for (int idy=0; idy<N; ++idy) {
-	for (int idx=0; idx<N; ++idx) {
-
-	  tmp[ID] = 0.5 * (Udata(i,j,dofMap(idx,idy,0,ID)) +
-			   URK  (i,j,dofMap(idx,idy,0,ID)) -
-			   mdUdt(i,j,dofMap(idx,idy,0,ID))*dt);
-	  tmp[IE] = 0.5 * (Udata(i,j,dofMap(idx,idy,0,IE)) +
-			   URK  (i,j,dofMap(idx,idy,0,IE)) -
-			   mdUdt(i,j,dofMap(idx,idy,0,IE))*dt);
-	  tmp[IU] = 0.5 * (Udata(i,j,dofMap(idx,idy,0,IU)) +
-			   URK  (i,j,dofMap(idx,idy,0,IU)) -
-			   mdUdt(i,j,dofMap(idx,idy,0,IU))*dt);
-	  tmp[IV] = 0.5 * (Udata(i,j,dofMap(idx,idy,0,IV)) +
-			   URK  (i,j,dofMap(idx,idy,0,IV)) -
-			   mdUdt(i,j,dofMap(idx,idy,0,IV))*dt);
+    for (int idy=0; idy<N; ++idy) {
+      for (int idx=0; idx<N; ++idx) {
+
+	tmp[ID] = 0.5 * (Udata(i,j,dofMap(idx,idy,0,ID)) +
+			 URK  (i,j,dofMap(idx,idy,0,ID)) -
+			 mdUdt(i,j,dofMap(idx,idy,0,ID))*dt);
+	tmp[IE] = 0.5 * (Udata(i,j,dofMap(idx,idy,0,IE)) +
+			 URK  (i,j,dofMap(idx,idy,0,IE)) -
+			 mdUdt(i,j,dofMap(idx,idy,0,IE))*dt);
+	tmp[IU] = 0.5 * (Udata(i,j,dofMap(idx,idy,0,IU)) +
+			 URK  (i,j,dofMap(idx,idy,0,IU)) -
+			 mdUdt(i,j,dofMap(idx,idy,0,IU))*dt);
+	tmp[IV] = 0.5 * (Udata(i,j,dofMap(idx,idy,0,IV)) +
+			 URK  (i,j,dofMap(idx,idy,0,IV)) -
+			 mdUdt(i,j,dofMap(idx,idy,0,IV))*dt);
 	  
-	  Udata(i,j,dofMap(idx,idy,0,ID)) = tmp[ID];
-	  Udata(i,j,dofMap(idx,idy,0,IE)) = tmp[IE];
-	  Udata(i,j,dofMap(idx,idy,0,IU)) = tmp[IU];
-	  Udata(i,j,dofMap(idx,idy,0,IV)) = tmp[IV];
+	Udata(i,j,dofMap(idx,idy,0,ID)) = tmp[ID];
+	Udata(i,j,dofMap(idx,idy,0,IE)) = tmp[IE];
+	Udata(i,j,dofMap(idx,idy,0,IU)) = tmp[IU];
+	Udata(i,j,dofMap(idx,idy,0,IV)) = tmp[IV];
 
-	} // for idx
-      } // for idy
-	  
-    } // end if guard
+      } // for idx
+    } // for idy
     
   } // end operator ()
   
   //! functor for 3d 
   template<int dim_ = dim>
   KOKKOS_INLINE_FUNCTION
-  void operator()(const typename std::enable_if<dim_==3, int>::type& index)  const
+  void operator()(const typename std::enable_if<dim_==3, int>::type& i,
+                  const int& j,
+                  const int& k) const
   {
-    const int isize = this->params.isize;
-    const int jsize = this->params.jsize;
-    const int ksize = this->params.ksize;
-    const int ghostWidth = this->params.ghostWidth;
-    
-    int i,j,k;
-    index2coord(index,i,j,k,isize,jsize,ksize);
-
     HydroState tmp;
 
-    if(k >= ghostWidth && k < ksize-ghostWidth  &&
-       j >= ghostWidth && j < jsize-ghostWidth  &&
-       i >= ghostWidth && i < isize-ghostWidth ) {
-
-      for (int idz=0; idz<N; ++idz) {
-	for (int idy=0; idy<N; ++idy) {
-	  for (int idx=0; idx<N; ++idx) {
+    for (int idz=0; idz<N; ++idz) {
+      for (int idy=0; idy<N; ++idy) {
+	for (int idx=0; idx<N; ++idx) {
 	
-	    tmp[ID] = 0.5 * (Udata(i,j,k,dofMap(idx,idy,idz,ID)) +
-			     URK  (i,j,k,dofMap(idx,idy,idz,ID)) -
-			     mdUdt(i,j,k,dofMap(idx,idy,idz,ID))*dt);
-	    tmp[IE] = 0.5 * (Udata(i,j,k,dofMap(idx,idy,idz,IE)) +
-			     URK  (i,j,k,dofMap(idx,idy,idz,IE)) -
-			     mdUdt(i,j,k,dofMap(idx,idy,idz,IE))*dt);
-	    tmp[IU] = 0.5 * (Udata(i,j,k,dofMap(idx,idy,idz,IU)) +
-			     URK  (i,j,k,dofMap(idx,idy,idz,IU)) -
-			     mdUdt(i,j,k,dofMap(idx,idy,idz,IU))*dt);
-	    tmp[IV] = 0.5 * (Udata(i,j,k,dofMap(idx,idy,idz,IV)) +
-			     URK  (i,j,k,dofMap(idx,idy,idz,IV)) -
-			     mdUdt(i,j,k,dofMap(idx,idy,idz,IV))*dt);
-	    tmp[IW] = 0.5 * (Udata(i,j,k,dofMap(idx,idy,idz,IW)) +
-			     URK  (i,j,k,dofMap(idx,idy,idz,IW)) -
-			     mdUdt(i,j,k,dofMap(idx,idy,idz,IW))*dt);
+	  tmp[ID] = 0.5 * (Udata(i,j,k,dofMap(idx,idy,idz,ID)) +
+			   URK  (i,j,k,dofMap(idx,idy,idz,ID)) -
+			   mdUdt(i,j,k,dofMap(idx,idy,idz,ID))*dt);
+	  tmp[IE] = 0.5 * (Udata(i,j,k,dofMap(idx,idy,idz,IE)) +
+			   URK  (i,j,k,dofMap(idx,idy,idz,IE)) -
+			   mdUdt(i,j,k,dofMap(idx,idy,idz,IE))*dt);
+	  tmp[IU] = 0.5 * (Udata(i,j,k,dofMap(idx,idy,idz,IU)) +
+			   URK  (i,j,k,dofMap(idx,idy,idz,IU)) -
+			   mdUdt(i,j,k,dofMap(idx,idy,idz,IU))*dt);
+	  tmp[IV] = 0.5 * (Udata(i,j,k,dofMap(idx,idy,idz,IV)) +
+			   URK  (i,j,k,dofMap(idx,idy,idz,IV)) -
+			   mdUdt(i,j,k,dofMap(idx,idy,idz,IV))*dt);
+	  tmp[IW] = 0.5 * (Udata(i,j,k,dofMap(idx,idy,idz,IW)) +
+			   URK  (i,j,k,dofMap(idx,idy,idz,IW)) -
+			   mdUdt(i,j,k,dofMap(idx,idy,idz,IW))*dt);
 	    
-	    Udata(i,j,k,dofMap(idx,idy,idz,ID)) = tmp[ID];
-	    Udata(i,j,k,dofMap(idx,idy,idz,IE)) = tmp[IE];
-	    Udata(i,j,k,dofMap(idx,idy,idz,IU)) = tmp[IU];
-	    Udata(i,j,k,dofMap(idx,idy,idz,IV)) = tmp[IV];
-	    Udata(i,j,k,dofMap(idx,idy,idz,IW)) = tmp[IW];
+	  Udata(i,j,k,dofMap(idx,idy,idz,ID)) = tmp[ID];
+	  Udata(i,j,k,dofMap(idx,idy,idz,IE)) = tmp[IE];
+	  Udata(i,j,k,dofMap(idx,idy,idz,IU)) = tmp[IU];
+	  Udata(i,j,k,dofMap(idx,idy,idz,IV)) = tmp[IV];
+	  Udata(i,j,k,dofMap(idx,idy,idz,IW)) = tmp[IW];
 	    
-	  } // for idx
-	} // for idy
-      } // for idz
-      
-    } // end if guard
+	} // for idx
+      } // for idy
+    } // for idz
     
   } // end operator ()
   
@@ -476,134 +432,115 @@ public:
                     coefs_t             coefs,
                     real_t              dt)
   {
-    int64_t nbCells = (dim==2) ? 
-      params.isize * params.jsize :
-      params.isize * params.jsize * params.ksize;
+    const int ghostWidth = params.ghostWidth;
 
     SDM_Update_RK_Functor functor(params, sdm_geom,
                                   Uout, U_0, U_1, U_2, coefs, dt);
-    Kokkos::parallel_for("SDM_Update_RK_Functor",nbCells, functor);
+    Kokkos::parallel_for("SDM_Update_RK_Functor",
+                         md_policy<dim>(ghostWidth, ghostWidth, ghostWidth,
+                                        params.isize-ghostWidth,
+                                        params.jsize-ghostWidth,
+                                        params.ksize-ghostWidth,
+                                        params.mdrange_tile),
+                         functor);
   }
 
     //! functor for 2d
   template<int dim_ = dim>
   KOKKOS_INLINE_FUNCTION
-  void operator()(const typename std::enable_if<dim_==2, int>::type& index)  const
+  void operator()(const typename std::enable_if<dim_==2, int>::type& i,
+                  const int& j) const
   {
-    const int isize = this->params.isize;
-    const int jsize = this->params.jsize;
-    const int ghostWidth = this->params.ghostWidth;
-
     const real_t c0   = coefs[0];
     const real_t c1   = coefs[1];
     const real_t c2dt = coefs[2]*dt;
     
-    int i,j;
-    index2coord(index,i,j,isize,jsize);
-
     HydroState tmp;
     
-    if(j >= ghostWidth && j < jsize-ghostWidth  &&
-       i >= ghostWidth && i < isize-ghostWidth ) {
-
-      for (int idy=0; idy<N; ++idy) {
-	for (int idx=0; idx<N; ++idx) {
-
-	  tmp[ID] =
-	    c0   * U_0 (i,j,dofMap(idx,idy,0,ID)) +
-	    c1   * U_1 (i,j,dofMap(idx,idy,0,ID)) +
-	    c2dt * U_2 (i,j,dofMap(idx,idy,0,ID)) ;
-
-	  tmp[IE] =
-	    c0   * U_0 (i,j,dofMap(idx,idy,0,IE)) +
-	    c1   * U_1 (i,j,dofMap(idx,idy,0,IE)) +
-	    c2dt * U_2 (i,j,dofMap(idx,idy,0,IE)) ;
-	  
-	  tmp[IU] =
-	    c0   * U_0 (i,j,dofMap(idx,idy,0,IU)) +
-	    c1   * U_1 (i,j,dofMap(idx,idy,0,IU)) +
-	    c2dt * U_2 (i,j,dofMap(idx,idy,0,IU)) ;
-
-	  tmp[IV] =
-	    c0   * U_0 (i,j,dofMap(idx,idy,0,IV)) +
-	    c1   * U_1 (i,j,dofMap(idx,idy,0,IV)) +
-	    c2dt * U_2 (i,j,dofMap(idx,idy,0,IV)) ;
-
-	  Uout(i,j,dofMap(idx,idy,0,ID)) = tmp[ID];
-	  Uout(i,j,dofMap(idx,idy,0,IE)) = tmp[IE];
-	  Uout(i,j,dofMap(idx,idy,0,IU)) = tmp[IU];
-	  Uout(i,j,dofMap(idx,idy,0,IV)) = tmp[IV];
-
-	} // for idx
-      } // for idy
+    for (int idy=0; idy<N; ++idy) {
+      for (int idx=0; idx<N; ++idx) {
+
+	tmp[ID] =
+	  c0   * U_0 (i,j,dofMap(idx,idy,0,ID)) +
+	  c1   * U_1 (i,j,dofMap(idx,idy,0,ID)) +
+	  c2dt * U_2 (i,j,dofMap(idx,idy,0,ID)) ;
+
+	tmp[IE] =
+	  c0   * U_0 (i,j,dofMap(idx,idy,0,IE)) +
+	  c1   * U_1 (i,j,dofMap(idx,idy,0,IE)) +
+	  c2dt * U_2 (i,j,dofMap(idx,idy,0,IE)) ;
 	  
-    } // end if guard
+	tmp[IU] =
+	  c0   * U_0 (i,j,dofMap(idx,idy,0,IU)) +
+	  c1   * U_1 (i,j,dofMap(idx,idy,0,IU)) +
+	  c2dt * U_2 (i,j,dofMap(idx,idy,0,IU)) ;
+
+	tmp[IV] =
+	  c0   * U_0 (i,j,dofMap(idx,idy,0,IV)) +
+	  c1   * U_1 (i,j,dofMap(idx,idy,0,IV)) +
+	  c2dt * U_2 (i,j,dofMap(idx,idy,0,IV)) ;
+
+	Uout(i,j,dofMap(idx,idy,0,ID)) = tmp[ID];
+	Uout(i,j,dofMap(idx,idy,0,IE)) = tmp[IE];
+	Uout(i,j,dofMap(idx,idy,0,IU)) = tmp[IU];
+	Uout(i,j,dofMap(idx,idy,0,IV)) = tmp[IV];
+
+      } // for idx
+    } // for idy
     
   } // end operator ()
   
   //! functor for 3d 
   template<int dim_ = dim>
   KOKKOS_INLINE_FUNCTION
-  void operator()(const typename std::enable_if<dim_==3, int>::type& index)  const
+  void operator()(const typename std::enable_if<dim_==3, int>::type& i,
+                  const int& j,
+                  const int& k) const
   {
-    const int isize = this->params.isize;
-    const int jsize = this->params.jsize;
-    const int ksize = this->params.ksize;
-    const int ghostWidth = this->params.ghostWidth;
-    
     const real_t c0   = coefs[0];
     const real_t c1   = coefs[1];
     const real_t c2dt = coefs[2]*dt;
 
-    int i,j,k;
-    index2coord(index,i,j,k,isize,jsize,ksize);
-
     HydroState tmp;
 
-    if(k >= ghostWidth && k < ksize-ghostWidth  &&
-       j >= ghostWidth && j < jsize-ghostWidth  &&
-       i >= ghostWidth && i < isize-ghostWidth ) {
-
-      for (int idz=0; idz<N; ++idz) {
-	for (int idy=0; idy<N; ++idy) {
-	  for (int idx=0; idx<N; ++idx) {
+    for (int idz=0; idz<N; ++idz) {
+      for (int idy=0; idy<N; ++idy) {
+	for (int idx=0; idx<N; ++idx) {
 	
-	    tmp[ID] =
-	      c0   * U_0 (i,j,k,dofMap(idx,idy,idz,ID)) +
-	      c1   * U_1 (i,j,k,dofMap(idx,idy,idz,ID)) +
-	      c2dt * U_2 (i,j,k,dofMap(idx,idy,idz,ID)) ;
+	  tmp[ID] =
+	    c0   * U_0 (i,j,k,dofMap(idx,idy,idz,ID)) +
+	    c1   * U_1 (i,j,k,dofMap(idx,idy,idz,ID)) +
+	    c2dt * U_2 (i,j,k,dofMap(idx,idy,idz,ID)) ;
 	    
-	    tmp[IE] =
-	      c0   * U_0 (i,j,k,dofMap(idx,idy,idz,IE)) +
-	      c1   * U_1 (i,j,k,dofMap(idx,idy,idz,IE)) +
-	      c2dt * U_2 (i,j,k,dofMap(idx,idy,idz,IE)) ;
+	  tmp[IE] =
+	    c0   * U_0 (i,j,k,dofMap(idx,idy,idz,IE)) +
+	    c1   * U_1 (i,j,k,dofMap(idx,idy,idz,IE)) +
+	    c2dt * U_2 (i,j,k,dofMap(idx,idy,idz,IE)) ;
 	    
-	    tmp[IU] =
-	      c0   * U_0 (i,j,k,dofMap(idx,idy,idz,IU)) +
-	      c1   * U_1 (i,j,k,dofMap(idx,idy,idz,IU)) +
-	      c2dt * U_2 (i,j,k,dofMap(idx,idy,idz,IU)) ;
+	  tmp[IU] =
+	    c0   * U_0 (i,j,k,dofMap(idx,idy,idz,IU)) +
+	    c1   * U_1 (i,j,k,dofMap(idx,idy,idz,IU)) +
+	    c2dt * U_2 (i,j,k,dofMap(idx,idy,idz,IU)) ;
 	    
-	    tmp[IV] =
-	      c0   * U_0 (i,j,k,dofMap(idx,idy,idz,IV)) +
-	      c1   * U_1 (i,j,k,dofMap(idx,idy,idz,IV)) +
-	      c2dt * U_2 (i,j,k,dofMap(idx,idy,idz,IV)) ;
+	  tmp[IV] =
+	    c0   * U_0 (i,j,k,dofMap(idx,idy,idz,IV)) +
+	    c1   * U_1 (i,j,k,dofMap(idx,idy,idz,IV)) +
+	    c2dt * U_2 (i,j,k,dofMap(idx,idy,idz,IV)) ;
 	    
-	    tmp[IW] =
-	      c0   * U_0 (i,j,k,dofMap(idx,idy,idz,IW)) +
-	      c1   * U_1 (i,j,k,dofMap(idx,idy,idz,IW)) +
-	      c2dt * U_2 (i,j,k,dofMap(idx,idy,idz,IW)) ;
+	  tmp[IW] =
+	    c0   * U_0 (i,j,k,dofMap(idx,idy,idz,IW)) +
+	    c1   * U_1 (i,j,k,dofMap(idx,idy,idz,IW)) +
+	    c2dt * U_2 (i,j,k,dofMap(idx,idy,idz,IW)) ;
 	    
-	    Uout(i,j,k,dofMap(idx,idy,idz,ID)) = tmp[ID];
-	    Uout(i,j,k,dofMap(idx,idy,idz,IE)) = tmp[IE];
-	    Uout(i,j,k,dofMap(idx,idy,idz,IU)) = tmp[IU];
-	    Uout(i,j,k,dofMap(idx,idy,idz,IV)) = tmp[IV];
-	    Uout(i,j,k,dofMap(idx,idy,idz,IW)) = tmp[IW];
+	  Uout(i,j,k,dofMap(idx,idy,idz,ID)) = tmp[ID];
+	  Uout(i,j,k,dofMap(idx,idy,idz,IE)) = tmp[IE];
+	  Uout(i,j,k,dofMap(idx,idy,idz,IU)) = tmp[IU];
+	  Uout(i,j,k,dofMap(idx,idy,idz,IV)) = tmp[IV];
+	  Uout(i,j,k,dofMap(idx,idy,idz,IW)) = tmp[IW];
 	    
-	  } // for idx
-	} // for idy
-      } // for idz
-      
-    } // end if guard
+	} // for idx
+      } // for idy
+    } // for idz
     
   } // end operator ()
   
@@ -0,0 +1,487 @@
+/**
+ * \file SDM_Troubled_Cells_Functors.h
+ *
+ * Troubled cells detection, used to restrict the (costly) limiting and
+ * positivity preserving procedures to a compacted list of cells.
+ *
+ * Two indicators are provided:
+ * - Troubled_Cells_Indicator_Functor flags cells where the cell-averaged
+ *   solution is not smooth (Jameson-like second difference sensor on
+ *   density and pressure computed from Uaverage); these cells are the
+ *   only one visited by the TVB limiter.
+ * - Positivity_Cells_Indicator_Functor flags cells where the flux points
+ *   values may violate density / pressure positivity; this test is
+ *   conservative (it uses the Lebesgue constant of the solution to flux
+ *   points interpolation), so that restricting Apply_positivity_Functor_v2
+ *   to these cells gives the same result as visiting all cells.
+ *
+ * Flags are then compacted into a CellList by Compact_Cell_List_Functor.
+ */
+#ifndef SDM_TROUBLED_CELLS_FUNCTORS_H_
+#define SDM_TROUBLED_CELLS_FUNCTORS_H_
+
+#include "shared/kokkos_shared.h"
+#include "sdm/SDMBaseFunctor.h"
+
+#include "sdm/SDM_Geometry.h"
+#include "sdm/sdm_shared.h" // for DofMap
+
+namespace sdm {
+
+/*************************************************/
+/*************************************************/
+/*************************************************/
+/**
+ * Troubled cells indicator based on cell-averaged values.
+ *
+ * For each direction, we compute a normalized second difference of
+ * density and pressure (as in Jameson's shock sensor):
+ *
+ * s = |q_{i+1} - 2 q_i + q_{i-1}| / (q_{i+1} + 2 q_i + q_{i-1})
+ *
+ * A cell is flagged when the max of s (over variables and directions)
+ * is larger than threshold. Outer-most cells (which are never limited)
+ * are not flagged.
+ */
+template<int dim, int N>
+class Troubled_Cells_Indicator_Functor : public SDMBaseFunctor<dim,N> {
+
+public:
+  using typename SDMBaseFunctor<dim,N>::DataArray;
+  using typename SDMBaseFunctor<dim,N>::HydroState;
+
+  /**
+   * \param[in]  params contains hydrodynamics parameters
+   * \param[in]  sdm_geom contains parameters to init base class functor
+   * \param[in]  Uaverage contains cell volume averaged conservative variables
+   * \param[out] CellFlags is 1 for troubled cells, 0 elsewhere
+   * \param[in]  threshold sensor value above which a cell is flagged
+   */
+  Troubled_Cells_Indicator_Functor(HydroParams         params,
+				   SDM_Geometry<dim,N> sdm_geom,
+				   DataArray           Uaverage,
+				   CellList            CellFlags,
+				   real_t              threshold) :
+    SDMBaseFunctor<dim,N>(params,sdm_geom),
+    Uaverage(Uaverage),
+    CellFlags(CellFlags),
+    threshold(threshold)
+  {};
+
+  // static method which does it all: create and execute functor
+  static void apply(HydroParams         params,
+                    SDM_Geometry<dim,N> sdm_geom,
+                    DataArray           Uaverage,
+                    CellList            CellFlags,
+                    real_t              threshold)
+  {
+    Troubled_Cells_Indicator_Functor functor(params, sdm_geom,
+                                             Uaverage, CellFlags,
+                                             threshold);
+    Kokkos::parallel_for("Troubled_Cells_Indicator_Functor",
+                         md_policy<dim>(0, 0, 0,
+                                        params.isize, params.jsize, params.ksize,
+                                        params.mdrange_tile),
+                         functor);
+  }
+
+  /**
+   * Compute pressure from cell-averaged conservative variables.
+   */
+  KOKKOS_INLINE_FUNCTION
+  real_t pressure(const HydroState& u) const
+  {
+    const real_t gamma0 = this->params.settings.gamma0;
+    const real_t smallp = this->params.settings.smallp;
+
+    real_t ekin = u[IU]*u[IU] + u[IV]*u[IV];
+    if (dim==3)
+      ekin += u[IW]*u[IW];
+    ekin *= HALF_F / u[ID];
+
+    const real_t p = (gamma0 - ONE_F) * (u[IE] - ekin);
+
+    return p > smallp ? p : smallp;
+
+  } // pressure
+
+  /**
+   * Normalized second difference (Jameson sensor).
+   */
+  KOKKOS_INLINE_FUNCTION
+  real_t sensor(real_t qL, real_t q, real_t qR) const
+  {
+    return fabs(qR - TWO_F*q + qL) / (qR + TWO_F*q + qL);
+  } // sensor
+
+  // ================================================
+  //
+  // 2D version.
+  //
+  // ================================================
+  //! functor for 2d
+  template<int dim_ = dim>
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const typename std::enable_if<dim_==2, int>::type& i,
+                  const int& j) const
+  {
+    const int isize = this->params.isize;
+    const int jsize = this->params.jsize;
+
+    const int nbvar = NbVar<dim>::value;
+
+    // flat cell index, as used by the cell list
+    const int index = coord2index(i,j,isize,jsize);
+
+    if (i==0 or i==isize-1 or
+	j==0 or j==jsize-1 ) {
+      CellFlags(index) = 0;
+      return;
+    }
+
+    HydroState u0, uxL, uxR, uyL, uyR;
+    for (int ivar = 0; ivar<nbvar; ++ivar) {
+      u0 [ivar] = Uaverage(i  ,j  ,ivar);
+      uxL[ivar] = Uaverage(i-1,j  ,ivar);
+      uxR[ivar] = Uaverage(i+1,j  ,ivar);
+      uyL[ivar] = Uaverage(i  ,j-1,ivar);
+      uyR[ivar] = Uaverage(i  ,j+1,ivar);
+    }
+
+    real_t s = 0;
+
+    // density
+    s = fmax(s, sensor(uxL[ID], u0[ID], uxR[ID]));
+    s = fmax(s, sensor(uyL[ID], u0[ID], uyR[ID]));
+
+    // pressure
+    const real_t p0 = pressure(u0);
+    s = fmax(s, sensor(pressure(uxL), p0, pressure(uxR)));
+    s = fmax(s, sensor(pressure(uyL), p0, pressure(uyR)));
+
+    CellFlags(index) = s > threshold ? 1 : 0;
+
+  } // operator () - 2d
+
+  // ================================================
+  //
+  // 3D version.
+  //
+  // ================================================
+  //! functor for 3d
+  template<int dim_ = dim>
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const typename std::enable_if<dim_==3, int>::type& i,
+                  const int& j,
+                  const int& k) const
+  {
+    const int isize = this->params.isize;
+    const int jsize = this->params.jsize;
+    const int ksize = this->params.ksize;
+
+    const int nbvar = NbVar<dim>::value;
+
+    // flat cell index, as used by the cell list
+    const int index = coord2index(i,j,k,isize,jsize,ksize);
+
+    if (i==0 or i==isize-1 or
+	j==0 or j==jsize-1 or
+	k==0 or k==ksize-1 ) {
+      CellFlags(index) = 0;
+      return;
+    }
+
+    HydroState u0, uxL, uxR, uyL, uyR, uzL, uzR;
+    for (int ivar = 0; ivar<nbvar; ++ivar) {
+      u0 [ivar] = Uaverage(i  ,j  ,k  ,ivar);
+      uxL[ivar] = Uaverage(i-1,j  ,k  ,ivar);
+      uxR[ivar] = Uaverage(i+1,j  ,k  ,ivar);
+      uyL[ivar] = Uaverage(i  ,j-1,k  ,ivar);
+      uyR[ivar] = Uaverage(i  ,j+1,k  ,ivar);
+      uzL[ivar] = Uaverage(i  ,j  ,k-1,ivar);
+      uzR[ivar] = Uaverage(i  ,j  ,k+1,ivar);
+    }
+
+    real_t s = 0;
+
+    // density
+    s = fmax(s, sensor(uxL[ID], u0[ID], uxR[ID]));
+    s = fmax(s, sensor(uyL[ID], u0[ID], uyR[ID]));
+    s = fmax(s, sensor(uzL[ID], u0[ID], uzR[ID]));
+
+    // pressure
+    const real_t p0 = pressure(u0);
+    s = fmax(s, sensor(pressure(uxL), p0, pressure(uxR)));
+    s = fmax(s, sensor(pressure(uyL), p0, pressure(uyR)));
+    s = fmax(s, sensor(pressure(uzL), p0, pressure(uzR)));
+
+    CellFlags(index) = s > threshold ? 1 : 0;
+
+  } // operator () - 3d
+
+  DataArray Uaverage;
+  CellList  CellFlags;
+  real_t    threshold;
+
+}; // class Troubled_Cells_Indicator_Functor
+
+/*************************************************/
+/*************************************************/
+/*************************************************/
+/**
+ * Flag cells that may require the positivity preserving procedure
+ * (see Apply_positivity_Functor_v2).
+ *
+ * Values at flux points are obtained by 1d Lagrange interpolation of
+ * values at solution points, so that for any variable:
+ * |u_flux - u_ave| <= L * max_{solution pts} |u_sol - u_ave|
+ * where L is the Lebesgue constant of the sol2flux interpolation.
+ *
+ * From these bounds, we derive a lower bound of density and pressure
+ * at flux points; the cell is flagged if one of these lower bounds is
+ * below the thresholds used in Apply_positivity_Functor_v2.
+ */
+template<int dim, int N>
+class Positivity_Cells_Indicator_Functor : public SDMBaseFunctor<dim,N> {
+
+public:
+  using typename SDMBaseFunctor<dim,N>::DataArray;
+  using typename SDMBaseFunctor<dim,N>::HydroState;
+
+  static constexpr auto dofMap = DofMap<dim,N>;
+
+  /**
+   * \param[in]  params contains hydrodynamics parameters
+   * \param[in]  sdm_geom contains parameters to init base class functor
+   * \param[in]  UdataSol contains conservative variables at solution points
+   * \param[in]  Uaverage contains cell volume averaged conservative variables
+   * \param[out] CellFlags is 1 for cells to be visited, 0 elsewhere
+   */
+  Positivity_Cells_Indicator_Functor(HydroParams         params,
+				     SDM_Geometry<dim,N> sdm_geom,
+				     DataArray           UdataSol,
+				     DataArray           Uaverage,
+				     CellList            CellFlags) :
+    SDMBaseFunctor<dim,N>(params,sdm_geom),
+    UdataSol(UdataSol),
+    Uaverage(Uaverage),
+    CellFlags(CellFlags)
+  {};
+
+  // static method which does it all: create and execute functor
+  static void apply(HydroParams         params,
+                    SDM_Geometry<dim,N> sdm_geom,
+                    DataArray           UdataSol,
+                    DataArray           Uaverage,
+                    CellList            CellFlags)
+  {
+    Positivity_Cells_Indicator_Functor functor(params, sdm_geom,
+                                               UdataSol, Uaverage,
+                                               CellFlags);
+    Kokkos::parallel_for("Positivity_Cells_Indicator_Functor",
+                         md_policy<dim>(0, 0, 0,
+                                        params.isize, params.jsize, params.ksize,
+                                        params.mdrange_tile),
+                         functor);
+  }
+
+  /**
+   * Lebesgue constant of the solution points to flux points interpolation.
+   */
+  KOKKOS_INLINE_FUNCTION
+  real_t lebesgue_constant() const
+  {
+    real_t L = 0;
+    for (int j=0; j<N+1; ++j) {
+      real_t tmp = 0;
+      for (int k=0; k<N; ++k)
+	tmp += fabs(this->sdm_geom.sol2flux(k,j));
+      L = tmp > L ? tmp : L;
+    }
+    return L;
+  } // lebesgue_constant
+
+  /**
+   * Given cell averaged state and max deviation of each variable at
+   * solution points, decide if positivity may be violated at flux points.
+   */
+  KOKKOS_INLINE_FUNCTION
+  int is_flagged(const HydroState& uave, const HydroState& dev) const
+  {
+    const real_t gamma0 = this->params.settings.gamma0;
+    const real_t eps1 = this->params.settings.smallr;
+    const real_t eps2 = 1e-12; // small pressure test of Apply_positivity_Functor_v2
+
+    const real_t L = lebesgue_constant();
+
+    // density lower bound
+    const real_t rho_lo = uave[ID] - L*dev[ID];
+    if (rho_lo < eps1)
+      return 1;
+
+    // pressure lower bound
+    const real_t e_lo = uave[IE] - L*dev[IE];
+    real_t m2_hi = 0;
+    for (int d=0; d<dim; ++d) {
+      const int iv = IU+d;
+      const real_t m_hi = fabs(uave[iv]) + L*dev[iv];
+      m2_hi += m_hi*m_hi;
+    }
+
+    const real_t p_lo = (gamma0-1)*(e_lo - 0.5*m2_hi/rho_lo);
+
+    return p_lo < eps2 ? 1 : 0;
+
+  } // is_flagged
+
+  // ================================================
+  //
+  // 2D version.
+  //
+  // ================================================
+  //! functor for 2d
+  template<int dim_ = dim>
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const typename std::enable_if<dim_==2, int>::type& i,
+                  const int& j) const
+  {
+    const int isize = this->params.isize;
+    const int jsize = this->params.jsize;
+
+    const int nbvar = NbVar<dim>::value;
+
+    // flat cell index, as used by the cell list
+    const int index = coord2index(i,j,isize,jsize);
+
+    HydroState uave, dev;
+    for (int ivar = 0; ivar<nbvar; ++ivar) {
+      uave[ivar] = Uaverage(i,j,ivar);
+      dev[ivar] = 0;
+    }
+
+    for (int ivar = 0; ivar<nbvar; ++ivar) {
+      for (int idy=0; idy<N; ++idy) {
+	for (int idx=0; idx<N; ++idx) {
+	  const real_t d = fabs(UdataSol(i,j,dofMap(idx,idy,0,ivar)) - uave[ivar]);
+	  dev[ivar] = d > dev[ivar] ? d : dev[ivar];
+	}
+      }
+    }
+
+    CellFlags(index) = is_flagged(uave, dev);
+
+  } // operator () - 2d
+
+  // ================================================
+  //
+  // 3D version.
+  //
+  // ================================================
+  //! functor for 3d
+  template<int dim_ = dim>
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const typename std::enable_if<dim_==3, int>::type& i,
+                  const int& j,
+                  const int& k) const
+  {
+    const int isize = this->params.isize;
+    const int jsize = this->params.jsize;
+    const int ksize = this->params.ksize;
+
+    const int nbvar = NbVar<dim>::value;
+
+    // flat cell index, as used by the cell list
+    const int index = coord2index(i,j,k,isize,jsize,ksize);
+
+    HydroState uave, dev;
+    for (int ivar = 0; ivar<nbvar; ++ivar) {
+      uave[ivar] = Uaverage(i,j,k,ivar);
+      dev[ivar] = 0;
+    }
+
+    for (int ivar = 0; ivar<nbvar; ++ivar) {
+      for (int idz=0; idz<N; ++idz) {
+	for (int idy=0; idy<N; ++idy) {
+	  for (int idx=0; idx<N; ++idx) {
+	    const real_t d = fabs(UdataSol(i,j,k,dofMap(idx,idy,idz,ivar)) - uave[ivar]);
+	    dev[ivar] = d > dev[ivar] ? d : dev[ivar];
+	  }
+	}
+      }
+    }
+
+    CellFlags(index) = is_flagged(uave, dev);
+
+  } // operator () - 3d
+
+  DataArray UdataSol;
+  DataArray Uaverage;
+  CellList  CellFlags;
+
+}; // class Positivity_Cells_Indicator_Functor
+
+/*************************************************/
+/*************************************************/
+/*************************************************/
+/**
+ * Compact a flag array into a list of flagged cells indexes
+ * (exclusive prefix sum).
+ *
+ * The number of flagged cells is returned by apply.
+ */
+class Compact_Cell_List_Functor {
+
+public:
+  using CountView = Kokkos::View<int, Device>;
+
+  Compact_Cell_List_Functor(CellList  CellFlags,
+			    CellList  cellList,
+			    CountView count,
+			    int       nbCells) :
+    CellFlags(CellFlags),
+    cellList(cellList),
+    count(count),
+    nbCells(nbCells)
+  {};
+
+  // static method which does it all: create and execute functor
+  static int apply(CellList CellFlags,
+		   CellList cellList,
+		   int      nbCells)
+  {
+    CountView count("nbFlaggedCells");
+
+    Compact_Cell_List_Functor functor(CellFlags, cellList, count, nbCells);
+    Kokkos::parallel_scan("Compact_Cell_List_Functor", nbCells, functor);
+
+    CountView::HostMirror count_h = Kokkos::create_mirror_view(count);
+    Kokkos::deep_copy(count_h, count);
+
+    return count_h();
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const int& index, int& update, const bool final) const
+  {
+    const int flag = CellFlags(index);
+
+    if (final) {
+      if (flag)
+	cellList(update) = index;
+      if (index == nbCells-1)
+	count() = update + flag;
+    }
+
+    update += flag;
+  }
+
+  CellList  CellFlags;
+  CellList  cellList;
+  CountView count;
+  int       nbCells;
+
+}; // class Compact_Cell_List_Functor
+
+} // namespace sdm
+
+#endif // SDM_TROUBLED_CELLS_FUNCTORS_H_
@@ -80,9 +80,26 @@ public:
 					 DataArray                   UdataFlux) :
     SDMBaseFunctor<dim,N>(params,sdm_geom),
     euler(euler),
+    FUgrad(FUgrad),
     UdataFlux(UdataFlux)
   {};
 
+  // static method which does it all: create and execute functor
+  static void apply(HydroParams                 params,
+                    SDM_Geometry<dim,N>         sdm_geom,
+                    ppkMHD::EulerEquations<dim> euler,
+                    DataArray                   FUgrad,
+                    DataArray                   UdataFlux)
+  {
+    ComputeViscousFluxAtFluxPoints_Functor functor(params, sdm_geom, euler,
+                                                   FUgrad, UdataFlux);
+    Kokkos::parallel_for("ComputeViscousFluxAtFluxPoints_Functor",
+                         md_policy<dim>(0, 0, 0,
+                                        params.isize, params.jsize, params.ksize,
+                                        params.mdrange_tile),
+                         functor);
+  }
+
   // ================================================
   //
   // 2D version.
@@ -91,16 +108,10 @@ public:
   //! functor for 2d 
   template<int dim_ = dim>
   KOKKOS_INLINE_FUNCTION
-  void operator()(const typename std::enable_if<dim_==2, int>::type& index) const
+  void operator()(const typename std::enable_if<dim_==2, int>::type& i,
+                  const int& j) const
   {
-    const int isize = this->params.isize;
-    const int jsize = this->params.jsize;
-
-    const int nbvar = this->params.nbvar;
-
-    // local cell index
-    int i,j;
-    index2coord(index,i,j,isize,jsize);
+    const int nbvar = NbVar<dim>::value;
 
     // velocity vector
     Vector vel;
@@ -198,18 +209,12 @@ public:
   //! functor for 3d 
   template<int dim_ = dim>
   KOKKOS_INLINE_FUNCTION
-  void operator()(const typename std::enable_if<dim_==3, int>::type& index) const
+  void operator()(const typename std::enable_if<dim_==3, int>::type& i,
+                  const int& j,
+                  const int& k) const
   {
 
-    const int isize = this->params.isize;
-    const int jsize = this->params.jsize;
-    const int ksize = this->params.ksize;
-
-    const int nbvar = this->params.nbvar;
-
-    // local cell index
-    int i,j,k;
-    index2coord(index,i,j,k,isize,jsize,ksize);
+    const int nbvar = NbVar<dim>::value;
 
     // velocity vector
     Vector vel;
@@ -29,6 +29,7 @@
 #include "sdm/SDM_Dt_Functor.h"
 
 #include "sdm/SDM_Interpolate_Functors.h"
+#include "sdm/SDM_Interpolate_Functors2.h"
 #include "sdm/SDM_Interpolate_viscous_Functors.h"
 
 #include "sdm/SDM_Flux_Functors.h"
@@ -41,6 +42,8 @@
 #include "sdm/SDM_Boundaries_Functors_Jet.h"
 #include "sdm/SDM_Limiter_Functors.h"
 #include "sdm/SDM_Positivity_preserving.h"
+#include "sdm/SDM_Troubled_Cells_Functors.h"
+#include "sdm/SDM_Face_Trace_Functors.h"
 
 // for IO
 #include "utils/io/IO_ReadWrite_SDM.h"
@@ -112,6 +115,12 @@ namespace sdm {
  * limiter_characteristics_enabled=true
  * in the sdm section of the ini parameter file.
  *
+ * Limiting and positivity preserving can be restricted to troubled cells
+ * (parameter troubled_cells_enabled=true); a cheap indicator computed from
+ * Uaverage flags cells, which are then compacted into a list; gradient,
+ * limiter and positivity functors only visit listed cells.
+ * The limiter indicator threshold is set by parameter troubled_cells_threshold.
+ *
  * If viscous terms computation is enabled, we need 
  * - Ugrax_v, Ugrady_v (and Ugradz_v) allocated;
  *   these arrays are used to store velocity gradients at soluton points.
@@ -120,6 +129,19 @@ namespace sdm {
  *
  * If thermal_diffusivity_terms_enabled, temperature gradients need to be stored.
  *
+ * With MPI, parameter face_trace_halo=true replaces the ghost cells
+ * exchange between sub-domains by an exchange of face traces (solution,
+ * and for viscous terms velocity and velocity gradients, interpolated at
+ * the flux points of the sub-domain faces), see SDM_Face_Trace_Functors.h.
+ * Ghost cells of MPI faces are then only filled at initialization; this
+ * mode is not available with the limiter, which needs cell-averaged values
+ * of the neighbor cells.
+ *
+ * Alternatively, [mpi] deep_halo_stages=s widens ghost cells so that
+ * they are exchanged once every s Runge-Kutta stages (deep halos, see
+ * SolverBase::deep_halo_stage); the update functors of intermediate stages
+ * then also update the ghost cells which only depend on valid data.
+ *
  */
 template<int dim, int N>
 class SolverHydroSDM : public ppkMHD::SolverBase
@@ -182,6 +204,13 @@ public:
   DataArray     Ugradz_v; /* velocity gradient-z, used and allocated only if viscous terms enabled */
 
   DataArray     FUgrad; /* velocity and velocity gradient at flux points */
+
+  /*
+   * troubled cells specific arrays (allocated only if troubled_cells_enabled)
+   */
+  CellList      TroubledCellsFlags; /*!< per cell flag (1 means troubled) */
+  CellList      LimiterCells;       /*!< list of cells to be limited */
+  CellList      PositivityCells;    /*!< list of cells to be visited by positivity preserving */
   
   //! Runge-Kutta temporary array (will be allocated only if necessary)
   DataArray     U_RK1, U_RK2, U_RK3, U_RK4;
@@ -189,6 +218,12 @@ public:
   //! fluxes : intermediate array containing fluxes, used in
   //! compute_fluxes_divergence_per_dir
   DataArray Fluxes;
+
+#ifdef USE_MPI
+  //! face traces MPI buffers, per direction and per side (FACE_MIN / FACE_MAX)
+  TraceBuffer traceBufSend[3][2];
+  TraceBuffer traceBufRecv[3][2];
+#endif // USE_MPI
   
   /*
    * Override base class method to initialize IO writer object
@@ -207,6 +242,10 @@ public:
 
   //! initialize sdm (geometric terms matrix)
   void init_sdm_geometry();
+
+  //! (re)allocate work arrays living in the scratch arena (Fluxes and
+  //! limiter gradients) for the current sub-domain sizes
+  void init_scratch_arrays();
     
   //! compute time step inside an MPI process, at shared memory level.
   double compute_dt_local();
@@ -257,6 +296,14 @@ public:
   //! \param[out] Ugrad (velocity gradient in direction dir, at solution points)
   template<int dir>
   void compute_velocity_gradients(DataArray Udata, DataArray Ugrad);
+
+  //! exchange face traces (values at flux points on sub-domain faces
+  //! normal to dir) with MPI neighbors, and store the received traces at
+  //! the flux points of the ghost cells (only if face_trace_halo_enabled)
+  //! \param[in,out] UdataFlux data at flux points (Fluxes or FUgrad)
+  //! \param[in] nbvar number of variables to exchange (variables 0 to nbvar-1)
+  template<int dir>
+  void exchange_face_traces(DataArray UdataFlux, int nbvar);
   
   //! compute flux divergence, the main term to perform the actual update
   //! in one of the Runge-Kutta methods.
@@ -309,12 +356,25 @@ public:
   //! main boundaries routine (this is were serial / mpi switch happens)
   void make_boundaries(DataArray Udata);
 
+  //! boundaries before a Runge-Kutta stage : with deep halos, MPI ghost
+  //! cells are exchanged only once every few stages, physical boundaries
+  //! are filled at every stage (see SolverBase::deep_halo_stage)
+  void make_boundaries_stage(DataArray Udata);
+
   //! here we call boundaries condition for serial execution
   void make_boundaries_sdm_serial(DataArray Udata, bool mhd_enabled);
 
 #ifdef USE_MPI
   //! here we call boundaries condition for mpi execution
   void make_boundaries_sdm_mpi(DataArray Udata, bool mhd_enabled);
+
+  //! boundaries condition of physical faces only (MPI faces are dealt
+  //! with by face traces exchange)
+  void make_boundaries_sdm_physical(DataArray Udata, bool mhd_enabled);
+
+  //! face traces mode : allocate MPI buffers, fill once all ghost cells
+  //! of U and of Runge-Kutta arrays (with valid, if outdated, states)
+  void init_face_trace_halo();
 #endif // USE_MPI
   
   // host routines (initialization)
@@ -331,6 +391,14 @@ public:
 
   void save_solution_impl();
 
+#ifdef USE_MPI
+  //! dynamic load balancing : migrate U (all DoFs of each cell)
+  void load_balancing_migrate(int dir, int shiftMin, int shiftMax);
+
+  //! dynamic load balancing : reallocate work arrays
+  void load_balancing_resize();
+#endif // USE_MPI
+
   //! debug routine that saves a flux data array (for a given direction)
   // template <int dir>
   // void save_flux();
@@ -352,11 +420,30 @@ public:
   //! positivity preserving (density + pressure)
   bool positivity_enabled;
 
+  //! restrict limiting / positivity preserving to troubled cells
+  bool troubled_cells_enabled;
+
+  //! sensor value above which a cell is flagged for limiting
+  real_t troubled_cells_threshold;
+
+  //! number of cells listed (last computed) in LimiterCells / PositivityCells
+  int nbLimiterCells;
+  int nbPositivityCells;
+
+  //! print fraction of troubled cells (called every nlog steps)
+  void print_troubled_cells_fraction();
+
   //! viscous terms
   bool viscous_terms_enabled;
 
   //! thermal diffusivity terms : kappa * rho * cp * gradient(T)
   bool thermal_diffusivity_terms_enabled;
+
+  //! exchange face traces instead of ghost cells between MPI sub-domains
+  bool face_trace_halo_enabled;
+
+  //! variant of the interpolation at flux points (1 or 2, same result)
+  int interpolation_version;
   
   int isize, jsize, ksize, nbCells;
 
@@ -387,8 +474,14 @@ SolverHydroSDM<dim,N>::SolverHydroSDM(HydroParams& params,
   limiter_enabled(false),
   limiter_characteristics_enabled(false),
   positivity_enabled(false),
+  troubled_cells_enabled(false),
+  troubled_cells_threshold(0.01),
+  nbLimiterCells(0),
+  nbPositivityCells(0),
   viscous_terms_enabled(false),
   thermal_diffusivity_terms_enabled(false),
+  face_trace_halo_enabled(false),
+  interpolation_version(1),
   isize(params.isize),
   jsize(params.jsize),
   ksize(params.ksize),
@@ -397,6 +490,8 @@ SolverHydroSDM<dim,N>::SolverHydroSDM(HydroParams& params,
 
   solver_type = SOLVER_SDM;
 
+  m_load_balancing_supported = true;
+
   if (dim==3)
     nbCells = params.isize*params.jsize*params.ksize;
   
@@ -407,9 +502,6 @@ SolverHydroSDM<dim,N>::SolverHydroSDM(HydroParams& params,
 
   m_nDofsPerCell = nb_dof_per_cell;
   
-  // useful for allocating Fluxes, for conservative variables at flux points
-  int nb_dof_flux = dim==2 ? (N+1)*N*params.nbvar : (N+1)*N*N*params.nbvar;
-  
   long long int total_mem_size = 0;
 
   // clear variables_names map -- hydro only, for now (MHD later)
@@ -442,24 +534,18 @@ SolverHydroSDM<dim,N>::SolverHydroSDM(HydroParams& params,
     U     = DataArray("U", isize, jsize, nb_dof);
     Uhost = Kokkos::create_mirror(U);
     Uaux  = DataArray("Uaux",isize, jsize, nb_dof);
-    
-    Fluxes = DataArray("Fluxes", isize, jsize, nb_dof_flux);
 
     total_mem_size += isize*jsize*nb_dof      * sizeof(real_t); // U
     total_mem_size += isize*jsize*nb_dof      * sizeof(real_t); // Uaux
-    total_mem_size += isize*jsize*nb_dof_flux * sizeof(real_t); // Fluxes
     
   } else if (dim==3) {
 
     U     = DataArray("U", isize, jsize, ksize, nb_dof);
     Uhost = Kokkos::create_mirror(U);
     Uaux  = DataArray("Uaux",isize, jsize, ksize, nb_dof);
-    
-    Fluxes = DataArray("Fluxes", isize, jsize, ksize, nb_dof_flux);
 
     total_mem_size += isize*jsize*ksize*nb_dof      * sizeof(real_t); // U
     total_mem_size += isize*jsize*ksize*nb_dof      * sizeof(real_t); // Uaux
-    total_mem_size += isize*jsize*ksize*nb_dof_flux * sizeof(real_t); // Fluxes
 
   }
 
@@ -567,23 +653,10 @@ SolverHydroSDM<dim,N>::SolverHydroSDM(HydroParams& params,
   limiter_enabled = configMap.getBool("sdm", "limiter_enabled", false);
 
   /*
-   * Ugradx / Ugrady / Ugradz memory allocation
+   * Fluxes and Ugradx / Ugrady / Ugradz (limiter) memory allocation
    */
-  if (limiter_enabled) {
-    
-    // memory allocation to store cell-averaged gradient components
-    if (dim==2) {
-      Ugradx   = DataArray("Ugradx"    ,isize,jsize,params.nbvar);
-      Ugrady   = DataArray("Ugrady"    ,isize,jsize,params.nbvar);
-      total_mem_size += isize*jsize*params.nbvar * 2 * sizeof(real_t);
-    } else if (dim==3) {
-      Ugradx   = DataArray("Ugradx"    ,isize,jsize,ksize,params.nbvar);
-      Ugrady   = DataArray("Ugrady"    ,isize,jsize,ksize,params.nbvar);
-      Ugradz   = DataArray("Ugradz"    ,isize,jsize,ksize,params.nbvar);
-      total_mem_size += isize*jsize*ksize*params.nbvar * 3 * sizeof(real_t);
-    }
-
-  }
+  init_scratch_arrays();
+  total_mem_size += m_scratch.size();
   
   limiter_characteristics_enabled = configMap.getBool("sdm", "limiter_characteristics_enabled", false);
     
@@ -605,6 +678,67 @@ SolverHydroSDM<dim,N>::SolverHydroSDM(HydroParams& params,
     }
     
   }
+
+  /*
+   * troubled cells detection
+   */
+  troubled_cells_enabled = configMap.getBool("sdm", "troubled_cells_enabled", false);
+  troubled_cells_threshold = configMap.getFloat("sdm", "troubled_cells_threshold", 0.01);
+
+  if (troubled_cells_enabled and (positivity_enabled or limiter_enabled)) {
+
+    TroubledCellsFlags = CellList("TroubledCellsFlags", nbCells);
+    total_mem_size += nbCells * sizeof(int);
+    
+    if (limiter_enabled) {
+      LimiterCells = CellList("LimiterCells", nbCells);
+      total_mem_size += nbCells * sizeof(int);
+    }
+    
+    if (positivity_enabled) {
+      PositivityCells = CellList("PositivityCells", nbCells);
+      total_mem_size += nbCells * sizeof(int);
+    }
+
+  } else {
+
+    troubled_cells_enabled = false;
+
+  }
+
+  /*
+   * face traces exchange between MPI sub-domains
+   */
+  face_trace_halo_enabled = configMap.getBool("sdm", "face_trace_halo", false);
+
+#ifdef USE_MPI
+  if (face_trace_halo_enabled and limiter_enabled) {
+    if (params.myRank==0)
+      std::cout << "[sdm] face_trace_halo is not compatible with limiter_enabled, "
+		<< "using ghost cells exchange\n";
+    face_trace_halo_enabled = false;
+  }
+
+  // deep halos need full ghost cells
+  if (face_trace_halo_enabled and m_deep_halo_stages > 1) {
+    if (params.myRank==0)
+      std::cout << "[mpi] deep_halo_stages is not used with face_trace_halo\n";
+    m_deep_halo_stages = 1;
+    deep_halo_reset();
+  }
+#else
+  face_trace_halo_enabled = false;
+#endif // USE_MPI
+
+  /*
+   * interpolation at flux points : one thread per cell (1) or, in 2D,
+   * one thread per flux point (2)
+   */
+  interpolation_version = configMap.getInteger("sdm", "interpolation_version", 1);
+  if (interpolation_version != 1 and interpolation_version != 2) {
+    std::cout << "[sdm] interpolation_version must be 1 or 2, using 1\n";
+    interpolation_version = 1;
+  }
   
   /*
    * initialize hydro array at t=0
@@ -704,8 +838,23 @@ SolverHydroSDM<dim,N>::SolverHydroSDM(HydroParams& params,
     total_mem_size += isize * jsize * gw    * nb_dof * 4 * sizeof(real_t);
     
   }
+
+  if (face_trace_halo_enabled) {
+    // velocity and velocity gradients traces for viscous terms
+    const int nbvar_trace = viscous_terms_enabled ?
+      std::max(params.nbvar, dim+dim*dim) : params.nbvar;
+    const int nb_face_pts = dim==2 ? N : N*N;
+
+    const int nb_face_cells = dim==2 ?
+      jsize + isize : jsize*ksize + isize*ksize + isize*jsize;
+
+    total_mem_size += nb_face_cells * nb_face_pts * nbvar_trace * 4 * sizeof(real_t);
+  }
 #endif // USE_MPI
 
+  // footprint of the most loaded process
+  const double mem_size = max_memory_footprint(total_mem_size);
+
   int myRank=0;
 #ifdef USE_MPI
   myRank = params.myRank;
@@ -721,12 +870,20 @@ SolverHydroSDM<dim,N>::SolverHydroSDM(HydroParams& params,
     std::cout << "SSPRK2        : " << ssprk2_enabled << "\n";
     std::cout << "SSPRK3        : " << ssprk3_enabled << "\n";
     std::cout << "SSPRK54       : " << ssprk54_enabled << "\n";
+    std::cout << "Limiter       : " << limiter_enabled << "\n";
+    std::cout << "Positivity    : " << positivity_enabled << "\n";
+    std::cout << "Troubled cells only : " << troubled_cells_enabled << "\n";
+    std::cout << "Face traces halo    : " << face_trace_halo_enabled << "\n";
+    std::cout << "Interpolation version : " << interpolation_version << "\n";
+    std::cout << "Deep halo stages    : " << m_deep_halo_stages << "\n";
     std::cout << "##########################" << "\n";
     
     // print parameters on screen
     params.print();
     std::cout << "##########################" << "\n";
-    std::cout << "Memory requested : " << (total_mem_size / 1e6) << " MBytes\n"; 
+    std::cout << "Memory requested : " << (mem_size / 1e6) << " MBytes per process (peak)\n";
+    std::cout << "Work arrays      : " << (m_scratch.size() / 1e6) << " MBytes ("
+	      << (m_scratch.requested_size() / 1e6) << " MBytes without aliasing)\n";
     std::cout << "##########################" << "\n";
   }
   
@@ -735,6 +892,11 @@ SolverHydroSDM<dim,N>::SolverHydroSDM(HydroParams& params,
 
   // initialize boundaries
   make_boundaries(U);
+
+#ifdef USE_MPI
+  if (face_trace_halo_enabled)
+    init_face_trace_halo();
+#endif // USE_MPI
   
 } // SolverHydroSDM::SolverHydroSDM
 
@@ -778,6 +940,51 @@ void SolverHydroSDM<dim,N>::init_io()
   
 } // SolverHydroSDM<dim,N>::init_io
 
+// =======================================================
+// =======================================================
+template<int dim, int N>
+void SolverHydroSDM<dim,N>::init_scratch_arrays()
+{
+
+  /*
+   * phases of compute_fluxes_divergence : limiter gradients are only
+   * used while limiting, Fluxes (erased before each direction) only
+   * afterwards, so that they share the same memory.
+   */
+  enum { PHASE_LIMITING, PHASE_FLUXES };
+
+  const int nbvar = params.nbvar;
+
+  // conservative variables at flux points
+  const int nb_dof_flux = dim==2 ? (N+1)*N*nbvar : (N+1)*N*N*nbvar;
+
+  m_scratch.clear();
+
+  if (dim==2) {
+
+    m_scratch.declare(Fluxes, PHASE_FLUXES, PHASE_FLUXES, isize, jsize, nb_dof_flux);
+
+    if (limiter_enabled) {
+      m_scratch.declare(Ugradx, PHASE_LIMITING, PHASE_LIMITING, isize,jsize,nbvar);
+      m_scratch.declare(Ugrady, PHASE_LIMITING, PHASE_LIMITING, isize,jsize,nbvar);
+    }
+
+  } else {
+
+    m_scratch.declare(Fluxes, PHASE_FLUXES, PHASE_FLUXES, isize, jsize, ksize, nb_dof_flux);
+
+    if (limiter_enabled) {
+      m_scratch.declare(Ugradx, PHASE_LIMITING, PHASE_LIMITING, isize,jsize,ksize,nbvar);
+      m_scratch.declare(Ugrady, PHASE_LIMITING, PHASE_LIMITING, isize,jsize,ksize,nbvar);
+      m_scratch.declare(Ugradz, PHASE_LIMITING, PHASE_LIMITING, isize,jsize,ksize,nbvar);
+    }
+
+  }
+
+  m_scratch.allocate();
+
+} // SolverHydroSDM::init_scratch_arrays
+
 // =======================================================
 // =======================================================
 template<int dim, int N>
@@ -846,6 +1053,10 @@ void SolverHydroSDM<dim,N>::next_iteration_impl()
       printf("time   step=%7d (dt=% 10.8g t=% 10.8f)\n",m_iteration,m_dt, m_t);
     }
   }
+
+  // troubled cells statistics from previous step
+  if (troubled_cells_enabled and m_iteration>0 and m_iteration % params.nlog == 0)
+    print_troubled_cells_fraction();
   
   // output
   if (params.enableOutput) {
@@ -868,6 +1079,63 @@ void SolverHydroSDM<dim,N>::next_iteration_impl()
   
 } // SolverHydroSDM::next_iteration_impl
 
+#ifdef USE_MPI
+// =======================================================
+// =======================================================
+template<int dim, int N>
+void SolverHydroSDM<dim,N>::load_balancing_migrate(int dir,
+						   int shiftMin,
+						   int shiftMax)
+{
+
+  U = migrate_data(U, dir, shiftMin, shiftMax);
+
+} // SolverHydroSDM::load_balancing_migrate
+
+// =======================================================
+// =======================================================
+template<int dim, int N>
+void SolverHydroSDM<dim,N>::load_balancing_resize()
+{
+
+  isize = params.isize;
+  jsize = params.jsize;
+  ksize = params.ksize;
+  nbCells = dim==2 ? isize*jsize : isize*jsize*ksize;
+  m_nCells = nbCells;
+
+  realloc_domain(Uaux);
+  realloc_domain(U_RK1);
+  realloc_domain(U_RK2);
+  realloc_domain(U_RK3);
+  realloc_domain(U_RK4);
+  realloc_domain(Ugradx_v);
+  realloc_domain(Ugrady_v);
+  realloc_domain(Ugradz_v);
+  realloc_domain(FUgrad);
+  realloc_domain(Uaverage);
+
+  init_scratch_arrays();
+
+  if (troubled_cells_enabled) {
+    Kokkos::realloc(TroubledCellsFlags, nbCells);
+    if (limiter_enabled)
+      Kokkos::realloc(LimiterCells, nbCells);
+    if (positivity_enabled)
+      Kokkos::realloc(PositivityCells, nbCells);
+  }
+
+  Uhost = Kokkos::create_mirror(U);
+
+  // fill ghost cells of the migrated state
+  make_boundaries(U);
+
+  if (face_trace_halo_enabled)
+    init_face_trace_halo();
+
+} // SolverHydroSDM::load_balancing_resize
+#endif // USE_MPI
+
 // =======================================================
 // =======================================================
 // ///////////////////////////////////////////
@@ -894,7 +1162,7 @@ void SolverHydroSDM<dim,N>::time_integration_impl(DataArray Udata,
   
   // fill ghost cell in Udata
   timers[TIMER_BOUNDARIES]->start();
-  make_boundaries(Udata);
+  make_boundaries_stage(Udata);
   timers[TIMER_BOUNDARIES]->stop();
       
   // start main computation
@@ -949,10 +1217,35 @@ void SolverHydroSDM<dim,N>::apply_positivity_preserving(DataArray Udata)
 {
 
   if (positivity_enabled) {
-    Apply_positivity_Functor_v2<dim,N>::apply(params,
-                                              sdm_geom,
-                                              Udata,
-                                              Uaverage);
+
+    if (troubled_cells_enabled) {
+
+      // only visit cells where positivity may be violated
+      Positivity_Cells_Indicator_Functor<dim,N>::apply(params,
+                                                       sdm_geom,
+                                                       Udata,
+                                                       Uaverage,
+                                                       TroubledCellsFlags);
+
+      nbPositivityCells = Compact_Cell_List_Functor::apply(TroubledCellsFlags,
+                                                           PositivityCells,
+                                                           nbCells);
+
+      Apply_positivity_Functor_v2<dim,N>::apply(params,
+                                                sdm_geom,
+                                                Udata,
+                                                Uaverage,
+                                                PositivityCells,
+                                                nbPositivityCells);
+
+    } else {
+
+      Apply_positivity_Functor_v2<dim,N>::apply(params,
+                                                sdm_geom,
+                                                Udata,
+                                                Uaverage);
+
+    }
   }
   
 } // SolverHydroSDM<dim,N>::apply_positivity_preserving
@@ -977,23 +1270,49 @@ void SolverHydroSDM<dim,N>::apply_limiting(DataArray Udata)
   
   if (limiter_enabled) {
 
+    // by default, visit all cells
+    int nbListedCells = -1;
+
+    if (troubled_cells_enabled) {
+
+      // flag troubled cells from Uaverage, and build the list of cells
+      // to be limited
+      Troubled_Cells_Indicator_Functor<dim,N>::apply(params,
+                                                     sdm_geom,
+                                                     Uaverage,
+                                                     TroubledCellsFlags,
+                                                     troubled_cells_threshold);
+
+      nbLimiterCells = Compact_Cell_List_Functor::apply(TroubledCellsFlags,
+                                                        LimiterCells,
+                                                        nbCells);
+      nbListedCells = nbLimiterCells;
+
+    }
+
     // we assume here that Uaverage has been computed in routine apply_pre_step_computation
     // we just need to compute cell-average gradient component.
     Average_Gradient_Functor<dim,N,IX>::apply(params,
                                               sdm_geom,
                                               Udata,
-                                              Ugradx);
+                                              Ugradx,
+                                              LimiterCells,
+                                              nbListedCells);
 
     Average_Gradient_Functor<dim,N,IY>::apply(params,
                                               sdm_geom,
                                               Udata,
-                                              Ugrady);
+                                              Ugrady,
+                                              LimiterCells,
+                                              nbListedCells);
     
     if (dim == 3) {
       Average_Gradient_Functor<dim,N,IZ>::apply(params,
                                                 sdm_geom,
                                                 Udata,
-                                                Ugradz);
+                                                Ugradz,
+                                                LimiterCells,
+                                                nbListedCells);
     }
 
     // retrieve parameter M_TVB (used in the modified minmod routine)
@@ -1010,12 +1329,43 @@ void SolverHydroSDM<dim,N>::apply_limiting(DataArray Udata)
                                         Ugradx,
                                         Ugrady,
                                         Ugradz,
-                                        Mdx2);
+                                        Mdx2,
+                                        LimiterCells,
+                                        nbListedCells);
     
   } // end limiter_enabled
   
 } // SolverHydroSDM<dim,N>::apply_limiting
 
+// =======================================================
+// =======================================================
+template<int dim, int N>
+void SolverHydroSDM<dim,N>::print_troubled_cells_fraction()
+{
+
+  int myRank=0;
+  int counts[3] = {nbLimiterCells, nbPositivityCells, nbCells};
+  
+#ifdef USE_MPI
+  myRank = params.myRank;
+
+  int counts_global[3];
+  params.communicator->allReduce(counts, counts_global, 3,
+                                 hydroSimu::MpiComm::INT,
+                                 hydroSimu::MpiComm::SUM);
+  for (int i=0; i<3; ++i)
+    counts[i] = counts_global[i];
+#endif // USE_MPI
+
+  if (myRank==0) {
+    if (limiter_enabled)
+      printf("troubled cells (limiter)    : %6.2f %%\n", 100.0*counts[0]/counts[2]);
+    if (positivity_enabled)
+      printf("troubled cells (positivity) : %6.2f %%\n", 100.0*counts[1]/counts[2]);
+  }
+  
+} // SolverHydroSDM<dim,N>::print_troubled_cells_fraction
+
 // =======================================================
 // =======================================================
 template<int dim, int N>
@@ -1032,10 +1382,20 @@ void SolverHydroSDM<dim,N>::compute_invicid_fluxes_divergence_per_dir(DataArray
     return;
   
   // 1. interpolate conservative variables from solution points to flux points
-  Interpolate_At_FluxPoints_Functor<dim,N,dir>::apply(params,
-                                                      sdm_geom,
-                                                      Udata,
-                                                      Fluxes);
+  if (interpolation_version == 2)
+    Interpolate_At_FluxPoints_Functor_v2<dim,N,dir>::apply(params,
+                                                           sdm_geom,
+                                                           Udata,
+                                                           Fluxes);
+  else
+    Interpolate_At_FluxPoints_Functor<dim,N,dir>::apply(params,
+                                                        sdm_geom,
+                                                        Udata,
+                                                        Fluxes);
+
+  // 1.1 ghost cells of MPI faces : use neighbor face traces
+  if (face_trace_halo_enabled)
+    exchange_face_traces<dir>(Fluxes, params.nbvar);
   
   // 2. inplace computation of fluxes along direction <dir> at flux points
   ComputeFluxAtFluxPoints_Functor<dim,N,dir>::apply(params,
@@ -1075,10 +1435,8 @@ void SolverHydroSDM<dim,N>::compute_viscous_fluxes_divergence_per_dir(DataArray
                                                             Udata,
                                                             FUgrad);
   
-  // 2. average velocity at cell borders
-  Average_component_at_cell_borders_Functor<dim,N,dir>::apply(params,
-                                                              sdm_geom,
-                                                              FUgrad);
+  // 2. velocity is averaged at cell borders after step 3, so that
+  //    velocity and velocity gradients face traces go in a single message
   
   // 3.1. interpolate velocity gradients-x from solution points to flux points
   Interpolate_velocity_gradients_Sol2Flux_Functor<dim,N,dir,IX>
@@ -1093,8 +1451,18 @@ void SolverHydroSDM<dim,N>::compute_viscous_fluxes_divergence_per_dir(DataArray
     Interpolate_velocity_gradients_Sol2Flux_Functor<dim,N,dir,IZ>
       ::apply(params, sdm_geom, Ugradz_v, FUgrad);
   }
+
+  // 3.4 ghost cells of MPI faces : use neighbor face traces
+  //     (velocity + velocity gradients are the dim+dim*dim first components)
+  if (face_trace_halo_enabled)
+    exchange_face_traces<dir>(FUgrad, dim+dim*dim);
+  
+  // 4.1 average velocity at cell borders
+  Average_component_at_cell_borders_Functor<dim,N,dir>::apply(params,
+                                                              sdm_geom,
+                                                              FUgrad);
   
-  // 4. average velocity gradients at cell border
+  // 4.2 average velocity gradients at cell border
   {
     int nvar_to_average = dim*dim;
     var_index_t var_index;
@@ -1118,25 +1486,18 @@ void SolverHydroSDM<dim,N>::compute_viscous_fluxes_divergence_per_dir(DataArray
       var_index[8] = (int) VarIndexGrad3d::IGWZ;
     }
     
-    Average_component_at_cell_borders_Functor<dim,N,dir> functor(params,
-                                                                 sdm_geom, 
-                                                                 FUgrad,
-								 nvar_to_average,
-                                                                 var_index);
-    Kokkos::parallel_for(nbCells, functor);
+    Average_component_at_cell_borders_Functor<dim,N,dir>::apply(params,
+                                                                sdm_geom,
+                                                                FUgrad,
+                                                                nvar_to_average,
+                                                                var_index);
   }
   
   // 5.1 Now one can compute viscous fluxes at flux points
-  {
-    ComputeViscousFluxAtFluxPoints_Functor<dim,N,dir> functor(params, sdm_geom, euler, FUgrad, Fluxes);
-    Kokkos::parallel_for(nbCells, functor);
-  }
+  ComputeViscousFluxAtFluxPoints_Functor<dim,N,dir>::apply(params, sdm_geom, euler, FUgrad, Fluxes);
   
   // 5.2 Finally compute derivative and accumulate (with negative sign) in Udata_fdiv
-  {
-    Interpolate_At_SolutionPoints_Functor<dim,N,dir,INTERPOLATE_DERIVATIVE_NEGATIVE> functor(params, sdm_geom, FUgrad, Udata_fdiv);
-    Kokkos::parallel_for(nbCells, functor);
-  }
+  Interpolate_At_SolutionPoints_Functor<dim,N,dir,INTERPOLATE_DERIVATIVE_NEGATIVE>::apply(params, sdm_geom, FUgrad, Udata_fdiv);
   
 } // SolverHydroSDM<dim,N>::compute_viscous_fluxes_divergence_per_dir
 
@@ -1163,6 +1524,10 @@ void SolverHydroSDM<dim,N>::compute_velocity_gradients(DataArray Udata, DataArra
                                                             Udata,
                                                             Fluxes);
 
+  // 1.1 ghost cells of MPI faces : use neighbor face traces
+  if (face_trace_halo_enabled)
+    exchange_face_traces<dir>(Fluxes, dim);
+
   // 2. average velocity at cell borders
   Average_component_at_cell_borders_Functor<dim,N,dir>::apply(params,
                                                               sdm_geom,
@@ -1174,6 +1539,69 @@ void SolverHydroSDM<dim,N>::compute_velocity_gradients(DataArray Udata, DataArra
     ::apply(params, sdm_geom, Fluxes, Ugrad);
   
 } // SolverHydroSDM<dim,N>::compute_velocity_gradients
+
+// =======================================================
+// =======================================================
+template<int dim, int N>
+template<int dir>
+void SolverHydroSDM<dim,N>::exchange_face_traces(DataArray UdataFlux, int nbvar)
+{
+
+#ifdef USE_MPI
+  
+  if (dim==2 and dir==IZ)
+    return;
+
+  using namespace hydroSimu;
+
+  using CopyFunctor = Copy_Face_Trace_Functor<dim,N,dir>;
+
+  const NeighborLocation nmin = dir==IX ? X_MIN : (dir==IY ? Y_MIN : Z_MIN);
+  const NeighborLocation nmax = dir==IX ? X_MAX : (dir==IY ? Y_MAX : Z_MAX);
+
+  TraceBuffer sendMin = traceBufSend[dir][FACE_MIN];
+  TraceBuffer sendMax = traceBufSend[dir][FACE_MAX];
+  TraceBuffer recvMin = traceBufRecv[dir][FACE_MIN];
+  TraceBuffer recvMax = traceBufRecv[dir][FACE_MAX];
+
+  // 1. copy outer-most interior cells face traces to MPI buffers
+  CopyFunctor::apply(params, sdm_geom, UdataFlux, sendMin,
+		     FACE_MIN, FACE_TRACE_PACK, nbvar);
+  CopyFunctor::apply(params, sdm_geom, UdataFlux, sendMax,
+		     FACE_MAX, FACE_TRACE_PACK, nbvar);
+  Kokkos::fence();
+
+  // 2. send/recv buffers (only the nbvar first variables)
+  const int count = CopyFunctor::buffer_size(params, nbvar);
+  const int data_type = params.storage_data_type;
+  const int tag = 121 + 100*dir;
+
+  params.communicator->sendrecv(sendMin.data(), count,
+				data_type, params.neighborsRank[nmin], tag,
+				recvMax.data(), count,
+				data_type, params.neighborsRank[nmax], tag);
+
+  params.communicator->sendrecv(sendMax.data(), count,
+				data_type, params.neighborsRank[nmax], tag,
+				recvMin.data(), count,
+				data_type, params.neighborsRank[nmin], tag);
+
+  // 3. received traces to ghost cells flux points (MPI faces only)
+  if (params.neighborsBC[nmin] == BC_COPY ||
+      params.neighborsBC[nmin] == BC_PERIODIC) {
+    CopyFunctor::apply(params, sdm_geom, UdataFlux, recvMin,
+		       FACE_MIN, FACE_TRACE_UNPACK, nbvar);
+  }
+
+  if (params.neighborsBC[nmax] == BC_COPY ||
+      params.neighborsBC[nmax] == BC_PERIODIC) {
+    CopyFunctor::apply(params, sdm_geom, UdataFlux, recvMax,
+		       FACE_MAX, FACE_TRACE_UNPACK, nbvar);
+  }
+
+#endif // USE_MPI
+  
+} // SolverHydroSDM<dim,N>::exchange_face_traces
   
 // =======================================================
 // =======================================================
@@ -1242,7 +1670,7 @@ void SolverHydroSDM<dim,N>::time_int_forward_euler(DataArray Udata,
   // translated into Udata = 1.0*Udata + 0.0*Udata - dt * Udata_fdiv 
   {
     coefs_t coefs = {1.0, 0.0, -1.0};
-    SDM_Update_RK_Functor<dim,N>::apply(params, sdm_geom, Udata, Udata, Udata, Udata_fdiv, coefs, dt);
+    SDM_Update_RK_Functor<dim,N>::apply(m_stage_params, sdm_geom, Udata, Udata, Udata, Udata_fdiv, coefs, dt);
   }
   
 } // SolverHydroSDM::time_int_forward_euler
@@ -1282,19 +1710,19 @@ void SolverHydroSDM<dim,N>::time_int_ssprk2(DataArray Udata,
   // perform actual time update : U_RK1 = 1.0 * U_{n} + 0.0 * U_{n} - dt * Udata_fdiv
   {
     coefs_t coefs = {1.0, 0.0, -1.0};
-    SDM_Update_RK_Functor<dim,N>::apply(params, sdm_geom, U_RK1, Udata, Udata, Udata_fdiv, coefs, dt);
+    SDM_Update_RK_Functor<dim,N>::apply(m_stage_params, sdm_geom, U_RK1, Udata, Udata, Udata_fdiv, coefs, dt);
   }
 
   // ================================================================
   // second step :
   // U_{n+1} = 0.5 * U_n + 0.5 * U_RK1 - 0.5 * dt * div_fluxes(U_RK1)
   // ================================================================
-  make_boundaries(U_RK1);
+  make_boundaries_stage(U_RK1);
   compute_fluxes_divergence(U_RK1, Udata_fdiv, dt);
 
   {
     coefs_t coefs= {0.5, 0.5, -0.5};    
-    SDM_Update_RK_Functor<dim,N>::apply(params, sdm_geom, Udata, Udata, U_RK1, Udata_fdiv, coefs, dt);
+    SDM_Update_RK_Functor<dim,N>::apply(m_stage_params, sdm_geom, Udata, Udata, U_RK1, Udata_fdiv, coefs, dt);
   }
   
 } // SolverHydroSDM::time_int_ssprk2
@@ -1336,29 +1764,29 @@ void SolverHydroSDM<dim,N>::time_int_ssprk3(DataArray Udata,
   // perform : U_RK1 = 1.0 * U_{n} + 0.0 * U_{n} - dt * Udata_fdiv 
   {
     coefs_t coefs = {1.0, 0.0, -1.0};
-    SDM_Update_RK_Functor<dim,N>::apply(params, sdm_geom, U_RK1, Udata, Udata, Udata_fdiv, coefs, dt);
+    SDM_Update_RK_Functor<dim,N>::apply(m_stage_params, sdm_geom, U_RK1, Udata, Udata, Udata_fdiv, coefs, dt);
   }
 
   // ==============================================================
   // second stage :
   // U_RK2 = 3/4 * U_n + 1/4 * U_RK1 - 1/4 * dt * div_fluxes(U_RK1)
   // ==============================================================
-  make_boundaries(U_RK1);
+  make_boundaries_stage(U_RK1);
   compute_fluxes_divergence(U_RK1, Udata_fdiv, dt);
   {
     coefs_t coefs = {0.75, 0.25, -0.25};
-    SDM_Update_RK_Functor<dim,N>::apply(params, sdm_geom, U_RK2, Udata, U_RK1, Udata_fdiv, coefs, dt);
+    SDM_Update_RK_Functor<dim,N>::apply(m_stage_params, sdm_geom, U_RK2, Udata, U_RK1, Udata_fdiv, coefs, dt);
   }
   
   // ================================================================
   // third stage :
   // U_{n+1} = 1/3 * U_n + 2/3 * U_RK2 - 2/3 * dt * div_fluxes(U_RK2)
   // ================================================================
-  make_boundaries(U_RK2);
+  make_boundaries_stage(U_RK2);
   compute_fluxes_divergence(U_RK2, Udata_fdiv, dt);
   {
     coefs_t coefs = {1.0/3, 2.0/3, -2.0/3};
-    SDM_Update_RK_Functor<dim,N>::apply(params, sdm_geom, Udata, Udata, U_RK2, Udata_fdiv, coefs, dt);
+    SDM_Update_RK_Functor<dim,N>::apply(m_stage_params, sdm_geom, Udata, Udata, U_RK2, Udata_fdiv, coefs, dt);
   }
 
 } // SolverHydroSDM::time_int_ssprk3
@@ -1420,7 +1848,7 @@ void SolverHydroSDM<dim,N>::time_int_ssprk54(DataArray Udata,
     const coefs_t coefs = {rk54_coef[0][0],
 			   rk54_coef[0][1],
 			   rk54_coef[0][2]};
-    SDM_Update_RK_Functor<dim,N>::apply(params, sdm_geom, U_RK1, Udata, Udata, Udata_fdiv, coefs, dt);
+    SDM_Update_RK_Functor<dim,N>::apply(m_stage_params, sdm_geom, U_RK1, Udata, Udata, Udata_fdiv, coefs, dt);
   }
 
   // ===============================================
@@ -1429,14 +1857,14 @@ void SolverHydroSDM<dim,N>::time_int_ssprk54(DataArray Udata,
   //                   rk_54[1][1] * U_RK1 +
   //                   rk_54[1][2] * dt * Udata_fdiv 
   // ===============================================
-  make_boundaries(U_RK1);
+  make_boundaries_stage(U_RK1);
   compute_fluxes_divergence(U_RK1, Udata_fdiv, dt);
   
   {
     const coefs_t coefs = {rk54_coef[1][0],
 			   rk54_coef[1][1],
 			   rk54_coef[1][2]};
-    SDM_Update_RK_Functor<dim,N>::apply(params, sdm_geom, U_RK2, Udata, U_RK1, Udata_fdiv, coefs, dt);
+    SDM_Update_RK_Functor<dim,N>::apply(m_stage_params, sdm_geom, U_RK2, Udata, U_RK1, Udata_fdiv, coefs, dt);
   }
 
   // ===============================================
@@ -1445,14 +1873,14 @@ void SolverHydroSDM<dim,N>::time_int_ssprk54(DataArray Udata,
   //                   rk_54[2][1] * U_RK2 +
   //                   rk_54[2][2] * dt * Udata_fdiv 
   // ===============================================
-  make_boundaries(U_RK2);
+  make_boundaries_stage(U_RK2);
   compute_fluxes_divergence(U_RK2, Udata_fdiv, dt);
   
   {
     const coefs_t coefs = {rk54_coef[2][0],
 			   rk54_coef[2][1],
 			   rk54_coef[2][2]};
-    SDM_Update_RK_Functor<dim,N>::apply(params, sdm_geom, U_RK3, Udata, U_RK2, Udata_fdiv, coefs, dt);
+    SDM_Update_RK_Functor<dim,N>::apply(m_stage_params, sdm_geom, U_RK3, Udata, U_RK2, Udata_fdiv, coefs, dt);
   }
   
   // ===============================================
@@ -1461,14 +1889,14 @@ void SolverHydroSDM<dim,N>::time_int_ssprk54(DataArray Udata,
   //                   rk_54[3][1] * U_RK3 +
   //                   rk_54[3][2] * dt * Udata_fdiv 
   // ===============================================
-  make_boundaries(U_RK3);
+  make_boundaries_stage(U_RK3);
   compute_fluxes_divergence(U_RK3, Udata_fdiv, dt);
   
   {
     const coefs_t coefs = {rk54_coef[3][0],
 			   rk54_coef[3][1],
 			   rk54_coef[3][2]};
-    SDM_Update_RK_Functor<dim,N>::apply(params, sdm_geom, U_RK4, Udata, U_RK3, Udata_fdiv, coefs, dt);
+    SDM_Update_RK_Functor<dim,N>::apply(m_stage_params, sdm_geom, U_RK4, Udata, U_RK3, Udata_fdiv, coefs, dt);
   }
 
   // ===============================================
@@ -1478,20 +1906,20 @@ void SolverHydroSDM<dim,N>::time_int_ssprk54(DataArray Udata,
     const coefs_t coefs = {rk54_coef[4][0],
 			   rk54_coef[4][1],
 			   rk54_coef[4][2]};
-    SDM_Update_RK_Functor<dim,N>::apply(params, sdm_geom, Udata, U_RK2, U_RK3, Udata_fdiv, coefs, dt);
+    SDM_Update_RK_Functor<dim,N>::apply(m_stage_params, sdm_geom, Udata, U_RK2, U_RK3, Udata_fdiv, coefs, dt);
   }
 
   
   // ===============================================
   // stage 5.2:
   // ===============================================
-  make_boundaries(U_RK4);
+  make_boundaries_stage(U_RK4);
   compute_fluxes_divergence(U_RK4, Udata_fdiv, dt);
   {
     const coefs_t coefs = {rk54_coef[5][0],
 			   rk54_coef[5][1],
 			   rk54_coef[5][2]};
-    SDM_Update_RK_Functor<dim,N>::apply(params, sdm_geom, Udata, Udata, U_RK4, Udata_fdiv, coefs, dt);
+    SDM_Update_RK_Functor<dim,N>::apply(m_stage_params, sdm_geom, Udata, Udata, U_RK4, Udata_fdiv, coefs, dt);
   }
 
   //std::cout << "SSP-RK54 is currently partially implemented\n";
@@ -1518,16 +1946,7 @@ void SolverHydroSDM<dim,N>::make_boundary_sdm(DataArray   Udata,
 
   UNUSED(mhd_enabled);
   
-  const int ghostWidth=params.ghostWidth;
-  int max_size = std::max(params.isize,params.jsize);
-  int nbIter = ghostWidth * max_size;
-
-  if (dim==3) {
-    max_size = std::max(max_size,params.ksize);
-    nbIter = ghostWidth * max_size * max_size;
-  }
-
-  MakeBoundariesFunctor_SDM<dim,N,faceId>::apply(params, sdm_geom, Udata, nbIter);
+  MakeBoundariesFunctor_SDM<dim,N,faceId>::apply(params, sdm_geom, Udata);
    
 } // SolverHydroSDM<dim,N>::make_boundary_sdm
 
@@ -1539,16 +1958,7 @@ void SolverHydroSDM<dim,N>::make_boundary_sdm_wedge(DataArray   Udata,
 						    WedgeParams wparams)
 {
 
-  const int ghostWidth=params.ghostWidth;
-  int max_size = std::max(params.isize,params.jsize);
-  int nbIter = ghostWidth * max_size;
-
-  if (dim==3) {
-    max_size = std::max(max_size,params.ksize);
-    nbIter = ghostWidth * max_size * max_size;
-  }
-
-  MakeBoundariesFunctor_SDM_Wedge<dim,N,faceId>::apply(params, sdm_geom, wparams, Udata, nbIter);
+  MakeBoundariesFunctor_SDM_Wedge<dim,N,faceId>::apply(params, sdm_geom, wparams, Udata);
     
 } // SolverHydroSDM<dim,N>::make_boundary_sdm_wedge
 
@@ -1560,16 +1970,7 @@ void SolverHydroSDM<dim,N>::make_boundary_sdm_jet(DataArray   Udata,
 						  JetParams   jparams)
 {
 
-  const int ghostWidth=params.ghostWidth;
-  int max_size = std::max(params.isize,params.jsize);
-  int nbIter = ghostWidth * max_size;
-
-  if (dim==3) {
-    max_size = std::max(max_size,params.ksize);
-    nbIter = ghostWidth * max_size * max_size;
-  }
-
-  MakeBoundariesFunctor_SDM_Jet<dim,N,faceId>::apply(params, sdm_geom, jparams, Udata, nbIter);
+  MakeBoundariesFunctor_SDM_Jet<dim,N,faceId>::apply(params, sdm_geom, jparams, Udata);
   
 } // SolverHydroSDM<dim,N>::make_boundary_sdm_jet
 
@@ -1586,8 +1987,12 @@ void SolverHydroSDM<dim,N>::make_boundaries(DataArray Udata)
   bool mhd_enabled = false;
 
 #ifdef USE_MPI
-  
-  make_boundaries_sdm_mpi(Udata, mhd_enabled);
+
+  // MPI faces are dealt with by face traces exchange
+  if (face_trace_halo_enabled)
+    make_boundaries_sdm_physical(Udata, mhd_enabled);
+  else
+    make_boundaries_sdm_mpi(Udata, mhd_enabled);
 
 #else
 
@@ -1597,6 +2002,27 @@ void SolverHydroSDM<dim,N>::make_boundaries(DataArray Udata)
   
 } // SolverHydroSDM::make_boundaries
 
+// =======================================================
+// =======================================================
+template<int dim, int N>
+void SolverHydroSDM<dim,N>::make_boundaries_stage(DataArray Udata)
+{
+
+  if (deep_halo_stage()) {
+
+    make_boundaries(Udata);
+
+  } else {
+
+#ifdef USE_MPI
+    bool mhd_enabled = false;
+    make_boundaries_sdm_physical(Udata, mhd_enabled);
+#endif // USE_MPI
+
+  }
+
+} // SolverHydroSDM::make_boundaries_stage
+
 // =======================================================
 // =======================================================
 template<int dim, int N>
@@ -1786,6 +2212,79 @@ void SolverHydroSDM<dim,N>::make_boundaries_sdm_mpi(DataArray Udata,
   } // end 3d
   
 } // SolverHydroSDM<dim,N>::make_boundaries_sdm_mpi
+
+// =======================================================
+// =======================================================
+template<int dim, int N>
+void SolverHydroSDM<dim,N>::make_boundaries_sdm_physical(DataArray Udata,
+							 bool mhd_enabled)
+{
+
+  using namespace hydroSimu;
+
+  if (params.neighborsBC[X_MIN] != BC_COPY and
+      params.neighborsBC[X_MIN] != BC_PERIODIC)
+    make_boundary_sdm<FACE_XMIN>(Udata, mhd_enabled);
+
+  if (params.neighborsBC[X_MAX] != BC_COPY and
+      params.neighborsBC[X_MAX] != BC_PERIODIC)
+    make_boundary_sdm<FACE_XMAX>(Udata, mhd_enabled);
+
+  if (params.neighborsBC[Y_MIN] != BC_COPY and
+      params.neighborsBC[Y_MIN] != BC_PERIODIC)
+    make_boundary_sdm<FACE_YMIN>(Udata, mhd_enabled);
+
+  if (params.neighborsBC[Y_MAX] != BC_COPY and
+      params.neighborsBC[Y_MAX] != BC_PERIODIC)
+    make_boundary_sdm<FACE_YMAX>(Udata, mhd_enabled);
+
+  if (dim==3) {
+
+    if (params.neighborsBC[Z_MIN] != BC_COPY and
+	params.neighborsBC[Z_MIN] != BC_PERIODIC)
+      make_boundary_sdm<FACE_ZMIN>(Udata, mhd_enabled);
+
+    if (params.neighborsBC[Z_MAX] != BC_COPY and
+	params.neighborsBC[Z_MAX] != BC_PERIODIC)
+      make_boundary_sdm<FACE_ZMAX>(Udata, mhd_enabled);
+
+  }
+
+} // SolverHydroSDM<dim,N>::make_boundaries_sdm_physical
+
+// =======================================================
+// =======================================================
+template<int dim, int N>
+void SolverHydroSDM<dim,N>::init_face_trace_halo()
+{
+
+  // velocity and velocity gradients traces for viscous terms
+  const int nbvar_trace = viscous_terms_enabled ?
+    std::max(params.nbvar, dim+dim*dim) : params.nbvar;
+
+  const int64_t size[3] = {
+    Copy_Face_Trace_Functor<dim,N,IX>::buffer_size(params, nbvar_trace),
+    Copy_Face_Trace_Functor<dim,N,IY>::buffer_size(params, nbvar_trace),
+    Copy_Face_Trace_Functor<dim,N,IZ>::buffer_size(params, nbvar_trace)
+  };
+
+  for (int d=0; d<dim; ++d) {
+    for (int side=FACE_MIN; side<=FACE_MAX; ++side) {
+      Kokkos::realloc(traceBufSend[d][side], size[d]);
+      Kokkos::realloc(traceBufRecv[d][side], size[d]);
+    }
+  }
+
+  // ghost cells of MPI faces are not updated anymore, but must hold a
+  // valid state (they are visited by interpolation / flux functors)
+  make_boundaries_sdm_mpi(U, false);
+
+  if (U_RK1.size() > 0) Kokkos::deep_copy(U_RK1, U);
+  if (U_RK2.size() > 0) Kokkos::deep_copy(U_RK2, U);
+  if (U_RK3.size() > 0) Kokkos::deep_copy(U_RK3, U);
+  if (U_RK4.size() > 0) Kokkos::deep_copy(U_RK4, U);
+
+} // SolverHydroSDM<dim,N>::init_face_trace_halo
 #endif // USE_MPI
 
 // =======================================================
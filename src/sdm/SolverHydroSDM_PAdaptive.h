@@ -0,0 +1,794 @@
+/**
+ * p-adaptive Spectral Difference Method solver : per cell order.
+ */
+#ifndef SOLVER_HYDRO_SDM_PADAPTIVE_H_
+#define SOLVER_HYDRO_SDM_PADAPTIVE_H_
+
+#include <string>
+#include <cstdio>
+#include <sstream>
+#include <vector>
+
+#include "sdm/SolverHydroSDM.h"
+#include "sdm/SDM_PAdaptive_Functors.h"
+
+namespace sdm {
+
+/**
+ * p-adaptive variant of SolverHydroSDM : each cell has its own order M
+ * in [p_adaptive_min_order, N] (M solution points per direction), so
+ * that high order is only paid for where the flow is not smooth enough
+ * for a lower one (e.g. the shear layers of a jet).
+ *
+ * The order of the cells is selected from a smoothness indicator (see
+ * PAdaptive_Order_Functor), at start and every p_adaptive_interval time
+ * steps, optionally raised to the order of face neighbors (buffer layer).
+ *
+ * The solution is integrated in a compact DoF store (see
+ * SDM_PAdaptive_Functors.h), cells being grouped by order so that each
+ * group uses functors specialized at compile time for its order. Data
+ * array U (order N) is updated at the end of each time step, and is
+ * used for time step computation, outputs and ghost cells : at each
+ * Runge-Kutta stage, cells close to the sub-domain border are copied to
+ * U, U ghost cells are filled as usual, then copied back (order N) to
+ * the DoF store.
+ *
+ * With all cells of order N, results are the same as SolverHydroSDM.
+ *
+ * Not supported : limiter, viscous terms, face traces halo, deep halos
+ * and load balancing. The time step is the one of order N.
+ *
+ * Settings ([sdm] section) :
+ * - p_adaptive_min_order : lowest order (default 2, order 1 cells are
+ *   piecewise constant i.e. first order accurate)
+ * - p_adaptive_tolerance : smoothness indicator tolerance (default 1e-3)
+ * - p_adaptive_interval  : time steps between order selections
+ *   (default 10, 0 : orders selected at start only)
+ * - p_adaptive_buffer    : raise order to face neighbors order (default true)
+ */
+template<int dim, int N>
+class SolverHydroSDM_PAdaptive : public SolverHydroSDM<dim,N>
+{
+
+public:
+
+  using typename SolverHydroSDM<dim,N>::DataArray;
+  using typename SolverHydroSDM<dim,N>::coefs_t;
+
+  SolverHydroSDM_PAdaptive(HydroParams& params, ConfigMap& configMap);
+  virtual ~SolverHydroSDM_PAdaptive();
+
+  /**
+   * Static creation method called by the solver factory.
+   */
+  static ppkMHD::SolverBase* create(HydroParams& params, ConfigMap& configMap)
+  {
+    SolverHydroSDM_PAdaptive<dim,N>* solver = new SolverHydroSDM_PAdaptive<dim,N>(params, configMap);
+
+    return solver;
+  }
+
+  //! returns SolverHydroSDM_PAdaptive<dim,N>
+  virtual std::string get_name () const;
+
+  //! SDM geometry of all orders
+  SDM_Geometry_List<dim,N> geometries;
+
+  //! interpolation matrices between orders
+  PAdaptive_Matrices<dim,N> matrices;
+
+  CellList   CellOrder;    /*!< per cell order */
+  CellList   CellOrderTmp; /*!< per cell order (buffer layer) */
+  CellList   CellFlags;    /*!< per cell flag, used to build OrderedCells */
+  CellList   OrderedCells; /*!< cells grouped by order, ghost cells last */
+  DofOffsets Offsets;      /*!< per cell first DoF in the DoF stores */
+
+  //! first position in OrderedCells and number of cells of each order
+  //! (index M in [1,N]), ghost cells at index 0
+  std::vector<int> groupBegin, groupCount;
+
+  //! number of DoFs of all cells / of interior cells (stored first)
+  int64_t nbDofs, nbInteriorDofs;
+
+  //! DoF stores : conservative variables, fluxes divergence and
+  //! Runge-Kutta temporaries (allocated only if necessary)
+  DofStore Ustore, Ustore_fdiv;
+  DofStore Ustore_RK1, Ustore_RK2, Ustore_RK3, Ustore_RK4;
+
+  //! face traces of order N (both sides, per direction)
+  DataArray Traces;
+
+  //! common fluxes at the low side face of each cell (per direction)
+  DataArray FaceFlux;
+
+  //! order selection settings
+  int    min_order;
+  real_t order_tolerance;
+  int    order_interval;
+  bool   order_buffer_enabled;
+
+  void init_scratch_arrays();
+
+  void next_iteration_impl();
+
+  //! select cell orders from U
+  void select_orders();
+
+  //! group cells by order, compute offsets, (re)allocate DoF stores and
+  //! fill Ustore from U
+  void build_store();
+
+  //! print fraction of cells of each order (called every nlog steps)
+  void print_orders_fraction();
+
+  //! \defgroup OrderGroups functors applied to each group of order <= M
+  //! @{
+  template<int M> void pack_groups(DataArray Udata, DofStore S);
+  template<int M> void unpack_groups(DofStore S, DataArray Udata, bool border_only);
+  template<int M> void positivity_groups(DofStore S);
+  template<int dir, int M> void trace_groups(DofStore S);
+  template<int dir, int M> void divergence_groups(DofStore S, DofStore S_fdiv);
+  //! @}
+
+  //! fill ghost cells of a DoF store (through U)
+  void fill_ghost_cells(DofStore S);
+
+  void time_integration(real_t dt);
+
+  void compute_fluxes_divergence(DofStore S, DofStore S_fdiv);
+
+  template<int dir>
+  void compute_fluxes_divergence_per_dir(DofStore S, DofStore S_fdiv);
+
+  //! same schemes as SolverHydroSDM, applied to DoF stores
+  //! @{
+  void time_int_forward_euler(real_t dt);
+  void time_int_ssprk2(real_t dt);
+  void time_int_ssprk3(real_t dt);
+  void time_int_ssprk54(real_t dt);
+  //! @}
+
+}; // class SolverHydroSDM_PAdaptive
+
+// =======================================================
+// ==== CLASS SolverHydroSDM_PAdaptive IMPL ==============
+// =======================================================
+
+// =======================================================
+// =======================================================
+template<int dim, int N>
+SolverHydroSDM_PAdaptive<dim,N>::SolverHydroSDM_PAdaptive(HydroParams& params,
+							  ConfigMap& configMap) :
+  SolverHydroSDM<dim,N>(params, configMap),
+  geometries(),
+  matrices(),
+  groupBegin(N+1, 0),
+  groupCount(N+1, 0),
+  nbDofs(0),
+  nbInteriorDofs(0),
+  min_order(2),
+  order_tolerance(1e-3),
+  order_interval(10),
+  order_buffer_enabled(true)
+{
+
+  int myRank=0;
+#ifdef USE_MPI
+  myRank = params.myRank;
+#endif // USE_MPI
+
+  /*
+   * unsupported options
+   */
+  if (this->viscous_terms_enabled) {
+    std::cerr << "[sdm] viscous terms are not supported by the p-adaptive solver\n";
+    exit(EXIT_FAILURE);
+  }
+
+  if (this->limiter_enabled) {
+    std::cerr << "[sdm] limiter is not supported by the p-adaptive solver\n";
+    exit(EXIT_FAILURE);
+  }
+
+  if (this->face_trace_halo_enabled) {
+    if (myRank==0)
+      std::cout << "[sdm] face_trace_halo is not used by the p-adaptive solver\n";
+    this->face_trace_halo_enabled = false;
+  }
+
+  if (this->m_deep_halo_stages > 1) {
+    if (myRank==0)
+      std::cout << "[mpi] deep_halo_stages is not used by the p-adaptive solver\n";
+    this->m_deep_halo_stages = 1;
+    this->deep_halo_reset();
+  }
+
+  // troubled cells only restrict the limiter / positivity of the base class
+  this->troubled_cells_enabled = false;
+
+  // DoF stores would need to be migrated too
+  this->m_load_balancing_supported = false;
+
+  /*
+   * release the base class arrays replaced by DoF stores
+   */
+  this->Uaux     = DataArray();
+  this->Uaverage = DataArray();
+  this->U_RK1    = DataArray();
+  this->U_RK2    = DataArray();
+  this->U_RK3    = DataArray();
+  this->U_RK4    = DataArray();
+  this->TroubledCellsFlags = CellList();
+  this->PositivityCells    = CellList();
+
+  init_scratch_arrays();
+
+  /*
+   * order selection
+   */
+  min_order            = configMap.getInteger("sdm", "p_adaptive_min_order", 2);
+  order_tolerance      = configMap.getFloat("sdm", "p_adaptive_tolerance", 1e-3);
+  order_interval       = configMap.getInteger("sdm", "p_adaptive_interval", 10);
+  order_buffer_enabled = configMap.getBool("sdm", "p_adaptive_buffer", true);
+
+  if (min_order < 1 or min_order > N) {
+    min_order = N < 2 ? N : 2;
+    if (myRank==0)
+      std::cout << "[sdm] p_adaptive_min_order must be in [1," << N << "], using "
+		<< min_order << "\n";
+  }
+
+  geometries.init();
+  matrices.init(geometries);
+
+  const int nbCells = this->nbCells;
+
+  CellOrder    = CellList("CellOrder",    nbCells);
+  CellOrderTmp = CellList("CellOrderTmp", nbCells);
+  CellFlags    = CellList("CellFlags",    nbCells);
+  OrderedCells = CellList("OrderedCells", nbCells);
+  Offsets      = DofOffsets("Offsets",    nbCells);
+
+  select_orders();
+  build_store();
+
+  if (myRank==0) {
+    std::cout << "##########################" << "\n";
+    std::cout << "p-adaptive orders : " << min_order << " to " << N << "\n";
+    std::cout << "Tolerance         : " << order_tolerance << "\n";
+    std::cout << "Interval          : " << order_interval << "\n";
+    std::cout << "Buffer layer      : " << order_buffer_enabled << "\n";
+    std::cout << "##########################" << "\n";
+  }
+
+  print_orders_fraction();
+
+} // SolverHydroSDM_PAdaptive::SolverHydroSDM_PAdaptive
+
+// =======================================================
+// =======================================================
+template<int dim, int N>
+SolverHydroSDM_PAdaptive<dim,N>::~SolverHydroSDM_PAdaptive()
+{
+
+} // SolverHydroSDM_PAdaptive::~SolverHydroSDM_PAdaptive
+
+// =======================================================
+// =======================================================
+template<int dim, int N>
+std::string SolverHydroSDM_PAdaptive<dim,N>::get_name() const
+{
+
+  std::ostringstream buf;
+  buf << "SolverHydroSDM_PAdaptive<"
+      << dim << "," << N << ">";
+
+  return buf.str();
+
+} // SolverHydroSDM_PAdaptive<dim,N>::get_name
+
+// =======================================================
+// =======================================================
+template<int dim, int N>
+void SolverHydroSDM_PAdaptive<dim,N>::init_scratch_arrays()
+{
+
+  /*
+   * phases of compute_fluxes_divergence_per_dir : traces are used by
+   * the Riemann solver, face fluxes by the Riemann solver and the
+   * divergence.
+   */
+  enum { PHASE_TRACES, PHASE_RIEMANN, PHASE_DIVERGENCE };
+
+  const int nbvar = this->params.nbvar;
+  const int nb_face_pts = dim==2 ? N : N*N;
+
+  const int isize = this->isize;
+  const int jsize = this->jsize;
+  const int ksize = this->ksize;
+
+  this->m_scratch.clear();
+
+  if (dim==2) {
+    this->m_scratch.declare(Traces,   PHASE_TRACES,  PHASE_RIEMANN,    isize, jsize, 2*nb_face_pts*nbvar);
+    this->m_scratch.declare(FaceFlux, PHASE_RIEMANN, PHASE_DIVERGENCE, isize, jsize,   nb_face_pts*nbvar);
+  } else {
+    this->m_scratch.declare(Traces,   PHASE_TRACES,  PHASE_RIEMANN,    isize, jsize, ksize, 2*nb_face_pts*nbvar);
+    this->m_scratch.declare(FaceFlux, PHASE_RIEMANN, PHASE_DIVERGENCE, isize, jsize, ksize,   nb_face_pts*nbvar);
+  }
+
+  this->m_scratch.allocate();
+
+  // base class work arrays are not declared anymore
+  this->Fluxes = DataArray();
+  this->Ugradx = DataArray();
+  this->Ugrady = DataArray();
+  this->Ugradz = DataArray();
+
+} // SolverHydroSDM_PAdaptive::init_scratch_arrays
+
+// =======================================================
+// =======================================================
+template<int dim, int N>
+void SolverHydroSDM_PAdaptive<dim,N>::next_iteration_impl()
+{
+
+  int myRank=0;
+#ifdef USE_MPI
+  myRank = this->params.myRank;
+#endif // USE_MPI
+  if (myRank==0) {
+    if (this->m_iteration % this->params.nlog == 0) {
+      printf("time   step=%7d (dt=% 10.8g t=% 10.8f)\n",this->m_iteration,this->m_dt, this->m_t);
+    }
+  }
+
+  // orders statistics
+  if (this->m_iteration>0 and this->m_iteration % this->params.nlog == 0)
+    print_orders_fraction();
+
+  // output
+  if (this->params.enableOutput) {
+    if ( this->should_save_solution() ) {
+
+      printf("Output step=%7d (dt=% 10.8g t=% 10.8f)\n",this->m_iteration,this->m_dt, this->m_t);
+
+      this->save_solution();
+
+    } // end output
+  } // end enable output
+
+  // new cell orders
+  if (order_interval > 0 and this->m_iteration > 0 and this->m_iteration % order_interval == 0) {
+    this->timers[TIMER_NUM_SCHEME]->start();
+    select_orders();
+    build_store();
+    this->timers[TIMER_NUM_SCHEME]->stop();
+  }
+
+  // compute new dt
+  this->timers[TIMER_DT]->start();
+  this->compute_dt();
+  this->timers[TIMER_DT]->stop();
+
+  // perform one step integration
+  time_integration(this->m_dt);
+
+} // SolverHydroSDM_PAdaptive::next_iteration_impl
+
+// =======================================================
+// =======================================================
+template<int dim, int N>
+void SolverHydroSDM_PAdaptive<dim,N>::select_orders()
+{
+
+  PAdaptive_Order_Functor<dim,N>::apply(this->params, this->sdm_geom, matrices,
+					this->U, CellOrder,
+					min_order, order_tolerance);
+
+  if (order_buffer_enabled) {
+    PAdaptive_Order_Buffer_Functor<dim,N>::apply(this->params, this->sdm_geom, matrices,
+						 CellOrder, CellOrderTmp);
+    std::swap(CellOrder, CellOrderTmp);
+  }
+
+} // SolverHydroSDM_PAdaptive::select_orders
+
+// =======================================================
+// =======================================================
+template<int dim, int N>
+void SolverHydroSDM_PAdaptive<dim,N>::build_store()
+{
+
+  const int nbCells = this->nbCells;
+
+  /*
+   * OrderedCells : interior cells of order 1, ..., N then ghost cells
+   */
+  int pos = 0;
+  for (int order=1; order<=N+1; ++order) {
+
+    // ghost cells are flagged with order 0
+    const int group = order<=N ? order : 0;
+
+    PAdaptive_Order_Flags_Functor<dim>::apply(this->params, CellOrder, CellFlags, group);
+
+    CellList list = Kokkos::subview(OrderedCells, std::make_pair(pos, nbCells));
+
+    groupBegin[group] = pos;
+    groupCount[group] = Compact_Cell_List_Functor::apply(CellFlags, list, nbCells);
+
+    pos += groupCount[group];
+
+  }
+
+  /*
+   * DoF offsets and stores
+   */
+  nbDofs = PAdaptive_Offsets_Functor<dim>::apply(OrderedCells, CellOrder, Offsets, nbCells);
+
+  // interior DoFs come first
+  nbInteriorDofs = nbDofs - (int64_t) groupCount[0] * this->params.nbvar * (dim==2 ? N*N : N*N*N);
+
+  Ustore      = DofStore("Ustore",      nbDofs);
+  Ustore_fdiv = DofStore("Ustore_fdiv", nbDofs);
+
+  if (this->ssprk2_enabled or this->ssprk3_enabled or this->ssprk54_enabled)
+    Ustore_RK1 = DofStore("Ustore_RK1", nbDofs);
+
+  if (this->ssprk3_enabled or this->ssprk54_enabled)
+    Ustore_RK2 = DofStore("Ustore_RK2", nbDofs);
+
+  if (this->ssprk54_enabled) {
+    Ustore_RK3 = DofStore("Ustore_RK3", nbDofs);
+    Ustore_RK4 = DofStore("Ustore_RK4", nbDofs);
+  }
+
+  // interior cells (ghost cells are filled at each stage)
+  pack_groups<N>(this->U, Ustore);
+
+} // SolverHydroSDM_PAdaptive::build_store
+
+// =======================================================
+// =======================================================
+template<int dim, int N>
+void SolverHydroSDM_PAdaptive<dim,N>::print_orders_fraction()
+{
+
+  int myRank=0;
+  std::vector<int> counts(groupCount);
+
+#ifdef USE_MPI
+  myRank = this->params.myRank;
+
+  std::vector<int> counts_global(N+1);
+  this->params.communicator->allReduce(counts.data(), counts_global.data(), N+1,
+				       hydroSimu::MpiComm::INT,
+				       hydroSimu::MpiComm::SUM);
+  counts = counts_global;
+#endif // USE_MPI
+
+  int total = 0;
+  for (int order=1; order<=N; ++order)
+    total += counts[order];
+
+  if (myRank==0) {
+    printf("cells per order :");
+    for (int order=1; order<=N; ++order)
+      printf(" %d:%6.2f %%", order, 100.0*counts[order]/total);
+    printf("\n");
+  }
+
+} // SolverHydroSDM_PAdaptive<dim,N>::print_orders_fraction
+
+// =======================================================
+// =======================================================
+template<int dim, int N>
+template<int M>
+void SolverHydroSDM_PAdaptive<dim,N>::pack_groups(DataArray Udata, DofStore S)
+{
+
+  if (M > 1)
+    pack_groups<(M>1 ? M-1 : 1)>(Udata, S);
+
+  if (groupCount[M] > 0)
+    PAdaptive_Pack_Functor<dim,N,M>::apply(this->params, geometries.template get<M>(), matrices,
+					   Offsets, Udata, S,
+					   OrderedCells, groupBegin[M], groupCount[M]);
+
+} // SolverHydroSDM_PAdaptive::pack_groups
+
+// =======================================================
+// =======================================================
+template<int dim, int N>
+template<int M>
+void SolverHydroSDM_PAdaptive<dim,N>::unpack_groups(DofStore S, DataArray Udata, bool border_only)
+{
+
+  if (M > 1)
+    unpack_groups<(M>1 ? M-1 : 1)>(S, Udata, border_only);
+
+  if (groupCount[M] > 0)
+    PAdaptive_Unpack_Functor<dim,N,M>::apply(this->params, geometries.template get<M>(), matrices,
+					     Offsets, S, Udata, border_only,
+					     OrderedCells, groupBegin[M], groupCount[M]);
+
+} // SolverHydroSDM_PAdaptive::unpack_groups
+
+// =======================================================
+// =======================================================
+template<int dim, int N>
+template<int M>
+void SolverHydroSDM_PAdaptive<dim,N>::positivity_groups(DofStore S)
+{
+
+  if (M > 1)
+    positivity_groups<(M>1 ? M-1 : 1)>(S);
+
+  if (groupCount[M] > 0)
+    PAdaptive_Positivity_Functor<dim,N,M>::apply(this->params, geometries.template get<M>(), matrices,
+						 Offsets, S,
+						 OrderedCells, groupBegin[M], groupCount[M]);
+
+} // SolverHydroSDM_PAdaptive::positivity_groups
+
+// =======================================================
+// =======================================================
+template<int dim, int N>
+template<int dir, int M>
+void SolverHydroSDM_PAdaptive<dim,N>::trace_groups(DofStore S)
+{
+
+  if (M > 1)
+    trace_groups<dir,(M>1 ? M-1 : 1)>(S);
+
+  if (groupCount[M] > 0)
+    PAdaptive_Trace_Functor<dim,N,M,dir>::apply(this->params, geometries.template get<M>(), matrices,
+						Offsets, S, Traces,
+						OrderedCells, groupBegin[M], groupCount[M]);
+
+} // SolverHydroSDM_PAdaptive::trace_groups
+
+// =======================================================
+// =======================================================
+template<int dim, int N>
+template<int dir, int M>
+void SolverHydroSDM_PAdaptive<dim,N>::divergence_groups(DofStore S, DofStore S_fdiv)
+{
+
+  if (M > 1)
+    divergence_groups<dir,(M>1 ? M-1 : 1)>(S, S_fdiv);
+
+  if (groupCount[M] > 0)
+    PAdaptive_Divergence_Functor<dim,N,M,dir>::apply(this->params, geometries.template get<M>(), matrices,
+						     Offsets, this->euler, S, FaceFlux, S_fdiv,
+						     OrderedCells, groupBegin[M], groupCount[M]);
+
+} // SolverHydroSDM_PAdaptive::divergence_groups
+
+// =======================================================
+// =======================================================
+template<int dim, int N>
+void SolverHydroSDM_PAdaptive<dim,N>::fill_ghost_cells(DofStore S)
+{
+
+  // cells used to fill ghost cells (MPI borders or physical boundaries)
+  unpack_groups<N>(S, this->U, true);
+
+  this->make_boundaries(this->U);
+
+  if (groupCount[0] > 0)
+    PAdaptive_Pack_Functor<dim,N,N>::apply(this->params, this->sdm_geom, matrices,
+					   Offsets, this->U, S,
+					   OrderedCells, groupBegin[0], groupCount[0]);
+
+} // SolverHydroSDM_PAdaptive::fill_ghost_cells
+
+// =======================================================
+// =======================================================
+template<int dim, int N>
+void SolverHydroSDM_PAdaptive<dim,N>::time_integration(real_t dt)
+{
+
+  this->timers[TIMER_NUM_SCHEME]->start();
+
+  if (this->ssprk2_enabled) {
+
+    time_int_ssprk2(dt);
+
+  } else if (this->ssprk3_enabled) {
+
+    time_int_ssprk3(dt);
+
+  } else if (this->ssprk54_enabled) {
+
+    time_int_ssprk54(dt);
+
+  } else {
+
+    time_int_forward_euler(dt);
+
+  }
+
+  // order N solution, for dt / outputs / next order selection
+  unpack_groups<N>(Ustore, this->U, false);
+
+  this->timers[TIMER_NUM_SCHEME]->stop();
+
+} // SolverHydroSDM_PAdaptive::time_integration
+
+// =======================================================
+// =======================================================
+/**
+ * Same as SolverHydroSDM::compute_fluxes_divergence (with positivity
+ * preserving, without limiter), ghost cells of S being filled first.
+ */
+template<int dim, int N>
+void SolverHydroSDM_PAdaptive<dim,N>::compute_fluxes_divergence(DofStore S,
+								DofStore S_fdiv)
+{
+
+  this->timers[TIMER_NUM_SCHEME]->stop();
+  this->timers[TIMER_BOUNDARIES]->start();
+  fill_ghost_cells(S);
+  this->timers[TIMER_BOUNDARIES]->stop();
+  this->timers[TIMER_NUM_SCHEME]->start();
+
+  Kokkos::deep_copy(S_fdiv, 0.0);
+
+  if (this->positivity_enabled) {
+
+    positivity_groups<N>(S);
+
+    if (groupCount[0] > 0)
+      PAdaptive_Positivity_Functor<dim,N,N>::apply(this->params, this->sdm_geom, matrices,
+						   Offsets, S,
+						   OrderedCells, groupBegin[0], groupCount[0]);
+
+  }
+
+  compute_fluxes_divergence_per_dir<IX>(S, S_fdiv);
+  compute_fluxes_divergence_per_dir<IY>(S, S_fdiv);
+  if (dim==3)
+    compute_fluxes_divergence_per_dir<IZ>(S, S_fdiv);
+
+} // SolverHydroSDM_PAdaptive::compute_fluxes_divergence
+
+// =======================================================
+// =======================================================
+template<int dim, int N>
+template<int dir>
+void SolverHydroSDM_PAdaptive<dim,N>::compute_fluxes_divergence_per_dir(DofStore S,
+									DofStore S_fdiv)
+{
+
+  // face traces of interior and ghost cells
+  trace_groups<dir,N>(S);
+
+  if (groupCount[0] > 0)
+    PAdaptive_Trace_Functor<dim,N,N,dir>::apply(this->params, this->sdm_geom, matrices,
+						Offsets, S, Traces,
+						OrderedCells, groupBegin[0], groupCount[0]);
+
+  // common fluxes
+  PAdaptive_Riemann_Functor<dim,N,dir>::apply(this->params, this->sdm_geom, matrices,
+					      this->euler, Traces, FaceFlux);
+
+  // fluxes divergence of interior cells
+  divergence_groups<dir,N>(S, S_fdiv);
+
+} // SolverHydroSDM_PAdaptive::compute_fluxes_divergence_per_dir
+
+// =======================================================
+// =======================================================
+template<int dim, int N>
+void SolverHydroSDM_PAdaptive<dim,N>::time_int_forward_euler(real_t dt)
+{
+
+  compute_fluxes_divergence(Ustore, Ustore_fdiv);
+
+  // Ustore = Ustore - dt * Ustore_fdiv
+  coefs_t coefs = {1.0, 0.0, -1.0};
+  PAdaptive_Update_RK_Functor::apply(Ustore, Ustore, Ustore, Ustore_fdiv,
+				     coefs, dt, nbInteriorDofs);
+
+} // SolverHydroSDM_PAdaptive::time_int_forward_euler
+
+// =======================================================
+// =======================================================
+template<int dim, int N>
+void SolverHydroSDM_PAdaptive<dim,N>::time_int_ssprk2(real_t dt)
+{
+
+  // first step : U_RK1 = U_n - dt * div_fluxes(U_n)
+  compute_fluxes_divergence(Ustore, Ustore_fdiv);
+  {
+    coefs_t coefs = {1.0, 0.0, -1.0};
+    PAdaptive_Update_RK_Functor::apply(Ustore_RK1, Ustore, Ustore, Ustore_fdiv,
+				       coefs, dt, nbInteriorDofs);
+  }
+
+  // second step : U_{n+1} = 0.5 * U_n + 0.5 * U_RK1 - 0.5 * dt * div_fluxes(U_RK1)
+  compute_fluxes_divergence(Ustore_RK1, Ustore_fdiv);
+  {
+    coefs_t coefs = {0.5, 0.5, -0.5};
+    PAdaptive_Update_RK_Functor::apply(Ustore, Ustore, Ustore_RK1, Ustore_fdiv,
+				       coefs, dt, nbInteriorDofs);
+  }
+
+} // SolverHydroSDM_PAdaptive::time_int_ssprk2
+
+// =======================================================
+// =======================================================
+template<int dim, int N>
+void SolverHydroSDM_PAdaptive<dim,N>::time_int_ssprk3(real_t dt)
+{
+
+  // first stage : U_RK1 = U_n - dt * div_fluxes(U_n)
+  compute_fluxes_divergence(Ustore, Ustore_fdiv);
+  {
+    coefs_t coefs = {1.0, 0.0, -1.0};
+    PAdaptive_Update_RK_Functor::apply(Ustore_RK1, Ustore, Ustore, Ustore_fdiv,
+				       coefs, dt, nbInteriorDofs);
+  }
+
+  // second stage : U_RK2 = 3/4 * U_n + 1/4 * U_RK1 - 1/4 * dt * div_fluxes(U_RK1)
+  compute_fluxes_divergence(Ustore_RK1, Ustore_fdiv);
+  {
+    coefs_t coefs = {0.75, 0.25, -0.25};
+    PAdaptive_Update_RK_Functor::apply(Ustore_RK2, Ustore, Ustore_RK1, Ustore_fdiv,
+				       coefs, dt, nbInteriorDofs);
+  }
+
+  // third stage : U_{n+1} = 1/3 * U_n + 2/3 * U_RK2 - 2/3 * dt * div_fluxes(U_RK2)
+  compute_fluxes_divergence(Ustore_RK2, Ustore_fdiv);
+  {
+    coefs_t coefs = {1.0/3, 2.0/3, -2.0/3};
+    PAdaptive_Update_RK_Functor::apply(Ustore, Ustore, Ustore_RK2, Ustore_fdiv,
+				       coefs, dt, nbInteriorDofs);
+  }
+
+} // SolverHydroSDM_PAdaptive::time_int_ssprk3
+
+// =======================================================
+// =======================================================
+template<int dim, int N>
+void SolverHydroSDM_PAdaptive<dim,N>::time_int_ssprk54(real_t dt)
+{
+
+  // see SolverHydroSDM::time_int_ssprk54
+  const real_t rk54_coef[6][3] =
+    {
+      {1.0,               0.0,               -0.391752226571890}, /*stage1*/
+      {0.444370493651235, 0.555629506348765, -0.368410593050371}, /*stage2*/
+      {0.620101851488403, 0.379898148511597, -0.251891774271694}, /*stage3*/
+      {0.178079954393132, 0.821920045606868, -0.544974750228521}, /*stage4*/
+      {0.517231671970585, 0.096059710526147, -0.063692468666290}, /*stage51*/
+      {1.0,               0.386708617503269, -0.226007483236906}  /*stage52*/
+    };
+
+  // stage input, first / second update operand and output of each stage
+  DofStore input[6]  = {Ustore,     Ustore_RK1, Ustore_RK2, Ustore_RK3, DofStore(), Ustore_RK4};
+  DofStore first[6]  = {Ustore,     Ustore,     Ustore,     Ustore,     Ustore_RK2, Ustore};
+  DofStore second[6] = {Ustore,     Ustore_RK1, Ustore_RK2, Ustore_RK3, Ustore_RK3, Ustore_RK4};
+  DofStore output[6] = {Ustore_RK1, Ustore_RK2, Ustore_RK3, Ustore_RK4, Ustore,     Ustore};
+
+  for (int stage=0; stage<6; ++stage) {
+
+    // stage 5.1 uses the fluxes divergence of stage 4
+    if (stage != 4)
+      compute_fluxes_divergence(input[stage], Ustore_fdiv);
+
+    const coefs_t coefs = {rk54_coef[stage][0],
+			   rk54_coef[stage][1],
+			   rk54_coef[stage][2]};
+    PAdaptive_Update_RK_Functor::apply(output[stage], first[stage], second[stage], Ustore_fdiv,
+				       coefs, dt, nbInteriorDofs);
+
+  }
+
+} // SolverHydroSDM_PAdaptive::time_int_ssprk54
+
+} // namespace sdm
+
+#endif // SOLVER_HYDRO_SDM_PADAPTIVE_H_
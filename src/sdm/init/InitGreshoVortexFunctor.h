@@ -41,12 +41,12 @@ public:
                     GreshoParams        gvParams,
                     DataArray           Udata)
   {
-    int nbCells = dim==2 ? 
-      params.isize*params.jsize : 
-      params.isize*params.jsize*params.ksize;
-    
     InitGreshoVortexFunctor functor(params, sdm_geom, gvParams, Udata);
-    Kokkos::parallel_for("InitGreshoVortexFunctor",nbCells, functor);
+    Kokkos::parallel_for("InitGreshoVortexFunctor",
+                         md_policy<dim>(0, 0, 0,
+                                        params.isize, params.jsize, params.ksize,
+                                        params.mdrange_tile),
+                         functor);
   }
 
   /*
@@ -55,23 +55,20 @@ public:
   //! functor for 2d 
   template<int dim_ = dim>
   KOKKOS_INLINE_FUNCTION
-  void operator()(const typename std::enable_if<dim_==2, int>::type& index) const
+  void operator()(const typename std::enable_if<dim_==2, int>::type& i,
+                  const int& j) const
   {
 
-    const int isize = this->params.isize;
-    const int jsize = this->params.jsize;
     const int ghostWidth = this->params.ghostWidth;
     
 #ifdef USE_MPI
-    const int i_mpi = this->params.myMpiPos[IX];
-    const int j_mpi = this->params.myMpiPos[IY];
+    const int i_offset = this->params.myOffset[IX];
+    const int j_offset = this->params.myOffset[IY];
 #else
-    const int i_mpi = 0;
-    const int j_mpi = 0;
+    const int i_offset = 0;
+    const int j_offset = 0;
 #endif
 
-    const int nx = this->params.nx;
-    const int ny = this->params.ny;
 
     const real_t xmin = this->params.xmin;
     const real_t ymin = this->params.ymin;
@@ -86,17 +83,13 @@ public:
 
     const real_t p0 = rho0 / (gamma0 * Ma * Ma);
     
-    // local cell index
-    int i,j;
-    index2coord(index,i,j,isize,jsize);
-    
     // loop over cell DoF's
     for (int idy=0; idy<N; ++idy) {
       for (int idx=0; idx<N; ++idx) {
 	
 	// lower left corner
-	real_t x = xmin + (i+nx*i_mpi-ghostWidth)*dx;
-	real_t y = ymin + (j+ny*j_mpi-ghostWidth)*dy;
+	real_t x = xmin + (i+i_offset-ghostWidth)*dx;
+	real_t y = ymin + (j+j_offset-ghostWidth)*dy;
 
 	// DoF location
 	x += this->sdm_geom.solution_pts_1d(idx) * dx;
@@ -147,27 +140,23 @@ public:
   //! functor for 3d 
   template<int dim_ = dim>
   KOKKOS_INLINE_FUNCTION
-  void operator()(const typename std::enable_if<dim_==3, int>::type& index) const
+  void operator()(const typename std::enable_if<dim_==3, int>::type& i,
+                  const int& j,
+                  const int& k) const
   {
 
-    const int isize = this->params.isize;
-    const int jsize = this->params.jsize;
-    const int ksize = this->params.ksize;
     const int ghostWidth = this->params.ghostWidth;
     
 #ifdef USE_MPI
-    const int i_mpi = this->params.myMpiPos[IX];
-    const int j_mpi = this->params.myMpiPos[IY];
-    const int k_mpi = this->params.myMpiPos[IZ];
+    const int i_offset = this->params.myOffset[IX];
+    const int j_offset = this->params.myOffset[IY];
+    const int k_offset = this->params.myOffset[IZ];
 #else
-    const int i_mpi = 0;
-    const int j_mpi = 0;
-    const int k_mpi = 0;
+    const int i_offset = 0;
+    const int j_offset = 0;
+    const int k_offset = 0;
 #endif
 
-    const int nx = this->params.nx;
-    const int ny = this->params.ny;
-    const int nz = this->params.nz;
 
     const real_t xmin = this->params.xmin;
     const real_t ymin = this->params.ymin;
@@ -185,19 +174,15 @@ public:
 
     const real_t p0 = rho0 / (gamma0 * Ma * Ma);
 
-    // local cell index
-    int i,j,k;
-    index2coord(index,i,j,k,isize,jsize,ksize);
-
     // loop over cell DoF's
     for (int idz=0; idz<N; ++idz) {
       for (int idy=0; idy<N; ++idy) {
 	for (int idx=0; idx<N; ++idx) {
 	  
 	  // lower left corner
-	  real_t x = xmin + (i+nx*i_mpi-ghostWidth)*dx;
-	  real_t y = ymin + (j+ny*j_mpi-ghostWidth)*dy;
-	  real_t z = zmin + (k+nz*k_mpi-ghostWidth)*dz;
+	  real_t x = xmin + (i+i_offset-ghostWidth)*dx;
+	  real_t y = ymin + (j+j_offset-ghostWidth)*dy;
+	  real_t z = zmin + (k+k_offset-ghostWidth)*dz;
 
 	  x += this->sdm_geom.solution_pts_1d(idx) * dx;
 	  y += this->sdm_geom.solution_pts_1d(idy) * dy;
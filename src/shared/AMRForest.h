@@ -0,0 +1,1647 @@
+/**
+ * \file AMRForest.h
+ * \brief Block-structured adaptive mesh : forest of quadtrees (2D) /
+ * octrees (3D) of fixed-size blocks.
+ */
+#ifndef AMR_FOREST_H_
+#define AMR_FOREST_H_
+
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+#include "shared/HydroParams.h"
+#include "shared/kokkos_shared.h"
+#include "shared/BoundariesFunctors.h"
+#include "shared/mpiBorderUtils.h"
+#include "shared/AMRFunctors.h"
+#include "utils/config/ConfigMap.h"
+
+#ifdef USE_MPI
+#include "utils/mpiUtils/MpiCommCart.h"
+#endif // USE_MPI
+
+namespace ppkMHD {
+
+/**
+ * Forest of quadtrees (2D) / octrees (3D) of blocks of block_size^dim
+ * cells (plus ghosts), covering the global domain.
+ *
+ * Roots are the level 0 blocks, a regular grid of (nx/block_size) x
+ * (ny/block_size) [x (nz/block_size)] blocks of the base resolution; a
+ * block of level L is split into 2^dim blocks of level L+1 with half
+ * the cell size. Neighbor leaves (diagonals included) differ by at most
+ * one level (2:1 balance).
+ *
+ * The tree structure is replicated on all MPI processes; each leaf is
+ * owned (state arrays allocated) by exactly one process. Leaves are
+ * sorted along a Morton space filling curve, and split into
+ * contiguous chunks of equal sizes between processes.
+ *
+ * Each leaf has its own HydroParams (sizes of a block, cell size of its
+ * level, offset of the block inside the global domain at its level),
+ * so that the uniform grid functors run unchanged on a leaf.
+ *
+ * All data movements between leaves (ghost cells, flux correction,
+ * regridding, output) are lists of transfers (see AMRTransfer), packed
+ * on the source owner and unpacked on the destination owner, with one
+ * message per pair of processes.
+ *
+ * Local time stepping : with time_levels > 1, each leaf has a time
+ * level t and advances with dt/2^t (dt is the step of time level 0),
+ * t being chosen from the stable time step of the leaf (see
+ * set_time_levels). Levels are advanced recursively (see run) : a
+ * leaf ahead in time provides ghost cells interpolated between its
+ * two states, fluxes of the leaf with the smaller time step are
+ * accumulated and replace the ones of its neighbor once both are
+ * synchronized. With level_max = 0, this is local time stepping on a
+ * uniform grid of blocks.
+ *
+ * Parameters (section [amr]) :
+ * - block_size        : interior cells of a block along each direction
+ * - level_max         : maximum refinement level (0 is the base grid)
+ * - refine_threshold  : a leaf is refined when its indicator is above
+ * - coarsen_threshold : siblings are merged when all their indicators
+ *                       are below
+ * - time_levels       : maximum number of time levels (1 : all leaves
+ *                       advance with the same time step)
+ */
+template<int dim>
+class AMRForest {
+
+public:
+
+  //! Decide at compile-time which data array to use for 2d or 3d
+  using DataArray = typename std::conditional<dim==2,DataArray2d,DataArray3d>::type;
+
+  //! Decide at compile-time which vector field to use for 2d or 3d
+  using VectorField = typename std::conditional<dim==2,VectorField2d,VectorField3d>::type;
+
+  static constexpr DimensionType dimType = dim==2 ? TWO_D : THREE_D;
+
+  static constexpr int nbChildren = 1 << dim;
+
+  struct Leaf {
+
+    int level;
+
+    //! block coordinates at level
+    Kokkos::Array<int,3> pos;
+
+    //! MPI rank of the process holding the data
+    int owner;
+
+    /*
+     * members below are only set on the owner
+     */
+
+    //! parameters of the block
+    HydroParams params;
+
+    //! state arrays, U[index] is read and U[1-index] written by a step
+    DataArray U[2];
+
+    //! gravity field (managed by the solver)
+    VectorField gravity;
+
+    //! border conditions of physical faces (BC_COPY for the others)
+    FaceBCArray faceBC;
+
+    //! ghost cells filled by border conditions
+    GhostCellList ghostCells;
+
+    //! time level (leaf advances with dt/2^tlevel)
+    int tlevel;
+
+    //! index of the current state in U during a step (see run)
+    int cur;
+
+    //! face flux layers saved after an update, for faces next to a
+    //! leaf of another level : reflux when this leaf is corrected
+    //! (neighbor finer in space or time), donor when its fluxes are
+    //! accumulated for the neighbor
+    bool reflux[6];
+    bool donor[6];
+    DataArray faceFlux[6];
+
+    //! true when data was created by the last regrid (new leaf, or
+    //! leaf moved to another process)
+    bool fresh;
+
+  }; // struct Leaf
+
+  AMRForest(HydroParams& params, ConfigMap& configMap);
+
+  //! number of leaves (all processes)
+  int size() const { return (int) m_leaves.size(); }
+
+  Leaf&       operator[](int l)       { return m_leaves[l]; }
+  const Leaf& operator[](int l) const { return m_leaves[l]; }
+
+  //! leaves owned by the current process
+  const std::vector<int>& local() const { return m_local; }
+
+  int block_size()  const { return m_bs; }
+  int level_max()   const { return m_level_max; }
+  int time_levels() const { return m_time_levels; }
+
+  //! ghosted size of a block along each direction
+  int ghosted_size() const { return m_bs + 2*params.ghostWidth; }
+
+  //! number of cells of all leaves (all processes)
+  long long int nb_cells() const;
+
+  //! fill ghost cells of U[index] of all local leaves
+  void fill_ghosts(int index, bool mhd_enabled);
+
+  //! save flux layers of local leaf l used by flux correction (implementation 0 fluxes)
+  void save_face_fluxes(int l, DataArray Fx, DataArray Fy, DataArray Fz);
+
+  /**
+   * Advance all leaves from U[index] to U[1-index] by dt : for each time
+   * level, ghost cells are filled, update(l, in, dtLevel) advances
+   * local leaf l from U[in] to U[1-in] and saves its fluxes (see
+   * save_face_fluxes), finer time levels are advanced twice, then
+   * coarse cells are corrected with the fluxes of their finer
+   * neighbors.
+   */
+  template<class Update>
+  void run(int index, bool mhd_enabled, real_t dt, Update update);
+
+  /**
+   * Set time levels from the stable time step of each leaf (only read
+   * for local leaves); neighbor leaves differ by at most one time
+   * level, and a finer leaf never has a larger time step than its
+   * coarser neighbor.
+   *
+   * \return time step of time level 0
+   */
+  real_t set_time_levels(const std::vector<real_t>& dtLeaf);
+
+  /**
+   * Refine / coarsen leaves according to indicator (one value per
+   * leaf, only read for local leaves), then redistribute leaves along
+   * the space filling curve. Ghost cells of U[index] must be up to
+   * date (used by prolongation).
+   *
+   * \return true when the forest changed
+   */
+  bool regrid(int index, const std::vector<real_t>& indicator);
+
+  //! average U[index] of all leaves on the base grid (process sub-domain)
+  void project(DataArray Udata, int index);
+
+private:
+
+  HydroParams& params;
+
+  //! block size (interior cells)
+  int m_bs;
+
+  int m_level_max;
+
+  //! maximum number of time levels, and number of time levels used
+  int m_time_levels;
+  int m_used_time_levels;
+  real_t m_refine_threshold;
+  real_t m_coarsen_threshold;
+
+  //! number of root blocks along each direction
+  int m_nRoot[3];
+
+  //! periodic border along each direction
+  bool m_periodic[3];
+
+  int m_myRank;
+  int m_nProcs;
+
+  std::vector<Leaf> m_leaves;
+
+  std::vector<int> m_local;
+
+  //! tree nodes : leaf index, or -1 for a refined node
+  std::map<uint64_t,int> m_tree;
+
+  /**
+   * A transfer between two leaves, or between a leaf and a process
+   * sub-domain (output).
+   */
+  struct Item {
+    int src, dst;          //!< leaf indices (dst : process rank for output)
+    int srcRank, dstRank;
+    int face;              //!< destination face (AMR_FLUX only)
+    AMRTransfer tr;
+    long long int sendOffset, recvOffset;
+  };
+
+  /**
+   * Transfer list and buffers; items of a given pair of processes are
+   * stored contiguously, in the same order on both sides.
+   */
+  struct Plan {
+    std::vector<Item> items;
+    std::vector<int> sendPeers, recvPeers;
+    std::vector<long long int> sendDispl, recvDispl;
+    std::vector<long long int> sendCount, recvCount;
+    Kokkos::View<storage_t*, Device> sendBuf, recvBuf;
+  };
+
+  //! ghost cells of the leaves of each time level : copies and
+  //! restrictions first, then prolongations (their slopes use the
+  //! coarse ghost cells filled by the first stage)
+  std::vector<Plan> m_ghostPlan[2];
+
+  //! flux correction of the leaves of each time level
+  std::vector<Plan> m_refluxPlan;
+
+  static uint64_t key(int level, const Kokkos::Array<int,3>& pos)
+  {
+    return
+      (uint64_t(level)   << 60) |
+      (uint64_t(pos[IX]) << 40) |
+      (uint64_t(pos[IY]) << 20) |
+      (uint64_t(pos[IZ]));
+  }
+
+  //! leaf index, -1 for a refined node, -2 when there is no such node
+  int find(int level, const Kokkos::Array<int,3>& pos) const
+  {
+    auto it = m_tree.find(key(level, pos));
+    return it == m_tree.end() ? -2 : it->second;
+  }
+
+  //! apply periodicity; false when pos is outside of the domain
+  bool wrap(int level, Kokkos::Array<int,3>& pos) const;
+
+  //! Morton index of a leaf (at level_max resolution)
+  uint64_t morton(int level, const Kokkos::Array<int,3>& pos) const;
+
+  //! child e coordinates (bit d of e is the position along direction d)
+  static Kokkos::Array<int,3> child(const Kokkos::Array<int,3>& pos, int e)
+  {
+    Kokkos::Array<int,3> c;
+    for (int d=0; d<3; ++d)
+      c[d] = d < dim ? 2*pos[d] + ((e >> d) & 1) : 0;
+    return c;
+  }
+
+  //! i-th neighbor offset, i in [0,3^dim[, (0,0,0) excluded by caller
+  static Kokkos::Array<int,3> offset(int i)
+  {
+    Kokkos::Array<int,3> off;
+    off[IX] = i%3 - 1;
+    off[IY] = (i/3)%3 - 1;
+    off[IZ] = dim==3 ? i/9 - 1 : 0;
+    return off;
+  }
+
+  static int nb_offsets() { return dim==2 ? 9 : 27; }
+
+  //! sort leaves along the curve, set owners, tree and local list
+  void distribute(std::vector<Leaf>& leaves);
+
+  //! parameters, border conditions and arrays of a local leaf
+  void setup_leaf(Leaf& leaf, bool allocate);
+
+  //! leaves touching leaf l (faces, edges and corners)
+  void touching(int l, std::vector<int>& out) const;
+
+  //! enforce sibling consistency and 2:1 balance on refinement flags
+  void balance(std::vector<int>& flags) const;
+
+  //! ghost cells and flux correction transfer lists
+  void build_plans();
+
+  //! compute offsets and allocate buffers of a plan
+  void finalize_plan(Plan& plan);
+
+  //! box view inside a plan buffer
+  DataArray box(Kokkos::View<storage_t*, Device> buf, long long int offset,
+		const AMRTransfer& tr) const
+  {
+    storage_t* ptr = buf.data() + offset;
+    return dim==2 ?
+      DataArray(ptr, tr.n[IX], tr.n[IY], params.nbvar) :
+      DataArray(ptr, tr.n[IX], tr.n[IY], tr.n[IZ], params.nbvar);
+  }
+
+  long long int item_size(const AMRTransfer& tr) const
+  {
+    return (long long int) tr.n[IX]*tr.n[IY]*tr.n[IZ]*params.nbvar;
+  }
+
+  /**
+   * Run the transfers of a plan : pack(item, box) fills box on the
+   * source side, store(item, box) unpacks it on the destination side.
+   */
+  template<class Pack, class Store>
+  void exchange(Plan& plan, Pack pack, Store store);
+
+  /**
+   * Fill ghost cells of the current state (U[cur]) of local leaves of
+   * time level tlevel (all leaves when negative); tick is the time of
+   * these leaves inside the step (in units of the step of the finest
+   * time level), sources ahead in time are then interpolated.
+   */
+  void fill_ghosts_level(int tlevel, int tick, bool mhd_enabled);
+
+  //! correct the current state of local leaves of time level tlevel
+  void reflux_level(int tlevel);
+
+  //! advance leaves of time level tlevel, and finer levels recursively
+  template<class Update>
+  void run_level(int tlevel, int tick, real_t dt, bool mhd_enabled, Update& update);
+
+}; // class AMRForest
+
+// =======================================================
+// =======================================================
+template<int dim>
+AMRForest<dim>::AMRForest(HydroParams& params, ConfigMap& configMap) :
+  params(params),
+  m_leaves(),
+  m_local(),
+  m_tree()
+{
+
+  m_bs                = configMap.getInteger("amr", "block_size", 16);
+  m_level_max         = configMap.getInteger("amr", "level_max", 2);
+  m_time_levels       = configMap.getInteger("amr", "time_levels", 1);
+  m_used_time_levels  = 1;
+  m_refine_threshold  = configMap.getFloat("amr", "refine_threshold", 0.1);
+  m_coarsen_threshold = configMap.getFloat("amr", "coarsen_threshold", 0.02);
+
+  m_myRank = 0;
+  m_nProcs = 1;
+
+  int nGlobal[3] = {params.nx, params.ny, params.nz};
+
+#ifdef USE_MPI
+  m_myRank = params.myRank;
+  m_nProcs = params.nProcs;
+  for (int d=0; d<3; ++d)
+    nGlobal[d] = params.nGlobal[d];
+#endif // USE_MPI
+
+  /*
+   * a leaf of level_max must cover a whole number of base cells
+   * (output), and ghost cells of a leaf must only touch leaves adjacent
+   * to it (2:1 balance)
+   */
+  const int ratioMax = 1 << m_level_max;
+  bool valid = m_level_max >= 0 && m_level_max < 16 &&
+    m_bs % ratioMax == 0 && m_bs % 4 == 0 && m_bs >= 2*params.ghostWidth;
+  for (int d=0; d<dim; ++d)
+    valid = valid && nGlobal[d] % m_bs == 0;
+
+  if (!valid) {
+    fprintf(stderr, "AMR : block_size must be a multiple of 4 and of 2^level_max,\n");
+    fprintf(stderr, "and divide the global domain sizes. Check section [amr] of your parameter file\n");
+    exit(EXIT_FAILURE);
+  }
+
+  if (m_time_levels < 1 || m_time_levels > 16) {
+    fprintf(stderr, "AMR : time_levels must be in [1,16]. Check section [amr] of your parameter file\n");
+    exit(EXIT_FAILURE);
+  }
+
+  m_ghostPlan[0].resize(m_time_levels);
+  m_ghostPlan[1].resize(m_time_levels);
+  m_refluxPlan.resize(m_time_levels);
+
+  BoundaryConditionType bcMin[3] = {
+    params.boundary_type_xmin, params.boundary_type_ymin, params.boundary_type_zmin };
+  for (int d=0; d<3; ++d) {
+    m_nRoot[d] = d < dim ? nGlobal[d]/m_bs : 1;
+    m_periodic[d] = d < dim && bcMin[d] == BC_PERIODIC;
+  }
+
+  // roots
+  std::vector<Leaf> leaves;
+  for (int k=0; k<m_nRoot[IZ]; ++k)
+    for (int j=0; j<m_nRoot[IY]; ++j)
+      for (int i=0; i<m_nRoot[IX]; ++i) {
+	Leaf leaf;
+	leaf.level = 0;
+	leaf.tlevel = 0;
+	leaf.pos[IX] = i;
+	leaf.pos[IY] = j;
+	leaf.pos[IZ] = k;
+	leaves.push_back(leaf);
+      }
+
+  distribute(leaves);
+
+  m_leaves = leaves;
+  for (int l : m_local)
+    setup_leaf(m_leaves[l], true);
+
+  build_plans();
+
+} // AMRForest::AMRForest
+
+// =======================================================
+// =======================================================
+template<int dim>
+long long int AMRForest<dim>::nb_cells() const
+{
+
+  long long int n = m_bs*m_bs;
+  if (dim==3)
+    n *= m_bs;
+
+  return n*size();
+
+} // AMRForest::nb_cells
+
+// =======================================================
+// =======================================================
+template<int dim>
+bool AMRForest<dim>::wrap(int level, Kokkos::Array<int,3>& pos) const
+{
+
+  for (int d=0; d<dim; ++d) {
+    const int n = m_nRoot[d] << level;
+    if (pos[d] >= 0 && pos[d] < n)
+      continue;
+    if (!m_periodic[d])
+      return false;
+    pos[d] = (pos[d] + n) % n;
+  }
+
+  return true;
+
+} // AMRForest::wrap
+
+// =======================================================
+// =======================================================
+template<int dim>
+uint64_t AMRForest<dim>::morton(int level, const Kokkos::Array<int,3>& pos) const
+{
+
+  const int shift = m_level_max - level;
+
+  uint64_t m = 0;
+  for (int bit=0; bit<21; ++bit)
+    for (int d=0; d<dim; ++d) {
+      const uint64_t x = uint64_t(pos[d]) << shift;
+      m |= ((x >> bit) & 1) << (dim*bit + d);
+    }
+
+  return m;
+
+} // AMRForest::morton
+
+// =======================================================
+// =======================================================
+template<int dim>
+void AMRForest<dim>::distribute(std::vector<Leaf>& leaves)
+{
+
+  std::sort(leaves.begin(), leaves.end(),
+	    [this](const Leaf& a, const Leaf& b) {
+	      return morton(a.level, a.pos) < morton(b.level, b.pos);
+	    });
+
+  const long long int n = leaves.size();
+
+  m_tree.clear();
+  m_local.clear();
+
+  for (long long int l=0; l<n; ++l) {
+
+    Leaf& leaf = leaves[l];
+    leaf.owner = (int) (l*m_nProcs/n);
+
+    if (leaf.owner == m_myRank)
+      m_local.push_back(l);
+
+    m_tree[key(leaf.level, leaf.pos)] = l;
+
+    // refined ancestors
+    Kokkos::Array<int,3> p = leaf.pos;
+    for (int level=leaf.level-1; level>=0; --level) {
+      for (int d=0; d<dim; ++d)
+	p[d] /= 2;
+      m_tree[key(level, p)] = -1;
+    }
+  }
+
+} // AMRForest::distribute
+
+// =======================================================
+// =======================================================
+template<int dim>
+void AMRForest<dim>::setup_leaf(Leaf& leaf, bool allocate)
+{
+
+  const int gw = params.ghostWidth;
+  const int bs = m_bs;
+  const int ratio = 1 << leaf.level;
+
+  HydroParams& lp = leaf.params;
+  lp = params;
+
+  lp.nx = bs;
+  lp.ny = bs;
+  lp.imax = bs-1+2*gw;
+  lp.jmax = bs-1+2*gw;
+  lp.isize = bs+2*gw;
+  lp.jsize = bs+2*gw;
+  lp.dx = (params.xmax - params.xmin) / (m_nRoot[IX]*bs*ratio);
+  lp.dy = (params.ymax - params.ymin) / (m_nRoot[IY]*bs*ratio);
+  if (dim==3) {
+    lp.nz = bs;
+    lp.kmax = bs-1+2*gw;
+    lp.ksize = bs+2*gw;
+    lp.dz = (params.zmax - params.zmin) / (m_nRoot[IZ]*bs*ratio);
+  }
+
+  for (int d=0; d<3; ++d)
+    lp.myOffset[d] = d < dim ? leaf.pos[d]*bs : 0;
+
+  BoundaryConditionType bc[6] = {
+    params.boundary_type_xmin, params.boundary_type_xmax,
+    params.boundary_type_ymin, params.boundary_type_ymax,
+    params.boundary_type_zmin, params.boundary_type_zmax };
+
+  for (int face=0; face<6; ++face) {
+
+    const int d = face/2;
+
+    leaf.faceBC[face] = BC_COPY;
+
+    if (d >= dim || m_periodic[d])
+      continue;
+
+    const bool atBorder = face%2 == 0 ?
+      leaf.pos[d] == 0 :
+      leaf.pos[d] == (m_nRoot[d] << leaf.level) - 1;
+
+    if (atBorder)
+      leaf.faceBC[face] = bc[face];
+
+  }
+
+  leaf.ghostCells = build_ghost_cell_list(lp, leaf.faceBC);
+
+  leaf.fresh = allocate;
+  leaf.cur = 0;
+
+  if (allocate) {
+    for (int index=0; index<2; ++index)
+      leaf.U[index] = dim==2 ?
+	DataArray("U_leaf", lp.isize, lp.jsize, lp.nbvar) :
+	DataArray("U_leaf", lp.isize, lp.jsize, lp.ksize, lp.nbvar);
+  }
+
+} // AMRForest::setup_leaf
+
+// =======================================================
+// =======================================================
+template<int dim>
+void AMRForest<dim>::touching(int l, std::vector<int>& out) const
+{
+
+  const Leaf& leaf = m_leaves[l];
+  const int level = leaf.level;
+
+  out.clear();
+
+  for (int o=0; o<nb_offsets(); ++o) {
+
+    const Kokkos::Array<int,3> off = offset(o);
+    if (off[IX] == 0 && off[IY] == 0 && off[IZ] == 0)
+      continue;
+
+    Kokkos::Array<int,3> p;
+    for (int d=0; d<3; ++d)
+      p[d] = leaf.pos[d] + off[d];
+
+    if (!wrap(level, p))
+      continue;
+
+    const int n = find(level, p);
+
+    if (n >= 0) {
+
+      out.push_back(n);
+
+    } else if (n == -1) {
+
+      // children of the slot next to the leaf
+      for (int e=0; e<nbChildren; ++e) {
+	bool next = true;
+	for (int d=0; d<dim; ++d) {
+	  const int ed = (e >> d) & 1;
+	  next = next && !(off[d] == -1 && ed == 0) && !(off[d] == 1 && ed == 1);
+	}
+	const int c = next ? find(level+1, child(p, e)) : -2;
+	if (c >= 0)
+	  out.push_back(c);
+      }
+
+    } else if (level > 0) {
+
+      Kokkos::Array<int,3> q = p;
+      for (int d=0; d<dim; ++d)
+	q[d] /= 2;
+      const int c = find(level-1, q);
+      if (c >= 0)
+	out.push_back(c);
+
+    }
+
+  } // end for o
+
+} // AMRForest::touching
+
+// =======================================================
+// =======================================================
+template<int dim>
+void AMRForest<dim>::balance(std::vector<int>& flags) const
+{
+
+  std::vector<int> next;
+
+  bool changed = true;
+  while (changed) {
+
+    changed = false;
+
+    // siblings are only merged all together
+    for (int l=0; l<size(); ++l) {
+
+      const Leaf& leaf = m_leaves[l];
+      if (flags[l] != -1)
+	continue;
+
+      Kokkos::Array<int,3> parent = leaf.pos;
+      for (int d=0; d<dim; ++d)
+	parent[d] /= 2;
+
+      bool all = true;
+      for (int e=0; e<nbChildren; ++e) {
+	const int s = find(leaf.level, child(parent, e));
+	all = all && s >= 0 && flags[s] == -1;
+      }
+
+      if (!all) {
+	flags[l] = 0;
+	changed = true;
+      }
+    }
+
+    // 2:1 balance of the new levels
+    for (int l=0; l<size(); ++l) {
+
+      touching(l, next);
+
+      const int target = m_leaves[l].level + flags[l];
+      for (int n : next) {
+	if (target - (m_leaves[n].level + flags[n]) > 1) {
+	  flags[n]++;
+	  changed = true;
+	}
+      }
+    }
+
+  } // end while changed
+
+} // AMRForest::balance
+
+// =======================================================
+// =======================================================
+template<int dim>
+void AMRForest<dim>::build_plans()
+{
+
+  const int gw = params.ghostWidth;
+  const int bs = m_bs;
+
+  for (int t=0; t<m_time_levels; ++t) {
+    m_ghostPlan[0][t] = Plan();
+    m_ghostPlan[1][t] = Plan();
+    m_refluxPlan[t] = Plan();
+  }
+
+  for (int l : m_local)
+    for (int face=0; face<6; ++face) {
+      m_leaves[l].reflux[face] = false;
+      m_leaves[l].donor[face] = false;
+    }
+
+  auto involved = [this](const Item& item) {
+    return item.srcRank == m_myRank || item.dstRank == m_myRank;
+  };
+
+  for (int l=0; l<size(); ++l) {
+
+    Leaf& leaf = m_leaves[l];
+    const int level = leaf.level;
+    const int t = leaf.tlevel;
+
+    /*
+     * ghost cells : one region per neighbor slot of the same level,
+     * filled by a copy (same level), a prolongation (coarser leaf) or
+     * restrictions (finer leaves)
+     */
+    for (int o=0; o<nb_offsets(); ++o) {
+
+      const Kokkos::Array<int,3> off = offset(o);
+      if (off[IX] == 0 && off[IY] == 0 && off[IZ] == 0)
+	continue;
+
+      Kokkos::Array<int,3> p;
+      for (int d=0; d<3; ++d)
+	p[d] = leaf.pos[d] + off[d];
+
+      if (!wrap(level, p))
+	continue;
+
+      // region of ghost cells
+      Kokkos::Array<int,3> lo, hi;
+      for (int d=0; d<3; ++d) {
+	lo[d] = d >= dim ? 0 : off[d] == -1 ? 0 : off[d] == 0 ? gw : gw+bs;
+	hi[d] = d >= dim ? 1 : off[d] == -1 ? gw : off[d] == 0 ? gw+bs : bs+2*gw;
+      }
+
+      Item item;
+      item.dst = l;
+      item.dstRank = leaf.owner;
+      item.face = -1;
+
+      const int n = find(level, p);
+
+      if (n >= 0) { // same level : copy
+
+	item.src = n;
+	item.srcRank = m_leaves[n].owner;
+	item.tr.type = AMR_RESTRICT;
+	item.tr.ratio = 1;
+	for (int d=0; d<3; ++d) {
+	  item.tr.lo[d] = lo[d];
+	  item.tr.n[d] = hi[d]-lo[d];
+	  item.tr.shift[d] = d < dim ? -off[d]*bs : 0;
+	}
+	if (involved(item))
+	  m_ghostPlan[0][t].items.push_back(item);
+
+      } else if (n == -2) { // coarser : prolongation
+
+	Kokkos::Array<int,3> q = p;
+	for (int d=0; d<dim; ++d)
+	  q[d] /= 2;
+
+	item.src = find(level-1, q);
+	if (item.src < 0) {
+	  fprintf(stderr, "AMR : unbalanced forest\n");
+	  exit(EXIT_FAILURE);
+	}
+	item.srcRank = m_leaves[item.src].owner;
+	item.tr.type = AMR_PROLONG;
+	for (int d=0; d<3; ++d) {
+	  item.tr.lo[d] = lo[d];
+	  item.tr.n[d] = hi[d]-lo[d];
+	  item.tr.shift[d] = d < dim ? gw + (p[d] - 2*q[d] - off[d])*bs : 0;
+	  item.tr.slopeMin[d] = 0;
+	  item.tr.slopeMax[d] = bs+2*gw;
+	}
+	if (involved(item))
+	  m_ghostPlan[1][t].items.push_back(item);
+
+      } else { // finer : restriction of each child covering the region
+
+	for (int e=0; e<nbChildren; ++e) {
+
+	  Item itemC = item;
+	  bool empty = false;
+	  for (int d=0; d<3; ++d) {
+	    const int ed = (e >> d) & 1;
+	    const int clo = d < dim ? gw + off[d]*bs + ed*bs/2 : 0;
+	    const int chi = d < dim ? clo + bs/2 : 1;
+	    itemC.tr.lo[d] = std::max(lo[d], clo);
+	    itemC.tr.n[d] = std::min(hi[d], chi) - itemC.tr.lo[d];
+	    itemC.tr.shift[d] = d < dim ? -gw - 2*off[d]*bs - ed*bs : 0;
+	    empty = empty || itemC.tr.n[d] <= 0 || (d >= dim && ed);
+	  }
+	  if (empty)
+	    continue;
+
+	  itemC.src = find(level+1, child(p, e));
+	  if (itemC.src < 0) {
+	    fprintf(stderr, "AMR : unbalanced forest\n");
+	    exit(EXIT_FAILURE);
+	  }
+	  itemC.srcRank = m_leaves[itemC.src].owner;
+	  itemC.tr.type = AMR_RESTRICT;
+	  itemC.tr.ratio = 2;
+	  if (involved(itemC))
+	    m_ghostPlan[0][t].items.push_back(itemC);
+
+	}
+
+      }
+
+    } // end for o
+
+    /*
+     * flux correction : cells next to a refined neighbor slot, or to a
+     * leaf of the same level with a smaller time step, use the fluxes
+     * of the neighbor (summed over its faces and time steps)
+     */
+    for (int face=0; face<2*dim; ++face) {
+
+      const int dir = face/2;
+      const int side = face%2;
+
+      Kokkos::Array<int,3> p = leaf.pos;
+      p[dir] += side == 0 ? -1 : 1;
+
+      if (!wrap(level, p))
+	continue;
+
+      const int n = find(level, p);
+
+      std::vector<Item> items;
+
+      Item item;
+      item.dst = l;
+      item.dstRank = leaf.owner;
+      item.face = face;
+      item.tr.type = AMR_FLUX;
+      item.tr.dir = dir;
+
+      if (n >= 0 && m_leaves[n].tlevel > t) {
+
+	item.src = n;
+	item.tr.ratio = 1;
+	for (int d=0; d<3; ++d) {
+	  item.tr.lo[d] = d == dir ? (side == 0 ? gw : gw+bs-1) : d < dim ? gw : 0;
+	  item.tr.n[d] = d == dir || d >= dim ? 1 : bs;
+	  item.tr.shift[d] = 0;
+	}
+	items.push_back(item);
+
+      } else if (n == -1) {
+
+	for (int e=0; e<nbChildren; ++e) {
+
+	  // only children touching the face
+	  if (((e >> dir) & 1) == side)
+	    continue;
+
+	  item.src = find(level+1, child(p, e));
+	  if (item.src < 0) {
+	    fprintf(stderr, "AMR : unbalanced forest\n");
+	    exit(EXIT_FAILURE);
+	  }
+	  item.tr.ratio = 2;
+	  for (int d=0; d<3; ++d) {
+	    const int ed = (e >> d) & 1;
+	    if (d == dir) {
+	      item.tr.lo[d] = side == 0 ? gw : gw+bs-1;
+	      item.tr.n[d] = 1;
+	      item.tr.shift[d] = 0;
+	    } else if (d < dim) {
+	      item.tr.lo[d] = gw + ed*bs/2;
+	      item.tr.n[d] = bs/2;
+	      item.tr.shift[d] = -gw - ed*bs;
+	    } else {
+	      item.tr.lo[d] = 0;
+	      item.tr.n[d] = 1;
+	      item.tr.shift[d] = 0;
+	    }
+	  }
+	  items.push_back(item);
+
+	}
+
+      }
+
+      for (Item& itemF : items) {
+
+	itemF.srcRank = m_leaves[itemF.src].owner;
+
+	if (!involved(itemF))
+	  continue;
+
+	m_refluxPlan[t].items.push_back(itemF);
+
+	// face fluxes to save (coarse side, and opposite face of the fine side)
+	if (leaf.owner == m_myRank)
+	  leaf.reflux[face] = true;
+	if (itemF.srcRank == m_myRank)
+	  m_leaves[itemF.src].donor[face^1] = true;
+
+      }
+
+    } // end for face
+
+  } // end for l
+
+  // face flux layers (zero : donor fluxes are accumulated)
+  for (int l : m_local) {
+    Leaf& leaf = m_leaves[l];
+    const HydroParams& lp = leaf.params;
+    for (int face=0; face<2*dim; ++face) {
+      if (!leaf.reflux[face] && !leaf.donor[face]) {
+	leaf.faceFlux[face] = DataArray();
+      } else if (leaf.faceFlux[face].data() != nullptr) {
+	Kokkos::deep_copy(leaf.faceFlux[face], ZERO_F);
+      } else {
+	int ext[3] = {lp.isize, lp.jsize, lp.ksize};
+	ext[face/2] = 1;
+	leaf.faceFlux[face] = dim==2 ?
+	  DataArray("faceFlux", ext[0], ext[1], lp.nbvar) :
+	  DataArray("faceFlux", ext[0], ext[1], ext[2], lp.nbvar);
+      }
+    }
+  }
+
+  for (int t=0; t<m_time_levels; ++t) {
+    finalize_plan(m_ghostPlan[0][t]);
+    finalize_plan(m_ghostPlan[1][t]);
+    finalize_plan(m_refluxPlan[t]);
+  }
+
+} // AMRForest::build_plans
+
+// =======================================================
+// =======================================================
+template<int dim>
+void AMRForest<dim>::finalize_plan(Plan& plan)
+{
+
+  std::vector<long long int> sendCount(m_nProcs, 0), recvCount(m_nProcs, 0);
+
+  for (const Item& item : plan.items) {
+    if (item.srcRank == m_myRank)
+      sendCount[item.dstRank] += item_size(item.tr);
+    if (item.dstRank == m_myRank && item.srcRank != m_myRank)
+      recvCount[item.srcRank] += item_size(item.tr);
+  }
+
+  // per peer segments
+  std::vector<long long int> sendDispl(m_nProcs, 0), recvDispl(m_nProcs, 0);
+  long long int sendTotal = 0, recvTotal = 0;
+
+  plan.sendPeers.clear();
+  plan.recvPeers.clear();
+  plan.sendDispl.clear();
+  plan.recvDispl.clear();
+  plan.sendCount.clear();
+  plan.recvCount.clear();
+
+  for (int r=0; r<m_nProcs; ++r) {
+    sendDispl[r] = sendTotal;
+    recvDispl[r] = recvTotal;
+    if (sendCount[r] > 0 && r != m_myRank) {
+      plan.sendPeers.push_back(r);
+      plan.sendDispl.push_back(sendTotal);
+      plan.sendCount.push_back(sendCount[r]);
+    }
+    if (recvCount[r] > 0) {
+      plan.recvPeers.push_back(r);
+      plan.recvDispl.push_back(recvTotal);
+      plan.recvCount.push_back(recvCount[r]);
+    }
+    sendTotal += sendCount[r];
+    recvTotal += recvCount[r];
+  }
+
+  // item offsets, in list order inside each segment
+  for (Item& item : plan.items) {
+    item.sendOffset = -1;
+    item.recvOffset = -1;
+    if (item.srcRank == m_myRank) {
+      item.sendOffset = sendDispl[item.dstRank];
+      sendDispl[item.dstRank] += item_size(item.tr);
+    }
+    if (item.dstRank == m_myRank && item.srcRank != m_myRank) {
+      item.recvOffset = recvDispl[item.srcRank];
+      recvDispl[item.srcRank] += item_size(item.tr);
+    }
+  }
+
+  plan.sendBuf = Kokkos::View<storage_t*, Device>("AMR sendBuf", sendTotal);
+  plan.recvBuf = Kokkos::View<storage_t*, Device>("AMR recvBuf", recvTotal);
+
+} // AMRForest::finalize_plan
+
+// =======================================================
+// =======================================================
+template<int dim>
+template<class Pack, class Store>
+void AMRForest<dim>::exchange(Plan& plan, Pack pack, Store store)
+{
+
+#ifdef USE_MPI
+  const int tag = 900;
+
+  std::vector<MPI_Request> requests;
+
+  for (size_t p=0; p<plan.recvPeers.size(); ++p)
+    requests.push_back(params.communicator->Irecv(plan.recvBuf.data() + plan.recvDispl[p],
+						  plan.recvCount[p],
+						  params.storage_data_type,
+						  plan.recvPeers[p], tag));
+#endif // USE_MPI
+
+  // pack, messages first
+  for (int pass=0; pass<2; ++pass)
+    for (const Item& item : plan.items) {
+      if (item.srcRank != m_myRank || (item.dstRank == m_myRank) != (pass == 1))
+	continue;
+      pack(item, box(plan.sendBuf, item.sendOffset, item.tr));
+    }
+
+#ifdef USE_MPI
+  Kokkos::fence();
+
+  for (size_t p=0; p<plan.sendPeers.size(); ++p)
+    requests.push_back(params.communicator->Isend(plan.sendBuf.data() + plan.sendDispl[p],
+						  plan.sendCount[p],
+						  params.storage_data_type,
+						  plan.sendPeers[p], tag));
+#endif // USE_MPI
+
+  // local transfers while messages are in flight
+  for (const Item& item : plan.items)
+    if (item.srcRank == m_myRank && item.dstRank == m_myRank)
+      store(item, box(plan.sendBuf, item.sendOffset, item.tr));
+
+#ifdef USE_MPI
+  if (!requests.empty())
+    MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
+
+  for (const Item& item : plan.items)
+    if (item.dstRank == m_myRank && item.srcRank != m_myRank)
+      store(item, box(plan.recvBuf, item.recvOffset, item.tr));
+#endif // USE_MPI
+
+} // AMRForest::exchange
+
+// =======================================================
+// =======================================================
+template<int dim>
+void AMRForest<dim>::fill_ghosts(int index, bool mhd_enabled)
+{
+
+  for (int l : m_local)
+    m_leaves[l].cur = index;
+
+  fill_ghosts_level(-1, 0, mhd_enabled);
+
+} // AMRForest::fill_ghosts
+
+// =======================================================
+// =======================================================
+template<int dim>
+void AMRForest<dim>::fill_ghosts_level(int tlevel, int tick, bool mhd_enabled)
+{
+
+  const Kokkos::Array<int,3>& tile = params.mdrange_tile;
+
+  // number of ticks of a step of time level 0
+  const int ticks = 1 << (m_time_levels-1);
+
+  auto pack = [&](const Item& item, DataArray data) {
+
+    const Leaf& src = m_leaves[item.src];
+
+    // source ahead in time : interpolate between its last two states
+    if (tlevel >= 0 && src.tlevel < tlevel) {
+      const int span = ticks >> src.tlevel;
+      const real_t alpha = (real_t) (tick % span) / span;
+      AMRPackFunctor<dimType>::apply(data, src.U[src.cur], src.U[1-src.cur],
+				     alpha, item.tr, tile);
+    } else {
+      AMRPackFunctor<dimType>::apply(data, src.U[src.cur], item.tr, tile);
+    }
+
+  };
+
+  auto store = [&](const Item& item, DataArray data) {
+    const Leaf& dst = m_leaves[item.dst];
+    AMRUnpackFunctor<dimType>::apply(dst.U[dst.cur], data, item.tr, tile);
+  };
+
+  for (int stage=0; stage<2; ++stage) {
+
+    for (int t=0; t<m_time_levels; ++t)
+      if (tlevel < 0 || t == tlevel)
+	exchange(m_ghostPlan[stage][t], pack, store);
+
+    // physical borders after each stage (corners use ghost cells filled
+    // above, prolongation slopes use the border ghost cells)
+    for (int l : m_local) {
+      Leaf& leaf = m_leaves[l];
+      if (tlevel < 0 || leaf.tlevel == tlevel)
+	make_boundaries_apply<dim>(leaf.params, leaf.U[leaf.cur],
+				   leaf.ghostCells, leaf.faceBC, mhd_enabled);
+    }
+
+  }
+
+} // AMRForest::fill_ghosts_level
+
+// =======================================================
+// =======================================================
+template<int dim>
+void AMRForest<dim>::save_face_fluxes(int l, DataArray Fx, DataArray Fy, DataArray Fz)
+{
+
+  Leaf& leaf = m_leaves[l];
+
+  DataArray flux[3] = {Fx, Fy, Fz};
+
+  for (int face=0; face<2*dim; ++face) {
+
+    if (!leaf.reflux[face] && !leaf.donor[face])
+      continue;
+
+    // flux of a min face is stored at the first interior cell, flux of
+    // a max face at the first ghost cell
+    const int layer = params.ghostWidth + (face%2 == 0 ? 0 : m_bs);
+
+    AMRSaveFluxFunctor<dimType>::apply(leaf.faceFlux[face], flux[face/2],
+				       face/2, layer, leaf.donor[face],
+				       params.mdrange_tile);
+  }
+
+} // AMRForest::save_face_fluxes
+
+// =======================================================
+// =======================================================
+template<int dim>
+void AMRForest<dim>::reflux_level(int tlevel)
+{
+
+  const Kokkos::Array<int,3>& tile = params.mdrange_tile;
+
+  Plan& plan = m_refluxPlan[tlevel];
+
+  exchange(plan,
+	   [&](const Item& item, DataArray data) {
+	     AMRPackFunctor<dimType>::apply(data, m_leaves[item.src].faceFlux[item.face^1],
+					    item.tr, tile);
+	   },
+	   [&](const Item& item, DataArray data) {
+	     Leaf& leaf = m_leaves[item.dst];
+	     AMRUnpackFunctor<dimType>::apply_flux(leaf.U[leaf.cur], data,
+						   leaf.faceFlux[item.face],
+						   item.tr, item.face%2, tile);
+	   });
+
+  // donors start accumulating the next step of their neighbor
+  for (const Item& item : plan.items)
+    if (item.srcRank == m_myRank)
+      Kokkos::deep_copy(m_leaves[item.src].faceFlux[item.face^1], ZERO_F);
+
+} // AMRForest::reflux_level
+
+// =======================================================
+// =======================================================
+template<int dim>
+template<class Update>
+void AMRForest<dim>::run(int index, bool mhd_enabled, real_t dt, Update update)
+{
+
+  for (int l : m_local)
+    m_leaves[l].cur = index;
+
+  run_level(0, 0, dt, mhd_enabled, update);
+
+  // current states back into U[1-index]
+  for (int l : m_local) {
+    Leaf& leaf = m_leaves[l];
+    if (leaf.cur != 1-index) {
+      std::swap(leaf.U[0], leaf.U[1]);
+      leaf.cur = 1-index;
+    }
+  }
+
+} // AMRForest::run
+
+// =======================================================
+// =======================================================
+template<int dim>
+template<class Update>
+void AMRForest<dim>::run_level(int tlevel, int tick, real_t dt, bool mhd_enabled,
+			       Update& update)
+{
+
+  fill_ghosts_level(tlevel, tick, mhd_enabled);
+
+  for (int l : m_local) {
+    Leaf& leaf = m_leaves[l];
+    if (leaf.tlevel != tlevel)
+      continue;
+    update(l, leaf.cur, dt);
+    leaf.cur = 1-leaf.cur;
+  }
+
+  if (tlevel+1 < m_used_time_levels) {
+    const int half = 1 << (m_time_levels-2-tlevel);
+    run_level(tlevel+1, tick,      dt/2, mhd_enabled, update);
+    run_level(tlevel+1, tick+half, dt/2, mhd_enabled, update);
+  }
+
+  reflux_level(tlevel);
+
+} // AMRForest::run_level
+
+// =======================================================
+// =======================================================
+template<int dim>
+real_t AMRForest<dim>::set_time_levels(const std::vector<real_t>& dtLeaf)
+{
+
+  std::vector<real_t> dtAll(size());
+
+#ifdef USE_MPI
+  std::vector<real_t> dtLocal(dtLeaf);
+  params.communicator->allReduce(dtLocal.data(), dtAll.data(), size(),
+				 params.data_type,
+				 hydroSimu::MpiComm::MIN);
+#else
+  dtAll = dtLeaf;
+#endif // USE_MPI
+
+  const real_t dtMin = *std::min_element(dtAll.begin(), dtAll.end());
+
+  // number of doublings of dtMin stable for each leaf
+  std::vector<int> steps(size());
+  for (int l=0; l<size(); ++l) {
+    int k = 0;
+    while (k+1 < m_time_levels && dtMin*(2 << k) <= dtAll[l])
+      ++k;
+    steps[l] = k;
+  }
+
+  // neighbors differ by one level at most, finer leaves do not have
+  // larger time steps
+  std::vector<int> next;
+
+  bool changed = true;
+  while (changed) {
+    changed = false;
+    for (int l=0; l<size(); ++l) {
+      touching(l, next);
+      for (int n : next) {
+	int kMax = steps[l]+1;
+	if (m_leaves[n].level > m_leaves[l].level)
+	  kMax = steps[l];
+	if (steps[n] > kMax) {
+	  steps[n] = kMax;
+	  changed = true;
+	}
+      }
+    }
+  }
+
+  const int kMax = *std::max_element(steps.begin(), steps.end());
+
+  // leaves with the largest time step are on time level 0
+  bool rebuild = false;
+  for (int l=0; l<size(); ++l) {
+    const int tlevel = kMax - steps[l];
+    rebuild = rebuild || tlevel != m_leaves[l].tlevel;
+    m_leaves[l].tlevel = tlevel;
+  }
+
+  m_used_time_levels = kMax+1;
+
+  if (rebuild)
+    build_plans();
+
+  return dtMin * (1 << kMax);
+
+} // AMRForest::set_time_levels
+
+// =======================================================
+// =======================================================
+template<int dim>
+bool AMRForest<dim>::regrid(int index, const std::vector<real_t>& indicator)
+{
+
+  const int gw = params.ghostWidth;
+  const int bs = m_bs;
+
+  /*
+   * refinement flags : +1 refine, -1 coarsen, 0 keep
+   */
+  std::vector<int> flagsLocal(size(), 0), flags(size(), 0);
+
+  for (int l : m_local) {
+    const int level = m_leaves[l].level;
+    if (indicator[l] > m_refine_threshold && level < m_level_max)
+      flagsLocal[l] = 1;
+    else if (indicator[l] < m_coarsen_threshold && level > 0)
+      flagsLocal[l] = -1;
+  }
+
+#ifdef USE_MPI
+  params.communicator->allReduce(flagsLocal.data(), flags.data(), size(),
+				 hydroSimu::MpiComm::INT,
+				 hydroSimu::MpiComm::SUM);
+#else
+  flags = flagsLocal;
+#endif // USE_MPI
+
+  balance(flags);
+
+  bool changed = false;
+  for (int f : flags)
+    changed = changed || f != 0;
+
+  if (!changed)
+    return false;
+
+  /*
+   * new leaves
+   */
+  std::vector<Leaf> leaves;
+
+  for (int l=0; l<size(); ++l) {
+
+    const Leaf& old = m_leaves[l];
+
+    // time levels are set again before the next step
+    Leaf leaf;
+    leaf.tlevel = 0;
+
+    if (flags[l] == 0) {
+
+      leaf.level = old.level;
+      leaf.pos = old.pos;
+      leaves.push_back(leaf);
+
+    } else if (flags[l] == 1) {
+
+      for (int e=0; e<nbChildren; ++e) {
+	leaf.level = old.level+1;
+	leaf.pos = child(old.pos, e);
+	leaves.push_back(leaf);
+      }
+
+    } else {
+
+      // the parent is created once, by its first child
+      bool first = true;
+      for (int d=0; d<dim; ++d)
+	first = first && old.pos[d] % 2 == 0;
+      if (!first)
+	continue;
+
+      leaf.level = old.level-1;
+      leaf.pos = old.pos;
+      for (int d=0; d<dim; ++d)
+	leaf.pos[d] /= 2;
+      leaves.push_back(leaf);
+
+    }
+
+  } // end for l
+
+  m_used_time_levels = 1;
+
+  std::vector<Leaf> oldLeaves;
+  oldLeaves.swap(m_leaves);
+  std::map<uint64_t,int> oldTree;
+  oldTree.swap(m_tree);
+
+  distribute(leaves);
+
+  /*
+   * where data of each new leaf comes from (old tree lookup) :
+   * - same leaf (0) : copy,
+   * - old parent (1) : prolongation,
+   * - old children (-1) : restriction, srcOf is then the first child
+   */
+  std::vector<int> srcOf(leaves.size()), flagOf(leaves.size());
+
+  for (int n=0; n<(int)leaves.size(); ++n) {
+
+    const Leaf& leaf = leaves[n];
+
+    auto it = oldTree.find(key(leaf.level, leaf.pos));
+
+    if (it != oldTree.end() && it->second >= 0) {
+      srcOf[n] = it->second;
+      flagOf[n] = 0;
+    } else if (it != oldTree.end()) {
+      srcOf[n] = oldTree[key(leaf.level+1, child(leaf.pos, 0))];
+      flagOf[n] = -1;
+    } else {
+      Kokkos::Array<int,3> p = leaf.pos;
+      for (int d=0; d<dim; ++d)
+	p[d] /= 2;
+      srcOf[n] = oldTree[key(leaf.level-1, p)];
+      flagOf[n] = 1;
+    }
+
+  }
+
+  /*
+   * allocate / move data of new local leaves, build transfer list
+   */
+  Plan plan;
+
+  for (int n=0; n<(int)leaves.size(); ++n) {
+
+    Leaf& leaf = leaves[n];
+    Leaf& old = oldLeaves[srcOf[n]];
+    const bool mine = leaf.owner == m_myRank;
+
+    if (flagOf[n] == 0 && mine && old.owner == m_myRank) {
+      // same leaf on the same process : data moved, no transfer
+      setup_leaf(leaf, false);
+      leaf.U[0] = old.U[0];
+      leaf.U[1] = old.U[1];
+      leaf.gravity = old.gravity;
+      continue;
+    }
+
+    if (mine)
+      setup_leaf(leaf, true);
+
+    Item item;
+    item.dst = n;
+    item.dstRank = leaf.owner;
+    item.face = -1;
+
+    if (flagOf[n] == 0) {
+
+      item.src = srcOf[n];
+      item.srcRank = old.owner;
+      item.tr.type = AMR_RESTRICT;
+      item.tr.ratio = 1;
+      for (int d=0; d<3; ++d) {
+	item.tr.lo[d] = d < dim ? gw : 0;
+	item.tr.n[d] = d < dim ? bs : 1;
+	item.tr.shift[d] = 0;
+      }
+      plan.items.push_back(item);
+
+    } else if (flagOf[n] == 1) {
+
+      // prolongation of the parent (its ghost cells are up to date)
+      item.src = srcOf[n];
+      item.srcRank = old.owner;
+      item.tr.type = AMR_PROLONG;
+      for (int d=0; d<3; ++d) {
+	const int ed = leaf.pos[d] % 2;
+	item.tr.lo[d] = d < dim ? gw : 0;
+	item.tr.n[d] = d < dim ? bs : 1;
+	item.tr.shift[d] = d < dim ? gw + ed*bs : 0;
+	item.tr.slopeMin[d] = 0;
+	item.tr.slopeMax[d] = bs+2*gw;
+      }
+      plan.items.push_back(item);
+
+    } else {
+
+      // restriction of each child into its quadrant / octant
+      for (int e=0; e<nbChildren; ++e) {
+	Item itemC = item;
+	itemC.src = oldTree[key(leaf.level+1, child(leaf.pos, e))];
+	itemC.srcRank = oldLeaves[itemC.src].owner;
+	itemC.tr.type = AMR_RESTRICT;
+	itemC.tr.ratio = 2;
+	for (int d=0; d<3; ++d) {
+	  const int ed = (e >> d) & 1;
+	  itemC.tr.lo[d] = d < dim ? gw + ed*bs/2 : 0;
+	  itemC.tr.n[d] = d < dim ? bs/2 : 1;
+	  itemC.tr.shift[d] = d < dim ? -gw - ed*bs : 0;
+	}
+	plan.items.push_back(itemC);
+      }
+
+    }
+
+  } // end for n
+
+  // only keep transfers involving the current process
+  plan.items.erase(std::remove_if(plan.items.begin(), plan.items.end(),
+				  [this](const Item& item) {
+				    return item.srcRank != m_myRank && item.dstRank != m_myRank;
+				  }),
+		   plan.items.end());
+
+  finalize_plan(plan);
+
+  m_leaves.swap(leaves);
+
+  exchange(plan,
+	   [&](const Item& item, DataArray data) {
+	     AMRPackFunctor<dimType>::apply(data, oldLeaves[item.src].U[index],
+					    item.tr, params.mdrange_tile);
+	   },
+	   [&](const Item& item, DataArray data) {
+	     AMRUnpackFunctor<dimType>::apply(m_leaves[item.dst].U[index],
+					      data, item.tr, params.mdrange_tile);
+	   });
+
+  build_plans();
+
+  return true;
+
+} // AMRForest::regrid
+
+// =======================================================
+// =======================================================
+template<int dim>
+void AMRForest<dim>::project(DataArray Udata, int index)
+{
+
+  const int gw = params.ghostWidth;
+  const int bs = m_bs;
+
+  // process sub-domains of the base grid
+  std::vector<Kokkos::Array<int,3>> offsets(m_nProcs), sizes(m_nProcs);
+
+  for (int r=0; r<m_nProcs; ++r) {
+#ifdef USE_MPI
+    int coords[3] = {0, 0, 0};
+    params.communicator->getCoords(r, dim, coords);
+    for (int d=0; d<3; ++d) {
+      offsets[r][d] = d < dim ? params.block_offset(d, coords[d]) : 0;
+      sizes[r][d]   = d < dim ? params.block_size(d, coords[d]) : 1;
+    }
+#else
+    offsets[r][IX] = 0;
+    offsets[r][IY] = 0;
+    offsets[r][IZ] = 0;
+    sizes[r][IX] = params.nx;
+    sizes[r][IY] = params.ny;
+    sizes[r][IZ] = dim==3 ? params.nz : 1;
+#endif // USE_MPI
+  }
+
+  Plan plan;
+
+  for (int l=0; l<size(); ++l) {
+
+    const Leaf& leaf = m_leaves[l];
+    const int ratio = 1 << leaf.level;
+
+    for (int r=0; r<m_nProcs; ++r) {
+
+      if (leaf.owner != m_myRank && r != m_myRank)
+	continue;
+
+      Item item;
+      item.src = l;
+      item.srcRank = leaf.owner;
+      item.dst = r;
+      item.dstRank = r;
+      item.face = -1;
+      item.tr.type = AMR_RESTRICT;
+      item.tr.ratio = ratio;
+
+      bool empty = false;
+      for (int d=0; d<3; ++d) {
+	if (d >= dim) {
+	  item.tr.lo[d] = 0;
+	  item.tr.n[d] = 1;
+	  item.tr.shift[d] = 0;
+	  continue;
+	}
+	// leaf extent in base cells
+	const int start = leaf.pos[d]*bs/ratio;
+	const int end   = start + bs/ratio;
+	const int lo = std::max(start, offsets[r][d]);
+	const int hi = std::min(end, offsets[r][d] + sizes[r][d]);
+	empty = empty || hi <= lo;
+	item.tr.lo[d] = lo - offsets[r][d] + gw;
+	item.tr.n[d] = hi - lo;
+	item.tr.shift[d] = ratio*(offsets[r][d] - gw) - leaf.pos[d]*bs + gw;
+      }
+
+      if (!empty)
+	plan.items.push_back(item);
+    }
+  }
+
+  finalize_plan(plan);
+
+  exchange(plan,
+	   [&](const Item& item, DataArray data) {
+	     AMRPackFunctor<dimType>::apply(data, m_leaves[item.src].U[index],
+					    item.tr, params.mdrange_tile);
+	   },
+	   [&](const Item& item, DataArray data) {
+	     AMRUnpackFunctor<dimType>::apply(Udata, data, item.tr,
+					      params.mdrange_tile);
+	   });
+
+} // AMRForest::project
+
+} // namespace ppkMHD
+
+#endif // AMR_FOREST_H_
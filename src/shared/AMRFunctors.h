@@ -0,0 +1,572 @@
+/**
+ * \file AMRFunctors.h
+ * \brief Data transfer kernels between the blocks of an AMR forest
+ * (copy, prolongation, restriction, flux correction).
+ */
+#ifndef AMR_FUNCTORS_H_
+#define AMR_FUNCTORS_H_
+
+#include "shared/kokkos_shared.h"
+#include "shared/enums.h"
+
+namespace ppkMHD {
+
+/**
+ * How the values of a destination box are computed from a source block.
+ */
+enum AMRTransferType {
+  AMR_RESTRICT, //!< average of ratio^dim source cells (ratio 1 is a copy)
+  AMR_PROLONG,  //!< limited piecewise linear interpolation of a coarser block
+  AMR_FLUX      //!< fine face fluxes summed over a coarse face (and
+                //!< accumulated over the fine time steps)
+};
+
+/**
+ * Geometry of a transfer : a box of destination cells, and the affine
+ * mapping from a destination cell index to the source cells
+ * (ghosts included on both sides).
+ *
+ * - AMR_RESTRICT : first source cell is ratio*i+shift.
+ * - AMR_PROLONG  : f = i+shift is the fine index measured from the
+ *                  source origin, source (coarse) cell is f/2, f%2 is
+ *                  the position inside that coarse cell.
+ * - AMR_FLUX     : source is a face flux array (one layer along dir),
+ *                  first source face along the other directions is
+ *                  ratio*i+shift (ratio 1 : neighbor of the same level
+ *                  with a smaller time step).
+ */
+struct AMRTransfer {
+
+  AMRTransferType type;
+
+  //! restriction ratio (AMR_RESTRICT, AMR_FLUX)
+  int ratio;
+
+  //! face normal (AMR_FLUX)
+  int dir;
+
+  //! first destination cell
+  Kokkos::Array<int,3> lo;
+
+  //! number of destination cells
+  Kokkos::Array<int,3> n;
+
+  //! source index shift
+  Kokkos::Array<int,3> shift;
+
+  //! source cells which may be used for slopes [slopeMin,slopeMax[ (AMR_PROLONG)
+  Kokkos::Array<int,3> slopeMin;
+  Kokkos::Array<int,3> slopeMax;
+
+  AMRTransfer() :
+    type(AMR_RESTRICT), ratio(1), dir(IX),
+    lo(), n(), shift(), slopeMin(), slopeMax() {}
+
+}; // struct AMRTransfer
+
+/*************************************************/
+/*************************************************/
+/*************************************************/
+/**
+ * Compute the values of a transfer box from a source block.
+ *
+ * box has the extents of the transfer (n), src is the source block
+ * state array (or face flux array for AMR_FLUX).
+ *
+ * When alpha < 1, the source block is ahead in time (local time
+ * stepping) : source values are interpolated between srcOld (beginning
+ * of its last step) and src (end of it).
+ *
+ * template parameters:
+ * @tparam dimType : triggers 2D or 3D specific treatment
+ */
+template<DimensionType dimType>
+class AMRPackFunctor {
+
+public:
+  //! data array type
+  using DataArray = typename std::conditional<dimType==TWO_D,DataArray2d,DataArray3d>::type;
+
+  static constexpr int dim = dimType==TWO_D ? 2 : 3;
+
+  AMRPackFunctor(DataArray box,
+		 DataArray src,
+		 DataArray srcOld,
+		 real_t alpha,
+		 AMRTransfer tr) :
+    box(box), src(src), srcOld(srcOld), alpha(alpha), tr(tr) {};
+
+  // static method which does it all: create and execute functor
+  static void apply(DataArray box,
+		    DataArray src,
+		    const AMRTransfer& tr,
+		    const Kokkos::Array<int,3>& tile)
+  {
+    AMRPackFunctor<dimType> functor(box, src, src, ONE_F, tr);
+    launch(functor, tr.n, tile);
+  }
+
+  //! source interpolated in time
+  static void apply(DataArray box,
+		    DataArray src,
+		    DataArray srcOld,
+		    real_t alpha,
+		    const AMRTransfer& tr,
+		    const Kokkos::Array<int,3>& tile)
+  {
+    AMRPackFunctor<dimType> functor(box, src, srcOld, alpha, tr);
+    launch(functor, tr.n, tile);
+  }
+
+  template<DimensionType dimType_ = dimType>
+  static void launch(const AMRPackFunctor<dimType>& functor,
+		     const Kokkos::Array<int,3>& n,
+		     const Kokkos::Array<int,3>& tile,
+		     typename std::enable_if<dimType_==TWO_D, int>::type = 0)
+  {
+    Kokkos::parallel_for("AMRPackFunctor 2d",
+			 md_policy_2d(0, 0, n[IX], n[IY], tile),
+			 functor);
+  }
+
+  template<DimensionType dimType_ = dimType>
+  static void launch(const AMRPackFunctor<dimType>& functor,
+		     const Kokkos::Array<int,3>& n,
+		     const Kokkos::Array<int,3>& tile,
+		     typename std::enable_if<dimType_==THREE_D, int>::type = 0)
+  {
+    Kokkos::parallel_for("AMRPackFunctor 3d",
+			 md_policy_3d(0, 0, 0, n[IX], n[IY], n[IZ], tile),
+			 functor);
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  real_t get(const DataArray2d& a, const int (&s)[3], int ivar) const
+  {
+    return a(s[IX], s[IY], ivar);
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  real_t get(const DataArray3d& a, const int (&s)[3], int ivar) const
+  {
+    return a(s[IX], s[IY], s[IZ], ivar);
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void set(const DataArray2d& a, const int (&b)[3], int ivar, real_t value) const
+  {
+    a(b[IX], b[IY], ivar) = value;
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void set(const DataArray3d& a, const int (&b)[3], int ivar, real_t value) const
+  {
+    a(b[IX], b[IY], b[IZ], ivar) = value;
+  }
+
+  //! source state value (at the destination time)
+  KOKKOS_INLINE_FUNCTION
+  real_t source_value(const int (&s)[3], int ivar) const
+  {
+    if (alpha < ONE_F)
+      return alpha * get(src, s, ivar) + (ONE_F-alpha) * get(srcOld, s, ivar);
+    return get(src, s, ivar);
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  static real_t minmod(real_t dl, real_t dr)
+  {
+    if (dl*dr <= ZERO_F)
+      return ZERO_F;
+    return FABS(dl) < FABS(dr) ? dl : dr;
+  }
+
+  //! average of ratio^dim source cells
+  KOKKOS_INLINE_FUNCTION
+  void restrict_cell(const int (&b)[3], int ivar, const int (&s0)[3], int r) const
+  {
+    real_t sum = ZERO_F;
+    int s[3] = {0, 0, 0};
+    for (int dk=0; dk<(dim==3 ? r : 1); ++dk)
+      for (int dj=0; dj<r; ++dj)
+	for (int di=0; di<r; ++di) {
+	  s[IX] = s0[IX]+di;
+	  s[IY] = s0[IY]+dj;
+	  s[IZ] = s0[IZ]+dk;
+	  sum += source_value(s, ivar);
+	}
+
+    real_t count = r*r;
+    if (dim==3)
+      count *= r;
+
+    set(box, b, ivar, sum/count);
+  }
+
+  //! coarse value plus limited slopes (conservative : the
+  //! 2^dim fine values average to the coarse one)
+  KOKKOS_INLINE_FUNCTION
+  void prolong_cell(const int (&b)[3], int ivar, const int (&f)[3]) const
+  {
+    int c[3] = {f[IX]/2, f[IY]/2, dim==3 ? f[IZ]/2 : 0};
+
+    const real_t uc = source_value(c, ivar);
+    real_t value = uc;
+
+    for (int d=0; d<dim; ++d) {
+
+      if (c[d]-1 < tr.slopeMin[d] || c[d]+1 >= tr.slopeMax[d])
+	continue;
+
+      int cm[3] = {c[IX], c[IY], c[IZ]};
+      int cp[3] = {c[IX], c[IY], c[IZ]};
+      cm[d] -= 1;
+      cp[d] += 1;
+
+      const real_t slope = minmod(uc - source_value(cm, ivar),
+				  source_value(cp, ivar) - uc);
+
+      value += (f[d]%2 == 0 ? -ONE_FOURTH_F : ONE_FOURTH_F) * slope;
+    }
+
+    set(box, b, ivar, value);
+  }
+
+  //! fine face fluxes (already scaled by the fine dt/dx) summed over
+  //! a coarse face : divided by ratio^(dim-1) faces, and by ratio for
+  //! dt/dx (flux layers of several time steps are already summed)
+  KOKKOS_INLINE_FUNCTION
+  void flux_cell(const int (&b)[3], int ivar, const int (&s0)[3]) const
+  {
+    const int r = tr.ratio;
+    real_t sum = ZERO_F;
+    int s[3] = {0, 0, 0};
+    for (int dk=0; dk<(dim==3 ? r : 1); ++dk)
+      for (int dj=0; dj<r; ++dj)
+	for (int di=0; di<r; ++di) {
+	  const int delta[3] = {di, dj, dk};
+	  bool skip = false;
+	  for (int d=0; d<3; ++d) {
+	    if (d == tr.dir)
+	      skip = skip || delta[d] != 0;
+	    s[d] = d == tr.dir ? 0 : s0[d]+delta[d];
+	  }
+	  if (!skip)
+	    sum += get(src, s, ivar);
+	}
+
+    real_t count = r*r;
+    if (dim==3)
+      count *= r;
+
+    set(box, b, ivar, sum/count);
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void compute(const int (&b)[3]) const
+  {
+    const int nbvar = src.extent(dim);
+
+    // destination cell
+    const int i[3] = {tr.lo[IX]+b[IX], tr.lo[IY]+b[IY], tr.lo[IZ]+b[IZ]};
+
+    if (tr.type == AMR_RESTRICT) {
+
+      const int s0[3] = {
+	tr.ratio*i[IX]+tr.shift[IX],
+	tr.ratio*i[IY]+tr.shift[IY],
+	dim==3 ? tr.ratio*i[IZ]+tr.shift[IZ] : 0};
+
+      for (int ivar=0; ivar<nbvar; ++ivar)
+	restrict_cell(b, ivar, s0, tr.ratio);
+
+    } else if (tr.type == AMR_PROLONG) {
+
+      const int f[3] = {
+	i[IX]+tr.shift[IX],
+	i[IY]+tr.shift[IY],
+	dim==3 ? i[IZ]+tr.shift[IZ] : 0};
+
+      for (int ivar=0; ivar<nbvar; ++ivar)
+	prolong_cell(b, ivar, f);
+
+    } else { // AMR_FLUX
+
+      const int s0[3] = {
+	tr.ratio*i[IX]+tr.shift[IX],
+	tr.ratio*i[IY]+tr.shift[IY],
+	dim==3 ? tr.ratio*i[IZ]+tr.shift[IZ] : 0};
+
+      for (int ivar=0; ivar<nbvar; ++ivar)
+	flux_cell(b, ivar, s0);
+
+    }
+
+  } // compute
+
+  template<DimensionType dimType_ = dimType>
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const typename std::enable_if<dimType_==TWO_D, int>::type& i,
+                  const int& j) const
+  {
+    const int b[3] = {i, j, 0};
+    compute(b);
+  }
+
+  template<DimensionType dimType_ = dimType>
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const typename std::enable_if<dimType_==THREE_D, int>::type& i,
+                  const int& j,
+                  const int& k) const
+  {
+    const int b[3] = {i, j, k};
+    compute(b);
+  }
+
+  DataArray   box;
+  DataArray   src;
+  DataArray   srcOld;
+  real_t      alpha;
+  AMRTransfer tr;
+
+}; // class AMRPackFunctor
+
+/*************************************************/
+/*************************************************/
+/*************************************************/
+/**
+ * Store a transfer box into the destination block.
+ *
+ * When faceFlux is allocated, the box holds fine fluxes (AMR_FLUX) and
+ * is used to correct the destination (coarse) cells next to face
+ * tr.dir / side : the coarse flux of faceFlux is replaced by the fine
+ * one.
+ *
+ * template parameters:
+ * @tparam dimType : triggers 2D or 3D specific treatment
+ */
+template<DimensionType dimType>
+class AMRUnpackFunctor {
+
+public:
+  //! data array type
+  using DataArray = typename std::conditional<dimType==TWO_D,DataArray2d,DataArray3d>::type;
+
+  static constexpr int dim = dimType==TWO_D ? 2 : 3;
+
+  AMRUnpackFunctor(DataArray dst,
+		   DataArray box,
+		   DataArray faceFlux,
+		   AMRTransfer tr,
+		   real_t sign) :
+    dst(dst), box(box), faceFlux(faceFlux), tr(tr), sign(sign) {};
+
+  //! copy box into dst
+  static void apply(DataArray dst,
+		    DataArray box,
+		    const AMRTransfer& tr,
+		    const Kokkos::Array<int,3>& tile)
+  {
+    AMRUnpackFunctor<dimType> functor(dst, box, DataArray(), tr, ZERO_F);
+    launch(functor, tr.n, tile);
+  }
+
+  //! flux correction of dst; side is 0 for a face at min, 1 at max
+  static void apply_flux(DataArray dst,
+			 DataArray box,
+			 DataArray faceFlux,
+			 const AMRTransfer& tr,
+			 int side,
+			 const Kokkos::Array<int,3>& tile)
+  {
+    AMRUnpackFunctor<dimType> functor(dst, box, faceFlux, tr,
+				      side == 0 ? -ONE_F : ONE_F);
+    launch(functor, tr.n, tile);
+  }
+
+  template<DimensionType dimType_ = dimType>
+  static void launch(const AMRUnpackFunctor<dimType>& functor,
+		     const Kokkos::Array<int,3>& n,
+		     const Kokkos::Array<int,3>& tile,
+		     typename std::enable_if<dimType_==TWO_D, int>::type = 0)
+  {
+    Kokkos::parallel_for("AMRUnpackFunctor 2d",
+			 md_policy_2d(0, 0, n[IX], n[IY], tile),
+			 functor);
+  }
+
+  template<DimensionType dimType_ = dimType>
+  static void launch(const AMRUnpackFunctor<dimType>& functor,
+		     const Kokkos::Array<int,3>& n,
+		     const Kokkos::Array<int,3>& tile,
+		     typename std::enable_if<dimType_==THREE_D, int>::type = 0)
+  {
+    Kokkos::parallel_for("AMRUnpackFunctor 3d",
+			 md_policy_3d(0, 0, 0, n[IX], n[IY], n[IZ], tile),
+			 functor);
+  }
+
+  template<DimensionType dimType_ = dimType>
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const typename std::enable_if<dimType_==TWO_D, int>::type& i,
+                  const int& j) const
+  {
+    const int nbvar = box.extent(2);
+
+    const int id = tr.lo[IX]+i;
+    const int jd = tr.lo[IY]+j;
+
+    if (sign == ZERO_F) {
+      for (int ivar=0; ivar<nbvar; ++ivar)
+	dst(id,jd,ivar) = box(i,j,ivar);
+    } else {
+      const int iF = tr.dir == IX ? 0 : id;
+      const int jF = tr.dir == IY ? 0 : jd;
+      for (int ivar=0; ivar<nbvar; ++ivar)
+	dst(id,jd,ivar) += sign * (faceFlux(iF,jF,ivar) - box(i,j,ivar));
+    }
+  }
+
+  template<DimensionType dimType_ = dimType>
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const typename std::enable_if<dimType_==THREE_D, int>::type& i,
+                  const int& j,
+                  const int& k) const
+  {
+    const int nbvar = box.extent(3);
+
+    const int id = tr.lo[IX]+i;
+    const int jd = tr.lo[IY]+j;
+    const int kd = tr.lo[IZ]+k;
+
+    if (sign == ZERO_F) {
+      for (int ivar=0; ivar<nbvar; ++ivar)
+	dst(id,jd,kd,ivar) = box(i,j,k,ivar);
+    } else {
+      const int iF = tr.dir == IX ? 0 : id;
+      const int jF = tr.dir == IY ? 0 : jd;
+      const int kF = tr.dir == IZ ? 0 : kd;
+      for (int ivar=0; ivar<nbvar; ++ivar)
+	dst(id,jd,kd,ivar) += sign * (faceFlux(iF,jF,kF,ivar) - box(i,j,k,ivar));
+    }
+  }
+
+  DataArray   dst;
+  DataArray   box;
+  DataArray   faceFlux;
+  AMRTransfer tr;
+  real_t      sign;
+
+}; // class AMRUnpackFunctor
+
+/*************************************************/
+/*************************************************/
+/*************************************************/
+/**
+ * Save one layer of a face flux array (fluxes computed by an update,
+ * layer along dir) into faceFlux; with accumulate, fluxes are summed
+ * over the time steps of a leaf until the flux correction of its
+ * neighbor.
+ *
+ * template parameters:
+ * @tparam dimType : triggers 2D or 3D specific treatment
+ */
+template<DimensionType dimType>
+class AMRSaveFluxFunctor {
+
+public:
+  //! data array type
+  using DataArray = typename std::conditional<dimType==TWO_D,DataArray2d,DataArray3d>::type;
+
+  static constexpr int dim = dimType==TWO_D ? 2 : 3;
+
+  AMRSaveFluxFunctor(DataArray faceFlux,
+		     DataArray flux,
+		     int dir,
+		     int layer,
+		     bool accumulate) :
+    faceFlux(faceFlux), flux(flux), dir(dir), layer(layer),
+    accumulate(accumulate) {};
+
+  // static method which does it all: create and execute functor
+  static void apply(DataArray faceFlux,
+		    DataArray flux,
+		    int dir,
+		    int layer,
+		    bool accumulate,
+		    const Kokkos::Array<int,3>& tile)
+  {
+    AMRSaveFluxFunctor<dimType> functor(faceFlux, flux, dir, layer, accumulate);
+
+    Kokkos::Array<int,3> n;
+    for (int d=0; d<3; ++d)
+      n[d] = d < dim ? faceFlux.extent(d) : 1;
+
+    launch(functor, n, tile);
+  }
+
+  template<DimensionType dimType_ = dimType>
+  static void launch(const AMRSaveFluxFunctor<dimType>& functor,
+		     const Kokkos::Array<int,3>& n,
+		     const Kokkos::Array<int,3>& tile,
+		     typename std::enable_if<dimType_==TWO_D, int>::type = 0)
+  {
+    Kokkos::parallel_for("AMRSaveFluxFunctor 2d",
+			 md_policy_2d(0, 0, n[IX], n[IY], tile),
+			 functor);
+  }
+
+  template<DimensionType dimType_ = dimType>
+  static void launch(const AMRSaveFluxFunctor<dimType>& functor,
+		     const Kokkos::Array<int,3>& n,
+		     const Kokkos::Array<int,3>& tile,
+		     typename std::enable_if<dimType_==THREE_D, int>::type = 0)
+  {
+    Kokkos::parallel_for("AMRSaveFluxFunctor 3d",
+			 md_policy_3d(0, 0, 0, n[IX], n[IY], n[IZ], tile),
+			 functor);
+  }
+
+  template<DimensionType dimType_ = dimType>
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const typename std::enable_if<dimType_==TWO_D, int>::type& i,
+                  const int& j) const
+  {
+    const int nbvar = faceFlux.extent(2);
+
+    const int iS = dir == IX ? layer : i;
+    const int jS = dir == IY ? layer : j;
+
+    for (int ivar=0; ivar<nbvar; ++ivar)
+      faceFlux(i,j,ivar) = accumulate ?
+	faceFlux(i,j,ivar) + flux(iS,jS,ivar) : flux(iS,jS,ivar);
+  }
+
+  template<DimensionType dimType_ = dimType>
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const typename std::enable_if<dimType_==THREE_D, int>::type& i,
+                  const int& j,
+                  const int& k) const
+  {
+    const int nbvar = faceFlux.extent(3);
+
+    const int iS = dir == IX ? layer : i;
+    const int jS = dir == IY ? layer : j;
+    const int kS = dir == IZ ? layer : k;
+
+    for (int ivar=0; ivar<nbvar; ++ivar)
+      faceFlux(i,j,k,ivar) = accumulate ?
+	faceFlux(i,j,k,ivar) + flux(iS,jS,kS,ivar) : flux(iS,jS,kS,ivar);
+  }
+
+  DataArray faceFlux;
+  DataArray flux;
+  int       dir;
+  int       layer;
+  bool      accumulate;
+
+}; // class AMRSaveFluxFunctor
+
+} // namespace ppkMHD
+
+#endif // AMR_FUNCTORS_H_
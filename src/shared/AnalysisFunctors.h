@@ -0,0 +1,586 @@
+#ifndef ANALYSIS_FUNCTORS_H_
+#define ANALYSIS_FUNCTORS_H_
+
+#include "shared/kokkos_shared.h"
+#include "shared/HydroParams.h"
+#include "shared/enums.h"
+
+namespace ppkMHD {
+
+/**
+ * Global integrals computed by the in-situ analysis (local to a MPI
+ * process before reduction). Accumulation is done in double precision.
+ */
+struct AnalysisIntegrals {
+
+  double mass;      //!< integral of density
+  double energy;    //!< integral of total energy
+  double ekin;      //!< integral of kinetic energy
+  double enstrophy; //!< integral of 0.5 |curl v|^2
+  double emag;      //!< integral of magnetic energy (MHD only)
+  double divb_l1;   //!< integral of |div B| (MHD only)
+  double divb_max;  //!< maximum of |div B| (MHD only)
+
+}; // struct AnalysisIntegrals
+
+/*************************************************/
+/*************************************************/
+/*************************************************/
+/**
+ * Compute global integrals over the interior cells.
+ *
+ * Ghost cells must be up to date (centered differences for the vorticity,
+ * face-centered magnetic field on the right faces).
+ *
+ * \tparam dimType : triggers 2D or 3D specific treatment
+ */
+template<DimensionType dimType>
+class AnalysisIntegralsFunctor {
+
+public:
+  //! data array type
+  using DataArray = typename std::conditional<dimType==TWO_D,DataArray2d,DataArray3d>::type;
+
+  typedef AnalysisIntegrals value_type;
+
+  AnalysisIntegralsFunctor(HydroParams params,
+			   DataArray Udata,
+			   bool mhd_enabled) :
+    params(params), Udata(Udata), mhd_enabled(mhd_enabled) {};
+
+  // static method which does it all: create and execute functor
+  static void apply(HydroParams params,
+		    DataArray Udata,
+		    bool mhd_enabled,
+		    AnalysisIntegrals& result)
+  {
+    AnalysisIntegralsFunctor<dimType> functor(params, Udata, mhd_enabled);
+    launch(functor, params, result);
+  }
+
+  template<DimensionType dimType_ = dimType>
+  static void launch(const AnalysisIntegralsFunctor<dimType>& functor,
+		     const HydroParams& params,
+		     AnalysisIntegrals& result,
+		     typename std::enable_if<dimType_==TWO_D, int>::type = 0)
+  {
+    const int gw = params.ghostWidth;
+    Kokkos::parallel_reduce("AnalysisIntegralsFunctor 2d",
+			    md_policy_2d(gw, gw,
+					 params.isize-gw, params.jsize-gw,
+					 params.mdrange_tile),
+			    functor, result);
+  }
+
+  template<DimensionType dimType_ = dimType>
+  static void launch(const AnalysisIntegralsFunctor<dimType>& functor,
+		     const HydroParams& params,
+		     AnalysisIntegrals& result,
+		     typename std::enable_if<dimType_==THREE_D, int>::type = 0)
+  {
+    const int gw = params.ghostWidth;
+    Kokkos::parallel_reduce("AnalysisIntegralsFunctor 3d",
+			    md_policy_3d(gw, gw, gw,
+					 params.isize-gw, params.jsize-gw, params.ksize-gw,
+					 params.mdrange_tile),
+			    functor, result);
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void init(AnalysisIntegrals& dst) const
+  {
+    dst.mass = dst.energy = dst.ekin = dst.enstrophy = 0;
+    dst.emag = dst.divb_l1 = dst.divb_max = 0;
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void join(volatile AnalysisIntegrals& dst,
+	    const volatile AnalysisIntegrals& src) const
+  {
+    dst.mass      += src.mass;
+    dst.energy    += src.energy;
+    dst.ekin      += src.ekin;
+    dst.enstrophy += src.enstrophy;
+    dst.emag      += src.emag;
+    dst.divb_l1   += src.divb_l1;
+    if (dst.divb_max < src.divb_max)
+      dst.divb_max = src.divb_max;
+  }
+
+  //! velocity component c (0,1,2) in cell (i,j)
+  KOKKOS_INLINE_FUNCTION
+  double velocity(int i, int j, int c) const
+  {
+    return Udata(i,j,IU+c) / Udata(i,j,ID);
+  }
+
+  //! velocity component c (0,1,2) in cell (i,j,k)
+  KOKKOS_INLINE_FUNCTION
+  double velocity(int i, int j, int k, int c) const
+  {
+    return Udata(i,j,k,IU+c) / Udata(i,j,k,ID);
+  }
+
+  template<DimensionType dimType_ = dimType>
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const typename std::enable_if<dimType_==TWO_D, int>::type& i,
+		  const int& j,
+		  AnalysisIntegrals& sum) const
+  {
+    const double dx = params.dx;
+    const double dy = params.dy;
+    const double dV = dx*dy;
+
+    const double rho = Udata(i,j,ID);
+    const double mx  = Udata(i,j,IU);
+    const double my  = Udata(i,j,IV);
+
+    sum.mass   += rho*dV;
+    sum.energy += Udata(i,j,IE)*dV;
+    sum.ekin   += 0.5*(mx*mx+my*my)/rho*dV;
+
+    const double wz =
+      (velocity(i+1,j,1)-velocity(i-1,j,1))/(2*dx) -
+      (velocity(i,j+1,0)-velocity(i,j-1,0))/(2*dy);
+    sum.enstrophy += 0.5*wz*wz*dV;
+
+    if (mhd_enabled) {
+      const double bx = 0.5*(Udata(i,j,IA)+Udata(i+1,j  ,IA));
+      const double by = 0.5*(Udata(i,j,IB)+Udata(i  ,j+1,IB));
+      const double bz = Udata(i,j,IC);
+      sum.emag += 0.5*(bx*bx+by*by+bz*bz)*dV;
+
+      const double divb = FABS((Udata(i+1,j,IA)-Udata(i,j,IA))/dx +
+			       (Udata(i,j+1,IB)-Udata(i,j,IB))/dy);
+      sum.divb_l1 += divb*dV;
+      if (sum.divb_max < divb)
+	sum.divb_max = divb;
+    }
+
+  } // operator () - 2d
+
+  template<DimensionType dimType_ = dimType>
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const typename std::enable_if<dimType_==THREE_D, int>::type& i,
+		  const int& j,
+		  const int& k,
+		  AnalysisIntegrals& sum) const
+  {
+    const double dx = params.dx;
+    const double dy = params.dy;
+    const double dz = params.dz;
+    const double dV = dx*dy*dz;
+
+    const double rho = Udata(i,j,k,ID);
+    const double mx  = Udata(i,j,k,IU);
+    const double my  = Udata(i,j,k,IV);
+    const double mz  = Udata(i,j,k,IW);
+
+    sum.mass   += rho*dV;
+    sum.energy += Udata(i,j,k,IE)*dV;
+    sum.ekin   += 0.5*(mx*mx+my*my+mz*mz)/rho*dV;
+
+    const double wx =
+      (velocity(i,j+1,k,2)-velocity(i,j-1,k,2))/(2*dy) -
+      (velocity(i,j,k+1,1)-velocity(i,j,k-1,1))/(2*dz);
+    const double wy =
+      (velocity(i,j,k+1,0)-velocity(i,j,k-1,0))/(2*dz) -
+      (velocity(i+1,j,k,2)-velocity(i-1,j,k,2))/(2*dx);
+    const double wz =
+      (velocity(i+1,j,k,1)-velocity(i-1,j,k,1))/(2*dx) -
+      (velocity(i,j+1,k,0)-velocity(i,j-1,k,0))/(2*dy);
+    sum.enstrophy += 0.5*(wx*wx+wy*wy+wz*wz)*dV;
+
+    if (mhd_enabled) {
+      const double bx = 0.5*(Udata(i,j,k,IA)+Udata(i+1,j  ,k  ,IA));
+      const double by = 0.5*(Udata(i,j,k,IB)+Udata(i  ,j+1,k  ,IB));
+      const double bz = 0.5*(Udata(i,j,k,IC)+Udata(i  ,j  ,k+1,IC));
+      sum.emag += 0.5*(bx*bx+by*by+bz*bz)*dV;
+
+      const double divb = FABS((Udata(i+1,j,k,IA)-Udata(i,j,k,IA))/dx +
+			       (Udata(i,j+1,k,IB)-Udata(i,j,k,IB))/dy +
+			       (Udata(i,j,k+1,IC)-Udata(i,j,k,IC))/dz);
+      sum.divb_l1 += divb*dV;
+      if (sum.divb_max < divb)
+	sum.divb_max = divb;
+    }
+
+  } // operator () - 3d
+
+  HydroParams params;
+  DataArray   Udata;
+  bool        mhd_enabled;
+
+}; // class AnalysisIntegralsFunctor
+
+/*************************************************/
+/*************************************************/
+/*************************************************/
+/**
+ * Histogram of one variable over the interior cells (cell count per bin).
+ *
+ * hist has nbins+2 entries : bins, then number of cells below and above
+ * the histogram range.
+ *
+ * \tparam dimType : triggers 2D or 3D specific treatment
+ */
+template<DimensionType dimType>
+class AnalysisHistogramFunctor {
+
+public:
+  //! data array type
+  using DataArray = typename std::conditional<dimType==TWO_D,DataArray2d,DataArray3d>::type;
+
+  AnalysisHistogramFunctor(DataArray Udata,
+			   Kokkos::View<double*, Device> hist,
+			   int iVar,
+			   double vmin,
+			   double vmax,
+			   bool log_scale) :
+    Udata(Udata), hist(hist), iVar(iVar),
+    vmin(vmin), vmax(vmax), log_scale(log_scale),
+    nbins(hist.extent(0)-2) {};
+
+  // static method which does it all: create and execute functor
+  static void apply(HydroParams params,
+		    DataArray Udata,
+		    Kokkos::View<double*, Device> hist,
+		    int iVar,
+		    double vmin,
+		    double vmax,
+		    bool log_scale)
+  {
+    AnalysisHistogramFunctor<dimType> functor(Udata, hist, iVar,
+					      vmin, vmax, log_scale);
+    launch(functor, params);
+  }
+
+  template<DimensionType dimType_ = dimType>
+  static void launch(const AnalysisHistogramFunctor<dimType>& functor,
+		     const HydroParams& params,
+		     typename std::enable_if<dimType_==TWO_D, int>::type = 0)
+  {
+    const int gw = params.ghostWidth;
+    Kokkos::parallel_for("AnalysisHistogramFunctor 2d",
+			 md_policy_2d(gw, gw,
+				      params.isize-gw, params.jsize-gw,
+				      params.mdrange_tile),
+			 functor);
+  }
+
+  template<DimensionType dimType_ = dimType>
+  static void launch(const AnalysisHistogramFunctor<dimType>& functor,
+		     const HydroParams& params,
+		     typename std::enable_if<dimType_==THREE_D, int>::type = 0)
+  {
+    const int gw = params.ghostWidth;
+    Kokkos::parallel_for("AnalysisHistogramFunctor 3d",
+			 md_policy_3d(gw, gw, gw,
+				      params.isize-gw, params.jsize-gw, params.ksize-gw,
+				      params.mdrange_tile),
+			 functor);
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void add(double value) const
+  {
+    if (log_scale)
+      value = value > 0 ? log10(value) : vmin - 1;
+
+    int bin;
+    if (value < vmin)
+      bin = nbins;
+    else if (value >= vmax)
+      bin = nbins+1;
+    else
+      bin = (int) ((value-vmin)/(vmax-vmin)*nbins);
+
+    Kokkos::atomic_add(&hist(bin < nbins+2 ? bin : nbins+1), 1.0);
+  }
+
+  template<DimensionType dimType_ = dimType>
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const typename std::enable_if<dimType_==TWO_D, int>::type& i,
+		  const int& j) const
+  {
+    add(Udata(i,j,iVar));
+  }
+
+  template<DimensionType dimType_ = dimType>
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const typename std::enable_if<dimType_==THREE_D, int>::type& i,
+		  const int& j,
+		  const int& k) const
+  {
+    add(Udata(i,j,k,iVar));
+  }
+
+  DataArray Udata;
+  Kokkos::View<double*, Device> hist;
+  int    iVar;
+  double vmin, vmax;
+  bool   log_scale;
+  int    nbins;
+
+}; // class AnalysisHistogramFunctor
+
+/*************************************************/
+/*************************************************/
+/*************************************************/
+/**
+ * Volume weighted profiles of all variables, either along a cartesian
+ * axis (one bin per global cell index, averaged over the transverse
+ * planes) or radial (spherical / circular shells around a center).
+ *
+ * prof(bin, iVar) accumulates U*dV, prof(bin, nbvar) the volume.
+ *
+ * \tparam dimType : triggers 2D or 3D specific treatment
+ */
+template<DimensionType dimType>
+class AnalysisProfileFunctor {
+
+public:
+  //! data array type
+  using DataArray = typename std::conditional<dimType==TWO_D,DataArray2d,DataArray3d>::type;
+
+  //! axis value for radial profiles
+  static constexpr int RADIAL = 3;
+
+  AnalysisProfileFunctor(HydroParams params,
+			 DataArray Udata,
+			 Kokkos::View<double**, Device> prof,
+			 int axis,
+			 Kokkos::Array<double,3> center,
+			 double rmax) :
+    params(params), Udata(Udata), prof(prof), axis(axis),
+    center(center), rmax(rmax) {};
+
+  // static method which does it all: create and execute functor
+  static void apply(HydroParams params,
+		    DataArray Udata,
+		    Kokkos::View<double**, Device> prof,
+		    int axis,
+		    Kokkos::Array<double,3> center,
+		    double rmax)
+  {
+    AnalysisProfileFunctor<dimType> functor(params, Udata, prof, axis,
+					    center, rmax);
+    launch(functor, params);
+  }
+
+  template<DimensionType dimType_ = dimType>
+  static void launch(const AnalysisProfileFunctor<dimType>& functor,
+		     const HydroParams& params,
+		     typename std::enable_if<dimType_==TWO_D, int>::type = 0)
+  {
+    const int gw = params.ghostWidth;
+    Kokkos::parallel_for("AnalysisProfileFunctor 2d",
+			 md_policy_2d(gw, gw,
+				      params.isize-gw, params.jsize-gw,
+				      params.mdrange_tile),
+			 functor);
+  }
+
+  template<DimensionType dimType_ = dimType>
+  static void launch(const AnalysisProfileFunctor<dimType>& functor,
+		     const HydroParams& params,
+		     typename std::enable_if<dimType_==THREE_D, int>::type = 0)
+  {
+    const int gw = params.ghostWidth;
+    Kokkos::parallel_for("AnalysisProfileFunctor 3d",
+			 md_policy_3d(gw, gw, gw,
+				      params.isize-gw, params.jsize-gw, params.ksize-gw,
+				      params.mdrange_tile),
+			 functor);
+  }
+
+  //! profile bin of a cell (global cell index g), -1 if outside
+  KOKKOS_INLINE_FUNCTION
+  int bin(const int g[3]) const
+  {
+    const int nbins = prof.extent(0);
+
+    if (axis != RADIAL)
+      return g[axis];
+
+    const double d[3] = {params.dx, params.dy, params.dz};
+    const double xmin[3] = {params.xmin, params.ymin, params.zmin};
+    const int dim = dimType==TWO_D ? 2 : 3;
+
+    double r2 = 0;
+    for (int dir=0; dir<dim; ++dir) {
+      const double x = xmin[dir] + (g[dir]+0.5)*d[dir] - center[dir];
+      r2 += x*x;
+    }
+
+    const int b = (int) (sqrt(r2)/rmax*nbins);
+    return b < nbins ? b : -1;
+  }
+
+  template<DimensionType dimType_ = dimType>
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const typename std::enable_if<dimType_==TWO_D, int>::type& i,
+		  const int& j) const
+  {
+    const int gw = params.ghostWidth;
+    const int nbvar = Udata.extent(2);
+    const int g[3] = {i-gw+params.myOffset[IX], j-gw+params.myOffset[IY], 0};
+    const double dV = params.dx*params.dy;
+
+    const int b = bin(g);
+    if (b < 0)
+      return;
+
+    for (int iVar=0; iVar<nbvar; ++iVar)
+      Kokkos::atomic_add(&prof(b,iVar), Udata(i,j,iVar)*dV);
+    Kokkos::atomic_add(&prof(b,nbvar), dV);
+  }
+
+  template<DimensionType dimType_ = dimType>
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const typename std::enable_if<dimType_==THREE_D, int>::type& i,
+		  const int& j,
+		  const int& k) const
+  {
+    const int gw = params.ghostWidth;
+    const int nbvar = Udata.extent(3);
+    const int g[3] = {i-gw+params.myOffset[IX],
+		      j-gw+params.myOffset[IY],
+		      k-gw+params.myOffset[IZ]};
+    const double dV = params.dx*params.dy*params.dz;
+
+    const int b = bin(g);
+    if (b < 0)
+      return;
+
+    for (int iVar=0; iVar<nbvar; ++iVar)
+      Kokkos::atomic_add(&prof(b,iVar), Udata(i,j,k,iVar)*dV);
+    Kokkos::atomic_add(&prof(b,nbvar), dV);
+  }
+
+  HydroParams params;
+  DataArray   Udata;
+  Kokkos::View<double**, Device> prof;
+  int         axis;
+  Kokkos::Array<double,3> center;
+  double      rmax;
+
+}; // class AnalysisProfileFunctor
+
+/*************************************************/
+/*************************************************/
+/*************************************************/
+/**
+ * Partial Fourier coefficients of the velocity along one axis.
+ *
+ * For each local line along axis dir (indexed by the transverse interior
+ * cell coordinates, first one fastest) and each wavenumber k < kmax,
+ * coef(line*kmax+k, 2*c+{0,1}) receives the real / imaginary part of
+ * sum_n v_c(n) exp(-2 i pi k n / N), n running over the interior cells of
+ * the line in the local sub-domain (global index, N = nGlobal). The sum
+ * over processes sharing a line gives the discrete Fourier transform.
+ *
+ * \tparam dimType : triggers 2D or 3D specific treatment
+ */
+template<DimensionType dimType>
+class AnalysisSpectrumFunctor {
+
+public:
+  //! data array type
+  using DataArray = typename std::conditional<dimType==TWO_D,DataArray2d,DataArray3d>::type;
+
+  static constexpr int dim = dimType==TWO_D ? 2 : 3;
+
+  AnalysisSpectrumFunctor(HydroParams params,
+			  DataArray Udata,
+			  Kokkos::View<double**, Device> coef,
+			  int dir,
+			  int nGlobal,
+			  int kmax) :
+    params(params), Udata(Udata), coef(coef), dir(dir),
+    nGlobal(nGlobal), kmax(kmax) {};
+
+  // static method which does it all: create and execute functor
+  static void apply(HydroParams params,
+		    DataArray Udata,
+		    Kokkos::View<double**, Device> coef,
+		    int dir,
+		    int nGlobal,
+		    int kmax)
+  {
+    AnalysisSpectrumFunctor<dimType> functor(params, Udata, coef, dir,
+					     nGlobal, kmax);
+    Kokkos::parallel_for("AnalysisSpectrumFunctor",
+			 Kokkos::RangePolicy<Device>(0, coef.extent(0)),
+			 functor);
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  double value(const int ijk[3], int c) const
+  {
+    if (dimType == TWO_D)
+      return Udata(ijk[IX],ijk[IY],IU+c) / Udata(ijk[IX],ijk[IY],ID);
+    else
+      return Udata(ijk[IX],ijk[IY],ijk[IZ],IU+c) / Udata(ijk[IX],ijk[IY],ijk[IZ],ID);
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const int& index) const
+  {
+    const int gw = params.ghostWidth;
+    const int n[3] = {params.nx, params.ny, params.nz};
+
+    const int k    = index % kmax;
+    const int line = index / kmax;
+
+    // transverse directions
+    const int d1 = (dir+1) % dim;
+    const int d2 = (dir+2) % dim;
+
+    int ijk[3] = {gw, gw, gw};
+    if (dim == 2) {
+      ijk[d1] += line;
+    } else {
+      const int t1 = d1 < d2 ? d1 : d2;
+      const int t2 = d1 < d2 ? d2 : d1;
+      ijk[t1] += line % n[t1];
+      ijk[t2] += line / n[t1];
+    }
+
+    const int    offset = params.myOffset[dir];
+    const double N      = nGlobal;
+    const double twopi  = 2*M_PI;
+
+    double re[3] = {0, 0, 0};
+    double im[3] = {0, 0, 0};
+
+    for (int m=0; m<n[dir]; ++m) {
+      ijk[dir] = gw + m;
+      const double phase = -twopi * k * (m+offset) / N;
+      const double cs = cos(phase);
+      const double sn = sin(phase);
+      for (int c=0; c<dim; ++c) {
+	const double v = value(ijk, c);
+	re[c] += v*cs;
+	im[c] += v*sn;
+      }
+    }
+
+    for (int c=0; c<dim; ++c) {
+      coef(index, 2*c  ) = re[c];
+      coef(index, 2*c+1) = im[c];
+    }
+  }
+
+  HydroParams params;
+  DataArray   Udata;
+  Kokkos::View<double**, Device> coef;
+  int         dir;
+  int         nGlobal;
+  int         kmax;
+
+}; // class AnalysisSpectrumFunctor
+
+} // namespace ppkMHD
+
+#endif // ANALYSIS_FUNCTORS_H_
@@ -0,0 +1,443 @@
+#include "shared/Autotuner.h"
+
+#include <cstdio>
+#include <cstdlib> // for exit
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <limits>
+
+#include "shared/kokkos_shared.h"
+#include "shared/HydroParams.h"
+#include "shared/SolverBase.h"
+#include "shared/SolverFactory.h"
+
+#ifdef USE_MPI
+#include <mpi.h>
+#endif // USE_MPI
+
+namespace ppkMHD {
+
+// =======================================================
+// =======================================================
+static int world_rank()
+{
+
+  int rank = 0;
+#ifdef USE_MPI
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+#endif // USE_MPI
+  return rank;
+
+} // world_rank
+
+// =======================================================
+// =======================================================
+/*
+ * Settings selecting the scheme (part of the key, a cached choice is
+ * only valid for the same scheme).
+ */
+static const char* scheme_settings[] = {
+  "OTHER.implementationVersion",
+  "hydro.riemann",
+  "hydro.iorder",
+  "sdm.limiter_enabled",
+  "amr.enabled"
+};
+
+/*
+ * Settings changing results which may be tuned : when set in the
+ * parameter file, they are neither tuned nor taken from the cache.
+ */
+static const char* numerics_settings[] = {
+  "OTHER.implementationVersion",
+  "sdm.interpolation_version"
+};
+
+// =======================================================
+// =======================================================
+static int world_size()
+{
+
+  int size = 1;
+#ifdef USE_MPI
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+#endif // USE_MPI
+  return size;
+
+} // world_size
+
+// =======================================================
+// =======================================================
+Autotuner::Autotuner(ConfigMap& configMap) :
+  configMap(configMap),
+  m_key(),
+  m_cache_file(configMap.getString("autotune", "cache_file", "ppkMHD_autotune.cache")),
+  m_steps(configMap.getInteger("autotune", "steps", 5))
+{
+
+  if (m_steps < 1)
+    m_steps = 1;
+
+  // actual local sizes (mesh sizes are global ones with automatic
+  // domain decomposition), the same on all processes
+  HydroParams params;
+  params.setup(configMap);
+  int n[3] = {params.nx, params.ny, params.nz};
+#ifdef USE_MPI
+  for (int dir=0; dir<3; ++dir)
+    n[dir] = params.block_size_max(dir);
+#endif // USE_MPI
+
+  std::ostringstream key;
+  key << configMap.getString("run", "solver_name", "unknown");
+  for (const char* setting : scheme_settings)
+    key << " " << setting << "=" << value(setting);
+  key << " " << n[IX] << " " << n[IY] << " " << n[IZ]
+      << " ranks=" << world_size() << " "
+      << Kokkos::DefaultExecutionSpace::name() << " "
+      << Kokkos::DefaultExecutionSpace().concurrency();
+  m_key = key.str();
+
+} // Autotuner::Autotuner
+
+// =======================================================
+// =======================================================
+void Autotuner::apply()
+{
+
+  const int rank = world_rank();
+
+  const std::vector<std::vector<Overrides> > groups = candidates();
+
+  if (groups.empty()) {
+    if (rank==0)
+      std::cout << "Autotune : nothing to tune for " << m_key << "\n";
+    return;
+  }
+
+  Overrides choice;
+
+  if (load(choice)) {
+
+    if (rank==0)
+      std::cout << "Autotune : cached choice for " << m_key << "\n";
+
+    // settings of the parameter file changing results always win
+    Overrides allowed;
+    for (const auto& kv : choice) {
+      if (user_numerics(kv.first)) {
+	if (rank==0)
+	  std::cout << "Autotune : ignoring cached " << kv.first << "=" << kv.second
+		    << ", set in parameter file\n";
+      } else {
+	allowed.push_back(kv);
+      }
+    }
+    choice = allowed;
+
+  } else {
+
+    if (rank==0)
+      std::cout << "Autotune : timing candidates for " << m_key << "\n";
+
+    for (const auto& group : groups) {
+
+      double best = std::numeric_limits<double>::max();
+      Overrides bestCandidate = group[0];
+
+      for (const auto& candidate : group) {
+
+	Overrides overrides = choice;
+	overrides.insert(overrides.end(), candidate.begin(), candidate.end());
+
+	const double t = time_candidate(overrides);
+
+	if (rank==0)
+	  printf("Autotune : %-50s %12.6g s/step\n", to_string(candidate).c_str(), t);
+
+	if (t < best) {
+	  best = t;
+	  bestCandidate = candidate;
+	}
+
+      }
+
+      choice.insert(choice.end(), bestCandidate.begin(), bestCandidate.end());
+
+    } // end for group
+
+    store(choice);
+
+  }
+
+  set(configMap, choice);
+
+  if (rank==0)
+    std::cout << "Autotune : using " << to_string(choice) << "\n";
+
+} // Autotuner::apply
+
+// =======================================================
+// =======================================================
+std::vector<std::vector<Autotuner::Overrides> > Autotuner::candidates() const
+{
+
+  std::vector<std::vector<Overrides> > groups;
+
+  const std::string solver_name = configMap.getString("run", "solver_name", "unknown");
+  const bool threeD = solver_name.find("3D") != std::string::npos;
+
+  if (solver_name.find("Muscl") != std::string::npos) {
+
+    std::vector<Overrides> group;
+
+    // implementation variants only exist for the hydro solver (the MHD
+    // solver silently skips the scheme for a version it does not
+    // implement), and AMR requires implementationVersion 0
+    const bool variants =
+      solver_name.find("Hydro_Muscl") == 0 and
+      !configMap.getBool("amr", "enabled", false);
+
+    if (variants) {
+      // implementationVersion 2 (directionally split) is a different
+      // scheme : only its number of pencils per team is tuned
+      if (configMap.getInteger("OTHER", "implementationVersion", 0) == 2) {
+	for (int width : {1, 2, 4, 8, 16})
+	  group.push_back({ {"OTHER.pencil_width", std::to_string(width)} });
+      } else if (!user_numerics("OTHER.implementationVersion")) {
+	for (int version : {0, 1})
+	  group.push_back({ {"OTHER.implementationVersion", std::to_string(version)} });
+      }
+    }
+    if (!group.empty())
+      groups.push_back(group);
+
+    // tile sizes of multidimensional range policies (0 : Kokkos default)
+    static const int tiles2d[][2] = { {0,0}, {16,16}, {64,4}, {4,64}, {256,1}, {1,256} };
+    static const int tiles3d[][3] = { {0,0,0}, {8,8,8}, {32,4,4}, {4,4,32}, {64,2,2}, {2,2,64} };
+
+    group.clear();
+    for (int t=0; t<6; ++t) {
+      Overrides tile;
+      tile.push_back({"kokkos.mdrange_tile_x", std::to_string(threeD ? tiles3d[t][0] : tiles2d[t][0])});
+      tile.push_back({"kokkos.mdrange_tile_y", std::to_string(threeD ? tiles3d[t][1] : tiles2d[t][1])});
+      if (threeD)
+	tile.push_back({"kokkos.mdrange_tile_z", std::to_string(tiles3d[t][2])});
+      group.push_back(tile);
+    }
+    groups.push_back(group);
+
+  } else if ( (solver_name.find("SDM") != std::string::npos or
+	       solver_name.find("Sdm") != std::string::npos) and !threeD and
+	      solver_name.find("padaptive") == std::string::npos and
+	      !user_numerics("sdm.interpolation_version") ) {
+
+    // both versions only differ in 2D (the p-adaptive solver has its own
+    // interpolation functors)
+    std::vector<Overrides> group;
+    for (int version : {1, 2})
+      group.push_back({ {"sdm.interpolation_version", std::to_string(version)} });
+    groups.push_back(group);
+
+  }
+
+  return groups;
+
+} // Autotuner::candidates
+
+// =======================================================
+// =======================================================
+double Autotuner::time_candidate(const Overrides& overrides) const
+{
+
+  ConfigMap cm(configMap);
+
+  // a short run without any output
+  set(cm, { {"run.ensemble_file", ""},
+	    {"run.noutput", "0"},
+	    {"run.nlog", "1000000"},
+	    {"run.nstepmax", std::to_string(m_steps+1)},
+	    {"analysis.interval", "0"},
+	    {"output.streams", ""},
+	    {"mpi.load_balancing_interval", "0"},
+	    {"autotune.enabled", "false"} });
+  set(cm, overrides);
+
+  HydroParams params;
+  params.setup(cm);
+
+  SolverBase* solver = SolverFactory::Instance().create(cm.getString("run", "solver_name", "unknown"),
+							params,
+							cm);
+
+  if (solver == nullptr) {
+    std::cerr << "Autotune : unknown solver name\n";
+    exit(EXIT_FAILURE);
+  }
+
+  // first step is not timed (first touch, first time step)
+  solver->next_iteration();
+
+  int nSteps = 0;
+  solver->timers[TIMER_TOTAL]->start();
+  while ( ! solver->finished() ) {
+    solver->next_iteration();
+    ++nSteps;
+  }
+  Kokkos::fence();
+  solver->timers[TIMER_TOTAL]->stop();
+
+  double t = nSteps > 0 ?
+    solver->timers[TIMER_TOTAL]->elapsed() / nSteps :
+    std::numeric_limits<double>::max();
+
+  if (nSteps == 0 and world_rank()==0)
+    std::cout << "Autotune : run ended before any timed step, increase [run] tEnd\n";
+
+  delete solver;
+
+#ifdef USE_MPI
+  MPI_Allreduce(MPI_IN_PLACE, &t, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+#endif // USE_MPI
+
+  return t;
+
+} // Autotuner::time_candidate
+
+// =======================================================
+// =======================================================
+bool Autotuner::load(Overrides& choice) const
+{
+
+  // settings of the last line matching the key
+  std::string found;
+
+  if (world_rank()==0) {
+
+    std::ifstream file(m_cache_file.c_str());
+    std::string line;
+
+    while (std::getline(file, line)) {
+
+      const size_t sep = line.find(':');
+      if (sep == std::string::npos)
+	continue;
+
+      // compare keys token by token (spacing is not significant)
+      std::istringstream lineKey(line.substr(0, sep)), refKey(m_key);
+      std::string a, b;
+      bool match = true;
+      while (match) {
+	const bool hasA = static_cast<bool>(lineKey >> a);
+	const bool hasB = static_cast<bool>(refKey  >> b);
+	if (!hasA or !hasB) {
+	  match = hasA == hasB;
+	  break;
+	}
+	match = a == b;
+      }
+
+      if (match)
+	found = line.substr(sep+1);
+
+    }
+
+  }
+
+#ifdef USE_MPI
+  int size = found.size();
+  MPI_Bcast(&size, 1, MPI_INT, 0, MPI_COMM_WORLD);
+  found.resize(size);
+  if (size > 0)
+    MPI_Bcast(&found[0], size, MPI_CHAR, 0, MPI_COMM_WORLD);
+#endif // USE_MPI
+
+  choice.clear();
+
+  std::istringstream tokens(found);
+  std::string token;
+  while (tokens >> token) {
+    const size_t eq  = token.find('=');
+    const size_t dot = token.find('.');
+    if (eq == std::string::npos or dot == std::string::npos or dot > eq)
+      continue;
+    choice.push_back(std::make_pair(token.substr(0, eq), token.substr(eq+1)));
+  }
+
+  return !choice.empty();
+
+} // Autotuner::load
+
+// =======================================================
+// =======================================================
+void Autotuner::store(const Overrides& choice) const
+{
+
+  if (world_rank()!=0)
+    return;
+
+  std::ofstream file(m_cache_file.c_str(), std::ios::app);
+
+  if (!file) {
+    std::cerr << "Autotune : unable to write " << m_cache_file << "\n";
+    return;
+  }
+
+  file << m_key << " : " << to_string(choice) << "\n";
+
+} // Autotuner::store
+
+// =======================================================
+// =======================================================
+std::string Autotuner::value(const std::string& setting) const
+{
+
+  const size_t dot = setting.find('.');
+  return configMap.getString(setting.substr(0, dot), setting.substr(dot+1), "");
+
+} // Autotuner::value
+
+// =======================================================
+// =======================================================
+bool Autotuner::user_numerics(const std::string& setting) const
+{
+
+  for (const char* numerics : numerics_settings)
+    if (setting == numerics)
+      return !value(setting).empty();
+
+  return false;
+
+} // Autotuner::user_numerics
+
+// =======================================================
+// =======================================================
+void Autotuner::set(ConfigMap& cm, const Overrides& overrides)
+{
+
+  for (const auto& kv : overrides) {
+    const size_t dot = kv.first.find('.');
+    cm.setString(kv.first.substr(0, dot), kv.first.substr(dot+1), kv.second);
+  }
+
+} // Autotuner::set
+
+// =======================================================
+// =======================================================
+std::string Autotuner::to_string(const Overrides& overrides)
+{
+
+  std::string str;
+
+  for (const auto& kv : overrides) {
+    if (!str.empty())
+      str += " ";
+    str += kv.first + "=" + kv.second;
+  }
+
+  return str;
+
+} // Autotuner::to_string
+
+} // namespace ppkMHD
@@ -0,0 +1,106 @@
+/**
+ * \file Autotuner.h
+ * \brief Choose implementation variants and tile sizes by timing them.
+ */
+#ifndef AUTOTUNER_H_
+#define AUTOTUNER_H_
+
+#include <string>
+#include <vector>
+
+#include "utils/config/ConfigMap.h"
+
+namespace ppkMHD {
+
+/**
+ * Autotuning of the settings which change performance but not results,
+ * enabled with [autotune] enabled=true.
+ *
+ * The first run for a given configuration (key) times each candidate
+ * setting over a few time steps, each candidate with a new solver, and
+ * appends the fastest choice to a cache file; later runs with the same
+ * key read the choice from the cache file. The key is made of the
+ * solver name (which includes dimension and degree), the settings
+ * selecting the scheme (implementationVersion, Riemann solver, order,
+ * limiter, AMR), the local sizes (as computed by HydroParams::setup,
+ * largest sub-domain), the number of MPI processes, the Kokkos backend
+ * and its thread count.
+ *
+ * Settings which change results (implementationVersion,
+ * sdm.interpolation_version) are only tuned when absent from the
+ * parameter file : a value set by the user is never replaced by a
+ * cached or timed choice.
+ *
+ * Candidates are tuned one group after the other (each group starting
+ * from the best choice of the previous ones) :
+ * - MUSCL : implementationVersion 0 or 1 (or, when implementationVersion
+ *   is 2, the number of pencils per team), then mdrange tile sizes;
+ *   implementation variants are only tuned for the hydro solver without
+ *   AMR (the MHD solver and AMR only implement version 0),
+ * - SDM 2D : interpolation at flux points, per cell or per flux point
+ *   (not the p-adaptive solver).
+ *
+ * Settings :
+ * - [autotune] cache_file : default ppkMHD_autotune.cache
+ * - [autotune] steps      : number of timed steps per candidate (default 5)
+ *
+ * The cache file has one line per key :
+ *   key : section.name=value section.name=value ...
+ * the last line of a key is used.
+ */
+class Autotuner {
+
+public:
+
+  //! list of (section.name, value)
+  using Overrides = std::vector<std::pair<std::string, std::string> >;
+
+  Autotuner(ConfigMap& configMap);
+
+  /**
+   * Read the choice from the cache file, or time the candidates and
+   * store the choice, then set the chosen values in configMap (to be
+   * called before HydroParams::setup).
+   *
+   * Collective when MPI is enabled.
+   */
+  void apply();
+
+  //! the configuration key
+  const std::string& key() const { return m_key; }
+
+private:
+
+  ConfigMap& configMap;
+
+  std::string m_key;
+  std::string m_cache_file;
+  int m_steps;
+
+  //! groups of alternative candidates
+  std::vector<std::vector<Overrides> > candidates() const;
+
+  //! time per step using these settings (max over MPI processes)
+  double time_candidate(const Overrides& overrides) const;
+
+  //! search the cache file (MPI rank 0) and broadcast the result
+  bool load(Overrides& choice) const;
+
+  //! append a line to the cache file (MPI rank 0)
+  void store(const Overrides& choice) const;
+
+  //! value of section.name in the parameter file (empty if absent)
+  std::string value(const std::string& setting) const;
+
+  //! true if setting changes results and is set in the parameter file
+  bool user_numerics(const std::string& setting) const;
+
+  static void set(ConfigMap& cm, const Overrides& overrides);
+
+  static std::string to_string(const Overrides& overrides);
+
+}; // class Autotuner
+
+} // namespace ppkMHD
+
+#endif // AUTOTUNER_H_
@@ -2,906 +2,393 @@
 #define BOUNDARIES_FUNCTORS_H_
 
 #include "HydroParams.h"    // for HydroParams
+#include "HydroState.h"     // for NbVar
 #include "kokkos_shared.h"  // for Data arrays
 
+//! list of ghost cells coordinates (i,j,k) touched by a physical border condition
+using GhostCellList = Kokkos::View<int*[3], Device>;
+
+//! border condition type per face (FACE_XMIN .. FACE_ZMAX),
+//! BC_COPY means the face is owned by a MPI neighbor (nothing to do)
+using FaceBCArray = Kokkos::Array<BoundaryConditionType,6>;
+
+/**
+ * Range policy over the ghost cells slab along face faceId, used to
+ * launch the physical boundary functors; along the transverse
+ * directions, the slab spans the whole sub-domain (ghost cells included).
+ */
+template<int dim>
+inline
+typename std::conditional<dim==2,MDPolicy2d,MDPolicy3d>::type
+boundary_policy(const HydroParams& params, FaceIdType faceId)
+{
+  const int gw = params.ghostWidth;
+
+  int ib = 0, ie = params.isize;
+  int jb = 0, je = params.jsize;
+  int kb = 0, ke = params.ksize;
+
+  if (faceId == FACE_XMIN) { ie = gw; }
+  if (faceId == FACE_XMAX) { ib = params.nx+gw; }
+  if (faceId == FACE_YMIN) { je = gw; }
+  if (faceId == FACE_YMAX) { jb = params.ny+gw; }
+  if (faceId == FACE_ZMIN) { ke = gw; }
+  if (faceId == FACE_ZMAX) { kb = params.nz+gw; }
+
+  return md_policy<dim>(ib, jb, kb, ie, je, ke, params.mdrange_tile);
+
+} // boundary_policy
+
 /*************************************************/
 /*************************************************/
 /*************************************************/
 /**
- * Functors to update ghost cells (Hydro 2D).
+ * Source cell index along one direction for a given type of border
+ * condition; n is the number of interior cells, gw the ghost width.
  *
+ * Ghost cell i is on the min side when i < gw, on the max side when
+ * i >= n+gw.
  */
-template <FaceIdType faceId>
-class MakeBoundariesFunctor2D {
-  
-public:
-  
-  MakeBoundariesFunctor2D(HydroParams params,
-			  DataArray2d Udata) :
-    params(params), Udata(Udata)  {};
-  
-  // static method which does it all: create and execute functor
-  static void apply(HydroParams params,
-                    DataArray2d Udata,
-                    int nbIter)
-  {
-    MakeBoundariesFunctor2D<faceId> functor(params, Udata);
-    Kokkos::parallel_for(nbIter, functor);
-  }
+template <BoundaryConditionType bc>
+struct BoundarySource;
 
+template <>
+struct BoundarySource<BC_DIRICHLET> {
+  static constexpr bool reflect = true;
   KOKKOS_INLINE_FUNCTION
-  void operator()(const int& index) const
+  static int at_min(int i, int n, int gw) { UNUSED(n); return 2*gw-1-i; }
+  KOKKOS_INLINE_FUNCTION
+  static int at_max(int i, int n, int gw) { return 2*n+2*gw-1-i; }
+};
+
+template <>
+struct BoundarySource<BC_NEUMANN> {
+  static constexpr bool reflect = false;
+  KOKKOS_INLINE_FUNCTION
+  static int at_min(int i, int n, int gw) { UNUSED(i); UNUSED(n); return gw; }
+  KOKKOS_INLINE_FUNCTION
+  static int at_max(int i, int n, int gw) { UNUSED(i); return n+gw-1; }
+};
+
+template <>
+struct BoundarySource<BC_PERIODIC> {
+  static constexpr bool reflect = false;
+  KOKKOS_INLINE_FUNCTION
+  static int at_min(int i, int n, int gw) { UNUSED(gw); return n+i; }
+  KOKKOS_INLINE_FUNCTION
+  static int at_max(int i, int n, int gw) { UNUSED(gw); return i-n; }
+};
+
+/**
+ * Runtime dispatch, only used when faces do not share the same
+ * border condition type (bc == BC_UNDEFINED).
+ */
+template <>
+struct BoundarySource<BC_UNDEFINED> {
+
+  KOKKOS_INLINE_FUNCTION
+  static int map(BoundaryConditionType type, bool atMin,
+                 int i, int n, int gw, bool& reflect)
   {
-    const int nx = params.nx;
-    const int ny = params.ny;
-    
-    const int ghostWidth = params.ghostWidth;
-    const int nbvar = params.nbvar;
-    
-    const int imin = params.imin;
-    const int imax = params.imax;
-    
-    const int jmin = params.jmin;
-    const int jmax = params.jmax;
-    
-    int i,j;
-    
-    int boundary_type;
-    
-    if (faceId == FACE_XMIN) {
-      
-      // boundary xmin
-      boundary_type = params.boundary_type_xmin;
-
-      j = index / ghostWidth;
-      i = index - j*ghostWidth;
-      
-      if(j >= jmin && j <= jmax    &&
-	 i >= 0    && i <ghostWidth) {
-	
-	int i0 = 0;
-	
-	for ( int iVar=0; iVar<nbvar; iVar++ ) {
-	  
-	  real_t sign=1.0;
-	  
-	  if ( boundary_type == BC_DIRICHLET ) {
-	    i0=2*ghostWidth-1-i;
-	    if (iVar==IU) sign=-1.0;
-	  } else if( boundary_type == BC_NEUMANN ) {
-	    i0=ghostWidth;
-	  } else { // periodic
-	    i0=nx+i;
-	  }
-	  
-	  Udata(i  ,j  , iVar) = Udata(i0  ,j  , iVar)*sign;
-	  
-	}
-	
-      }
-    } // end FACE_XMIN
-
-    if (faceId == FACE_XMAX) {
-      
-      // boundary xmax
-      boundary_type = params.boundary_type_xmax;
-      
-      j = index / ghostWidth;
-      i = index - j*ghostWidth;
-      i += (nx+ghostWidth);
-
-      if(j >= jmin          && j <= jmax             &&
-	 i >= nx+ghostWidth && i <= nx+2*ghostWidth-1) {
-	
-	int i0 = 0;
-	
-	for ( int iVar=0; iVar<nbvar; iVar++ ) {
-	  
-	  real_t sign=1.0;
-	  
-	  if ( boundary_type == BC_DIRICHLET ) {
-	    i0=2*nx+2*ghostWidth-1-i;
-	    if (iVar==IU) sign=-1.0;
-	  } else if ( boundary_type == BC_NEUMANN ) {
-	    i0=nx+ghostWidth-1;
-	  } else { // periodic
-	    i0=i-nx;
-	  }
-	  
-	  Udata(i  ,j  , iVar) = Udata(i0 ,j  , iVar)*sign;
-	  
-	}
-      }
-    } // end FACE_XMAX
-    
-    if (faceId == FACE_YMIN) {
-      
-      // boundary ymin
-      boundary_type = params.boundary_type_ymin;
-      
-      i = index / ghostWidth;
-      j = index - i*ghostWidth;
-
-      if(i >= imin && i <= imax    &&
-	 j >= 0    && j <ghostWidth) {
-	
-	int j0 = 0;
-	
-	for ( int iVar=0; iVar<nbvar; iVar++ ) {
-	  
-	  real_t sign=1.0;
-	  
-	  if ( boundary_type == BC_DIRICHLET ) {
-	    j0=2*ghostWidth-1-j;
-	    if (iVar==IV) sign=-1.0;
-	  } else if ( boundary_type == BC_NEUMANN ) {
-	    j0=ghostWidth;
-	  } else { // periodic
-	    j0=ny+j;
-	  }
-	  
-	  Udata(i  ,j  , iVar) = Udata(i  ,j0 , iVar)*sign;
-	}
-      }
-    } // end FACE_YMIN
-
-    if (faceId == FACE_YMAX) {
-
-      // boundary ymax
-      boundary_type = params.boundary_type_ymax;
-      
-      i = index / ghostWidth;
-      j = index - i*ghostWidth;
-      j += (ny+ghostWidth);
-      if(i >= imin          && i <= imax              &&
-	 j >= ny+ghostWidth && j <= ny+2*ghostWidth-1) {
-	
-	int j0 = 0;
-	
-	for ( int iVar=0; iVar<nbvar; iVar++ ) {
-	  
-	  real_t sign=1.0;
-	  
-	  if ( boundary_type == BC_DIRICHLET ) {
-	    j0=2*ny+2*ghostWidth-1-j;
-	    if (iVar==IV) sign=-1.0;
-	  } else if ( boundary_type == BC_NEUMANN ) {
-	    j0=ny+ghostWidth-1;
-	  } else { // periodic
-	    j0=j-ny;
-	  }
-	  
-	  Udata(i  ,j  , iVar) = Udata(i  ,j0  , iVar)*sign;
-	  
-	}
+    if (type == BC_DIRICHLET) {
+      reflect = true;
+      return atMin ?
+        BoundarySource<BC_DIRICHLET>::at_min(i,n,gw) :
+        BoundarySource<BC_DIRICHLET>::at_max(i,n,gw);
+    } else if (type == BC_NEUMANN) {
+      reflect = false;
+      return atMin ?
+        BoundarySource<BC_NEUMANN>::at_min(i,n,gw) :
+        BoundarySource<BC_NEUMANN>::at_max(i,n,gw);
+    } else { // periodic
+      reflect = false;
+      return atMin ?
+        BoundarySource<BC_PERIODIC>::at_min(i,n,gw) :
+        BoundarySource<BC_PERIODIC>::at_max(i,n,gw);
+    }
+  }
 
-      }
-    } // end FACE_YMAX
-    
-  } // end operator ()
-  
-  HydroParams params;
-  DataArray2d Udata;
-  
-}; // MakeBoundariesFunctor2D
+};
 
 /*************************************************/
 /*************************************************/
 /*************************************************/
 /**
- * Functors to update ghost cells (Hydro 3D).
+ * Functor to update all ghost cells (Hydro or MHD, 2D or 3D) in a
+ * single launch.
+ *
+ * Iterates over a precomputed list of ghost cells (see
+ * build_ghost_cell_list); each cell is filled from its source cell,
+ * obtained by composing the mapping along each direction. This
+ * gives the same result as applying faces one after the other
+ * (X, then Y, then Z), corners and edges included.
  *
+ * \tparam bc is the border condition type shared by all physical
+ * faces, or BC_UNDEFINED when it must be read per face at runtime.
+ * \tparam mhd selects the variables (hydro or MHD), so that their
+ * number is known at compile time.
  */
-template <FaceIdType faceId>
-class MakeBoundariesFunctor3D {
+template <int dim, BoundaryConditionType bc, bool mhd>
+class MakeBoundariesFunctor {
 
 public:
 
-  MakeBoundariesFunctor3D(HydroParams params,
-			  DataArray3d Udata) :
-    params(params), Udata(Udata)  {};
-  
+  using DataArray = typename std::conditional<dim==2,DataArray2d,DataArray3d>::type;
+
+  //! number of variables
+  enum { nbvar = NbVar<dim,mhd>::value };
+
+  MakeBoundariesFunctor(HydroParams   params,
+			DataArray     Udata,
+			GhostCellList ghostCells,
+			FaceBCArray   faceBC) :
+    params(params), Udata(Udata), ghostCells(ghostCells),
+    faceBC(faceBC) {};
+
   // static method which does it all: create and execute functor
-  static void apply(HydroParams params,
-                    DataArray3d Udata,
-                    int nbIter)
+  static void apply(HydroParams   params,
+                    DataArray     Udata,
+		    GhostCellList ghostCells,
+		    FaceBCArray   faceBC)
   {
-    MakeBoundariesFunctor3D<faceId> functor(params, Udata);
-    Kokkos::parallel_for(nbIter, functor);
+    MakeBoundariesFunctor<dim,bc,mhd> functor(params, Udata, ghostCells,
+					      faceBC);
+    Kokkos::parallel_for("MakeBoundariesFunctor",
+			 Kokkos::RangePolicy<Device>(0, ghostCells.extent(0)),
+			 functor);
   }
 
+  /**
+   * Source index along one direction.
+   *
+   * \param[in]  i index along current direction
+   * \param[in]  n number of interior cells along current direction
+   * \param[in]  faceMin face id of the min side (max side is faceMin+1)
+   * \param[out] reflect true if normal components must change sign
+   */
   KOKKOS_INLINE_FUNCTION
-  void operator()(const int& index) const
+  int source(int i, int n, int faceMin, bool& reflect) const
   {
-    const int nx = params.nx;
-    const int ny = params.ny;
-    const int nz = params.nz;
-    
-    const int isize = params.isize;
-    const int jsize = params.jsize;
-    //const int ksize = params.ksize;
-    const int ghostWidth = params.ghostWidth;
-    const int nbvar = params.nbvar;
-    
-    const int imin = params.imin;
-    const int imax = params.imax;
-    
-    const int jmin = params.jmin;
-    const int jmax = params.jmax;
-
-    const int kmin = params.kmin;
-    const int kmax = params.kmax;
-    
-    int i,j,k;
-    
-    int boundary_type;
-    
-    int i0, j0, k0;
-    
-    if (faceId == FACE_XMIN) {
-      
-      // boundary xmin (index = i + j * ghostWidth + k * ghostWidth*jsize)
-      k = index / (ghostWidth*jsize);
-      j = (index - k*ghostWidth*jsize) / ghostWidth;
-      i = index - j*ghostWidth - k*ghostWidth*jsize;
-      
-      boundary_type = params.boundary_type_xmin;
-      
-      if(k >= kmin && k <= kmax &&
-	 j >= jmin && j <= jmax &&
-	 i >= 0    && i <ghostWidth) {
-	
-	for ( int iVar=0; iVar<nbvar; iVar++ ) {
-
-	  real_t sign=1.0;
-	  
-	  if ( boundary_type == BC_DIRICHLET ) {
-	    i0=2*ghostWidth-1-i;
-	    if (iVar==IU) sign=-1.0;
-	  } else if( boundary_type == BC_NEUMANN ) {
-	    i0=ghostWidth;
-	  } else { // periodic
-	    i0=nx+i;
-	  }
-	  
-	  Udata(i,j,k, iVar) = Udata(i0,j,k, iVar)*sign;
-	  
-	}
-	
-      } // end xmin
-    }
+    const int gw = params.ghostWidth;
 
-    if (faceId == FACE_XMAX) {
-      
-      // boundary xmax (index = i + j *ghostWidth + k * ghostWidth*jsize)
-      // same i,j,k as xmin, except translation along x-axis
-      k = index / (ghostWidth*jsize);
-      j = (index - k*ghostWidth*jsize) / ghostWidth;
-      i = index - j*ghostWidth - k*ghostWidth*jsize;
-
-      i += (nx+ghostWidth);
-      
-      boundary_type = params.boundary_type_xmax;
-      
-      if(k >= kmin          && k <= kmax &&
-	 j >= jmin          && j <= jmax &&
-	 i >= nx+ghostWidth && i <= nx+2*ghostWidth-1) {
-	
-	for ( int iVar=0; iVar<nbvar; iVar++ ) {
-	  
-	  real_t sign=1.0;
-	  
-	  if ( boundary_type == BC_DIRICHLET ) {
-	    i0=2*nx+2*ghostWidth-1-i;
-	    if (iVar==IU) sign=-1.0;
-	  } else if ( boundary_type == BC_NEUMANN ) {
-	    i0=nx+ghostWidth-1;
-	  } else { // periodic
-	    i0=i-nx;
-	  }
-	  
-	  Udata(i,j,k, iVar) = Udata(i0,j,k, iVar)*sign;
-	  
-	}
-      } // end xmax
-    }
+    reflect = false;
 
-    if (faceId == FACE_YMIN) {
-
-      // boundary ymin (index = i + j*isize + k*isize*ghostWidth)
-      k = index / (isize*ghostWidth);
-      j = (index - k*isize*ghostWidth) / isize;
-      i = index - j*isize - k*isize*ghostWidth;
-
-      boundary_type = params.boundary_type_ymin;
-      
-      if(k >= kmin && k <= kmax       && 
-	 j >= 0    && j <  ghostWidth &&
-	 i >= imin && i <= imax) {
-	
-	for ( int iVar=0; iVar<nbvar; iVar++ ) {
-
-	  real_t sign=1.0;
-	
-	  if ( boundary_type == BC_DIRICHLET ) {
-	    j0=2*ghostWidth-1-j;
-	    if (iVar==IV) sign=-1.0;
-	    else sign=1.0;
-	  } else if ( boundary_type == BC_NEUMANN ) {
-	    j0=ghostWidth;
-	  } else { // periodic
-	    j0=ny+j;
-	  }
-	  
-	  Udata(i,j,k, iVar) = Udata(i,j0,k, iVar)*sign;
-	  
-	}
-      } // end ymin
-    }
+    if (i < gw && faceBC[faceMin] != BC_COPY)
+      return map(faceBC[faceMin], true, i, n, gw, reflect);
 
-    if (faceId == FACE_YMAX) {
-      
-      // boundary ymax (index = i + j*isize + k*isize*ghostWidth)
-      // same i,j,k as ymin, except translation along y-axis
-      k = index / (isize*ghostWidth);
-      j = (index - k*isize*ghostWidth) / isize;
-      i = index - j*isize - k*isize*ghostWidth;
-
-      j += (ny+ghostWidth);
-
-      boundary_type = params.boundary_type_ymax;
-      
-      if(k >= kmin           && k <= kmax              &&
-	 j >= ny+ghostWidth  && j <= ny+2*ghostWidth-1 &&
-	 i >= imin           && i <= imax) {
-	
-	for ( int iVar=0; iVar<nbvar; iVar++ ) {
-	  
-	  real_t sign=1.0;
-	  
-	  if ( boundary_type == BC_DIRICHLET ) {
-	    j0=2*ny+2*ghostWidth-1-j;
-	    if (iVar==IV) sign=-1.0;
-	  } else if ( boundary_type == BC_NEUMANN ) {
-	    j0=ny+ghostWidth-1;
-	  } else { // periodic
-	    j0=j-ny;
-	  }
-	  
-	  Udata(i,j,k, iVar) = Udata(i,j0,k, iVar)*sign;
-	  
-	}
-	
-      } // end ymax
-    }
+    if (i >= n+gw && faceBC[faceMin+1] != BC_COPY)
+      return map(faceBC[faceMin+1], false, i, n, gw, reflect);
 
-    if (faceId == FACE_ZMIN) {
-      
-      // boundary zmin (index = i + j*isize + k*isize*jsize)
-      k = index / (isize*jsize);
-      j = (index - k*isize*jsize) / isize;
-      i = index - j*isize - k*isize*jsize;
-
-      boundary_type = params.boundary_type_zmin;
-      
-      if(k >= 0    && k <  ghostWidth &&
-	 j >= jmin && j <= jmax       &&
-	 i >= imin && i <= imax) {
-	
-	for ( int iVar=0; iVar<nbvar; iVar++ ) {
-
-	  real_t sign=1.0;
-	
-	  if ( boundary_type == BC_DIRICHLET ) {
-	    k0=2*ghostWidth-1-k;
-	    if (iVar==IW) sign=-1.0;
-	  } else if ( boundary_type == BC_NEUMANN ) {
-	    k0=ghostWidth;
-	  } else { // periodic
-	    k0=nz+k;
-	  }
-	  
-	  Udata(i,j,k, iVar) = Udata(i,j,k0, iVar)*sign;
-	  
-	}
-      } // end zmin
-    }
-    
-    if (faceId == FACE_ZMAX) {
-      
-      // boundary zmax (index = i + j*isize + k*isize*jsize)
-      // same i,j,k as ymin, except translation along y-axis
-      k = index / (isize*jsize);
-      j = (index - k*isize*jsize) / isize;
-      i = index - j*isize - k*isize*jsize;
-
-      k += (nz+ghostWidth);
-
-      boundary_type = params.boundary_type_zmax;
-      
-      if(k >= nz+ghostWidth && k <= nz+2*ghostWidth-1 &&
-	 j >= jmin          && j <= jmax              &&
-	 i >= imin          && i <= imax) {
-	
-	
-	for ( int iVar=0; iVar<nbvar; iVar++ ) {
-
-	  real_t sign=1.0;
-	  
-	  if ( boundary_type == BC_DIRICHLET ) {
-	    k0=2*nz+2*ghostWidth-1-k;
-	    if (iVar==IW) sign=-1.0;
-	  } else if ( boundary_type == BC_NEUMANN ) {
-	    k0=nz+ghostWidth-1;
-	  } else { // periodic
-	    k0=k-nz;
-	  }
-	  
-	  Udata(i,j,k, iVar) = Udata(i,j,k0, iVar)*sign;
-	  
-	}
-      } // end zmax
-    }
-    
-  } // end operator ()
+    return i;
 
-  HydroParams params;
-  DataArray3d Udata;
-  
-}; // MakeBoundariesFunctor3D
+  } // source
 
-/*************************************************/
-/*************************************************/
-/*************************************************/
-/**
- * Three boundary conditions:
- * - reflective : normal velocity + normal magfield inverted
- * - outflow
- * - periodic
- */
-template <FaceIdType faceId>
-class MakeBoundariesFunctor2D_MHD {
+  //! sign to apply to variable iVar (normal velocity and magnetic field)
+  KOKKOS_INLINE_FUNCTION
+  real_t sign(int iVar, bool reflectX, bool reflectY, bool reflectZ) const
+  {
+    real_t s = 1.0;
 
-public:
+    if ( reflectX && (iVar==IU || (mhd && iVar==IA)) ) s = -s;
+    if ( reflectY && (iVar==IV || (mhd && iVar==IB)) ) s = -s;
+    if ( reflectZ && (iVar==IW || (mhd && iVar==IC)) ) s = -s;
 
-  MakeBoundariesFunctor2D_MHD(HydroParams params,
-			      DataArray2d Udata) :
-    params(params), Udata(Udata)  {};
-  
-  // static method which does it all: create and execute functor
-  static void apply(HydroParams params,
-                    DataArray2d Udata,
-                    int nbIter)
+    return s;
+
+  } // sign
+
+  //! 2D version.
+  template<int dim_=dim>
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const typename std::enable_if<dim_==2, int>::type& index) const
   {
-    MakeBoundariesFunctor2D_MHD<faceId> functor(params, Udata);
-    Kokkos::parallel_for(nbIter, functor);
-  }
+    const int i = ghostCells(index,IX);
+    const int j = ghostCells(index,IY);
+
+    bool reflectX, reflectY;
+    const int i0 = source(i, params.nx, FACE_XMIN, reflectX);
+    const int j0 = source(j, params.ny, FACE_YMIN, reflectY);
+
+    for ( int iVar=0; iVar<nbvar; iVar++ ) {
+      Udata(i,j,iVar) = Udata(i0,j0,iVar) * sign(iVar, reflectX, reflectY, false);
+    }
+
+  } // operator () - 2d
 
+  //! 3D version.
+  template<int dim_=dim>
   KOKKOS_INLINE_FUNCTION
-  void operator()(const int& index) const
+  void operator()(const typename std::enable_if<dim_==3, int>::type& index) const
   {
-    const int nx = params.nx;
-    const int ny = params.ny;
-    
-    const int ghostWidth = params.ghostWidth;
-    const int nbvar = params.nbvar;
-
-    const int imin = params.imin;
-    const int imax = params.imax;
-    
-    const int jmin = params.jmin;
-    const int jmax = params.jmax;
-    
-    int i,j;
-
-    int boundary_type;
-    
-    if (faceId == FACE_XMIN) {
-      
-      // boundary xmin
-      boundary_type = params.boundary_type_xmin;
-
-      j = index / ghostWidth;
-      i = index - j*ghostWidth;
-      
-      
-      if(j >= jmin && j <= jmax    &&
-	 i >= 0    && i <ghostWidth) {
-
-	int i0 = 0;
-	
-	for ( int iVar=0; iVar<nbvar; iVar++ ) {
-	  
-	  real_t sign=1.0;
-	  
-	  if ( boundary_type == BC_DIRICHLET ) {
-	    i0=2*ghostWidth-1-i;
-	    if (iVar==IU) sign=-1.0;
-	    if (iVar==IA) sign=-1.0;
-	  } else if( boundary_type == BC_NEUMANN ) {
-	    i0=ghostWidth;
-	  } else { // periodic
-	    i0=nx+i;
-	  }
-	  
-	  Udata(i,j, iVar) = Udata(i0,j , iVar)*sign;
-	  
-	}
-	
-      }
-    } // end FACE_XMIN
-
-    if (faceId == FACE_XMAX) {
-      
-      // boundary xmax
-      boundary_type = params.boundary_type_xmax;
-      
-      j = index / ghostWidth;
-      i = index - j*ghostWidth;
-      i += (nx+ghostWidth);
-
-      if(j >= jmin          && j <= jmax             &&
-	 i >= nx+ghostWidth && i <= nx+2*ghostWidth-1) {
-
-	int i0 = 0;
-	
-	for ( int iVar=0; iVar<nbvar; iVar++ ) {
-	  
-	  real_t sign=1.0;
-	  
-	  if ( boundary_type == BC_DIRICHLET ) {
-	    i0=2*nx+2*ghostWidth-1-i;
-	    if (iVar==IU) sign=-1.0;
-	    if (iVar==IA) sign=-1.0;
-	  } else if ( boundary_type == BC_NEUMANN ) {
-	    i0=nx+ghostWidth-1;
-	  } else { // periodic
-	    i0=i-nx;
-	  }
-	  
-	  Udata(i,j, iVar) = Udata(i0,j , iVar)*sign;
-	  
-	}
-      }
-    } // end FACE_XMAX
-    
-    if (faceId == FACE_YMIN) {
-      
-      // boundary ymin
-      boundary_type = params.boundary_type_ymin;
-      
-      i = index / ghostWidth;
-      j = index - i*ghostWidth;
-
-      if(i >= imin && i <= imax    &&
-	 j >= 0    && j <ghostWidth) {
-
-	int j0 = 0;
-	
-	for ( int iVar=0; iVar<nbvar; iVar++ ) {
-
-	  real_t sign=1.0;
-	
-	  if ( boundary_type == BC_DIRICHLET ) {
-	    j0=2*ghostWidth-1-j;
-	    if (iVar==IV) sign=-1.0;
-	    if (iVar==IB) sign=-1.0;
-	  } else if ( boundary_type == BC_NEUMANN ) {
-	    j0=ghostWidth;
-	  } else { // periodic
-	    j0=ny+j;
-	  }
-	  
-	  Udata(i,j, iVar) = Udata(i,j0, iVar)*sign;
-	}
-      }
-    } // end FACE_YMIN
-
-    if (faceId == FACE_YMAX) {
-
-      // boundary ymax
-      boundary_type = params.boundary_type_ymax;
-      
-      i = index / ghostWidth;
-      j = index - i*ghostWidth;
-      j += (ny+ghostWidth);
-
-      if(i >= imin          && i <= imax              &&
-	 j >= ny+ghostWidth && j <= ny+2*ghostWidth-1) {
-	
-	int j0 = 0;
-
-	for ( int iVar=0; iVar<nbvar; iVar++ ) {
-	  
-	  real_t sign=1.0;
-	  
-	  if ( boundary_type == BC_DIRICHLET ) {
-	    j0=2*ny+2*ghostWidth-1-j;
-	    if (iVar==IV) sign=-1.0;
-	    if (iVar==IB) sign=-1.0;
-	  } else if ( boundary_type == BC_NEUMANN ) {
-	    j0=ny+ghostWidth-1;
-	  } else { // periodic
-	    j0=j-ny;
-	  }
-	  
-	  Udata(i,j, iVar) = Udata(i,j0, iVar)*sign;
-	  
-	}
+    const int i = ghostCells(index,IX);
+    const int j = ghostCells(index,IY);
+    const int k = ghostCells(index,IZ);
 
-      }
-    } // end FACE_YMAX
-    
-  } // end operator ()
+    bool reflectX, reflectY, reflectZ;
+    const int i0 = source(i, params.nx, FACE_XMIN, reflectX);
+    const int j0 = source(j, params.ny, FACE_YMIN, reflectY);
+    const int k0 = source(k, params.nz, FACE_ZMIN, reflectZ);
 
-  HydroParams params;
-  DataArray2d Udata;
-  
-}; // MakeBoundariesFunctor2D_MHD
+    for ( int iVar=0; iVar<nbvar; iVar++ ) {
+      Udata(i,j,k,iVar) = Udata(i0,j0,k0,iVar) * sign(iVar, reflectX, reflectY, reflectZ);
+    }
 
-/*************************************************/
-/*************************************************/
-/*************************************************/
-template <FaceIdType faceId>
-class MakeBoundariesFunctor3D_MHD {
+  } // operator () - 3d
 
-public:
+private:
 
-  MakeBoundariesFunctor3D_MHD(HydroParams params,
-			      DataArray3d Udata) :
-    params(params), Udata(Udata)  {};
-  
-  // static method which does it all: create and execute functor
-  static void apply(HydroParams params,
-                    DataArray3d Udata,
-                    int nbIter)
+  //! border condition type is known at compile time
+  template<BoundaryConditionType bc_=bc>
+  KOKKOS_INLINE_FUNCTION
+  int map(typename std::enable_if<bc_!=BC_UNDEFINED, BoundaryConditionType>::type type,
+	  bool atMin, int i, int n, int gw, bool& reflect) const
   {
-    MakeBoundariesFunctor3D_MHD<faceId> functor(params, Udata);
-    Kokkos::parallel_for(nbIter, functor);
+    UNUSED(type);
+    reflect = BoundarySource<bc>::reflect;
+    return atMin ?
+      BoundarySource<bc>::at_min(i,n,gw) :
+      BoundarySource<bc>::at_max(i,n,gw);
   }
 
+  //! border condition type read at runtime
+  template<BoundaryConditionType bc_=bc>
   KOKKOS_INLINE_FUNCTION
-  void operator()(const int& index) const
+  int map(typename std::enable_if<bc_==BC_UNDEFINED, BoundaryConditionType>::type type,
+	  bool atMin, int i, int n, int gw, bool& reflect) const
   {
-    const int nx = params.nx;
-    const int ny = params.ny;
-    const int nz = params.nz;
-    
-    const int isize = params.isize;
-    const int jsize = params.jsize;
-    //const int ksize = params.ksize;
-    const int ghostWidth = params.ghostWidth;
-    const int nbvar = params.nbvar;
-    
-    const int imin = params.imin;
-    const int imax = params.imax;
-    
-    const int jmin = params.jmin;
-    const int jmax = params.jmax;
-
-    const int kmin = params.kmin;
-    const int kmax = params.kmax;
-    
-    int i,j,k;
-    
-    int boundary_type;
-    
-    int i0, j0, k0;
-
-    if (faceId == FACE_XMIN) {
-
-      // boundary xmin (index = i + j * ghostWidth + k * ghostWidth*jsize)
-      boundary_type = params.boundary_type_xmin;
-      
-      k = index / (ghostWidth*jsize);
-      j = (index - k*ghostWidth*jsize) / ghostWidth;
-      i = index - j*ghostWidth - k*ghostWidth*jsize;
-
-      if(k >= kmin && k <= kmax &&
-	 j >= jmin && j <= jmax &&
-	 i >= 0    && i <ghostWidth) {
-	
-	for ( int iVar=0; iVar<nbvar; iVar++ ) {
-	
-	  real_t sign=1.0;
-	  
-	  if ( boundary_type == BC_DIRICHLET ) {
-	    i0=2*ghostWidth-1-i;
-	    if (iVar==IU) sign=-1.0;
-	    if (iVar==IA) sign=-1.0;
-	  } else if( boundary_type == BC_NEUMANN ) {
-	    i0=ghostWidth;
-	  } else { // periodic
-	    i0=nx+i;
-	  }
-
-	  Udata(i,j,k , iVar) = Udata(i0,j,k , iVar)*sign;
+    return BoundarySource<BC_UNDEFINED>::map(type, atMin, i, n, gw, reflect);
+  }
 
-	}
+public:
 
-      }
-    } // end FACE_XMIN
-
-    if (faceId == FACE_XMAX) {
-      
-      // boundary xmax (index = i + j *ghostWidth + k * ghostWidth*jsize)
-      // same i,j,k as xmin, except translation along x-axis
-      boundary_type = params.boundary_type_xmax;
-      
-      k = index / (ghostWidth*jsize);
-      j = (index - k*ghostWidth*jsize) / ghostWidth;
-      i = index - j*ghostWidth - k*ghostWidth*jsize;
-
-      i += (nx+ghostWidth);
-      
-      if(k >= kmin          && k <= kmax &&
-	 j >= jmin          && j <= jmax &&
-	 i >= nx+ghostWidth && i <= nx+2*ghostWidth-1) {
-	
-	for ( int iVar=0; iVar<nbvar; iVar++ ) {
-
-	  real_t sign=1.0;
-	  
-	  if ( boundary_type == BC_DIRICHLET ) {
-	    i0=2*nx+2*ghostWidth-1-i;
-	    if (iVar==IU) sign=-1.0;
-	    if (iVar==IA) sign=-1.0;
-	  } else if ( boundary_type == BC_NEUMANN ) {
-	    i0=nx+ghostWidth-1;
-	  } else { // periodic
-	    i0=i-nx;
-	  }
-
-	  Udata(i,j,k, iVar) = Udata(i0,j,k, iVar)*sign;
+  HydroParams   params;
+  DataArray     Udata;
+  GhostCellList ghostCells;
+  FaceBCArray   faceBC;
 
-	}
-      }
-    } // end FACE_XMAX
-    
-    if (faceId == FACE_YMIN) {
-
-      // boundary ymin (index = i + j*isize + k*isize*ghostWidth)
-      boundary_type = params.boundary_type_ymin;
-      
-      k = index / (isize*ghostWidth);
-      j = (index - k*isize*ghostWidth) / isize;
-      i = index - j*isize - k*isize*ghostWidth;
-
-      if(k >= kmin && k <= kmax       && 
-	 j >= 0    && j <  ghostWidth &&
-	 i >= imin && i <= imax) {
-	
-	for ( int iVar=0; iVar<nbvar; iVar++ ) {
-
-	  real_t sign=1.0;
-
-	  if ( boundary_type == BC_DIRICHLET ) {
-	    j0=2*ghostWidth-1-j;
-	    if (iVar==IV) sign=-1.0;
-	    if (iVar==IB) sign=-1.0;
-	  } else if ( boundary_type == BC_NEUMANN ) {
-	    j0=ghostWidth;
-	  } else { // periodic
-	    j0=ny+j;
-	  }
-
-	  Udata(i,j,k, iVar) = Udata(i,j0,k, iVar)*sign;
-	
-	}
-      }
-    } // end FACE_YMIN
-
-    if (faceId == FACE_YMAX) {
-      
-      // boundary ymax (index = i + j*isize + k*isize*ghostWidth)
-      // same i,j,k as ymin, except translation along y-axis
-      boundary_type = params.boundary_type_ymax;
-      
-      k = index / (isize*ghostWidth);
-      j = (index - k*isize*ghostWidth) / isize;
-      i = index - j*isize - k*isize*ghostWidth;
-
-      j += (ny+ghostWidth);
-
-      if(k >= kmin           && k <= kmax              &&
-	 j >= ny+ghostWidth  && j <= ny+2*ghostWidth-1 &&
-	 i >= imin           && i <= imax) {
-	
-	for ( int iVar=0; iVar<nbvar; iVar++ ) {
-
-	  real_t sign=1.0;
-	  
-	  if ( boundary_type == BC_DIRICHLET ) {
-	    j0=2*ny+2*ghostWidth-1-j;
-	    if (iVar==IV) sign=-1.0;
-	    if (iVar==IB) sign=-1.0;
-	  } else if ( boundary_type == BC_NEUMANN ) {
-	    j0=ny+ghostWidth-1;
-	  } else { // periodic
-	    j0=j-ny;
-	  }
-
-	  Udata(i,j,k , iVar) = Udata(i,j0,k , iVar)*sign;
+}; // class MakeBoundariesFunctor
 
+/*************************************************/
+/*************************************************/
+/*************************************************/
+/**
+ * Build the list of ghost cells which lie in the ghost layer of at
+ * least one physical face (i.e. a face whose faceBC is not BC_COPY).
+ *
+ * Cells only touched by MPI exchanges are left out.
+ */
+inline GhostCellList build_ghost_cell_list(const HydroParams& params,
+					   const FaceBCArray& faceBC)
+{
+
+  const int gw = params.ghostWidth;
+  const int isize = params.isize;
+  const int jsize = params.jsize;
+  const int ksize = params.dimType == THREE_D ? params.ksize : 1;
+
+  auto in_ghost = [gw,&faceBC](int i, int n, int faceMin) {
+    return
+      (i <  gw   && faceBC[faceMin]   != BC_COPY) ||
+      (i >= n+gw && faceBC[faceMin+1] != BC_COPY);
+  };
+
+  auto is_ghost = [&](int i, int j, int k) {
+    return
+      in_ghost(i, params.nx, FACE_XMIN) ||
+      in_ghost(j, params.ny, FACE_YMIN) ||
+      (params.dimType == THREE_D && in_ghost(k, params.nz, FACE_ZMIN));
+  };
+
+  // first pass : count
+  int nbCells = 0;
+  for (int k=0; k<ksize; ++k)
+    for (int j=0; j<jsize; ++j)
+      for (int i=0; i<isize; ++i)
+	if (is_ghost(i,j,k))
+	  nbCells++;
+
+  GhostCellList ghostCells("ghostCells", nbCells);
+  GhostCellList::HostMirror ghostCells_h = Kokkos::create_mirror_view(ghostCells);
+
+  // second pass : fill
+  int index = 0;
+  for (int k=0; k<ksize; ++k)
+    for (int j=0; j<jsize; ++j)
+      for (int i=0; i<isize; ++i)
+	if (is_ghost(i,j,k)) {
+	  ghostCells_h(index,IX) = i;
+	  ghostCells_h(index,IY) = j;
+	  ghostCells_h(index,IZ) = k;
+	  index++;
 	}
 
-      }
-    } // end FACE_YMAX
-    
-    if (faceId == FACE_ZMIN) {
-      
-      // boundary zmin (index = i + j*isize + k*isize*jsize)
-      boundary_type = params.boundary_type_zmin;
-      
-      k = index / (isize*jsize);
-      j = (index - k*isize*jsize) / isize;
-      i = index - j*isize - k*isize*jsize;
-
-      if(k >= 0    && k <  ghostWidth &&
-	 j >= jmin && j <= jmax       &&
-	 i >= imin && i <= imax) {
-	
-	for ( int iVar=0; iVar<nbvar; iVar++ ) {
-
-	  real_t sign=1.0;
-
-	  if ( boundary_type == BC_DIRICHLET ) {
-	    k0=2*ghostWidth-1-k;
-	    if (iVar==IW) sign=-1.0;
-	    if (iVar==IC) sign=-1.0;
-	  } else if ( boundary_type == BC_NEUMANN ) {
-	    k0=ghostWidth;
-	  } else { // periodic
-	    k0=nz+k;
-	  }
-
-	  Udata(i,j,k, iVar) = Udata(i,j,k0, iVar)*sign;
-	
-	}
-      }
-    } // end FACE_ZMIN
-    
-    if (faceId == FACE_ZMAX) {
-      
-      // boundary zmax (index = i + j*isize + k*isize*jsize)
-      // same i,j,k as ymin, except translation along y-axis
-      boundary_type = params.boundary_type_zmax;
-      
-      k = index / (isize*jsize);
-      j = (index - k*isize*jsize) / isize;
-      i = index - j*isize - k*isize*jsize;
-
-      k += (nz+ghostWidth);
-
-      if(k >= nz+ghostWidth && k <= nz+2*ghostWidth-1 &&
-	 j >= jmin          && j <= jmax              &&
-	 i >= imin          && i <= imax) {
-	
-	for ( int iVar=0; iVar<nbvar; iVar++ ) {
-
-	  real_t sign=1.0;
-	
-	  if ( boundary_type == BC_DIRICHLET ) {
-	    k0=2*nz+2*ghostWidth-1-k;
-	    if (iVar==IW) sign=-1.0;
-	    if (iVar==IC) sign=-1.0;
-	  } else if ( boundary_type == BC_NEUMANN ) {
-	    k0=nz+ghostWidth-1;
-	  } else { // periodic
-	    k0=k-nz;
-	  }
-
-	  Udata(i,j,k, iVar) = Udata(i,j,k0, iVar)*sign;
-	
-	}
-      }
-    } // end FACE_ZMAX
-    
-  } // end operator ()
-
-  HydroParams params;
-  DataArray3d Udata;
-  
-}; // MakeBoundariesFunctor3D_MHD
+  Kokkos::deep_copy(ghostCells, ghostCells_h);
+
+  return ghostCells;
+
+} // build_ghost_cell_list
+
+/*************************************************/
+/*************************************************/
+/*************************************************/
+/**
+ * Launch MakeBoundariesFunctor for a given set of variables (hydro or
+ * MHD).
+ */
+template<int dim, bool mhd, class DataArray>
+void make_boundaries_apply_bc(const HydroParams&    params,
+			      DataArray             Udata,
+			      GhostCellList         ghostCells,
+			      FaceBCArray           faceBC,
+			      BoundaryConditionType bc)
+{
+
+  if (bc == BC_DIRICHLET)
+    MakeBoundariesFunctor<dim,BC_DIRICHLET,mhd>::apply(params, Udata, ghostCells, faceBC);
+  else if (bc == BC_NEUMANN)
+    MakeBoundariesFunctor<dim,BC_NEUMANN,mhd>::apply(params, Udata, ghostCells, faceBC);
+  else if (bc == BC_PERIODIC)
+    MakeBoundariesFunctor<dim,BC_PERIODIC,mhd>::apply(params, Udata, ghostCells, faceBC);
+  else
+    MakeBoundariesFunctor<dim,BC_UNDEFINED,mhd>::apply(params, Udata, ghostCells, faceBC);
+
+} // make_boundaries_apply_bc
+
+/**
+ * Launch MakeBoundariesFunctor, using a compile-time border condition
+ * type when all physical faces share the same one.
+ */
+template<int dim, class DataArray>
+void make_boundaries_apply(const HydroParams& params,
+			   DataArray          Udata,
+			   GhostCellList      ghostCells,
+			   FaceBCArray        faceBC,
+			   bool               mhd_enabled)
+{
+
+  if (ghostCells.extent(0) == 0)
+    return;
+
+  BoundaryConditionType bc = BC_UNDEFINED;
+  bool uniform = true;
+
+  for (int face=0; face<2*dim; ++face) {
+    if (faceBC[face] == BC_COPY)
+      continue;
+    if (bc == BC_UNDEFINED)
+      bc = faceBC[face];
+    else if (bc != faceBC[face])
+      uniform = false;
+  }
+
+  if (!uniform)
+    bc = BC_UNDEFINED;
+
+  if (mhd_enabled)
+    make_boundaries_apply_bc<dim,true>(params, Udata, ghostCells, faceBC, bc);
+  else
+    make_boundaries_apply_bc<dim,false>(params, Udata, ghostCells, faceBC, bc);
+
+} // make_boundaries_apply
 
 #endif // BOUNDARIES_FUNCTORS_H_
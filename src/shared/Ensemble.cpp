@@ -0,0 +1,291 @@
+#include "shared/Ensemble.h"
+
+#include <algorithm> // for std::min, std::max
+#include <atomic>
+#include <cstdio>
+#include <cstdlib> // for exit
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <iomanip>
+
+#include "shared/SolverFactory.h"
+#include "shared/solver_utils.h"
+
+#ifdef USE_MPI
+#include <mpi.h>
+#endif // USE_MPI
+
+#ifdef USE_HDF5
+#include "utils/io/IO_HDF5.h"
+#endif // USE_HDF5
+
+namespace ppkMHD {
+
+// =======================================================
+// =======================================================
+Ensemble::Ensemble(ConfigMap& configMap, const std::string& filename) :
+  m_members(),
+  m_nPartitions(1)
+{
+
+#ifdef USE_MPI
+  int nRanks = 1;
+  MPI_Comm_size(MPI_COMM_WORLD, &nRanks);
+  if (nRanks > 1) {
+    std::cerr << "[run] ensemble_file requires a single MPI process\n";
+    exit(EXIT_FAILURE);
+  }
+#endif // USE_MPI
+
+  const auto overrides = read_overrides(filename);
+
+  if (overrides.empty()) {
+    std::cerr << "[run] ensemble_file " << filename << " lists no member\n";
+    exit(EXIT_FAILURE);
+  }
+
+  const std::string solver_name  = configMap.getString("run", "solver_name", "Unknown");
+  const std::string outputPrefix = configMap.getString("output", "outputPrefix", "output");
+
+  m_members.resize(overrides.size());
+
+  for (int m=0; m<size(); ++m) {
+
+    Member& member = m_members[m];
+
+    std::ostringstream tag;
+    tag << "m" << std::setw(3) << std::setfill('0') << m;
+    member.tag = tag.str();
+
+    member.configMap.reset(new ConfigMap(configMap));
+    ConfigMap& cm = *member.configMap;
+
+    // the ensemble file must not be read again by a member
+    cm.setString("run", "ensemble_file", "");
+
+    for (const auto& kv : overrides[m]) {
+      const size_t dot = kv.first.find('.');
+      cm.setString(kv.first.substr(0, dot), kv.first.substr(dot+1), kv.second);
+    }
+
+    // tag outputs by member (a member may override the prefix too)
+    cm.setString("output", "outputPrefix",
+		 cm.getString("output", "outputPrefix", outputPrefix) + "_" + member.tag);
+
+    member.params.reset(new HydroParams());
+    member.params->setup(cm);
+
+    member.solver = SolverFactory::Instance().create(cm.getString("run", "solver_name", solver_name),
+						     *member.params,
+						     cm);
+
+    if (member.solver == nullptr) {
+      std::cerr << "Ensemble member " << member.tag << " : unknown solver name\n";
+      exit(EXIT_FAILURE);
+    }
+
+  } // end for m
+
+#if defined(KOKKOS_ENABLE_OPENMP)
+  if (std::is_same<Device, Kokkos::OpenMP>::value) {
+
+    const int nThreads = Kokkos::OpenMP::concurrency();
+    m_nPartitions = configMap.getInteger("run", "ensemble_partitions", 0);
+    if (m_nPartitions <= 0)
+      m_nPartitions = size();
+    m_nPartitions = std::max(1, std::min(m_nPartitions, std::min(size(), nThreads)));
+
+#ifdef USE_MPI
+    // members call MPI (time step reduction, border exchanges, outputs)
+    // and MPI is not initialized for concurrent calls from several
+    // threads (see GlobalMpiSession)
+    m_nPartitions = 1;
+#endif // USE_MPI
+
+#ifdef USE_HDF5
+    // HDF5 library is usually not thread safe
+    for (const Member& member : m_members)
+      if (member.configMap->getBool("output", "hdf5_enabled", false))
+	m_nPartitions = 1;
+#endif // USE_HDF5
+
+  }
+#endif // KOKKOS_ENABLE_OPENMP
+
+} // Ensemble::Ensemble
+
+// =======================================================
+// =======================================================
+Ensemble::~Ensemble()
+{
+
+  for (Member& member : m_members)
+    delete member.solver;
+
+} // Ensemble::~Ensemble
+
+// =======================================================
+// =======================================================
+void Ensemble::run()
+{
+
+  for (Member& member : m_members)
+    if (member.params->nOutput != 0)
+      member.solver->save_solution();
+
+  std::cout << "Start computation of " << size() << " ensemble members"
+	    << " (" << m_nPartitions << " concurrent)....\n";
+
+  if (m_nPartitions > 1)
+    run_partitioned();
+  else
+    run_lockstep();
+
+  for (Member& member : m_members) {
+
+    SolverBase* solver = member.solver;
+
+    if (member.params->nOutput != 0)
+      solver->save_solution();
+
+#ifdef USE_HDF5
+    if (member.configMap->getBool("output","hdf5_enabled",false)) {
+      ppkMHD::io::writeXdmfForHdf5Wrapper(*member.params, *member.configMap,
+					  solver->m_variables_names,
+					  solver->m_times_saved-1, false);
+    }
+#endif // USE_HDF5
+
+    printf("ensemble member %s : final time is %f after %d iterations\n",
+	   member.tag.c_str(), solver->m_t, solver->m_iteration);
+
+    print_solver_monitoring_info(solver);
+
+  }
+
+} // Ensemble::run
+
+// =======================================================
+// =======================================================
+void Ensemble::run_lockstep()
+{
+
+  // advance unfinished members by one iteration each, every member
+  // with its own time step, until all of them reached their end time
+  bool running = true;
+  while (running) {
+
+    running = false;
+
+    for (Member& member : m_members) {
+
+      SolverBase* solver = member.solver;
+
+      if (solver->finished())
+	continue;
+
+      solver->timers[TIMER_TOTAL]->start();
+      solver->next_iteration();
+      solver->timers[TIMER_TOTAL]->stop();
+
+      running = true;
+
+    }
+
+  } // end ensemble loop
+
+} // Ensemble::run_lockstep
+
+// =======================================================
+// =======================================================
+void Ensemble::run_partitioned()
+{
+
+#if defined(KOKKOS_ENABLE_OPENMP)
+
+  // inside a partition, kernels launched on the default execution space
+  // only use the threads of that partition, so solvers need no change;
+  // members are handed out one at a time, which balances members of
+  // different costs
+  std::atomic<int> next(0);
+
+  Kokkos::OpenMP::partition_master([&](int partition_id, int num_partitions) {
+
+      UNUSED(partition_id);
+      UNUSED(num_partitions);
+
+      for (int m = next++; m < size(); m = next++) {
+
+	SolverBase* solver = m_members[m].solver;
+
+	solver->timers[TIMER_TOTAL]->start();
+	while (!solver->finished())
+	  solver->next_iteration();
+	solver->timers[TIMER_TOTAL]->stop();
+
+      }
+
+    }, m_nPartitions, 0);
+
+#else
+
+  run_lockstep();
+
+#endif // KOKKOS_ENABLE_OPENMP
+
+} // Ensemble::run_partitioned
+
+// =======================================================
+// =======================================================
+std::vector<std::vector<std::pair<std::string, std::string> > >
+Ensemble::read_overrides(const std::string& filename)
+{
+
+  std::vector<std::vector<std::pair<std::string, std::string> > > members;
+
+  std::ifstream file(filename.c_str());
+  if (!file) {
+    std::cerr << "Unable to open ensemble file " << filename << "\n";
+    exit(EXIT_FAILURE);
+  }
+
+  std::string line;
+  int lineNumber = 0;
+  while (std::getline(file, line)) {
+
+    ++lineNumber;
+
+    const size_t first = line.find_first_not_of(" \t\r");
+    if (first == std::string::npos or line[first] == '#')
+      continue;
+
+    std::vector<std::pair<std::string, std::string> > overrides;
+
+    std::istringstream tokens(line);
+    std::string token;
+    while (tokens >> token) {
+
+      const size_t eq  = token.find('=');
+      const size_t dot = token.find('.');
+
+      if (eq == std::string::npos or dot == std::string::npos or
+	  dot == 0 or dot+1 >= eq) {
+	std::cerr << filename << ":" << lineNumber
+		  << " : expected section.name=value, got " << token << "\n";
+	exit(EXIT_FAILURE);
+      }
+
+      overrides.push_back(std::make_pair(token.substr(0, eq), token.substr(eq+1)));
+
+    }
+
+    members.push_back(overrides);
+
+  }
+
+  return members;
+
+} // Ensemble::read_overrides
+
+} // namespace ppkMHD
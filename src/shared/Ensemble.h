@@ -0,0 +1,96 @@
+/**
+ * \file Ensemble.h
+ * \brief Run many small independent simulations in one process.
+ */
+#ifndef ENSEMBLE_H_
+#define ENSEMBLE_H_
+
+#include <string>
+#include <vector>
+#include <memory>
+
+#include "shared/HydroParams.h"
+#include "shared/SolverBase.h"
+#include "utils/config/ConfigMap.h"
+
+namespace ppkMHD {
+
+/**
+ * An ensemble is a set of independent simulations (members) sharing
+ * the same parameter file, each member overriding some of the
+ * parameters; all members live in the same process and are advanced
+ * together, which amortizes the executable start-up and keeps the
+ * device busy with several small problems instead of one.
+ *
+ * Members are listed in the file given by [run] ensemble_file, one
+ * member per line, as whitespace-separated section.name=value
+ * overrides, e.g.
+ *
+ *   hydro.gamma0=1.4 run.tEnd=0.2
+ *   hydro.gamma0=1.6 blast.blast_radius=0.1
+ *
+ * Empty lines and lines starting with '#' are ignored.
+ *
+ * Each member has its own time step and end time. With the OpenMP
+ * backend, the thread pool is split into [run] ensemble_partitions
+ * partitions (default : one per member, at most one per thread), and
+ * members run concurrently, each partition taking the next member not
+ * started yet and running it to completion with its own threads (not
+ * with MPI or HDF5 output, which must not be called concurrently). On
+ * other backends (or with a single partition), members are advanced in
+ * lockstep (one iteration of every unfinished member per round) until
+ * all of them are finished. Output files of member m are tagged with the
+ * suffix _mXXX appended to [output] outputPrefix.
+ */
+class Ensemble {
+
+public:
+
+  /**
+   * \param[in] configMap parameters shared by all members
+   * \param[in] filename  file listing member overrides
+   */
+  Ensemble(ConfigMap& configMap, const std::string& filename);
+  ~Ensemble();
+
+  //! number of members
+  int size() const { return (int) m_members.size(); }
+
+  //! initial outputs, time loop, final outputs and monitoring
+  void run();
+
+private:
+
+  struct Member {
+
+    //! output tag, e.g. m003
+    std::string tag;
+
+    //! solvers keep references to their settings
+    std::unique_ptr<ConfigMap>   configMap;
+    std::unique_ptr<HydroParams> params;
+
+    SolverBase* solver;
+
+  }; // struct Member
+
+  std::vector<Member> m_members;
+
+  //! number of OpenMP thread pool partitions running members concurrently
+  int m_nPartitions;
+
+  //! advance members one iteration at a time, in lockstep
+  void run_lockstep();
+
+  //! run members concurrently on partitions of the thread pool
+  void run_partitioned();
+
+  //! parse the member list, one vector of (key, value) per member
+  static std::vector<std::vector<std::pair<std::string, std::string> > >
+  read_overrides(const std::string& filename);
+
+}; // class Ensemble
+
+} // namespace ppkMHD
+
+#endif // ENSEMBLE_H_
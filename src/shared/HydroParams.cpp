@@ -4,6 +4,7 @@
 #include <cstdio>  // for fprintf
 #include <cstring> // for strcmp
 #include <iostream>
+#include <algorithm> // for std::min, std::max
 
 #include "config/inih/ini.h" // our INI file reader
 
@@ -14,6 +15,68 @@
 
 #ifdef USE_MPI
 using namespace hydroSimu;
+
+// =======================================================
+// =======================================================
+/**
+ * Choose the MPI cartesian topology (mx,my,mz) with mx*my*mz == nProcs
+ * which minimizes the total halo surface for the given global sizes.
+ *
+ * Topologies leading to sub-domains smaller than the ghost width are
+ * only used when there is no other choice.
+ */
+static void find_mpi_topology(int nProcs,
+			      const Kokkos::Array<int,3>& nGlobal,
+			      DimensionType dimType,
+			      int ghostWidth,
+			      int& mx, int& my, int& mz)
+{
+
+  double bestSurface = -1.0;
+  bool bestValid = false;
+
+  const int mzMax = dimType == TWO_D ? 1 : nProcs;
+
+  for (int px=1; px<=nProcs; ++px) {
+    if (nProcs % px) continue;
+    
+    for (int py=1; py<=nProcs/px; ++py) {
+      if ((nProcs/px) % py) continue;
+
+      const int pz = nProcs/(px*py);
+      if (pz > mzMax) continue;
+
+      // interface surface between sub-domains
+      const double nxg = nGlobal[IX];
+      const double nyg = nGlobal[IY];
+      const double nzg = dimType == TWO_D ? 1.0 : nGlobal[IZ];
+      const double surface =
+	(px-1)*nyg*nzg +
+	(py-1)*nxg*nzg +
+	(pz-1)*nxg*nyg;
+
+      const bool valid =
+	nGlobal[IX]/px >= ghostWidth and
+	nGlobal[IY]/py >= ghostWidth and
+	(dimType == TWO_D or nGlobal[IZ]/pz >= ghostWidth);
+
+      if ( bestSurface < 0 or
+	   (valid and !bestValid) or
+	   (valid == bestValid and surface < bestSurface) ) {
+	bestSurface = surface;
+	bestValid = valid;
+	mx = px;
+	my = py;
+	mz = pz;
+      }
+    }
+  }
+
+  if (!bestValid)
+    std::cerr << "Warning : sub-domains are smaller than ghost width\n";
+
+} // find_mpi_topology
+
 #endif // USE_MPI
 
 // =======================================================
@@ -114,6 +177,40 @@ void HydroParams::setup(ConfigMap &configMap)
     std::cerr << "Solver name not valid : " << solver_name << "\n";
     
   }
+
+  /*
+   * deep halos (SDM and MOOD, MPI only) : ghost cells wide enough for
+   * deep_halo_stages Runge-Kutta stages, so that MPI halos are exchanged
+   * once every deep_halo_stages stages; ghost cells are updated
+   * redundantly in between (see SolverBase::deep_halo_stage).
+   */
+  deepHaloStages = 1;
+#ifdef USE_MPI
+  {
+    const int stages = configMap.getInteger("mpi", "deep_halo_stages", 1);
+
+    const bool sdm =
+      solver_name.find("Hydro_Sdm") != std::string::npos ||
+      solver_name.find("Hydro_SDM") != std::string::npos;
+    const bool mood = solver_name.find("Hydro_Mood") != std::string::npos;
+
+    if (stages > 1 and (sdm or mood)) {
+
+      // ghost layers consumed by one stage : the stencil ghost width,
+      // plus for SDM one cell for the limiter (neighbor cell averages)
+      // and one for viscous terms (gradients averaged at cell borders)
+      int stageWidth = ghostWidth;
+      if (sdm and configMap.getBool("sdm", "limiter_enabled", false))
+	stageWidth++;
+      if (sdm and configMap.getFloat("hydro", "mu", 0.0) > 0)
+	stageWidth++;
+
+      deepHaloStages = stages;
+      ghostWidth = stages * stageWidth;
+
+    }
+  }
+#endif // USE_MPI
   
   /* initialize MESH parameters */
   nx = configMap.getInteger("mesh","nx", 1);
@@ -171,12 +268,19 @@ void HydroParams::setup(ConfigMap &configMap)
   
   implementationVersion  = configMap.getFloat("OTHER","implementationVersion", 0);
   if (implementationVersion != 0 and
-      implementationVersion != 1) {
-    std::cout << "Implementation version is invalid (must be 0 or 1)\n";
+      implementationVersion != 1 and
+      implementationVersion != 2) {
+    std::cout << "Implementation version is invalid (must be 0, 1 or 2)\n";
     std::cout << "Use the default : 0\n";
     implementationVersion = 0;
   }
 
+  // tile sizes for multidimensional range policies, to be tuned per
+  // backend (e.g. large tile along the unit stride direction on CPU)
+  mdrange_tile[0] = configMap.getInteger("kokkos","mdrange_tile_x", 0);
+  mdrange_tile[1] = configMap.getInteger("kokkos","mdrange_tile_y", 0);
+  mdrange_tile[2] = configMap.getInteger("kokkos","mdrange_tile_z", 0);
+
   init();
 
 #ifdef USE_MPI
@@ -194,25 +298,65 @@ void HydroParams::setup_mpi(ConfigMap& configMap)
   // runtime determination if we are using float ou double (for MPI communication)
   data_type = typeid(1.0f).name() == typeid((real_t)1.0f).name() ?
     hydroSimu::MpiComm::FLOAT : hydroSimu::MpiComm::DOUBLE;
+  storage_data_type = typeid(1.0f).name() == typeid((storage_t)1.0f).name() ?
+    hydroSimu::MpiComm::FLOAT : hydroSimu::MpiComm::DOUBLE;
   
   // MPI parameters :
   mx = configMap.getInteger("mpi", "mx", 1);
   my = configMap.getInteger("mpi", "my", 1);
   mz = configMap.getInteger("mpi", "mz", 1);
-    
+
+  /*
+   * domain decomposition mode :
+   * - manual : [mesh] nx,ny,nz are the sub-domain sizes (identical on all
+   *   MPI processes), mx*my*mz must match the number of MPI processes
+   * - auto : [mesh] nx,ny,nz are the global sizes; if mx*my*mz does not
+   *   match the number of MPI processes, the cartesian topology is chosen
+   *   to minimize halo surface. Sub-domain sizes may differ by one cell
+   *   when the global size is not divisible.
+   */
+  const std::string decomposition = configMap.getString("mpi", "decomposition", "manual");
+  const bool autoDecomposition = !decomposition.compare("auto");
+
+  // get world communicator size
+  nProcs = MpiComm::world().getNProc();
+
+  if (autoDecomposition) {
+
+    if (dimType == TWO_D)
+      mz = 1;
+
+    nGlobal[IX] = nx;
+    nGlobal[IY] = ny;
+    nGlobal[IZ] = nz;
+
+    if (nProcs != mx*my*mz)
+      find_mpi_topology(nProcs, nGlobal, dimType, ghostWidth, mx, my, mz);
+
+  } else {
+
+    nGlobal[IX] = nx*mx;
+    nGlobal[IY] = ny*my;
+    nGlobal[IZ] = nz*mz;
+
+  }
+  
   // check that parameters are consistent
   bool error = false;
   error |= (mx < 1);
   error |= (my < 1);
   error |= (mz < 1);
 
-  // get world communicator size and check it is consistent with mesh grid sizes
-  nProcs = MpiComm::world().getNProc();
+  // check MPI topology is consistent with mesh grid sizes
   if (nProcs != mx*my*mz) {
     std::cerr << "Inconsistent MPI cartesian virtual topology geometry; \n mx*my*mz must match with parameter given to mpirun !!!\n";
     
   }
 
+  // initial sub-domains : balanced number of cells (see block_offset),
+  // until the solver owns the boundaries
+  blockCuts = nullptr;
+
   // create the MPI communicator for our cartesian mesh
   if (dimType == TWO_D) {
     communicator = new MpiCommCart(mx, my, MPI_CART_PERIODIC_TRUE, MPI_REORDER_TRUE);
@@ -237,6 +381,11 @@ void HydroParams::setup_mpi(ConfigMap& configMap)
     myMpiPos[1] = mpiPos[1];
     myMpiPos[2] = mpiPos[2];
   }
+
+  /*
+   * local sub-domain sizes and location
+   */
+  update_local_sizes();
   
   /*
    * compute MPI ranks of our neighbors and 
@@ -355,25 +504,92 @@ void HydroParams::setup_mpi(ConfigMap& configMap)
 
 #endif // KOKKOS_ENABLE_CUDA
 
-    // fix space resolution :
-    // need to take into account number of MPI process in each direction
-    dx = (xmax - xmin)/(nx*mx);
-    dy = (ymax - ymin)/(ny*my);
-    dz = (zmax - zmin)/(nz*mz);
-
     // print information about current setup
     if (myRank == 0) {
       std::cout << "We are about to start simulation with the following characteristics\n";
 
       std::cout << "Global resolution : " << 
-	nx*mx << " x " << ny*my << " x " << nz*mz << "\n";
+	nGlobal[IX] << " x " << nGlobal[IY] << " x " << nGlobal[IZ] << "\n";
       std::cout << "Local  resolution : " << 
-	nx << " x " << ny << " x " << nz << "\n";
+	nx << " x " << ny << " x " << nz <<
+	(uniformBlocks ? "\n" : " (non-uniform sub-domains)\n");
       std::cout << "MPI Cartesian topology : " << mx << "x" << my << "x" << mz << std::endl;
     }
   
 } // HydroParams::setup_mpi
 
+// =======================================================
+// =======================================================
+int HydroParams::block_size(int dir, int pos) const
+{
+
+  return block_offset(dir, pos+1) - block_offset(dir, pos);
+
+} // HydroParams::block_size
+
+// =======================================================
+// =======================================================
+int HydroParams::block_offset(int dir, int pos) const
+{
+
+  if (blockCuts)
+    return blockCuts[dir][pos];
+
+  // balanced number of cells, the first n%m sub-domains along a
+  // direction get one more cell
+  const int n = nGlobal[dir];
+  const int m = dir == IX ? mx : (dir == IY ? my : mz);
+
+  return pos*(n/m) + std::min(pos, n%m);
+
+} // HydroParams::block_offset
+
+// =======================================================
+// =======================================================
+int HydroParams::block_size_max(int dir) const
+{
+
+  return blockSizeMax[dir];
+
+} // HydroParams::block_size_max
+
+// =======================================================
+// =======================================================
+void HydroParams::update_local_sizes()
+{
+
+  nx = block_size(IX, myMpiPos[IX]);
+  ny = block_size(IY, myMpiPos[IY]);
+  if (dimType == THREE_D)
+    nz = block_size(IZ, myMpiPos[IZ]);
+
+  // update ghosted sizes
+  init();
+
+  myOffset[IX] = block_offset(IX, myMpiPos[IX]);
+  myOffset[IY] = block_offset(IY, myMpiPos[IY]);
+  myOffset[IZ] = block_offset(IZ, myMpiPos[IZ]);
+
+  for (int dir=0; dir<3; ++dir) {
+    const int m = dir == IX ? mx : (dir == IY ? my : mz);
+    blockSizeMax[dir] = 0;
+    for (int pos=0; pos<m; ++pos)
+      blockSizeMax[dir] = std::max(blockSizeMax[dir], block_size(dir,pos));
+  }
+
+  uniformBlocks =
+    blockSizeMax[IX]*mx == nGlobal[IX] and
+    blockSizeMax[IY]*my == nGlobal[IY] and
+    blockSizeMax[IZ]*mz == nGlobal[IZ];
+
+  // fix space resolution :
+  // need to take into account number of MPI process in each direction
+  dx = (xmax - xmin)/nGlobal[IX];
+  dy = (ymax - ymin)/nGlobal[IY];
+  dz = (zmax - zmin)/nGlobal[IZ];
+
+} // HydroParams::update_local_sizes
+
 #endif // USE_MPI
 
 // =======================================================
@@ -115,13 +115,46 @@ struct HydroParams {
   // other parameters
   int implementationVersion=0; /*!< triggers which implementation to use (currently 3 versions)*/
 
+  //! tile sizes used by multidimensional range policies (0 means backend default)
+  Kokkos::Array<int,3> mdrange_tile;
+
+  //! location (in cells, ghosts excluded) of the local sub-domain
+  //! inside the global domain (zero in a serial run, except for AMR blocks)
+  Kokkos::Array<int,3> myOffset;
+
+  //! number of Runge-Kutta stages between two MPI halo exchanges (deep
+  //! halos, SDM and MOOD only); ghostWidth is then deepHaloStages times
+  //! the number of ghost layers consumed by one stage
+  int deepHaloStages;
+
 #ifdef USE_MPI
   //! runtime determination if we are using float ou double (for MPI communication)
   //! initialized in constructor to either MpiComm::FLOAT or MpiComm::DOUBLE
   int data_type;
 
+  //! MPI data type of the state arrays (storage_t), used for border exchange;
+  //! differs from data_type in mixed precision mode
+  int storage_data_type;
+
   //! size of the MPI cartesian grid
   int mx,my,mz;
+
+  //! global resolution (sum of the sub-domain sizes along each direction)
+  Kokkos::Array<int,3> nGlobal;
+
+  //! true when all sub-domains have the same sizes
+  bool uniformBlocks;
+
+  //! largest sub-domain size along each direction
+  Kokkos::Array<int,3> blockSizeMax;
+
+  //! sub-domain boundaries along each direction (host side, mx+1, my+1,
+  //! mz+1 values); sub-domain at MPI coordinate pos spans cells
+  //! [blockCuts[dir][pos], blockCuts[dir][pos+1][ of the global domain.
+  //! Owned by the solver (moved by dynamic load balancing) or by an
+  //! output stream, only a pointer is copied with the parameters; when
+  //! null, sub-domains are the balanced ones of setup_mpi.
+  const std::vector<int>* blockCuts;
   
   //! MPI communicator in a cartesian virtual topology
   MpiCommCart *communicator;
@@ -167,7 +200,10 @@ struct HydroParams {
     ioVTK(true), ioHDF5(false),
     settings(),
     niter_riemann(10), riemannSolverType(),
-    implementationVersion(0)
+    implementationVersion(0),
+    mdrange_tile(),
+    myOffset(),
+    deepHaloStages(1)
 #ifdef USE_MPI
     // init MPI-specific parameters...
 #endif // USE_MPI
@@ -181,6 +217,19 @@ struct HydroParams {
 #ifdef USE_MPI
   //! Initialize MPI-specific parameters
   void setup_mpi(ConfigMap& map);
+
+  //! sub-domain size along direction dir at MPI coordinate pos
+  int block_size(int dir, int pos) const;
+
+  //! sub-domain offset along direction dir at MPI coordinate pos
+  int block_offset(int dir, int pos) const;
+
+  //! largest sub-domain size along direction dir
+  int block_size_max(int dir) const;
+
+  //! update local sizes (nx,ny,nz, ghosted sizes, offsets) from
+  //! blockCuts (balanced sub-domains when null)
+  void update_local_sizes();
 #endif // USE_MPI
   
   void init();
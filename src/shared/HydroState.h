@@ -9,6 +9,18 @@ constexpr int MHD_2D_NBVAR=8;
 constexpr int MHD_3D_NBVAR=8;
 constexpr int MHD_NBVAR=8;
 
+/**
+ * Number of variables known at compile time, same value as
+ * HydroParams::nbvar; used as loop bound in computational kernels so
+ * that loops over variables can be unrolled.
+ *
+ * enum instead of static constexpr (not supported by nvcc).
+ */
+template<int dim, bool mhd=false>
+struct NbVar {
+  enum { value = mhd ? MHD_NBVAR : (dim==2 ? HYDRO_2D_NBVAR : HYDRO_3D_NBVAR) };
+};
+
 using HydroState2d = Kokkos::Array<real_t,HYDRO_2D_NBVAR>;
 using HydroState3d = Kokkos::Array<real_t,HYDRO_3D_NBVAR>;
 using MHDState     = Kokkos::Array<real_t,MHD_NBVAR>;
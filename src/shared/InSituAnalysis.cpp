@@ -0,0 +1,427 @@
+#include "InSituAnalysis.h"
+
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+#include "shared/AnalysisFunctors.h"
+
+#ifdef USE_MPI
+#include "utils/mpiUtils/MpiCommCart.h"
+#endif // USE_MPI
+
+namespace ppkMHD {
+
+// =======================================================
+// ==== CLASS InSituAnalysis IMPL ========================
+// =======================================================
+
+// =======================================================
+// =======================================================
+InSituAnalysis::InSituAnalysis(HydroParams& params,
+			       ConfigMap& configMap,
+			       const std::map<int, std::string>& variables_names) :
+  params(params),
+  configMap(configMap),
+  variables_names(variables_names)
+{
+
+  m_interval          = configMap.getInteger("analysis", "interval", 0);
+  m_integrals_enabled = configMap.getBool   ("analysis", "integrals", true);
+
+#ifdef USE_MPI
+  m_rank    = params.myRank;
+  m_nGlobal = params.nGlobal;
+#else
+  m_rank = 0;
+  m_nGlobal[IX] = params.nx;
+  m_nGlobal[IY] = params.ny;
+  m_nGlobal[IZ] = params.nz;
+#endif // USE_MPI
+
+  /*
+   * histogram
+   */
+  m_histogram_var   = -1;
+  m_histogram_nbins = configMap.getInteger("analysis", "histogram_nbins", 100);
+  m_histogram_min   = configMap.getFloat  ("analysis", "histogram_min", 0.0);
+  m_histogram_max   = configMap.getFloat  ("analysis", "histogram_max", 1.0);
+  m_histogram_log   = configMap.getBool   ("analysis", "histogram_log", false);
+
+  std::string histogram_variable =
+    configMap.getString("analysis", "histogram_variable", "");
+  if (!histogram_variable.empty()) {
+    for (const auto& var : variables_names)
+      if (var.first < params.nbvar and var.second == histogram_variable)
+	m_histogram_var = var.first;
+    if (m_histogram_var < 0 and m_rank == 0)
+      std::cerr << "[analysis] unknown histogram_variable "
+		<< histogram_variable << ", histogram disabled\n";
+  }
+  if (m_histogram_nbins < 1 or m_histogram_max <= m_histogram_min)
+    m_histogram_var = -1;
+
+  /*
+   * profile
+   */
+  std::string profile_axis = configMap.getString("analysis", "profile_axis", "");
+  m_profile_axis = -1;
+  if (profile_axis == "x")
+    m_profile_axis = IX;
+  else if (profile_axis == "y")
+    m_profile_axis = IY;
+  else if (profile_axis == "z" and params.dimType == THREE_D)
+    m_profile_axis = IZ;
+  else if (profile_axis == "r")
+    m_profile_axis = AnalysisProfileFunctor<TWO_D>::RADIAL;
+  else if (!profile_axis.empty() and m_rank == 0)
+    std::cerr << "[analysis] invalid profile_axis "
+	      << profile_axis << ", profile disabled\n";
+
+  m_profile_nbins = configMap.getInteger("analysis", "profile_nbins", 100);
+  m_profile_center[IX] = configMap.getFloat("analysis", "profile_center_x",
+					    0.5*(params.xmin+params.xmax));
+  m_profile_center[IY] = configMap.getFloat("analysis", "profile_center_y",
+					    0.5*(params.ymin+params.ymax));
+  m_profile_center[IZ] = configMap.getFloat("analysis", "profile_center_z",
+					    0.5*(params.zmin+params.zmax));
+  m_profile_rmax = configMap.getFloat("analysis", "profile_rmax",
+				      0.5*(params.xmax-params.xmin));
+  if (m_profile_axis >= 0 and m_profile_axis < 3)
+    m_profile_nbins = m_nGlobal[m_profile_axis];
+
+  /*
+   * spectrum
+   */
+  m_spectrum_kmax = configMap.getInteger("analysis", "spectrum_kmax", 0);
+
+#ifdef USE_MPI
+  const int dim = params.dimType == TWO_D ? 2 : 3;
+  const int coords[3]  = {params.myMpiPos[IX], params.myMpiPos[IY],
+			  dim == 3 ? params.myMpiPos[IZ] : 0};
+  const int mpiSize[3] = {params.mx, params.my, params.mz};
+  for (int d=0; d<3; ++d) {
+    m_line_comm[d] = MPI_COMM_NULL;
+    if (m_spectrum_kmax > 0 and d < dim) {
+      const int d1 = (d+1)%3;
+      const int d2 = (d+2)%3;
+      const int color = coords[d1] + mpiSize[d1]*coords[d2];
+      MPI_Comm_split(params.communicator->getComm(), color, coords[d],
+		     &m_line_comm[d]);
+    }
+  }
+#endif // USE_MPI
+
+} // InSituAnalysis::InSituAnalysis
+
+// =======================================================
+// =======================================================
+InSituAnalysis::~InSituAnalysis()
+{
+
+#ifdef USE_MPI
+  for (int d=0; d<3; ++d)
+    if (m_line_comm[d] != MPI_COMM_NULL)
+      MPI_Comm_free(&m_line_comm[d]);
+#endif // USE_MPI
+
+} // InSituAnalysis::~InSituAnalysis
+
+// =======================================================
+// =======================================================
+void InSituAnalysis::run(DataArray2d Udata, int iStep, double time,
+			 bool mhd_enabled)
+{
+  run_impl<TWO_D>(Udata, iStep, time, mhd_enabled);
+}
+
+// =======================================================
+// =======================================================
+void InSituAnalysis::run(DataArray3d Udata, int iStep, double time,
+			 bool mhd_enabled)
+{
+  run_impl<THREE_D>(Udata, iStep, time, mhd_enabled);
+}
+
+// =======================================================
+// =======================================================
+template<DimensionType dimType, class DataArray>
+void InSituAnalysis::run_impl(DataArray Udata, int iStep, double time,
+			      bool mhd_enabled)
+{
+
+  if (m_integrals_enabled)
+    compute_integrals<dimType>(Udata, iStep, time, mhd_enabled);
+
+  if (m_histogram_var >= 0)
+    compute_histogram<dimType>(Udata, iStep, time);
+
+  if (m_profile_axis >= 0)
+    compute_profile<dimType>(Udata, iStep, time);
+
+  if (m_spectrum_kmax > 0)
+    compute_spectrum<dimType>(Udata, iStep, time);
+
+} // InSituAnalysis::run_impl
+
+// =======================================================
+// =======================================================
+template<DimensionType dimType, class DataArray>
+void InSituAnalysis::compute_integrals(DataArray Udata, int iStep, double time,
+				       bool mhd_enabled)
+{
+
+  AnalysisIntegrals sum;
+  AnalysisIntegralsFunctor<dimType>::apply(params, Udata, mhd_enabled, sum);
+
+  std::vector<double> values = {sum.mass, sum.energy, sum.ekin, sum.enstrophy,
+				sum.emag, sum.divb_l1};
+  reduce_sum(values);
+
+  double divb_max = sum.divb_max;
+#ifdef USE_MPI
+  params.communicator->allReduce(&sum.divb_max, &divb_max, 1,
+				 hydroSimu::MpiComm::DOUBLE,
+				 hydroSimu::MpiComm::MAX);
+#endif // USE_MPI
+
+  std::string header = "# iStep time mass energy ekin enstrophy";
+  if (mhd_enabled)
+    header += " emag divb_l1 divb_max";
+
+  std::ofstream out;
+  if (!open_output(out, "integrals", header))
+    return;
+
+  out << iStep << " " << time;
+  for (int i=0; i<(mhd_enabled ? 6 : 4); ++i)
+    out << " " << values[i];
+  if (mhd_enabled)
+    out << " " << divb_max;
+  out << "\n";
+
+} // InSituAnalysis::compute_integrals
+
+// =======================================================
+// =======================================================
+template<DimensionType dimType, class DataArray>
+void InSituAnalysis::compute_histogram(DataArray Udata, int iStep, double time)
+{
+
+  Kokkos::View<double*, Device> hist("analysis_histogram", m_histogram_nbins+2);
+
+  AnalysisHistogramFunctor<dimType>::apply(params, Udata, hist,
+					   m_histogram_var,
+					   m_histogram_min, m_histogram_max,
+					   m_histogram_log);
+
+  auto hist_host = Kokkos::create_mirror_view(hist);
+  Kokkos::deep_copy(hist_host, hist);
+
+  std::vector<double> values(hist_host.data(),
+			     hist_host.data() + m_histogram_nbins+2);
+  reduce_sum(values);
+
+  std::ofstream out;
+  const std::string& name = variables_names.at(m_histogram_var);
+  if (!open_output(out, "histogram",
+		   "# bin_center pdf count (" + name +
+		   (m_histogram_log ? ", log10)" : ")")))
+    return;
+
+  double total = 0;
+  for (double v : values)
+    total += v;
+
+  const double width = (m_histogram_max-m_histogram_min)/m_histogram_nbins;
+
+  out << "# " << iStep << " " << time
+      << " below " << values[m_histogram_nbins]
+      << " above " << values[m_histogram_nbins+1] << "\n";
+  for (int b=0; b<m_histogram_nbins; ++b)
+    out << m_histogram_min + (b+0.5)*width << " "
+	<< values[b]/(total*width) << " "
+	<< values[b] << "\n";
+  out << "\n\n";
+
+} // InSituAnalysis::compute_histogram
+
+// =======================================================
+// =======================================================
+template<DimensionType dimType, class DataArray>
+void InSituAnalysis::compute_profile(DataArray Udata, int iStep, double time)
+{
+
+  const int nbvar = params.nbvar;
+  const int nbins = m_profile_nbins;
+
+  Kokkos::View<double**, Device> prof("analysis_profile", nbins, nbvar+1);
+
+  AnalysisProfileFunctor<dimType>::apply(params, Udata, prof, m_profile_axis,
+					 m_profile_center, m_profile_rmax);
+
+  // copy to a contiguous host array, whatever the device layout
+  auto prof_host = Kokkos::create_mirror_view(prof);
+  Kokkos::deep_copy(prof_host, prof);
+
+  std::vector<double> values(nbins*(nbvar+1));
+  for (int b=0; b<nbins; ++b)
+    for (int iVar=0; iVar<=nbvar; ++iVar)
+      values[b*(nbvar+1)+iVar] = prof_host(b,iVar);
+  reduce_sum(values);
+
+  std::string header = "# coordinate";
+  for (int iVar=0; iVar<nbvar; ++iVar)
+    header += " " + variables_names.at(iVar);
+  header += " volume";
+
+  std::ofstream out;
+  if (!open_output(out, "profile", header))
+    return;
+
+  const double xmin[3] = {params.xmin, params.ymin, params.zmin};
+  const double dx[3]   = {params.dx, params.dy, params.dz};
+
+  out << "# " << iStep << " " << time << "\n";
+  for (int b=0; b<nbins; ++b) {
+    const double vol = values[b*(nbvar+1)+nbvar];
+    if (vol <= 0)
+      continue;
+
+    if (m_profile_axis < 3)
+      out << xmin[m_profile_axis] + (b+0.5)*dx[m_profile_axis];
+    else
+      out << (b+0.5)*m_profile_rmax/nbins;
+
+    for (int iVar=0; iVar<nbvar; ++iVar)
+      out << " " << values[b*(nbvar+1)+iVar]/vol;
+    out << " " << vol << "\n";
+  }
+  out << "\n\n";
+
+} // InSituAnalysis::compute_profile
+
+// =======================================================
+// =======================================================
+template<DimensionType dimType, class DataArray>
+void InSituAnalysis::compute_spectrum(DataArray Udata, int iStep, double time)
+{
+
+  const int dim  = dimType == TWO_D ? 2 : 3;
+  const int kmax = m_spectrum_kmax;
+  const int n[3] = {params.nx, params.ny, params.nz};
+
+  std::vector<double> spectrum(kmax, 0.0);
+
+  for (int dir=0; dir<dim; ++dir) {
+
+    // number of local / global lines along dir
+    int nlines = 1;
+    double nlines_global = 1;
+    for (int d=0; d<dim; ++d)
+      if (d != dir) {
+	nlines *= n[d];
+	nlines_global *= m_nGlobal[d];
+      }
+
+    Kokkos::View<double**, Device> coef("analysis_spectrum", nlines*kmax, 2*dim);
+    AnalysisSpectrumFunctor<dimType>::apply(params, Udata, coef, dir,
+					    m_nGlobal[dir], kmax);
+
+    auto coef_host = Kokkos::create_mirror_view(coef);
+    Kokkos::deep_copy(coef_host, coef);
+
+    std::vector<double> values(nlines*kmax*2*dim);
+    for (int index=0; index<nlines*kmax; ++index)
+      for (int c=0; c<2*dim; ++c)
+	values[index*2*dim+c] = coef_host(index,c);
+
+    // sum partial transforms of the processes sharing the same lines
+    bool line_root = true;
+#ifdef USE_MPI
+    int line_rank;
+    MPI_Comm_rank(m_line_comm[dir], &line_rank);
+    line_root = line_rank == 0;
+    MPI_Reduce(line_root ? MPI_IN_PLACE : values.data(),
+	       values.data(), values.size(), MPI_DOUBLE, MPI_SUM,
+	       0, m_line_comm[dir]);
+#endif // USE_MPI
+
+    if (!line_root)
+      continue;
+
+    // 1D spectrum of 0.5 |v|^2, folded on positive wavenumbers
+    const double N = m_nGlobal[dir];
+    for (int index=0; index<nlines*kmax; ++index) {
+      const int k = index % kmax;
+      if (k > N/2)
+	continue;
+      const double weight = (k == 0 or 2*k == N) ? 1.0 : 2.0;
+      double e = 0;
+      for (int c=0; c<2*dim; ++c)
+	e += values[index*2*dim+c]*values[index*2*dim+c];
+      spectrum[k] += 0.5*weight*e/(N*N)/(nlines_global*dim);
+    }
+
+  } // end for dir
+
+  reduce_sum(spectrum);
+
+  std::ofstream out;
+  if (!open_output(out, "spectrum", "# k E(k)"))
+    return;
+
+  out << "# " << iStep << " " << time << "\n";
+  for (int k=0; k<kmax; ++k)
+    out << k << " " << spectrum[k] << "\n";
+  out << "\n\n";
+
+} // InSituAnalysis::compute_spectrum
+
+// =======================================================
+// =======================================================
+void InSituAnalysis::reduce_sum(std::vector<double>& values)
+{
+
+#ifdef USE_MPI
+  std::vector<double> local(values);
+  params.communicator->allReduce(local.data(), values.data(), values.size(),
+				 hydroSimu::MpiComm::DOUBLE,
+				 hydroSimu::MpiComm::SUM);
+#endif // USE_MPI
+
+} // InSituAnalysis::reduce_sum
+
+// =======================================================
+// =======================================================
+bool InSituAnalysis::open_output(std::ofstream& out,
+				 const std::string& suffix,
+				 const std::string& header)
+{
+
+  if (m_rank != 0)
+    return false;
+
+  std::string outputDir    = configMap.getString("output", "outputDir", "./");
+  std::string outputPrefix = configMap.getString("output", "outputPrefix", "output");
+  std::string filename = outputDir + "/" + outputPrefix + "_" + suffix + ".dat";
+
+  const bool created = m_files.count(suffix) == 0;
+  out.open(filename, created ? std::ios::trunc : std::ios::app);
+  if (!out) {
+    std::cerr << "[analysis] unable to open " << filename << "\n";
+    return false;
+  }
+
+  out << std::setprecision(12);
+  if (created) {
+    out << header << "\n";
+    m_files.insert(suffix);
+  }
+
+  return true;
+
+} // InSituAnalysis::open_output
+
+} // namespace ppkMHD
@@ -0,0 +1,125 @@
+#ifndef IN_SITU_ANALYSIS_H_
+#define IN_SITU_ANALYSIS_H_
+
+#include <fstream>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "shared/kokkos_shared.h"
+#include "shared/HydroParams.h"
+#include "utils/config/ConfigMap.h"
+
+#ifdef USE_MPI
+#include <mpi.h>
+#endif // USE_MPI
+
+namespace ppkMHD {
+
+/**
+ * In-situ analysis : reduced data computed on device every few time steps
+ * and appended to small text files (written by MPI rank 0), as a cheap
+ * alternative to full dumps.
+ *
+ * Parameters are read from section [analysis] :
+ * - interval : number of time steps between two analysis (0 : disabled)
+ * - integrals : global integrals (mass, total / kinetic energy, enstrophy,
+ *   and for MHD magnetic energy, L1 norm and maximum of div B),
+ *   file <outputPrefix>_integrals.dat
+ * - histogram_variable (variable name, empty : disabled), histogram_nbins,
+ *   histogram_min, histogram_max, histogram_log (bin log10 of the value) :
+ *   PDF of one variable, file <outputPrefix>_histogram.dat
+ * - profile_axis (x, y, z, r or empty : disabled), profile_nbins,
+ *   profile_center_x/y/z, profile_rmax : volume averaged profiles of all
+ *   variables along an axis or in radial shells,
+ *   file <outputPrefix>_profile.dat
+ * - spectrum_kmax (0 : disabled) : 1D kinetic energy spectrum for
+ *   wavenumbers k < kmax, averaged over all grid lines and directions,
+ *   file <outputPrefix>_spectrum.dat
+ *
+ * Ghost cells of the state must be up to date when calling run.
+ */
+class InSituAnalysis {
+
+public:
+  InSituAnalysis(HydroParams& params,
+		 ConfigMap& configMap,
+		 const std::map<int, std::string>& variables_names);
+  ~InSituAnalysis();
+
+  //! number of time steps between two analysis
+  int interval() const { return m_interval; }
+
+  void run(DataArray2d Udata, int iStep, double time, bool mhd_enabled);
+  void run(DataArray3d Udata, int iStep, double time, bool mhd_enabled);
+
+private:
+  HydroParams& params;
+  ConfigMap& configMap;
+  const std::map<int, std::string>& variables_names;
+
+  int  m_interval;
+  bool m_integrals_enabled;
+
+  //! MPI rank (0 in a serial run), only rank 0 writes output files
+  int m_rank;
+
+  //! global resolution
+  Kokkos::Array<int,3> m_nGlobal;
+
+  //! \defgroup AnalysisHistogram histogram parameters
+  //! @{
+  int    m_histogram_var; //!< -1 : disabled
+  int    m_histogram_nbins;
+  double m_histogram_min;
+  double m_histogram_max;
+  bool   m_histogram_log;
+  //! @}
+
+  //! \defgroup AnalysisProfile profile parameters
+  //! @{
+  int    m_profile_axis; //!< IX, IY, IZ, 3 (radial) or -1 (disabled)
+  int    m_profile_nbins;
+  Kokkos::Array<double,3> m_profile_center;
+  double m_profile_rmax;
+  //! @}
+
+  int m_spectrum_kmax; //!< 0 : disabled
+
+#ifdef USE_MPI
+  //! processes sharing the same grid lines along each direction
+  MPI_Comm m_line_comm[3];
+#endif // USE_MPI
+
+  //! output files already created during this run
+  std::set<std::string> m_files;
+
+  template<DimensionType dimType, class DataArray>
+  void run_impl(DataArray Udata, int iStep, double time, bool mhd_enabled);
+
+  template<DimensionType dimType, class DataArray>
+  void compute_integrals(DataArray Udata, int iStep, double time, bool mhd_enabled);
+
+  template<DimensionType dimType, class DataArray>
+  void compute_histogram(DataArray Udata, int iStep, double time);
+
+  template<DimensionType dimType, class DataArray>
+  void compute_profile(DataArray Udata, int iStep, double time);
+
+  template<DimensionType dimType, class DataArray>
+  void compute_spectrum(DataArray Udata, int iStep, double time);
+
+  //! sum values over all MPI processes (in place)
+  void reduce_sum(std::vector<double>& values);
+
+  //! open output file (rank 0 only) : truncated on first use, then
+  //! appended; header is written on creation
+  bool open_output(std::ofstream& out, const std::string& suffix,
+		   const std::string& header);
+
+}; // class InSituAnalysis
+
+} // namespace ppkMHD
+
+#endif // IN_SITU_ANALYSIS_H_
@@ -0,0 +1,664 @@
+/**
+ * \file MultiBlock.h
+ * \brief Over-decomposition of a sub-domain into several blocks.
+ */
+#ifndef MULTI_BLOCK_H_
+#define MULTI_BLOCK_H_
+
+#include <vector>
+#include <algorithm>
+
+#include "shared/HydroParams.h"
+#include "shared/kokkos_shared.h"
+#include "shared/BoundariesFunctors.h"
+#include "shared/mpiBorderUtils.h"
+
+#ifdef USE_MPI
+#include "utils/mpiUtils/MpiCommCart.h"
+#endif // USE_MPI
+
+namespace ppkMHD {
+
+/**
+ * How the ghost cells of a block face are filled.
+ */
+enum BlockFaceType {
+  BLOCK_FACE_PHYSICAL, //!< border condition (or nothing, see faceBC)
+  BLOCK_FACE_LOCAL,    //!< copy from another block of the same process
+  BLOCK_FACE_MPI       //!< exchange with a block of a neighbor process
+};
+
+/**
+ * Over-decomposition of the sub-domain of the current process into
+ * several blocks, stacked along the last direction (Y in 2D, Z in 3D),
+ * each with its own state arrays.
+ *
+ * Ghost cells shared by two blocks of the same process are filled by
+ * direct copies (no MPI). Blocks touching a neighbor process exchange
+ * their own borders with non-blocking messages, and method run
+ * advances every block as soon as all its ghost cells are up to date,
+ * so that computation on some blocks overlaps communications of the
+ * others.
+ *
+ * Exchanges are ordered as in SolverBase::make_boundaries_mpi (X, then
+ * Y, then Z; physical borders last) to get corners right.
+ */
+template<int dim>
+class MultiBlock {
+
+public:
+
+  //! Decide at compile-time which data array to use for 2d or 3d
+  using DataArray = typename std::conditional<dim==2,DataArray2d,DataArray3d>::type;
+
+  static constexpr DimensionType dimType = dim==2 ? TWO_D : THREE_D;
+
+  //! direction along which blocks are stacked
+  static constexpr int splitDir = dim-1;
+
+  struct Block {
+
+    //! same as the process parameters, except for the sizes along splitDir
+    HydroParams params;
+
+    //! first interior layer of the block inside the process sub-domain
+    int start;
+
+    //! number of interior layers along splitDir
+    int n;
+
+    //! state arrays, U[index] is read and U[1-index] written by a step
+    DataArray U[2];
+
+    BlockFaceType faceType[6];
+
+    //! source block of BLOCK_FACE_LOCAL faces
+    int faceSrc[6];
+
+    //! border conditions of physical faces (BC_COPY for the others)
+    FaceBCArray faceBC;
+
+    //! ghost cells filled by border conditions
+    GhostCellList ghostCells;
+
+#ifdef USE_MPI
+    //! border buffers of BLOCK_FACE_MPI faces
+    DataArray sendBuf[6];
+    DataArray recvBuf[6];
+#endif // USE_MPI
+
+  }; // struct Block
+
+  /**
+   * \param[in] params   parameters of the process sub-domain
+   * \param[in] nbBlocks requested number of blocks, reduced when a block
+   *                     would have less layers than ghostWidth
+   */
+  MultiBlock(HydroParams& params, int nbBlocks);
+
+  int size() const { return (int) m_blocks.size(); }
+
+  Block&       operator[](int b)       { return m_blocks[b]; }
+  const Block& operator[](int b) const { return m_blocks[b]; }
+
+  //! largest ghosted size of a block along splitDir
+  int max_ghosted_size() const;
+
+  //! copy a process-sized array (ghosts included) into U[index] of all blocks
+  void scatter(DataArray Udata, int index);
+
+  //! copy U[index] of all blocks into a process-sized array
+  void gather(DataArray Udata, int index);
+
+  /**
+   * Copy a process-sized field (e.g. gravity) into per-block fields,
+   * allocated here with the block sizes.
+   */
+  template<class Field>
+  void scatter_field(Field data, std::vector<Field>& blockData) const;
+
+  /**
+   * Fill ghost cells of U[index] of every block and call compute(b) on
+   * block b as soon as its ghost cells are ready.
+   *
+   * compute must only read U[index] (ghost cells of neighbor blocks are
+   * copied from it while other blocks are computed).
+   */
+  template<class Compute>
+  void run(int index, bool mhd_enabled, Compute compute);
+
+private:
+
+  HydroParams& params;
+
+  std::vector<Block> m_blocks;
+
+  //! copy nLayers layers along splitDir
+  static void copy_layers(DataArray dst, int dstStart,
+			  DataArray src, int srcStart,
+			  int nLayers, const Kokkos::Array<int,3>& tile)
+  {
+    CopyDataArraySlab<dimType>::apply(dst, src, splitDir,
+				      dstStart, srcStart, nLayers, tile);
+  }
+
+  //! fill ghost cells along splitDir, then physical borders
+  void finish_ghosts(int b, int index, bool mhd_enabled);
+
+  //! true when ghost cells of block b can be completed : other
+  //! directions exchanged, ghost layers along splitDir available
+  bool faces_ready(int b, const std::vector<int>& phase);
+
+#ifdef USE_MPI
+
+  /*
+   * requests: 4 per block for directions other than splitDir (send min,
+   * send max, recv min, recv max), then 4 for splitDir (first block
+   * min face, last block max face, same order).
+   */
+  std::vector<MPI_Request> m_requests;
+
+  //! message tags, side is the direction of travel (0: towards min)
+  static int tag(int b, int dir, int side) { return 700 + 8 + 8*b + 2*dir + side; }
+  static int tag_split(int side) { return 700 + side; }
+
+  //! pack faces along dir and post messages
+  void start_exchange(int b, int index, int dir);
+
+  //! unpack faces along dir
+  void finish_exchange(int b, int index, int dir);
+
+  //! post exchange along splitDir of first / last block
+  void start_split_exchange(int b, int index);
+
+  void post(DataArray buf, int peer, int tag, bool send, MPI_Request& request);
+
+#endif // USE_MPI
+
+}; // class MultiBlock
+
+// =======================================================
+// =======================================================
+template<int dim>
+MultiBlock<dim>::MultiBlock(HydroParams& params, int nbBlocks) :
+  params(params),
+  m_blocks()
+{
+
+  const int gw = params.ghostWidth;
+  const int nTotal = dim==2 ? params.ny : params.nz;
+
+  // sizes only depend on the process sizes, so that processes sharing
+  // a face have matching blocks
+  nbBlocks = std::max(1, std::min(nbBlocks, nTotal/gw));
+
+  m_blocks.resize(nbBlocks);
+
+  // physical border conditions of the process sub-domain
+  BoundaryConditionType bc[6] = {
+    params.boundary_type_xmin, params.boundary_type_xmax,
+    params.boundary_type_ymin, params.boundary_type_ymax,
+    params.boundary_type_zmin, params.boundary_type_zmax };
+
+  int start = 0;
+  for (int b=0; b<nbBlocks; ++b) {
+
+    Block& blk = m_blocks[b];
+
+    blk.start = start;
+    blk.n = nTotal/nbBlocks + (b < nTotal%nbBlocks ? 1 : 0);
+    start += blk.n;
+
+    HydroParams& bp = blk.params;
+    bp = params;
+    if (dim==2) {
+      bp.ny = blk.n;
+      bp.jmax = blk.n-1+2*gw;
+      bp.jsize = blk.n+2*gw;
+    } else {
+      bp.nz = blk.n;
+      bp.kmax = blk.n-1+2*gw;
+      bp.ksize = blk.n+2*gw;
+    }
+    bp.myOffset[splitDir] += blk.start;
+
+    for (int face=0; face<6; ++face) {
+
+      blk.faceType[face] = BLOCK_FACE_PHYSICAL;
+      blk.faceSrc[face] = -1;
+      blk.faceBC[face] = face < 2*dim ? bc[face] : BC_COPY;
+
+      const int dir = face/2;
+      const bool atMin = face%2 == 0;
+
+      if (dir >= dim)
+	continue;
+
+      // inner faces
+      if (dir == splitDir && atMin && b > 0) {
+	blk.faceType[face] = BLOCK_FACE_LOCAL;
+	blk.faceSrc[face] = b-1;
+	blk.faceBC[face] = BC_COPY;
+	continue;
+      }
+      if (dir == splitDir && !atMin && b < nbBlocks-1) {
+	blk.faceType[face] = BLOCK_FACE_LOCAL;
+	blk.faceSrc[face] = b+1;
+	blk.faceBC[face] = BC_COPY;
+	continue;
+      }
+
+      // faces of the process sub-domain; a face exchanged with the
+      // process itself (periodic) never needs MPI : blocks span the
+      // whole sub-domain along the other directions, and wrap around
+      // along splitDir
+#ifdef USE_MPI
+      const bool exchanged =
+	params.neighborsBC[face] == BC_COPY ||
+	params.neighborsBC[face] == BC_PERIODIC;
+      const bool self = exchanged && params.neighborsRank[face] == params.myRank;
+#else
+      const bool exchanged = bc[face] == BC_PERIODIC;
+      const bool self = exchanged;
+#endif // USE_MPI
+
+      if (self && dir == splitDir) {
+	blk.faceType[face] = BLOCK_FACE_LOCAL;
+	blk.faceSrc[face] = atMin ? nbBlocks-1 : 0;
+	blk.faceBC[face] = BC_COPY;
+      } else if (self) {
+	blk.faceBC[face] = BC_PERIODIC;
+      } else if (exchanged) {
+	blk.faceType[face] = BLOCK_FACE_MPI;
+	blk.faceBC[face] = BC_COPY;
+      }
+
+    } // end for face
+
+    blk.U[0] = dim==2 ?
+      DataArray("U_block",  bp.isize, bp.jsize, bp.nbvar) :
+      DataArray("U_block",  bp.isize, bp.jsize, bp.ksize, bp.nbvar);
+    blk.U[1] = dim==2 ?
+      DataArray("U2_block", bp.isize, bp.jsize, bp.nbvar) :
+      DataArray("U2_block", bp.isize, bp.jsize, bp.ksize, bp.nbvar);
+
+    blk.ghostCells = build_ghost_cell_list(bp, blk.faceBC);
+
+#ifdef USE_MPI
+    for (int face=0; face<2*dim; ++face) {
+      if (blk.faceType[face] != BLOCK_FACE_MPI)
+	continue;
+      int ext[3] = {bp.isize, bp.jsize, bp.ksize};
+      ext[face/2] = gw;
+      blk.sendBuf[face] = dim==2 ?
+	DataArray("sendBuf_block", ext[0], ext[1], bp.nbvar) :
+	DataArray("sendBuf_block", ext[0], ext[1], ext[2], bp.nbvar);
+      blk.recvBuf[face] = dim==2 ?
+	DataArray("recvBuf_block", ext[0], ext[1], bp.nbvar) :
+	DataArray("recvBuf_block", ext[0], ext[1], ext[2], bp.nbvar);
+    }
+#endif // USE_MPI
+
+  } // end for b
+
+#ifdef USE_MPI
+  m_requests.resize(4*nbBlocks+4, MPI_REQUEST_NULL);
+#endif // USE_MPI
+
+} // MultiBlock::MultiBlock
+
+// =======================================================
+// =======================================================
+template<int dim>
+int MultiBlock<dim>::max_ghosted_size() const
+{
+
+  int size = 0;
+  for (const Block& blk : m_blocks)
+    size = std::max(size, blk.n + 2*params.ghostWidth);
+
+  return size;
+
+} // MultiBlock::max_ghosted_size
+
+// =======================================================
+// =======================================================
+template<int dim>
+void MultiBlock<dim>::scatter(DataArray Udata, int index)
+{
+
+  const int gw = params.ghostWidth;
+
+  for (Block& blk : m_blocks)
+    copy_layers(blk.U[index], 0, Udata, blk.start, blk.n+2*gw,
+		params.mdrange_tile);
+
+} // MultiBlock::scatter
+
+// =======================================================
+// =======================================================
+template<int dim>
+void MultiBlock<dim>::gather(DataArray Udata, int index)
+{
+
+  const int gw = params.ghostWidth;
+  const int nb = size();
+
+  // interior layers, plus outer ghost layers of first / last block
+  for (int b=0; b<nb; ++b) {
+    const Block& blk = m_blocks[b];
+    const int lo = b==0    ? 0          : gw;
+    const int hi = b==nb-1 ? blk.n+2*gw : blk.n+gw;
+    copy_layers(Udata, blk.start+lo, blk.U[index], lo, hi-lo,
+		params.mdrange_tile);
+  }
+
+} // MultiBlock::gather
+
+// =======================================================
+// =======================================================
+template<int dim>
+template<class Field>
+void MultiBlock<dim>::scatter_field(Field data,
+				    std::vector<Field>& blockData) const
+{
+
+  const int gw = params.ghostWidth;
+
+  blockData.resize(m_blocks.size());
+
+  for (int b=0; b<size(); ++b) {
+
+    const Block& blk = m_blocks[b];
+
+    blockData[b] = dim==2 ?
+      Field(data.label(), blk.params.isize, blk.params.jsize) :
+      Field(data.label(), blk.params.isize, blk.params.jsize, blk.params.ksize);
+
+    CopyDataArraySlab<dimType,Field>::apply(blockData[b], data, splitDir,
+					    0, blk.start, blk.n+2*gw,
+					    params.mdrange_tile);
+  }
+
+} // MultiBlock::scatter_field
+
+// =======================================================
+// =======================================================
+template<int dim>
+bool MultiBlock<dim>::faces_ready(int b, const std::vector<int>& phase)
+{
+
+  const Block& blk = m_blocks[b];
+
+  // all other directions must be done for the block itself...
+  if (phase[b] < splitDir)
+    return false;
+
+  for (int face=2*splitDir; face<2*splitDir+2; ++face) {
+
+    // ...and for the blocks ghost layers are copied from
+    if (blk.faceType[face] == BLOCK_FACE_LOCAL &&
+	phase[blk.faceSrc[face]] < splitDir)
+      return false;
+
+#ifdef USE_MPI
+    if (blk.faceType[face] == BLOCK_FACE_MPI) {
+      int flag = 0;
+      MPI_Test(&m_requests[4*size() + 2 + face%2], &flag, MPI_STATUS_IGNORE);
+      if (!flag)
+	return false;
+    }
+#endif // USE_MPI
+
+  }
+
+  return true;
+
+} // MultiBlock::faces_ready
+
+// =======================================================
+// =======================================================
+template<int dim>
+void MultiBlock<dim>::finish_ghosts(int b, int index, bool mhd_enabled)
+{
+
+  const int gw = params.ghostWidth;
+  const Kokkos::Array<int,3>& tile = params.mdrange_tile;
+
+  Block& blk = m_blocks[b];
+
+  const int faceMin = 2*splitDir;
+  const int faceMax = 2*splitDir+1;
+
+  if (blk.faceType[faceMin] == BLOCK_FACE_LOCAL) {
+    const Block& src = m_blocks[blk.faceSrc[faceMin]];
+    copy_layers(blk.U[index], 0, src.U[index], src.n, gw, tile);
+  }
+
+  if (blk.faceType[faceMax] == BLOCK_FACE_LOCAL) {
+    const Block& src = m_blocks[blk.faceSrc[faceMax]];
+    copy_layers(blk.U[index], blk.n+gw, src.U[index], gw, gw, tile);
+  }
+
+#ifdef USE_MPI
+  if (blk.faceType[faceMin] == BLOCK_FACE_MPI)
+    copy_layers(blk.U[index], 0, blk.recvBuf[faceMin], 0, gw, tile);
+
+  if (blk.faceType[faceMax] == BLOCK_FACE_MPI)
+    copy_layers(blk.U[index], blk.n+gw, blk.recvBuf[faceMax], 0, gw, tile);
+#endif // USE_MPI
+
+  make_boundaries_apply<dim>(blk.params, blk.U[index],
+			     blk.ghostCells, blk.faceBC, mhd_enabled);
+
+} // MultiBlock::finish_ghosts
+
+#ifdef USE_MPI
+// =======================================================
+// =======================================================
+template<int dim>
+void MultiBlock<dim>::post(DataArray buf, int peer, int tag, bool send,
+			   MPI_Request& request)
+{
+
+  if (send)
+    request = params.communicator->Isend(buf.data(), buf.size(),
+					 params.storage_data_type, peer, tag);
+  else
+    request = params.communicator->Irecv(buf.data(), buf.size(),
+					 params.storage_data_type, peer, tag);
+
+} // MultiBlock::post
+
+// =======================================================
+// =======================================================
+template<int dim>
+void MultiBlock<dim>::start_exchange(int b, int index, int dir)
+{
+
+  const int gw = params.ghostWidth;
+
+  Block& blk = m_blocks[b];
+  const int faceMin = 2*dir;
+  const int faceMax = 2*dir+1;
+  const int n = dir==IX ? blk.params.nx : blk.params.ny;
+
+  MPI_Request* requests = &m_requests[4*b];
+
+  if (blk.faceType[faceMin] == BLOCK_FACE_MPI)
+    CopyDataArraySlab<dimType>::apply(blk.sendBuf[faceMin], blk.U[index], dir,
+				      0, gw, gw, params.mdrange_tile);
+  if (blk.faceType[faceMax] == BLOCK_FACE_MPI)
+    CopyDataArraySlab<dimType>::apply(blk.sendBuf[faceMax], blk.U[index], dir,
+				      0, n, gw, params.mdrange_tile);
+
+  Kokkos::fence();
+
+  if (blk.faceType[faceMin] == BLOCK_FACE_MPI) {
+    post(blk.recvBuf[faceMin], params.neighborsRank[faceMin], tag(b,dir,1), false, requests[2]);
+    post(blk.sendBuf[faceMin], params.neighborsRank[faceMin], tag(b,dir,0), true,  requests[0]);
+  }
+  if (blk.faceType[faceMax] == BLOCK_FACE_MPI) {
+    post(blk.recvBuf[faceMax], params.neighborsRank[faceMax], tag(b,dir,0), false, requests[3]);
+    post(blk.sendBuf[faceMax], params.neighborsRank[faceMax], tag(b,dir,1), true,  requests[1]);
+  }
+
+} // MultiBlock::start_exchange
+
+// =======================================================
+// =======================================================
+template<int dim>
+void MultiBlock<dim>::finish_exchange(int b, int index, int dir)
+{
+
+  const int gw = params.ghostWidth;
+
+  Block& blk = m_blocks[b];
+  const int faceMin = 2*dir;
+  const int faceMax = 2*dir+1;
+  const int n = dir==IX ? blk.params.nx : blk.params.ny;
+
+  if (blk.faceType[faceMin] == BLOCK_FACE_MPI)
+    CopyDataArraySlab<dimType>::apply(blk.U[index], blk.recvBuf[faceMin], dir,
+				      0, 0, gw, params.mdrange_tile);
+  if (blk.faceType[faceMax] == BLOCK_FACE_MPI)
+    CopyDataArraySlab<dimType>::apply(blk.U[index], blk.recvBuf[faceMax], dir,
+				      n+gw, 0, gw, params.mdrange_tile);
+
+} // MultiBlock::finish_exchange
+
+// =======================================================
+// =======================================================
+template<int dim>
+void MultiBlock<dim>::start_split_exchange(int b, int index)
+{
+
+  const int gw = params.ghostWidth;
+
+  Block& blk = m_blocks[b];
+  const int faceMin = 2*splitDir;
+  const int faceMax = 2*splitDir+1;
+
+  MPI_Request* requests = &m_requests[4*size()];
+
+  if (blk.faceType[faceMin] == BLOCK_FACE_MPI) {
+    copy_layers(blk.sendBuf[faceMin], 0, blk.U[index], gw, gw, params.mdrange_tile);
+    Kokkos::fence();
+    post(blk.sendBuf[faceMin], params.neighborsRank[faceMin], tag_split(0), true, requests[0]);
+  }
+
+  if (blk.faceType[faceMax] == BLOCK_FACE_MPI) {
+    copy_layers(blk.sendBuf[faceMax], 0, blk.U[index], blk.n, gw, params.mdrange_tile);
+    Kokkos::fence();
+    post(blk.sendBuf[faceMax], params.neighborsRank[faceMax], tag_split(1), true, requests[1]);
+  }
+
+} // MultiBlock::start_split_exchange
+#endif // USE_MPI
+
+// =======================================================
+// =======================================================
+template<int dim>
+template<class Compute>
+void MultiBlock<dim>::run(int index, bool mhd_enabled, Compute compute)
+{
+
+  const int nb = size();
+
+  // number of directions (other than splitDir) already exchanged
+  std::vector<int> phase(nb, 0);
+  std::vector<char> done(nb, 0);
+
+#ifdef USE_MPI
+
+  // receive ghost layers along splitDir as early as possible
+  {
+    MPI_Request* requests = &m_requests[4*nb];
+    Block& first = m_blocks[0];
+    Block& last  = m_blocks[nb-1];
+    const int faceMin = 2*splitDir;
+    const int faceMax = 2*splitDir+1;
+
+    if (first.faceType[faceMin] == BLOCK_FACE_MPI)
+      post(first.recvBuf[faceMin], params.neighborsRank[faceMin], tag_split(1), false, requests[2]);
+    if (last.faceType[faceMax] == BLOCK_FACE_MPI)
+      post(last.recvBuf[faceMax], params.neighborsRank[faceMax], tag_split(0), false, requests[3]);
+  }
+
+  for (int b=0; b<nb; ++b)
+    start_exchange(b, index, IX);
+
+#else
+
+  for (int b=0; b<nb; ++b)
+    phase[b] = splitDir;
+
+#endif // USE_MPI
+
+  int remaining = nb;
+
+  while (remaining > 0) {
+
+    bool progress = false;
+
+#ifdef USE_MPI
+    // advance exchanges along directions other than splitDir
+    for (int b=0; b<nb; ++b) {
+
+      while (phase[b] < splitDir) {
+
+	int flag = 0;
+	MPI_Testall(4, &m_requests[4*b], &flag, MPI_STATUSES_IGNORE);
+	if (!flag)
+	  break;
+
+	finish_exchange(b, index, phase[b]);
+	phase[b]++;
+	progress = true;
+
+	if (phase[b] < splitDir)
+	  start_exchange(b, index, phase[b]);
+	else
+	  start_split_exchange(b, index);
+
+      }
+
+    } // end for b
+#endif // USE_MPI
+
+    // advance ready blocks
+    for (int b=0; b<nb; ++b) {
+
+      if (done[b] || !faces_ready(b, phase))
+	continue;
+
+      finish_ghosts(b, index, mhd_enabled);
+
+      compute(b);
+
+      done[b] = 1;
+      remaining--;
+      progress = true;
+
+    } // end for b
+
+#ifdef USE_MPI
+    // nothing to do but wait for a message
+    if (!progress) {
+      int which;
+      MPI_Waitany(m_requests.size(), m_requests.data(), &which, MPI_STATUS_IGNORE);
+    }
+#endif // USE_MPI
+
+  } // end while
+
+#ifdef USE_MPI
+  // send buffers along splitDir are reused at next step
+  MPI_Waitall(4, &m_requests[4*nb], MPI_STATUSES_IGNORE);
+#endif // USE_MPI
+
+} // MultiBlock::run
+
+} // namespace ppkMHD
+
+#endif // MULTI_BLOCK_H_
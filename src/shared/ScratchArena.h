@@ -0,0 +1,167 @@
+/**
+ * \file ScratchArena.h
+ * \brief Work arrays sharing memory according to their lifetime within
+ * a time step.
+ */
+#ifndef SCRATCH_ARENA_H_
+#define SCRATCH_ARENA_H_
+
+#include <vector>
+#include <functional>
+#include <algorithm>
+
+#include "shared/kokkos_shared.h"
+
+namespace ppkMHD {
+
+/**
+ * Memory arena for the temporaries of a numerical scheme.
+ *
+ * A time step is described as a sequence of phases (numbered by the
+ * solver); each work array is declared with the first phase where it
+ * is written and the last phase where it is read. All arrays are then
+ * placed in a single allocation, arrays whose lifetimes do not overlap
+ * sharing the same memory, so that the footprint is the peak over the
+ * phases instead of the sum of all arrays.
+ *
+ * An array must be entirely written (at least everywhere it is read
+ * later) during its first phase, since it may start with the content
+ * of another array. The arena is zero-filled when allocated.
+ *
+ * Usage : declare all arrays, then call allocate() which binds the
+ * declared views to the arena (unmanaged views). The arena must
+ * outlive these views.
+ */
+class ScratchArena {
+
+public:
+
+  ScratchArena() : m_buffers(), m_pool(), m_size(0) {}
+
+  /**
+   * Declare a work array, bound to view by allocate().
+   *
+   * \param[out] view  array to be bound to the arena
+   * \param[in]  first first phase where the array is used
+   * \param[in]  last  last phase where the array is used
+   * \param[in]  dims  array extents
+   */
+  template<class View, class... Dims>
+  void declare(View& view, int first, int last, Dims... dims)
+  {
+    Buffer b;
+    b.bytes  = View::required_allocation_size(dims...);
+    b.first  = first;
+    b.last   = last;
+    b.offset = 0;
+    b.bind   = [&view, dims...](void* ptr) {
+      view = View(reinterpret_cast<typename View::pointer_type>(ptr), dims...);
+    };
+    m_buffers.push_back(b);
+  }
+
+  /**
+   * Place all declared arrays, allocate the arena and bind the views.
+   * A previous arena is released : views bound to it and not declared
+   * again must not be used anymore.
+   */
+  void allocate();
+
+  //! forget all declared arrays (before declaring them again, e.g.
+  //! with new sizes)
+  void clear() { m_buffers.clear(); }
+
+  //! actual footprint (bytes)
+  size_t size() const { return m_size; }
+
+  //! footprint without aliasing (bytes)
+  size_t requested_size() const;
+
+private:
+
+  //! alignment of arrays inside the arena (bytes)
+  static constexpr size_t alignment = 256;
+
+  struct Buffer {
+    size_t bytes;
+    int first, last;
+    size_t offset;
+    std::function<void(void*)> bind;
+  }; // struct Buffer
+
+  std::vector<Buffer> m_buffers;
+
+  //! the arena (double for alignment)
+  Kokkos::View<double*, Device> m_pool;
+
+  size_t m_size;
+
+}; // class ScratchArena
+
+// =======================================================
+// =======================================================
+inline void ScratchArena::allocate()
+{
+
+  // largest arrays first, each one at the lowest offset not overlapping
+  // a placed array alive at the same time
+  std::vector<int> order(m_buffers.size());
+  for (size_t b=0; b<order.size(); ++b)
+    order[b] = (int) b;
+  std::stable_sort(order.begin(), order.end(), [this](int a, int b) {
+      return m_buffers[a].bytes > m_buffers[b].bytes; });
+
+  m_size = 0;
+
+  for (size_t n=0; n<order.size(); ++n) {
+
+    Buffer& buf = m_buffers[order[n]];
+
+    // memory ranges already taken during the lifetime of buf
+    std::vector<std::pair<size_t,size_t> > taken;
+    for (size_t p=0; p<n; ++p) {
+      const Buffer& other = m_buffers[order[p]];
+      if (other.first <= buf.last && buf.first <= other.last)
+	taken.push_back(std::make_pair(other.offset, other.offset+other.bytes));
+    }
+    std::sort(taken.begin(), taken.end());
+
+    size_t offset = 0;
+    for (const auto& range : taken) {
+      if (offset + buf.bytes <= range.first)
+	break;
+      offset = std::max(offset,
+			(range.second + alignment-1) / alignment * alignment);
+    }
+
+    buf.offset = offset;
+    m_size = std::max(m_size, offset + buf.bytes);
+
+  }
+
+  m_pool = Kokkos::View<double*, Device>();
+  m_pool = Kokkos::View<double*, Device>("scratch arena",
+					 (m_size + sizeof(double)-1) / sizeof(double));
+
+  char* base = reinterpret_cast<char*>(m_pool.data());
+  for (Buffer& buf : m_buffers)
+    buf.bind(base + buf.offset);
+
+} // ScratchArena::allocate
+
+// =======================================================
+// =======================================================
+inline size_t ScratchArena::requested_size() const
+{
+
+  size_t size = 0;
+  for (const Buffer& buf : m_buffers)
+    size += buf.bytes;
+
+  return size;
+
+} // ScratchArena::requested_size
+
+} // namespace ppkMHD
+
+#endif // SCRATCH_ARENA_H_
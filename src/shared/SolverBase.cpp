@@ -1,14 +1,21 @@
 #include "SolverBase.h"
 
+#include <algorithm> // for std::min, std::max, std::copy
+#include <sstream>
+#include <vector>
+
 #include "shared/utils.h"
-#include "shared/BoundariesFunctors.h"
 
 #ifdef USE_MPI
 #include "shared/mpiBorderUtils.h"
+#include "shared/mpiHaloCompression.h"
+#include "shared/load_balancing_utils.h"
 #include "utils/mpiUtils/MpiCommCart.h"
 #endif // USE_MPI
 
 #include "utils/io/IO_ReadWrite.h"
+#include "utils/io/IO_Streams.h"
+#include "shared/InSituAnalysis.h"
 
 namespace ppkMHD {
 
@@ -35,6 +42,32 @@ SolverBase::SolverBase (HydroParams& params, ConfigMap& configMap) :
   m_times_saved = 0;
   m_nCells = -1;
   m_nDofsPerCell = -1;
+
+  m_ghost_cells_ready[0] = false;
+  m_ghost_cells_ready[1] = false;
+
+#ifdef USE_MPI
+  // the solver owns the sub-domain boundaries from now on (initially the
+  // balanced ones of HydroParams::setup_mpi)
+  for (int dir=0; dir<3; ++dir) {
+    const int m = dir == IX ? params.mx : (dir == IY ? params.my : params.mz);
+    m_block_cuts[dir].resize(m+1);
+    for (int pos=0; pos<=m; ++pos)
+      m_block_cuts[dir][pos] = params.block_offset(dir, pos);
+  }
+  params.blockCuts = m_block_cuts;
+#endif // USE_MPI
+
+  m_deep_halo_stages = params.deepHaloStages;
+  m_deep_halo_age    = m_deep_halo_stages;
+  m_stage_params     = params;
+
+#ifdef USE_MPI
+  m_shared_halo_ready = false;
+  m_node_comm = MPI_COMM_NULL;
+  for (int d=0; d<3; ++d)
+    m_halo_win[d] = MPI_WIN_NULL;
+#endif // USE_MPI
   
   // create the timers
   timers[TIMER_TOTAL]      = std::make_shared<Timer>();
@@ -53,6 +86,17 @@ SolverBase::SolverBase (HydroParams& params, ConfigMap& configMap) :
   m_variables_names[IB] = "by"; // mag field Y
   m_variables_names[IC] = "bz"; // mag field Z
 
+  // in-situ analysis
+  if (configMap.getInteger("analysis", "interval", 0) > 0)
+    m_analysis = std::make_shared<InSituAnalysis>(params, configMap, m_variables_names);
+
+  // additional output streams
+  if (!configMap.getString("output", "streams", "").empty()) {
+    m_output_streams = std::make_shared<io::OutputStreams>(params, configMap, m_variables_names);
+    if (!m_output_streams->enabled())
+      m_output_streams.reset();
+  }
+
   // init io reader/writer is/should/must be called outside of constructor
   // right now we moved that in SolverFactory's method create
   //init_io();
@@ -92,6 +136,8 @@ SolverBase::SolverBase (HydroParams& params, ConfigMap& configMap) :
     borderBufRecv_zmin_3d = DataArray3d("borderBufRecv_zmin", isize, jsize,    gw, nbvar);
     borderBufRecv_zmax_3d = DataArray3d("borderBufRecv_zmax", isize, jsize,    gw, nbvar);
   }
+
+  init_halo_precision();
 #endif // USE_MPI
   
 } // SolverBase::SolverBase
@@ -103,6 +149,16 @@ SolverBase::~SolverBase()
 
   // m_io_reader_writer is now a shared (managed) pointer
   //delete m_io_reader_writer;
+
+#ifdef USE_MPI
+  free_shared_halo();
+  if (m_node_comm != MPI_COMM_NULL)
+    MPI_Comm_free(&m_node_comm);
+
+  // params outlives the solver
+  if (params.blockCuts == m_block_cuts)
+    params.blockCuts = nullptr;
+#endif // USE_MPI
   
 } // SolverBase::~SolverBase
 
@@ -139,6 +195,28 @@ SolverBase::read_config()
       m_point_gravity_enabled;
     // || m_self_gravity_enabled;
 
+  /*
+   * Dynamic load balancing (MPI only) : every load_balancing_interval
+   * time steps, sub-domain boundaries are moved when the most loaded MPI
+   * process exceeds the mean cost by more than load_balancing_threshold.
+   */
+  m_load_balancing_supported = false;
+  m_load_balancing_interval  = configMap.getInteger("mpi", "load_balancing_interval", 0);
+  m_load_balancing_threshold = configMap.getFloat  ("mpi", "load_balancing_threshold", 0.1);
+  m_load_balancing_cost      = 0.0;
+
+#ifdef USE_MPI
+  /*
+   * Halo exchange between MPI processes on the same node through MPI-3
+   * shared memory windows (border buffers must be in host memory).
+   * Disabled by default (opt-in).
+   */
+  m_shared_halo_enabled = configMap.getBool("mpi", "shared_memory_halo", false);
+#ifdef KOKKOS_ENABLE_CUDA
+  m_shared_halo_enabled = false;
+#endif // KOKKOS_ENABLE_CUDA
+#endif // USE_MPI
+
 } // SolverBase::read_config
 
 // =======================================================
@@ -213,6 +291,18 @@ SolverBase::next_iteration()
   ++m_iteration;
   m_t += m_dt;
 
+#ifdef USE_MPI
+  if (m_load_balancing_interval > 0 and
+      m_iteration % m_load_balancing_interval == 0)
+    load_balancing();
+#endif // USE_MPI
+
+  if (m_analysis and m_iteration % m_analysis->interval() == 0)
+    run_analysis_impl();
+
+  if (m_output_streams and m_output_streams->should_save(m_iteration))
+    save_streams_impl();
+
 } // SolverBase::next_iteration
 
 // =======================================================
@@ -256,10 +346,90 @@ SolverBase::read_restart_file()
   
 } // SolverBase::read_restart_file
 
+// =======================================================
+// =======================================================
+void
+SolverBase::run_analysis_impl()
+{
+
+  // This is application dependent
+
+} // SolverBase::run_analysis_impl
+
+// =======================================================
+// =======================================================
+void
+SolverBase::run_analysis(DataArray2d U, bool mhd_enabled)
+{
+
+  timers[TIMER_IO]->start();
+  m_analysis->run(U, m_iteration, m_t, mhd_enabled);
+
+  timers[TIMER_IO]->stop();
+
+} // SolverBase::run_analysis - 2d
+
+// =======================================================
+// =======================================================
+void
+SolverBase::run_analysis(DataArray3d U, bool mhd_enabled)
+{
+
+  timers[TIMER_IO]->start();
+  m_analysis->run(U, m_iteration, m_t, mhd_enabled);
+
+  timers[TIMER_IO]->stop();
+
+} // SolverBase::run_analysis - 3d
+
+// =======================================================
+// =======================================================
+void
+SolverBase::save_streams_impl()
+{
+
+  // This is application dependent
+
+} // SolverBase::save_streams_impl
+
+// =======================================================
+// =======================================================
+void
+SolverBase::save_streams(DataArray2d U)
+{
+
+  timers[TIMER_IO]->start();
+  m_output_streams->save(U, m_iteration, m_t);
+  timers[TIMER_IO]->stop();
+
+} // SolverBase::save_streams - 2d
+
+// =======================================================
+// =======================================================
+void
+SolverBase::save_streams(DataArray3d U)
+{
+
+  timers[TIMER_IO]->start();
+  m_output_streams->save(U, m_iteration, m_t);
+  timers[TIMER_IO]->stop();
+
+} // SolverBase::save_streams - 3d
+
 // =======================================================
 // =======================================================
 int
 SolverBase::should_save_solution()
+{
+
+  return should_save_solution_at(m_t);
+
+} // SolverBase::should_save_solution
+
+// =======================================================
+// =======================================================
+int
+SolverBase::should_save_solution_at(double t)
 {
   
   double interval = m_tEnd / params.nOutput;
@@ -270,18 +440,39 @@ SolverBase::should_save_solution()
     return 1;
   }
 
-  if ((m_t - (m_times_saved - 1) * interval) > interval) {
+  if ((t - (m_times_saved - 1) * interval) > interval) {
     return 1;
   }
 
   /* always write the last time step */
-  if (ISFUZZYNULL (m_t - m_tEnd)) {
+  if (ISFUZZYNULL (t - m_tEnd)) {
     return 1;
   }
 
   return 0;
   
-} // SolverBase::should_save_solution
+} // SolverBase::should_save_solution_at
+
+// =======================================================
+// =======================================================
+int
+SolverBase::steps_before_next_event(int nSteps)
+{
+
+  for (int s=1; s<nSteps; ++s) {
+
+    const int iStep = m_iteration + s;
+
+    if ((params.enableOutput && should_save_solution_at(m_t + s*m_dt)) ||
+	(m_analysis && iStep % m_analysis->interval() == 0) ||
+	(m_output_streams && m_output_streams->should_save(iStep)))
+      return s;
+
+  }
+
+  return nSteps;
+
+} // SolverBase::steps_before_next_event
 
 // =======================================================
 // =======================================================
@@ -342,167 +533,120 @@ SolverBase::load_data(DataArray3d             U,
 // =======================================================
 // =======================================================
 void
-SolverBase::make_boundary(DataArray2d Udata, FaceIdType faceId, bool mhd_enabled)
+SolverBase::init_ghost_cells(bool skip_mpi_faces)
 {
 
-  const int ghostWidth=params.ghostWidth;
-  int nbIter = ghostWidth*std::max(params.isize,params.jsize);
-
-  if (faceId == FACE_XMIN) {
-
-    if (mhd_enabled) {
-    
-      MakeBoundariesFunctor2D_MHD<FACE_XMIN>::apply(params, Udata, nbIter);
-            
-    } else {
-
-      MakeBoundariesFunctor2D<FACE_XMIN>::apply(params, Udata, nbIter);
-
-    }
-
-  }
-    
-  if (faceId == FACE_XMAX) {
-
-    if (mhd_enabled) {
-    
-      MakeBoundariesFunctor2D_MHD<FACE_XMAX>::apply(params, Udata, nbIter);
-            
-    } else {
+  const int index = skip_mpi_faces ? 1 : 0;
 
-      MakeBoundariesFunctor2D<FACE_XMAX>::apply(params, Udata, nbIter);
+  FaceBCArray& faceBC = m_ghost_faces_bc[index];
 
-    }
+  faceBC[FACE_XMIN] = params.boundary_type_xmin;
+  faceBC[FACE_XMAX] = params.boundary_type_xmax;
+  faceBC[FACE_YMIN] = params.boundary_type_ymin;
+  faceBC[FACE_YMAX] = params.boundary_type_ymax;
+  faceBC[FACE_ZMIN] = params.boundary_type_zmin;
+  faceBC[FACE_ZMAX] = params.boundary_type_zmax;
 
+  if (params.dimType == TWO_D) {
+    faceBC[FACE_ZMIN] = BC_COPY;
+    faceBC[FACE_ZMAX] = BC_COPY;
   }
 
-  if (faceId == FACE_YMIN) {
-
-    if (mhd_enabled) {
-    
-      MakeBoundariesFunctor2D_MHD<FACE_YMIN>::apply(params, Udata, nbIter);
-            
-    } else {
-
-      MakeBoundariesFunctor2D<FACE_YMIN>::apply(params, Udata, nbIter);
-
+#ifdef USE_MPI
+  // faces exchanged with a neighbor are not physical borders
+  if (skip_mpi_faces) {
+    for (int face=0; face<6; ++face) {
+      if (params.neighborsBC[face] == BC_COPY ||
+	  params.neighborsBC[face] == BC_PERIODIC)
+	faceBC[face] = BC_COPY;
     }
-
   }
+#endif // USE_MPI
 
-  if (faceId == FACE_YMAX) {
-
-    if (mhd_enabled) {
-    
-      MakeBoundariesFunctor2D_MHD<FACE_YMAX>::apply(params, Udata, nbIter);
-            
-    } else {
-
-      MakeBoundariesFunctor2D<FACE_YMAX>::apply(params, Udata, nbIter);
+  m_ghost_cells[index] = build_ghost_cell_list(params, faceBC);
+  m_ghost_cells_ready[index] = true;
 
-    }
-
-  }
-  
-} // SolverBase::make_boundary - 2d
+} // SolverBase::init_ghost_cells
 
 // =======================================================
 // =======================================================
-void
-SolverBase::make_boundary(DataArray3d Udata, FaceIdType faceId, bool mhd_enabled)
+bool
+SolverBase::deep_halo_stage()
 {
-  
-  const int ghostWidth=params.ghostWidth;
-  
-  int max_size = std::max(params.isize,params.jsize);
-  max_size = std::max(max_size,params.ksize);
-  int nbIter = ghostWidth * max_size * max_size;
-
-  if (faceId == FACE_XMIN) {
-
-    if (mhd_enabled) {
-    
-      MakeBoundariesFunctor3D_MHD<FACE_XMIN>::apply(params, Udata, nbIter);
-            
-    } else {
-
-      MakeBoundariesFunctor3D<FACE_XMIN>::apply(params, Udata, nbIter);
-
-    }
-
-  }
-    
-  if (faceId == FACE_XMAX) {
-
-    if (mhd_enabled) {
-    
-      MakeBoundariesFunctor3D_MHD<FACE_XMAX>::apply(params, Udata, nbIter);
-            
-    } else {
 
-      MakeBoundariesFunctor3D<FACE_XMAX>::apply(params, Udata, nbIter);
+  m_stage_params = params;
 
-    }
+  if (m_deep_halo_stages <= 1)
+    return true;
 
+  bool exchange = false;
+  if (m_deep_halo_age >= m_deep_halo_stages) {
+    exchange = true;
+    m_deep_halo_age = 0;
   }
-
-  if (faceId == FACE_YMIN) {
-
-    if (mhd_enabled) {
-    
-      MakeBoundariesFunctor3D_MHD<FACE_YMIN>::apply(params, Udata, nbIter);
-            
-    } else {
-
-      MakeBoundariesFunctor3D<FACE_YMIN>::apply(params, Udata, nbIter);
-
-    }
-
+  ++m_deep_halo_age;
+
+  // ghost layers consumed by one stage, and ghost layers to be updated
+  // by the current stage (zero for the last stage before an exchange)
+  const int width = params.ghostWidth / m_deep_halo_stages;
+  const int extra = (m_deep_halo_stages - m_deep_halo_age) * width;
+
+  // same cells, same cell coordinates : only the interior grows
+  HydroParams& p = m_stage_params;
+  p.ghostWidth -= extra;
+  p.nx += 2*extra;
+  p.ny += 2*extra;
+  p.xmin -= extra*p.dx;
+  p.xmax += extra*p.dx;
+  p.ymin -= extra*p.dy;
+  p.ymax += extra*p.dy;
+  if (params.dimType == THREE_D) {
+    p.nz += 2*extra;
+    p.zmin -= extra*p.dz;
+    p.zmax += extra*p.dz;
   }
 
-  if (faceId == FACE_YMAX) {
-
-    if (mhd_enabled) {
-    
-      MakeBoundariesFunctor3D_MHD<FACE_YMAX>::apply(params, Udata, nbIter);
-            
-    } else {
-
-      MakeBoundariesFunctor3D<FACE_YMAX>::apply(params, Udata, nbIter);
-
-    }
-
-  }
+  return exchange;
 
-  if (faceId == FACE_ZMIN) {
+} // SolverBase::deep_halo_stage
 
-    if (mhd_enabled) {
-    
-      MakeBoundariesFunctor3D_MHD<FACE_ZMIN>::apply(params, Udata, nbIter);
-            
-    } else {
+// =======================================================
+// =======================================================
+void
+SolverBase::make_boundaries_physical(DataArray2d Udata, bool mhd_enabled,
+				     bool skip_mpi_faces)
+{
 
-      MakeBoundariesFunctor3D<FACE_ZMIN>::apply(params, Udata, nbIter);
+  const int index = skip_mpi_faces ? 1 : 0;
 
-    }
+  if (!m_ghost_cells_ready[index])
+    init_ghost_cells(skip_mpi_faces);
 
-  }
+  make_boundaries_apply<2>(params, Udata,
+			   m_ghost_cells[index],
+			   m_ghost_faces_bc[index],
+			   mhd_enabled);
 
-  if (faceId == FACE_ZMAX) {
+} // SolverBase::make_boundaries_physical - 2d
 
-    if (mhd_enabled) {
-    
-      MakeBoundariesFunctor3D_MHD<FACE_ZMAX>::apply(params, Udata, nbIter);
-            
-    } else {
+// =======================================================
+// =======================================================
+void
+SolverBase::make_boundaries_physical(DataArray3d Udata, bool mhd_enabled,
+				     bool skip_mpi_faces)
+{
 
-      MakeBoundariesFunctor3D<FACE_ZMAX>::apply(params, Udata, nbIter);
+  const int index = skip_mpi_faces ? 1 : 0;
 
-    }
+  if (!m_ghost_cells_ready[index])
+    init_ghost_cells(skip_mpi_faces);
 
-  }
+  make_boundaries_apply<3>(params, Udata,
+			   m_ghost_cells[index],
+			   m_ghost_faces_bc[index],
+			   mhd_enabled);
 
-} // SolverBase::make_boundary - 3d
+} // SolverBase::make_boundaries_physical - 3d
 
 // =======================================================
 // =======================================================
@@ -510,10 +654,7 @@ void
 SolverBase::make_boundaries_serial(DataArray2d Udata, bool mhd_enabled)
 {
 
-  make_boundary(Udata, FACE_XMIN, mhd_enabled);
-  make_boundary(Udata, FACE_XMAX, mhd_enabled);
-  make_boundary(Udata, FACE_YMIN, mhd_enabled);
-  make_boundary(Udata, FACE_YMAX, mhd_enabled);
+  make_boundaries_physical(Udata, mhd_enabled, false);
   
 } // SolverBase::make_boundaries_serial - 2d
   
@@ -523,12 +664,7 @@ void
 SolverBase::make_boundaries_serial(DataArray3d Udata, bool mhd_enabled)
 {
 
-  make_boundary(Udata, FACE_XMIN, mhd_enabled);
-  make_boundary(Udata, FACE_XMAX, mhd_enabled);
-  make_boundary(Udata, FACE_YMIN, mhd_enabled);
-  make_boundary(Udata, FACE_YMAX, mhd_enabled);
-  make_boundary(Udata, FACE_ZMIN, mhd_enabled);
-  make_boundary(Udata, FACE_ZMAX, mhd_enabled);
+  make_boundaries_physical(Udata, mhd_enabled, false);
     
 } // SolverBase::make_boundaries_serial - 3d
 
@@ -544,7 +680,9 @@ SolverBase::make_boundaries_mpi(DataArray2d Udata, bool mhd_enabled)
   // for each direction:
   // 1. copy boundary to MPI buffer
   // 2. send/recv buffer
-  // 3. test if BC is BC_PERIODIC / BC_COPY then ... else ..
+  // 3. test if BC is BC_PERIODIC / BC_COPY then copy back
+  // physical borders are filled afterwards, in a single launch,
+  // corners included
 
   // ======
   // XDIR
@@ -555,15 +693,11 @@ SolverBase::make_boundaries_mpi(DataArray2d Udata, bool mhd_enabled)
   if (params.neighborsBC[X_MIN] == BC_COPY ||
       params.neighborsBC[X_MIN] == BC_PERIODIC) {
     copy_boundaries_back(Udata, XMIN);
-  } else {
-    make_boundary(Udata, FACE_XMIN, mhd_enabled);
   }
   
   if (params.neighborsBC[X_MAX] == BC_COPY ||
       params.neighborsBC[X_MAX] == BC_PERIODIC) {
     copy_boundaries_back(Udata, XMAX);
-  } else {
-    make_boundary(Udata, FACE_XMAX, mhd_enabled);
   }
   
   params.communicator->synchronize();
@@ -577,18 +711,19 @@ SolverBase::make_boundaries_mpi(DataArray2d Udata, bool mhd_enabled)
   if (params.neighborsBC[Y_MIN] == BC_COPY ||
       params.neighborsBC[Y_MIN] == BC_PERIODIC) {
     copy_boundaries_back(Udata, YMIN);
-  } else {
-    make_boundary(Udata, FACE_YMIN, mhd_enabled);
   }
   
   if (params.neighborsBC[Y_MAX] == BC_COPY ||
       params.neighborsBC[Y_MAX] == BC_PERIODIC) {
     copy_boundaries_back(Udata, YMAX);
-  } else {
-    make_boundary(Udata, FACE_YMAX, mhd_enabled);
   }
   
   params.communicator->synchronize();
+
+  // ======
+  // physical borders
+  // ======
+  make_boundaries_physical(Udata, mhd_enabled, true);
   
 } // SolverBase::make_boundaries_mpi - 2d
 
@@ -609,15 +744,11 @@ SolverBase::make_boundaries_mpi(DataArray3d Udata, bool mhd_enabled)
   if (params.neighborsBC[X_MIN] == BC_COPY ||
       params.neighborsBC[X_MIN] == BC_PERIODIC) {
     copy_boundaries_back(Udata, XMIN);
-  } else {
-    make_boundary(Udata, FACE_XMIN, mhd_enabled);
   }
   
   if (params.neighborsBC[X_MAX] == BC_COPY ||
       params.neighborsBC[X_MAX] == BC_PERIODIC) {
     copy_boundaries_back(Udata, XMAX);
-  } else {
-    make_boundary(Udata, FACE_XMAX, mhd_enabled);
   }
   
   params.communicator->synchronize();
@@ -631,15 +762,11 @@ SolverBase::make_boundaries_mpi(DataArray3d Udata, bool mhd_enabled)
   if (params.neighborsBC[Y_MIN] == BC_COPY ||
       params.neighborsBC[Y_MIN] == BC_PERIODIC) {
     copy_boundaries_back(Udata, YMIN);
-  } else {
-    make_boundary(Udata, FACE_YMIN, mhd_enabled);
   }
   
   if (params.neighborsBC[Y_MAX] == BC_COPY ||
       params.neighborsBC[Y_MAX] == BC_PERIODIC) {
     copy_boundaries_back(Udata, YMAX);
-  } else {
-    make_boundary(Udata, FACE_YMAX, mhd_enabled);
   }
   
   params.communicator->synchronize();
@@ -653,47 +780,248 @@ SolverBase::make_boundaries_mpi(DataArray3d Udata, bool mhd_enabled)
   if (params.neighborsBC[Z_MIN] == BC_COPY ||
       params.neighborsBC[Z_MIN] == BC_PERIODIC) {
     copy_boundaries_back(Udata, ZMIN);
-  } else {
-    make_boundary(Udata, FACE_ZMIN, mhd_enabled);
   }
   
   if (params.neighborsBC[Z_MAX] == BC_COPY ||
       params.neighborsBC[Z_MAX] == BC_PERIODIC) {
     copy_boundaries_back(Udata, ZMAX);
-  } else {
-    make_boundary(Udata, FACE_ZMAX, mhd_enabled);
   }
   
   params.communicator->synchronize();
 
+  // ======
+  // physical borders
+  // ======
+  make_boundaries_physical(Udata, mhd_enabled, true);
+
 } // SolverBase::make_boundaries_mpi - 3d
 
+// =======================================================
+// =======================================================
+void
+SolverBase::init_halo_precision()
+{
+
+  m_halo_exchange_count = 0;
+  m_halo_check_active   = false;
+
+  const std::string precision = configMap.getString("mpi", "halo_precision", "full");
+
+  if (!precision.compare("float")) {
+    m_halo_precision = HALO_PRECISION_FLOAT;
+  } else if (!precision.compare("fixed16")) {
+    m_halo_precision = HALO_PRECISION_FIXED16;
+  } else if (!precision.compare("fixed32")) {
+    m_halo_precision = HALO_PRECISION_FIXED32;
+  } else {
+    if (precision.compare("full") and params.myRank==0)
+      std::cout << "[mpi] halo_precision " << precision << " is not valid, using full\n";
+    m_halo_precision = HALO_PRECISION_FULL;
+  }
+
+  // variables kept at full precision (comma separated names)
+  m_halo_full_mask = 0;
+  std::istringstream names(configMap.getString("mpi", "halo_full_precision_variables", ""));
+  std::string name;
+  while (std::getline(names, name, ',')) {
+
+    name.erase(0, name.find_first_not_of(" \t"));
+    name.erase(name.find_last_not_of(" \t")+1);
+    if (name.empty())
+      continue;
+
+    bool found = false;
+    for (int iVar=0; iVar<params.nbvar; ++iVar) {
+      if (!m_variables_names[iVar].compare(name)) {
+	m_halo_full_mask |= 1 << iVar;
+	found = true;
+      }
+    }
+
+    if (!found and params.myRank==0)
+      std::cout << "[mpi] halo_full_precision_variables : unknown variable " << name << "\n";
+
+  }
+
+  m_halo_check_interval  = configMap.getInteger("mpi", "halo_check_interval", 0);
+  m_halo_check_tolerance = configMap.getFloat  ("mpi", "halo_check_tolerance", 1e-4);
+
+  // shared memory halos read full precision send buffers in place
+  if (m_halo_precision != HALO_PRECISION_FULL and m_shared_halo_enabled) {
+    if (params.myRank==0)
+      std::cout << "[mpi] shared_memory_halo is disabled by halo_precision\n";
+    m_shared_halo_enabled = false;
+  }
+
+} // SolverBase::init_halo_precision
+
+// =======================================================
+// =======================================================
+void
+SolverBase::halo_exchange_begin()
+{
+
+  using namespace hydroSimu;
+
+  if (m_halo_check_active) {
+
+    const int nbvar = params.nbvar;
+
+    auto error_host = Kokkos::create_mirror_view(m_halo_error);
+    Kokkos::deep_copy(error_host, m_halo_error);
+
+    std::vector<double> local(error_host.data(), error_host.data()+2*nbvar);
+    std::vector<double> global(2*nbvar);
+    params.communicator->allReduce(local.data(), global.data(), 2*nbvar,
+				   MpiComm::DOUBLE, MpiComm::MAX);
+
+    // error relative to the largest value of each variable
+    double errMax = 0;
+    std::ostringstream report;
+    for (int iVar=0; iVar<nbvar; ++iVar) {
+      const double err = global[2*iVar+1] > 0 ? global[2*iVar]/global[2*iVar+1] : 0;
+      errMax = std::max(errMax, err);
+      report << " " << m_variables_names[iVar] << "=" << err;
+    }
+
+    if (params.myRank==0)
+      std::cout << "Halo precision check (exchange " << m_halo_exchange_count-1
+		<< ") : max relative error" << report.str() << "\n";
+
+    if (errMax > m_halo_check_tolerance) {
+      if (params.myRank==0)
+	std::cout << "Halo precision check : error above tolerance "
+		  << m_halo_check_tolerance << ", using full precision halo\n";
+      m_halo_precision = HALO_PRECISION_FULL;
+    }
+
+    m_halo_check_active = false;
+
+  }
+
+  if (m_halo_precision == HALO_PRECISION_FULL)
+    return;
+
+  m_halo_check_active =
+    m_halo_check_interval > 0 and
+    m_halo_exchange_count % m_halo_check_interval == 0;
+  ++m_halo_exchange_count;
+
+  if (m_halo_check_active) {
+    if (m_halo_error.extent(0) != 2*params.nbvar)
+      m_halo_error = Kokkos::View<double*, Device>("HaloError", 2*params.nbvar);
+    Kokkos::deep_copy(m_halo_error, 0.0);
+  }
+
+} // SolverBase::halo_exchange_begin
+
+// =======================================================
+// =======================================================
+void
+SolverBase::transfert_halo_messages(Direction dir)
+{
+
+  using namespace hydroSimu;
+
+  const int locMin = 2*(dir-1);
+  const int locMax = locMin+1;
+  const int tag    = 100*dir+11;
+
+  const NeighborLocation nMin = static_cast<NeighborLocation>(locMin);
+  const NeighborLocation nMax = static_cast<NeighborLocation>(locMax);
+
+  // neighbors along dir have the same border sizes
+  for (int loc=locMin; loc<=locMax; ++loc)
+    if (m_halo_recv[loc].extent(0) != m_halo_send[loc].extent(0))
+      m_halo_recv[loc] = HaloMessage("HaloMessageRecv",
+				   m_halo_send[loc].extent(0));
+
+  params.communicator->sendrecv(m_halo_send[locMin].data(),
+				m_halo_send[locMin].extent(0),
+				MpiComm::CHAR, halo_peer_rank(nMin), tag,
+				m_halo_recv[locMax].data(),
+				m_halo_recv[locMax].extent(0),
+				MpiComm::CHAR, halo_peer_rank(nMax), tag);
+
+  params.communicator->sendrecv(m_halo_send[locMax].data(),
+				m_halo_send[locMax].extent(0),
+				MpiComm::CHAR, halo_peer_rank(nMax), tag,
+				m_halo_recv[locMin].data(),
+				m_halo_recv[locMin].extent(0),
+				MpiComm::CHAR, halo_peer_rank(nMin), tag);
+
+} // SolverBase::transfert_halo_messages
+
+// =======================================================
+// =======================================================
+template<BoundaryLocation loc, DimensionType dimType, class DataArray>
+void
+SolverBase::pack_border(DataArray Udata, DataArray b)
+{
+
+  const int gw = params.ghostWidth;
+
+  if (m_halo_precision != HALO_PRECISION_FULL)
+    pack_halo_message<loc, dimType>(m_halo_precision, Udata, b,
+				    m_halo_send[loc], m_halo_range[loc],
+				    params.nbvar, m_halo_full_mask,
+				    gw, params.mdrange_tile);
+
+  if (m_halo_precision == HALO_PRECISION_FULL or m_halo_check_active)
+    CopyDataArray_To_BorderBuf<loc, dimType>::apply(b, Udata, gw, params.mdrange_tile);
+
+} // SolverBase::pack_border
+
+// =======================================================
+// =======================================================
+template<BoundaryLocation loc, DimensionType dimType, class DataArray>
+void
+SolverBase::unpack_border(DataArray Udata, DataArray b)
+{
+
+  const int gw = params.ghostWidth;
+
+  if (m_halo_precision == HALO_PRECISION_FULL) {
+    CopyBorderBuf_To_DataArray<loc, dimType>::apply(Udata, b, gw, params.mdrange_tile);
+    return;
+  }
+
+  unpack_halo_message<loc, dimType>(m_halo_precision, Udata, b,
+				    m_halo_recv[loc],
+				    params.nbvar, m_halo_full_mask,
+				    gw, params.mdrange_tile);
+
+  if (m_halo_check_active)
+    compare_halo_message<loc, dimType>(Udata, b, m_halo_error,
+				       params.nbvar, gw, params.mdrange_tile);
+
+} // SolverBase::unpack_border
+
 // =======================================================
 // =======================================================
 void
 SolverBase::copy_boundaries(DataArray2d Udata, Direction dir)
 {
 
-  const int isize = params.isize;
-  const int jsize = params.jsize;
-  //const int ksize = params.ksize;
-  const int gw    = params.ghostWidth;
+  // first direction of a new exchange
+  if (dir == XDIR)
+    halo_exchange_begin();
+
+  // send buffers must be bound to shared windows before being filled
+  if (m_shared_halo_enabled and !m_shared_halo_ready)
+    init_shared_halo();
 
   if (dir == XDIR) {
     
-    const int nbIter = gw * jsize;
-    
-    CopyDataArray_To_BorderBuf<XMIN, TWO_D>::apply(borderBufSend_xmin_2d, Udata, gw, nbIter);
-    CopyDataArray_To_BorderBuf<XMAX, TWO_D>::apply(borderBufSend_xmax_2d, Udata, gw, nbIter);
+    pack_border<XMIN, TWO_D>(Udata, borderBufSend_xmin_2d);
+    pack_border<XMAX, TWO_D>(Udata, borderBufSend_xmax_2d);
     
   }
 
   else if (dir == YDIR) {
     
-    const int nbIter = isize * gw;
-    
-    CopyDataArray_To_BorderBuf<YMIN, TWO_D>::apply(borderBufSend_ymin_2d, Udata, gw, nbIter);
-    CopyDataArray_To_BorderBuf<YMAX, TWO_D>::apply(borderBufSend_ymax_2d, Udata, gw, nbIter);
+    pack_border<YMIN, TWO_D>(Udata, borderBufSend_ymin_2d);
+    pack_border<YMAX, TWO_D>(Udata, borderBufSend_ymax_2d);
     
   }
 
@@ -707,34 +1035,31 @@ void
 SolverBase::copy_boundaries(DataArray3d Udata, Direction dir)
 {
 
-  const int isize = params.isize;
-  const int jsize = params.jsize;
-  const int ksize = params.ksize;
-  const int gw    = params.ghostWidth;
+  // first direction of a new exchange
+  if (dir == XDIR)
+    halo_exchange_begin();
+
+  // send buffers must be bound to shared windows before being filled
+  if (m_shared_halo_enabled and !m_shared_halo_ready)
+    init_shared_halo();
 
   if (dir == XDIR) {
     
-    const int nbIter = gw * jsize * ksize;
-    
-    CopyDataArray_To_BorderBuf<XMIN, THREE_D>::apply(borderBufSend_xmin_3d, Udata, gw, nbIter);
-    CopyDataArray_To_BorderBuf<XMAX, THREE_D>::apply(borderBufSend_xmax_3d, Udata, gw, nbIter);
+    pack_border<XMIN, THREE_D>(Udata, borderBufSend_xmin_3d);
+    pack_border<XMAX, THREE_D>(Udata, borderBufSend_xmax_3d);
   }
 
   else if (dir == YDIR) {
     
-    const int nbIter = isize * gw * ksize;
-    
-    CopyDataArray_To_BorderBuf<YMIN, THREE_D>::apply(borderBufSend_ymin_3d, Udata, gw, nbIter);
-    CopyDataArray_To_BorderBuf<YMAX, THREE_D>::apply(borderBufSend_ymax_3d, Udata, gw, nbIter);
+    pack_border<YMIN, THREE_D>(Udata, borderBufSend_ymin_3d);
+    pack_border<YMAX, THREE_D>(Udata, borderBufSend_ymax_3d);
     
   }
   
   else if (dir == ZDIR) {
     
-    const int nbIter = isize * jsize * gw;
-    
-    CopyDataArray_To_BorderBuf<ZMIN, THREE_D>::apply(borderBufSend_zmin_3d, Udata, gw, nbIter);
-    CopyDataArray_To_BorderBuf<ZMAX, THREE_D>::apply(borderBufSend_zmax_3d, Udata, gw, nbIter);
+    pack_border<ZMIN, THREE_D>(Udata, borderBufSend_zmin_3d);
+    pack_border<ZMAX, THREE_D>(Udata, borderBufSend_zmax_3d);
     
   }
 
@@ -748,10 +1073,23 @@ void
 SolverBase::transfert_boundaries_2d(Direction dir)
 {
 
-  const int data_type = params.data_type;
+  const int data_type = params.storage_data_type;
 
   using namespace hydroSimu;
-  
+
+  // neighbors on the same node read our send buffers in place : wait
+  // until theirs are filled
+  if (m_shared_halo_enabled)
+    shared_halo_sync(dir);
+
+  // reduced-precision messages (full precision border buffers are sent
+  // as well when the exchange is checked)
+  if (m_halo_precision != HALO_PRECISION_FULL) {
+    transfert_halo_messages(dir);
+    if (!m_halo_check_active)
+      return;
+  }
+
   /*
    * use MPI_Sendrecv
    */
@@ -762,33 +1100,33 @@ SolverBase::transfert_boundaries_2d(Direction dir)
 
     params.communicator->sendrecv(borderBufSend_xmin_2d.data(),
 				  borderBufSend_xmin_2d.size(),
-				  data_type, params.neighborsRank[X_MIN], 111,
+				  data_type, halo_peer_rank(X_MIN), 111,
 				  borderBufRecv_xmax_2d.data(),
 				  borderBufRecv_xmax_2d.size(),
-				  data_type, params.neighborsRank[X_MAX], 111);
+				  data_type, halo_peer_rank(X_MAX), 111);
     
     params.communicator->sendrecv(borderBufSend_xmax_2d.data(),
 				  borderBufSend_xmax_2d.size(),
-				  data_type, params.neighborsRank[X_MAX], 111,
+				  data_type, halo_peer_rank(X_MAX), 111,
 				  borderBufRecv_xmin_2d.data(),
 				  borderBufRecv_xmin_2d.size(),
-				  data_type, params.neighborsRank[X_MIN], 111);
+				  data_type, halo_peer_rank(X_MIN), 111);
     
   } else if (dir == YDIR) {
 
     params.communicator->sendrecv(borderBufSend_ymin_2d.data(),
 				  borderBufSend_ymin_2d.size(),
-				  data_type, params.neighborsRank[Y_MIN], 211,
+				  data_type, halo_peer_rank(Y_MIN), 211,
 				  borderBufRecv_ymax_2d.data(),
 				  borderBufRecv_ymax_2d.size(),
-				  data_type, params.neighborsRank[Y_MAX], 211);
+				  data_type, halo_peer_rank(Y_MAX), 211);
     
     params.communicator->sendrecv(borderBufSend_ymax_2d.data(),
 				  borderBufSend_ymax_2d.size(),
-				  data_type, params.neighborsRank[Y_MAX], 211,
+				  data_type, halo_peer_rank(Y_MAX), 211,
 				  borderBufRecv_ymin_2d.data(),
 				  borderBufRecv_ymin_2d.size(),
-				  data_type, params.neighborsRank[Y_MIN], 211);
+				  data_type, halo_peer_rank(Y_MIN), 211);
   }
   
 } // SolverBase::transfert_boundaries_2d
@@ -799,102 +1137,284 @@ void
 SolverBase::transfert_boundaries_3d(Direction dir)
 {
 
-  const int data_type = params.data_type;
+  const int data_type = params.storage_data_type;
 
   using namespace hydroSimu;
 
+  // neighbors on the same node read our send buffers in place : wait
+  // until theirs are filled
+  if (m_shared_halo_enabled)
+    shared_halo_sync(dir);
+
+  // reduced-precision messages (full precision border buffers are sent
+  // as well when the exchange is checked)
+  if (m_halo_precision != HALO_PRECISION_FULL) {
+    transfert_halo_messages(dir);
+    if (!m_halo_check_active)
+      return;
+  }
+
   if (dir == XDIR) {
 
     params.communicator->sendrecv(borderBufSend_xmin_3d.data(),
 				  borderBufSend_xmin_3d.size(),
-				  data_type, params.neighborsRank[X_MIN], 111,
+				  data_type, halo_peer_rank(X_MIN), 111,
 				  borderBufRecv_xmax_3d.data(),
 				  borderBufRecv_xmax_3d.size(),
-				  data_type, params.neighborsRank[X_MAX], 111);
+				  data_type, halo_peer_rank(X_MAX), 111);
     
     params.communicator->sendrecv(borderBufSend_xmax_3d.data(),
 				  borderBufSend_xmax_3d.size(),
-				  data_type, params.neighborsRank[X_MAX], 111,
+				  data_type, halo_peer_rank(X_MAX), 111,
 				  borderBufRecv_xmin_3d.data(),
 				  borderBufRecv_xmin_3d.size(),
-				  data_type, params.neighborsRank[X_MIN], 111);
+				  data_type, halo_peer_rank(X_MIN), 111);
 
   } else if (dir == YDIR) {
 
     params.communicator->sendrecv(borderBufSend_ymin_3d.data(),
 				  borderBufSend_ymin_3d.size(),
-				  data_type, params.neighborsRank[Y_MIN], 211,
+				  data_type, halo_peer_rank(Y_MIN), 211,
 				  borderBufRecv_ymax_3d.data(),
 				  borderBufRecv_ymax_3d.size(),
-				  data_type, params.neighborsRank[Y_MAX], 211);
+				  data_type, halo_peer_rank(Y_MAX), 211);
     
     params.communicator->sendrecv(borderBufSend_ymax_3d.data(),
 				  borderBufSend_ymax_3d.size(),
-				  data_type, params.neighborsRank[Y_MAX], 211,
+				  data_type, halo_peer_rank(Y_MAX), 211,
 				  borderBufRecv_ymin_3d.data(),
 				  borderBufRecv_ymin_3d.size(),
-				  data_type, params.neighborsRank[Y_MIN], 211);
+				  data_type, halo_peer_rank(Y_MIN), 211);
 
   } else if (dir == ZDIR) {
 
     params.communicator->sendrecv(borderBufSend_zmin_3d.data(),
 				  borderBufSend_zmin_3d.size(),
-				  data_type, params.neighborsRank[Z_MIN], 311,
+				  data_type, halo_peer_rank(Z_MIN), 311,
 				  borderBufRecv_zmax_3d.data(),
 				  borderBufRecv_zmax_3d.size(),
-				  data_type, params.neighborsRank[Z_MAX], 311);
+				  data_type, halo_peer_rank(Z_MAX), 311);
     
     params.communicator->sendrecv(borderBufSend_zmax_3d.data(),
 				  borderBufSend_zmax_3d.size(),
-				  data_type, params.neighborsRank[Z_MAX], 311,
+				  data_type, halo_peer_rank(Z_MAX), 311,
 				  borderBufRecv_zmin_3d.data(),
 				  borderBufRecv_zmin_3d.size(),
-				  data_type, params.neighborsRank[Z_MIN], 311);
+				  data_type, halo_peer_rank(Z_MIN), 311);
 
   }
   
 } // SolverBase::transfert_boundaries_3d
 
+// =======================================================
+// =======================================================
+/**
+ * Allocate a shared window holding the two send buffers of one
+ * direction (min side first), bind the send buffers to it, and alias the
+ * receive buffers facing a neighbor on the same node to the matching
+ * send buffer of that neighbor (neighbors along a direction share the
+ * same border buffer sizes).
+ */
+template<class DataArray>
+static void bind_shared_halo(MPI_Comm nodeComm,
+			     MPI_Win& win,
+			     int nodeRankMin,
+			     int nodeRankMax,
+			     DataArray& sendMin, DataArray& sendMax,
+			     DataArray& recvMin, DataArray& recvMax)
+{
+
+  using value_t = typename DataArray::non_const_value_type;
+
+  const size_t n = sendMin.size();
+
+  value_t* base = nullptr;
+  MPI_Win_allocate_shared(2*n*sizeof(value_t), sizeof(value_t),
+			  MPI_INFO_NULL, nodeComm, &base, &win);
+  MPI_Win_lock_all(MPI_MODE_NOCHECK, win);
+
+  sendMin = DataArray(base,   sendMin.layout());
+  sendMax = DataArray(base+n, sendMax.layout());
+
+  MPI_Aint size;
+  int      dispUnit;
+  value_t* peer;
+
+  // lower neighbor sends its max side to us
+  if (nodeRankMin != MPI_UNDEFINED) {
+    MPI_Win_shared_query(win, nodeRankMin, &size, &dispUnit, &peer);
+    recvMin = DataArray(peer+n, recvMin.layout());
+  }
+
+  // upper neighbor sends its min side to us
+  if (nodeRankMax != MPI_UNDEFINED) {
+    MPI_Win_shared_query(win, nodeRankMax, &size, &dispUnit, &peer);
+    recvMax = DataArray(peer,   recvMax.layout());
+  }
+
+} // bind_shared_halo
+
 // =======================================================
 // =======================================================
 void
-SolverBase::copy_boundaries_back(DataArray2d Udata, BoundaryLocation loc)
+SolverBase::init_shared_halo()
 {
 
-  const int isize = params.isize;
-  const int jsize = params.jsize;
-  //const int ksize = params.ksize;
-  const int gw    = params.ghostWidth;
+  using namespace hydroSimu;
+
+  free_shared_halo();
+
+  // identify neighbors sharing memory with current process
+  if (m_node_comm == MPI_COMM_NULL) {
+
+    MPI_Comm comm = params.communicator->getComm();
+
+    MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, params.myRank,
+			MPI_INFO_NULL, &m_node_comm);
+
+    MPI_Group group, nodeGroup;
+    MPI_Comm_group(comm, &group);
+    MPI_Comm_group(m_node_comm, &nodeGroup);
+
+    int ranks[6];
+    for (int n=0; n<6; ++n)
+      ranks[n] = params.neighborsRank[n];
+
+    MPI_Group_translate_ranks(group, params.nNeighbors, ranks,
+			      nodeGroup, m_neighbors_node_rank.data());
+
+    for (int n=params.nNeighbors; n<6; ++n)
+      m_neighbors_node_rank[n] = MPI_UNDEFINED;
+
+    MPI_Group_free(&group);
+    MPI_Group_free(&nodeGroup);
+
+  }
+
+  const Kokkos::Array<int,6>& nr = m_neighbors_node_rank;
+
+  if (params.dimType == TWO_D) {
+
+    bind_shared_halo(m_node_comm, m_halo_win[0], nr[X_MIN], nr[X_MAX],
+		     borderBufSend_xmin_2d, borderBufSend_xmax_2d,
+		     borderBufRecv_xmin_2d, borderBufRecv_xmax_2d);
+    bind_shared_halo(m_node_comm, m_halo_win[1], nr[Y_MIN], nr[Y_MAX],
+		     borderBufSend_ymin_2d, borderBufSend_ymax_2d,
+		     borderBufRecv_ymin_2d, borderBufRecv_ymax_2d);
+
+  } else {
+
+    bind_shared_halo(m_node_comm, m_halo_win[0], nr[X_MIN], nr[X_MAX],
+		     borderBufSend_xmin_3d, borderBufSend_xmax_3d,
+		     borderBufRecv_xmin_3d, borderBufRecv_xmax_3d);
+    bind_shared_halo(m_node_comm, m_halo_win[1], nr[Y_MIN], nr[Y_MAX],
+		     borderBufSend_ymin_3d, borderBufSend_ymax_3d,
+		     borderBufRecv_ymin_3d, borderBufRecv_ymax_3d);
+    bind_shared_halo(m_node_comm, m_halo_win[2], nr[Z_MIN], nr[Z_MAX],
+		     borderBufSend_zmin_3d, borderBufSend_zmax_3d,
+		     borderBufRecv_zmin_3d, borderBufRecv_zmax_3d);
+
+  }
+
+  m_shared_halo_ready = true;
+
+} // SolverBase::init_shared_halo
+
+// =======================================================
+// =======================================================
+/**
+ * Pairwise synchronization with the neighbors along direction dir that
+ * share memory with current process (zero byte messages in both
+ * directions) : on return, their send buffers along dir are filled and
+ * visible. Processes on other nodes, or along other directions, are not
+ * waited for.
+ *
+ * Send buffers are only refilled at the next exchange along dir, after
+ * the communicator synchronization that ends each direction of
+ * make_boundaries_mpi, i.e. after neighbors have read them.
+ */
+void
+SolverBase::shared_halo_sync(Direction dir)
+{
+
+  const int d   = dir-1;
+  const int tag = 100*dir+13;
+
+  const int nodeRankMin = m_neighbors_node_rank[2*d];
+  const int nodeRankMax = m_neighbors_node_rank[2*d+1];
+  const int peerMin = nodeRankMin == MPI_UNDEFINED ? MPI_PROC_NULL : nodeRankMin;
+  const int peerMax = nodeRankMax == MPI_UNDEFINED ? MPI_PROC_NULL : nodeRankMax;
+
+  MPI_Win_sync(m_halo_win[d]);
+
+  MPI_Sendrecv(nullptr, 0, MPI_BYTE, peerMin, tag,
+	       nullptr, 0, MPI_BYTE, peerMax, tag,
+	       m_node_comm, MPI_STATUS_IGNORE);
+  MPI_Sendrecv(nullptr, 0, MPI_BYTE, peerMax, tag,
+	       nullptr, 0, MPI_BYTE, peerMin, tag,
+	       m_node_comm, MPI_STATUS_IGNORE);
+
+  MPI_Win_sync(m_halo_win[d]);
+
+} // SolverBase::shared_halo_sync
+
+// =======================================================
+// =======================================================
+void
+SolverBase::free_shared_halo()
+{
+
+  for (int d=0; d<3; ++d) {
+    if (m_halo_win[d] != MPI_WIN_NULL) {
+      MPI_Win_unlock_all(m_halo_win[d]);
+      MPI_Win_free(&m_halo_win[d]);
+    }
+  }
+
+  m_shared_halo_ready = false;
+
+} // SolverBase::free_shared_halo
+
+// =======================================================
+// =======================================================
+int
+SolverBase::halo_peer_rank(hydroSimu::NeighborLocation loc) const
+{
+
+  if (m_shared_halo_enabled and m_neighbors_node_rank[loc] != MPI_UNDEFINED)
+    return MPI_PROC_NULL;
+
+  return params.neighborsRank[loc];
+
+} // SolverBase::halo_peer_rank
+
+// =======================================================
+// =======================================================
+void
+SolverBase::copy_boundaries_back(DataArray2d Udata, BoundaryLocation loc)
+{
 
   if (loc == XMIN) {
     
-    const int nbIter = gw * jsize;
-    
-    CopyBorderBuf_To_DataArray<XMIN, TWO_D>::apply(Udata, borderBufRecv_xmin_2d, gw, nbIter);
+    unpack_border<XMIN, TWO_D>(Udata, borderBufRecv_xmin_2d);
 
   }
 
   if (loc == XMAX) {
 
-    const int nbIter = gw * jsize;
-    
-    CopyBorderBuf_To_DataArray<XMAX, TWO_D>::apply(Udata, borderBufRecv_xmax_2d, gw, nbIter);
+    unpack_border<XMAX, TWO_D>(Udata, borderBufRecv_xmax_2d);
     
   }
 
   if (loc == YMIN) {
     
-    const int nbIter = isize * gw;
-    
-    CopyBorderBuf_To_DataArray<YMIN, TWO_D>::apply(Udata, borderBufRecv_ymin_2d, gw, nbIter);
+    unpack_border<YMIN, TWO_D>(Udata, borderBufRecv_ymin_2d);
 
   }
 
   if (loc == YMAX) {
     
-    const int nbIter = isize * gw;
-
-    CopyBorderBuf_To_DataArray<YMAX, TWO_D>::apply(Udata, borderBufRecv_ymax_2d, gw, nbIter);
+    unpack_border<YMAX, TWO_D>(Udata, borderBufRecv_ymax_2d);
     
   }
   
@@ -906,63 +1426,355 @@ void
 SolverBase::copy_boundaries_back(DataArray3d Udata, BoundaryLocation loc)
 {
 
-  const int isize = params.isize;
-  const int jsize = params.jsize;
-  const int ksize = params.ksize;
-  const int gw    = params.ghostWidth;
-
   if (loc == XMIN) {
     
-    const int nbIter = gw * jsize * ksize;
-    
-    CopyBorderBuf_To_DataArray<XMIN, THREE_D>::apply(Udata, borderBufRecv_xmin_3d, gw, nbIter);
+    unpack_border<XMIN, THREE_D>(Udata, borderBufRecv_xmin_3d);
 
   }
 
   if (loc == XMAX) {
 
-    const int nbIter = gw * jsize * ksize;
-    
-    CopyBorderBuf_To_DataArray<XMAX, THREE_D>::apply(Udata, borderBufRecv_xmax_3d, gw, nbIter);
+    unpack_border<XMAX, THREE_D>(Udata, borderBufRecv_xmax_3d);
     
   }
 
   if (loc == YMIN) {
     
-    const int nbIter = isize * gw * ksize;
-    
-    CopyBorderBuf_To_DataArray<YMIN, THREE_D>::apply(Udata, borderBufRecv_ymin_3d, gw, nbIter);
+    unpack_border<YMIN, THREE_D>(Udata, borderBufRecv_ymin_3d);
 
   }
 
   if (loc == YMAX) {
     
-    const int nbIter = isize * gw * ksize;
-    
-    CopyBorderBuf_To_DataArray<YMAX, THREE_D>::apply(Udata, borderBufRecv_ymax_3d, gw, nbIter);
+    unpack_border<YMAX, THREE_D>(Udata, borderBufRecv_ymax_3d);
     
   }
   
   if (loc == ZMIN) {
     
-    const int nbIter = isize * jsize * gw;
-    
-    CopyBorderBuf_To_DataArray<ZMIN, THREE_D>::apply(Udata, borderBufRecv_zmin_3d, gw, nbIter);
+    unpack_border<ZMIN, THREE_D>(Udata, borderBufRecv_zmin_3d);
 
   }
 
   if (loc == ZMAX) {
     
-    const int nbIter = isize * jsize * gw;
-
-    CopyBorderBuf_To_DataArray<ZMAX, THREE_D>::apply(Udata, borderBufRecv_zmax_3d, gw, nbIter);
+    unpack_border<ZMAX, THREE_D>(Udata, borderBufRecv_zmax_3d);
     
   }
   
 } // SolverBase::copy_boundaries_back - 3d
 
+// =======================================================
+// =======================================================
+void
+SolverBase::load_balancing()
+{
+
+  if (!m_load_balancing_supported)
+    return;
+
+  using namespace hydroSimu;
+
+  // cost of the numerical scheme since previous call
+  const double elapsed = timers[TIMER_NUM_SCHEME]->elapsed();
+  double cost = elapsed - m_load_balancing_cost;
+  m_load_balancing_cost = elapsed;
+
+  double costMax, costSum;
+  params.communicator->allReduce(&cost, &costMax, 1, MpiComm::DOUBLE, MpiComm::MAX);
+  params.communicator->allReduce(&cost, &costSum, 1, MpiComm::DOUBLE, MpiComm::SUM);
+
+  const double costMean = costSum / params.nProcs;
+
+  if ( costMean <= 0 or
+       costMax <= (1.0 + m_load_balancing_threshold) * costMean )
+    return;
+
+  bool moved = false;
+
+  for (int dir=0; dir<params.nDim; ++dir) {
+
+    const int m = dir == IX ? params.mx : (dir == IY ? params.my : params.mz);
+    if (m < 2)
+      continue;
+
+    const int pos = params.myMpiPos[dir];
+
+    // cost of each slab of MPI processes along dir
+    std::vector<double> slabCostLocal(m, 0.0);
+    std::vector<double> slabCost(m, 0.0);
+    slabCostLocal[pos] = cost;
+    params.communicator->allReduce(slabCostLocal.data(), slabCost.data(), m,
+				   MpiComm::DOUBLE, MpiComm::SUM);
+
+    std::vector<int>& cuts = m_block_cuts[dir];
+
+    std::vector<int> newCuts;
+    if ( !compute_balanced_cuts(cuts.data(), slabCost,
+				params.ghostWidth, newCuts) )
+      continue;
+
+    const int shiftMin = newCuts[pos]   - cuts[pos];
+    const int shiftMax = newCuts[pos+1] - cuts[pos+1];
+
+    load_balancing_migrate(dir, shiftMin, shiftMax);
+
+    cuts = newCuts;
+    params.update_local_sizes();
+
+    moved = true;
+
+  } // end for dir
+
+  if (!moved)
+    return;
+
+  resize_border_buffers();
+
+  m_ghost_cells_ready[0] = false;
+  m_ghost_cells_ready[1] = false;
+
+  deep_halo_reset();
+
+  load_balancing_resize();
+
+  if (params.myRank == 0)
+    printf("load balancing step=%7d (imbalance % 5.2f)\n",
+	   m_iteration, costMax / costMean);
+
+} // SolverBase::load_balancing
+
+// =======================================================
+// =======================================================
+void
+SolverBase::load_balancing_migrate(int dir, int shiftMin, int shiftMax)
+{
+
+  UNUSED(dir);
+  UNUSED(shiftMin);
+  UNUSED(shiftMax);
+
+  // This is application dependent
+
+} // SolverBase::load_balancing_migrate
+
+// =======================================================
+// =======================================================
+void
+SolverBase::load_balancing_resize()
+{
+
+  // This is application dependent
+
+} // SolverBase::load_balancing_resize
+
+// =======================================================
+// =======================================================
+static DataArray2d slab_array(const std::string& label,
+			      DataArray2d U, int dir, int n)
+{
+  int ext[2] = {(int) U.extent(0), (int) U.extent(1)};
+  ext[dir] = n;
+  return DataArray2d(label, ext[0], ext[1], U.extent(2));
+}
+
+static DataArray3d slab_array(const std::string& label,
+			      DataArray3d U, int dir, int n)
+{
+  int ext[3] = {(int) U.extent(0), (int) U.extent(1), (int) U.extent(2)};
+  ext[dir] = n;
+  return DataArray3d(label, ext[0], ext[1], ext[2], U.extent(3));
+}
+
+/**
+ * Resize U along dir, keeping cells which stay on current MPI process,
+ * and exchanging migrating layers with the two neighbors along dir.
+ *
+ * shiftMin (resp. shiftMax) is the displacement of the lower (resp.
+ * upper) sub-domain boundary : a positive shiftMin means the first
+ * shiftMin layers are sent to lower neighbor, a positive shiftMax
+ * means shiftMax layers are received from upper neighbor. Ghost cells
+ * are not filled.
+ */
+template<DimensionType dimType, class DataArray>
+static DataArray migrate_slabs(HydroParams& params,
+			       DataArray U,
+			       int dir, int shiftMin, int shiftMax)
+{
+
+  using Copy = CopyDataArraySlab<dimType>;
+
+  const int gw = params.ghostWidth;
+  const int data_type = params.storage_data_type;
+  const Kokkos::Array<int,3>& tile = params.mdrange_tile;
+
+  const int rankMin = params.neighborsRank[2*dir];
+  const int rankMax = params.neighborsRank[2*dir+1];
+
+  const int n    = U.extent(dir) - 2*gw;
+  const int nNew = n - shiftMin + shiftMax;
+
+  DataArray Unew = slab_array(U.label(), U, dir, nNew+2*gw);
+
+  // cells staying on current process
+  const int first = std::max(shiftMin, 0);
+  const int last  = n + std::min(shiftMax, 0);
+  Copy::apply(Unew, U, dir, gw+first-shiftMin, gw+first, last-first, tile);
+
+  // send first layers to lower neighbor, receive from upper neighbor
+  {
+    const int nSend = std::max( shiftMin, 0);
+    const int nRecv = std::max( shiftMax, 0);
+
+    DataArray sendBuf = slab_array("loadBalancingSend", U, dir, nSend);
+    DataArray recvBuf = slab_array("loadBalancingRecv", U, dir, nRecv);
+
+    Copy::apply(sendBuf, U, dir, 0, gw, nSend, tile);
+    Kokkos::fence();
+
+    params.communicator->sendrecv(sendBuf.data(), sendBuf.size(),
+				  data_type, rankMin, 411,
+				  recvBuf.data(), recvBuf.size(),
+				  data_type, rankMax, 411);
+
+    Copy::apply(Unew, recvBuf, dir, gw+nNew-nRecv, 0, nRecv, tile);
+  }
+
+  // send last layers to upper neighbor, receive from lower neighbor
+  {
+    const int nSend = std::max(-shiftMax, 0);
+    const int nRecv = std::max(-shiftMin, 0);
+
+    DataArray sendBuf = slab_array("loadBalancingSend", U, dir, nSend);
+    DataArray recvBuf = slab_array("loadBalancingRecv", U, dir, nRecv);
+
+    Copy::apply(sendBuf, U, dir, 0, gw+n-nSend, nSend, tile);
+    Kokkos::fence();
+
+    params.communicator->sendrecv(sendBuf.data(), sendBuf.size(),
+				  data_type, rankMax, 412,
+				  recvBuf.data(), recvBuf.size(),
+				  data_type, rankMin, 412);
+
+    Copy::apply(Unew, recvBuf, dir, gw, 0, nRecv, tile);
+  }
+
+  return Unew;
+
+} // migrate_slabs
+
+// =======================================================
+// =======================================================
+DataArray2d
+SolverBase::migrate_data(DataArray2d Udata, int dir, int shiftMin, int shiftMax)
+{
+
+  return migrate_slabs<TWO_D>(params, Udata, dir, shiftMin, shiftMax);
+
+} // SolverBase::migrate_data - 2d
+
+// =======================================================
+// =======================================================
+DataArray3d
+SolverBase::migrate_data(DataArray3d Udata, int dir, int shiftMin, int shiftMax)
+{
+
+  return migrate_slabs<THREE_D>(params, Udata, dir, shiftMin, shiftMax);
+
+} // SolverBase::migrate_data - 3d
+
+// =======================================================
+// =======================================================
+void
+SolverBase::resize_border_buffers()
+{
+
+  const int gw = params.ghostWidth;
+  const int isize = params.isize;
+  const int jsize = params.jsize;
+  const int ksize = params.ksize;
+
+  // keep the number of values per cell (differs from nbvar for SDM)
+  if (params.dimType == TWO_D) {
+
+    const int nb = borderBufSend_xmin_2d.extent(2);
+
+    Kokkos::realloc(borderBufSend_xmin_2d,    gw, jsize, nb);
+    Kokkos::realloc(borderBufSend_xmax_2d,    gw, jsize, nb);
+    Kokkos::realloc(borderBufSend_ymin_2d, isize,    gw, nb);
+    Kokkos::realloc(borderBufSend_ymax_2d, isize,    gw, nb);
+
+    Kokkos::realloc(borderBufRecv_xmin_2d,    gw, jsize, nb);
+    Kokkos::realloc(borderBufRecv_xmax_2d,    gw, jsize, nb);
+    Kokkos::realloc(borderBufRecv_ymin_2d, isize,    gw, nb);
+    Kokkos::realloc(borderBufRecv_ymax_2d, isize,    gw, nb);
+
+  } else {
+
+    const int nb = borderBufSend_xmin_3d.extent(3);
+
+    Kokkos::realloc(borderBufSend_xmin_3d,    gw, jsize, ksize, nb);
+    Kokkos::realloc(borderBufSend_xmax_3d,    gw, jsize, ksize, nb);
+    Kokkos::realloc(borderBufSend_ymin_3d, isize,    gw, ksize, nb);
+    Kokkos::realloc(borderBufSend_ymax_3d, isize,    gw, ksize, nb);
+    Kokkos::realloc(borderBufSend_zmin_3d, isize, jsize,    gw, nb);
+    Kokkos::realloc(borderBufSend_zmax_3d, isize, jsize,    gw, nb);
+
+    Kokkos::realloc(borderBufRecv_xmin_3d,    gw, jsize, ksize, nb);
+    Kokkos::realloc(borderBufRecv_xmax_3d,    gw, jsize, ksize, nb);
+    Kokkos::realloc(borderBufRecv_ymin_3d, isize,    gw, ksize, nb);
+    Kokkos::realloc(borderBufRecv_ymax_3d, isize,    gw, ksize, nb);
+    Kokkos::realloc(borderBufRecv_zmin_3d, isize, jsize,    gw, nb);
+    Kokkos::realloc(borderBufRecv_zmax_3d, isize, jsize,    gw, nb);
+
+  }
+
+  // shared windows are rebuilt before next use
+  m_shared_halo_ready = false;
+
+} // SolverBase::resize_border_buffers
+
+// =======================================================
+// =======================================================
+void
+SolverBase::realloc_domain(DataArray2d& data)
+{
+
+  if (data.size() > 0)
+    Kokkos::realloc(data, params.isize, params.jsize, data.extent(2));
+
+} // SolverBase::realloc_domain - 2d
+
+// =======================================================
+// =======================================================
+void
+SolverBase::realloc_domain(DataArray3d& data)
+{
+
+  if (data.size() > 0)
+    Kokkos::realloc(data, params.isize, params.jsize, params.ksize, data.extent(3));
+
+} // SolverBase::realloc_domain - 3d
+
 #endif // USE_MPI
 
+// =======================================================
+// =======================================================
+double SolverBase::max_memory_footprint(double bytes)
+{
+
+  double bytesMax = bytes;
+
+#ifdef USE_MPI
+  params.communicator->allReduce(&bytes, &bytesMax, 1,
+				 hydroSimu::MpiComm::DOUBLE,
+				 hydroSimu::MpiComm::MAX);
+#endif // USE_MPI
+
+  return bytesMax;
+
+} // SolverBase::max_memory_footprint
+
 // =======================================================
 // =======================================================
 void SolverBase::init_io()
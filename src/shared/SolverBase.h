@@ -4,6 +4,8 @@
 #include "shared/HydroParams.h"
 #include "utils/config/ConfigMap.h"
 #include "shared/kokkos_shared.h"
+#include "shared/BoundariesFunctors.h"
+#include "shared/ScratchArena.h"
 
 #include <map>
 #include <memory> // for std::unique_ptr / std::shared_ptr
@@ -25,8 +27,13 @@ enum solver_type_t {
 
 namespace ppkMHD { namespace io {
 class IO_ReadWriteBase;
+class OutputStreams;
 } }
 
+namespace ppkMHD {
+class InSituAnalysis;
+}
+
 enum TimerIds {
   TIMER_TOTAL = 0,
   TIMER_IO = 1,
@@ -110,6 +117,14 @@ public:
   //! Decides if the current time step is eligible for dump data to file
   virtual int  should_save_solution();
 
+  //! same as should_save_solution, at time t
+  int should_save_solution_at(double t);
+
+  //! largest number of steps (at most nSteps) of size m_dt which can be
+  //! done in a row without any output, analysis or output stream due in
+  //! between (see temporal blocking)
+  int steps_before_next_event(int nSteps);
+
   //! main routine to dump solution to file
   virtual void save_solution();
 
@@ -118,6 +133,13 @@ public:
 
   //! read restart data
   virtual void read_restart_file();
+
+  //! in-situ analysis of the current state, called by next_iteration
+  //! every [analysis] interval time steps (application specific)
+  virtual void run_analysis_impl();
+
+  //! write output streams due at current time step (application specific)
+  virtual void save_streams_impl();
   
   /* IO related */
 
@@ -161,6 +183,14 @@ public:
 		       real_t time,
 		       std::string debug_name);
 
+  //! run in-situ analysis on U (ghost cells must be up to date)
+  void run_analysis(DataArray2d U, bool mhd_enabled);
+  void run_analysis(DataArray3d U, bool mhd_enabled);
+
+  //! extract and write output streams due at current time step from U
+  void save_streams(DataArray2d U);
+  void save_streams(DataArray3d U);
+
   /** 
    * Routine to load data from file (for a restart run). 
    * This routine change iStep and time (loaded from file).
@@ -176,8 +206,11 @@ public:
 		 real_t& time);
   
   
-  virtual void make_boundary(DataArray2d Udata, FaceIdType faceId, bool mhd_enabled);
-  virtual void make_boundary(DataArray3d Udata, FaceIdType faceId, bool mhd_enabled);
+  //! fill ghost cells of all physical faces in a single kernel launch
+  void make_boundaries_physical(DataArray2d Udata, bool mhd_enabled,
+				bool skip_mpi_faces);
+  void make_boundaries_physical(DataArray3d Udata, bool mhd_enabled,
+				bool skip_mpi_faces);
   
   virtual void make_boundaries_serial(DataArray2d Udata, bool mhd_enabled);
   virtual void make_boundaries_serial(DataArray3d Udata, bool mhd_enabled);
@@ -195,6 +228,23 @@ public:
   void copy_boundaries_back(DataArray2d Udata, BoundaryLocation loc);
   void copy_boundaries_back(DataArray3d Udata, BoundaryLocation loc);
 
+  //! dynamic load balancing : move sub-domain boundaries according to
+  //! the numerical scheme cost measured since previous call
+  void load_balancing();
+
+  //! migrate state arrays after the sub-domain boundaries along dir
+  //! moved by shiftMin (lower side) and shiftMax (upper side), see
+  //! migrate_data; to be overriden by solvers supporting load balancing
+  virtual void load_balancing_migrate(int dir, int shiftMin, int shiftMax);
+
+  //! reallocate work arrays once sub-domain sizes have changed
+  virtual void load_balancing_resize();
+
+  //! return a copy of Udata resized along dir, with layers of cells
+  //! exchanged with MPI neighbors along dir
+  DataArray2d migrate_data(DataArray2d Udata, int dir, int shiftMin, int shiftMax);
+  DataArray3d migrate_data(DataArray3d Udata, int dir, int shiftMin, int shiftMax);
+
 #endif // USE_MPI
 
   //! initialize m_io_writer (can be override in a derived class)
@@ -205,7 +255,142 @@ protected:
   //! io writer
   std::shared_ptr<io::IO_ReadWriteBase>  m_io_reader_writer;
 
+  //! in-situ analysis ([analysis] section), null when disabled
+  std::shared_ptr<InSituAnalysis>        m_analysis;
+
+  //! additional output streams ([output] streams), null when disabled
+  std::shared_ptr<io::OutputStreams>     m_output_streams;
+
+  //! work arrays of the numerical scheme, aliased according to their
+  //! lifetime within a time step
+  ScratchArena m_scratch;
+
+  //! largest memory footprint over MPI processes (collective), given
+  //! the footprint of the current process in bytes
+  double max_memory_footprint(double bytes);
+
+  //! \defgroup GhostCells ghost cells touched by physical border conditions,
+  //! built on first use; index 0 : all faces, index 1 : MPI faces skipped
+  //! @{
+  GhostCellList m_ghost_cells[2];
+  FaceBCArray   m_ghost_faces_bc[2];
+  bool          m_ghost_cells_ready[2];
+  //! @}
+
+  void init_ghost_cells(bool skip_mpi_faces);
+
+  //! \defgroup DeepHalos deep halos : with params.deepHaloStages > 1,
+  //! MPI halos are exchanged once every deepHaloStages Runge-Kutta stages;
+  //! in between, stages also update the ghost cells still depending only
+  //! on valid data, so that the computed region shrinks stage after stage
+  //! down to the interior. Physical boundaries are filled at every stage.
+  //! @{
+  int         m_deep_halo_stages; //!< stages between two exchanges (1 : disabled)
+  int         m_deep_halo_age;    //!< stages computed since last exchange
+  HydroParams m_stage_params;     //!< grid description of the current stage
+  //! @}
+
+  /**
+   * Deep halos : to be called before each Runge-Kutta stage.
+   * Sets m_stage_params, the grid description to be used by the stage
+   * functors : interior extended to the ghost layers which remain valid
+   * after the stage (same as params without deep halos).
+   *
+   * \return true if the MPI halo exchange is due, false if only physical
+   * boundaries need to be filled.
+   */
+  bool deep_halo_stage();
+
+  //! deep halos : force a halo exchange at next stage
+  void deep_halo_reset() { m_deep_halo_age = m_deep_halo_stages; }
+
+  //! \defgroup LoadBalancing dynamic load balancing ([mpi] section)
+  //! @{
+  bool   m_load_balancing_supported; //!< set by solvers implementing load_balancing_migrate
+  int    m_load_balancing_interval;  //!< number of time steps between two rebalancing (0 : disabled)
+  double m_load_balancing_threshold; //!< imbalance (max cost / mean cost - 1) triggering rebalancing
+  double m_load_balancing_cost;      //!< numerical scheme timer value at previous rebalancing
+  //! @}
+
 #ifdef USE_MPI
+  //! sub-domain boundaries along each direction (see
+  //! HydroParams::blockCuts), moved by load_balancing
+  std::vector<int> m_block_cuts[3];
+
+  //! reallocate border buffers for the current sub-domain sizes
+  void resize_border_buffers();
+
+  //! \defgroup SharedMemoryHalo intra-node halo exchange : send border
+  //! buffers live in MPI-3 shared memory windows (one per direction), the
+  //! receive border buffer facing a neighbor on the same node is an alias
+  //! to that neighbor's send buffer, read in place by copy_boundaries_back
+  //! (no MPI transfer). Inter-node neighbors still use MPI_Sendrecv.
+  //! @{
+  bool     m_shared_halo_enabled; //!< [mpi] shared_memory_halo (host backends only, default false)
+  bool     m_shared_halo_ready;   //!< windows match current border buffers
+  MPI_Comm m_node_comm;           //!< processes sharing memory with current one
+  MPI_Win  m_halo_win[3];         //!< one shared window per direction
+  Kokkos::Array<int,6> m_neighbors_node_rank; //!< rank in m_node_comm, or MPI_UNDEFINED
+  //! @}
+
+  //! (re)allocate shared windows and bind border buffers to them
+  void init_shared_halo();
+
+  //! release shared windows
+  void free_shared_halo();
+
+  //! wait until the send buffers of the neighbors along dir on the same
+  //! node are filled (pairwise, no node-wide barrier)
+  void shared_halo_sync(Direction dir);
+
+  //! rank to exchange with through MPI for a given neighbor
+  //! (MPI_PROC_NULL when border buffers are shared)
+  int halo_peer_rank(hydroSimu::NeighborLocation loc) const;
+
+  //! \defgroup ReducedPrecisionHalo reduced-precision halo messages : border
+  //! cells are converted to float or fixed point in the pack kernel and
+  //! expanded back in the unpack kernel (see mpiHaloCompression.h), some
+  //! variables may be kept at full precision. Every m_halo_check_interval
+  //! exchanges, full precision borders are exchanged as well and compared
+  //! to the decoded ones; above m_halo_check_tolerance, the run falls back
+  //! to full precision.
+  //! @{
+  int     m_halo_precision;       //!< HaloPrecision ([mpi] halo_precision)
+  int     m_halo_full_mask;       //!< bit iVar set : variable kept at full precision
+  int     m_halo_check_interval;  //!< exchanges between two accuracy checks (0 : never)
+  double  m_halo_check_tolerance; //!< maximum relative error accepted
+  int64_t m_halo_exchange_count;  //!< number of halo exchanges so far
+  bool    m_halo_check_active;    //!< current exchange is checked
+  Kokkos::View<uint8_t*, Device> m_halo_send[6];  //!< messages (indexed by BoundaryLocation)
+  Kokkos::View<uint8_t*, Device> m_halo_recv[6];
+  Kokkos::View<double*, Device>  m_halo_range[6]; //!< components min / max (fixed point)
+  Kokkos::View<double*, Device>  m_halo_error;    //!< accuracy check, per variable
+  //! @}
+
+  //! read reduced-precision halo parameters (variables names must be set)
+  void init_halo_precision();
+
+  //! beginning of a halo exchange : report the accuracy check of the
+  //! previous exchange (if any), decide whether this one is checked
+  void halo_exchange_begin();
+
+  //! send / receive reduced-precision messages along direction dir
+  void transfert_halo_messages(Direction dir);
+
+  //! fill the send border buffer b (or its reduced-precision message)
+  template<BoundaryLocation loc, DimensionType dimType, class DataArray>
+  void pack_border(DataArray Udata, DataArray b);
+
+  //! copy the receive border buffer b (or its reduced-precision message)
+  //! into the ghost cells
+  template<BoundaryLocation loc, DimensionType dimType, class DataArray>
+  void unpack_border(DataArray Udata, DataArray b);
+
+  //! reallocate an array (if allocated) for the current sub-domain
+  //! sizes, keeping its number of values per cell; contents are lost
+  void realloc_domain(DataArray2d& data);
+  void realloc_domain(DataArray3d& data);
+
   //! \defgroup BorderBuffer data arrays for border exchange handling
   //! we assume that we use a cuda-aware version of OpenMPI / MVAPICH
   //! @{
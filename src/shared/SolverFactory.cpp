@@ -7,6 +7,7 @@
 
 #ifdef USE_SDM
 #include "sdm/SolverHydroSDM.h"
+#include "sdm/SolverHydroSDM_PAdaptive.h"
 #endif // USE_SDM
 
 #ifdef USE_MOOD
@@ -39,6 +40,17 @@ SolverFactory::SolverFactory()
   registerSolver("Hydro_SDM_3D_degree2",   &sdm::SolverHydroSDM<3,2>::create);
   registerSolver("Hydro_SDM_3D_degree3",   &sdm::SolverHydroSDM<3,3>::create);
   registerSolver("Hydro_SDM_3D_degree4",   &sdm::SolverHydroSDM<3,4>::create);
+
+  // p-adaptive : per cell degree up to the given one
+  registerSolver("Hydro_SDM_2D_padaptive_degree2", &sdm::SolverHydroSDM_PAdaptive<2,2>::create);
+  registerSolver("Hydro_SDM_2D_padaptive_degree3", &sdm::SolverHydroSDM_PAdaptive<2,3>::create);
+  registerSolver("Hydro_SDM_2D_padaptive_degree4", &sdm::SolverHydroSDM_PAdaptive<2,4>::create);
+  registerSolver("Hydro_SDM_2D_padaptive_degree5", &sdm::SolverHydroSDM_PAdaptive<2,5>::create);
+  registerSolver("Hydro_SDM_2D_padaptive_degree6", &sdm::SolverHydroSDM_PAdaptive<2,6>::create);
+
+  registerSolver("Hydro_SDM_3D_padaptive_degree2", &sdm::SolverHydroSDM_PAdaptive<3,2>::create);
+  registerSolver("Hydro_SDM_3D_padaptive_degree3", &sdm::SolverHydroSDM_PAdaptive<3,3>::create);
+  registerSolver("Hydro_SDM_3D_padaptive_degree4", &sdm::SolverHydroSDM_PAdaptive<3,4>::create);
 #endif // USE_SDM
   
 #ifdef USE_MOOD
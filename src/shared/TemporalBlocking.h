@@ -0,0 +1,345 @@
+/**
+ * \file TemporalBlocking.h
+ * \brief Advance several time steps per tile of a sub-domain.
+ */
+#ifndef TEMPORAL_BLOCKING_H_
+#define TEMPORAL_BLOCKING_H_
+
+#include <vector>
+#include <algorithm>
+
+#include "shared/HydroParams.h"
+#include "shared/kokkos_shared.h"
+#include "shared/BoundariesFunctors.h"
+#include "shared/mpiBorderUtils.h"
+
+namespace ppkMHD {
+
+/**
+ * Temporal blocking of a (single process) domain : the domain is cut
+ * into tiles stacked along the last direction (Y in 2D, Z in 3D), and
+ * each tile is advanced by several time steps in a row in small work
+ * arrays before moving to the next one, so that the data of a tile is
+ * reused from cache instead of streaming the whole domain through
+ * memory at every step.
+ *
+ * A tile advanced by depth steps reads depth*ghostWidth layers of its
+ * neighbors (overlapped tiling) : the outer layers of the work arrays
+ * are never updated, and the error made near them moves inwards by
+ * ghostWidth layers per step, so that the interior layers of the tile
+ * are exact after depth steps. Layers beyond the regular ghost cells
+ * are computed redundantly by neighbor tiles.
+ *
+ * Tile parameters extend the interior over these extra layers, the
+ * numerical scheme is applied to the work arrays as to a regular
+ * sub-domain; ghost cells of physical faces are filled by border
+ * conditions before every step.
+ *
+ * All tiles are processed one after the other and share the same work
+ * arrays, sized for the largest tile.
+ */
+template<int dim>
+class TemporalBlocking {
+
+public:
+
+  //! Decide at compile-time which data array to use for 2d or 3d
+  using DataArray = typename std::conditional<dim==2,DataArray2d,DataArray3d>::type;
+
+  static constexpr DimensionType dimType = dim==2 ? TWO_D : THREE_D;
+
+  //! direction along which tiles are stacked
+  static constexpr int splitDir = dim-1;
+
+  struct Tile {
+
+    //! same as the domain parameters, except for the sizes along splitDir
+    HydroParams params;
+
+    //! first interior layer of the tile inside the domain
+    int start;
+
+    //! number of interior layers along splitDir
+    int n;
+
+    //! number of extra layers read from neighbor tiles below / above
+    int lo, hi;
+
+    //! border conditions of physical faces (BC_COPY for the others)
+    FaceBCArray faceBC;
+
+    //! ghost cells filled by border conditions
+    GhostCellList ghostCells;
+
+  }; // struct Tile
+
+  /**
+   * \param[in] params     parameters of the domain
+   * \param[in] depth      number of time steps per tile
+   * \param[in] tileLayers requested number of interior layers of a tile
+   *                       along splitDir
+   */
+  TemporalBlocking(HydroParams& params, int depth, int tileLayers);
+
+  int size() const { return (int) m_tiles.size(); }
+
+  //! number of time steps per tile
+  int depth() const { return m_depth; }
+
+  Tile&       operator[](int b)       { return m_tiles[b]; }
+  const Tile& operator[](int b) const { return m_tiles[b]; }
+
+  //! largest ghosted size of a tile along splitDir
+  int max_ghosted_size() const;
+
+  /**
+   * Copy a domain-sized field (e.g. gravity) into per-tile fields,
+   * allocated here with the tile sizes.
+   */
+  template<class Field>
+  void scatter_field(Field data, std::vector<Field>& tileData) const;
+
+  /**
+   * Advance every tile by nSteps (at most depth) time steps, reading
+   * data_in (ghost cells up to date) and writing the interior of
+   * data_out; data_in and data_out must be different arrays.
+   *
+   * step(b, s, in, out) must advance tile b by one time step (step s
+   * of the block) from in to out (ghost cells of in are up to date).
+   */
+  template<class Step>
+  void run(DataArray data_in, DataArray data_out, int nSteps,
+	   bool mhd_enabled, Step step);
+
+private:
+
+  HydroParams& params;
+
+  int m_depth;
+
+  //! true if the domain is periodic along splitDir
+  bool m_periodic;
+
+  std::vector<Tile> m_tiles;
+
+  //! work arrays, shared by all tiles
+  DataArray m_U[2];
+
+  /**
+   * Copy the layers of tile b (extra and ghost layers included) from a
+   * domain-sized array, wrapping around along a periodic splitDir.
+   */
+  template<class Array>
+  void load(const Tile& tile, Array dst, Array src) const;
+
+}; // class TemporalBlocking
+
+// =======================================================
+// =======================================================
+template<int dim>
+TemporalBlocking<dim>::TemporalBlocking(HydroParams& params, int depth,
+					int tileLayers) :
+  params(params),
+  m_depth(std::max(1, depth)),
+  m_periodic(false),
+  m_tiles()
+{
+
+  const int gw = params.ghostWidth;
+  const int nTotal = dim==2 ? params.ny : params.nz;
+  const int extra = (m_depth-1)*gw;
+
+  const int nbTiles = std::max(1, nTotal/std::max(tileLayers, gw));
+
+  m_tiles.resize(nbTiles);
+
+  // physical border conditions of the domain
+  BoundaryConditionType bc[6] = {
+    params.boundary_type_xmin, params.boundary_type_xmax,
+    params.boundary_type_ymin, params.boundary_type_ymax,
+    params.boundary_type_zmin, params.boundary_type_zmax };
+
+  bool periodic[6];
+  for (int face=0; face<6; ++face) {
+#ifdef USE_MPI
+    periodic[face] =
+      params.neighborsBC[face] == BC_COPY ||
+      params.neighborsBC[face] == BC_PERIODIC;
+#else
+    periodic[face] = bc[face] == BC_PERIODIC;
+#endif // USE_MPI
+  }
+
+  m_periodic = periodic[2*splitDir];
+
+  int start = 0;
+  for (int b=0; b<nbTiles; ++b) {
+
+    Tile& tile = m_tiles[b];
+
+    tile.start = start;
+    tile.n = nTotal/nbTiles + (b < nTotal%nbTiles ? 1 : 0);
+    start += tile.n;
+
+    // extra layers stop at physical borders; a periodic domain wraps
+    // around (unless a single tile wraps onto itself)
+    const bool wrap = nbTiles > 1 && m_periodic;
+    tile.lo = wrap ? extra : std::min(extra, tile.start);
+    tile.hi = wrap ? extra : std::min(extra, nTotal - tile.start - tile.n);
+
+    const int n = tile.n + tile.lo + tile.hi;
+
+    HydroParams& tp = tile.params;
+    tp = params;
+    if (dim==2) {
+      tp.ny = n;
+      tp.jmax = n-1+2*gw;
+      tp.jsize = n+2*gw;
+    } else {
+      tp.nz = n;
+      tp.kmax = n-1+2*gw;
+      tp.ksize = n+2*gw;
+    }
+    tp.myOffset[splitDir] += tile.start - tile.lo;
+
+    for (int face=0; face<6; ++face) {
+
+      tile.faceBC[face] = BC_COPY;
+
+      if (face/2 >= dim)
+	continue;
+
+      // ghost layers loaded from a neighbor tile
+      const bool border = face%2 == 0 ?
+	tile.start - tile.lo == 0 :
+	tile.start + tile.n + tile.hi == nTotal;
+      if (face/2 == splitDir && (!border || wrap))
+	continue;
+
+      tile.faceBC[face] = periodic[face] ? BC_PERIODIC : bc[face];
+
+    } // end for face
+
+    tile.ghostCells = build_ghost_cell_list(tp, tile.faceBC);
+
+  } // end for b
+
+  const int nMax = max_ghosted_size();
+  for (int index=0; index<2; ++index)
+    m_U[index] = dim==2 ?
+      DataArray("U_tile", params.isize, nMax, params.nbvar) :
+      DataArray("U_tile", params.isize, params.jsize, nMax, params.nbvar);
+
+} // TemporalBlocking::TemporalBlocking
+
+// =======================================================
+// =======================================================
+template<int dim>
+int TemporalBlocking<dim>::max_ghosted_size() const
+{
+
+  int size = 0;
+  for (const Tile& tile : m_tiles)
+    size = std::max(size, tile.n + tile.lo + tile.hi + 2*params.ghostWidth);
+
+  return size;
+
+} // TemporalBlocking::max_ghosted_size
+
+// =======================================================
+// =======================================================
+template<int dim>
+template<class Array>
+void TemporalBlocking<dim>::load(const Tile& tile, Array dst, Array src) const
+{
+
+  const int gw = params.ghostWidth;
+  const int nTotal = dim==2 ? params.ny : params.nz;
+  const int nLayers = tile.n + tile.lo + tile.hi + 2*gw;
+
+  // interior index of the first layer of the tile (may be negative)
+  const int first = tile.start - tile.lo - gw;
+
+  int l = 0;
+  while (l < nLayers) {
+
+    int p = first + l;
+    int len = nLayers - l;
+
+    if (m_periodic) {
+      p = ((p % nTotal) + nTotal) % nTotal;
+      len = std::min(len, nTotal - p);
+    }
+
+    CopyDataArraySlab<dimType,Array>::apply(dst, src, splitDir, l, p+gw, len,
+					    params.mdrange_tile);
+    l += len;
+
+  }
+
+} // TemporalBlocking::load
+
+// =======================================================
+// =======================================================
+template<int dim>
+template<class Field>
+void TemporalBlocking<dim>::scatter_field(Field data,
+					  std::vector<Field>& tileData) const
+{
+
+  tileData.resize(m_tiles.size());
+
+  for (int b=0; b<size(); ++b) {
+
+    const Tile& tile = m_tiles[b];
+
+    tileData[b] = dim==2 ?
+      Field(data.label(), tile.params.isize, tile.params.jsize) :
+      Field(data.label(), tile.params.isize, tile.params.jsize, tile.params.ksize);
+
+    load(tile, tileData[b], data);
+  }
+
+} // TemporalBlocking::scatter_field
+
+// =======================================================
+// =======================================================
+template<int dim>
+template<class Step>
+void TemporalBlocking<dim>::run(DataArray data_in, DataArray data_out,
+				int nSteps, bool mhd_enabled, Step step)
+{
+
+  const int gw = params.ghostWidth;
+
+  nSteps = std::max(1, std::min(nSteps, m_depth));
+
+  for (int b=0; b<size(); ++b) {
+
+    const Tile& tile = m_tiles[b];
+
+    load(tile, m_U[0], data_in);
+
+    for (int s=0; s<nSteps; ++s) {
+
+      DataArray in  = m_U[s%2];
+      DataArray out = m_U[1-s%2];
+
+      make_boundaries_apply<dim>(tile.params, in, tile.ghostCells,
+				 tile.faceBC, mhd_enabled);
+
+      step(b, s, in, out);
+
+    }
+
+    CopyDataArraySlab<dimType>::apply(data_out, m_U[nSteps%2], splitDir,
+				      tile.start+gw, tile.lo+gw, tile.n,
+				      params.mdrange_tile);
+
+  } // end for b
+
+} // TemporalBlocking::run
+
+} // namespace ppkMHD
+
+#endif // TEMPORAL_BLOCKING_H_
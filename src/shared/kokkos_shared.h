@@ -19,12 +19,34 @@ enum KokkosLayout {
   KOKKOS_LAYOUT_RIGHT
 };
 
+/**
+ * Memory layout of the hydro state arrays (DataArray2d / DataArray3d).
+ *
+ * By default, the execution space prefered layout is used : left for
+ * CUDA, right for OpenMP (variables of a given cell are interleaved).
+ *
+ * When USE_SOA_LAYOUT is defined, left layout is enforced on all
+ * execution spaces : the variable index is the slowest, so that each
+ * variable is stored in a contiguous plane (structure of arrays) with
+ * unit stride along i.
+ *
+ * Functors only access data through View::operator(), which is layout
+ * agnostic; only the mapping index <-> (i,j,k) below depends on it.
+ */
+#if defined(KOKKOS_ENABLE_CUDA) || defined(USE_SOA_LAYOUT)
+#define PPKMHD_LAYOUT_LEFT
+using StateLayout = Kokkos::LayoutLeft;
+#else
+using StateLayout = Kokkos::LayoutRight;
+#endif
+
 // last index is hydro variable
 // n-1 first indexes are space (i,j,k,....)
-typedef Kokkos::View<real_t***, Device>   DataArray2d;
+// state arrays use storage_t (may differ from real_t in mixed precision)
+typedef Kokkos::View<storage_t***, StateLayout, Device>   DataArray2d;
 typedef DataArray2d::HostMirror           DataArray2dHost;
 
-typedef Kokkos::View<real_t****, Device>  DataArray3d;
+typedef Kokkos::View<storage_t****, StateLayout, Device>  DataArray3d;
 typedef DataArray3d::HostMirror           DataArray3dHost;
 //typedef DataArray2d     DataArray3d;
 //typedef DataArray2dHost DataArray3dHost;
@@ -43,15 +65,82 @@ typedef DataArrayVector3::HostMirror           DataArrayVector3Host;
 using VectorField3d     = DataArrayVector3;
 using VectorField3dHost = DataArrayVector3::HostMirror;
 
+/**
+ * Multidimensional range policies, used to launch functors over a
+ * (i,j) or (i,j,k) region (usually the active region, possibly enlarged
+ * by a few ghost cells) instead of a flat range over all cells decoded
+ * with index2coord.
+ *
+ * Iteration order follows the layout of state arrays (see StateLayout
+ * above). Tile sizes are set at run time (see HydroParams::mdrange_tile);
+ * a tile size of 0 lets Kokkos use its default for the current backend.
+ */
+#ifdef PPKMHD_LAYOUT_LEFT
+constexpr Kokkos::Iterate MDIterate = Kokkos::Iterate::Left;
+#else
+constexpr Kokkos::Iterate MDIterate = Kokkos::Iterate::Right;
+#endif
+
+using MDPolicy2d = Kokkos::MDRangePolicy<Device, Kokkos::Rank<2, MDIterate, MDIterate> >;
+using MDPolicy3d = Kokkos::MDRangePolicy<Device, Kokkos::Rank<3, MDIterate, MDIterate> >;
+
+/**
+ * Build a 2D range policy over [ib,ie[ x [jb,je[.
+ */
+inline
+MDPolicy2d md_policy_2d(int ib, int jb,
+                        int ie, int je,
+                        const Kokkos::Array<int,3>& tile)
+{
+  return MDPolicy2d({ib,jb}, {ie,je}, {tile[0],tile[1]});
+}
+
+/**
+ * Build a 3D range policy over [ib,ie[ x [jb,je[ x [kb,ke[.
+ */
+inline
+MDPolicy3d md_policy_3d(int ib, int jb, int kb,
+                        int ie, int je, int ke,
+                        const Kokkos::Array<int,3>& tile)
+{
+  return MDPolicy3d({ib,jb,kb}, {ie,je,ke}, {tile[0],tile[1],tile[2]});
+}
+
+/**
+ * Dimension generic version, for functors templated by dim (SDM, MOOD):
+ * range [ib,ie[ x [jb,je[ in 2D (kb and ke are ignored), and
+ * [ib,ie[ x [jb,je[ x [kb,ke[ in 3D.
+ */
+template<int dim>
+inline
+typename std::enable_if<dim==2, MDPolicy2d>::type
+md_policy(int ib, int jb, int kb,
+          int ie, int je, int ke,
+          const Kokkos::Array<int,3>& tile)
+{
+  UNUSED(kb);
+  UNUSED(ke);
+  return md_policy_2d(ib, jb, ie, je, tile);
+}
+
+template<int dim>
+inline
+typename std::enable_if<dim==3, MDPolicy3d>::type
+md_policy(int ib, int jb, int kb,
+          int ie, int je, int ke,
+          const Kokkos::Array<int,3>& tile)
+{
+  return md_policy_3d(ib, jb, kb, ie, je, ke, tile);
+}
+
 /**
  * Retrieve cartesian coordinate from index, using memory layout information.
  *
- * for each execution space define a prefered layout.
- * Prefer left layout  for CUDA execution space.
- * Prefer right layout for OpenMP execution space.
+ * Follows the layout of state arrays (see StateLayout above), so that
+ * consecutive indexes access consecutive memory locations.
  *
- * These function will eventually disappear.
- * We still need then as long as parallel_reduce does not accept MDRange policy.
+ * Only used by functors that are still launched over a flat range; new
+ * code should use md_policy_2d / md_policy_3d above.
  */
 
 /* 2D */
@@ -62,7 +151,7 @@ void index2coord(int index, int &i, int &j, int Nx, int Ny)
   UNUSED(Nx);
   UNUSED(Ny);
   
-#ifdef KOKKOS_ENABLE_CUDA
+#ifdef PPKMHD_LAYOUT_LEFT
   j = index / Nx;
   i = index - j*Nx;
 #else
@@ -76,7 +165,7 @@ int coord2index(int i, int j, int Nx, int Ny)
 {
   UNUSED(Nx);
   UNUSED(Ny);
-#ifdef KOKKOS_ENABLE_CUDA
+#ifdef PPKMHD_LAYOUT_LEFT
   return i + Nx*j; // left layout
 #else
   return j + Ny*i; // right layout
@@ -92,7 +181,7 @@ void index2coord(int index,
 {
   UNUSED(Nx);
   UNUSED(Nz);
-#ifdef KOKKOS_ENABLE_CUDA
+#ifdef PPKMHD_LAYOUT_LEFT
   int NxNy = Nx*Ny;
   k = index / NxNy;
   j = (index - k*NxNy) / Nx;
@@ -111,7 +200,7 @@ int coord2index(int i,  int j,  int k,
 {
   UNUSED(Nx);
   UNUSED(Nz);
-#ifdef KOKKOS_ENABLE_CUDA
+#ifdef PPKMHD_LAYOUT_LEFT
   return i + Nx*j + Nx*Ny*k; // left layout
 #else
   return k + Nz*j + Nz*Ny*i; // right layout
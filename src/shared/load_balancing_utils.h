@@ -0,0 +1,76 @@
+/**
+ * \file load_balancing_utils.h
+ * \brief Helpers for dynamic load balancing (see SolverBase::load_balancing).
+ */
+#ifndef LOAD_BALANCING_UTILS_H_
+#define LOAD_BALANCING_UTILS_H_
+
+#include <algorithm> // for std::min, std::max
+#include <vector>
+
+namespace ppkMHD {
+
+/**
+ * Compute new sub-domain boundaries along one direction, so that the
+ * measured cost is evenly distributed among the m slabs of MPI
+ * processes (the cost density is assumed uniform inside a slab).
+ *
+ * Each boundary moves by at most half the width of the adjacent
+ * sub-domains (minus ghost width), so that cells only migrate between
+ * direct neighbors and no sub-domain becomes thinner than ghostWidth.
+ *
+ * \param[in]  cuts      current boundaries (m+1 values, see SolverBase::m_block_cuts)
+ * \param[in]  slabCost  measured cost of each of the m slabs
+ * \param[in]  ghostWidth
+ * \param[out] newCuts   new boundaries (m+1 values, first and last unchanged)
+ *
+ * \return true if at least one boundary moved.
+ */
+inline
+bool compute_balanced_cuts(const int* cuts,
+			   const std::vector<double>& slabCost,
+			   int ghostWidth,
+			   std::vector<int>& newCuts)
+{
+
+  const int m = slabCost.size();
+
+  std::vector<double> cumCost(m+1, 0.0);
+  for (int p=0; p<m; ++p)
+    cumCost[p+1] = cumCost[p] + slabCost[p];
+
+  newCuts.assign(cuts, cuts+m+1);
+
+  bool moved = false;
+
+  for (int p=1; p<m; ++p) {
+
+    const double target = p * cumCost[m] / m;
+
+    // find slab containing the target cost, and interpolate inside
+    int q = 0;
+    while (q < m-1 and cumCost[q+1] < target)
+      ++q;
+
+    const int width = cuts[q+1] - cuts[q];
+    const double x = slabCost[q] > 0 ?
+      cuts[q] + (target - cumCost[q]) / slabCost[q] * width :
+      cuts[q];
+
+    // limit displacement
+    const int lower = cuts[p] - std::max(0, (cuts[p]   - cuts[p-1] - ghostWidth)/2);
+    const int upper = cuts[p] + std::max(0, (cuts[p+1] - cuts[p]   - ghostWidth)/2);
+
+    newCuts[p] = std::min(std::max(static_cast<int>(x+0.5), lower), upper);
+
+    moved |= (newCuts[p] != cuts[p]);
+
+  }
+
+  return moved;
+
+} // compute_balanced_cuts
+
+} // namespace ppkMHD
+
+#endif // LOAD_BALANCING_UTILS_H_
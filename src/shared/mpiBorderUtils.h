@@ -14,6 +14,33 @@
 
 namespace ppkMHD {
 
+/**
+ * Launch a border copy functor over the whole extent of border buffer b.
+ */
+template<class Functor>
+void launch_border_copy(const Functor& functor,
+                        DataArray2d b,
+                        const Kokkos::Array<int,3>& tile)
+{
+  Kokkos::parallel_for("border copy 2d",
+                       md_policy_2d(0, 0,
+                                    b.extent(0), b.extent(1),
+                                    tile),
+                       functor);
+}
+
+template<class Functor>
+void launch_border_copy(const Functor& functor,
+                        DataArray3d b,
+                        const Kokkos::Array<int,3>& tile)
+{
+  Kokkos::parallel_for("border copy 3d",
+                       md_policy_3d(0, 0, 0,
+                                    b.extent(0), b.extent(1), b.extent(2),
+                                    tile),
+                       functor);
+}
+
 /**
  * \class CopyBorderBuf_To_DataArray
  *
@@ -31,6 +58,8 @@ namespace ppkMHD {
  * @param[in]  b reference to a border buffer (source array)
  * @param[in]  ghostWidth is the number of ghost cells
  *
+ * The functor is launched over the border buffer extents (multidimensional
+ * range policy).
  */
 template<
   BoundaryLocation boundaryLoc,
@@ -51,22 +80,20 @@ public:
   static void apply(DataArray U,
 		    DataArray b,
 		    int       ghostWidth,
-                    int       nbIter)
+                    const Kokkos::Array<int,3>& tile)
   {
     CopyBorderBuf_To_DataArray<boundaryLoc,dimType> functor(U,b,ghostWidth);
-    Kokkos::parallel_for(nbIter, functor);
+    launch_border_copy(functor, b, tile);
   }
 
   
   template<DimensionType dimType_ = dimType>
   KOKKOS_INLINE_FUNCTION
-  void operator()(const typename std::enable_if<dimType_==TWO_D, int>::type&  index) const
+  void operator()(const typename std::enable_if<dimType_==TWO_D, int>::type& i,
+                  const int& j) const
   {
     
-    const int isize = U.extent(0);
-    const int jsize = U.extent(1);
     const int nbvar = U.extent(2);
-    int i,j;
 
     /*
      * Proceed with copy.
@@ -79,19 +106,11 @@ public:
     
     if (boundaryLoc == XMIN or boundaryLoc == XMAX) {
       
-      //j = index / ghostWidth;
-      //i = index - j*ghostWidth;
-      index2coord(index,i,j,ghostWidth,jsize);
-
       for (int nVar=0; nVar<nbvar; ++nVar)
 	U(offset+i  ,j,nVar) = b(i,j,nVar);
             
     } else if (boundaryLoc == YMIN or boundaryLoc == YMAX) {
       
-      //i = index / ghostWidth;
-      //j = index - i*ghostWidth;
-      index2coord(index,i,j,isize,ghostWidth);
-
       for (int nVar=0; nVar<nbvar; ++nVar)
 	U(i,offset+j  ,nVar) = b(i,j,nVar);
       
@@ -101,14 +120,12 @@ public:
   
   template<DimensionType dimType_ = dimType>
   KOKKOS_INLINE_FUNCTION
-  void operator()(const typename std::enable_if<dimType_==THREE_D, int>::type&  index) const
+  void operator()(const typename std::enable_if<dimType_==THREE_D, int>::type& i,
+                  const int& j,
+                  const int& k) const
   {
 
-    const int isize = U.extent(0);
-    const int jsize = U.extent(1);
-    const int ksize = U.extent(2);
     const int nbvar = U.extent(3);
-    int i,j,k;
     
     /*
      * Proceed with copy.
@@ -124,24 +141,18 @@ public:
     
     if (boundaryLoc == XMIN or boundaryLoc == XMAX) {
       	
-      index2coord(index,i,j,k,ghostWidth,jsize,ksize);
-      
       for (int nVar=0; nVar<nbvar; ++nVar) {
 	U(offset+i  ,j,k,nVar) = b(i,j,k,nVar);
       }
       
     } else if (boundaryLoc == YMIN or boundaryLoc == YMAX) {
       
-      index2coord(index,i,j,k,isize,ghostWidth,ksize);
-
       for (int nVar=0; nVar<nbvar; ++nVar) {
 	U(i,offset+j,k,nVar) = b(i,j,k,nVar);
       }
       
     } else if (boundaryLoc == ZMIN or boundaryLoc == ZMAX) {
       
-      index2coord(index,i,j,k,isize,jsize,ghostWidth);
-
       for (int nVar=0; nVar<nbvar; ++nVar) {
 	U(i,j,offset+k  ,nVar) = b(i,j,k,nVar);
       }
@@ -163,8 +174,8 @@ public:
  * Here we assume U is a <b>DataArray</b>. 
  * \sa copyBorderBufSendToHostArray
  *
- * When used with 2d Array, we just use the index to access border data.
- * For 3d data Array, we need to map the correct location, by using index2coord.
+ * The functor is launched over the border buffer extents (multidimensional
+ * range policy).
  *
  * template parameters:
  * @tparam boundaryLoc : boundary location in source Array
@@ -193,21 +204,19 @@ public:
   static void apply(DataArray b,
 		    DataArray U,
 		    int       ghostWidth,
-                    int       nbIter)
+                    const Kokkos::Array<int,3>& tile)
   {
     CopyDataArray_To_BorderBuf<boundaryLoc,dimType> functor(b,U,ghostWidth);
-    Kokkos::parallel_for(nbIter, functor);
+    launch_border_copy(functor, b, tile);
   }
 
   template<DimensionType dimType_ = dimType>
   KOKKOS_INLINE_FUNCTION
-  void operator()(const typename std::enable_if<dimType_==TWO_D, int>::type&  index) const
+  void operator()(const typename std::enable_if<dimType_==TWO_D, int>::type& i,
+                  const int& j) const
   {
     
-    const int isize = U.extent(0);
-    const int jsize = U.extent(1);
     const int nbvar = U.extent(2);
-    int i,j;
 
     /*
      * Proceed with copy
@@ -223,20 +232,12 @@ public:
      */      
     if (boundaryLoc == XMIN or boundaryLoc == XMAX) {
       
-      //j = index / ghostWidth;
-      //i = index - j*ghostWidth;
-      index2coord(index,i,j,ghostWidth,jsize);
-      
       for (int nVar=0; nVar<nbvar; ++nVar) {
 	b(i,j,nVar) = U(offset+i  ,j,nVar);
       }
       
     } else if (boundaryLoc == YMIN or boundaryLoc == YMAX) {
 
-      //i = index / ghostWidth;
-      //j = index - i*ghostWidth;
-      index2coord(index,i,j,isize,ghostWidth);
-
       for (int nVar=0; nVar<nbvar; ++nVar) {
 	b(i,j,nVar) = U(i,offset+j  ,nVar);
       }
@@ -247,25 +248,12 @@ public:
 
   template<DimensionType dimType_ = dimType>
   KOKKOS_INLINE_FUNCTION
-  void operator()(const typename std::enable_if<dimType_==THREE_D, int>::type&  index) const
+  void operator()(const typename std::enable_if<dimType_==THREE_D, int>::type& i,
+                  const int& j,
+                  const int& k) const
   {
 
-    const int isize = U.extent(0);
-    const int jsize = U.extent(1);
-    const int ksize = U.extent(2);
     const int nbvar = U.extent(3);
-    const int    gw = ghostWidth;
-
-    int i,j,k;
-
-    // compute i,j,k
-    if (boundaryLoc == XMIN or boundaryLoc == XMAX) {
-      index2coord(index,i,j,k,   gw,jsize,ksize);
-    } else if (boundaryLoc == YMIN or boundaryLoc == YMAX) {
-      index2coord(index,i,j,k,isize,   gw,ksize);
-    } else {
-      index2coord(index,i,j,k,isize,jsize,   gw);
-    }
 
     /*
      * Proceed with copy
@@ -310,6 +298,129 @@ public:
 
 }; // class CopyDataArray_To_BorderBuf
 
+/**
+ * \class CopyDataArraySlab
+ *
+ * Copy a slab of nLayers cell layers along direction dir, from src
+ * (starting at layer srcStart) to dst (starting at layer dstStart); the
+ * two arrays share the same extents along the other directions.
+ *
+ * Used by dynamic load balancing to pack / unpack the layers of cells
+ * migrating between MPI neighbors, and to copy the cells which stay in
+ * place into the resized array. Also used to move data between the
+ * blocks of an over-decomposed sub-domain (see MultiBlock).
+ *
+ * template parameters:
+ * @tparam dimType     : triggers 2D or 3D specific treatment
+ * @tparam DataArray_t : array type, last extent is the number of
+ *                       components (state arrays by default)
+ */
+template<DimensionType dimType,
+	 class DataArray_t = typename std::conditional<dimType==TWO_D,DataArray2d,DataArray3d>::type>
+class CopyDataArraySlab {
+
+public:
+  //! data array type
+  using DataArray  = DataArray_t;
+
+  CopyDataArraySlab(DataArray dst,
+		    DataArray src,
+		    int       dir,
+		    int       dstStart,
+		    int       srcStart) :
+    dst(dst), src(src), dir(dir), dstStart(dstStart), srcStart(srcStart) {};
+
+  // static method which does it all: create and execute functor
+  static void apply(DataArray dst,
+		    DataArray src,
+		    int       dir,
+		    int       dstStart,
+		    int       srcStart,
+		    int       nLayers,
+                    const Kokkos::Array<int,3>& tile)
+  {
+    if (nLayers <= 0)
+      return;
+
+    CopyDataArraySlab<dimType,DataArray_t> functor(dst, src, dir, dstStart, srcStart);
+
+    // launch over the slab (last extent of dst is not used in 2D)
+    int ext[3] = {0, 0, 0};
+    for (int d=0; d<3; ++d)
+      ext[d] = d == dir ? nLayers : dst.extent(d);
+
+    launch(functor, ext, tile);
+  }
+
+  template<DimensionType dimType_ = dimType>
+  static void launch(const CopyDataArraySlab<dimType,DataArray_t>& functor,
+		     const int (&ext)[3],
+		     const Kokkos::Array<int,3>& tile,
+		     typename std::enable_if<dimType_==TWO_D, int>::type = 0)
+  {
+    Kokkos::parallel_for("copy slab 2d",
+			 md_policy_2d(0, 0, ext[0], ext[1], tile),
+			 functor);
+  }
+
+  template<DimensionType dimType_ = dimType>
+  static void launch(const CopyDataArraySlab<dimType,DataArray_t>& functor,
+		     const int (&ext)[3],
+		     const Kokkos::Array<int,3>& tile,
+		     typename std::enable_if<dimType_==THREE_D, int>::type = 0)
+  {
+    Kokkos::parallel_for("copy slab 3d",
+			 md_policy_3d(0, 0, 0, ext[0], ext[1], ext[2], tile),
+			 functor);
+  }
+
+  template<DimensionType dimType_ = dimType>
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const typename std::enable_if<dimType_==TWO_D, int>::type& i,
+                  const int& j) const
+  {
+
+    const int nbvar = src.extent(2);
+
+    const int id = dir == IX ? i+dstStart : i;
+    const int jd = dir == IY ? j+dstStart : j;
+    const int is = dir == IX ? i+srcStart : i;
+    const int js = dir == IY ? j+srcStart : j;
+
+    for (int nVar=0; nVar<nbvar; ++nVar)
+      dst(id,jd,nVar) = src(is,js,nVar);
+
+  } // operator() - 2D
+
+  template<DimensionType dimType_ = dimType>
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const typename std::enable_if<dimType_==THREE_D, int>::type& i,
+                  const int& j,
+                  const int& k) const
+  {
+
+    const int nbvar = src.extent(3);
+
+    const int id = dir == IX ? i+dstStart : i;
+    const int jd = dir == IY ? j+dstStart : j;
+    const int kd = dir == IZ ? k+dstStart : k;
+    const int is = dir == IX ? i+srcStart : i;
+    const int js = dir == IY ? j+srcStart : j;
+    const int ks = dir == IZ ? k+srcStart : k;
+
+    for (int nVar=0; nVar<nbvar; ++nVar)
+      dst(id,jd,kd,nVar) = src(is,js,ks,nVar);
+
+  } // operator() - 3D
+
+  DataArray dst;
+  DataArray src;
+  int       dir;
+  int       dstStart;
+  int       srcStart;
+
+}; // class CopyDataArraySlab
+
 } // namespace ppkMHD
 
 #endif // MPI_BORDER_UTILS_H_
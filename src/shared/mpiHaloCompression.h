@@ -0,0 +1,502 @@
+/**
+ * \file mpiHaloCompression.h
+ * \brief Reduced-precision MPI halo messages.
+ *
+ * Border cells are converted to a narrower type directly in the pack
+ * kernel (reading the data array, no intermediate full-precision border
+ * buffer), and expanded back in the unpack kernel (writing the ghost
+ * cells). Available encodings :
+ * - float   : 32 bits floating point (relative error 6e-8)
+ * - fixed16 : 16 bits fixed point over [min,max] of each component in
+ *   the message (absolute error bounded by (max-min)/(2*(2^16-1)), half
+ *   the quantization step)
+ * - fixed32 : 32 bits fixed point (absolute error bounded by
+ *   (max-min)/(2*(2^32-1)))
+ *
+ * Some variables may be kept at full precision (storage_t), see
+ * fullMask : bit iVar set means variable iVar is not converted.
+ * A border buffer component c belongs to variable c / (ncomp / nbvar),
+ * i.e. components are assumed grouped by variable (true for finite volume
+ * arrays, and for SDM / MOOD arrays, see DofMap).
+ *
+ * Message layout (bytes, each section 8 bytes aligned) :
+ * - header (fixed point only) : min and max of each component (2*ncomp doubles)
+ * - components kept at full precision : nCells * nFull storage_t
+ * - converted components : nCells * nReduced wire values
+ * where cell index is i + n0*(j + n1*k), (i,j,k) being the coordinates
+ * inside the border buffer (of extents n0, n1, n2).
+ */
+#ifndef MPI_HALO_COMPRESSION_H_
+#define MPI_HALO_COMPRESSION_H_
+
+#include <cstdint>
+#include <limits>
+
+#include "shared/kokkos_shared.h"
+#include "shared/enums.h"
+#include "shared/mpiBorderUtils.h" // for launch_border_copy
+
+namespace ppkMHD {
+
+//! halo messages precision
+enum HaloPrecision {
+  HALO_PRECISION_FULL,    /*!< storage_t, no conversion */
+  HALO_PRECISION_FLOAT,   /*!< 32 bits floating point */
+  HALO_PRECISION_FIXED16, /*!< 16 bits fixed point */
+  HALO_PRECISION_FIXED32  /*!< 32 bits fixed point */
+};
+
+//! byte buffer holding an encoded halo message
+using HaloMessage = Kokkos::View<uint8_t*, Device>;
+
+//! per component values (min / max, errors), double precision
+using HaloRange = Kokkos::View<double*, Device>;
+
+/**
+ * Wire encodings.
+ */
+struct HaloWireFloat {
+
+  using type = float;
+  static constexpr bool fixed = false;
+
+  KOKKOS_INLINE_FUNCTION
+  static type encode(double x, double /*lo*/, double /*hi*/)
+  {
+    return static_cast<type>(x);
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  static double decode(type q, double /*lo*/, double /*hi*/)
+  {
+    return q;
+  }
+
+}; // struct HaloWireFloat
+
+template<class UInt>
+struct HaloWireFixed {
+
+  using type = UInt;
+  static constexpr bool fixed = true;
+
+  //! largest encoded value
+  KOKKOS_INLINE_FUNCTION
+  static constexpr double qmax()
+  {
+    return static_cast<double>(static_cast<UInt>(~UInt(0)));
+  }
+
+  //! values outside [lo,hi] (round-off in the range computation) are
+  //! clamped, the conversion to UInt being undefined out of its range
+  KOKKOS_INLINE_FUNCTION
+  static type encode(double x, double lo, double hi)
+  {
+    if (!(hi > lo))
+      return 0;
+    const double r = (x-lo)/(hi-lo)*qmax()+0.5;
+    return !(r > 0) ? 0 : (r >= qmax() ? static_cast<type>(~UInt(0)) : static_cast<type>(r));
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  static double decode(type q, double lo, double hi)
+  {
+    return lo + (hi-lo)*q/qmax();
+  }
+
+}; // struct HaloWireFixed
+
+//! number of components per cell of a border buffer
+inline int halo_ncomp(DataArray2d b) { return b.extent(2); }
+inline int halo_ncomp(DataArray3d b) { return b.extent(3); }
+
+/**
+ * Byte offsets of the sections of a halo message.
+ */
+struct HaloMessageLayout {
+
+  int64_t nCells;   //!< number of cells in the border buffer
+  int     ncomp;    //!< number of components per cell
+  int     nFull;    //!< components per cell kept at full precision
+  size_t  full;     //!< offset of full precision section
+  size_t  reduced;  //!< offset of converted section
+  size_t  bytes;    //!< total message size
+
+  template<class DataArray>
+  HaloMessageLayout(DataArray b, int nbvar, int fullMask,
+		    size_t wireSize, bool fixed)
+  {
+    ncomp  = halo_ncomp(b);
+    nCells = b.size() / ncomp;
+
+    const int compPerVar = ncomp / nbvar;
+    nFull = 0;
+    for (int iVar=0; iVar<nbvar; ++iVar)
+      if ((fullMask >> iVar) & 1)
+	nFull += compPerVar;
+
+    full    = fixed ? align(2*ncomp*sizeof(double)) : 0;
+    reduced = full + align(nCells*nFull*sizeof(storage_t));
+    bytes   = reduced + align(nCells*(ncomp-nFull)*wireSize);
+  }
+
+  static size_t align(size_t n) { return (n+7)/8*8; }
+
+}; // struct HaloMessageLayout
+
+/**
+ * Offset along the boundary normal of the first cell to send (interior
+ * cells) or to receive (ghost cells).
+ */
+template<BoundaryLocation boundaryLoc, class DataArray>
+KOKKOS_INLINE_FUNCTION
+int halo_offset(const DataArray& U, int ghostWidth, bool send)
+{
+  if (boundaryLoc == XMAX)
+    return U.extent(0) - (send ? 2 : 1)*ghostWidth;
+  if (boundaryLoc == YMAX)
+    return U.extent(1) - (send ? 2 : 1)*ghostWidth;
+  if (boundaryLoc == ZMAX)
+    return U.extent(2) - (send ? 2 : 1)*ghostWidth;
+  return send ? ghostWidth : 0;
+}
+
+/**
+ * \class HaloMessageFunctor
+ *
+ * Encode (pack) the cells of a border into a halo message, decode
+ * (unpack) a halo message into the ghost cells of a border, compute the
+ * range of each component (fixed point encodings) or compare decoded
+ * ghost cells to a full precision border buffer (accuracy check).
+ *
+ * The functor is launched over the border buffer extents (multidimensional
+ * range policy), the border buffer b is only used for its extents, except
+ * in mode HALO_COMPARE.
+ *
+ * template parameters:
+ * @tparam boundaryLoc : boundary location
+ * @tparam dimType     : triggers 2D or 3D specific treatment
+ * @tparam Wire        : HaloWireFloat or HaloWireFixed
+ */
+enum HaloMessageMode {
+  HALO_RANGE,   /*!< min / max of each component (atomics into range) */
+  HALO_PACK,    /*!< data array to message */
+  HALO_UNPACK,  /*!< message to data array */
+  HALO_COMPARE  /*!< max error / max value per variable (atomics into range) */
+};
+
+template<
+  BoundaryLocation boundaryLoc,
+  DimensionType    dimType,
+  class            Wire>
+class HaloMessageFunctor {
+
+public:
+  //! Decide at compile-time which data array to use
+  using DataArray  = typename std::conditional<dimType==TWO_D,DataArray2d,DataArray3d>::type;
+  using wire_t     = typename Wire::type;
+
+  HaloMessageFunctor(DataArray         U,
+		     DataArray         b,
+		     HaloMessage       msg,
+		     HaloRange         range,
+		     int               nbvar,
+		     int               fullMask,
+		     int               ghostWidth,
+		     HaloMessageMode   mode) :
+    U(U), b(b), msg(msg), range(range),
+    nbvar(nbvar), fullMask(fullMask), mode(mode),
+    layout(b, nbvar, fullMask, sizeof(wire_t), Wire::fixed)
+  {
+    offset = halo_offset<boundaryLoc>(U, ghostWidth, mode != HALO_UNPACK and mode != HALO_COMPARE);
+    compPerVar = layout.ncomp / nbvar;
+    n0 = b.extent(0);
+    n1 = b.extent(1);
+  };
+
+  // static method which does it all: create and execute functor
+  static void apply(DataArray         U,
+		    DataArray         b,
+		    HaloMessage       msg,
+		    HaloRange         range,
+		    int               nbvar,
+		    int               fullMask,
+		    int               ghostWidth,
+		    HaloMessageMode   mode,
+                    const Kokkos::Array<int,3>& tile)
+  {
+    HaloMessageFunctor<boundaryLoc,dimType,Wire> functor(U, b, msg, range,
+							   nbvar, fullMask,
+							   ghostWidth, mode);
+    launch_border_copy(functor, b, tile);
+  }
+
+  //! header (min / max of each component) of the message
+  KOKKOS_INLINE_FUNCTION
+  double* header() const
+  {
+    return reinterpret_cast<double*>(msg.data());
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  storage_t* full() const
+  {
+    return reinterpret_cast<storage_t*>(msg.data() + layout.full);
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  wire_t* reduced() const
+  {
+    return reinterpret_cast<wire_t*>(msg.data() + layout.reduced);
+  }
+
+  /**
+   * Process component c of cell index (position in message).
+   * \param[in,out] u   value in the data array
+   * \param[in]     ref full precision value (HALO_COMPARE only)
+   * \param[in,out] iFull, iReduced position of the component in its section
+   */
+  KOKKOS_INLINE_FUNCTION
+  void process(int64_t index, int c, storage_t& u, storage_t ref,
+	       int& iFull, int& iReduced) const
+  {
+
+    const bool keep = (fullMask >> (c/compPerVar)) & 1;
+
+    if (mode == HALO_RANGE) {
+
+      if (!keep) {
+	Kokkos::atomic_fetch_min(&range(2*c  ), static_cast<double>(u));
+	Kokkos::atomic_fetch_max(&range(2*c+1), static_cast<double>(u));
+      }
+
+    } else if (mode == HALO_COMPARE) {
+
+      const int iVar = c/compPerVar;
+      Kokkos::atomic_fetch_max(&range(2*iVar  ), fabs(static_cast<double>(u)-ref));
+      Kokkos::atomic_fetch_max(&range(2*iVar+1), fabs(static_cast<double>(ref)));
+
+    } else if (keep) {
+
+      storage_t& v = full()[index*layout.nFull + iFull++];
+      if (mode == HALO_PACK)
+	v = u;
+      else
+	u = v;
+
+    } else {
+
+      // min / max of the component : from the range array when packing,
+      // from the message header when unpacking (fixed point only)
+      const int nReduced = layout.ncomp - layout.nFull;
+      const double* h = mode == HALO_PACK ? range.data() : header();
+      const double lo = Wire::fixed ? h[2*c  ] : 0;
+      const double hi = Wire::fixed ? h[2*c+1] : 0;
+
+      wire_t& q = reduced()[index*nReduced + iReduced++];
+      if (mode == HALO_PACK)
+	q = Wire::encode(u, lo, hi);
+      else
+	u = Wire::decode(q, lo, hi);
+
+    }
+
+  } // process
+
+  //! copy range into message header (fixed point only)
+  KOKKOS_INLINE_FUNCTION
+  void write_header(int64_t index) const
+  {
+    if (mode == HALO_PACK and Wire::fixed and index == 0)
+      for (int c=0; c<2*layout.ncomp; ++c)
+	header()[c] = range(c);
+  }
+
+  template<DimensionType dimType_ = dimType>
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const typename std::enable_if<dimType_==TWO_D, int>::type& i,
+                  const int& j) const
+  {
+
+    const int iU = (boundaryLoc == XMIN or boundaryLoc == XMAX) ? offset+i : i;
+    const int jU = (boundaryLoc == YMIN or boundaryLoc == YMAX) ? offset+j : j;
+
+    const int64_t index = i + n0*j;
+    write_header(index);
+
+    int iFull = 0, iReduced = 0;
+    for (int c=0; c<layout.ncomp; ++c)
+      process(index, c, U(iU,jU,c),
+	      mode == HALO_COMPARE ? b(i,j,c) : storage_t(0),
+	      iFull, iReduced);
+
+  } // operator() - 2D
+
+  template<DimensionType dimType_ = dimType>
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const typename std::enable_if<dimType_==THREE_D, int>::type& i,
+                  const int& j,
+                  const int& k) const
+  {
+
+    const int iU = (boundaryLoc == XMIN or boundaryLoc == XMAX) ? offset+i : i;
+    const int jU = (boundaryLoc == YMIN or boundaryLoc == YMAX) ? offset+j : j;
+    const int kU = (boundaryLoc == ZMIN or boundaryLoc == ZMAX) ? offset+k : k;
+
+    const int64_t index = i + n0*(j + n1*static_cast<int64_t>(k));
+    write_header(index);
+
+    int iFull = 0, iReduced = 0;
+    for (int c=0; c<layout.ncomp; ++c)
+      process(index, c, U(iU,jU,kU,c),
+	      mode == HALO_COMPARE ? b(i,j,k,c) : storage_t(0),
+	      iFull, iReduced);
+
+  } // operator() - 3D
+
+  DataArray         U;
+  DataArray         b;
+  HaloMessage       msg;
+  HaloRange         range;
+  int               nbvar;
+  int               fullMask;
+  HaloMessageMode   mode;
+  HaloMessageLayout layout;
+  int               offset;
+  int               compPerVar;
+  int               n0, n1;
+
+}; // class HaloMessageFunctor
+
+/**
+ * Launch a HaloMessageFunctor for a given precision (runtime value, not
+ * HALO_PRECISION_FULL).
+ */
+template<BoundaryLocation boundaryLoc, DimensionType dimType, class DataArray>
+void halo_message_apply(int             precision,
+			DataArray       U,
+			DataArray       b,
+			HaloMessage     msg,
+			HaloRange       range,
+			int             nbvar,
+			int             fullMask,
+			int             ghostWidth,
+			HaloMessageMode mode,
+			const Kokkos::Array<int,3>& tile)
+{
+
+  if (precision == HALO_PRECISION_FIXED16)
+    HaloMessageFunctor<boundaryLoc, dimType, HaloWireFixed<uint16_t> >::
+      apply(U, b, msg, range, nbvar, fullMask, ghostWidth, mode, tile);
+  else if (precision == HALO_PRECISION_FIXED32)
+    HaloMessageFunctor<boundaryLoc, dimType, HaloWireFixed<uint32_t> >::
+      apply(U, b, msg, range, nbvar, fullMask, ghostWidth, mode, tile);
+  else
+    HaloMessageFunctor<boundaryLoc, dimType, HaloWireFloat>::
+      apply(U, b, msg, range, nbvar, fullMask, ghostWidth, mode, tile);
+
+} // halo_message_apply
+
+/**
+ * Size in bytes of the halo message of border buffer b.
+ */
+template<class DataArray>
+size_t halo_message_size(int precision, DataArray b, int nbvar, int fullMask)
+{
+
+  const size_t wireSize = precision == HALO_PRECISION_FIXED16 ? 2 : 4;
+  const bool   fixed    = precision != HALO_PRECISION_FLOAT;
+
+  return HaloMessageLayout(b, nbvar, fullMask, wireSize, fixed).bytes;
+
+} // halo_message_size
+
+/**
+ * Pack the border of U matching border buffer b into message msg
+ * (reallocated if needed). range is a work array (min / max of each
+ * component, fixed point only).
+ */
+template<BoundaryLocation boundaryLoc, DimensionType dimType, class DataArray>
+void pack_halo_message(int          precision,
+		       DataArray    U,
+		       DataArray    b,
+		       HaloMessage& msg,
+		       HaloRange&   range,
+		       int          nbvar,
+		       int          fullMask,
+		       int          ghostWidth,
+		       const Kokkos::Array<int,3>& tile)
+{
+
+  const size_t bytes = halo_message_size(precision, b, nbvar, fullMask);
+  if (msg.extent(0) != bytes)
+    msg = HaloMessage("HaloMessage", bytes);
+
+  if (precision != HALO_PRECISION_FLOAT) {
+
+    const int ncomp = halo_ncomp(b);
+    if (range.extent(0) != 2*ncomp)
+      range = HaloRange("HaloRange", 2*ncomp);
+
+    auto range_host = Kokkos::create_mirror_view(range);
+    for (int c=0; c<ncomp; ++c) {
+      range_host(2*c  ) =  std::numeric_limits<double>::max();
+      range_host(2*c+1) = -std::numeric_limits<double>::max();
+    }
+    Kokkos::deep_copy(range, range_host);
+
+    halo_message_apply<boundaryLoc,dimType>(precision, U, b, msg, range,
+					    nbvar, fullMask, ghostWidth,
+					    HALO_RANGE, tile);
+
+  }
+
+  halo_message_apply<boundaryLoc,dimType>(precision, U, b, msg, range,
+					  nbvar, fullMask, ghostWidth,
+					  HALO_PACK, tile);
+
+} // pack_halo_message
+
+/**
+ * Unpack message msg into the ghost cells of U matching border buffer b.
+ */
+template<BoundaryLocation boundaryLoc, DimensionType dimType, class DataArray>
+void unpack_halo_message(int          precision,
+			 DataArray    U,
+			 DataArray    b,
+			 HaloMessage  msg,
+			 int          nbvar,
+			 int          fullMask,
+			 int          ghostWidth,
+			 const Kokkos::Array<int,3>& tile)
+{
+
+  halo_message_apply<boundaryLoc,dimType>(precision, U, b, msg, HaloRange(),
+					  nbvar, fullMask, ghostWidth,
+					  HALO_UNPACK, tile);
+
+} // unpack_halo_message
+
+/**
+ * Accuracy check : accumulate into error (2*nbvar values) the maximum
+ * difference between the ghost cells of U (decoded from a message) and
+ * the full precision border buffer b (even index), and the maximum
+ * absolute value of b (odd index), per variable.
+ */
+template<BoundaryLocation boundaryLoc, DimensionType dimType, class DataArray>
+void compare_halo_message(DataArray    U,
+			  DataArray    b,
+			  HaloRange    error,
+			  int          nbvar,
+			  int          ghostWidth,
+			  const Kokkos::Array<int,3>& tile)
+{
+
+  HaloMessageFunctor<boundaryLoc, dimType, HaloWireFloat>::
+    apply(U, b, HaloMessage(), error, nbvar, 0, ghostWidth, HALO_COMPARE, tile);
+
+} // compare_halo_message
+
+} // namespace ppkMHD
+
+#endif // MPI_HALO_COMPRESSION_H_
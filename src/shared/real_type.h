@@ -13,13 +13,30 @@
 
 /**
  * \typedef real_t (alias to float or double)
+ *
+ * real_t is the type used for computations (fluxes, reconstructions,
+ * reductions, time update). When USE_MIXED_PRECISION is defined,
+ * computations are done in double precision.
  */
-#ifdef USE_DOUBLE
+#if defined(USE_DOUBLE) || defined(USE_MIXED_PRECISION)
 using real_t = double;
 #else
 using real_t = float;
 #endif // USE_DOUBLE
 
+/**
+ * \typedef storage_t (alias to float or double)
+ *
+ * storage_t is the type used to store the state arrays (DataArray).
+ * In mixed precision mode, state is stored in single precision
+ * and promoted to real_t when loaded in a kernel.
+ */
+#ifdef USE_MIXED_PRECISION
+using storage_t = float;
+#else
+using storage_t = real_t;
+#endif // USE_MIXED_PRECISION
+
 // math function
 #if defined(USE_DOUBLE) ||  defined(USE_MIXED_PRECISION)
 #define FMAX(x,y) fmax(x,y)
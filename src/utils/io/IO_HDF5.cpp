@@ -14,16 +14,16 @@ void writeXdmfForHdf5Wrapper(HydroParams& params,
 			     bool singleStep)
 {
 
-  // domain (no-MPI) or sub-domain sizes (MPI)
-  const int nx = params.nx;
-  const int ny = params.ny;
-  const int nz = params.nz;
-
 #ifdef USE_MPI
   // sub-domain decomposition sizes
   const int mx = params.mx;
   const int my = params.my;
   const int mz = params.mz;
+
+  // largest sub-domain sizes (sub-domains may differ)
+  const int nxMax = params.block_size_max(IX);
+  const int nyMax = params.block_size_max(IY);
+  const int nzMax = params.block_size_max(IZ);
 #endif
   
   const int ghostWidth = params.ghostWidth;
@@ -36,14 +36,14 @@ void writeXdmfForHdf5Wrapper(HydroParams& params,
 
 #ifdef USE_MPI
   // global sizes
-  int nxg = mx*nx;
-  int nyg = my*ny;
-  int nzg = mz*nz;
+  int nxg = params.nGlobal[IX];
+  int nyg = params.nGlobal[IY];
+  int nzg = params.nGlobal[IZ];
 #else  
   // data size actually written on disk
-  int nxg = nx;
-  int nyg = ny;
-  int nzg = nz;
+  int nxg = params.nx;
+  int nyg = params.ny;
+  int nzg = params.nz;
 #endif // USE_MPI
 
   if (ghostIncluded) {
@@ -61,9 +61,9 @@ void writeXdmfForHdf5Wrapper(HydroParams& params,
    */
   bool allghostIncluded = configMap.getBool("output","allghostIncluded",false);
   if (allghostIncluded) {
-    nxg = mx*(nx+2*ghostWidth);
-    nyg = my*(ny+2*ghostWidth);
-    nzg = mz*(nz+2*ghostWidth);
+    nxg = params.nGlobal[IX]+mx*2*ghostWidth;
+    nyg = params.nGlobal[IY]+my*2*ghostWidth;
+    nzg = params.nGlobal[IZ]+mz*2*ghostWidth;
   }
 
   /*
@@ -72,23 +72,24 @@ void writeXdmfForHdf5Wrapper(HydroParams& params,
    */
   bool reassembleInFile = configMap.getBool("output", "reassembleInFile", true);
   if (!reassembleInFile) {
+    // pieces are stacked, one slot of the largest sub-domain size per rank
     if (dimType==TWO_D) {
       if (allghostIncluded or ghostIncluded) {
-	nxg = (nx+2*ghostWidth);
-	nyg = (ny+2*ghostWidth)*mx*my;
+	nxg = (nxMax+2*ghostWidth);
+	nyg = (nyMax+2*ghostWidth)*mx*my;
       } else {
-	nxg = nx;
-	nyg = ny*mx*my;
+	nxg = nxMax;
+	nyg = nyMax*mx*my;
       }
     } else {
       if (allghostIncluded or ghostIncluded) {
-	nxg = nx+2*ghostWidth;
-	nyg = ny+2*ghostWidth;
-	nzg = (nz+2*ghostWidth)*mx*my*mz;
+	nxg = nxMax+2*ghostWidth;
+	nyg = nyMax+2*ghostWidth;
+	nzg = (nzMax+2*ghostWidth)*mx*my*mz;
       } else {
-	nxg = nx;
-	nyg = ny;
-	nzg = nz*mx*my*mz;
+	nxg = nxMax;
+	nyg = nyMax;
+	nzg = nzMax*mx*my*mz;
       }
     }
   }
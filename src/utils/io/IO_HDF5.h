@@ -59,6 +59,28 @@ void writeXdmfForHdf5Wrapper(HydroParams& params,
 			     int totalNumberOfSteps,
 			     bool singleStep);
 
+// =======================================================
+// =======================================================
+/**
+ * Host array data seen as real_t, used to read / write a variable of a
+ * left layout array without intermediate buffer.
+ *
+ * Only available when the storage type is real_t : with mixed precision
+ * storage, there is no such pointer (nullptr), and IO classes always use
+ * a real_t buffer (KOKKOS_LAYOUT_RIGHT path).
+ */
+template<typename T>
+struct RealData
+{
+  static real_t* get(T*) { return nullptr; }
+};
+
+template<>
+struct RealData<real_t>
+{
+  static real_t* get(real_t* p) { return p; }
+};
+
 // =======================================================
 // =======================================================
 /**
@@ -102,7 +124,7 @@ public:
 	}
       }
     } else {
-      data = Uhost.data() + isize*jsize*nvar;
+      data = RealData<storage_t>::get(Uhost.data()) + isize*jsize*nvar;
     }
 
   } // copy_buffer
@@ -125,7 +147,7 @@ public:
       }
       
     } else {
-      data = Uhost.data() + isize*jsize*ksize*nvar;
+      data = RealData<storage_t>::get(Uhost.data()) + isize*jsize*ksize*nvar;
     }
 
   } // copy_buffer / 3D
@@ -194,7 +216,9 @@ public:
 
     // here we need to check Uhost memory layout
     KokkosLayout layout;
-    if (std::is_same<typename DataArray::array_layout, Kokkos::LayoutLeft>::value)
+    // (mixed precision storage always goes through the real_t buffer)
+    if (std::is_same<typename DataArray::array_layout, Kokkos::LayoutLeft>::value and
+        std::is_same<storage_t, real_t>::value)
       layout = KOKKOS_LAYOUT_LEFT;
     else
       layout = KOKKOS_LAYOUT_RIGHT;
@@ -527,7 +551,7 @@ public:
 	}
       }
     } else {
-      data = Uhost.data() + isize*jsize*nvar;
+      data = RealData<storage_t>::get(Uhost.data()) + isize*jsize*nvar;
     }
 
   } // copy_buffer
@@ -550,7 +574,7 @@ public:
       }
       
     } else {
-      data = Uhost.data() + isize*jsize*ksize*nvar;
+      data = RealData<storage_t>::get(Uhost.data()) + isize*jsize*ksize*nvar;
     }
 
   } // copy_buffer / 3D
@@ -614,6 +638,23 @@ public:
     const int my = params.my;
     const int mz = params.mz;
 
+    // global sizes
+    const int nxg = params.nGlobal[IX];
+    const int nyg = params.nGlobal[IY];
+    const int nzg = params.nGlobal[IZ];
+
+    // largest sub-domain sizes (sub-domains may differ, see
+    // HydroParams::blockCuts); HDF5 chunk sizes must be the same on all
+    // MPI processes
+    const int nxMax = params.block_size_max(IX);
+    const int nyMax = params.block_size_max(IY);
+    const int nzMax = params.block_size_max(IZ);
+
+    // location of the local sub-domain inside the global domain
+    const int xOffset = params.myOffset[IX];
+    const int yOffset = params.myOffset[IY];
+    const int zOffset = params.myOffset[IZ];
+
     // sub-domaine sizes with ghost cells
     const int isize = params.isize;
     const int jsize = params.jsize;
@@ -643,7 +684,9 @@ public:
 
     // here we need to check Uhost memory layout
     KokkosLayout layout;
-    if (std::is_same<typename DataArray::array_layout, Kokkos::LayoutLeft>::value)
+    // (mixed precision storage always goes through the real_t buffer)
+    if (std::is_same<typename DataArray::array_layout, Kokkos::LayoutLeft>::value and
+        std::is_same<storage_t, real_t>::value)
       layout = KOKKOS_LAYOUT_LEFT;
     else
       layout = KOKKOS_LAYOUT_RIGHT;
@@ -713,6 +756,7 @@ public:
     hsize_t  dims_file[3];
     hsize_t  dims_memory[3];
     hsize_t  dims_chunk[3];
+    hsize_t  dims_block[3]; // local piece sizes
     hid_t dataspace_memory;
     //hid_t dataspace_chunk;
     hid_t dataspace_file;
@@ -726,26 +770,31 @@ public:
 	
 	if (dimType == TWO_D) {
 	  
-	  dims_file[0] = (ny+2*ghostWidth)*(mx*my);
-	  dims_file[1] = (nx+2*ghostWidth);
+	  dims_file[0] = (nyMax+2*ghostWidth)*(mx*my);
+	  dims_file[1] = (nxMax+2*ghostWidth);
 	  dims_memory[0] = jsize;
 	  dims_memory[1] = isize;
-	  dims_chunk[0] = ny+2*ghostWidth;
-	  dims_chunk[1] = nx+2*ghostWidth;
+	  dims_chunk[0] = nyMax+2*ghostWidth;
+	  dims_chunk[1] = nxMax+2*ghostWidth;
+	  dims_block[0] = ny+2*ghostWidth;
+	  dims_block[1] = nx+2*ghostWidth;
 	  dataspace_memory = H5Screate_simple(2, dims_memory, NULL);
 	  dataspace_file   = H5Screate_simple(2, dims_file  , NULL);
 
 	} else { // THREE_D
 
-	  dims_file[0] = (nz+2*ghostWidth)*(mx*my*mz);
-	  dims_file[1] =  ny+2*ghostWidth;
-	  dims_file[2] =  nx+2*ghostWidth;
+	  dims_file[0] = (nzMax+2*ghostWidth)*(mx*my*mz);
+	  dims_file[1] =  nyMax+2*ghostWidth;
+	  dims_file[2] =  nxMax+2*ghostWidth;
 	  dims_memory[0] = ksize; 
 	  dims_memory[1] = jsize;
 	  dims_memory[2] = isize;
-	  dims_chunk[0] = nz+2*ghostWidth;
-	  dims_chunk[1] = ny+2*ghostWidth;
-	  dims_chunk[2] = nx+2*ghostWidth;
+	  dims_chunk[0] = nzMax+2*ghostWidth;
+	  dims_chunk[1] = nyMax+2*ghostWidth;
+	  dims_chunk[2] = nxMax+2*ghostWidth;
+	  dims_block[0] = nz+2*ghostWidth;
+	  dims_block[1] = ny+2*ghostWidth;
+	  dims_block[2] = nx+2*ghostWidth;
 	  dataspace_memory = H5Screate_simple(3, dims_memory, NULL);
 	  dataspace_file   = H5Screate_simple(3, dims_file  , NULL);
 	  
@@ -755,26 +804,31 @@ public:
 	
 	if (dimType == TWO_D) {
 	  
-	  dims_file[0] = (ny)*(mx*my);
-	  dims_file[1] = nx;
+	  dims_file[0] = (nyMax)*(mx*my);
+	  dims_file[1] = nxMax;
 	  dims_memory[0] = jsize; 
 	  dims_memory[1] = isize;
-	  dims_chunk[0] = ny;
-	  dims_chunk[1] = nx;
+	  dims_chunk[0] = nyMax;
+	  dims_chunk[1] = nxMax;
+	  dims_block[0] = ny;
+	  dims_block[1] = nx;
 	  dataspace_memory = H5Screate_simple(2, dims_memory, NULL);
 	  dataspace_file   = H5Screate_simple(2, dims_file  , NULL);
 
 	} else {
 
-	  dims_file[0] = (nz)*(mx*my*mz);
-	  dims_file[1] = ny;
-	  dims_file[2] = nx;
+	  dims_file[0] = (nzMax)*(mx*my*mz);
+	  dims_file[1] = nyMax;
+	  dims_file[2] = nxMax;
 	  dims_memory[0] = ksize; 
 	  dims_memory[1] = jsize;
 	  dims_memory[2] = isize;
-	  dims_chunk[0] = nz;
-	  dims_chunk[1] = ny;
-	  dims_chunk[2] = nx;
+	  dims_chunk[0] = nzMax;
+	  dims_chunk[1] = nyMax;
+	  dims_chunk[2] = nxMax;
+	  dims_block[0] = nz;
+	  dims_block[1] = ny;
+	  dims_block[2] = nx;
 	  dataspace_memory = H5Screate_simple(3, dims_memory, NULL);
 	  dataspace_file   = H5Screate_simple(3, dims_file  , NULL);
 	  
@@ -791,26 +845,31 @@ public:
 	
 	if (dimType == TWO_D) {
 	  
-	  dims_file[0] = my*(ny+2*ghostWidth);
-	  dims_file[1] = mx*(nx+2*ghostWidth);
+	  dims_file[0] = nyg+my*2*ghostWidth;
+	  dims_file[1] = nxg+mx*2*ghostWidth;
 	  dims_memory[0] = jsize; 
 	  dims_memory[1] = isize;
-	  dims_chunk[0] = ny+2*ghostWidth;
-	  dims_chunk[1] = nx+2*ghostWidth;
+	  dims_chunk[0] = nyMax+2*ghostWidth;
+	  dims_chunk[1] = nxMax+2*ghostWidth;
+	  dims_block[0] = ny+2*ghostWidth;
+	  dims_block[1] = nx+2*ghostWidth;
 	  dataspace_memory = H5Screate_simple(2, dims_memory, NULL);
 	  dataspace_file   = H5Screate_simple(2, dims_file  , NULL);
 
 	} else {
 
-	  dims_file[0] = mz*(nz+2*ghostWidth);
-	  dims_file[1] = my*(ny+2*ghostWidth);
-	  dims_file[2] = mx*(nx+2*ghostWidth);
+	  dims_file[0] = nzg+mz*2*ghostWidth;
+	  dims_file[1] = nyg+my*2*ghostWidth;
+	  dims_file[2] = nxg+mx*2*ghostWidth;
 	  dims_memory[0] = ksize; 
 	  dims_memory[1] = jsize;
 	  dims_memory[2] = isize;
-	  dims_chunk[0] = nz+2*ghostWidth;
-	  dims_chunk[1] = ny+2*ghostWidth;
-	  dims_chunk[2] = nx+2*ghostWidth;
+	  dims_chunk[0] = nzMax+2*ghostWidth;
+	  dims_chunk[1] = nyMax+2*ghostWidth;
+	  dims_chunk[2] = nxMax+2*ghostWidth;
+	  dims_block[0] = nz+2*ghostWidth;
+	  dims_block[1] = ny+2*ghostWidth;
+	  dims_block[2] = nx+2*ghostWidth;
 	  dataspace_memory = H5Screate_simple(3, dims_memory, NULL);
 	  dataspace_file   = H5Screate_simple(3, dims_file  , NULL);
 	  
@@ -820,26 +879,31 @@ public:
 	
 	if (dimType == TWO_D) {
 	  
-	  dims_file[0] = ny*my+2*ghostWidth;
-	  dims_file[1] = nx*mx+2*ghostWidth;
+	  dims_file[0] = nyg+2*ghostWidth;
+	  dims_file[1] = nxg+2*ghostWidth;
 	  dims_memory[0] = jsize; 
 	  dims_memory[1] = isize;
-	  dims_chunk[0] = ny+2*ghostWidth;
-	  dims_chunk[1] = nx+2*ghostWidth;
+	  dims_chunk[0] = nyMax+2*ghostWidth;
+	  dims_chunk[1] = nxMax+2*ghostWidth;
+	  dims_block[0] = ny+2*ghostWidth;
+	  dims_block[1] = nx+2*ghostWidth;
 	  dataspace_memory = H5Screate_simple(2, dims_memory, NULL);
 	  dataspace_file   = H5Screate_simple(2, dims_file  , NULL);
 
 	} else {
 
-	  dims_file[0] = nz*mz+2*ghostWidth;
-	  dims_file[1] = ny*my+2*ghostWidth;
-	  dims_file[2] = nx*mx+2*ghostWidth;
+	  dims_file[0] = nzg+2*ghostWidth;
+	  dims_file[1] = nyg+2*ghostWidth;
+	  dims_file[2] = nxg+2*ghostWidth;
 	  dims_memory[0] = ksize;
 	  dims_memory[1] = jsize;
 	  dims_memory[2] = isize;
-	  dims_chunk[0] = nz+2*ghostWidth;
-	  dims_chunk[1] = ny+2*ghostWidth;
-	  dims_chunk[2] = nx+2*ghostWidth;
+	  dims_chunk[0] = nzMax+2*ghostWidth;
+	  dims_chunk[1] = nyMax+2*ghostWidth;
+	  dims_chunk[2] = nxMax+2*ghostWidth;
+	  dims_block[0] = nz+2*ghostWidth;
+	  dims_block[1] = ny+2*ghostWidth;
+	  dims_block[2] = nx+2*ghostWidth;
 	  dataspace_memory = H5Screate_simple(3, dims_memory, NULL);
 	  dataspace_file   = H5Screate_simple(3, dims_file  , NULL);
 
@@ -849,26 +913,31 @@ public:
       
 	if (dimType == TWO_D) {
 
-	  dims_file[0] = ny*my;
-	  dims_file[1] = nx*mx;
+	  dims_file[0] = nyg;
+	  dims_file[1] = nxg;
 	  dims_memory[0] = jsize;
 	  dims_memory[1] = isize;
-	  dims_chunk[0] = ny;
-	  dims_chunk[1] = nx;
+	  dims_chunk[0] = nyMax;
+	  dims_chunk[1] = nxMax;
+	  dims_block[0] = ny;
+	  dims_block[1] = nx;
 	  dataspace_memory = H5Screate_simple(2, dims_memory, NULL);
 	  dataspace_file   = H5Screate_simple(2, dims_file  , NULL);
 
 	} else {
 
-	  dims_file[0] = nz*mz;
-	  dims_file[1] = ny*my;
-	  dims_file[2] = nx*mx;
+	  dims_file[0] = nzg;
+	  dims_file[1] = nyg;
+	  dims_file[2] = nxg;
 	  dims_memory[0] = ksize;
 	  dims_memory[1] = jsize;
 	  dims_memory[2] = isize;
-	  dims_chunk[0] = nz;
-	  dims_chunk[1] = ny;
-	  dims_chunk[2] = nx;
+	  dims_chunk[0] = nzMax;
+	  dims_chunk[1] = nyMax;
+	  dims_chunk[2] = nxMax;
+	  dims_block[0] = nz;
+	  dims_block[1] = ny;
+	  dims_block[2] = nx;
 	  dataspace_memory = H5Screate_simple(3, dims_memory, NULL);
 	  dataspace_file   = H5Screate_simple(3, dims_file  , NULL);
 	  
@@ -888,13 +957,13 @@ public:
 	hsize_t  start[2] = { 0, 0 }; // no start offset
 	hsize_t stride[2] = { 1, 1 };
 	hsize_t  count[2] = { 1, 1 };
-	hsize_t  block[2] = { dims_chunk[0], dims_chunk[1] }; // row-major instead of column-major here
+	hsize_t  block[2] = { dims_block[0], dims_block[1] }; // row-major instead of column-major here
 	status = H5Sselect_hyperslab(dataspace_memory, H5S_SELECT_SET, start, stride, count, block);
       } else {
 	hsize_t  start[3] = { 0, 0, 0 }; // no start offset
 	hsize_t stride[3] = { 1, 1, 1 };
 	hsize_t  count[3] = { 1, 1, 1 };
-	hsize_t  block[3] = { dims_chunk[0], dims_chunk[1], dims_chunk[2] }; // row-major instead of column-major here
+	hsize_t  block[3] = { dims_block[0], dims_block[1], dims_block[2] }; // row-major instead of column-major here
 	status = H5Sselect_hyperslab(dataspace_memory, H5S_SELECT_SET, start, stride, count, block);      
       }
       
@@ -933,7 +1002,7 @@ public:
 	//hsize_t  start[2] = { 0, myRank*dims_chunk[1]};
 	hsize_t stride[2] = { 1,  1 };
 	hsize_t  count[2] = { 1,  1 };
-	hsize_t  block[2] = { dims_chunk[0], dims_chunk[1] }; // row-major instead of column-major here
+	hsize_t  block[2] = { dims_block[0], dims_block[1] }; // row-major instead of column-major here
 	status = H5Sselect_hyperslab(dataspace_file, H5S_SELECT_SET, start, stride, count, block);
 	
       } else { // THREE_D
@@ -941,7 +1010,7 @@ public:
 	hsize_t  start[3] = { myRank*dims_chunk[0], 0, 0 };
 	hsize_t stride[3] = { 1,  1,  1 };
 	hsize_t  count[3] = { 1,  1,  1 };
-	hsize_t  block[3] = { dims_chunk[0], dims_chunk[1], dims_chunk[2] }; // row-major instead of column-major here
+	hsize_t  block[3] = { dims_block[0], dims_block[1], dims_block[2] }; // row-major instead of column-major here
 	status = H5Sselect_hyperslab(dataspace_file, H5S_SELECT_SET, start, stride, count, block);
 	
       } // end THREE_D -- allghostIncluded
@@ -956,18 +1025,21 @@ public:
 	
 	if (dimType == TWO_D) {
 	  
-	  hsize_t  start[2] = { coords[1]*dims_chunk[0], coords[0]*dims_chunk[1]};
+	  hsize_t  start[2] = { (hsize_t) (yOffset+coords[1]*2*ghostWidth),
+				(hsize_t) (xOffset+coords[0]*2*ghostWidth) };
 	  hsize_t stride[2] = { 1,  1 };
 	  hsize_t  count[2] = { 1,  1 };
-	  hsize_t  block[2] = { dims_chunk[0], dims_chunk[1] }; // row-major instead of column-major here
+	  hsize_t  block[2] = { dims_block[0], dims_block[1] }; // row-major instead of column-major here
 	  status = H5Sselect_hyperslab(dataspace_file, H5S_SELECT_SET, start, stride, count, block);
 	  
 	} else { // THREE_D
 	  
-	  hsize_t  start[3] = { coords[2]*dims_chunk[0], coords[1]*dims_chunk[1], coords[0]*dims_chunk[2]};
+	  hsize_t  start[3] = { (hsize_t) (zOffset+coords[2]*2*ghostWidth),
+				(hsize_t) (yOffset+coords[1]*2*ghostWidth),
+				(hsize_t) (xOffset+coords[0]*2*ghostWidth) };
 	  hsize_t stride[3] = { 1,  1,  1 };
 	  hsize_t  count[3] = { 1,  1,  1 };
-	  hsize_t  block[3] = { dims_chunk[0], dims_chunk[1], dims_chunk[2] }; // row-major instead of column-major here
+	  hsize_t  block[3] = { dims_block[0], dims_block[1], dims_block[2] }; // row-major instead of column-major here
 	  status = H5Sselect_hyperslab(dataspace_file, H5S_SELECT_SET, start, stride, count, block);
 	  
 	}
@@ -978,25 +1050,25 @@ public:
 	int gOffsetStartX, gOffsetStartY, gOffsetStartZ;
 	
 	if (dimType == TWO_D) {
-	  gOffsetStartY  = coords[1]*ny;
-	  gOffsetStartX  = coords[0]*nx;
+	  gOffsetStartY  = yOffset;
+	  gOffsetStartX  = xOffset;
 	  
 	  hsize_t  start[2] = { (hsize_t) gOffsetStartY, (hsize_t) gOffsetStartX };
 	  hsize_t stride[2] = { 1,  1 };
 	  hsize_t  count[2] = { 1,  1 };
-	  hsize_t  block[2] = { dims_chunk[0], dims_chunk[1] }; // row-major instead of column-major here
+	  hsize_t  block[2] = { dims_block[0], dims_block[1] }; // row-major instead of column-major here
 	  status = H5Sselect_hyperslab(dataspace_file, H5S_SELECT_SET, start, stride, count, block);
 	  
 	} else { // THREE_D
 	  
-	  gOffsetStartZ  = coords[2]*nz;
-	  gOffsetStartY  = coords[1]*ny;
-	  gOffsetStartX  = coords[0]*nx;
+	  gOffsetStartZ  = zOffset;
+	  gOffsetStartY  = yOffset;
+	  gOffsetStartX  = xOffset;
 	  
 	  hsize_t  start[3] = { (hsize_t) gOffsetStartZ, (hsize_t) gOffsetStartY, (hsize_t) gOffsetStartX };
 	  hsize_t stride[3] = { 1,  1,  1 };
 	  hsize_t  count[3] = { 1,  1,  1 };
-	  hsize_t  block[3] = { dims_chunk[0], dims_chunk[1], dims_chunk[2] }; // row-major instead of column-major here
+	  hsize_t  block[3] = { dims_block[0], dims_block[1], dims_block[2] }; // row-major instead of column-major here
 	  status = H5Sselect_hyperslab(dataspace_file, H5S_SELECT_SET, start, stride, count, block);
 	  
 	}
@@ -1005,18 +1077,18 @@ public:
 	
 	if (dimType == TWO_D) {
 	  
-	  hsize_t  start[2] = { coords[1]*dims_chunk[0], coords[0]*dims_chunk[1]};
+	  hsize_t  start[2] = { (hsize_t) yOffset, (hsize_t) xOffset };
 	  hsize_t stride[2] = { 1,  1 };
 	  hsize_t  count[2] = { 1,  1 };
-	  hsize_t  block[2] = { dims_chunk[0], dims_chunk[1] }; // row-major instead of column-major here
+	  hsize_t  block[2] = { dims_block[0], dims_block[1] }; // row-major instead of column-major here
 	  status = H5Sselect_hyperslab(dataspace_file, H5S_SELECT_SET, start, stride, count, block);
 	  
 	} else { // THREE_D
 	  
-	  hsize_t  start[3] = { coords[2]*dims_chunk[0], coords[1]*dims_chunk[1], coords[0]*dims_chunk[2]};
+	  hsize_t  start[3] = { (hsize_t) zOffset, (hsize_t) yOffset, (hsize_t) xOffset };
 	  hsize_t stride[3] = { 1,  1,  1 };
 	  hsize_t  count[3] = { 1,  1,  1 };
-	  hsize_t  block[3] = { dims_chunk[0], dims_chunk[1], dims_chunk[2] }; // row-major instead of column-major here
+	  hsize_t  block[3] = { dims_block[0], dims_block[1], dims_block[2] }; // row-major instead of column-major here
 	  status = H5Sselect_hyperslab(dataspace_file, H5S_SELECT_SET, start, stride, count, block);
 	  
 	} // end THREE_D
@@ -1286,9 +1358,9 @@ public:
 	       1.0*write_size/1048576.0);
 	sum_write_size /= 1048576.0;
 	printf("Global array size %d x %d x %d reals(%zu bytes), write size = %.2f GB\n",
-	       mx*nx+2*ghostWidth,
-	       my*ny+2*ghostWidth,
-	       mz*nz+2*ghostWidth,
+	       nxg+2*ghostWidth,
+	       nyg+2*ghostWidth,
+	       nzg+2*ghostWidth,
 	       sizeof(real_t),
 	       1.0*sum_write_size/1024);
 	
@@ -1296,9 +1368,9 @@ public:
 	printf(" procs    Global array size  exec(sec)  write(MB/s)\n");
 	printf("-------  ------------------  ---------  -----------\n");
 	printf(" %4d    %4d x %4d x %4d %8.2f  %10.2f\n", params.nProcs,
-	       mx*nx+2*ghostWidth,
-	       my*ny+2*ghostWidth,
-	       mz*nz+2*ghostWidth,
+	       nxg+2*ghostWidth,
+	       nyg+2*ghostWidth,
+	       nzg+2*ghostWidth,
 	       max_write_timing, write_bw);
 	printf("########################################################\n");
       } // end (myRank == 0)
@@ -1448,7 +1520,7 @@ public:
 	}
       } else {
 	// simple copy
-	real_t* tmp = Uhost.data() + isize*jsize*nvar;
+	real_t* tmp = RealData<storage_t>::get(Uhost.data()) + isize*jsize*nvar;
 	memcpy(tmp,data,isize*jsize*sizeof(real_t));
       }
     }
@@ -1538,7 +1610,7 @@ public:
 	
       } else {
 	// simple copy
-	real_t* tmp = Uhost.data() + isize*jsize*ksize*nvar;
+	real_t* tmp = RealData<storage_t>::get(Uhost.data()) + isize*jsize*ksize*nvar;
 	memcpy(tmp,data,isize*jsize*ksize*sizeof(real_t));
       }
 
@@ -1771,7 +1843,9 @@ public:
     // here we need to check Udata / Uhost memory layout 
     // see https://github.com/kokkos/kokkos/wiki/View - section 6.3.4
     KokkosLayout layout;
-    if (std::is_same<typename DataArray::array_layout, Kokkos::LayoutLeft>::value)
+    // (mixed precision storage always goes through the real_t buffer)
+    if (std::is_same<typename DataArray::array_layout, Kokkos::LayoutLeft>::value and
+        std::is_same<storage_t, real_t>::value)
       layout = KOKKOS_LAYOUT_LEFT;
     else
       layout = KOKKOS_LAYOUT_RIGHT;
@@ -2053,6 +2127,18 @@ public:
       
     }
 
+    // global sizes and location of the local sub-domain to read
+    // (sub-domains may differ, see HydroParams::block_size)
+    const int ratio = halfResolution ? 2 : 1;
+
+    const int nxg_r = this->params.nGlobal[IX]/ratio;
+    const int nyg_r = this->params.nGlobal[IY]/ratio;
+    const int nzg_r = this->params.nGlobal[IZ]/ratio;
+
+    const int xOffset_r = this->params.myOffset[IX]/ratio;
+    const int yOffset_r = this->params.myOffset[IY]/ratio;
+    const int zOffset_r = this->params.myOffset[IZ]/ratio;
+
     read_size = dimType == TWO_D ? nx_rg*ny_rg : nx_rg*ny_rg*nz_rg;
     read_size *= nbvar;
     read_size *= sizeof(real_t);
@@ -2088,8 +2174,8 @@ public:
       
       if (dimType == TWO_D) {
 	
-	dims_file[0] = my*ny_rg;
-	dims_file[1] = mx*nx_rg;
+	dims_file[0] = nyg_r+my*2*ghostWidth;
+	dims_file[1] = nxg_r+mx*2*ghostWidth;
 	dims_memory[0] = ny_rg; 
 	dims_memory[1] = nx_rg;
 	dims_chunk[0] = ny_rg;
@@ -2099,9 +2185,9 @@ public:
 
       } else { // THREE_D
 
-	dims_file[0] = mz*nz_rg;
-	dims_file[1] = my*ny_rg;
-	dims_file[2] = mx*nx_rg;
+	dims_file[0] = nzg_r+mz*2*ghostWidth;
+	dims_file[1] = nyg_r+my*2*ghostWidth;
+	dims_file[2] = nxg_r+mx*2*ghostWidth;
 	dims_memory[0] = nz_rg; 
 	dims_memory[1] = ny_rg;
 	dims_memory[2] = nx_rg;
@@ -2117,8 +2203,8 @@ public:
 
       if (dimType == TWO_D) {
 
-	dims_file[0] = ny_r*my+2*ghostWidth;
-	dims_file[1] = nx_r*mx+2*ghostWidth;
+	dims_file[0] = nyg_r+2*ghostWidth;
+	dims_file[1] = nxg_r+2*ghostWidth;
 	dims_memory[0] = ny_rg;
 	dims_memory[1] = nx_rg;
 	dims_chunk[0] = ny_rg;
@@ -2128,9 +2214,9 @@ public:
 
       } else { // THREE_D
 
-	dims_file[0] = nz_r*mz+2*ghostWidth;
-	dims_file[1] = ny_r*my+2*ghostWidth;
-	dims_file[2] = nx_r*mx+2*ghostWidth;
+	dims_file[0] = nzg_r+2*ghostWidth;
+	dims_file[1] = nyg_r+2*ghostWidth;
+	dims_file[2] = nxg_r+2*ghostWidth;
 	dims_memory[0] = nz_rg;
 	dims_memory[1] = ny_rg;
 	dims_memory[2] = nx_rg;
@@ -2146,8 +2232,8 @@ public:
 
       if (dimType == TWO_D) {
 
-	dims_file[0] = ny_r*my;
-	dims_file[1] = nx_r*mx;
+	dims_file[0] = nyg_r;
+	dims_file[1] = nxg_r;
 
 	dims_memory[0] = ny_rg;
 	dims_memory[1] = nx_rg;
@@ -2160,9 +2246,9 @@ public:
 
       } else {
 
-	dims_file[0] = nz_r*mz;
-	dims_file[1] = ny_r*my;
-	dims_file[2] = nx_r*mx;
+	dims_file[0] = nzg_r;
+	dims_file[1] = nyg_r;
+	dims_file[2] = nxg_r;
 
 	dims_memory[0] = nz_rg;
 	dims_memory[1] = ny_rg;
@@ -2226,7 +2312,8 @@ public:
 
       if (dimType == TWO_D) {
 	
-	hsize_t  start[2] = { coords[1]*dims_chunk[0], coords[0]*dims_chunk[1]};
+	hsize_t  start[2] = { (hsize_t) (yOffset_r+coords[1]*2*ghostWidth),
+			      (hsize_t) (xOffset_r+coords[0]*2*ghostWidth) };
 	hsize_t stride[2] = { 1,  1 };
 	hsize_t  count[2] = { 1,  1 };
 	hsize_t  block[2] = { dims_chunk[0], dims_chunk[1] }; // row-major instead of column-major here
@@ -2234,7 +2321,9 @@ public:
 	
       } else { // THREE_D
 	
-	hsize_t  start[3] = { coords[2]*dims_chunk[0], coords[1]*dims_chunk[1], coords[0]*dims_chunk[2]};
+	hsize_t  start[3] = { (hsize_t) (zOffset_r+coords[2]*2*ghostWidth),
+			      (hsize_t) (yOffset_r+coords[1]*2*ghostWidth),
+			      (hsize_t) (xOffset_r+coords[0]*2*ghostWidth) };
 	hsize_t stride[3] = { 1,  1,  1 };
 	hsize_t  count[3] = { 1,  1,  1 };
 	hsize_t  block[3] = { dims_chunk[0], dims_chunk[1], dims_chunk[2] }; // row-major instead of column-major here
@@ -2248,8 +2337,8 @@ public:
       int gOffsetStartX, gOffsetStartY, gOffsetStartZ;
 
       if (dimType == TWO_D) {
-	gOffsetStartY  = coords[1]*ny_r;
-	gOffsetStartX  = coords[0]*nx_r;
+	gOffsetStartY  = yOffset_r;
+	gOffsetStartX  = xOffset_r;
 
 	hsize_t  start[2] = { (hsize_t) gOffsetStartY, (hsize_t) gOffsetStartX };
 	hsize_t stride[2] = { 1,  1};
@@ -2259,9 +2348,9 @@ public:
 	
       } else { // THREE_D
 	
-	gOffsetStartZ  = coords[2]*nz_r;
-	gOffsetStartY  = coords[1]*ny_r;
-	gOffsetStartX  = coords[0]*nx_r;
+	gOffsetStartZ  = zOffset_r;
+	gOffsetStartY  = yOffset_r;
+	gOffsetStartX  = xOffset_r;
 
 	hsize_t  start[3] = { (hsize_t) gOffsetStartZ, (hsize_t) gOffsetStartY, (hsize_t) gOffsetStartX };
 	hsize_t stride[3] = { 1,  1,  1};
@@ -2275,7 +2364,7 @@ public:
       
       if (dimType == TWO_D) {
 	
-	hsize_t  start[2] = { coords[1]*dims_chunk[0], coords[0]*dims_chunk[1]};
+	hsize_t  start[2] = { (hsize_t) yOffset_r, (hsize_t) xOffset_r };
 	hsize_t stride[2] = { 1,  1};
 	hsize_t  count[2] = { 1,  1};
 	hsize_t  block[2] = { dims_chunk[0], dims_chunk[1] }; // row-major instead of column-major here
@@ -2283,7 +2372,7 @@ public:
 	
       } else { // THREE_D
 	
-	hsize_t  start[3] = { coords[2]*dims_chunk[0], coords[1]*dims_chunk[1], coords[0]*dims_chunk[2]};
+	hsize_t  start[3] = { (hsize_t) zOffset_r, (hsize_t) yOffset_r, (hsize_t) xOffset_r };
 	hsize_t stride[3] = { 1,  1,  1};
 	hsize_t  count[3] = { 1,  1,  1};
 	hsize_t  block[3] = { dims_chunk[0], dims_chunk[1], dims_chunk[2] }; // row-major instead of column-major here
@@ -2318,7 +2407,9 @@ public:
     // here we need to check Udata / Uhost memory layout 
     // see https://github.com/kokkos/kokkos/wiki/View - section 6.3.4
     KokkosLayout layout;
-    if (std::is_same<typename DataArray::array_layout, Kokkos::LayoutLeft>::value)
+    // (mixed precision storage always goes through the real_t buffer)
+    if (std::is_same<typename DataArray::array_layout, Kokkos::LayoutLeft>::value and
+        std::is_same<storage_t, real_t>::value)
       layout = KOKKOS_LAYOUT_LEFT;
     else
       layout = KOKKOS_LAYOUT_RIGHT;
@@ -2446,9 +2537,9 @@ public:
 	       1.0*read_size/1048576.0);
 	sum_read_size /= 1048576.0;
 	printf("Global array size %d x %d x %d reals(%zu bytes), read size = %.2f GB\n",
-	       mx*nx+2*ghostWidth,
-	       my*ny+2*ghostWidth,
-	       mz*nz+2*ghostWidth,
+	       this->params.nGlobal[IX]+2*ghostWidth,
+	       this->params.nGlobal[IY]+2*ghostWidth,
+	       this->params.nGlobal[IZ]+2*ghostWidth,
 	       sizeof(real_t),
 	       1.0*sum_read_size/1024);
 	
@@ -2456,9 +2547,9 @@ public:
 	printf(" procs    Global array size  exec(sec)  read(MB/s)\n");
 	printf("-------  ------------------  ---------  -----------\n");
 	printf(" %4d    %4d x %4d x %4d %8.2f  %10.2f\n", nProcs,
-	       mx*nx+2*ghostWidth,
-	       my*ny+2*ghostWidth,
-	       mz*nz+2*ghostWidth,
+	       this->params.nGlobal[IX]+2*ghostWidth,
+	       this->params.nGlobal[IY]+2*ghostWidth,
+	       this->params.nGlobal[IZ]+2*ghostWidth,
 	       max_read_timing, read_bw);
 	printf("########################################################\n");
 
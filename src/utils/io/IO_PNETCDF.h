@@ -145,6 +145,12 @@ public:
     const int my = params.my;
     const int mz = params.mz;
 
+    // global sizes (sub-domains may differ, see
+    // HydroParams::block_size)
+    const int nxg = params.nGlobal[IX];
+    const int nyg = params.nGlobal[IY];
+    const int nzg = params.nGlobal[IZ];
+
     // sub-domaine sizes with ghost cells
     const int isize = params.isize;
     const int jsize = params.jsize;
@@ -260,8 +266,8 @@ public:
      */
     int gsizes[3];
     if (dimType == TWO_D) {
-      gsizes[1] = mx*nx+2*ghostWidth;
-      gsizes[0] = my*ny+2*ghostWidth;
+      gsizes[1] = nxg+2*ghostWidth;
+      gsizes[0] = nyg+2*ghostWidth;
       
       err = ncmpi_def_dim(ncFileId, "x", gsizes[0], &dimIds[0]);
       PNETCDF_HANDLE_ERROR;
@@ -270,9 +276,9 @@ public:
       PNETCDF_HANDLE_ERROR;
     
     } else { 
-      gsizes[2] = mx*nx+2*ghostWidth;
-      gsizes[1] = my*ny+2*ghostWidth;
-      gsizes[0] = mz*nz+2*ghostWidth;
+      gsizes[2] = nxg+2*ghostWidth;
+      gsizes[1] = nyg+2*ghostWidth;
+      gsizes[0] = nzg+2*ghostWidth;
       
       err = ncmpi_def_dim(ncFileId, "x", gsizes[0], &dimIds[0]);
       PNETCDF_HANDLE_ERROR;
@@ -406,8 +412,8 @@ public:
       counts[IY] = nx;
       counts[IX] = ny;
       
-      starts[IY] = coords[IX]*nx;
-      starts[IX] = coords[IY]*ny;
+      starts[IY] = params.myOffset[IX];
+      starts[IX] = params.myOffset[IY];
       
       // take care of borders along X
       if (coords[IX]==mx-1) {
@@ -425,9 +431,9 @@ public:
       counts[IY] = ny;
       counts[IX] = nz;
       
-      starts[IZ] = coords[IX]*nx;
-      starts[IY] = coords[IY]*ny;
-      starts[IX] = coords[IZ]*nz;
+      starts[IZ] = params.myOffset[IX];
+      starts[IY] = params.myOffset[IY];
+      starts[IX] = params.myOffset[IZ];
       
       // take care of borders along X
       if (coords[IX]==mx-1) {
@@ -506,9 +512,9 @@ public:
 	       1.0*write_size/1048576.0);
 	sum_write_size /= 1048576.0;
 	printf("Global array size %d x %d x %d reals(%zu bytes), write size = %.2f GB\n",
-	       mx*nx+2*ghostWidth,
-	       my*ny+2*ghostWidth,
-	       mz*nz+2*ghostWidth,
+	       nxg+2*ghostWidth,
+	       nyg+2*ghostWidth,
+	       nzg+2*ghostWidth,
 	       sizeof(real_t),
 	       1.0*sum_write_size/1024);
 	
@@ -516,9 +522,9 @@ public:
 	printf(" procs    Global array size  exec(sec)  write(MB/s)\n");
 	printf("-------  ------------------  ---------  -----------\n");
 	printf(" %4d    %4d x %4d x %4d %8.2f  %10.2f\n", params.nProcs,
-	       mx*nx+2*ghostWidth,
-	       my*ny+2*ghostWidth,
-	       mz*nz+2*ghostWidth,
+	       nxg+2*ghostWidth,
+	       nyg+2*ghostWidth,
+	       nzg+2*ghostWidth,
 	       max_write_timing, write_bw);
 	printf("########################################################\n");
       } // end (myRank == 0)
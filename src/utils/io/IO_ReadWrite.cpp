@@ -27,7 +27,9 @@ IO_ReadWrite::IO_ReadWrite(HydroParams& params,
   variables_names(variables_names),
   vtk_enabled(true),
   hdf5_enabled(false),
-  pnetcdf_enabled(false)
+  pnetcdf_enabled(false),
+  vtk_staged(true),
+  vtk_writer(params, configMap, variables_names)
 {
   
   // do we want VTK output ?
@@ -38,6 +40,10 @@ IO_ReadWrite::IO_ReadWrite(HydroParams& params,
   
   // do we want Parallel NETCDF output ? Only valid/activated for MPI run
   pnetcdf_enabled = configMap.getBool("output","pnetcdf_enabled", false);
+
+  // binary VTK output through the staging buffer (default), unless ascii
+  vtk_staged = configMap.getBool("output","outputVtkStaged", true) and
+    !configMap.getBool("output","outputVtkAscii", false);
   
 } // IO_ReadWrite::IO_ReadWrite
 
@@ -75,12 +81,16 @@ void IO_ReadWrite::save_data_impl(DataArray2d             Udata,
 {
 
   if (vtk_enabled) {
-    
+
+    if (vtk_staged) {
+      vtk_writer.save(Udata, iStep, debug_name);
+    } else {
 #ifdef USE_MPI
-    save_VTK_2D_mpi(Udata, Uhost, params, configMap, params.nbvar, variables_names, iStep, debug_name);
+      save_VTK_2D_mpi(Udata, Uhost, params, configMap, params.nbvar, variables_names, iStep, debug_name);
 #else
-    save_VTK_2D(Udata, Uhost, params, configMap, params.nbvar, variables_names, iStep, debug_name);
+      save_VTK_2D(Udata, Uhost, params, configMap, params.nbvar, variables_names, iStep, debug_name);
 #endif // USE_MPI
+    }
 
   }
 
@@ -118,11 +128,15 @@ void IO_ReadWrite::save_data_impl(DataArray3d             Udata,
 
   if (vtk_enabled) {
 
+    if (vtk_staged) {
+      vtk_writer.save(Udata, iStep, debug_name);
+    } else {
 #ifdef USE_MPI
-    save_VTK_3D_mpi(Udata, Uhost, params, configMap, params.nbvar, variables_names, iStep, debug_name);
+      save_VTK_3D_mpi(Udata, Uhost, params, configMap, params.nbvar, variables_names, iStep, debug_name);
 #else
-    save_VTK_3D(Udata, Uhost, params, configMap, params.nbvar, variables_names, iStep, debug_name);
+      save_VTK_3D(Udata, Uhost, params, configMap, params.nbvar, variables_names, iStep, debug_name);
 #endif // USE_MPI
+    }
     
   }
 
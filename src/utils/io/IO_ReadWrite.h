@@ -11,6 +11,7 @@
 #include <utils/config/ConfigMap.h>
 
 #include "IO_ReadWriteBase.h"
+#include "IO_VTK.h"
 
 namespace ppkMHD { namespace io {
 
@@ -89,6 +90,12 @@ public:
   bool vtk_enabled;
   bool hdf5_enabled;
   bool pnetcdf_enabled;
+
+  //! use the staged binary VTK writer (ignored for ascii output)
+  bool vtk_staged;
+
+  //! staged binary VTK writer
+  VTKWriter vtk_writer;
   
 }; // class IO_ReadWrite
 
@@ -17,6 +17,7 @@
 
 #include "IO_VTK_SDM.h"
 #include "IO_VTK_SDM_Flux.h"
+#include "IO_VTK_SDM_Lagrange.h"
 
 
 namespace ppkMHD { namespace io {
@@ -37,7 +38,11 @@ public:
 		std::map<int, std::string>& variables_names,
 		sdm::SDM_Geometry<dim,N> sdm_geom) :
     IO_ReadWrite(params, configMap, variables_names),
-    sdm_geom(sdm_geom) { };
+    sdm_geom(sdm_geom),
+    vtk_lagrange_enabled(false)
+  {
+    vtk_lagrange_enabled = configMap.getBool("output","outputVtkLagrange",false);
+  };
 
   //! destructor
   virtual ~IO_ReadWrite_SDM() {};
@@ -45,6 +50,12 @@ public:
   //! Spectral Difference Method Geometry information
   sdm::SDM_Geometry<dim,N> sdm_geom;
 
+  //! write one VTK Lagrange cell per SDM cell instead of N^dim sub-cells
+  bool vtk_lagrange_enabled;
+
+  //! geometry of Lagrange cells output, serialized once
+  VTKLagrangeGeometry vtk_lagrange_geom;
+
   //! this using allow to override base class method without any warning
   using IO_ReadWrite::save_data_impl;
 
@@ -58,7 +69,10 @@ public:
     
     if (vtk_enabled) {
 
-      save_VTK_SDM<N>(Udata, Uhost, params, configMap, sdm_geom, variables_names.size(), variables_names, iStep, time, debug_name);
+      if (vtk_lagrange_enabled)
+	save_VTK_SDM_Lagrange<dim,N>(Udata, Uhost, params, configMap, sdm_geom, vtk_lagrange_geom, variables_names.size(), variables_names, iStep, time, debug_name);
+      else
+	save_VTK_SDM<N>(Udata, Uhost, params, configMap, sdm_geom, variables_names.size(), variables_names, iStep, time, debug_name);
 
     }
     
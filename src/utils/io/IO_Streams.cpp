@@ -0,0 +1,671 @@
+#include "IO_Streams.h"
+
+#include <algorithm> // for std::min, std::max
+#include <iostream>
+#include <sstream>
+
+namespace ppkMHD { namespace io {
+
+// =======================================================
+// =======================================================
+/**
+ * Extract (coarsened) stream cells from the local sub-domain - 2D.
+ *
+ * Output cell (i,j) averages fine cells starting at local interior index
+ * first = lo + (offset_out+i)*factor - offset_in; only the first one is
+ * used in strided mode. In average mode, the sum is clipped to the local
+ * interior (first may be negative for a leading cell, see
+ * OutputStreams::Stream::lead) but always divided by the full number of
+ * fine cells, so that partial averages of a cell straddling sub-domains
+ * add up.
+ */
+class ExtractStreamFunctor2D {
+
+public:
+  ExtractStreamFunctor2D(DataArray2d Udata,
+			 DataArray2d Uout,
+			 int ghostWidth,
+			 Kokkos::Array<int,3> n_in,
+			 Kokkos::Array<int,3> n_out,
+			 Kokkos::Array<int,3> first,
+			 Kokkos::Array<int,3> factor,
+			 bool average) :
+    Udata(Udata), Uout(Uout), ghostWidth(ghostWidth),
+    n_in(n_in), n_out(n_out), first(first), factor(factor),
+    average(average) {};
+
+  static void apply(DataArray2d Udata,
+		    DataArray2d Uout,
+		    int ghostWidth,
+		    Kokkos::Array<int,3> n_in,
+		    Kokkos::Array<int,3> n_out,
+		    Kokkos::Array<int,3> first,
+		    Kokkos::Array<int,3> factor,
+		    bool average)
+  {
+    ExtractStreamFunctor2D functor(Udata, Uout, ghostWidth, n_in, n_out,
+				   first, factor, average);
+    Kokkos::parallel_for("ExtractStreamFunctor2D",
+			 Kokkos::RangePolicy<Device>(0, (int64_t) n_out[IX]*n_out[IY]),
+			 functor);
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const int64_t& index) const
+  {
+    const int j = index / n_out[IX];
+    const int i = index - (int64_t) j*n_out[IX];
+
+    const int i0 = first[IX] + i*factor[IX];
+    const int j0 = first[IY] + j*factor[IY];
+
+    const int a0 = begin(IX, i0), a1 = end(IX, i0);
+    const int b0 = begin(IY, j0), b1 = end(IY, j0);
+
+    const int gw = ghostWidth;
+    const int nbvar = Uout.extent(2);
+    const real_t count = average ? factor[IX]*factor[IY] : 1;
+
+    for (int iVar=0; iVar<nbvar; ++iVar) {
+      real_t sum = 0;
+      for (int b=b0; b<b1; ++b)
+	for (int a=a0; a<a1; ++a)
+	  sum += Udata(gw+i0+a, gw+j0+b, iVar);
+      Uout(gw+i, gw+j, iVar) = sum/count;
+    }
+  }
+
+  //! range [begin,end[ of fine cells of a stream cell starting at local
+  //! index i0, clipped to the local interior
+  KOKKOS_INLINE_FUNCTION
+  int begin(int dir, int i0) const
+  {
+    UNUSED(dir);
+    return i0 < 0 ? -i0 : 0;
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  int end(int dir, int i0) const
+  {
+    if (!average)
+      return 1;
+    return n_in[dir]-i0 < factor[dir] ? n_in[dir]-i0 : factor[dir];
+  }
+
+  DataArray2d Udata, Uout;
+  int ghostWidth;
+  Kokkos::Array<int,3> n_in, n_out, first, factor;
+  bool average;
+
+}; // ExtractStreamFunctor2D
+
+// =======================================================
+// =======================================================
+/**
+ * Extract (coarsened) stream cells from the local sub-domain - 3D.
+ */
+class ExtractStreamFunctor3D {
+
+public:
+  ExtractStreamFunctor3D(DataArray3d Udata,
+			 DataArray3d Uout,
+			 int ghostWidth,
+			 Kokkos::Array<int,3> n_in,
+			 Kokkos::Array<int,3> n_out,
+			 Kokkos::Array<int,3> first,
+			 Kokkos::Array<int,3> factor,
+			 bool average) :
+    Udata(Udata), Uout(Uout), ghostWidth(ghostWidth),
+    n_in(n_in), n_out(n_out), first(first), factor(factor),
+    average(average) {};
+
+  static void apply(DataArray3d Udata,
+		    DataArray3d Uout,
+		    int ghostWidth,
+		    Kokkos::Array<int,3> n_in,
+		    Kokkos::Array<int,3> n_out,
+		    Kokkos::Array<int,3> first,
+		    Kokkos::Array<int,3> factor,
+		    bool average)
+  {
+    ExtractStreamFunctor3D functor(Udata, Uout, ghostWidth, n_in, n_out,
+				   first, factor, average);
+    Kokkos::parallel_for("ExtractStreamFunctor3D",
+			 Kokkos::RangePolicy<Device>(0, (int64_t) n_out[IX]*n_out[IY]*n_out[IZ]),
+			 functor);
+  }
+
+  //! range [begin,end[ of fine cells of a stream cell starting at local
+  //! index i0, clipped to the local interior
+  KOKKOS_INLINE_FUNCTION
+  int begin(int dir, int i0) const
+  {
+    UNUSED(dir);
+    return i0 < 0 ? -i0 : 0;
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  int end(int dir, int i0) const
+  {
+    if (!average)
+      return 1;
+    return n_in[dir]-i0 < factor[dir] ? n_in[dir]-i0 : factor[dir];
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const int64_t& index) const
+  {
+    const int64_t nxy = (int64_t) n_out[IX]*n_out[IY];
+    const int k = index / nxy;
+    const int j = (index - k*nxy) / n_out[IX];
+    const int i = index - k*nxy - (int64_t) j*n_out[IX];
+
+    const int i0 = first[IX] + i*factor[IX];
+    const int j0 = first[IY] + j*factor[IY];
+    const int k0 = first[IZ] + k*factor[IZ];
+
+    const int a0 = begin(IX, i0), a1 = end(IX, i0);
+    const int b0 = begin(IY, j0), b1 = end(IY, j0);
+    const int c0 = begin(IZ, k0), c1 = end(IZ, k0);
+
+    const int gw = ghostWidth;
+    const int nbvar = Uout.extent(3);
+    const real_t count = average ? factor[IX]*factor[IY]*factor[IZ] : 1;
+
+    for (int iVar=0; iVar<nbvar; ++iVar) {
+      real_t sum = 0;
+      for (int c=c0; c<c1; ++c)
+	for (int b=b0; b<b1; ++b)
+	  for (int a=a0; a<a1; ++a)
+	    sum += Udata(gw+i0+a, gw+j0+b, gw+k0+c, iVar);
+      Uout(gw+i, gw+j, gw+k, iVar) = sum/count;
+    }
+  }
+
+  DataArray3d Udata, Uout;
+  int ghostWidth;
+  Kokkos::Array<int,3> n_in, n_out, first, factor;
+  bool average;
+
+}; // ExtractStreamFunctor3D
+
+// =======================================================
+// =======================================================
+OutputStreams::OutputStreams(HydroParams& params,
+			     ConfigMap& configMap,
+			     std::map<int, std::string>& variables_names) :
+  params(params),
+  configMap(configMap),
+  variables_names(variables_names),
+  streams()
+{
+
+  const int dim = params.dimType == TWO_D ? 2 : 3;
+
+  const std::string outputPrefix = configMap.getString("output", "outputPrefix", "output");
+  const double xmin[3] = {params.xmin, params.ymin, params.zmin};
+  const double xmax[3] = {params.xmax, params.ymax, params.zmax};
+
+  // stream names, comma separated
+  std::istringstream names(configMap.getString("output", "streams", ""));
+  std::string name;
+  while (std::getline(names, name, ',')) {
+
+    name.erase(0, name.find_first_not_of(" \t"));
+    name.erase(name.find_last_not_of(" \t")+1);
+    if (name.empty())
+      continue;
+
+    const std::string section = "stream_" + name;
+    const std::string type = configMap.getString(section, "type", "box");
+
+    std::unique_ptr<Stream> s(new Stream(params, configMap));
+    s->name     = name;
+    s->interval = configMap.getInteger(section, "interval", 0);
+    s->counter  = 0;
+    s->average  = configMap.getString(section, "sampling", "average") != "stride";
+
+    const int factor = configMap.getInteger(section, "factor", type == "coarse" ? 2 : 1);
+
+    bool valid = s->interval > 0 and factor > 0;
+
+    for (int dir=0; dir<3; ++dir) {
+      s->lo[dir] = 0;
+      s->hi[dir] = dir < dim ? global_size(dir) : 1;
+      s->factor[dir] = dir < dim ? factor : 1;
+    }
+
+    if (type == "slice") {
+
+      const std::string axis = configMap.getString(section, "axis", dim == 3 ? "z" : "y");
+      const int dir = axis == "x" ? IX : (axis == "y" ? IY : IZ);
+      valid = valid and (axis == "x" or axis == "y" or axis == "z") and dir < dim;
+
+      const double d = (xmax[dir]-xmin[dir])/global_size(dir);
+      const double position = configMap.getFloat(section, "position",
+						 0.5*(xmin[dir]+xmax[dir]));
+      const int index = (int) floor((position-xmin[dir])/d);
+      s->lo[dir] = std::max(0, std::min(index, global_size(dir)-1));
+      s->hi[dir] = s->lo[dir]+1;
+      s->factor[dir] = 1;
+
+    } else if (type == "box") {
+
+      const char* bmin[3] = {"xmin", "ymin", "zmin"};
+      const char* bmax[3] = {"xmax", "ymax", "zmax"};
+      for (int dir=0; dir<dim; ++dir) {
+	const double d = (xmax[dir]-xmin[dir])/global_size(dir);
+	const double b0 = configMap.getFloat(section, bmin[dir], xmin[dir]);
+	const double b1 = configMap.getFloat(section, bmax[dir], xmax[dir]);
+	s->lo[dir] = std::max(0, (int) floor((b0-xmin[dir])/d));
+	s->hi[dir] = std::min(global_size(dir), (int) ceil((b1-xmin[dir])/d));
+      }
+
+    } else if (type != "coarse") {
+      valid = false;
+    }
+
+    // whole number of coarse cells
+    for (int dir=0; dir<3; ++dir) {
+      const int n = (s->hi[dir]-s->lo[dir])/s->factor[dir];
+      valid = valid and n > 0;
+      s->hi[dir] = s->lo[dir] + n*s->factor[dir];
+    }
+
+    if (!valid) {
+#ifdef USE_MPI
+      if (params.myRank == 0)
+#endif // USE_MPI
+	std::cerr << "[output] invalid settings for stream " << name
+		  << ", stream disabled\n";
+      continue;
+    }
+
+    // writers settings
+    ConfigMap& cm = s->configMap;
+    cm.setString("output", "outputPrefix", outputPrefix + "_" + name);
+    cm.setBool("output", "ghostIncluded", false);
+    cm.setBool("output", "allghostIncluded", false);
+    cm.setBool("output", "vtk_enabled",
+	       configMap.getBool(section, "vtk_enabled",
+				 configMap.getBool("output", "vtk_enabled", true)));
+    cm.setBool("output", "hdf5_enabled",
+	       configMap.getBool(section, "hdf5_enabled",
+				 configMap.getBool("output", "hdf5_enabled", false)));
+    cm.setBool("output", "pnetcdf_enabled",
+	       configMap.getBool(section, "pnetcdf_enabled",
+				 configMap.getBool("output", "pnetcdf_enabled", false)));
+
+    update_grid(*s);
+
+    s->writer.reset(new IO_ReadWrite(s->params, s->configMap, variables_names));
+
+    streams.push_back(std::move(s));
+
+  } // end while
+
+} // OutputStreams::OutputStreams
+
+// =======================================================
+// =======================================================
+OutputStreams::~OutputStreams()
+{
+} // OutputStreams::~OutputStreams
+
+// =======================================================
+// =======================================================
+int OutputStreams::global_size(int dir) const
+{
+
+#ifdef USE_MPI
+  return params.nGlobal[dir];
+#else
+  return dir == IX ? params.nx : (dir == IY ? params.ny : params.nz);
+#endif // USE_MPI
+
+} // OutputStreams::global_size
+
+#ifdef USE_MPI
+// =======================================================
+// =======================================================
+/**
+ * True if a sub-domain starting at global fine cell offset falls in the
+ * middle of a stream cell of [lo,hi[ (which is then owned by a lower
+ * process).
+ */
+static bool straddles(int offset, int lo, int hi, int factor)
+{
+
+  return offset > lo and offset < hi and (offset - lo) % factor != 0;
+
+} // straddles
+
+// =======================================================
+// =======================================================
+// cell accessors, so that reduce_shared is written once for 2D and 3D
+static storage_t& cell(DataArray2d::HostMirror& U, int i, int j, int k, int iVar)
+{
+  UNUSED(k);
+  return U(i,j,iVar);
+}
+
+static storage_t& cell(DataArray3d::HostMirror& U, int i, int j, int k, int iVar)
+{
+  return U(i,j,k,iVar);
+}
+
+#endif // USE_MPI
+
+// =======================================================
+// =======================================================
+void OutputStreams::update_grid(Stream& s)
+{
+
+  const double dx[3]   = {params.dx, params.dy, params.dz};
+  const double xmin[3] = {params.xmin, params.ymin, params.zmin};
+
+  HydroParams& sp = s.params;
+
+  sp = params;
+
+  sp.xmin = xmin[IX] + s.lo[IX]*dx[IX];
+  sp.xmax = xmin[IX] + s.hi[IX]*dx[IX];
+  sp.ymin = xmin[IY] + s.lo[IY]*dx[IY];
+  sp.ymax = xmin[IY] + s.hi[IY]*dx[IY];
+  if (params.dimType == THREE_D) {
+    sp.zmin = xmin[IZ] + s.lo[IZ]*dx[IZ];
+    sp.zmax = xmin[IZ] + s.hi[IZ]*dx[IZ];
+  }
+
+  s.lead   = {0, 0, 0};
+  s.shared = false;
+
+#ifdef USE_MPI
+
+  // stream cell c belongs to the process owning fine cell lo+c*factor
+  const int m[3] = {params.mx, params.my, params.mz};
+  for (int dir=0; dir<3; ++dir) {
+    const int n = (s.hi[dir]-s.lo[dir])/s.factor[dir];
+    s.cuts[dir].resize(m[dir]+1);
+    for (int pos=0; pos<=m[dir]; ++pos) {
+      const int offset = params.block_offset(dir, pos);
+      const int shift = offset - s.lo[dir];
+      const int c = shift <= 0 ? 0 : (shift + s.factor[dir] - 1)/s.factor[dir];
+      s.cuts[dir][pos] = std::min(c, n);
+      if (s.average and pos < m[dir] and straddles(offset, s.lo[dir], s.hi[dir], s.factor[dir])) {
+	s.shared = true;
+	if (pos == params.myMpiPos[dir])
+	  s.lead[dir] = 1;
+      }
+    }
+    sp.nGlobal[dir] = n;
+  }
+  sp.blockCuts = s.cuts;
+  sp.update_local_sizes();
+
+#else
+
+  sp.nx = (s.hi[IX]-s.lo[IX])/s.factor[IX];
+  sp.ny = (s.hi[IY]-s.lo[IY])/s.factor[IY];
+  sp.nz = (s.hi[IZ]-s.lo[IZ])/s.factor[IZ];
+  sp.init();
+
+#endif // USE_MPI
+
+} // OutputStreams::update_grid
+
+#ifdef USE_MPI
+// =======================================================
+// =======================================================
+/**
+ * Cell (i,j,k) of Uext is local stream cell (i,j,k)-lead (leading cells
+ * have index -1), shifted by ghost width. Directions are processed one
+ * after the other : the leading layer along dir (which already holds
+ * contributions along previous directions) is sent to the process
+ * owning it along dir, possibly several positions below when
+ * sub-domains are thinner than factor.
+ */
+template<class HostArray>
+void OutputStreams::reduce_shared(Stream& s, HostArray Uext)
+{
+
+  const int dim   = params.dimType == TWO_D ? 2 : 3;
+  const int gw    = params.ghostWidth;
+  const int nbvar = params.nbvar;
+  const HydroParams& sp = s.params;
+
+  const int m[3] = {params.mx, params.my, params.mz};
+
+  // extended sizes
+  Kokkos::Array<int,3> n;
+  n[IX] = sp.nx + s.lead[IX];
+  n[IY] = sp.ny + s.lead[IY];
+  n[IZ] = dim == 3 ? sp.nz + s.lead[IZ] : 1;
+  const int kb = dim == 3 ? gw : 0;
+
+  for (int dir=0; dir<dim; ++dir) {
+
+    const int d1 = (dir+1)%3, d2 = (dir+2)%3;
+    const int layerSize = n[d1]*n[d2]*nbvar;
+
+    // pack / unpack layer l (stream cell index along dir) of Uext
+    auto for_layer = [&](int l, std::vector<storage_t>& buf, bool pack) {
+      int ijk[3];
+      int index = 0;
+      ijk[dir] = (dir == IZ ? kb : gw) + l;
+      for (int b=0; b<n[d2]; ++b)
+	for (int a=0; a<n[d1]; ++a) {
+	  ijk[d1] = (d1 == IZ ? kb : gw) + a;
+	  ijk[d2] = (d2 == IZ ? kb : gw) + b;
+	  for (int iVar=0; iVar<nbvar; ++iVar, ++index) {
+	    storage_t& v = cell(Uext, ijk[IX], ijk[IY], ijk[IZ], iVar);
+	    if (pack)
+	      buf[index] = v;
+	    else
+	      v += buf[index];
+	  }
+	}
+    };
+
+    std::vector<MPI_Request> requests;
+    std::vector<std::vector<storage_t>> recvBuf;
+    std::vector<int> recvLayer;
+    std::vector<storage_t> sendBuf;
+    recvBuf.reserve(m[dir]);
+
+    for (int pos=0; pos<m[dir]; ++pos) {
+
+      const int offset = params.block_offset(dir, pos);
+      if (!straddles(offset, s.lo[dir], s.hi[dir], s.factor[dir]))
+	continue;
+
+      // leading cell of process pos, and its owner along dir
+      const int c = (offset - s.lo[dir])/s.factor[dir];
+      const int first = s.lo[dir] + c*s.factor[dir];
+      int owner = pos;
+      while (params.block_offset(dir, owner) > first)
+	--owner;
+
+      int coords[3] = {params.myMpiPos[IX], params.myMpiPos[IY], params.myMpiPos[IZ]};
+
+      if (pos == params.myMpiPos[dir]) {
+	coords[dir] = owner;
+	sendBuf.resize(layerSize);
+	for_layer(0, sendBuf, true);
+	requests.push_back(params.communicator->Isend(sendBuf.data(), layerSize,
+						      params.storage_data_type,
+						      params.communicator->getCartRank(coords),
+						      300+dir));
+      } else if (owner == params.myMpiPos[dir]) {
+	coords[dir] = pos;
+	recvBuf.push_back(std::vector<storage_t>(layerSize));
+	recvLayer.push_back(c - sp.myOffset[dir] + s.lead[dir]);
+	requests.push_back(params.communicator->Irecv(recvBuf.back().data(), layerSize,
+						      params.storage_data_type,
+						      params.communicator->getCartRank(coords),
+						      300+dir));
+      }
+
+    }
+
+    MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
+
+    for (size_t r=0; r<recvBuf.size(); ++r)
+      for_layer(recvLayer[r], recvBuf[r], false);
+
+  } // end for dir
+
+} // OutputStreams::reduce_shared
+#endif // USE_MPI
+
+// =======================================================
+// =======================================================
+bool OutputStreams::should_save(int iStep) const
+{
+
+  for (const auto& s : streams)
+    if (iStep % s->interval == 0)
+      return true;
+
+  return false;
+
+} // OutputStreams::should_save
+
+// =======================================================
+// =======================================================
+void OutputStreams::save(DataArray2d Udata, int iStep, real_t time)
+{
+
+  for (auto& ps : streams) {
+
+    Stream& s = *ps;
+    if (iStep % s.interval != 0)
+      continue;
+
+    update_grid(s);
+    const HydroParams& sp = s.params;
+
+    if (s.U2d.extent(0) != (size_t) sp.isize or
+	s.U2d.extent(1) != (size_t) sp.jsize) {
+      s.U2d      = DataArray2d("stream", sp.isize, sp.jsize, params.nbvar);
+      s.U2d_host = Kokkos::create_mirror_view(s.U2d);
+    }
+
+    const Kokkos::Array<int,3> n_in  = {params.nx, params.ny, 1};
+    const Kokkos::Array<int,3> n_out = {sp.nx+s.lead[IX], sp.ny+s.lead[IY], 1};
+    Kokkos::Array<int,3> first;
+    for (int dir=IX; dir<=IY; ++dir)
+      first[dir] = s.lo[dir] + (sp.myOffset[dir]-s.lead[dir])*s.factor[dir] - params.myOffset[dir];
+    first[IZ] = 0;
+
+    if (!s.shared) {
+
+      ExtractStreamFunctor2D::apply(Udata, s.U2d, params.ghostWidth,
+				    n_in, n_out, first, s.factor, s.average);
+
+    } else {
+
+#ifdef USE_MPI
+      const int gw = params.ghostWidth;
+
+      if (s.Uext2d.extent(0) != (size_t) n_out[IX]+2*gw or
+	  s.Uext2d.extent(1) != (size_t) n_out[IY]+2*gw) {
+	s.Uext2d      = DataArray2d("stream_ext", n_out[IX]+2*gw, n_out[IY]+2*gw, params.nbvar);
+	s.Uext2d_host = Kokkos::create_mirror_view(s.Uext2d);
+      }
+
+      ExtractStreamFunctor2D::apply(Udata, s.Uext2d, params.ghostWidth,
+				    n_in, n_out, first, s.factor, s.average);
+      Kokkos::deep_copy(s.Uext2d_host, s.Uext2d);
+
+      reduce_shared(s, s.Uext2d_host);
+
+      // drop leading cells
+      for (int j=gw; j<gw+sp.ny; ++j)
+	for (int i=gw; i<gw+sp.nx; ++i)
+	  for (int iVar=0; iVar<params.nbvar; ++iVar)
+	    s.U2d_host(i,j,iVar) = s.Uext2d_host(i+s.lead[IX], j+s.lead[IY], iVar);
+      Kokkos::deep_copy(s.U2d, s.U2d_host);
+#endif // USE_MPI
+
+    }
+
+    s.writer->save_data(s.U2d, s.U2d_host, s.counter, time, "");
+    ++s.counter;
+
+  }
+
+} // OutputStreams::save - 2d
+
+// =======================================================
+// =======================================================
+void OutputStreams::save(DataArray3d Udata, int iStep, real_t time)
+{
+
+  for (auto& ps : streams) {
+
+    Stream& s = *ps;
+    if (iStep % s.interval != 0)
+      continue;
+
+    update_grid(s);
+    const HydroParams& sp = s.params;
+
+    if (s.U3d.extent(0) != (size_t) sp.isize or
+	s.U3d.extent(1) != (size_t) sp.jsize or
+	s.U3d.extent(2) != (size_t) sp.ksize) {
+      s.U3d      = DataArray3d("stream", sp.isize, sp.jsize, sp.ksize, params.nbvar);
+      s.U3d_host = Kokkos::create_mirror_view(s.U3d);
+    }
+
+    const Kokkos::Array<int,3> n_in  = {params.nx, params.ny, params.nz};
+    const Kokkos::Array<int,3> n_out = {sp.nx+s.lead[IX], sp.ny+s.lead[IY], sp.nz+s.lead[IZ]};
+    Kokkos::Array<int,3> first;
+    for (int dir=IX; dir<=IZ; ++dir)
+      first[dir] = s.lo[dir] + (sp.myOffset[dir]-s.lead[dir])*s.factor[dir] - params.myOffset[dir];
+
+    if (!s.shared) {
+
+      ExtractStreamFunctor3D::apply(Udata, s.U3d, params.ghostWidth,
+				    n_in, n_out, first, s.factor, s.average);
+
+    } else {
+
+#ifdef USE_MPI
+      const int gw = params.ghostWidth;
+
+      if (s.Uext3d.extent(0) != (size_t) n_out[IX]+2*gw or
+	  s.Uext3d.extent(1) != (size_t) n_out[IY]+2*gw or
+	  s.Uext3d.extent(2) != (size_t) n_out[IZ]+2*gw) {
+	s.Uext3d      = DataArray3d("stream_ext", n_out[IX]+2*gw, n_out[IY]+2*gw,
+				    n_out[IZ]+2*gw, params.nbvar);
+	s.Uext3d_host = Kokkos::create_mirror_view(s.Uext3d);
+      }
+
+      ExtractStreamFunctor3D::apply(Udata, s.Uext3d, params.ghostWidth,
+				    n_in, n_out, first, s.factor, s.average);
+      Kokkos::deep_copy(s.Uext3d_host, s.Uext3d);
+
+      reduce_shared(s, s.Uext3d_host);
+
+      // drop leading cells
+      for (int k=gw; k<gw+sp.nz; ++k)
+	for (int j=gw; j<gw+sp.ny; ++j)
+	  for (int i=gw; i<gw+sp.nx; ++i)
+	    for (int iVar=0; iVar<params.nbvar; ++iVar)
+	      s.U3d_host(i,j,k,iVar) = s.Uext3d_host(i+s.lead[IX], j+s.lead[IY], k+s.lead[IZ], iVar);
+      Kokkos::deep_copy(s.U3d, s.U3d_host);
+#endif // USE_MPI
+
+    }
+
+    s.writer->save_data(s.U3d, s.U3d_host, s.counter, time, "");
+    ++s.counter;
+
+  }
+
+} // OutputStreams::save - 3d
+
+} // namespace io
+
+} // namespace ppkMHD
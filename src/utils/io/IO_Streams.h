@@ -0,0 +1,137 @@
+#ifndef IO_STREAMS_H_
+#define IO_STREAMS_H_
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <shared/kokkos_shared.h>
+#include <shared/HydroParams.h>
+#include <utils/config/ConfigMap.h>
+
+#include "IO_ReadWrite.h"
+
+namespace ppkMHD { namespace io {
+
+/**
+ * Additional output streams, each with its own cadence, written in
+ * between regular outputs : coarse (down-sampled) copies of the whole
+ * domain, axis-aligned slices and sub-boxes.
+ *
+ * Streams are listed in [output] streams (comma separated names); stream
+ * "name" is configured in section [stream_name] :
+ * - type : coarse, slice or box
+ * - interval : number of time steps between two outputs
+ * - factor : coarsening factor (default 2 for coarse, 1 otherwise)
+ * - sampling : average (box average over factor^dim cells, default) or
+ *   stride (keep one cell out of factor)
+ * - axis (x, y or z) and position : slice location
+ * - xmin, xmax, ymin, ymax, zmin, zmax : sub-box bounds
+ * - vtk_enabled, hdf5_enabled, pnetcdf_enabled : default to [output]
+ *
+ * Every stream is a box of cells of the global grid, coarsened by an
+ * integer factor per direction (a slice is one cell thick). A device
+ * kernel extracts the local part of the box into a small array, which is
+ * written by the regular writers (IO_ReadWrite) with a grid description
+ * (HydroParams) of its own. Files are named
+ * <outputPrefix>_<name>_<number>, number counting the stream outputs.
+ *
+ * With MPI, an output cell belongs to the process owning its first fine
+ * cell; when a sub-domain boundary is not aligned with the coarsening
+ * factor, the other processes covering the cell send their partial
+ * averages to the owner (see reduce_shared), so that results do not
+ * depend on the domain decomposition. Processes not intersecting a
+ * stream hold an empty piece.
+ */
+class OutputStreams {
+
+public:
+  OutputStreams(HydroParams& params,
+		ConfigMap& configMap,
+		std::map<int, std::string>& variables_names);
+  ~OutputStreams();
+
+  //! true if at least one stream is enabled
+  bool enabled() const { return !streams.empty(); }
+
+  //! true if at least one stream must be written at time step iStep
+  bool should_save(int iStep) const;
+
+  //! write the streams due at time step iStep
+  void save(DataArray2d Udata, int iStep, real_t time);
+  void save(DataArray3d Udata, int iStep, real_t time);
+
+private:
+  struct Stream {
+
+    Stream(HydroParams& params, ConfigMap& configMap) :
+      params(params), configMap(configMap) {};
+
+    std::string name;
+    int  interval;
+    int  counter;   //!< number of outputs written so far
+    bool average;   //!< box average (true) or strided sampling
+
+    //! global fine cell range [lo,hi[ and coarsening factor
+    Kokkos::Array<int,3> lo, hi, factor;
+
+    //! 1 along dir when the first stream cell intersecting the local
+    //! sub-domain is owned by a lower process (average mode with MPI)
+    Kokkos::Array<int,3> lead;
+
+    //! true when a stream cell straddles sub-domains on any process
+    bool shared;
+
+    //! grid description of the extracted data
+    HydroParams params;
+    ConfigMap   configMap;
+
+#ifdef USE_MPI
+    //! stream cell boundaries of the sub-domains (params.blockCuts)
+    std::vector<int> cuts[3];
+#endif // USE_MPI
+
+    DataArray2d             U2d;
+    DataArray2d::HostMirror U2d_host;
+    DataArray3d             U3d;
+    DataArray3d::HostMirror U3d_host;
+
+    //! partial averages of the local stream cells, including leading
+    //! ones (only used when shared)
+    DataArray2d             Uext2d;
+    DataArray2d::HostMirror Uext2d_host;
+    DataArray3d             Uext3d;
+    DataArray3d::HostMirror Uext3d_host;
+
+    std::unique_ptr<IO_ReadWrite> writer;
+
+  }; // struct Stream
+
+  HydroParams& params;
+  ConfigMap& configMap;
+  std::map<int, std::string>& variables_names;
+
+  std::vector<std::unique_ptr<Stream>> streams;
+
+  //! global number of cells along dir
+  int global_size(int dir) const;
+
+  //! update the grid description of a stream for the current domain
+  //! decomposition (may change with load balancing)
+  void update_grid(Stream& s);
+
+#ifdef USE_MPI
+  //! send partial averages of leading cells to their owner, and add the
+  //! ones received to the local cells (host arrays, see Stream::lead)
+  template<class HostArray>
+  void reduce_shared(Stream& s, HostArray Uext);
+#endif // USE_MPI
+
+}; // class OutputStreams
+
+} // namespace io
+
+} // namespace ppkMHD
+
+#endif // IO_STREAMS_H_
@@ -4,6 +4,13 @@
 #include "utils/config/ConfigMap.h"
 
 #include <fstream>
+#include <sstream>
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>    // for open
+#include <sys/uio.h>  // for writev
+#include <unistd.h>   // for close
 
 namespace ppkMHD { namespace io {
 
@@ -422,10 +429,10 @@ void save_VTK_2D_mpi(DataArray2d             Udata,
 
   int xmin=0, xmax=0, ymin=0, ymax=0;
 
-  xmin=params.myMpiPos[0]*nx   ;
-  xmax=params.myMpiPos[0]*nx+nx;
-  ymin=params.myMpiPos[1]*ny   ;
-  ymax=params.myMpiPos[1]*ny+ny;
+  xmin=params.myOffset[IX]   ;
+  xmax=params.myOffset[IX]+nx;
+  ymin=params.myOffset[IY]   ;
+  ymax=params.myOffset[IY]+ny;
   
   // copy device data to host
   Kokkos::deep_copy(Uhost, Udata);
@@ -636,12 +643,12 @@ void save_VTK_3D_mpi(DataArray3d             Udata,
   const int nbCells = isize*jsize*ksize;
 
   int xmin=0, xmax=0, ymin=0, ymax=0, zmin=0, zmax=0;
-  xmin=params.myMpiPos[0]*nx   ;
-  xmax=params.myMpiPos[0]*nx+nx;
-  ymin=params.myMpiPos[1]*ny   ;
-  ymax=params.myMpiPos[1]*ny+ny;
-  zmin=params.myMpiPos[2]*nz   ;
-  zmax=params.myMpiPos[2]*nz+nz;
+  xmin=params.myOffset[IX]   ;
+  xmax=params.myOffset[IX]+nx;
+  ymin=params.myOffset[IY]   ;
+  ymax=params.myOffset[IY]+ny;
+  zmin=params.myOffset[IZ]   ;
+  zmax=params.myOffset[IZ]+nz;
 
   // copy device data to host
   Kokkos::deep_copy(Uhost, Udata);
@@ -830,10 +837,6 @@ void write_pvti_header(std::string headerFilename,
   // file handler
   std::fstream outHeader;
   
-  // dummy string here, when using the full VTK API, data can be compressed
-  // here, no compression used
-  std::string compressor("");
-  
   // check scalar data type
   bool useDouble = false;
   
@@ -841,41 +844,63 @@ void write_pvti_header(std::string headerFilename,
     useDouble = true;
   }
   
-  const int dimType = params.dimType;
-  const int nProcs = params.nProcs;
-  
   // write iStep in string timeFormat
   std::ostringstream timeFormat;
   timeFormat.width(7);
   timeFormat.fill('0');
   timeFormat << iStep;
   
-  // local sub-domain sizes
-  const int nx = params.nx;
-  const int ny = params.ny;
-  const int nz = (dimType == THREE_D) ? params.nz : 0;
+  // open pvti header file
+  outHeader.open (headerFilename.c_str(), std::ios_base::out);
+  
+  outHeader << make_pvti_header(outputPrefix, params, nbvar, varNames,
+				timeFormat.str(),
+				useDouble ? "Float64" : "Float32");
+  
+  // close header file
+  outHeader.close();
+  
+  // end writing pvti header
+  
+} // write_pvti_header
 
-  // sizes of MPI Cartesian topology
-  const int mx = params.mx;
-  const int my = params.my;
-  const int mz = (dimType == THREE_D) ? params.mz : 0;
+// =======================================================
+// =======================================================
+std::string make_pvti_header(std::string outputPrefix,
+			     HydroParams& params,
+			     int nbvar,
+			     const std::map<int, std::string>& varNames,
+			     std::string stepStr,
+			     const char* dataType)
+{
+  std::ostringstream outHeader;
+  
+  // dummy string here, when using the full VTK API, data can be compressed
+  // here, no compression used
+  std::string compressor("");
+  
+  const int dimType = params.dimType;
+  const int nProcs = params.nProcs;
+  
+  // global domain sizes (sub-domain sizes may differ, see
+  // HydroParams::block_size)
+  const int nxg = params.nGlobal[IX];
+  const int nyg = params.nGlobal[IY];
+  const int nzg = (dimType == THREE_D) ? params.nGlobal[IZ] : 0;
 
   const real_t dx = params.dx;
   const real_t dy = params.dy;
   const real_t dz = (dimType == THREE_D) ? params.dz : 0.0;
 
-  // open pvti header file
-  outHeader.open (headerFilename.c_str(), std::ios_base::out);
-  
   outHeader << "<?xml version=\"1.0\"?>" << std::endl;
   if (isBigEndian())
     outHeader << "<VTKFile type=\"PImageData\" version=\"0.1\" byte_order=\"BigEndian\"" << compressor << ">" << std::endl;
   else
     outHeader << "<VTKFile type=\"PImageData\" version=\"0.1\" byte_order=\"LittleEndian\"" << compressor << ">" << std::endl;
   outHeader << "  <PImageData WholeExtent=\"";
-  outHeader << 0 << " " << mx*nx << " ";
-  outHeader << 0 << " " << my*ny << " ";
-  outHeader << 0 << " " << mz*nz << "\" GhostLevel=\"0\" "
+  outHeader << 0 << " " << nxg << " ";
+  outHeader << 0 << " " << nyg << " ";
+  outHeader << 0 << " " << nzg << "\" GhostLevel=\"0\" "
 	    << "Origin=\""
 	    << params.xmin << " " << params.ymin << " " << params.zmin << "\" "
 	    << "Spacing=\""
@@ -883,10 +908,7 @@ void write_pvti_header(std::string headerFilename,
 	    << std::endl;
   outHeader << "    <PCellData Scalars=\"Scalars_\">" << std::endl;
   for (int iVar=0; iVar<nbvar; iVar++) {
-    if (useDouble) 
-      outHeader << "      <PDataArray type=\"Float64\" Name=\""<< varNames.at(iVar)<<"\"/>" << std::endl;
-    else
-      outHeader << "      <PDataArray type=\"Float32\" Name=\""<< varNames.at(iVar)<<"\"/>" << std::endl;	  
+    outHeader << "      <PDataArray type=\"" << dataType << "\" Name=\""<< varNames.at(iVar)<<"\"/>" << std::endl;
   }
   outHeader << "    </PCellData>" << std::endl;
   
@@ -897,22 +919,24 @@ void write_pvti_header(std::string headerFilename,
       pieceFormat.width(5);
       pieceFormat.fill('0');
       pieceFormat << iPiece;
-      std::string pieceFilename   = outputPrefix+"_time"+timeFormat.str()+"_mpi"+pieceFormat.str()+".vti";
+      std::string pieceFilename   = outputPrefix+"_time"+stepStr+"_mpi"+pieceFormat.str()+".vti";
       // get MPI coords corresponding to MPI rank iPiece
       int coords[2];
       params.communicator->getCoords(iPiece,2,coords);
+
+      // skip empty pieces (output streams not crossing all sub-domains)
+      if (params.block_size(IX, coords[IX]) == 0 or
+	  params.block_size(IY, coords[IY]) == 0)
+	continue;
+
       outHeader << "    <Piece Extent=\"";
       
-      // pieces in first line of column are different (due to the special
-      // pvti file format with overlapping by 1 cell)
-      if (coords[0] == 0)
-	outHeader << 0 << " " << nx << " ";
-      else
-	outHeader << coords[0]*nx << " " << coords[0]*nx+nx << " ";
-      if (coords[1] == 0)
-	outHeader << 0 << " " << ny << " ";
-      else
-	outHeader << coords[1]*ny << " " << coords[1]*ny+ny << " ";
+      // point extent of the piece (neighbor pieces share their
+      // boundary points)
+      for (int dir=IX; dir<=IY; ++dir) {
+	const int offset = params.block_offset(dir, coords[dir]);
+	outHeader << offset << " " << offset+params.block_size(dir, coords[dir]) << " ";
+      }
       outHeader << 0 << " " << 1 << "\" Source=\"";
       outHeader << pieceFilename << "\"/>" << std::endl;
     } 
@@ -922,26 +946,22 @@ void write_pvti_header(std::string headerFilename,
       pieceFormat.width(5);
       pieceFormat.fill('0');
       pieceFormat << iPiece;
-      std::string pieceFilename   = outputPrefix+"_time"+timeFormat.str()+"_mpi"+pieceFormat.str()+".vti";
+      std::string pieceFilename   = outputPrefix+"_time"+stepStr+"_mpi"+pieceFormat.str()+".vti";
       // get MPI coords corresponding to MPI rank iPiece
       int coords[3];
       params.communicator->getCoords(iPiece,3,coords);
+
+      if (params.block_size(IX, coords[IX]) == 0 or
+	  params.block_size(IY, coords[IY]) == 0 or
+	  params.block_size(IZ, coords[IZ]) == 0)
+	continue;
+
       outHeader << " <Piece Extent=\"";
       
-      if (coords[0] == 0)
-	outHeader << 0 << " " << nx << " ";
-      else
-	outHeader << coords[0]*nx << " " << coords[0]*nx+nx << " ";
-      
-      if (coords[1] == 0)
-	outHeader << 0 << " " << ny << " ";
-      else
-	outHeader << coords[1]*ny << " " << coords[1]*ny+ny << " ";
-      
-      if (coords[2] == 0)
-	outHeader << 0 << " " << nz << " ";
-      else
-	outHeader << coords[2]*nz << " " << coords[2]*nz+nz << " ";
+      for (int dir=IX; dir<=IZ; ++dir) {
+	const int offset = params.block_offset(dir, coords[dir]);
+	outHeader << offset << " " << offset+params.block_size(dir, coords[dir]) << " ";
+      }
       
       outHeader << "\" Source=\"";
       outHeader << pieceFilename << "\"/>" << std::endl;
@@ -950,14 +970,352 @@ void write_pvti_header(std::string headerFilename,
   outHeader << "</PImageData>" << std::endl;
   outHeader << "</VTKFile>" << std::endl;
   
-  // close header file
-  outHeader.close();
-  
-  // end writing pvti header
-  
-} // write_pvti_header
+  return outHeader.str();
+
+} // make_pvti_header
+#endif // USE_MPI
+
+// =======================================================
+// =======================================================
+/**
+ * Pack interior cells into the VTK staging buffer - 2D.
+ *
+ * Variable iVar starts at iVar*stride+header in the buffer, cells are
+ * ordered i fastest (VTK order).
+ */
+class PackVTKFunctor2D {
+
+public:
+  PackVTKFunctor2D(DataArray2d Udata,
+		   Kokkos::View<storage_t*, Device> buffer,
+		   int nx, int ny, int ghostWidth,
+		   int nbvar, int64_t stride, int64_t header) :
+    Udata(Udata), buffer(buffer), nx(nx), ny(ny), ghostWidth(ghostWidth),
+    nbvar(nbvar), stride(stride), header(header) {};
+
+  static void apply(DataArray2d Udata,
+		    Kokkos::View<storage_t*, Device> buffer,
+		    int nx, int ny, int ghostWidth,
+		    int nbvar, int64_t stride, int64_t header)
+  {
+    PackVTKFunctor2D functor(Udata, buffer, nx, ny, ghostWidth,
+			     nbvar, stride, header);
+    Kokkos::parallel_for("PackVTKFunctor2D",
+			 Kokkos::RangePolicy<Device>(0, (int64_t) nx*ny),
+			 functor);
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const int64_t& index) const
+  {
+    const int j = index / nx;
+    const int i = index - (int64_t) j*nx;
+
+    for (int iVar=0; iVar<nbvar; ++iVar)
+      buffer(iVar*stride + header + index) = Udata(i+ghostWidth, j+ghostWidth, iVar);
+  }
+
+  DataArray2d Udata;
+  Kokkos::View<storage_t*, Device> buffer;
+  int nx, ny, ghostWidth, nbvar;
+  int64_t stride, header;
+
+}; // PackVTKFunctor2D
+
+// =======================================================
+// =======================================================
+/**
+ * Pack interior cells into the VTK staging buffer - 3D.
+ */
+class PackVTKFunctor3D {
+
+public:
+  PackVTKFunctor3D(DataArray3d Udata,
+		   Kokkos::View<storage_t*, Device> buffer,
+		   int nx, int ny, int nz, int ghostWidth,
+		   int nbvar, int64_t stride, int64_t header) :
+    Udata(Udata), buffer(buffer), nx(nx), ny(ny), nz(nz),
+    ghostWidth(ghostWidth), nbvar(nbvar), stride(stride), header(header) {};
+
+  static void apply(DataArray3d Udata,
+		    Kokkos::View<storage_t*, Device> buffer,
+		    int nx, int ny, int nz, int ghostWidth,
+		    int nbvar, int64_t stride, int64_t header)
+  {
+    PackVTKFunctor3D functor(Udata, buffer, nx, ny, nz, ghostWidth,
+			     nbvar, stride, header);
+    Kokkos::parallel_for("PackVTKFunctor3D",
+			 Kokkos::RangePolicy<Device>(0, (int64_t) nx*ny*nz),
+			 functor);
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const int64_t& index) const
+  {
+    const int64_t nxy = (int64_t) nx*ny;
+    const int k = index / nxy;
+    const int j = (index - k*nxy) / nx;
+    const int i = index - k*nxy - (int64_t) j*nx;
+
+    for (int iVar=0; iVar<nbvar; ++iVar)
+      buffer(iVar*stride + header + index) =
+	Udata(i+ghostWidth, j+ghostWidth, k+ghostWidth, iVar);
+  }
+
+  DataArray3d Udata;
+  Kokkos::View<storage_t*, Device> buffer;
+  int nx, ny, nz, ghostWidth, nbvar;
+  int64_t stride, header;
+
+}; // PackVTKFunctor3D
+
+// =======================================================
+// =======================================================
+//! number of storage_t slots used by the UInt64 size header of an array
+static constexpr int64_t vtk_header_slots =
+  (sizeof(uint64_t) + sizeof(storage_t) - 1) / sizeof(storage_t);
+
+// =======================================================
+// =======================================================
+VTKWriter::VTKWriter(HydroParams& params,
+		     ConfigMap& configMap,
+		     const std::map<int, std::string>& variables_names) :
+  params(params),
+  configMap(configMap),
+  variables_names(variables_names),
+  buffer(),
+  buffer_host(),
+  nbCells(0),
+  nbvar(0),
+  pvti_header(),
+  pvti_decomposition()
+{
+} // VTKWriter::VTKWriter
+
+// =======================================================
+// =======================================================
+void VTKWriter::resize_buffer(int64_t nbCells_, int nbvar_)
+{
+
+  if (nbCells_ == nbCells && nbvar_ == nbvar && buffer.size() > 0)
+    return;
+
+  nbCells = nbCells_;
+  nbvar   = nbvar_;
+
+  const int64_t stride = vtk_header_slots + nbCells;
+
+  buffer      = Buffer("VTK staging buffer", nbvar*stride);
+  buffer_host = Kokkos::create_mirror_view(buffer);
+
+  // size headers are never touched by the pack kernels : write them once
+  const uint64_t size = sizeof(storage_t)*nbCells;
+  for (int iVar=0; iVar<nbvar; ++iVar)
+    memcpy(&buffer_host(iVar*stride), &size, sizeof(uint64_t));
+  Kokkos::deep_copy(buffer, buffer_host);
+
+} // VTKWriter::resize_buffer
+
+// =======================================================
+// =======================================================
+void VTKWriter::save(DataArray2d Udata, int iStep, std::string debug_name)
+{
+
+  const int nx = params.nx;
+  const int ny = params.ny;
+
+  resize_buffer((int64_t) nx*ny, params.nbvar);
+
+  PackVTKFunctor2D::apply(Udata, buffer, nx, ny, params.ghostWidth,
+			  nbvar, vtk_header_slots+nbCells, vtk_header_slots);
+  Kokkos::deep_copy(buffer_host, buffer);
+
+  const int extent[6] = {params.myOffset[IX], params.myOffset[IX]+nx,
+			 params.myOffset[IY], params.myOffset[IY]+ny,
+			 0, 0};
+
+  write_piece(iStep, debug_name, extent);
+
+} // VTKWriter::save - 2d
+
+// =======================================================
+// =======================================================
+void VTKWriter::save(DataArray3d Udata, int iStep, std::string debug_name)
+{
+
+  const int nx = params.nx;
+  const int ny = params.ny;
+  const int nz = params.nz;
+
+  resize_buffer((int64_t) nx*ny*nz, params.nbvar);
+
+  PackVTKFunctor3D::apply(Udata, buffer, nx, ny, nz, params.ghostWidth,
+			  nbvar, vtk_header_slots+nbCells, vtk_header_slots);
+  Kokkos::deep_copy(buffer_host, buffer);
+
+  const int extent[6] = {params.myOffset[IX], params.myOffset[IX]+nx,
+			 params.myOffset[IY], params.myOffset[IY]+ny,
+			 params.myOffset[IZ], params.myOffset[IZ]+nz};
+
+  write_piece(iStep, debug_name, extent);
+
+} // VTKWriter::save - 3d
+
+// =======================================================
+// =======================================================
+void VTKWriter::write_piece(int iStep, std::string debug_name,
+			    const int extent[6])
+{
+
+  std::string outputDir    = configMap.getString("output", "outputDir", "./");
+  std::string outputPrefix = configMap.getString("output", "outputPrefix", "output");
+
+  if ( !debug_name.empty() )
+    outputPrefix += "_" + debug_name;
+
+  const char* dataType = sizeof(storage_t) == sizeof(double) ? "Float64" : "Float32";
+
+  // write iStep in string stepNum
+  std::ostringstream stepNum;
+  stepNum.width(7);
+  stepNum.fill('0');
+  stepNum << iStep;
+
+  std::string filename = outputDir + "/" + outputPrefix + "_" + stepNum.str() + ".vti";
+
+#ifdef USE_MPI
+  {
+    // write MPI rank in string rankFormat
+    std::ostringstream rankFormat;
+    rankFormat.width(5);
+    rankFormat.fill('0');
+    rankFormat << params.myRank;
+
+    filename = outputDir+"/"+outputPrefix+"_time"+stepNum.str()+"_mpi"+rankFormat.str()+".vti";
+  }
+
+  // pvti header : only rebuilt when the decomposition (or prefix) changes
+  if (params.myRank == 0) {
+
+    static const std::string marker("@STEP@");
+
+    std::vector<int> decomposition;
+    for (int iPiece=0; iPiece<params.nProcs; ++iPiece) {
+      int coords[3] = {0, 0, 0};
+      params.communicator->getCoords(iPiece, params.dimType == TWO_D ? 2 : 3, coords);
+      for (int dir=IX; dir<=(params.dimType == TWO_D ? IY : IZ); ++dir) {
+	decomposition.push_back(params.block_offset(dir, coords[dir]));
+	decomposition.push_back(params.block_size(dir, coords[dir]));
+      }
+    }
+    decomposition.insert(decomposition.end(), outputPrefix.begin(), outputPrefix.end());
+
+    if (pvti_header.empty() || decomposition != pvti_decomposition) {
+      pvti_header = make_pvti_header(outputPrefix, params, nbvar,
+				     variables_names, marker, dataType);
+      pvti_decomposition = decomposition;
+    }
+
+    std::string header = pvti_header;
+    for (size_t pos = header.find(marker); pos != std::string::npos;
+	 pos = header.find(marker, pos))
+      header.replace(pos, marker.size(), stepNum.str());
+
+    std::string headerFilename = outputDir+"/"+outputPrefix+"_time"+stepNum.str()+".pvti";
+    std::ofstream outHeader(headerFilename.c_str());
+    outHeader << header;
+  }
+
+  // nothing to write for an empty piece (not referenced by the pvti header)
+  if (nbCells == 0)
+    return;
 #endif // USE_MPI
 
+  // xml part, before and after the appended data
+  std::ostringstream head;
+
+  head << "<VTKFile type=\"ImageData\" version=\"1.0\" byte_order=\""
+       << (isBigEndian() ? "BigEndian" : "LittleEndian")
+       << "\" header_type=\"UInt64\">\n";
+
+  head << "  <ImageData WholeExtent=\""
+       << extent[0] << " " << extent[1] << " "
+       << extent[2] << " " << extent[3] << " "
+       << extent[4] << " " << extent[5] << "\" "
+       << "Origin=\""
+       << params.xmin << " " << params.ymin << " "
+       << (params.dimType == TWO_D ? 0.0 : params.zmin) << "\" "
+       << "Spacing=\""
+       << params.dx << " " << params.dy << " "
+       << (params.dimType == TWO_D ? 0.0 : params.dz) << "\">\n";
+  head << "  <Piece Extent=\""
+       << extent[0] << " " << extent[1] << " "
+       << extent[2] << " " << extent[3] << " "
+       << extent[4] << " " << extent[5] << "\">\n";
+
+  head << "    <PointData>\n";
+  head << "    </PointData>\n";
+  head << "    <CellData>\n";
+
+  const int64_t stride = vtk_header_slots + nbCells;
+  for (int iVar=0; iVar<nbvar; ++iVar) {
+    head << "     <DataArray type=\"" << dataType << "\" Name=\""
+	 << variables_names.at(iVar)
+	 << "\" format=\"appended\" offset=\""
+	 << iVar*stride*sizeof(storage_t) << "\" />\n";
+  }
+
+  head << "    </CellData>\n";
+  head << "  </Piece>\n";
+  head << "  </ImageData>\n";
+  head << "  <AppendedData encoding=\"raw\">\n";
+
+  // leading underscore
+  head << "_";
+
+  const std::string headStr = head.str();
+  const std::string footStr = "\n  </AppendedData>\n</VTKFile>\n";
+
+  int fd = open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) {
+    std::cerr << "VTKWriter: unable to open " << filename
+	      << " (" << strerror(errno) << ")\n";
+    return;
+  }
+
+  // the whole piece in a single system call (loop on partial writes)
+  struct iovec iov[3];
+  iov[0].iov_base = const_cast<char*>(headStr.data());
+  iov[0].iov_len  = headStr.size();
+  iov[1].iov_base = buffer_host.data();
+  iov[1].iov_len  = buffer_host.size()*sizeof(storage_t);
+  iov[2].iov_base = const_cast<char*>(footStr.data());
+  iov[2].iov_len  = footStr.size();
+
+  int first = 0;
+  while (first < 3) {
+    ssize_t written = writev(fd, iov+first, 3-first);
+    if (written < 0) {
+      if (errno == EINTR)
+	continue;
+      std::cerr << "VTKWriter: error writing " << filename
+		<< " (" << strerror(errno) << ")\n";
+      break;
+    }
+    while (first < 3 && (size_t) written >= iov[first].iov_len) {
+      written -= iov[first].iov_len;
+      ++first;
+    }
+    if (first < 3) {
+      iov[first].iov_base = static_cast<char*>(iov[first].iov_base) + written;
+      iov[first].iov_len -= written;
+    }
+  }
+
+  close(fd);
+
+} // VTKWriter::write_piece
+
 } // namespace io
 
 } // namespace ppkMHD
@@ -3,6 +3,8 @@
 
 #include <map>
 #include <string>
+#include <vector>
+#include <cstdint>
 
 #include <shared/kokkos_shared.h>
 struct HydroParams;
@@ -83,8 +85,70 @@ void write_pvti_header(std::string headerFilename,
 		       int nbvar,
 		       const std::map<int, std::string>& varNames,
 		       int iStep);
+
+/**
+ * Build the pvti header content; piece file names use step string stepStr.
+ */
+std::string make_pvti_header(std::string outputPrefix,
+			     HydroParams& params,
+			     int nbvar,
+			     const std::map<int, std::string>& varNames,
+			     std::string stepStr,
+			     const char* dataType);
 #endif // USE_MPI
 
+/**
+ * Binary VTK writer (VtkImageData, raw appended data) with a staging buffer.
+ *
+ * A device kernel packs the interior cells of all variables into a
+ * reusable buffer laid out exactly as the appended data section of the
+ * .vti file (UInt64 size header, then the array, for each variable), so
+ * that no full host copy of the state is needed: only the packed buffer is
+ * copied to host (no copy at all when device memory is host memory). Each
+ * process then writes its whole piece with a single writev call.
+ *
+ * Data are written in storage precision (storage_t). The pvti header
+ * (MPI) is built once and only the step number is substituted at each
+ * dump; it is rebuilt when the domain decomposition changes.
+ */
+class VTKWriter {
+
+public:
+  VTKWriter(HydroParams& params,
+	    ConfigMap& configMap,
+	    const std::map<int, std::string>& variables_names);
+
+  void save(DataArray2d Udata, int iStep, std::string debug_name);
+  void save(DataArray3d Udata, int iStep, std::string debug_name);
+
+private:
+  using Buffer = Kokkos::View<storage_t*, Device>;
+
+  HydroParams& params;
+  ConfigMap& configMap;
+  const std::map<int, std::string>& variables_names;
+
+  //! staging buffer, in the order of the appended data section
+  Buffer buffer;
+  Buffer::HostMirror buffer_host;
+
+  //! number of cells / variables the staging buffer was allocated for
+  int64_t nbCells;
+  int nbvar;
+
+  //! cached pvti header (step number replaced by a marker)
+  std::string pvti_header;
+  std::vector<int> pvti_decomposition;
+
+  //! (re)allocate staging buffer if needed and write size headers
+  void resize_buffer(int64_t nbCells, int nbvar);
+
+  //! write piece file (xml header + staging buffer + footer)
+  void write_piece(int iStep, std::string debug_name,
+		   const int extent[6]);
+
+}; // class VTKWriter
+
 } // namespace io
 
 } // namespace ppkMHD
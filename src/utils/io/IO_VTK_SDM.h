@@ -51,11 +51,11 @@ void write_nodes_location(std::ostream& outFile,
   const real_t dy = params.dy;
   
 #ifdef USE_MPI
-  const int i_mpi = params.myMpiPos[IX];
-  const int j_mpi = params.myMpiPos[IY];
+  const int i_offset = params.myOffset[IX];
+  const int j_offset = params.myOffset[IY];
 #else
-  const int i_mpi = 0;
-  const int j_mpi = 0;
+  const int i_offset = 0;
+  const int j_offset = 0;
 #endif
   
   bool outputVtkAscii = configMap.getBool("output", "outputVtkAscii", false);
@@ -78,8 +78,8 @@ void write_nodes_location(std::ostream& outFile,
       for (int i=0; i<nx; ++i) {
 	
 	// cell offset
-	real_t xo = xmin + (i+nx*i_mpi)*dx;
-	real_t yo = ymin + (j+ny*j_mpi)*dy;
+	real_t xo = xmin + (i+i_offset)*dx;
+	real_t yo = ymin + (j+j_offset)*dy;
 	
 	for (int idy=0; idy<N+1; ++idy) {
 	  for (int idx=0; idx<N+1; ++idx) {
@@ -153,13 +153,13 @@ void write_nodes_location(std::ostream& outFile,
   const real_t dz = params.dz;
   
 #ifdef USE_MPI
-  const int i_mpi = params.myMpiPos[IX];
-  const int j_mpi = params.myMpiPos[IY];
-  const int k_mpi = params.myMpiPos[IZ];
+  const int i_offset = params.myOffset[IX];
+  const int j_offset = params.myOffset[IY];
+  const int k_offset = params.myOffset[IZ];
 #else
-  const int i_mpi = 0;
-  const int j_mpi = 0;
-  const int k_mpi = 0;
+  const int i_offset = 0;
+  const int j_offset = 0;
+  const int k_offset = 0;
 #endif
   
   bool outputVtkAscii = configMap.getBool("output", "outputVtkAscii", false);
@@ -181,9 +181,9 @@ void write_nodes_location(std::ostream& outFile,
 	for (int i=0; i<nx; ++i) {
 	  
 	  // cell offset
-	  real_t xo = xmin + (i+nx*i_mpi)*dx;
-	  real_t yo = ymin + (j+ny*j_mpi)*dy;
-	  real_t zo = zmin + (k+nz*k_mpi)*dz;
+	  real_t xo = xmin + (i+i_offset)*dx;
+	  real_t yo = ymin + (j+j_offset)*dy;
+	  real_t zo = zmin + (k+k_offset)*dz;
 	  
 	  for (int idz=0; idz<N+1; ++idz) {
 	    for (int idy=0; idy<N+1; ++idy) {
@@ -702,11 +702,11 @@ void write_appended_binary_data(std::ostream& outFile,
   const real_t dy = params.dy;
   
 #ifdef USE_MPI
-  const int i_mpi = params.myMpiPos[IX];
-  const int j_mpi = params.myMpiPos[IY];
+  const int i_offset = params.myOffset[IX];
+  const int j_offset = params.myOffset[IY];
 #else
-  const int i_mpi = 0;
-  const int j_mpi = 0;
+  const int i_offset = 0;
+  const int j_offset = 0;
 #endif
 
   const int nbvar = variables_names.size();
@@ -730,8 +730,8 @@ void write_appended_binary_data(std::ostream& outFile,
       for (int i=0; i<nx; ++i) {
 	
 	// cell offset
-	real_t xo = xmin + (i+nx*i_mpi)*dx;
-	real_t yo = ymin + (j+ny*j_mpi)*dy;
+	real_t xo = xmin + (i+i_offset)*dx;
+	real_t yo = ymin + (j+j_offset)*dy;
 	
 	for (int idy=0; idy<N+1; ++idy) {
 	  for (int idx=0; idx<N+1; ++idx) {
@@ -931,13 +931,13 @@ void write_appended_binary_data(std::ostream& outFile,
   const real_t dz = params.dz;
   
 #ifdef USE_MPI
-  const int i_mpi = params.myMpiPos[IX];
-  const int j_mpi = params.myMpiPos[IY];
-  const int k_mpi = params.myMpiPos[IZ];
+  const int i_offset = params.myOffset[IX];
+  const int j_offset = params.myOffset[IY];
+  const int k_offset = params.myOffset[IZ];
 #else
-  const int i_mpi = 0;
-  const int j_mpi = 0;
-  const int k_mpi = 0;
+  const int i_offset = 0;
+  const int j_offset = 0;
+  const int k_offset = 0;
 #endif
 
   const int nbvar = variables_names.size();
@@ -966,9 +966,9 @@ void write_appended_binary_data(std::ostream& outFile,
 	for (int i=0; i<nx; ++i) {
 	  
 	  // cell offset
-	  real_t xo = xmin + (i+nx*i_mpi)*dx;
-	  real_t yo = ymin + (j+ny*j_mpi)*dy;
-	  real_t zo = zmin + (k+nz*k_mpi)*dz;
+	  real_t xo = xmin + (i+i_offset)*dx;
+	  real_t yo = ymin + (j+j_offset)*dy;
+	  real_t zo = zmin + (k+k_offset)*dz;
 	  
 	  for (int idz=0; idz<N+1; ++idz) {
 	    for (int idy=0; idy<N+1; ++idy) {
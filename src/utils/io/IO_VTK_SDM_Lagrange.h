@@ -0,0 +1,705 @@
+/**
+ * VTK output routines for the High-order Spectral Difference Method schemes
+ * using VTK Lagrange cells : each SDM cell is written as a single high-order
+ * cell (VTK_LAGRANGE_QUADRILATERAL / VTK_LAGRANGE_HEXAHEDRON) instead of
+ * N^dim linear sub-cells.
+ *
+ * The SDM solution in a cell is a polynomial of degree N-1 in each
+ * direction; it is evaluated at the (equidistant) nodes of a Lagrange cell
+ * of the same order, so that the VTK interpolant reproduces it exactly.
+ * Nodes are not shared between cells (the SDM solution is discontinuous at
+ * cell borders), data are attached to points.
+ *
+ * Points, connectivity, offsets and types only depend on the local
+ * sub-domain: they are serialized once (see VTKLagrangeGeometry) and the
+ * cached bytes are copied verbatim into each time step file; only the
+ * point data are computed at each dump.
+ */
+
+#ifndef IO_VTK_SDM_LAGRANGE_H_
+#define IO_VTK_SDM_LAGRANGE_H_
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include <cstdint>
+#include <cstring>
+
+#include "shared/kokkos_shared.h"
+#include "shared/HydroParams.h"
+#include "utils/config/ConfigMap.h"
+
+#include "sdm/SDM_Geometry.h"
+#include "sdm/sdm_shared.h" // for DofMap
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+
+#include "utils/io/IO_VTK_SDM_shared.h"
+
+namespace ppkMHD { namespace io {
+
+//! VTK cell type identifiers for Lagrange cells
+enum VTKLagrangeCellType {
+  VTK_LAGRANGE_QUADRILATERAL_ID = 70,
+  VTK_LAGRANGE_HEXAHEDRON_ID    = 72
+};
+
+// =======================================================
+// =======================================================
+/**
+ * Order of the Lagrange cells used to represent a SDM solution with N
+ * solution points per direction (a Lagrange cell has at least order 1).
+ */
+KOKKOS_INLINE_FUNCTION
+constexpr int vtk_lagrange_order(int N)
+{
+  return N > 1 ? N-1 : 1;
+}
+
+// =======================================================
+// =======================================================
+/**
+ * VTK Lagrange quadrilateral local node index of node (i,j), i,j in [0,p].
+ *
+ * Ordering is : vertices, edges (along increasing parametric coordinate),
+ * then interior nodes (i fastest).
+ */
+inline int vtk_lagrange_node_index(int i, int j, int p)
+{
+  const bool ibdy = (i == 0 || i == p);
+  const bool jbdy = (j == 0 || j == p);
+  const int nbdy = (ibdy ? 1 : 0) + (jbdy ? 1 : 0);
+
+  // vertex
+  if (nbdy == 2)
+    return (i ? (j ? 2 : 1) : (j ? 3 : 0));
+
+  int offset = 4;
+
+  // edge
+  if (nbdy == 1) {
+    if (!ibdy)
+      return (i-1) + (j ? 2*(p-1) : 0) + offset;
+    return (j-1) + (i ? (p-1) : 3*(p-1)) + offset;
+  }
+
+  // interior
+  offset += 4*(p-1);
+  return offset + (i-1) + (p-1)*(j-1);
+
+} // vtk_lagrange_node_index - 2d
+
+// =======================================================
+// =======================================================
+/**
+ * VTK Lagrange hexahedron local node index of node (i,j,k), i,j,k in [0,p].
+ *
+ * Ordering is the one of VTK XML file format version 2.2 : vertices, edges,
+ * faces (-x,+x,-y,+y,-z,+z), then interior nodes (i fastest).
+ */
+inline int vtk_lagrange_node_index(int i, int j, int k, int p)
+{
+  const bool ibdy = (i == 0 || i == p);
+  const bool jbdy = (j == 0 || j == p);
+  const bool kbdy = (k == 0 || k == p);
+  const int nbdy = (ibdy ? 1 : 0) + (jbdy ? 1 : 0) + (kbdy ? 1 : 0);
+
+  const int q = p-1; // number of nodes strictly inside an edge
+
+  // vertex
+  if (nbdy == 3)
+    return (i ? (j ? 2 : 1) : (j ? 3 : 0)) + (k ? 4 : 0);
+
+  int offset = 8;
+
+  // edge
+  if (nbdy == 2) {
+    if (!ibdy)
+      return (i-1) + (j ? 2*q : 0) + (k ? 4*q : 0) + offset;
+    if (!jbdy)
+      return (j-1) + (i ? q : 3*q) + (k ? 4*q : 0) + offset;
+    offset += 8*q;
+    return (k-1) + q * (i ? (j ? 3 : 1) : (j ? 2 : 0)) + offset;
+  }
+
+  offset += 12*q;
+
+  // face
+  if (nbdy == 1) {
+    if (ibdy)
+      return (j-1) + q*(k-1) + (i ? q*q : 0) + offset;
+    offset += 2*q*q;
+    if (jbdy)
+      return (i-1) + q*(k-1) + (j ? q*q : 0) + offset;
+    offset += 2*q*q;
+    return (i-1) + q*(j-1) + (k ? q*q : 0) + offset;
+  }
+
+  // interior
+  offset += 6*q*q;
+  return offset + (i-1) + q*((j-1) + q*(k-1));
+
+} // vtk_lagrange_node_index - 3d
+
+// =======================================================
+// =======================================================
+/**
+ * Cached geometry of a Lagrange cell VTU piece.
+ *
+ * bytes holds the beginning of the raw appended data section (points,
+ * connectivity, offsets and types, each with its UInt64 size header). It is
+ * rebuilt only when the local sub-domain changes (e.g. after a load
+ * balancing step).
+ */
+struct VTKLagrangeGeometry {
+
+  //! local sub-domain the cache was built for
+  int nx = -1, ny = -1, nz = -1;
+  int i_offset = -1, j_offset = -1, k_offset = -1;
+
+  //! offset of each array inside the appended section
+  uint64_t offset_points = 0;
+  uint64_t offset_connectivity = 0;
+  uint64_t offset_offsets = 0;
+  uint64_t offset_types = 0;
+
+  //! raw appended bytes
+  std::vector<char> bytes;
+
+  //! true when the cache matches the given sub-domain
+  bool valid(int nx_, int ny_, int nz_, int io, int jo, int ko) const
+  {
+    return !bytes.empty() &&
+      nx == nx_ && ny == ny_ && nz == nz_ &&
+      i_offset == io && j_offset == jo && k_offset == ko;
+  }
+
+  //! append a data array (size header + values), return its offset
+  template<typename T>
+  uint64_t append(const std::vector<T>& data)
+  {
+    uint64_t offset = bytes.size();
+    uint64_t size = sizeof(T)*data.size();
+    bytes.resize(offset + sizeof(uint64_t) + size);
+    memcpy(&bytes[offset], &size, sizeof(uint64_t));
+    if (size)
+      memcpy(&bytes[offset+sizeof(uint64_t)], data.data(), size);
+    return offset;
+  }
+
+}; // struct VTKLagrangeGeometry
+
+// =======================================================
+// =======================================================
+/**
+ * Fill geometry cache - 2D.
+ *
+ * Nodes of cell (i,j) are numbered consecutively, cell after cell, in VTK
+ * Lagrange order.
+ */
+template<int N>
+void build_lagrange_geometry(VTKLagrangeGeometry& geom,
+			     sdm::SDM_Geometry<2,N> sdm_geom,
+			     HydroParams& params)
+{
+  UNUSED(sdm_geom);
+
+  const int nx = params.nx;
+  const int ny = params.ny;
+
+  const real_t xmin = params.xmin;
+  const real_t ymin = params.ymin;
+
+  const real_t dx = params.dx;
+  const real_t dy = params.dy;
+
+#ifdef USE_MPI
+  const int i_offset = params.myOffset[IX];
+  const int j_offset = params.myOffset[IY];
+#else
+  const int i_offset = 0;
+  const int j_offset = 0;
+#endif
+
+  const int p = vtk_lagrange_order(N);
+  const int nbNodesPerCell = (p+1)*(p+1);
+  const uint64_t nbCells = (uint64_t) nx*ny;
+
+  std::vector<float>    points(nbCells*nbNodesPerCell*3);
+  std::vector<uint64_t> connectivity(nbCells*nbNodesPerCell);
+  std::vector<uint64_t> offsets(nbCells);
+  std::vector<unsigned char> types(nbCells, VTK_LAGRANGE_QUADRILATERAL_ID);
+
+  for (int j=0; j<ny; ++j) {
+    for (int i=0; i<nx; ++i) {
+
+      const uint64_t index = i + (uint64_t) nx*j;
+      const uint64_t first = index*nbNodesPerCell;
+
+      // cell offset
+      real_t xo = xmin + (i+i_offset)*dx;
+      real_t yo = ymin + (j+j_offset)*dy;
+
+      for (int b=0; b<=p; ++b) {
+	for (int a=0; a<=p; ++a) {
+
+	  const uint64_t node = first + vtk_lagrange_node_index(a,b,p);
+
+	  points[3*node  ] = xo + dx*a/p;
+	  points[3*node+1] = yo + dy*b/p;
+	  points[3*node+2] = 0.0;
+
+	} // for a
+      } // for b
+
+      for (int n=0; n<nbNodesPerCell; ++n)
+	connectivity[first+n] = first+n;
+
+      offsets[index] = first + nbNodesPerCell;
+
+    } // for i
+  } // for j
+
+  geom.bytes.clear();
+  geom.offset_points       = geom.append(points);
+  geom.offset_connectivity = geom.append(connectivity);
+  geom.offset_offsets      = geom.append(offsets);
+  geom.offset_types        = geom.append(types);
+
+  geom.nx = nx; geom.ny = ny; geom.nz = 1;
+  geom.i_offset = i_offset; geom.j_offset = j_offset; geom.k_offset = 0;
+
+} // build_lagrange_geometry - 2d
+
+// =======================================================
+// =======================================================
+/**
+ * Fill geometry cache - 3D.
+ */
+template<int N>
+void build_lagrange_geometry(VTKLagrangeGeometry& geom,
+			     sdm::SDM_Geometry<3,N> sdm_geom,
+			     HydroParams& params)
+{
+  UNUSED(sdm_geom);
+
+  const int nx = params.nx;
+  const int ny = params.ny;
+  const int nz = params.nz;
+
+  const real_t xmin = params.xmin;
+  const real_t ymin = params.ymin;
+  const real_t zmin = params.zmin;
+
+  const real_t dx = params.dx;
+  const real_t dy = params.dy;
+  const real_t dz = params.dz;
+
+#ifdef USE_MPI
+  const int i_offset = params.myOffset[IX];
+  const int j_offset = params.myOffset[IY];
+  const int k_offset = params.myOffset[IZ];
+#else
+  const int i_offset = 0;
+  const int j_offset = 0;
+  const int k_offset = 0;
+#endif
+
+  const int p = vtk_lagrange_order(N);
+  const int nbNodesPerCell = (p+1)*(p+1)*(p+1);
+  const uint64_t nbCells = (uint64_t) nx*ny*nz;
+
+  std::vector<float>    points(nbCells*nbNodesPerCell*3);
+  std::vector<uint64_t> connectivity(nbCells*nbNodesPerCell);
+  std::vector<uint64_t> offsets(nbCells);
+  std::vector<unsigned char> types(nbCells, VTK_LAGRANGE_HEXAHEDRON_ID);
+
+  for (int k=0; k<nz; ++k) {
+    for (int j=0; j<ny; ++j) {
+      for (int i=0; i<nx; ++i) {
+
+	const uint64_t index = i + (uint64_t) nx*(j + (uint64_t) ny*k);
+	const uint64_t first = index*nbNodesPerCell;
+
+	// cell offset
+	real_t xo = xmin + (i+i_offset)*dx;
+	real_t yo = ymin + (j+j_offset)*dy;
+	real_t zo = zmin + (k+k_offset)*dz;
+
+	for (int c=0; c<=p; ++c) {
+	  for (int b=0; b<=p; ++b) {
+	    for (int a=0; a<=p; ++a) {
+
+	      const uint64_t node = first + vtk_lagrange_node_index(a,b,c,p);
+
+	      points[3*node  ] = xo + dx*a/p;
+	      points[3*node+1] = yo + dy*b/p;
+	      points[3*node+2] = zo + dz*c/p;
+
+	    } // for a
+	  } // for b
+	} // for c
+
+	for (int n=0; n<nbNodesPerCell; ++n)
+	  connectivity[first+n] = first+n;
+
+	offsets[index] = first + nbNodesPerCell;
+
+      } // for i
+    } // for j
+  } // for k
+
+  geom.bytes.clear();
+  geom.offset_points       = geom.append(points);
+  geom.offset_connectivity = geom.append(connectivity);
+  geom.offset_offsets      = geom.append(offsets);
+  geom.offset_types        = geom.append(types);
+
+  geom.nx = nx; geom.ny = ny; geom.nz = nz;
+  geom.i_offset = i_offset; geom.j_offset = j_offset; geom.k_offset = k_offset;
+
+} // build_lagrange_geometry - 3d
+
+// =======================================================
+// =======================================================
+/**
+ * Interpolation matrix from the N solution points to the p+1 equidistant
+ * Lagrange cell nodes : interp[a*N+i] is the value of the i-th Lagrange
+ * polynomial (solution points basis) at node a.
+ */
+template<int dim, int N>
+std::vector<real_t> lagrange_nodes_interp(sdm::SDM_Geometry<dim,N> sdm_geom)
+{
+  const int p = vtk_lagrange_order(N);
+
+  std::vector<real_t> interp((p+1)*N);
+
+  for (int a=0; a<=p; ++a) {
+
+    const real_t x_a = 1.0*a/p;
+
+    for (int i=0; i<N; ++i) {
+
+      const real_t x_i = sdm_geom.solution_pts_1d_host(i);
+
+      real_t l = 1.0;
+      for (int k=0; k<N; ++k) {
+	const real_t x_k = sdm_geom.solution_pts_1d_host(k);
+	if (k != i)
+	  l *= (x_a-x_k)/(x_i-x_k);
+      }
+
+      interp[a*N+i] = l;
+
+    } // for i
+
+  } // for a
+
+  return interp;
+
+} // lagrange_nodes_interp
+
+// =======================================================
+// =======================================================
+/**
+ * Evaluate variable iVar at the Lagrange nodes of every cell - 2D.
+ */
+template<int N>
+void lagrange_nodes_data(std::vector<real_t>& data,
+			 DataArray2d::HostMirror Uhost,
+			 const std::vector<real_t>& interp,
+			 HydroParams& params,
+			 int iVar)
+{
+  const int nx = params.nx;
+  const int ny = params.ny;
+  const int gw = params.ghostWidth;
+
+  const int p = vtk_lagrange_order(N);
+  const int nbNodesPerCell = (p+1)*(p+1);
+
+  data.resize((uint64_t) nx*ny*nbNodesPerCell);
+
+  // partial interpolation along x : tmp(a,idy)
+  std::vector<real_t> tmp((p+1)*N);
+
+  for (int j=0; j<ny; ++j) {
+    for (int i=0; i<nx; ++i) {
+
+      const uint64_t first = (i + (uint64_t) nx*j)*nbNodesPerCell;
+
+      for (int idy=0; idy<N; ++idy) {
+	for (int a=0; a<=p; ++a) {
+	  real_t v = 0;
+	  for (int idx=0; idx<N; ++idx)
+	    v += interp[a*N+idx] * Uhost(gw+i,gw+j, sdm::DofMap<2,N>(idx,idy,0,iVar));
+	  tmp[a*N+idy] = v;
+	}
+      }
+
+      for (int b=0; b<=p; ++b) {
+	for (int a=0; a<=p; ++a) {
+	  real_t v = 0;
+	  for (int idy=0; idy<N; ++idy)
+	    v += interp[b*N+idy] * tmp[a*N+idy];
+	  data[first + vtk_lagrange_node_index(a,b,p)] = v;
+	}
+      }
+
+    } // for i
+  } // for j
+
+} // lagrange_nodes_data - 2d
+
+// =======================================================
+// =======================================================
+/**
+ * Evaluate variable iVar at the Lagrange nodes of every cell - 3D.
+ */
+template<int N>
+void lagrange_nodes_data(std::vector<real_t>& data,
+			 DataArray3d::HostMirror Uhost,
+			 const std::vector<real_t>& interp,
+			 HydroParams& params,
+			 int iVar)
+{
+  const int nx = params.nx;
+  const int ny = params.ny;
+  const int nz = params.nz;
+  const int gw = params.ghostWidth;
+
+  const int p = vtk_lagrange_order(N);
+  const int P = p+1;
+  const int nbNodesPerCell = P*P*P;
+
+  data.resize((uint64_t) nx*ny*nz*nbNodesPerCell);
+
+  // partial interpolations : along x tmpx(a,idy,idz), then y tmpy(a,b,idz)
+  std::vector<real_t> tmpx(P*N*N);
+  std::vector<real_t> tmpy(P*P*N);
+
+  for (int k=0; k<nz; ++k) {
+    for (int j=0; j<ny; ++j) {
+      for (int i=0; i<nx; ++i) {
+
+	const uint64_t first = (i + (uint64_t) nx*(j + (uint64_t) ny*k))*nbNodesPerCell;
+
+	for (int idz=0; idz<N; ++idz) {
+	  for (int idy=0; idy<N; ++idy) {
+	    for (int a=0; a<P; ++a) {
+	      real_t v = 0;
+	      for (int idx=0; idx<N; ++idx)
+		v += interp[a*N+idx] * Uhost(gw+i,gw+j,gw+k, sdm::DofMap<3,N>(idx,idy,idz,iVar));
+	      tmpx[(a*N+idy)*N+idz] = v;
+	    }
+	  }
+	}
+
+	for (int idz=0; idz<N; ++idz) {
+	  for (int b=0; b<P; ++b) {
+	    for (int a=0; a<P; ++a) {
+	      real_t v = 0;
+	      for (int idy=0; idy<N; ++idy)
+		v += interp[b*N+idy] * tmpx[(a*N+idy)*N+idz];
+	      tmpy[(a*P+b)*N+idz] = v;
+	    }
+	  }
+	}
+
+	for (int c=0; c<P; ++c) {
+	  for (int b=0; b<P; ++b) {
+	    for (int a=0; a<P; ++a) {
+	      real_t v = 0;
+	      for (int idz=0; idz<N; ++idz)
+		v += interp[c*N+idz] * tmpy[(a*P+b)*N+idz];
+	      data[first + vtk_lagrange_node_index(a,b,c,p)] = v;
+	    }
+	  }
+	}
+
+      } // for i
+    } // for j
+  } // for k
+
+} // lagrange_nodes_data - 3d
+
+// ================================================================
+// ================================================================
+/**
+ * Output routine (VTK file format, raw appended binary, VtkUnstructuredGrid
+ * made of Lagrange cells) for High-Order Spectral Difference method schemes.
+ *
+ * File names and the pvtu wrapper (MPI) are the same as save_VTK_SDM.
+ *
+ * \param[in] Udata device data to save
+ * \param[in,out] Uhost host data temporary array before saving to file
+ * \param[in,out] geom geometry cache, (re)built when needed
+ */
+template<int dim, int N>
+void save_VTK_SDM_Lagrange(typename std::conditional<dim==2,DataArray2d,DataArray3d>::type Udata,
+			   typename std::conditional<dim==2,DataArray2d,DataArray3d>::type::HostMirror Uhost,
+			   HydroParams& params,
+			   ConfigMap& configMap,
+			   sdm::SDM_Geometry<dim,N> sdm_geom,
+			   VTKLagrangeGeometry& geom,
+			   int nbvar,
+			   const std::map<int, std::string>& variables_names,
+			   int iStep,
+			   real_t time,
+			   std::string debug_name = "")
+{
+
+  const int nx = params.nx;
+  const int ny = params.ny;
+  const int nz = dim==2 ? 1 : params.nz;
+
+  // copy device data to host
+  Kokkos::deep_copy(Uhost, Udata);
+
+#ifdef USE_MPI
+  const int i_offset = params.myOffset[IX];
+  const int j_offset = params.myOffset[IY];
+  const int k_offset = dim==2 ? 0 : params.myOffset[IZ];
+#else
+  const int i_offset = 0;
+  const int j_offset = 0;
+  const int k_offset = 0;
+#endif
+
+  if (!geom.valid(nx,ny,nz,i_offset,j_offset,k_offset))
+    build_lagrange_geometry<N>(geom, sdm_geom, params);
+
+  // local variables
+  std::string outputDir    = configMap.getString("output", "outputDir", "./");
+  std::string outputPrefix = configMap.getString("output", "outputPrefix", "output");
+
+  bool useDouble = sizeof(real_t) == sizeof(double) ? true : false;
+  const char* dataType = useDouble ? "Float64" : "Float32";
+
+  // write iStep in string stepNum
+  std::ostringstream stepNum;
+  stepNum.width(7);
+  stepNum.fill('0');
+  stepNum << iStep;
+
+#ifdef USE_MPI
+  // write pvtu wrapper file (data are attached to nodes)
+  if (params.myRank == 0) {
+
+    // header file : parallel vtu format
+    std::string headerFilename = outputDir+"/"+outputPrefix+"_time"+stepNum.str()+".pvtu";
+
+    if ( !debug_name.empty() )
+      headerFilename = outputDir+"/"+outputPrefix+"_"+debug_name+"_time"+stepNum.str()+".pvtu";
+
+    write_pvtu_header(headerFilename,
+		      outputPrefix,
+		      params,
+		      configMap,
+		      nbvar,
+		      variables_names,
+		      iStep,
+		      true);
+  }
+#else
+  UNUSED(nbvar);
+#endif // USE_MPI
+
+  // concatenate file prefix + file number + suffix
+  std::string filename;
+  filename = outputDir + "/" + outputPrefix + "_" + stepNum.str() + ".vtu";
+
+  if ( !debug_name.empty() )
+    filename = outputDir + "/" + outputPrefix + "_" + debug_name + "_" + stepNum.str() + ".vtu";
+
+#ifdef USE_MPI
+  {
+    // write MPI rank in string rankFormat
+    std::ostringstream rankFormat;
+    rankFormat.width(5);
+    rankFormat.fill('0');
+    rankFormat << params.myRank;
+
+    // modify filename for mpi
+    filename = outputDir + "/" + outputPrefix + "_time" + stepNum.str()+"_mpi"+rankFormat.str()+".vtu";
+  }
+#endif // USE_MPI
+
+  const int p = vtk_lagrange_order(N);
+  const uint64_t nbOfCells = (uint64_t) nx*ny*nz;
+  const uint64_t nbOfNodes = nbOfCells * (dim==2 ? (p+1)*(p+1) : (p+1)*(p+1)*(p+1));
+
+  // open file
+  std::fstream outFile;
+  outFile.open(filename.c_str(), std::ios_base::out | std::ios_base::binary);
+
+  // write header (node ordering of Lagrange hexahedra requires version 2.2)
+  write_vtu_header(outFile, configMap, "2.2");
+
+  // write vtk metadata (time and iStep)
+  write_vtk_metadata(outFile, iStep, time);
+
+  outFile << "<Piece NumberOfPoints=\"" << nbOfNodes
+	  <<"\" NumberOfCells=\"" << nbOfCells << "\" >\n";
+
+  outFile << "  <Points>\n";
+  outFile << "    <DataArray type=\"Float32\" Name=\"Points\" NumberOfComponents=\"3\" format=\"appended\" offset=\"" << geom.offset_points << "\" />\n";
+  outFile << "  </Points>\n";
+
+  outFile << "  <Cells>\n";
+  outFile << "    <DataArray type=\"Int64\" Name=\"connectivity\" format=\"appended\" offset=\"" << geom.offset_connectivity << "\" />\n";
+  outFile << "    <DataArray type=\"Int64\" Name=\"offsets\" format=\"appended\" offset=\"" << geom.offset_offsets << "\" />\n";
+  outFile << "    <DataArray type=\"UInt8\" Name=\"types\" format=\"appended\" offset=\"" << geom.offset_types << "\" />\n";
+  outFile << "  </Cells>\n";
+
+  const int nbvarOut = variables_names.size();
+  const uint64_t dataSize = sizeof(real_t)*nbOfNodes;
+
+  outFile << "  <PointData>\n";
+  uint64_t offsetBytes = geom.bytes.size();
+  for (int iVar=0; iVar<nbvarOut; ++iVar) {
+    outFile << "    <DataArray type=\"" << dataType
+	    << "\" Name=\"" << variables_names.at(iVar)
+	    << "\" format=\"appended\" offset=\"" << offsetBytes << "\" />\n";
+    offsetBytes += sizeof(uint64_t) + dataSize;
+  }
+  outFile << "  </PointData>\n";
+
+  outFile << " </Piece>\n";
+  outFile << " </UnstructuredGrid>\n";
+
+  outFile << " <AppendedData encoding=\"raw\">" << "\n";
+
+  // leading underscore
+  outFile << "_";
+
+  // cached geometry
+  outFile.write(geom.bytes.data(), geom.bytes.size());
+
+  // nodes data
+  {
+    const std::vector<real_t> interp = lagrange_nodes_interp(sdm_geom);
+    std::vector<real_t> data;
+
+    for (int iVar=0; iVar<nbvarOut; ++iVar) {
+      lagrange_nodes_data<N>(data, Uhost, interp, params, iVar);
+      outFile.write(reinterpret_cast<const char *>( &dataSize ), sizeof(uint64_t) );
+      outFile.write(reinterpret_cast<const char *>( data.data() ), dataSize);
+    }
+  }
+
+  outFile << " </AppendedData>" << "\n";
+  outFile << "</VTKFile>\n";
+
+  outFile.close();
+
+} // save_VTK_SDM_Lagrange
+
+} // namespace io
+
+} // namespace ppkMHD
+
+#endif // IO_VTK_SDM_LAGRANGE_H_
@@ -16,7 +16,8 @@ static bool isBigEndian()
 // =======================================================
 // =======================================================
 void write_vtu_header(std::ostream& outFile,	
-		      ConfigMap& configMap)
+		      ConfigMap& configMap,
+		      const std::string& version)
 {
 
   bool outputVtkAscii = configMap.getBool("output", "outputVtkAscii", false);
@@ -41,9 +42,9 @@ void write_vtu_header(std::ostream& outFile,
   
   // write xml data header
   if (isBigEndian()) {
-    outFile << "<VTKFile type=\"UnstructuredGrid\" version=\"1.0\" byte_order=\"BigEndian\" header_type=\"UInt64\">\n";
+    outFile << "<VTKFile type=\"UnstructuredGrid\" version=\"" << version << "\" byte_order=\"BigEndian\" header_type=\"UInt64\">\n";
   } else {
-    outFile << "<VTKFile type=\"UnstructuredGrid\" version=\"1.0\" byte_order=\"LittleEndian\" header_type=\"UInt64\">\n";
+    outFile << "<VTKFile type=\"UnstructuredGrid\" version=\"" << version << "\" byte_order=\"LittleEndian\" header_type=\"UInt64\">\n";
   }
 
   outFile << "<UnstructuredGrid>\n";
@@ -11,9 +11,13 @@ namespace ppkMHD { namespace io {
 
 /**
  * Write VTK unstructured grid header.
+ *
+ * \param[in] version VTK XML file format version (2.2 is required to get
+ *             the current node ordering of high-order hexahedra).
  */
 void write_vtu_header(std::ostream& outFile,	
-		      ConfigMap& configMap);
+		      ConfigMap& configMap,
+		      const std::string& version = "1.0");
 
 /**
  * Write VTK unstructured grid metadata (date and time).
@@ -0,0 +1,90 @@
+#!/bin/bash
+
+########################################################################################
+########################################################################################
+# Compare the SDM isentropic vortex errors (computed with SDM_Compute_error.h)
+# obtained with a double precision build and a mixed precision build
+# (-DUSE_MIXED_PRECISION=ON: state stored in float, computations in double).
+#
+# The mixed precision build is accepted if, for each order / resolution, its L1 and
+# L2 errors are within TOLERANCE (relative) of the double precision errors, i.e.
+# storage round-off must stay well below the discretization error.
+#
+# Usage : mixed_precision_check.sh [BIN_DOUBLE BIN_MIXED]
+# (registered as ctest sdm_mixed_precision_check in mixed precision builds, see
+# test/sdm/CMakeLists.txt)
+########################################################################################
+########################################################################################
+
+########################################################################################
+# (REQUIRED) Edit the following variables to reflect your local environment
+########################################################################################
+
+# Full path to test_sdm_isentropic_vortex built with USE_DOUBLE=ON
+BIN_DOUBLE=$HOME/src/ppkMHD/build_double/test/sdm/test_sdm_isentropic_vortex
+
+# Full path to test_sdm_isentropic_vortex built with USE_MIXED_PRECISION=ON
+BIN_MIXED=$HOME/src/ppkMHD/build_mixed/test/sdm/test_sdm_isentropic_vortex
+
+# both can also be given on the command line
+if [ $# -ge 2 ]; then
+    BIN_DOUBLE=$1
+    BIN_MIXED=$2
+fi
+
+########################################################################################
+# (Optional) orders, resolutions and final time used for the comparison
+########################################################################################
+
+ORDERS=(2 3 4)
+SIZES=(32 64)
+TEND=1.0
+
+# maximum relative difference allowed between double and mixed errors
+TOLERANCE=0.01
+
+########################################################################################
+########################################################################################
+# No changes should be required beyond this point
+########################################################################################
+
+STATUS=0
+
+# extract "error L1=xxx, error L2=yyy" from test output
+get_errors() {
+    grep "test isentropic vortex" | sed -e 's/.*error L1=\([^,]*\), error L2=\(.*\)$/\1 \2/'
+}
+
+for N in "${ORDERS[@]}"; do
+    for SIZE in "${SIZES[@]}"; do
+
+	ERR_DOUBLE=$($BIN_DOUBLE $N $SIZE $TEND | get_errors)
+	ERR_MIXED=$($BIN_MIXED  $N $SIZE $TEND | get_errors)
+
+	read L1_D L2_D <<< "$ERR_DOUBLE"
+	read L1_M L2_M <<< "$ERR_MIXED"
+
+	if [ -z "$L2_D" ] || [ -z "$L2_M" ]; then
+	    echo "order $N, size=$SIZE : no error found in test output -> FAILED"
+	    STATUS=1
+	    continue
+	fi
+
+	RES=$(awk -v l1d=$L1_D -v l2d=$L2_D -v l1m=$L1_M -v l2m=$L2_M -v tol=$TOLERANCE '
+	    function rel(a,b) { d = a-b; if (d<0) d=-d; return d/b }
+	    BEGIN {
+		r1 = rel(l1m,l1d); r2 = rel(l2m,l2d);
+		printf("%6.4e %6.4e %s", r1, r2, (r1<=tol && r2<=tol) ? "PASSED" : "FAILED")
+	    }')
+
+	read R1 R2 VERDICT <<< "$RES"
+	echo "order $N, size=$SIZE : L1 double=$L1_D mixed=$L1_M (rel. diff $R1) ; L2 double=$L2_D mixed=$L2_M (rel. diff $R2) -> $VERDICT"
+
+	if [ "$VERDICT" != "PASSED" ]; then
+	    STATUS=1
+	fi
+
+    done
+done
+
+exit $STATUS
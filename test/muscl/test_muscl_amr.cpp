@@ -0,0 +1,216 @@
+/**
+ * This executable checks the block-structured AMR mode of the MUSCL
+ * hydro solver ([amr] section) :
+ * - on a periodic blast, total mass is conserved (to round-off) while
+ *   leaves are refined / coarsened and fluxes are corrected at
+ *   coarse / fine faces,
+ * - with level_max=0 (root blocks only), results are identical to the
+ *   uniform grid solver.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <iostream>
+
+#include "shared/real_type.h"
+#include "shared/kokkos_shared.h"
+#include "shared/HydroParams.h"
+
+#include "muscl/SolverHydroMuscl.h"
+
+#ifdef USE_MPI
+#include "utils/mpiUtils/GlobalMpiSession.h"
+#include <mpi.h>
+#endif // USE_MPI
+
+using namespace ppkMHD;
+
+/*
+ * Total mass of the current state (AMR leaves are projected on the base
+ * grid by current_state, which preserves cell averages).
+ */
+template<int dim>
+double total_mass(muscl::SolverHydroMuscl<dim>& solver)
+{
+
+  const HydroParams& params = solver.params;
+  const int gw = params.ghostWidth;
+
+  auto U = solver.current_state();
+  auto Uhost = Kokkos::create_mirror_view(U);
+  Kokkos::deep_copy(Uhost, U);
+
+  double mass = 0;
+  if (dim == 2) {
+    for (int j=gw; j<params.jsize-gw; ++j)
+      for (int i=gw; i<params.isize-gw; ++i)
+	mass += Uhost(i,j,ID);
+    mass *= params.dx*params.dy;
+  } else {
+    for (int k=gw; k<params.ksize-gw; ++k)
+      for (int j=gw; j<params.jsize-gw; ++j)
+	for (int i=gw; i<params.isize-gw; ++i)
+	  mass += Uhost(i,j,k,ID);
+    mass *= params.dx*params.dy*params.dz;
+  }
+
+#ifdef USE_MPI
+  MPI_Allreduce(MPI_IN_PLACE, &mass, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+#endif // USE_MPI
+
+  return mass;
+
+} // total_mass
+
+/*
+ * Periodic blast with regrid and flux correction : mass must be
+ * conserved, and the forest must actually be refined.
+ */
+template<int dim>
+int test_mass_conservation(int myRank)
+{
+
+  ConfigMap configMap(dim == 2 ? "test_muscl_amr_2D.ini" : "test_muscl_amr_3D.ini");
+
+  HydroParams params;
+  params.setup(configMap);
+
+  muscl::SolverHydroMuscl<dim> solver(params, configMap);
+
+  const int nbRoots = dim == 2 ?
+    (params.nx/solver.m_amr->block_size()) * (params.ny/solver.m_amr->block_size()) :
+    (params.nx/solver.m_amr->block_size()) * (params.ny/solver.m_amr->block_size()) *
+    (params.nz/solver.m_amr->block_size());
+
+  const double mass0 = total_mass(solver);
+
+  double errMax = 0;
+  int nbLeavesMax = solver.m_amr->size();
+  int nbRegrids = 0;
+
+  while ( !solver.finished() ) {
+
+    const int nbLeaves = solver.m_amr->size();
+
+    solver.next_iteration();
+
+    if (solver.m_amr->size() != nbLeaves)
+      ++nbRegrids;
+    nbLeavesMax = std::max(nbLeavesMax, solver.m_amr->size());
+
+    errMax = std::max(errMax, fabs(total_mass(solver) - mass0) / mass0);
+
+  }
+
+  if (myRank==0)
+    printf("dim=%d : %d roots, up to %d leaves, %d regrids, max relative mass error %g\n",
+	   dim, nbRoots, nbLeavesMax, nbRegrids, errMax);
+
+  int status = 0;
+
+  if (nbLeavesMax <= nbRoots or nbRegrids == 0) {
+    if (myRank==0)
+      printf("  forest was not regridded\n");
+    status = 1;
+  }
+
+  if (errMax > 1e-12) {
+    if (myRank==0)
+      printf("  mass is not conserved\n");
+    status = 1;
+  }
+
+  return status;
+
+} // test_mass_conservation
+
+/*
+ * level_max=0 : same results as the uniform grid solver.
+ */
+template<int dim>
+int test_uniform(int myRank)
+{
+
+  ConfigMap configMap(dim == 2 ? "test_muscl_amr_2D.ini" : "test_muscl_amr_3D.ini");
+  configMap.setInteger("amr", "level_max", 0);
+
+  HydroParams params;
+  params.setup(configMap);
+  muscl::SolverHydroMuscl<dim> solverAmr(params, configMap);
+  while ( !solverAmr.finished() )
+    solverAmr.next_iteration();
+
+  configMap.setBool("amr", "enabled", false);
+
+  HydroParams paramsRef;
+  paramsRef.setup(configMap);
+  muscl::SolverHydroMuscl<dim> solverRef(paramsRef, configMap);
+  while ( !solverRef.finished() )
+    solverRef.next_iteration();
+
+  auto Uamr = solverAmr.current_state();
+  auto Uref = solverRef.current_state();
+  auto Uamr_host = Kokkos::create_mirror_view(Uamr);
+  auto Uref_host = Kokkos::create_mirror_view(Uref);
+  Kokkos::deep_copy(Uamr_host, Uamr);
+  Kokkos::deep_copy(Uref_host, Uref);
+
+  const int gw = params.ghostWidth;
+
+  double diff = 0;
+  if (dim == 2) {
+    for (int j=gw; j<params.jsize-gw; ++j)
+      for (int i=gw; i<params.isize-gw; ++i)
+	for (int iVar=0; iVar<params.nbvar; ++iVar)
+	  diff = fmax(diff, fabs(Uamr_host(i,j,iVar) - Uref_host(i,j,iVar)));
+  } else {
+    for (int k=gw; k<params.ksize-gw; ++k)
+      for (int j=gw; j<params.jsize-gw; ++j)
+	for (int i=gw; i<params.isize-gw; ++i)
+	  for (int iVar=0; iVar<params.nbvar; ++iVar)
+	    diff = fmax(diff, fabs(Uamr_host(i,j,k,iVar) - Uref_host(i,j,k,iVar)));
+  }
+
+#ifdef USE_MPI
+  MPI_Allreduce(MPI_IN_PLACE, &diff, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+#endif // USE_MPI
+
+  if (myRank==0)
+    printf("dim=%d : level_max=0 vs uniform grid, max difference %g (t=%g / %g)\n",
+	   dim, diff, solverAmr.m_t, solverRef.m_t);
+
+  return diff == 0 and solverAmr.m_t == solverRef.m_t ? 0 : 1;
+
+} // test_uniform
+
+/*************************************************/
+/*************************************************/
+/*************************************************/
+int main(int argc, char* argv[])
+{
+
+  // Create MPI session if MPI enabled
+#ifdef USE_MPI
+  hydroSimu::GlobalMpiSession mpiSession(&argc,&argv);
+#endif // USE_MPI
+
+  Kokkos::initialize(argc, argv);
+
+  int myRank = 0;
+#ifdef USE_MPI
+  MPI_Comm_rank(MPI_COMM_WORLD, &myRank);
+#endif // USE_MPI
+
+  int status = 0;
+
+  status += test_mass_conservation<2>(myRank);
+  status += test_mass_conservation<3>(myRank);
+  status += test_uniform<2>(myRank);
+  status += test_uniform<3>(myRank);
+
+  Kokkos::finalize();
+
+  return status;
+
+}
@@ -0,0 +1,210 @@
+/**
+ * This executable checks local time stepping in the block-structured
+ * AMR mode of the MUSCL hydro solver ([amr] time_levels) :
+ * - with time_levels > 1, on a periodic blast, total mass and total
+ *   energy are conserved (to round-off) while leaves of different time
+ *   levels exchange fluxes,
+ * - with time_levels = 1, results are those of the solver before local
+ *   time stepping was introduced (single global time step).
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <iostream>
+
+#include "shared/real_type.h"
+#include "shared/kokkos_shared.h"
+#include "shared/HydroParams.h"
+
+#include "muscl/SolverHydroMuscl.h"
+
+#ifdef USE_MPI
+#include "utils/mpiUtils/GlobalMpiSession.h"
+#include <mpi.h>
+#endif // USE_MPI
+
+using namespace ppkMHD;
+
+/*
+ * Totals of density and energy of the current state (AMR leaves are
+ * projected on the base grid by current_state, which preserves cell
+ * averages).
+ */
+template<int dim>
+void totals(muscl::SolverHydroMuscl<dim>& solver, double& mass, double& energy)
+{
+
+  const HydroParams& params = solver.params;
+  const int gw = params.ghostWidth;
+
+  auto U = solver.current_state();
+  auto Uhost = Kokkos::create_mirror_view(U);
+  Kokkos::deep_copy(Uhost, U);
+
+  double sum[2] = {0, 0};
+  if (dim == 2) {
+    for (int j=gw; j<params.jsize-gw; ++j)
+      for (int i=gw; i<params.isize-gw; ++i) {
+	sum[0] += Uhost(i,j,ID);
+	sum[1] += Uhost(i,j,IE);
+      }
+  } else {
+    for (int k=gw; k<params.ksize-gw; ++k)
+      for (int j=gw; j<params.jsize-gw; ++j)
+	for (int i=gw; i<params.isize-gw; ++i) {
+	  sum[0] += Uhost(i,j,k,ID);
+	  sum[1] += Uhost(i,j,k,IE);
+	}
+  }
+
+#ifdef USE_MPI
+  MPI_Allreduce(MPI_IN_PLACE, sum, 2, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+#endif // USE_MPI
+
+  const double dv = dim == 2 ?
+    params.dx*params.dy :
+    params.dx*params.dy*params.dz;
+
+  mass   = sum[0]*dv;
+  energy = sum[1]*dv;
+
+} // totals
+
+/*
+ * time_levels > 1 : mass and energy must be conserved, and leaves must
+ * actually use several time levels.
+ */
+template<int dim>
+int test_conservation(int myRank)
+{
+
+  ConfigMap configMap(dim == 2 ? "test_muscl_amr_2D.ini" : "test_muscl_amr_3D.ini");
+  configMap.setInteger("amr", "time_levels", 3);
+
+  HydroParams params;
+  params.setup(configMap);
+
+  muscl::SolverHydroMuscl<dim> solver(params, configMap);
+
+  double mass0, energy0;
+  totals(solver, mass0, energy0);
+
+  double errMass = 0, errEnergy = 0;
+  int tlevelMax = 0;
+
+  while ( !solver.finished() ) {
+
+    solver.next_iteration();
+
+    for (int l=0; l<solver.m_amr->size(); ++l)
+      tlevelMax = std::max(tlevelMax, (*solver.m_amr)[l].tlevel);
+
+    double mass, energy;
+    totals(solver, mass, energy);
+    errMass   = std::max(errMass,   fabs(mass   - mass0)   / mass0);
+    errEnergy = std::max(errEnergy, fabs(energy - energy0) / energy0);
+
+  }
+
+#ifdef USE_MPI
+  MPI_Allreduce(MPI_IN_PLACE, &tlevelMax, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
+#endif // USE_MPI
+
+  if (myRank==0)
+    printf("dim=%d : time_levels=3, finest time level used %d, max relative error mass %g energy %g\n",
+	   dim, tlevelMax, errMass, errEnergy);
+
+  int status = 0;
+
+  if (tlevelMax == 0) {
+    if (myRank==0)
+      printf("  local time stepping was not used\n");
+    status = 1;
+  }
+
+  if (errMass > 1e-12 or errEnergy > 1e-12) {
+    if (myRank==0)
+      printf("  mass or energy is not conserved\n");
+    status = 1;
+  }
+
+  return status;
+
+} // test_conservation
+
+/*
+ * time_levels = 1 : same results as before local time stepping. The
+ * reference values were obtained with the AMR solver using a single
+ * global time step, on the same configuration.
+ */
+template<int dim>
+int test_single_time_level(int myRank)
+{
+
+  ConfigMap configMap(dim == 2 ? "test_muscl_amr_2D.ini" : "test_muscl_amr_3D.ini");
+  configMap.setInteger("amr", "time_levels", 1);
+
+  HydroParams params;
+  params.setup(configMap);
+
+  muscl::SolverHydroMuscl<dim> solver(params, configMap);
+  while ( !solver.finished() )
+    solver.next_iteration();
+
+  double mass, energy;
+  totals(solver, mass, energy);
+
+  const double dv = dim == 2 ?
+    params.dx*params.dy :
+    params.dx*params.dy*params.dz;
+
+  // totals of ID and IE (sum over cells) and final time
+  const double massRef   = dim == 2 ? 1214.3000453710547  : 4903.2001924514825;
+  const double energyRef = dim == 2 ? 2050.3751257564913  : 2509.0001645833236;
+  const double tRef      = dim == 2 ? 0.0084226453071664913 : 0.012219946779509171;
+
+  const double err = std::max(fabs(mass/dv   - massRef)   / massRef,
+			      fabs(energy/dv - energyRef) / energyRef);
+  const double errT = fabs(solver.m_t - tRef) / tRef;
+
+  if (myRank==0)
+    printf("dim=%d : time_levels=1 vs single time step, relative difference %g (t=%.17g / %.17g)\n",
+	   dim, err, solver.m_t, tRef);
+
+  // tolerance only allows for a different floating point contraction
+  // of the compiler
+  return err < 1e-10 and errT < 1e-10 ? 0 : 1;
+
+} // test_single_time_level
+
+/*************************************************/
+/*************************************************/
+/*************************************************/
+int main(int argc, char* argv[])
+{
+
+  // Create MPI session if MPI enabled
+#ifdef USE_MPI
+  hydroSimu::GlobalMpiSession mpiSession(&argc,&argv);
+#endif // USE_MPI
+
+  Kokkos::initialize(argc, argv);
+
+  int myRank = 0;
+#ifdef USE_MPI
+  MPI_Comm_rank(MPI_COMM_WORLD, &myRank);
+#endif // USE_MPI
+
+  int status = 0;
+
+  status += test_conservation<2>(myRank);
+  status += test_conservation<3>(myRank);
+  status += test_single_time_level<2>(myRank);
+  status += test_single_time_level<3>(myRank);
+
+  Kokkos::finalize();
+
+  return status;
+
+}
@@ -0,0 +1,254 @@
+/**
+ * This executable checks that the settings chosen by the autotuner
+ * ([autotune] enabled=true, see shared/Autotuner.h) leave the results
+ * of the MUSCL solvers unchanged, for hydro (with and without AMR) and
+ * MHD, in 2D and 3D : the tuned run (and, for hydro, the run with the
+ * other implementation variant) must give the same state as the run
+ * with the settings of the parameter file, and variants which a solver
+ * does not implement must not be chosen.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "shared/real_type.h"
+#include "shared/kokkos_shared.h"
+#include "shared/HydroParams.h"
+#include "shared/Autotuner.h"
+
+#include "muscl/SolverHydroMuscl.h"
+#include "muscl/SolverMHDMuscl.h"
+
+#ifdef USE_MPI
+#include "utils/mpiUtils/GlobalMpiSession.h"
+#include <mpi.h>
+#endif // USE_MPI
+
+using namespace ppkMHD;
+
+static const char* cache_file = "test_muscl_autotune.cache";
+
+/**
+ * Generate a test parameter file (periodic blast).
+ */
+void generate_input_file(const std::string& solver_name, bool amr)
+{
+
+  const bool threeD = solver_name.find("3D") != std::string::npos;
+  const int n = threeD ? 16 : 32;
+
+  std::fstream outFile;
+  outFile.open ("test_muscl_autotune.ini", std::ios_base::out);
+
+  outFile << "[run]\n";
+  outFile << "solver_name=" << solver_name << "\n";
+  outFile << "tEnd=1.0\n";
+  outFile << "nStepmax=10\n";
+  outFile << "nOutput=0\n";
+  outFile << "nlog=100\n";
+  outFile << "\n";
+
+  outFile << "[mesh]\n";
+  outFile << "nx=" << n << "\n";
+  outFile << "ny=" << n << "\n";
+  outFile << "nz=" << (threeD ? n : 1) << "\n";
+  outFile << "boundary_type_xmin=3\n";
+  outFile << "boundary_type_xmax=3\n";
+  outFile << "boundary_type_ymin=3\n";
+  outFile << "boundary_type_ymax=3\n";
+  outFile << "boundary_type_zmin=3\n";
+  outFile << "boundary_type_zmax=3\n";
+  outFile << "\n";
+
+  outFile << "[hydro]\n";
+  outFile << "gamma0=1.4\n";
+  outFile << "cfl=0.5\n";
+  outFile << "niter_riemann=10\n";
+  outFile << "iorder=2\n";
+  outFile << "slope_type=2\n";
+  outFile << "problem=blast\n";
+  outFile << "riemann=hllc\n";
+  outFile << "\n";
+
+  outFile << "[blast]\n";
+  outFile << "radius=0.15\n";
+  outFile << "\n";
+
+  if (amr) {
+    outFile << "[amr]\n";
+    outFile << "enabled=true\n";
+    outFile << "block_size=8\n";
+    outFile << "level_max=1\n";
+    outFile << "\n";
+  }
+
+  outFile << "[autotune]\n";
+  outFile << "enabled=true\n";
+  outFile << "cache_file=" << cache_file << "\n";
+  outFile << "steps=2\n";
+  outFile << "\n";
+
+  outFile << "[output]\n";
+  outFile << "outputDir=./\n";
+  outFile << "outputPrefix=test_muscl_autotune\n";
+  outFile << "outputVtkEnabled=false\n";
+  outFile << "\n";
+
+  outFile.close();
+
+} // generate_input_file
+
+// state after the last time step
+template<int dim>
+typename muscl::SolverHydroMuscl<dim>::DataArray
+final_state(muscl::SolverHydroMuscl<dim>& solver)
+{
+  return solver.current_state();
+}
+
+template<int dim>
+typename muscl::SolverMHDMuscl<dim>::DataArray
+final_state(muscl::SolverMHDMuscl<dim>& solver)
+{
+  return solver.m_iteration % 2 == 0 ? solver.U : solver.U2;
+}
+
+/*
+ * Run to the end with the given settings, return the state on host.
+ */
+template<class Solver>
+typename Solver::DataArray::HostMirror run(ConfigMap& configMap)
+{
+
+  HydroParams params;
+  params.setup(configMap);
+
+  Solver solver(params, configMap);
+  while ( !solver.finished() )
+    solver.next_iteration();
+
+  auto U = final_state(solver);
+  typename Solver::DataArray::HostMirror Uhost = Kokkos::create_mirror(U);
+  Kokkos::deep_copy(Uhost, U);
+
+  return Uhost;
+
+} // run
+
+/*
+ * max difference relative to the max of the reference (over all MPI
+ * processes)
+ */
+template<class HostArray>
+double relative_difference(const HostArray& U, const HostArray& Uref)
+{
+
+  double diff = 0, norm = 0;
+  for (size_t idx=0; idx<Uref.span(); ++idx) {
+    diff = fmax(diff, fabs(U.data()[idx] - Uref.data()[idx]));
+    norm = fmax(norm, fabs(Uref.data()[idx]));
+  }
+
+#ifdef USE_MPI
+  MPI_Allreduce(MPI_IN_PLACE, &diff, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+  MPI_Allreduce(MPI_IN_PLACE, &norm, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+#endif // USE_MPI
+
+  return diff/norm;
+
+} // relative_difference
+
+/*
+ * Autotune, then compare the tuned run with the reference run.
+ */
+template<class Solver>
+int test_autotune(const std::string& solver_name, bool amr, int myRank)
+{
+
+  generate_input_file(solver_name, amr);
+
+  // time candidates, do not read a previous choice
+  if (myRank==0)
+    remove(cache_file);
+
+  ConfigMap configMap("test_muscl_autotune.ini");
+  ConfigMap configTuned(configMap);
+
+  Autotuner autotuner(configTuned);
+  autotuner.apply();
+
+  const int version = configTuned.getInteger("OTHER", "implementationVersion", 0);
+
+  auto Uref   = run<Solver>(configMap);
+  auto Utuned = run<Solver>(configTuned);
+
+  double diff = relative_difference(Utuned, Uref);
+
+  // the tuned choice depends on timings : check the other candidate
+  // implementations of the hydro solver as well
+  const bool hydro = solver_name.find("Hydro") == 0;
+  if (hydro and !amr) {
+    ConfigMap configOther(configMap);
+    configOther.setInteger("OTHER", "implementationVersion", 1-version);
+    diff = fmax(diff, relative_difference(run<Solver>(configOther), Uref));
+  }
+
+  if (myRank==0)
+    printf("%s%s : tuned implementationVersion=%d, max relative difference %g\n",
+	   solver_name.c_str(), amr ? " (AMR)" : "", version, diff);
+
+  int status = 0;
+
+  // the MHD solver and AMR only implement version 0
+  if ((!hydro or amr) and version != 0) {
+    if (myRank==0)
+      printf("  unsupported implementationVersion chosen\n");
+    status = 1;
+  }
+
+  // implementation variants of the same scheme only differ by round-off
+  if (diff > 1e-12) {
+    if (myRank==0)
+      printf("  tuned results differ\n");
+    status = 1;
+  }
+
+  return status;
+
+} // test_autotune
+
+/*************************************************/
+/*************************************************/
+/*************************************************/
+int main(int argc, char* argv[])
+{
+
+  // Create MPI session if MPI enabled
+#ifdef USE_MPI
+  hydroSimu::GlobalMpiSession mpiSession(&argc,&argv);
+#endif // USE_MPI
+
+  Kokkos::initialize(argc, argv);
+
+  int myRank = 0;
+#ifdef USE_MPI
+  MPI_Comm_rank(MPI_COMM_WORLD, &myRank);
+#endif // USE_MPI
+
+  int status = 0;
+
+  status += test_autotune<muscl::SolverHydroMuscl<2> >("Hydro_Muscl_2D", false, myRank);
+  status += test_autotune<muscl::SolverHydroMuscl<3> >("Hydro_Muscl_3D", false, myRank);
+  status += test_autotune<muscl::SolverHydroMuscl<2> >("Hydro_Muscl_2D", true,  myRank);
+  status += test_autotune<muscl::SolverMHDMuscl<2> >  ("MHD_Muscl_2D",   false, myRank);
+  status += test_autotune<muscl::SolverMHDMuscl<3> >  ("MHD_Muscl_3D",   false, myRank);
+
+  Kokkos::finalize();
+
+  return status;
+
+}
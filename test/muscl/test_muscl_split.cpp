@@ -0,0 +1,406 @@
+/**
+ * This executable checks the directionally split sweeps of the hydro
+ * MUSCL solver (implementationVersion=2) on a periodic Sod tube (two
+ * Sod problems back to back) aligned with X, Y or Z, in 2D and 3D :
+ * - mass, momentum and energy are conserved (to round-off),
+ * - the solution is the same whatever the tube direction, i.e. the
+ *   position of its sweep in the X, Y(, Z) / reverse ordering, and
+ *   stays uniform across the tube,
+ * - over-decomposition (blocks_per_rank > 1) and temporal blocking
+ *   (temporal_blocking_steps > 1) give the same results as plain
+ *   stepping with the same sequence of time steps.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include "shared/real_type.h"
+#include "shared/kokkos_shared.h"
+#include "shared/HydroParams.h"
+
+#include "muscl/SolverHydroMuscl.h"
+
+#ifdef USE_MPI
+#include "utils/mpiUtils/GlobalMpiSession.h"
+#include <mpi.h>
+#endif // USE_MPI
+
+using namespace ppkMHD;
+
+/**
+ * Plain stepping, with a given sequence of time steps (if not empty).
+ */
+template<int dim>
+class SolverReplayDt : public muscl::SolverHydroMuscl<dim>
+{
+
+public:
+
+  SolverReplayDt(HydroParams& params, ConfigMap& configMap,
+		 const std::vector<real_t>& dts) :
+    muscl::SolverHydroMuscl<dim>(params, configMap),
+    dts(dts)
+  {}
+
+  virtual void compute_dt()
+  {
+    if (dts.empty())
+      muscl::SolverHydroMuscl<dim>::compute_dt();
+    else
+      this->m_dt = dts[this->m_iteration];
+  }
+
+  std::vector<real_t> dts;
+
+}; // class SolverReplayDt
+
+// global number of cells along dir
+int global_size(const HydroParams& params, int dir)
+{
+#ifdef USE_MPI
+  return params.nGlobal[dir];
+#else
+  return dir == IX ? params.nx : (dir == IY ? params.ny : params.nz);
+#endif // USE_MPI
+}
+
+/*
+ * Replace the initial state by a periodic Sod tube along dir : high
+ * pressure state in [0.25,0.75[, low pressure state elsewhere.
+ */
+template<int dim>
+void init_sod(muscl::SolverHydroMuscl<dim>& solver, int dir)
+{
+
+  const HydroParams& params = solver.params;
+  const int gw = params.ghostWidth;
+  const real_t gamma0 = params.settings.gamma0;
+
+  const double xmin[3] = {params.xmin, params.ymin, params.zmin};
+  const double dx[3]   = {params.dx, params.dy, params.dz};
+
+  auto Uhost = Kokkos::create_mirror_view(solver.U);
+
+  const int ksize = dim == 2 ? 1 : params.ksize;
+
+  for (int k=0; k<ksize; ++k)
+    for (int j=0; j<params.jsize; ++j)
+      for (int i=0; i<params.isize; ++i) {
+
+	const int ijk[3] = {i, j, k};
+	const double x = xmin[dir] + (ijk[dir] - gw + params.myOffset[dir] + 0.5)*dx[dir];
+	const bool left = x >= 0.25 and x < 0.75;
+
+	const real_t rho = left ? 1.0 : 0.125;
+	const real_t p   = left ? 1.0 : 0.1;
+
+	real_t u[5] = {rho, p/(gamma0-1), 0, 0, 0};
+
+	for (int iVar=0; iVar<params.nbvar; ++iVar) {
+	  if (dim == 2)
+	    Uhost(i,j,iVar) = u[iVar];
+	  else
+	    Uhost(i,j,k,iVar) = u[iVar];
+	}
+
+      }
+
+  Kokkos::deep_copy(solver.U, Uhost);
+
+  if (solver.m_blocks)
+    solver.m_blocks->scatter(solver.U, 0);
+
+} // init_sod
+
+/*
+ * Totals of the conservative variables (normal momentum along dir
+ * first), profile along the tube (density, energy, normal momentum,
+ * transverse momentum) and largest deviation from it across the tube.
+ */
+template<int dim>
+void analyse(muscl::SolverHydroMuscl<dim>& solver, int dir,
+	     double totals[3], std::vector<double>& profile, double& deviation)
+{
+
+  const HydroParams& params = solver.params;
+  const int gw = params.ghostWidth;
+  const int n  = global_size(params, dir);
+
+  const int iNormal = dir == IX ? IU : (dir == IY ? IV : IW);
+  const int iTrans0 = dir == IX ? IV : IU;
+  const int iTrans1 = dir == IZ ? IV : IW;
+
+  auto U = solver.current_state();
+  auto Uhost = Kokkos::create_mirror_view(U);
+  Kokkos::deep_copy(Uhost, U);
+
+  const int kmin = dim == 2 ? 0 : gw;
+  const int kmax = dim == 2 ? 1 : params.ksize-gw;
+
+  auto cell = [&](int i, int j, int k, double v[4]) {
+    v[0] = dim == 2 ? Uhost(i,j,ID)      : Uhost(i,j,k,ID);
+    v[1] = dim == 2 ? Uhost(i,j,IP)      : Uhost(i,j,k,IP);
+    v[2] = dim == 2 ? Uhost(i,j,iNormal) : Uhost(i,j,k,iNormal);
+    v[3] = dim == 2 ? fabs(Uhost(i,j,iTrans0)) :
+      fmax(fabs(Uhost(i,j,k,iTrans0)), fabs(Uhost(i,j,k,iTrans1)));
+  };
+
+  // profile : cells of the first row (plane) across the tube
+  profile.assign(4*n, 0.0);
+  for (int k=kmin; k<kmax; ++k)
+    for (int j=gw; j<params.jsize-gw; ++j)
+      for (int i=gw; i<params.isize-gw; ++i) {
+	const int ijk[3] = {i, j, k};
+	bool first = true;
+	for (int d=0; d<dim; ++d)
+	  if (d != dir and ijk[d]-gw+params.myOffset[d] != 0)
+	    first = false;
+	if (first)
+	  cell(i, j, k, &profile[4*(ijk[dir]-gw+params.myOffset[dir])]);
+      }
+
+#ifdef USE_MPI
+  MPI_Allreduce(MPI_IN_PLACE, profile.data(), 4*n, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+#endif // USE_MPI
+
+  totals[0] = totals[1] = totals[2] = 0;
+  deviation = 0;
+  for (int k=kmin; k<kmax; ++k)
+    for (int j=gw; j<params.jsize-gw; ++j)
+      for (int i=gw; i<params.isize-gw; ++i) {
+	const int ijk[3] = {i, j, k};
+	const int c = ijk[dir]-gw+params.myOffset[dir];
+	double v[4];
+	cell(i, j, k, v);
+	totals[0] += v[0];
+	totals[1] += v[1];
+	totals[2] += v[2];
+	for (int iVar=0; iVar<4; ++iVar)
+	  deviation = fmax(deviation, fabs(v[iVar] - profile[4*c+iVar]));
+      }
+
+  const double dV = dim == 2 ? params.dx*params.dy : params.dx*params.dy*params.dz;
+  for (int iVar=0; iVar<3; ++iVar)
+    totals[iVar] *= dV;
+
+#ifdef USE_MPI
+  MPI_Allreduce(MPI_IN_PLACE, totals, 3, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+  MPI_Allreduce(MPI_IN_PLACE, &deviation, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+#endif // USE_MPI
+
+} // analyse
+
+// largest difference between the interior cells of two states
+template<int dim>
+double difference(muscl::SolverHydroMuscl<dim>& solver,
+		  muscl::SolverHydroMuscl<dim>& solverRef)
+{
+
+  const HydroParams& params = solver.params;
+  const int gw = params.ghostWidth;
+
+  auto U    = solver.current_state();
+  auto Uref = solverRef.current_state();
+  auto U_host    = Kokkos::create_mirror_view(U);
+  auto Uref_host = Kokkos::create_mirror_view(Uref);
+  Kokkos::deep_copy(U_host, U);
+  Kokkos::deep_copy(Uref_host, Uref);
+
+  double diff = 0;
+  if (dim == 2) {
+    for (int j=gw; j<params.jsize-gw; ++j)
+      for (int i=gw; i<params.isize-gw; ++i)
+	for (int iVar=0; iVar<params.nbvar; ++iVar)
+	  diff = fmax(diff, fabs(U_host(i,j,iVar) - Uref_host(i,j,iVar)));
+  } else {
+    for (int k=gw; k<params.ksize-gw; ++k)
+      for (int j=gw; j<params.jsize-gw; ++j)
+	for (int i=gw; i<params.isize-gw; ++i)
+	  for (int iVar=0; iVar<params.nbvar; ++iVar)
+	    diff = fmax(diff, fabs(U_host(i,j,k,iVar) - Uref_host(i,j,k,iVar)));
+  }
+
+#ifdef USE_MPI
+  MPI_Allreduce(MPI_IN_PLACE, &diff, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+#endif // USE_MPI
+
+  return diff;
+
+} // difference
+
+/*
+ * Sod tube along each direction : conservation, uniformity across the
+ * tube and same profile for all directions.
+ */
+template<int dim>
+int test_sweeps(int myRank)
+{
+
+  ConfigMap configMap(dim == 2 ? "test_muscl_split_2D.ini" : "test_muscl_split_3D.ini");
+
+  int status = 0;
+
+  std::vector<double> profileX;
+
+  for (int dir=0; dir<dim; ++dir) {
+
+    HydroParams params;
+    params.setup(configMap);
+    muscl::SolverHydroMuscl<dim> solver(params, configMap);
+    init_sod(solver, dir);
+
+    double totals0[3], totals[3], deviation;
+    std::vector<double> profile0, profile;
+    analyse(solver, dir, totals0, profile0, deviation);
+
+    while ( !solver.finished() )
+      solver.next_iteration();
+
+    analyse(solver, dir, totals, profile, deviation);
+
+    // relative conservation errors, momentum relative to mass (sound
+    // speed of order 1)
+    const double errMass     = fabs(totals[0] - totals0[0]) / totals0[0];
+    const double errEnergy   = fabs(totals[1] - totals0[1]) / totals0[1];
+    const double errMomentum = fabs(totals[2] - totals0[2]) / totals0[0];
+
+    // the tube has evolved
+    double change = 0;
+    for (size_t c=0; c<profile.size(); ++c)
+      change = fmax(change, fabs(profile[c] - profile0[c]));
+
+    if (dir == IX)
+      profileX = profile;
+
+    double symmetry = 0;
+    for (size_t c=0; c<profile.size(); ++c)
+      symmetry = fmax(symmetry, fabs(profile[c] - profileX[c]));
+
+    if (myRank==0)
+      printf("dim=%d Sod tube along %c : %d steps (t=%g), max change %g, "
+	     "relative errors mass %g momentum %g energy %g, "
+	     "deviation across the tube %g, difference with X %g\n",
+	     dim, "XYZ"[dir], solver.m_iteration, solver.m_t, change,
+	     errMass, errMomentum, errEnergy, deviation, symmetry);
+
+    if (change < 0.1) {
+      if (myRank==0)
+	printf("  the solution did not evolve\n");
+      status = 1;
+    }
+
+    if (errMass > 1e-12 or errMomentum > 1e-12 or errEnergy > 1e-12) {
+      if (myRank==0)
+	printf("  mass / momentum / energy are not conserved\n");
+      status = 1;
+    }
+
+    if (deviation > 1e-12 or symmetry > 1e-12) {
+      if (myRank==0)
+	printf("  solution depends on the sweep ordering\n");
+      status = 1;
+    }
+
+  }
+
+  return status;
+
+} // test_sweeps
+
+/*
+ * Temporal blocking, then plain stepping and over-decomposition with
+ * the same time steps (Sod tube along the direction cut into tiles).
+ */
+template<int dim>
+int test_blocking(int myRank)
+{
+
+  ConfigMap configMap(dim == 2 ? "test_muscl_split_2D.ini" : "test_muscl_split_3D.ini");
+  const int dir = dim-1;
+
+  std::vector<real_t> dts;
+
+  configMap.setInteger("run", "temporal_blocking_steps", 4);
+  HydroParams paramsTB;
+  paramsTB.setup(configMap);
+  muscl::SolverHydroMuscl<dim> solverTB(paramsTB, configMap);
+  init_sod(solverTB, dir);
+  while ( !solverTB.finished() ) {
+    solverTB.next_iteration();
+    dts.push_back(solverTB.m_dt);
+  }
+
+  configMap.setInteger("run", "temporal_blocking_steps", 1);
+  HydroParams paramsRef;
+  paramsRef.setup(configMap);
+  SolverReplayDt<dim> solverRef(paramsRef, configMap, dts);
+  init_sod(solverRef, dir);
+  while ( !solverRef.finished() )
+    solverRef.next_iteration();
+
+  configMap.setInteger("run", "blocks_per_rank", 4);
+  HydroParams paramsMB;
+  paramsMB.setup(configMap);
+  SolverReplayDt<dim> solverMB(paramsMB, configMap, dts);
+  init_sod(solverMB, dir);
+  while ( !solverMB.finished() )
+    solverMB.next_iteration();
+
+  const double diffTB = difference(solverTB, solverRef);
+  const double diffMB = difference(solverMB, solverRef);
+
+  if (myRank==0)
+    printf("dim=%d : %d steps, max difference with plain stepping : "
+	   "temporal blocking %g (%s, t=%g), blocks_per_rank %g (%s, t=%g), plain t=%g\n",
+	   dim, solverRef.m_iteration,
+	   diffTB, solverTB.m_tiles ? "enabled" : "disabled", solverTB.m_t,
+	   diffMB, solverMB.m_blocks ? "enabled" : "disabled", solverMB.m_t,
+	   solverRef.m_t);
+
+  int status = 0;
+
+  if (diffTB != 0 or solverTB.m_t != solverRef.m_t or
+      diffMB != 0 or solverMB.m_t != solverRef.m_t) {
+    if (myRank==0)
+      printf("  results differ from plain stepping\n");
+    status = 1;
+  }
+
+  return status;
+
+} // test_blocking
+
+/*************************************************/
+/*************************************************/
+/*************************************************/
+int main(int argc, char* argv[])
+{
+
+  // Create MPI session if MPI enabled (temporal blocking is limited to
+  // a single process)
+#ifdef USE_MPI
+  hydroSimu::GlobalMpiSession mpiSession(&argc,&argv);
+#endif // USE_MPI
+
+  Kokkos::initialize(argc, argv);
+
+  int myRank = 0;
+#ifdef USE_MPI
+  MPI_Comm_rank(MPI_COMM_WORLD, &myRank);
+#endif // USE_MPI
+
+  int status = 0;
+
+  status += test_sweeps<2>(myRank);
+  status += test_sweeps<3>(myRank);
+  status += test_blocking<2>(myRank);
+  status += test_blocking<3>(myRank);
+
+  Kokkos::finalize();
+
+  return status;
+
+}
@@ -0,0 +1,170 @@
+/**
+ * This executable checks temporal blocking of the hydro MUSCL solver
+ * ([run] temporal_blocking_steps > 1) on a periodic blast :
+ * - results are identical to plain stepping (temporal_blocking_steps=1)
+ *   with the same sequence of time steps,
+ * - the CFL condition holds at the end of every block of several
+ *   steps, also when the time step is not reduced
+ *   (temporal_blocking_dt_factor=1) and blocks have to be computed
+ *   again.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include "shared/real_type.h"
+#include "shared/kokkos_shared.h"
+#include "shared/HydroParams.h"
+
+#include "muscl/SolverHydroMuscl.h"
+
+#ifdef USE_MPI
+#include "utils/mpiUtils/GlobalMpiSession.h"
+#endif // USE_MPI
+
+using namespace ppkMHD;
+
+/**
+ * Plain stepping with a given sequence of time steps.
+ */
+template<int dim>
+class SolverReplayDt : public muscl::SolverHydroMuscl<dim>
+{
+
+public:
+
+  SolverReplayDt(HydroParams& params, ConfigMap& configMap,
+		 const std::vector<real_t>& dts) :
+    muscl::SolverHydroMuscl<dim>(params, configMap),
+    dts(dts)
+  {}
+
+  virtual void compute_dt()
+  {
+    this->m_dt = dts[this->m_iteration];
+  }
+
+  std::vector<real_t> dts;
+
+}; // class SolverReplayDt
+
+/*
+ * Temporal blocking with the given time step factor, then plain
+ * stepping with the same time steps.
+ */
+template<int dim>
+int test_temporal_blocking(real_t dt_factor)
+{
+
+  ConfigMap configMap(dim == 2 ?
+		      "test_muscl_temporal_blocking_2D.ini" :
+		      "test_muscl_temporal_blocking_3D.ini");
+  configMap.setFloat("run", "temporal_blocking_dt_factor", dt_factor);
+
+  std::vector<real_t> dts;
+  int nbBlocks = 0, nbCflErrors = 0;
+
+  HydroParams params;
+  params.setup(configMap);
+  muscl::SolverHydroMuscl<dim> solver(params, configMap);
+
+  while ( !solver.finished() ) {
+
+    solver.next_iteration();
+    dts.push_back(solver.m_dt);
+
+    // end of a block of several steps : CFL condition of the new state
+    if (solver.m_tiles_left == 0) {
+      ++nbBlocks;
+      if (solver.m_tiles_steps > 1 and solver.compute_dt_local() < solver.m_dt)
+	++nbCflErrors;
+    }
+
+  }
+
+  configMap.setInteger("run", "temporal_blocking_steps", 1);
+
+  HydroParams paramsRef;
+  paramsRef.setup(configMap);
+  SolverReplayDt<dim> solverRef(paramsRef, configMap, dts);
+  while ( !solverRef.finished() )
+    solverRef.next_iteration();
+
+  auto Ublk = solver.current_state();
+  auto Uref = solverRef.current_state();
+  auto Ublk_host = Kokkos::create_mirror_view(Ublk);
+  auto Uref_host = Kokkos::create_mirror_view(Uref);
+  Kokkos::deep_copy(Ublk_host, Ublk);
+  Kokkos::deep_copy(Uref_host, Uref);
+
+  const int gw = params.ghostWidth;
+
+  double diff = 0;
+  if (dim == 2) {
+    for (int j=gw; j<params.jsize-gw; ++j)
+      for (int i=gw; i<params.isize-gw; ++i)
+	for (int iVar=0; iVar<params.nbvar; ++iVar)
+	  diff = fmax(diff, fabs(Ublk_host(i,j,iVar) - Uref_host(i,j,iVar)));
+  } else {
+    for (int k=gw; k<params.ksize-gw; ++k)
+      for (int j=gw; j<params.jsize-gw; ++j)
+	for (int i=gw; i<params.isize-gw; ++i)
+	  for (int iVar=0; iVar<params.nbvar; ++iVar)
+	    diff = fmax(diff, fabs(Ublk_host(i,j,k,iVar) - Uref_host(i,j,k,iVar)));
+  }
+
+  printf("dim=%d dt_factor=%g : %d steps in %d blocks, %d CFL errors, "
+	 "max difference with plain stepping %g (t=%g / %g)\n",
+	 dim, dt_factor, solver.m_iteration, nbBlocks, nbCflErrors,
+	 diff, solver.m_t, solverRef.m_t);
+
+  int status = 0;
+
+  if (nbBlocks == solver.m_iteration) {
+    printf("  no block of several steps\n");
+    status = 1;
+  }
+
+  if (nbCflErrors > 0) {
+    printf("  CFL condition exceeded at the end of a block\n");
+    status = 1;
+  }
+
+  if (diff != 0 or solver.m_t != solverRef.m_t) {
+    printf("  results differ from plain stepping\n");
+    status = 1;
+  }
+
+  return status;
+
+} // test_temporal_blocking
+
+/*************************************************/
+/*************************************************/
+/*************************************************/
+int main(int argc, char* argv[])
+{
+
+  // Create MPI session if MPI enabled (temporal blocking is limited to
+  // a single process)
+#ifdef USE_MPI
+  hydroSimu::GlobalMpiSession mpiSession(&argc,&argv);
+#endif // USE_MPI
+
+  Kokkos::initialize(argc, argv);
+
+  int status = 0;
+
+  status += test_temporal_blocking<2>(0.8);
+  status += test_temporal_blocking<3>(0.8);
+  status += test_temporal_blocking<2>(1.0);
+  status += test_temporal_blocking<3>(1.0);
+
+  Kokkos::finalize();
+
+  return status;
+
+}
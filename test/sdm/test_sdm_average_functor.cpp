@@ -39,10 +39,6 @@
 template< int dim, int N >
 void compute_Uaverage(sdm::SolverHydroSDM<dim,N>& solver) {
       
-  int nbCells = dim==2 ?
-    solver.params.isize * solver.params.jsize :
-    solver.params.isize * solver.params.jsize * solver.params.ksize;
-  
   // compute cell average
   {
     sdm::Average_Conservative_Variables_Functor<dim,N>
@@ -51,7 +47,10 @@ void compute_Uaverage(sdm::SolverHydroSDM<dim,N>& solver) {
 	      solver.U,
 	      solver.Uaverage);
   
-    Kokkos::parallel_for(nbCells, functor);
+    Kokkos::parallel_for(md_policy<dim>(0, 0, 0,
+                                        solver.params.isize, solver.params.jsize, solver.params.ksize,
+                                        solver.params.mdrange_tile),
+                         functor);
   }
 
   // compute x gradient cell-averaged
@@ -60,7 +59,10 @@ void compute_Uaverage(sdm::SolverHydroSDM<dim,N>& solver) {
 						    solver.sdm_geom,
 						    solver.U,
 						    solver.Ugradx);
-    Kokkos::parallel_for(nbCells, functor);
+    Kokkos::parallel_for(md_policy<dim>(0, 0, 0,
+                                        solver.params.isize, solver.params.jsize, solver.params.ksize,
+                                        solver.params.mdrange_tile),
+                         functor);
 
   }
 
@@ -70,7 +72,10 @@ void compute_Uaverage(sdm::SolverHydroSDM<dim,N>& solver) {
 						    solver.sdm_geom,
 						    solver.U,
 						    solver.Ugrady);
-    Kokkos::parallel_for(nbCells, functor);
+    Kokkos::parallel_for(md_policy<dim>(0, 0, 0,
+                                        solver.params.isize, solver.params.jsize, solver.params.ksize,
+                                        solver.params.mdrange_tile),
+                         functor);
 
   }
 
@@ -80,7 +85,10 @@ void compute_Uaverage(sdm::SolverHydroSDM<dim,N>& solver) {
 						    solver.sdm_geom,
 						    solver.U,
 						    solver.Ugradz);
-    Kokkos::parallel_for(nbCells, functor);
+    Kokkos::parallel_for(md_policy<dim>(0, 0, 0,
+                                        solver.params.isize, solver.params.jsize, solver.params.ksize,
+                                        solver.params.mdrange_tile),
+                         functor);
 
   }
 
@@ -77,10 +77,6 @@ void test_flux_functors()
   // SolverFactory's create method)
   solver.init_io();
 
-  int nbCells = dim==2 ?
-    params.isize*params.jsize :
-    params.isize*params.jsize*params.ksize;
-  
   // init data
   {
 
@@ -115,7 +111,10 @@ void test_flux_functors()
 							       solver.sdm_geom,
 							       solver.U,
 							       solver.Fluxes);
-      Kokkos::parallel_for(nbCells, functor);
+      Kokkos::parallel_for(md_policy<dim>(0, 0, 0,
+                                          solver.params.isize, solver.params.jsize, solver.params.ksize,
+                                          solver.params.mdrange_tile),
+                           functor);
       
     }
     
@@ -125,7 +124,10 @@ void test_flux_functors()
 							     solver.sdm_geom,
 							     euler,
 							     solver.Fluxes);
-      Kokkos::parallel_for(nbCells, functor);
+      Kokkos::parallel_for(md_policy<dim>(0, 0, 0,
+                                          solver.params.isize, solver.params.jsize, solver.params.ksize,
+                                          solver.params.mdrange_tile),
+                           functor);
     }
     
     /*
@@ -149,7 +151,10 @@ void test_flux_functors()
 							       solver.sdm_geom,
 							       solver.U,
 							       solver.Fluxes);
-      Kokkos::parallel_for(nbCells, functor);
+      Kokkos::parallel_for(md_policy<dim>(0, 0, 0,
+                                          solver.params.isize, solver.params.jsize, solver.params.ksize,
+                                          solver.params.mdrange_tile),
+                           functor);
       
     }
 
@@ -159,7 +164,10 @@ void test_flux_functors()
 							     solver.sdm_geom,
 							     euler,
 							     solver.Fluxes);
-      Kokkos::parallel_for(nbCells, functor);
+      Kokkos::parallel_for(md_policy<dim>(0, 0, 0,
+                                          solver.params.isize, solver.params.jsize, solver.params.ksize,
+                                          solver.params.mdrange_tile),
+                           functor);
     }
     
     /*
@@ -183,7 +191,10 @@ void test_flux_functors()
 							       solver.sdm_geom,
 							       solver.U,
 							       solver.Fluxes);
-      Kokkos::parallel_for(nbCells, functor);
+      Kokkos::parallel_for(md_policy<dim>(0, 0, 0,
+                                          solver.params.isize, solver.params.jsize, solver.params.ksize,
+                                          solver.params.mdrange_tile),
+                           functor);
       
     }
     
@@ -193,7 +204,10 @@ void test_flux_functors()
 							     solver.sdm_geom,
 							     euler,
 							     solver.Fluxes);
-      Kokkos::parallel_for(nbCells, functor);
+      Kokkos::parallel_for(md_policy<dim>(0, 0, 0,
+                                          solver.params.isize, solver.params.jsize, solver.params.ksize,
+                                          solver.params.mdrange_tile),
+                           functor);
     }
   
     /*
@@ -159,7 +159,10 @@ errors_t compute_error_versus_exact(sdm::SolverHydroSDM<2,N>* solver)
 						  solver->sdm_geom,
 						  iparams,
 						  solver->Uaux);
-    Kokkos::parallel_for(nbCells, functor);
+    Kokkos::parallel_for(md_policy<2>(0, 0, 0,
+                                      solver->params.isize, solver->params.jsize, solver->params.ksize,
+                                      solver->params.mdrange_tile),
+                         functor);
     solver->configMap.setBool("isentropic_vortex","use_tEnd",false);
   }
 
@@ -75,10 +75,6 @@ bool test_lagrange_functor()
   int jsize = params.jsize;
   int ksize = params.ksize;
 
-  int64_t nbCells = dim == 2 ?
-    isize*jsize : 
-    isize*jsize*ksize;
-
   // SDM config
   sdm::SDM_Geometry<dim,N> sdm_geom;
   sdm_geom.init(0);
@@ -144,7 +140,10 @@ bool test_lagrange_functor()
 							     sdm_geom,
 							     U,
 							     Fluxes);
-    Kokkos::parallel_for(nbCells, functor);
+    Kokkos::parallel_for(md_policy<dim>(0, 0, 0,
+                                        params.isize, params.jsize, params.ksize,
+                                        params.mdrange_tile),
+                         functor);
 
     io_writer-> template save_flux<IY>(Fluxes,
 				       FluxHost,
@@ -161,7 +160,10 @@ bool test_lagrange_functor()
 								 sdm_geom,
 								 Fluxes,
 								 U);
-    Kokkos::parallel_for(nbCells, functor);
+    Kokkos::parallel_for(md_policy<dim>(0, 0, 0,
+                                        params.isize, params.jsize, params.ksize,
+                                        params.mdrange_tile),
+                         functor);
   }
 
   // compute L1 error between U and U2
@@ -0,0 +1,248 @@
+/**
+ * This executable checks the p-adaptive SDM solver
+ * (sdm::SolverHydroSDM_PAdaptive) on a periodic Kelvin-Helmholtz flow :
+ * - with all cells of order N (p_adaptive_min_order=N), results are
+ *   identical to the ones of SolverHydroSDM,
+ * - with cells of several orders, total mass and energy are conserved
+ *   (to round-off), fluxes at faces between cells of different orders
+ *   being L2 projections of the common flux.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include "shared/real_type.h"
+#include "shared/kokkos_shared.h"
+#include "shared/HydroParams.h"
+
+#include "sdm/SolverHydroSDM.h"
+#include "sdm/SolverHydroSDM_PAdaptive.h"
+
+#ifdef USE_MPI
+#include "utils/mpiUtils/GlobalMpiSession.h"
+#include <mpi.h>
+#endif // USE_MPI
+
+using namespace ppkMHD;
+
+// order of the SDM scheme
+constexpr int N = 3;
+
+/*
+ * Total mass and energy of the solution (order N data array U) : exact
+ * integral of the polynomial of each cell, from the integrals of the
+ * Lagrange polynomials of the solution points.
+ */
+template<int dim>
+void totals(sdm::SolverHydroSDM_PAdaptive<dim,N>& solver,
+	    double& mass, double& energy)
+{
+
+  const HydroParams& params = solver.params;
+  const int gw = params.ghostWidth;
+
+  // 1D weights : integral over [0,1] of the Lagrange polynomials
+  std::vector<std::vector<real_t> > points;
+  solver.geometries.solution_points(points);
+
+  std::vector<double> xq, wq;
+  sdm::PAdaptive_Matrices<dim,N>::gauss_legendre(N, xq, wq);
+
+  std::vector<double> w(N, 0.0);
+  for (int i=0; i<N; ++i)
+    for (int q=0; q<N; ++q)
+      w[i] += wq[q] * sdm::PAdaptive_Matrices<dim,N>::lagrange(points[N], i, xq[q]);
+
+  auto Uhost = Kokkos::create_mirror_view(solver.U);
+  Kokkos::deep_copy(Uhost, solver.U);
+
+  const int nbDofsPerCell = dim==2 ? N*N : N*N*N;
+
+  mass = 0;
+  energy = 0;
+  if (dim == 2) {
+    for (int j=gw; j<params.jsize-gw; ++j)
+      for (int i=gw; i<params.isize-gw; ++i)
+	for (int jj=0; jj<N; ++jj)
+	  for (int ii=0; ii<N; ++ii) {
+	    const double wp = w[ii]*w[jj];
+	    mass   += wp * Uhost(i,j,ii+N*jj+nbDofsPerCell*ID);
+	    energy += wp * Uhost(i,j,ii+N*jj+nbDofsPerCell*IE);
+	  }
+    mass   *= params.dx*params.dy;
+    energy *= params.dx*params.dy;
+  } else {
+    for (int k=gw; k<params.ksize-gw; ++k)
+      for (int j=gw; j<params.jsize-gw; ++j)
+	for (int i=gw; i<params.isize-gw; ++i)
+	  for (int kk=0; kk<N; ++kk)
+	    for (int jj=0; jj<N; ++jj)
+	      for (int ii=0; ii<N; ++ii) {
+		const double wp = w[ii]*w[jj]*w[kk];
+		mass   += wp * Uhost(i,j,k,ii+N*jj+N*N*kk+nbDofsPerCell*ID);
+		energy += wp * Uhost(i,j,k,ii+N*jj+N*N*kk+nbDofsPerCell*IE);
+	      }
+    mass   *= params.dx*params.dy*params.dz;
+    energy *= params.dx*params.dy*params.dz;
+  }
+
+#ifdef USE_MPI
+  MPI_Allreduce(MPI_IN_PLACE, &mass,   1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+  MPI_Allreduce(MPI_IN_PLACE, &energy, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+#endif // USE_MPI
+
+} // totals
+
+/*
+ * p_adaptive_min_order=N : same results as SolverHydroSDM.
+ */
+template<int dim>
+int test_order_N(int myRank)
+{
+
+  ConfigMap configMap(dim == 2 ? "test_sdm_padaptive_2D.ini" : "test_sdm_padaptive_3D.ini");
+  configMap.setInteger("sdm", "p_adaptive_min_order", N);
+
+  HydroParams params;
+  params.setup(configMap);
+  sdm::SolverHydroSDM_PAdaptive<dim,N> solverP(params, configMap);
+  while ( !solverP.finished() )
+    solverP.next_iteration();
+
+  HydroParams paramsRef;
+  paramsRef.setup(configMap);
+  sdm::SolverHydroSDM<dim,N> solverRef(paramsRef, configMap);
+  while ( !solverRef.finished() )
+    solverRef.next_iteration();
+
+  auto Up_host   = Kokkos::create_mirror_view(solverP.U);
+  auto Uref_host = Kokkos::create_mirror_view(solverRef.U);
+  Kokkos::deep_copy(Up_host,   solverP.U);
+  Kokkos::deep_copy(Uref_host, solverRef.U);
+
+  const int gw = params.ghostWidth;
+  const int nbDofs = params.nbvar * (dim==2 ? N*N : N*N*N);
+
+  double diff = 0;
+  if (dim == 2) {
+    for (int j=gw; j<params.jsize-gw; ++j)
+      for (int i=gw; i<params.isize-gw; ++i)
+	for (int idof=0; idof<nbDofs; ++idof)
+	  diff = fmax(diff, fabs(Up_host(i,j,idof) - Uref_host(i,j,idof)));
+  } else {
+    for (int k=gw; k<params.ksize-gw; ++k)
+      for (int j=gw; j<params.jsize-gw; ++j)
+	for (int i=gw; i<params.isize-gw; ++i)
+	  for (int idof=0; idof<nbDofs; ++idof)
+	    diff = fmax(diff, fabs(Up_host(i,j,k,idof) - Uref_host(i,j,k,idof)));
+  }
+
+#ifdef USE_MPI
+  MPI_Allreduce(MPI_IN_PLACE, &diff, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+#endif // USE_MPI
+
+  if (myRank==0)
+    printf("dim=%d : all cells of order %d vs SolverHydroSDM, max difference %g (t=%g / %g)\n",
+	   dim, N, diff, solverP.m_t, solverRef.m_t);
+
+  return diff == 0 and solverP.m_t == solverRef.m_t ? 0 : 1;
+
+} // test_order_N
+
+/*
+ * Cells of several orders (selected again every p_adaptive_interval
+ * steps) : mass and energy must be conserved.
+ */
+template<int dim>
+int test_conservation(int myRank)
+{
+
+  ConfigMap configMap(dim == 2 ? "test_sdm_padaptive_2D.ini" : "test_sdm_padaptive_3D.ini");
+
+  HydroParams params;
+  params.setup(configMap);
+  sdm::SolverHydroSDM_PAdaptive<dim,N> solver(params, configMap);
+
+  double mass0, energy0;
+  totals(solver, mass0, energy0);
+
+  double errMass = 0, errEnergy = 0;
+  int nbOrdersMax = 0;
+
+  while ( !solver.finished() ) {
+
+    solver.next_iteration();
+
+    int nbOrders = 0;
+    for (int order=1; order<=N; ++order) {
+      int count = solver.groupCount[order];
+#ifdef USE_MPI
+      MPI_Allreduce(MPI_IN_PLACE, &count, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+#endif // USE_MPI
+      if (count > 0)
+	++nbOrders;
+    }
+    nbOrdersMax = std::max(nbOrdersMax, nbOrders);
+
+    double mass, energy;
+    totals(solver, mass, energy);
+    errMass   = std::max(errMass,   fabs(mass   - mass0)   / mass0);
+    errEnergy = std::max(errEnergy, fabs(energy - energy0) / energy0);
+
+  }
+
+  if (myRank==0)
+    printf("dim=%d : up to %d orders, max relative mass error %g, energy error %g\n",
+	   dim, nbOrdersMax, errMass, errEnergy);
+
+  int status = 0;
+
+  if (nbOrdersMax < 2) {
+    if (myRank==0)
+      printf("  all cells have the same order\n");
+    status = 1;
+  }
+
+  if (errMass > 1e-12 or errEnergy > 1e-12) {
+    if (myRank==0)
+      printf("  mass / energy are not conserved\n");
+    status = 1;
+  }
+
+  return status;
+
+} // test_conservation
+
+/*************************************************/
+/*************************************************/
+/*************************************************/
+int main(int argc, char* argv[])
+{
+
+  // Create MPI session if MPI enabled
+#ifdef USE_MPI
+  hydroSimu::GlobalMpiSession mpiSession(&argc,&argv);
+#endif // USE_MPI
+
+  Kokkos::initialize(argc, argv);
+
+  int myRank = 0;
+#ifdef USE_MPI
+  MPI_Comm_rank(MPI_COMM_WORLD, &myRank);
+#endif // USE_MPI
+
+  int status = 0;
+
+  status += test_order_N<2>(myRank);
+  status += test_order_N<3>(myRank);
+  status += test_conservation<2>(myRank);
+  status += test_conservation<3>(myRank);
+
+  Kokkos::finalize();
+
+  return status;
+
+}
@@ -0,0 +1,135 @@
+/**
+ * This executable checks that restricting the SDM limiter / positivity
+ * preserving functors to a list of troubled cells gives the same
+ * results as visiting all cells :
+ * - positivity preserving only : the positivity indicator is
+ *   conservative, so that the cell list path must be exact,
+ * - limiter and positivity preserving, with a negative limiter
+ *   threshold (all cells are listed).
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <iostream>
+
+#include "shared/real_type.h"
+#include "shared/kokkos_shared.h"
+
+#include "sdm/SolverHydroSDM.h"
+
+#ifdef USE_MPI
+#include "utils/mpiUtils/GlobalMpiSession.h"
+#include <mpi.h>
+#endif // USE_MPI
+
+/*
+ * Run a few time steps, and return the solution (copied on host).
+ */
+template<int dim, int N>
+typename sdm::SolverHydroSDM<dim,N>::DataArrayHost
+run(ConfigMap configMap, bool troubled_cells_enabled, HydroParams& params)
+{
+
+  configMap.setBool("sdm", "troubled_cells_enabled", troubled_cells_enabled);
+
+  params = HydroParams();
+  params.setup(configMap);
+
+  sdm::SolverHydroSDM<dim,N> solver(params, configMap);
+
+  while ( !solver.finished() )
+    solver.next_iteration();
+
+  typename sdm::SolverHydroSDM<dim,N>::DataArrayHost Uhost =
+    Kokkos::create_mirror(solver.U);
+  Kokkos::deep_copy(Uhost, solver.U);
+
+  return Uhost;
+
+} // run
+
+/*
+ * Main test using scheme order as template parameter.
+ * order is the number of solution points per direction.
+ */
+template<int dim,
+	 int N>
+int test_troubled_cells(bool limiter_enabled)
+{
+
+  int myRank = 0;
+#ifdef USE_MPI
+  MPI_Comm_rank(MPI_COMM_WORLD, &myRank);
+#endif // USE_MPI
+
+  std::string input_file = dim == 2 ?
+    "test_sdm_troubled_cells_2D.ini" :
+    "test_sdm_troubled_cells_3D.ini";
+  ConfigMap configMap(input_file);
+
+  configMap.setBool("sdm", "positivity_enabled", true);
+  configMap.setBool("sdm", "limiter_enabled", limiter_enabled);
+
+  // all interior cells are listed for the limiter
+  configMap.setFloat("sdm", "troubled_cells_threshold", -1.0);
+
+  HydroParams params;
+  auto Uref  = run<dim,N>(configMap, false, params);
+  auto Ulist = run<dim,N>(configMap, true,  params);
+
+  const int gw = params.ghostWidth;
+  const int nbvar = params.nbvar;
+
+  // max difference over interior cells
+  double diff = 0;
+  if (dim == 2) {
+    for (int j=gw; j<params.jsize-gw; ++j)
+      for (int i=gw; i<params.isize-gw; ++i)
+	for (int idof=0; idof<N*N*nbvar; ++idof)
+	  diff = fmax(diff, fabs(Uref(i,j,idof) - Ulist(i,j,idof)));
+  } else {
+    for (int k=gw; k<params.ksize-gw; ++k)
+      for (int j=gw; j<params.jsize-gw; ++j)
+	for (int i=gw; i<params.isize-gw; ++i)
+	  for (int idof=0; idof<N*N*N*nbvar; ++idof)
+	    diff = fmax(diff, fabs(Uref(i,j,k,idof) - Ulist(i,j,k,idof)));
+  }
+
+#ifdef USE_MPI
+  MPI_Allreduce(MPI_IN_PLACE, &diff, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+#endif // USE_MPI
+
+  if (myRank==0)
+    printf("dim=%d N=%d limiter=%d : max difference cell list vs all cells = %g\n",
+	   dim, N, limiter_enabled, diff);
+
+  return diff == 0 ? 0 : 1;
+
+} // test_troubled_cells
+
+/*************************************************/
+/*************************************************/
+/*************************************************/
+int main(int argc, char* argv[])
+{
+
+  // Create MPI session if MPI enabled
+#ifdef USE_MPI
+  hydroSimu::GlobalMpiSession mpiSession(&argc,&argv);
+#endif // USE_MPI
+
+  Kokkos::initialize(argc, argv);
+
+  int status = 0;
+
+  status += test_troubled_cells<2,3>(false);
+  status += test_troubled_cells<2,3>(true);
+  status += test_troubled_cells<3,2>(false);
+  status += test_troubled_cells<3,2>(true);
+
+  Kokkos::finalize();
+
+  return status;
+
+}
@@ -0,0 +1,166 @@
+/**
+ * This executable is used to test reduced-precision halo messages
+ * (shared/mpiHaloCompression.h) : fixed point round-trip error bound,
+ * clamping of values outside the encoding range, and pack / unpack of
+ * a border with some variables kept at full precision.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <iostream>
+
+#include "shared/real_type.h"
+#include "shared/kokkos_shared.h"
+#include "shared/mpiHaloCompression.h"
+
+using namespace ppkMHD;
+
+/*
+ * Encode / decode values of [lo,hi] : error must not exceed
+ * (hi-lo)/(2*qmax), qmax = 2^bits-1. Values slightly outside [lo,hi]
+ * must be clamped to the nearest end point.
+ */
+template<class Wire>
+int test_wire(const char* name)
+{
+
+  const double qmax = Wire::qmax();
+  int status = 0;
+  double ratioMax = 0;
+
+  srand(12345);
+  for (int iter=0; iter<1000; ++iter) {
+
+    const double lo = -1.0 + 2.0*rand()/RAND_MAX;
+    const double hi = lo + pow(10.0, -3.0 + 6.0*rand()/RAND_MAX);
+    const double bound = (hi-lo)/(2*qmax);
+
+    for (int n=0; n<=100; ++n) {
+      const double x = n == 0 ? lo : (n == 100 ? hi : lo + (hi-lo)*rand()/RAND_MAX);
+      const double y = Wire::decode(Wire::encode(x, lo, hi), lo, hi);
+      // allow for round-off in the (x-lo)/(hi-lo) computation
+      ratioMax = std::max(ratioMax, fabs(y-x)/bound);
+    }
+
+    // outside of range : no wrap around
+    const double eps = (hi-lo)*1e-3;
+    if (Wire::encode(hi+eps, lo, hi) != Wire::encode(hi, lo, hi) or
+	Wire::encode(lo-eps, lo, hi) != 0) {
+      if (iter == 0)
+	std::cout << "  " << name << " : values outside [lo,hi] are not clamped\n";
+      status = 1;
+    }
+
+  }
+
+  std::cout << name << " : max error / bound " << ratioMax << "\n";
+
+  if (ratioMax > 1.0 + 1e-6) {
+    std::cout << "  " << name << " : error bound exceeded\n";
+    status = 1;
+  }
+
+  // constant component
+  if (Wire::decode(Wire::encode(0.5, 0.5, 0.5), 0.5, 0.5) != 0.5) {
+    std::cout << "  " << name << " : constant component not exact\n";
+    status = 1;
+  }
+
+  return status;
+
+} // test_wire
+
+/*
+ * Pack the XMIN border (interior cells) of a 2D array into a message,
+ * unpack into the XMIN ghost cells of another array and compare. ID is
+ * kept at full precision (exact), other variables must be within the
+ * bound of their own range.
+ */
+int test_message(int precision, const char* name)
+{
+
+  const int gw = 2, isize = 12, jsize = 10, nbvar = 4;
+  const int fullMask = 1 << ID;
+
+  DataArray2d U ("U",  isize, jsize, nbvar);
+  DataArray2d U2("U2", isize, jsize, nbvar);
+  DataArray2d b ("b",  gw,    jsize, nbvar);
+
+  auto Uhost = Kokkos::create_mirror_view(U);
+  for (int j=0; j<jsize; ++j)
+    for (int i=0; i<isize; ++i)
+      for (int iVar=0; iVar<nbvar; ++iVar)
+	Uhost(i,j,iVar) = (iVar+1) * (1.0 + sin(0.7*i + 1.3*j + iVar)) + 0.1*iVar;
+  Kokkos::deep_copy(U, Uhost);
+
+  const Kokkos::Array<int,3> tile = {0, 0, 0};
+  HaloMessage msg;
+  HaloRange   range;
+
+  pack_halo_message<XMIN,TWO_D>(precision, U, b, msg, range,
+				nbvar, fullMask, gw, tile);
+  unpack_halo_message<XMIN,TWO_D>(precision, U2, b, msg,
+				  nbvar, fullMask, gw, tile);
+
+  auto U2host = Kokkos::create_mirror_view(U2);
+  Kokkos::deep_copy(U2host, U2);
+
+  const double qmax = precision == HALO_PRECISION_FIXED16 ? 65535.0 : 4294967295.0;
+
+  int status = 0;
+  for (int iVar=0; iVar<nbvar; ++iVar) {
+
+    // range of the component (one component per variable here)
+    double lo =  1e300, hi = -1e300;
+    for (int j=0; j<jsize; ++j)
+      for (int i=0; i<gw; ++i) {
+	lo = std::min(lo, (double) Uhost(gw+i,j,iVar));
+	hi = std::max(hi, (double) Uhost(gw+i,j,iVar));
+      }
+
+    double err = 0;
+    for (int j=0; j<jsize; ++j)
+      for (int i=0; i<gw; ++i)
+	err = std::max(err, fabs((double) U2host(i,j,iVar) - Uhost(gw+i,j,iVar)));
+
+    const double bound = iVar == ID ? 0 : (hi-lo)/(2*qmax)*(1+1e-6);
+    std::cout << name << " : variable " << iVar << " error " << err
+	      << " (bound " << bound << ")\n";
+    if (err > bound) {
+      std::cout << "  error bound exceeded\n";
+      status = 1;
+    }
+
+  }
+
+  return status;
+
+} // test_message
+
+/*************************************************/
+/*************************************************/
+/*************************************************/
+int main(int argc, char* argv[])
+{
+
+  Kokkos::initialize(argc, argv);
+
+  int status = 0;
+
+  status += test_wire<HaloWireFixed<uint16_t> >("fixed16");
+  status += test_wire<HaloWireFixed<uint32_t> >("fixed32");
+
+  status += test_message(HALO_PRECISION_FIXED16, "fixed16 message");
+  status += test_message(HALO_PRECISION_FIXED32, "fixed32 message");
+
+  Kokkos::finalize();
+
+  if (status == 0)
+    std::cout << "test passed\n";
+  else
+    std::cout << "test failed\n";
+
+  return status == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+
+} // main
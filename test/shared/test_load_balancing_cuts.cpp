@@ -0,0 +1,184 @@
+/**
+ * This executable is used to test ppkMHD::compute_balanced_cuts (new
+ * sub-domain boundaries computed by dynamic load balancing).
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include "shared/load_balancing_utils.h"
+
+/*
+ * Check the invariants of new boundaries : end points unchanged, each
+ * boundary moved by at most half the adjacent widths (minus ghost
+ * width), no sub-domain thinner than ghostWidth.
+ */
+int check_invariants(const std::vector<int>& cuts,
+		     const std::vector<int>& newCuts,
+		     int ghostWidth)
+{
+
+  const int m = cuts.size()-1;
+  int status = 0;
+
+  if ( (int) newCuts.size() != m+1 ) {
+    std::cout << "  wrong number of boundaries\n";
+    return 1;
+  }
+
+  if (newCuts[0] != cuts[0] or newCuts[m] != cuts[m]) {
+    std::cout << "  domain end points moved\n";
+    status = 1;
+  }
+
+  for (int p=1; p<m; ++p) {
+    const int maxLeft  = std::max(0, (cuts[p]   - cuts[p-1] - ghostWidth)/2);
+    const int maxRight = std::max(0, (cuts[p+1] - cuts[p]   - ghostWidth)/2);
+    if (newCuts[p] < cuts[p]-maxLeft or newCuts[p] > cuts[p]+maxRight) {
+      std::cout << "  boundary " << p << " moved too far : "
+		<< cuts[p] << " -> " << newCuts[p] << "\n";
+      status = 1;
+    }
+  }
+
+  for (int p=0; p<m; ++p) {
+    if (newCuts[p+1] - newCuts[p] < ghostWidth) {
+      std::cout << "  sub-domain " << p << " thinner than ghostWidth\n";
+      status = 1;
+    }
+  }
+
+  return status;
+
+} // check_invariants
+
+/*
+ * max slab cost over mean slab cost, the cost density being uniform
+ * inside each of the original slabs
+ */
+double imbalance(const std::vector<int>& cuts,
+		 const std::vector<double>& slabCost,
+		 const std::vector<int>& newCuts)
+{
+
+  const int m = slabCost.size();
+
+  // cost density per cell
+  std::vector<double> cellCost;
+  double total = 0;
+  for (int p=0; p<m; ++p) {
+    for (int c=cuts[p]; c<cuts[p+1]; ++c)
+      cellCost.push_back( slabCost[p] / (cuts[p+1]-cuts[p]) );
+    total += slabCost[p];
+  }
+
+  double costMax = 0;
+  for (int p=0; p<m; ++p) {
+    double cost = 0;
+    for (int c=newCuts[p]; c<newCuts[p+1]; ++c)
+      cost += cellCost[c-cuts[0]];
+    costMax = std::max(costMax, cost);
+  }
+
+  return costMax / (total/m);
+
+} // imbalance
+
+/*************************************************/
+/*************************************************/
+/*************************************************/
+int main(int argc, char* argv[])
+{
+
+  (void) argc;
+  (void) argv;
+
+  int status = 0;
+  const int ghostWidth = 2;
+
+  // uniform cost : nothing moves
+  {
+    std::cout << "uniform cost\n";
+    std::vector<int>    cuts     = {0, 32, 64, 96, 128};
+    std::vector<double> slabCost = {1.0, 1.0, 1.0, 1.0};
+    std::vector<int>    newCuts;
+
+    const bool moved = ppkMHD::compute_balanced_cuts(cuts.data(), slabCost,
+						     ghostWidth, newCuts);
+    if (moved or newCuts != cuts) {
+      std::cout << "  boundaries moved with a uniform cost\n";
+      status = 1;
+    }
+  }
+
+  // one slab twice as expensive : imbalance decreases
+  {
+    std::cout << "one expensive slab\n";
+    std::vector<int>    cuts     = {0, 32, 64, 96, 128};
+    std::vector<double> slabCost = {1.0, 2.0, 1.0, 1.0};
+    std::vector<int>    newCuts;
+
+    const bool moved = ppkMHD::compute_balanced_cuts(cuts.data(), slabCost,
+						     ghostWidth, newCuts);
+    status += check_invariants(cuts, newCuts, ghostWidth);
+
+    const double before = imbalance(cuts, slabCost, cuts);
+    const double after  = imbalance(cuts, slabCost, newCuts);
+    std::cout << "  imbalance " << before << " -> " << after << "\n";
+
+    if (!moved or after >= before) {
+      std::cout << "  imbalance did not decrease\n";
+      status = 1;
+    }
+
+    // the expensive sub-domain shrinks
+    if (newCuts[2]-newCuts[1] >= cuts[2]-cuts[1]) {
+      std::cout << "  expensive sub-domain did not shrink\n";
+      status = 1;
+    }
+  }
+
+  // very expensive slab : displacement is limited, sub-domains stay
+  // wider than ghostWidth
+  {
+    std::cout << "very expensive slab\n";
+    std::vector<int>    cuts     = {10, 18, 26, 34};
+    std::vector<double> slabCost = {0.0, 100.0, 0.0};
+    std::vector<int>    newCuts;
+
+    ppkMHD::compute_balanced_cuts(cuts.data(), slabCost,
+				  ghostWidth, newCuts);
+    status += check_invariants(cuts, newCuts, ghostWidth);
+  }
+
+  // non uniform initial decomposition, random costs
+  {
+    std::cout << "random costs\n";
+    srand(12345);
+    for (int iter=0; iter<100; ++iter) {
+      const int m = 2 + rand() % 7;
+      std::vector<int> cuts(m+1, 0);
+      for (int p=1; p<=m; ++p)
+	cuts[p] = cuts[p-1] + ghostWidth + rand() % 20;
+      std::vector<double> slabCost(m);
+      for (int p=0; p<m; ++p)
+	slabCost[p] = 1.0 * (rand() % 10);
+      std::vector<int> newCuts;
+
+      ppkMHD::compute_balanced_cuts(cuts.data(), slabCost,
+				    ghostWidth, newCuts);
+      status += check_invariants(cuts, newCuts, ghostWidth);
+    }
+  }
+
+  if (status == 0)
+    std::cout << "test passed\n";
+  else
+    std::cout << "test failed\n";
+
+  return status == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+
+} // main